@@ -0,0 +1,167 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     cm_perf_statistics_bench.cpp
+//! \brief    Times the overhead INSERT_PROFILER_RECORD adds to a CM API call and checks the call
+//!           counts the profiler dumps at teardown
+//!
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <atomic>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+#include "cm_timer.h"
+#include "cm_perf_statistics.h"
+#include "media_bench.h"
+
+//!
+//! \brief  Reads CmPerfStatistics.txt once the profiler wrote it
+//! \details Defined before gCmPerfStatistics, so it is destroyed after the profiler dumped its records.
+//!
+class StatisticsCheck
+{
+public:
+    ~StatisticsCheck()
+    {
+        FILE *file = fopen("CmPerfStatistics.txt", "r");
+        if (file == nullptr)
+        {
+            printf("check: no CmPerfStatistics.txt\n");
+            _exit(1);
+        }
+
+        std::map<std::string, uint64_t> counts;
+        char                            line[512];
+        fgets(line, sizeof(line), file);  // header
+        while (fgets(line, sizeof(line), file))
+        {
+            char               name[256];
+            double             ms;
+            unsigned long long calls;
+            if (sscanf(line, "%255s %lfms %llu", name, &ms, &calls) == 3)
+            {
+                counts[name] = calls;
+            }
+        }
+        fclose(file);
+
+        uint32_t mismatches = 0;
+        for (auto &expected : m_expected)
+        {
+            printf("check: %-20s %llu calls, CmPerfStatistics.txt %llu\n", expected.first.c_str(),
+                (unsigned long long)expected.second, (unsigned long long)counts[expected.first]);
+            mismatches += (counts[expected.first] != expected.second);
+        }
+        if (mismatches)
+        {
+            _exit(1);
+        }
+    }
+
+    std::map<std::string, uint64_t> m_expected;
+};
+
+static StatisticsCheck g_check;
+
+CmPerfStatistics gCmPerfStatistics;  // as in cm_device.cpp
+
+static std::atomic<uint32_t> g_sink(0);
+
+__attribute__((noinline)) void CmEnqueueUnprofiled()
+{
+    g_sink.fetch_add(1, std::memory_order_relaxed);
+}
+
+__attribute__((noinline)) void CmEnqueue()
+{
+    INSERT_PROFILER_RECORD();
+    g_sink.fetch_add(1, std::memory_order_relaxed);
+}
+
+__attribute__((noinline)) void CmCreateSurface2D()
+{
+    INSERT_PROFILER_RECORD();
+    g_sink.fetch_add(1, std::memory_order_relaxed);
+}
+
+//!
+//! \brief  threads threads make calls calls each, one in 8 profiled ones is CmCreateSurface2D
+//! \return ns per call
+//!
+static double Run(uint32_t threads, uint32_t calls, bool profiled)
+{
+    MediaBenchTimer timer;
+
+    std::vector<std::thread> pool;
+    for (uint32_t t = 0; t < threads; t++)
+    {
+        pool.emplace_back([=]() {
+            for (uint32_t i = 0; i < calls; i++)
+            {
+                if (!profiled)
+                {
+                    CmEnqueueUnprofiled();
+                }
+                else if (i & 7)
+                {
+                    CmEnqueue();
+                }
+                else
+                {
+                    CmCreateSurface2D();
+                }
+            }
+        });
+    }
+    for (auto &thread : pool)
+    {
+        thread.join();
+    }
+
+    if (profiled)
+    {
+        uint64_t surfaceCalls = (uint64_t)threads * ((calls + 7) / 8);
+        g_check.m_expected["CmCreateSurface2D"] += surfaceCalls;
+        g_check.m_expected["CmEnqueue"] += (uint64_t)threads * calls - surfaceCalls;
+    }
+
+    return timer.Ns() / ((double)calls * threads);
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t calls = MediaBenchArg(argc, argv, 1, 100000);
+
+    printf("%u calls per thread, ns per call:\n", calls);
+    printf("  threads  unprofiled  profiled  overhead\n");
+    for (uint32_t threads : {1, 4, 8})
+    {
+        double unprofiled = Run(threads, calls, false);
+        double profiled   = Run(threads, calls, true);
+        printf("  %7u  %10.1f  %8.1f  %8.1f\n", threads, unprofiled, profiled, profiled - unprofiled);
+    }
+    return 0;
+}
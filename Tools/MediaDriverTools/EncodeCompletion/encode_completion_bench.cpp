@@ -0,0 +1,186 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     encode_completion_bench.cpp
+//! \brief    CPU time per waited frame of the encode status report, poll vs completion object
+//! \details  Usage: EncodeCompletionBench [frames] [frame us] [status lag us] [threads]
+//!           The GPU is simulated: the coded buffer bo turns idle after frame us, and the
+//!           status is written status lag us later. The bo wait sleeps like DRM_IOCTL_I915_GEM_WAIT.
+//!
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <errno.h>
+#include <unistd.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "media_ddi_encode_completion.h"
+#include "media_bench.h"
+
+typedef std::chrono::steady_clock Clock;
+
+struct Frame
+{
+    Clock::time_point boIdle;
+    Clock::time_point statusTime;
+};
+
+struct Result
+{
+    double cpuUs;
+    double latencyUs;
+    double queries;
+};
+
+static double ThreadCpuUs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+static int WaitBo(void *bo, int64_t timeoutNs)
+{
+    Clock::time_point idle    = static_cast<Frame *>(bo)->boIdle;
+    Clock::time_point timeout = Clock::now() + std::chrono::nanoseconds(timeoutNs);
+    std::this_thread::sleep_until(idle < timeout ? idle : timeout);
+    return Clock::now() >= idle ? 0 : -ETIME;
+}
+
+// Legacy status report loop: query, usleep(10), up to 1s worth of iterations
+static void NoReference(void *bo)
+{
+}
+
+static void Poll(uint32_t us)
+{
+    usleep(us);
+}
+
+static bool PollFrame(Frame *frame, uint32_t *queries)
+{
+    for (uint32_t timeOutCount = 0; timeOutCount < 100000; timeOutCount++)
+    {
+        (*queries)++;
+        if (Clock::now() >= frame->statusTime)
+        {
+            return true;
+        }
+        usleep(10);
+    }
+    return false;
+}
+
+static bool WaitFrame(Frame *frame, uint32_t *queries)
+{
+    DDI_ENCODE_COMPLETION completion = {};
+    DdiEncode_AddCompletionBo(&completion, frame, NoReference);
+
+    DDI_ENCODE_DEADLINE deadline = DdiEncode_GetDeadline(1000000);
+    while (true)
+    {
+        (*queries)++;
+        if (Clock::now() >= frame->statusTime)
+        {
+            return true;
+        }
+        if (!DdiEncode_WaitCompletion<Clock>(&completion, deadline, WaitBo, Poll))
+        {
+            return false;
+        }
+    }
+}
+
+static void RunSession(bool poll, uint32_t frameNum, uint32_t frameUs, uint32_t lagUs, Result *result)
+{
+    double   cpu     = 0;
+    double   latency = 0;
+    uint64_t queries = 0;
+
+    for (uint32_t i = 0; i < frameNum; i++)
+    {
+        // app maps the coded buffer right after EndPicture
+        Frame frame;
+        frame.boIdle     = Clock::now() + std::chrono::microseconds(frameUs);
+        frame.statusTime = frame.boIdle + std::chrono::microseconds(lagUs);
+
+        uint32_t frameQueries = 0;
+        double   start        = ThreadCpuUs();
+        bool     done         = poll ? PollFrame(&frame, &frameQueries) : WaitFrame(&frame, &frameQueries);
+        cpu += ThreadCpuUs() - start;
+        latency += std::chrono::duration<double, std::micro>(Clock::now() - frame.statusTime).count();
+        queries += frameQueries;
+        if (!done)
+        {
+            fprintf(stderr, "frame %u timed out\n", i);
+        }
+    }
+
+    result->cpuUs     = cpu / frameNum;
+    result->latencyUs = latency / frameNum;
+    result->queries   = (double)queries / frameNum;
+}
+
+static void Run(const char *name, bool poll, uint32_t frameNum, uint32_t frameUs, uint32_t lagUs, uint32_t threadNum)
+{
+    std::vector<std::thread> threads;
+    std::vector<Result>      results(threadNum);
+    for (uint32_t i = 0; i < threadNum; i++)
+    {
+        threads.emplace_back(RunSession, poll, frameNum, frameUs, lagUs, &results[i]);
+    }
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    Result sum = {};
+    for (auto &r : results)
+    {
+        sum.cpuUs += r.cpuUs / threadNum;
+        sum.latencyUs += r.latencyUs / threadNum;
+        sum.queries += r.queries / threadNum;
+    }
+    printf("%-10s  %8u  %9u  %7u  %16.1f  %14.1f  %13.1f\n",
+        name, threadNum, frameUs, lagUs, sum.cpuUs, sum.latencyUs, sum.queries);
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t frameNum  = MediaBenchArg(argc, argv, 1, 200);
+    uint32_t frameUs   = MediaBenchArg(argc, argv, 2, 5000);
+    uint32_t lagUs     = MediaBenchArg(argc, argv, 3, 0);
+    uint32_t threadNum = MediaBenchArg(argc, argv, 4, 1);
+
+    if (frameNum == 0 || threadNum == 0)
+    {
+        return -1;
+    }
+
+    printf("mode        sessions   frame us   lag us  cpu us per frame  wake late us  queries/frame\n");
+    Run("poll", true, frameNum, frameUs, lagUs, threadNum);
+    Run("completion", false, frameNum, frameUs, lagUs, threadNum);
+
+    return 0;
+}
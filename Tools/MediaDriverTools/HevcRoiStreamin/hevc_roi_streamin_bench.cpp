@@ -0,0 +1,328 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     hevc_roi_streamin_bench.cpp
+//! \brief    Checks and times RoiOverlap::WriteStreaminDataIncremental against
+//!           the full WriteStreaminData rewrite of the streamin buffer
+//!
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "encode_hevc_vdenc_roi_strategy.h"
+#include "media_bench.h"
+
+using namespace encode;
+
+static const uint32_t g_recordSize  = 64;
+static const uint32_t g_bufferNum   = 3;
+static const uint32_t g_maxRoiNum   = 16;
+static const uint32_t g_maxCuNum    = 64;   //!< Width and height limit of the checked scenes
+
+//!
+//! \brief  Strategy writing a native ROI like record, optionally with the LCU position in it
+//!
+class BenchRoi : public RoiStrategy
+{
+public:
+    BenchRoi(bool positionDependent) : RoiStrategy(nullptr, nullptr, nullptr), m_positionDependent(positionDependent)
+    {
+        m_deltaQp.assign(g_maxRoiNum, 0);
+    }
+
+    MOS_STATUS WriteStreaminData(
+        uint32_t lcuIndex,
+        RoiOverlap::OverlapMarker marker,
+        uint32_t roiRegionIndex,
+        uint8_t *streamInBuffer) override
+    {
+        HevcVdencStreamInState *data = (HevcVdencStreamInState *)(streamInBuffer + lcuIndex * g_recordSize);
+
+        bool cu64Align = (marker == RoiOverlap::mkRoi || marker == RoiOverlap::mkRoiBk ||
+                          marker == RoiOverlap::mkDirtyRoi || marker == RoiOverlap::mkDirtyRoiBk);
+        bool foreground = (marker == RoiOverlap::mkRoi || marker == RoiOverlap::mkRoiNone64Align);
+
+        data->DW0.MaxTuSize        = m_maxTuSize;
+        data->DW0.MaxCuSize        = cu64Align ? 3 : 2;
+        data->DW0.NumImePredictors = 8;
+        data->DW0.RoiCtrl          = foreground ? (roiRegionIndex + 1) : 0;
+        data->DW6.NumMergeCandidateCu64x64 = cu64Align ? 2 : 0;
+        data->DW7.QpEnable         = foreground ? 0xf : 0;
+        data->DW14.ForceQp_0       = foreground ? (uint8_t)(m_qp + m_deltaQp[roiRegionIndex % g_maxRoiNum]) : 0;
+        if (m_positionDependent)
+        {
+            data->DW13.PanicModeLCUThreshold = lcuIndex & 0xffff;
+        }
+        return MOS_STATUS_SUCCESS;
+    }
+
+    bool IsLcuPositionDependent() const override { return m_positionDependent; }
+
+    std::vector<int8_t> m_deltaQp;
+    uint8_t             m_qp        = 26;
+    uint32_t            m_maxTuSize = 3;
+
+private:
+    bool m_positionDependent = false;
+};
+
+struct Rect
+{
+    uint32_t left;
+    uint32_t top;
+    uint32_t right;
+    uint32_t bottom;
+};
+
+struct Scene
+{
+    uint32_t          width  = 0;  //!< in 32x32 CUs
+    uint32_t          height = 0;  //!< in 32x32 CUs
+    std::vector<Rect> rois;
+    std::vector<Rect> dirtyRects;
+};
+
+static Rect RandomRect(std::mt19937 &rng, uint32_t width, uint32_t height, uint32_t maxSize)
+{
+    Rect rect;
+    uint32_t w  = 1 + rng() % std::min(maxSize, width);
+    uint32_t h  = 1 + rng() % std::min(maxSize, height);
+    rect.left   = rng() % (width - w + 1);
+    rect.top    = rng() % (height - h + 1);
+    rect.right  = rect.left + w;
+    rect.bottom = rect.top + h;
+    return rect;
+}
+
+static void MarkScene(RoiOverlap &overlap, const Scene &scene, UintVector &lcus)
+{
+    overlap.Update(scene.width * scene.height);
+
+    for (auto &rect : scene.dirtyRects)
+    {
+        lcus.clear();
+        for (uint32_t y = rect.top; y < rect.bottom; y++)
+        {
+            for (uint32_t x = rect.left; x < rect.right; x++)
+            {
+                lcus.push_back(y * scene.width + x);
+            }
+        }
+        overlap.MarkLcus(lcus, (rect.right - rect.left) % 2 ? RoiOverlap::mkDirtyRoiNone64Align : RoiOverlap::mkDirtyRoi);
+    }
+    for (uint32_t i = 0; i < scene.rois.size(); i++)
+    {
+        const Rect &rect = scene.rois[i];
+        lcus.clear();
+        for (uint32_t y = rect.top; y < rect.bottom; y++)
+        {
+            for (uint32_t x = rect.left; x < rect.right; x++)
+            {
+                lcus.push_back(y * scene.width + x);
+            }
+        }
+        overlap.MarkLcus(lcus, (rect.bottom - rect.top) % 2 ? RoiOverlap::mkRoiNone64Align : RoiOverlap::mkRoi, i);
+    }
+    // ROI background, only written where nothing else is
+    for (uint32_t lcu = 0; lcu < scene.width * scene.height; lcu++)
+    {
+        overlap.MarkLcu(lcu, RoiOverlap::mkRoiBk);
+    }
+}
+
+//!
+//! \brief  Writes the buffer the way HevcVdencRoi::WriteStreaminData does
+//!
+static MOS_STATUS WriteFrame(
+    RoiOverlap &overlap,
+    RoiStrategy *roi,
+    RoiStrategy *dirtyRoi,
+    bool incremental,
+    std::vector<uint8_t> &buffer,
+    std::vector<uint8_t> &staging)
+{
+    // The allocation of a vector is its data, standing for the graphics address of the resource
+    uint64_t allocationId = (uintptr_t)buffer.data();
+
+    if (incremental)
+    {
+        return overlap.WriteStreaminDataIncremental(roi, dirtyRoi, allocationId, buffer.data());
+    }
+
+    std::fill(staging.begin(), staging.end(), 0);
+    MOS_STATUS status = overlap.WriteStreaminData(roi, dirtyRoi, staging.data());
+    std::copy(staging.begin(), staging.end(), buffer.begin());
+    overlap.ResetStreaminHistory(allocationId);
+    return status;
+}
+
+//!
+//! \brief  Random frames over recycled buffers, each compared with a full write into a zeroed buffer
+//!
+static uint32_t Check(uint32_t frames)
+{
+    std::mt19937 rng(1234);
+    RoiOverlap   overlap;
+    BenchRoi     roi(false);
+    BenchRoi     positionRoi(true);
+    BenchRoi     dirtyRoi(false);
+    Scene        scene;
+    UintVector   lcus;
+    uint32_t     mismatches = 0;
+    uint32_t     lcuNumber  = 0;
+    // Recycled buffers are allocated for the largest resolution and start with garbage.
+    // RoiOverlap keeps the LCU number of the largest frame, so every write covers it.
+    size_t bufferSize = g_maxCuNum * g_maxCuNum * g_recordSize;
+    std::vector<std::vector<uint8_t>> buffers(g_bufferNum, std::vector<uint8_t>(bufferSize));
+    for (auto &buffer : buffers)
+    {
+        for (auto &byte : buffer)
+        {
+            byte = (uint8_t)rng();
+        }
+    }
+
+    for (uint32_t frame = 0; frame < frames; frame++)
+    {
+        if (frame % 500 == 0)
+        {
+            // new resolution on the same recycled buffers
+            scene.width  = 4 + rng() % (g_maxCuNum - 4);
+            scene.height = 4 + rng() % (g_maxCuNum - 4);
+            lcuNumber    = std::max(lcuNumber, scene.width * scene.height);
+            scene.rois.clear();
+            for (uint32_t i = 0; i < 1 + rng() % g_maxRoiNum; i++)
+            {
+                scene.rois.push_back(RandomRect(rng, scene.width, scene.height, 16));
+            }
+        }
+
+        switch (rng() % 4)
+        {
+        case 0:
+            scene.rois[rng() % scene.rois.size()] = RandomRect(rng, scene.width, scene.height, 16);
+            break;
+        case 1:
+            roi.m_deltaQp[rng() % g_maxRoiNum] = (int8_t)(rng() % 16) - 8;
+            break;
+        case 2:
+            roi.m_maxTuSize = rng() % 4;
+            break;
+        default:
+            break;
+        }
+        scene.dirtyRects.clear();
+        for (uint32_t i = 0; i < rng() % 4; i++)
+        {
+            scene.dirtyRects.push_back(RandomRect(rng, scene.width, scene.height, 24));
+        }
+
+        MarkScene(overlap, scene, lcus);
+
+        // ARB/QP map style frames interleaved with the incremental ones
+        RoiStrategy *frameRoi    = (frame % 7 == 3) ? (RoiStrategy *)&positionRoi : (RoiStrategy *)&roi;
+        RoiStrategy *frameDirty  = scene.dirtyRects.empty() ? nullptr : &dirtyRoi;
+        bool         incremental = !frameRoi->IsLcuPositionDependent();
+
+        std::vector<uint8_t> reference(bufferSize, 0);
+        std::vector<uint8_t> staging(reference.size());
+        std::vector<uint8_t> &buffer = buffers[frame % g_bufferNum];
+
+        if (overlap.WriteStreaminData(frameRoi, frameDirty, reference.data()) != MOS_STATUS_SUCCESS ||
+            WriteFrame(overlap, frameRoi, frameDirty, incremental, buffer, staging) != MOS_STATUS_SUCCESS ||
+            !std::equal(reference.begin(), reference.begin() + lcuNumber * g_recordSize, buffer.begin()))
+        {
+            if (mismatches++ < 10)
+            {
+                printf("frame %u: %s write differs from a full write into a zeroed buffer\n",
+                    frame, incremental ? "incremental" : "full");
+            }
+        }
+    }
+
+    return mismatches;
+}
+
+//!
+//! \brief  8K streamin, 15 ROIs, one of them panning by one CU per frame
+//!
+static double Time(bool incremental, uint32_t frames)
+{
+    std::mt19937 rng(5678);
+    RoiOverlap   overlap;
+    BenchRoi     roi(false);
+    Scene        scene;
+    UintVector   lcus;
+
+    scene.width  = 240;
+    scene.height = 136;
+    for (uint32_t i = 0; i < 15; i++)
+    {
+        scene.rois.push_back(RandomRect(rng, scene.width, scene.height, 40));
+        roi.m_deltaQp[i] = (int8_t)(rng() % 16) - 8;
+    }
+
+    std::vector<std::vector<uint8_t>> buffers(g_bufferNum, std::vector<uint8_t>(scene.width * scene.height * g_recordSize));
+    std::vector<uint8_t>              staging(scene.width * scene.height * g_recordSize);
+    double                            writeUs = 0;
+
+    for (uint32_t frame = 0; frame < frames; frame++)
+    {
+        Rect &pan = scene.rois[0];
+        if (pan.right == scene.width)
+        {
+            pan.right -= pan.left;
+            pan.left   = 0;
+        }
+        else
+        {
+            pan.left++;
+            pan.right++;
+        }
+        MarkScene(overlap, scene, lcus);
+
+        MediaBenchTimer timer;
+        WriteFrame(overlap, &roi, nullptr, incremental, buffers[frame % g_bufferNum], staging);
+        writeUs += timer.Us();
+    }
+
+    return writeUs / frames;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t frames = MediaBenchArg(argc, argv, 1, 3000);
+
+    uint32_t mismatches = Check(frames);
+    printf("check: %u frames over %u recycled buffers, %u mismatches\n", frames, g_bufferNum, mismatches);
+    if (mismatches)
+    {
+        return 1;
+    }
+
+    printf("8K, 15 ROIs, one panning, streamin write per frame:\n");
+    printf("  full rewrite (WriteStreaminData)           %8.1f us\n", Time(false, frames));
+    printf("  incremental (WriteStreaminDataIncremental) %8.1f us\n", Time(true, frames));
+    return 0;
+}
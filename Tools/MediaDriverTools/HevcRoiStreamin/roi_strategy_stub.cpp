@@ -0,0 +1,59 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     roi_strategy_stub.cpp
+//! \brief    Out of line RoiStrategy members the ROI overlap links against.
+//!           The benchmark strategies override WriteStreaminData, the rest is unused.
+//!
+
+#include "encode_hevc_vdenc_roi_strategy.h"
+
+namespace encode
+{
+MOS_STATUS RoiStrategy::PrepareParams(
+    SeqParams *hevcSeqParams,
+    PicParams *hevcPicParams,
+    SlcParams *hevcSlcParams)
+{
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS RoiStrategy::SetupRoi(RoiOverlap &overlap)
+{
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS RoiStrategy::WriteStreaminData(
+    uint32_t lcuIndex,
+    RoiOverlap::OverlapMarker marker,
+    uint32_t roiRegionIndex,
+    uint8_t *streamInBuffer)
+{
+    return MOS_STATUS_INVALID_PARAMETER;
+}
+
+void RoiStrategy::SetStreaminParamByTU(
+    bool cu64Align,
+    StreamInParams &streaminDataParams)
+{
+}
+}  // namespace encode
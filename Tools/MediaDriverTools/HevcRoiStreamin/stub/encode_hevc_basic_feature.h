@@ -0,0 +1,72 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     encode_hevc_basic_feature.h
+//! \brief    Names the ROI strategy header needs from the HEVC basic feature
+//!
+#ifndef __ENCODE_HEVC_BASIC_FEATURE_H__
+#define __ENCODE_HEVC_BASIC_FEATURE_H__
+
+#include <vector>
+#include "encode_utils.h"
+#include "encode_recycle_resource.h"
+
+struct CODEC_HEVC_ENCODE_SEQUENCE_PARAMS;
+struct CODEC_HEVC_ENCODE_PICTURE_PARAMS;
+struct CODEC_HEVC_ENCODE_SLICE_PARAMS;
+struct CODEC_ROI;
+
+struct MHW_VDBOX_PIPE_BUF_ADDR_PARAMS
+{
+    PMOS_RESOURCE presVdencStreamInBuffer;
+};
+
+class MediaFeature
+{
+public:
+    virtual ~MediaFeature() {}
+};
+
+class MediaFeatureManager
+{
+public:
+    MediaFeature *GetFeature(int featureID) { return nullptr; }
+};
+
+namespace FeatureIDs
+{
+enum
+{
+    basicFeature = 0,
+};
+}
+
+namespace encode
+{
+class HevcBasicFeature : public MediaFeature
+{
+public:
+    RecycleResource *m_recycleBuf = nullptr;
+};
+}  // namespace encode
+
+#endif  // __ENCODE_HEVC_BASIC_FEATURE_H__
@@ -0,0 +1,55 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     mhw_vdbox_huc_itf.h
+//! \brief    Names the ROI strategy header needs from MHW
+//!
+#ifndef __MHW_VDBOX_HUC_ITF_H__
+#define __MHW_VDBOX_HUC_ITF_H__
+
+#define _MHW_PAR_T(cmd) cmd##_PAR
+
+namespace mhw
+{
+namespace vdbox
+{
+namespace huc
+{
+class Itf
+{
+public:
+    class ParSetting
+    {
+    public:
+        virtual ~ParSetting() = default;
+    };
+};
+}  // namespace huc
+
+namespace vdenc
+{
+struct VDENC_STREAMIN_STATE_PAR;
+}  // namespace vdenc
+}  // namespace vdbox
+}  // namespace mhw
+
+#endif  // __MHW_VDBOX_HUC_ITF_H__
@@ -0,0 +1,44 @@
+# Copyright (c) 2026, Intel Corporation
+#
+# Permission is hereby granted, free of charge, to any person obtaining a
+# copy of this software and associated documentation files (the "Software"),
+# to deal in the Software without restriction, including without limitation
+# the rights to use, copy, modify, merge, publish, distribute, sublicense,
+# and/or sell copies of the Software, and to permit persons to whom the
+# Software is furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included
+# in all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+# OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+# THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+# OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+# ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+# OTHER DEALINGS IN THE SOFTWARE.
+
+# Included by every benchmark. Sets MEDIA_ROOT, the driver tree the benchmarked
+# sources are taken from, and media_bench_add(), which builds a benchmark with
+# media_bench.h and the MOS stubs in MediaBench/stub ahead of the driver headers.
+# To compare with another version of the driver, configure with -DMEDIA_ROOT=<path of that checkout>.
+
+set(MEDIA_ROOT ${CMAKE_CURRENT_LIST_DIR}/../../.. CACHE PATH "media-driver tree the benchmarks build the driver sources from")
+set(MEDIA_BENCH_DIR ${CMAKE_CURRENT_LIST_DIR})
+set(MEDIA_BENCH_STUB_DIR ${MEDIA_BENCH_DIR}/stub)
+
+find_package(Threads REQUIRED)
+
+function(media_bench_add name)
+    add_executable(${name} ${ARGN})
+    target_include_directories(${name} BEFORE PRIVATE
+        ${MEDIA_BENCH_DIR}
+        ${MEDIA_BENCH_STUB_DIR}
+    )
+    target_include_directories(${name} PRIVATE
+        ${MEDIA_ROOT}/media_common/agnostic/common/os
+        ${MEDIA_ROOT}/media_common/linux/common/os
+        ${MEDIA_ROOT}/media_softlet/agnostic/common/shared/classtrace
+    )
+    target_link_libraries(${name} ${CMAKE_THREAD_LIBS_INIT})
+endfunction()
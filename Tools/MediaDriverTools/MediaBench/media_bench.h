@@ -0,0 +1,86 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     media_bench.h
+//! \brief    Timing and argument helpers shared by the media driver benchmarks
+//!
+#ifndef __MEDIA_BENCH_H__
+#define __MEDIA_BENCH_H__
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <chrono>
+
+//!
+//! \brief  Wall clock timer, started when constructed
+//!
+class MediaBenchTimer
+{
+public:
+    MediaBenchTimer() : m_start(std::chrono::steady_clock::now()) {}
+
+    void Restart()
+    {
+        m_start = std::chrono::steady_clock::now();
+    }
+
+    double Seconds() const
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count();
+    }
+
+    double Ms() const
+    {
+        return Seconds() * 1e3;
+    }
+
+    double Us() const
+    {
+        return Seconds() * 1e6;
+    }
+
+    uint64_t Ns() const
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_start).count();
+    }
+
+private:
+    std::chrono::steady_clock::time_point m_start;
+};
+
+//!
+//! \brief  Returns the numeric command line argument at index, or defaultValue if it is not given
+//!
+inline uint32_t MediaBenchArg(int argc, char **argv, int index, uint32_t defaultValue)
+{
+    return argc > index ? (uint32_t)strtoul(argv[index], nullptr, 0) : defaultValue;
+}
+
+//!
+//! \brief  Returns the string command line argument at index, or defaultValue if it is not given
+//!
+inline const char *MediaBenchStringArg(int argc, char **argv, int index, const char *defaultValue)
+{
+    return argc > index ? argv[index] : defaultValue;
+}
+
+#endif  // __MEDIA_BENCH_H__
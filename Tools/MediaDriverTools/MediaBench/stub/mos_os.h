@@ -0,0 +1,97 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     mos_os.h
+//! \brief    Minimal MOS interface to build driver sources into the benchmarks
+//! \details  Resources are host memory (pData) or an opaque buffer object (bo),
+//!           the OS interface only has the callbacks the benchmarked sources take.
+//!
+#ifndef __MOS_OS_H__
+#define __MOS_OS_H__
+
+#include "mos_defs.h"
+#include "mos_resource_defs.h"
+#include "mos_utilities.h"
+#include "media_class_trace.h"
+
+struct MOS_RESOURCE
+{
+    void    *bo;
+    uint8_t *pData;
+};
+typedef MOS_RESOURCE *PMOS_RESOURCE;
+
+struct MOS_SURFACE
+{
+    MOS_RESOURCE OsResource;
+    uint32_t     dwWidth;
+    uint32_t     dwHeight;
+};
+typedef MOS_SURFACE *PMOS_SURFACE;
+
+struct MEDIA_WA_TABLE;
+
+// Only the features read by the benchmarked sources
+struct MEDIA_FEATURE_TABLE
+{
+    bool FtrLocalMemory;
+};
+
+struct MOS_INTERFACE;
+typedef MOS_INTERFACE *PMOS_INTERFACE;
+struct MOS_INTERFACE
+{
+    MediaUserSettingSharedPtr (*pfnGetUserSettingInstance)(PMOS_INTERFACE osInterface);
+    MEDIA_WA_TABLE *(*pfnGetWaTable)(PMOS_INTERFACE osInterface);
+    MEDIA_FEATURE_TABLE *(*pfnGetSkuTable)(PMOS_INTERFACE osInterface);
+    MOS_STATUS (*pfnUnlockResource)(PMOS_INTERFACE osInterface, PMOS_RESOURCE resource);
+    void    *pOsContext;
+    bool     bSimIsActive;
+    int32_t  bUsesGfxAddress;
+};
+
+typedef struct _MOS_USER_FEATURE_VALUE_DATA
+{
+    int32_t i32Data;
+} MOS_USER_FEATURE_VALUE_DATA;
+
+enum
+{
+    __MEDIA_USER_FEATURE_VALUE_HEVC_VDENC_ROUNDING_ENABLE_ID,
+};
+
+inline MOS_STATUS MOS_UserFeature_ReadValue_ID(void *, uint32_t, MOS_USER_FEATURE_VALUE_DATA *, void *)
+{
+    return MOS_STATUS_SUCCESS;
+}
+
+inline bool Mos_ResourceIsNull(PMOS_RESOURCE resource)
+{
+    return resource == nullptr || (resource->bo == nullptr && resource->pData == nullptr);
+}
+
+// No WA table is installed, WA dependent paths are not taken
+#define MEDIA_IS_WA(_waTable, _waName) false
+#define MEDIA_IS_SKU(_skuTable, _ftrName) ((_skuTable)->_ftrName)
+#define Mos_Solo_Extension(_osContext) false
+
+#endif  // __MOS_OS_H__
@@ -0,0 +1,191 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     mos_reg_stub.cpp
+//! \brief    Registry and env functions of the Linux MOS utilities
+//! \details  Same as in mos_utilities_specific.cpp. The registry is not loaded from the
+//!           user feature file but copied from MosBenchRegistry(), filled by the benchmark.
+//!
+#include <stdlib.h>
+#include <algorithm>
+#include "mos_utilities.h"
+
+bool MosUtilities::m_mosUltFlag = false;
+
+RegBufferMap &MosBenchRegistry()
+{
+    static RegBufferMap registry;
+    return registry;
+}
+
+MOS_STATUS MosUtilities::MosInitializeReg(RegBufferMap &regBufferMap)
+{
+    regBufferMap = MosBenchRegistry();
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS MosUtilities::MosUninitializeReg(RegBufferMap &regBufferMap)
+{
+    regBufferMap.clear();
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS MosUtilities::MosCreateRegKey(
+    UFKEY_NEXT keyHandle,
+    const std::string &subKey,
+    uint32_t samDesired,
+    PUFKEY_NEXT key,
+    RegBufferMap &regBufferMap)
+{
+    MOS_UNUSED(keyHandle);
+    MOS_UNUSED(samDesired);
+    MOS_OS_CHK_NULL_RETURN(key);
+    auto ret = regBufferMap.find(subKey);
+
+    if (ret == regBufferMap.end())
+    {
+        regBufferMap[subKey] = {};
+    }
+
+    *key = subKey;
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS MosUtilities::MosOpenRegKey(
+    UFKEY_NEXT keyHandle,
+    const std::string &subKey,
+    uint32_t samDesired,
+    PUFKEY_NEXT key,
+    RegBufferMap &regBufferMap)
+{
+    std::string tempSubKey = subKey;
+
+    if (subKey.find_first_of("\\") != std::string::npos)
+    {
+        tempSubKey = subKey.substr(1);
+    }
+
+    if (tempSubKey.find_first_of("[") == std::string::npos)
+    {
+        tempSubKey = "[" + tempSubKey + "]";
+    }
+    return MosCreateRegKey(keyHandle, tempSubKey, samDesired, key, regBufferMap);
+}
+
+MOS_STATUS MosUtilities::MosCloseRegKey(
+    UFKEY_NEXT keyHandle)
+{
+    MOS_UNUSED(keyHandle);
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS MosUtilities::MosReadEnvVariable(
+    UFKEY_NEXT keyHandle,
+    const std::string &valueName,
+    uint32_t *type,
+    std::string &data,
+    uint32_t *size)
+{
+    MOS_OS_CHK_NULL_RETURN(size);
+    MOS_UNUSED(type);
+
+    MOS_STATUS status = MOS_STATUS_SUCCESS;
+
+    std::string name = valueName;
+    std::replace(name.begin(), name.end(), ' ', '_');
+    char *retVal = getenv(name.c_str());
+    if (retVal != nullptr)
+    {
+        std::string strData = retVal;
+        *size               = strData.length();
+        data                = strData;
+        return MOS_STATUS_SUCCESS;
+    }
+
+    return MOS_STATUS_INVALID_PARAMETER;
+}
+
+MOS_STATUS MosUtilities::MosGetRegValue(
+    UFKEY_NEXT keyHandle,
+    const std::string &valueName,
+    uint32_t *type,
+    std::string &data,
+    uint32_t *size,
+    RegBufferMap &regBufferMap)
+{
+    MOS_OS_CHK_NULL_RETURN(size);
+    MOS_UNUSED(type);
+
+    MOS_STATUS status = MOS_STATUS_SUCCESS;
+
+    if (regBufferMap.end() == regBufferMap.find(keyHandle))
+    {
+        return MOS_STATUS_USER_FEATURE_KEY_OPEN_FAILED;
+    }
+
+    try
+    {
+        auto keys = regBufferMap[keyHandle];
+        auto it = keys.find(valueName);
+        if (it == keys.end())
+        {
+            return MOS_STATUS_USER_FEATURE_KEY_OPEN_FAILED;
+        }
+
+        data = it->second;
+    }
+    catch(const std::exception &e)
+    {
+        status = MOS_STATUS_INVALID_PARAMETER;
+    }
+
+    return status;
+}
+
+MOS_STATUS MosUtilities::MosSetRegValue(
+    UFKEY_NEXT keyHandle,
+    const std::string &valueName,
+    uint32_t type,
+    const std::string &data,
+    RegBufferMap &regBufferMap)
+{
+    MOS_UNUSED(type);
+
+    if (regBufferMap.end() == regBufferMap.find(keyHandle))
+    {
+        return MOS_STATUS_INVALID_PARAMETER;
+    }
+
+    MOS_STATUS status = MOS_STATUS_SUCCESS;
+    try
+    {
+        auto &keys = regBufferMap[keyHandle];
+
+        keys[valueName] = data;
+    }
+    catch(const std::exception &e)
+    {
+        status = MOS_STATUS_INVALID_PARAMETER;
+    }
+
+    return status;
+}
@@ -0,0 +1,108 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     mos_util_debug.h
+//! \brief    MOS messages and checks for the benchmarks
+//! \details  Assert messages go to stderr and are counted, see MosBenchAssertCount(),
+//!           the other messages are dropped.
+//!
+#ifndef __MOS_UTIL_DEBUG_H__
+#define __MOS_UTIL_DEBUG_H__
+
+#include <stdio.h>
+#include <atomic>
+#include "mos_defs.h"
+
+enum MOS_COMPONENT_ID
+{
+    MOS_COMPONENT_OS,
+    MOS_COMPONENT_HW,
+    MOS_COMPONENT_LIBVA,
+    MOS_COMPONENT_CODEC,
+    MOS_COMPONENT_VP,
+    MOS_COMPONENT_CP,
+    MOS_COMPONENT_DDI,
+    MOS_COMPONENT_CM,
+};
+
+#define MOS_SUBCOMP_SELF   0
+#define MOS_HW_SUBCOMP_ALL 0
+
+//!
+//! \brief  Number of assert messages printed so far
+//!
+inline std::atomic<int32_t> &MosBenchAssertCount()
+{
+    static std::atomic<int32_t> count(0);
+    return count;
+}
+
+#define MOS_ASSERT(_comp, _subcomp, _expr)
+#define MOS_ASSERTMESSAGE(_comp, _subcomp, _message, ...)                    \
+    do                                                                       \
+    {                                                                        \
+        MosBenchAssertCount()++;                                             \
+        fprintf(stderr, "%s: " _message "\n", __FUNCTION__, ##__VA_ARGS__);  \
+    } while (0)
+#define MOS_CRITICALMESSAGE(_comp, _subcomp, _message, ...) MOS_ASSERTMESSAGE(_comp, _subcomp, _message, ##__VA_ARGS__)
+#define MOS_NORMALMESSAGE(_comp, _subcomp, _message, ...)
+#define MOS_VERBOSEMESSAGE(_comp, _subcomp, _message, ...)
+#define MOS_FUNCTION_ENTER(_comp, _subcomp)
+#define MOS_FUNCTION_ENTER_VERBOSE(_comp, _subcomp)
+
+#define MOS_CHK_NULL_RETURN(_comp, _subcomp, _ptr)                             \
+    do                                                                         \
+    {                                                                          \
+        if ((_ptr) == nullptr)                                                 \
+        {                                                                      \
+            MOS_ASSERTMESSAGE(_comp, _subcomp, "Invalid (nullptr) Pointer.");  \
+            return MOS_STATUS_NULL_POINTER;                                    \
+        }                                                                      \
+    } while (0)
+#define MOS_CHK_NULL_NO_STATUS_RETURN(_comp, _subcomp, _ptr)                   \
+    do                                                                         \
+    {                                                                          \
+        if ((_ptr) == nullptr)                                                 \
+        {                                                                      \
+            MOS_ASSERTMESSAGE(_comp, _subcomp, "Invalid (nullptr) Pointer.");  \
+            return;                                                            \
+        }                                                                      \
+    } while (0)
+#define MOS_CHK_STATUS_RETURN(_comp, _subcomp, _stmt)                          \
+    do                                                                         \
+    {                                                                          \
+        MOS_STATUS stmtStatus = (MOS_STATUS)(_stmt);                           \
+        if (stmtStatus != MOS_STATUS_SUCCESS)                                  \
+        {                                                                      \
+            return stmtStatus;                                                 \
+        }                                                                      \
+    } while (0)
+
+#define MOS_OS_ASSERT(_expr)                         MOS_ASSERT(MOS_COMPONENT_OS, MOS_SUBCOMP_SELF, _expr)
+#define MOS_OS_ASSERTMESSAGE(_message, ...)          MOS_ASSERTMESSAGE(MOS_COMPONENT_OS, MOS_SUBCOMP_SELF, _message, ##__VA_ARGS__)
+#define MOS_OS_NORMALMESSAGE(_message, ...)
+#define MOS_OS_VERBOSEMESSAGE(_message, ...)
+#define MOS_OS_FUNCTION_ENTER
+#define MOS_OS_CHK_NULL_RETURN(_ptr)                 MOS_CHK_NULL_RETURN(MOS_COMPONENT_OS, MOS_SUBCOMP_SELF, _ptr)
+#define MOS_OS_CHK_STATUS_RETURN(_stmt)              MOS_CHK_STATUS_RETURN(MOS_COMPONENT_OS, MOS_SUBCOMP_SELF, _stmt)
+
+#endif  // __MOS_UTIL_DEBUG_H__
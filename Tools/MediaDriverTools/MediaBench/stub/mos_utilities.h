@@ -0,0 +1,128 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     mos_utilities.h
+//! \brief    MOS memory, lock and registry utilities for the benchmarks
+//! \details  The registry and env functions are declared as in the Linux
+//!           mos_utilities_specific.cpp, mos_reg_stub.cpp defines them with the
+//!           registry held in memory. Locks and semaphores the benchmarks do not
+//!           contend on are no-ops.
+//!
+#ifndef __MOS_UTILITIES_H__
+#define __MOS_UTILITIES_H__
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <map>
+#include <mutex>
+#include <new>
+#include <string>
+#include "mos_defs.h"
+#include "mos_resource_defs.h"
+#include "mos_util_debug.h"
+
+#define MEDIA_USER_SETTING_INTERNAL     0x1
+#define MOS_USER_CONTROL_MAX_DATA_SIZE  2048
+#define UFKEY_INTERNAL_NEXT             ""
+#define USER_SETTING_CONFIG_PATH        "[config]"
+#define USER_SETTING_REPORT_PATH        "[report]"
+#define KEY_READ                        0
+#define KEY_WRITE                       1
+#define UF_SZ                           1
+
+typedef std::map<std::string, std::map<std::string, std::string>> RegBufferMap;
+
+//!
+//! \brief  Registry MosInitializeReg() loads instead of the user feature file
+//!
+RegBufferMap &MosBenchRegistry();
+
+typedef struct _MOS_USER_FEATURE_KEY_PATH_INFO
+{
+    const char *Path;
+} MOS_USER_FEATURE_KEY_PATH_INFO;
+
+#define MOS_New(classType, ...) new (std::nothrow) classType(__VA_ARGS__)
+#define MOS_Delete(_ptr)   \
+    do                     \
+    {                      \
+        delete (_ptr);     \
+        (_ptr) = nullptr;  \
+    } while (0)
+
+#define MOS_AllocMemory(_size)          malloc(_size)
+#define MOS_AllocAndZeroMemory(_size)   calloc(1, (_size))
+#define MOS_FreeMemory(_ptr)            free(_ptr)
+#define MOS_ZeroMemory(_dst, _size)     memset((_dst), 0, (_size))
+#define MOS_SecureMemcpy(_dst, _dstSize, _src, _srcSize) (memcpy((_dst), (_src), (_srcSize)), MOS_STATUS_SUCCESS)
+#define MOS_SecureStringPrint(_buffer, _bufSize, _length, _format, ...) snprintf((_buffer), (_bufSize), (_format), ##__VA_ARGS__)
+
+class MosMutex
+{
+public:
+    void Lock()
+    {
+        m_mutex.lock();
+    }
+    void Unlock()
+    {
+        m_mutex.unlock();
+    }
+
+private:
+    std::mutex m_mutex;
+};
+
+class MosUtilities
+{
+public:
+    static MOS_STATUS MosInitializeReg(RegBufferMap &regBufferMap);
+    static MOS_STATUS MosUninitializeReg(RegBufferMap &regBufferMap);
+    static MOS_STATUS MosCreateRegKey(UFKEY_NEXT keyHandle, const std::string &subKey, uint32_t samDesired, PUFKEY_NEXT key, RegBufferMap &regBufferMap);
+    static MOS_STATUS MosOpenRegKey(UFKEY_NEXT keyHandle, const std::string &subKey, uint32_t samDesired, PUFKEY_NEXT key, RegBufferMap &regBufferMap);
+    static MOS_STATUS MosCloseRegKey(UFKEY_NEXT keyHandle);
+    static MOS_STATUS MosReadEnvVariable(UFKEY_NEXT keyHandle, const std::string &valueName, uint32_t *type, std::string &data, uint32_t *size);
+    static MOS_STATUS MosGetRegValue(UFKEY_NEXT keyHandle, const std::string &valueName, uint32_t *type, std::string &data, uint32_t *size, RegBufferMap &regBufferMap);
+    static MOS_STATUS MosSetRegValue(UFKEY_NEXT keyHandle, const std::string &valueName, uint32_t type, const std::string &data, RegBufferMap &regBufferMap);
+
+    static void           MosLockMutex(PMOS_MUTEX) {}
+    static void           MosUnlockMutex(PMOS_MUTEX) {}
+    static PMOS_SEMAPHORE MosCreateSemaphore(uint32_t, uint32_t) { return nullptr; }
+    static void           MosDestroySemaphore(PMOS_SEMAPHORE) {}
+    static MOS_STATUS     MosWaitSemaphore(PMOS_SEMAPHORE, uint32_t) { return MOS_STATUS_SUCCESS; }
+    static void           MosPostSemaphore(PMOS_SEMAPHORE, uint32_t) {}
+
+    static MOS_STATUS MosWriteFileFromPtr(const char *fileName, void *data, uint32_t size)
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+
+    // mos_utilities_swizzle.cpp
+    static int32_t MosSwizzleOffset(int32_t OffsetX, int32_t OffsetY, int32_t Pitch, MOS_TILE_TYPE TileFormat, int32_t CsxSwizzle, int32_t flags);
+    static void    MosSwizzleData(uint8_t *pSrc, uint8_t *pDst, MOS_TILE_TYPE SrcTiling, MOS_TILE_TYPE DstTiling, int32_t iHeight, int32_t iPitch, int32_t extFlags);
+    static void    MosSwizzleDataRows(uint8_t *pSrc, uint8_t *pDst, MOS_TILE_TYPE SrcTiling, MOS_TILE_TYPE DstTiling, int32_t iStartRow, int32_t iNumRows, int32_t iPitch, int32_t extFlags);
+
+    static bool m_mosUltFlag;
+};
+
+#endif  // __MOS_UTILITIES_H__
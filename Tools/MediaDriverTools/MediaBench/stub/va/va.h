@@ -0,0 +1,62 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     va.h
+//! \brief    The libva types and fourccs the benchmarked sources need, nothing of libva is called
+//!
+#ifndef __VA_H__
+#define __VA_H__
+#include <stdint.h>
+
+typedef int VAStatus;
+typedef void *VADisplay;
+typedef unsigned int VASurfaceID;
+#define VA_CHECK_VERSION(major, minor, micro) 1
+#define VA_FOURCC(ch0, ch1, ch2, ch3) ((uint32_t)(uint8_t)(ch0) | ((uint32_t)(uint8_t)(ch1) << 8) | ((uint32_t)(uint8_t)(ch2) << 16) | ((uint32_t)(uint8_t)(ch3) << 24))
+
+#define VA_FOURCC_411P VA_FOURCC('4', '1', '1', 'P')
+#define VA_FOURCC_411R VA_FOURCC('4', '1', '1', 'R')
+#define VA_FOURCC_422H VA_FOURCC('4', '2', '2', 'H')
+#define VA_FOURCC_422V VA_FOURCC('4', '2', '2', 'V')
+#define VA_FOURCC_444P VA_FOURCC('4', '4', '4', 'P')
+#define VA_FOURCC_AI44 VA_FOURCC('A', 'I', '4', '4')
+#define VA_FOURCC_AYUV VA_FOURCC('A', 'Y', 'U', 'V')
+#define VA_FOURCC_BGRP VA_FOURCC('B', 'G', 'R', 'P')
+#define VA_FOURCC_IMC3 VA_FOURCC('I', 'M', 'C', '3')
+#define VA_FOURCC_NV12 VA_FOURCC('N', 'V', '1', '2')
+#define VA_FOURCC_P010 VA_FOURCC('P', '0', '1', '0')
+#define VA_FOURCC_P012 VA_FOURCC('P', '0', '1', '2')
+#define VA_FOURCC_P016 VA_FOURCC('P', '0', '1', '6')
+#define VA_FOURCC_P208 VA_FOURCC('P', '2', '0', '8')
+#define VA_FOURCC_RGBP VA_FOURCC('R', 'G', 'B', 'P')
+#define VA_FOURCC_UYVY VA_FOURCC('U', 'Y', 'V', 'Y')
+#define VA_FOURCC_XYUV VA_FOURCC('X', 'Y', 'U', 'V')
+#define VA_FOURCC_Y210 VA_FOURCC('Y', '2', '1', '0')
+#define VA_FOURCC_Y212 VA_FOURCC('Y', '2', '1', '2')
+#define VA_FOURCC_Y216 VA_FOURCC('Y', '2', '1', '6')
+#define VA_FOURCC_Y410 VA_FOURCC('Y', '4', '1', '0')
+#define VA_FOURCC_Y412 VA_FOURCC('Y', '4', '1', '2')
+#define VA_FOURCC_Y416 VA_FOURCC('Y', '4', '1', '6')
+#define VA_FOURCC_YUY2 VA_FOURCC('Y', 'U', 'Y', '2')
+#define VA_FOURCC_YV12 VA_FOURCC('Y', 'V', '1', '2')
+
+#endif  // __VA_H__
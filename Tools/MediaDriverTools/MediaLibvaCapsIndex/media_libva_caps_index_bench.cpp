@@ -0,0 +1,278 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     media_libva_caps_index_bench.cpp
+//! \brief    CPU time of the caps lookups done per config, table scan against index
+//! \details  Usage: MediaLibvaCapsIndexBench [configs]
+//!           The profile & entrypoint table has the shape of a Gen12 one. Each config runs
+//!           the lookups of vaGetConfigAttributes, vaCreateConfig, vaQueryConfigAttributes
+//!           and vaCreateContext, cycling through all profile & entrypoint entries.
+//!
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <map>
+#include <vector>
+#include "media_libva_caps_index.h"
+#include "media_bench.h"
+
+// VA values as in va.h
+enum
+{
+    VAEntrypointVLD         = 1,
+    VAEntrypointEncSlice    = 6,
+    VAEntrypointEncPicture  = 7,
+    VAEntrypointEncSliceLP  = 8,
+    VAEntrypointVideoProc   = 10,
+    VAEntrypointFEI         = 11,
+    VAEntrypointStats       = 12,
+};
+
+enum
+{
+    videoEncode,
+    videoDecode,
+    videoProcess,
+};
+
+static const uint32_t attribTypeNum       = 60;
+static const uint32_t attribNotSupported  = 0x80000000;
+
+struct ProfileEntrypoint
+{
+    int32_t                         profile;
+    int32_t                         entrypoint;
+    uint32_t                        codecType;
+    std::map<uint32_t, uint32_t>    *attributes;
+    int32_t                         configStartIdx;
+    int32_t                         configNum;
+};
+
+class Caps
+{
+public:
+    Caps()
+    {
+        // Decode for 20 profiles, encode for 10, low power encode for 8, FEI for 3, VP and stats
+        int32_t configCount[3] = {};
+        for (int32_t profile = 0; profile < 20; profile++)
+        {
+            AddEntry(profile, VAEntrypointVLD, videoDecode, 2 + profile % 3, configCount);
+        }
+        for (int32_t profile = 0; profile < 10; profile++)
+        {
+            AddEntry(profile * 2, VAEntrypointEncSlice, videoEncode, 18, configCount);
+        }
+        for (int32_t profile = 0; profile < 8; profile++)
+        {
+            AddEntry(profile * 2 + 1, VAEntrypointEncSliceLP, videoEncode, 18, configCount);
+        }
+        for (int32_t profile = 0; profile < 3; profile++)
+        {
+            AddEntry(profile + 5, VAEntrypointFEI, videoEncode, 4, configCount);
+        }
+        AddEntry(12, VAEntrypointEncPicture, videoEncode, 1, configCount);
+        AddEntry(-1, VAEntrypointVideoProc, videoProcess, 1, configCount);
+        AddEntry(-1, VAEntrypointStats, videoEncode, 1, configCount);
+
+        m_index.InitAttribs(m_table.size(), attribTypeNum);
+        for (uint32_t i = 0; i < m_table.size(); i++)
+        {
+            m_index.AddProfileEntry(m_table[i].profile, m_table[i].entrypoint, i);
+            for (auto &attrib : *m_table[i].attributes)
+            {
+                m_index.SetAttrib(i, attrib.first, attrib.second);
+            }
+        }
+        for (uint32_t codecType = videoEncode; codecType <= videoProcess; codecType++)
+        {
+            for (uint32_t i = 0; i < m_table.size(); i++)
+            {
+                if (m_table[i].codecType == codecType)
+                {
+                    m_index.AddConfigs(codecType, m_table[i].configStartIdx, m_table[i].configNum, i);
+                }
+            }
+        }
+        m_index.SetValid();
+    }
+
+    ~Caps()
+    {
+        for (auto &entry : m_table)
+        {
+            delete entry.attributes;
+        }
+    }
+
+    int32_t GetProfileTableIdx(bool useIndex, int32_t profile, int32_t entrypoint)
+    {
+        if (useIndex)
+        {
+            return m_index.FindProfileEntry(profile, entrypoint);
+        }
+        int32_t ret = -1;
+        for (int32_t i = 0; i < (int32_t)m_table.size(); i++)
+        {
+            if (m_table[i].profile == profile)
+            {
+                ret = -2;
+                if (m_table[i].entrypoint == entrypoint)
+                {
+                    return i;
+                }
+            }
+        }
+        return ret;
+    }
+
+    int32_t GetConfigIdx(bool useIndex, uint32_t codecType, int32_t configOffset)
+    {
+        if (useIndex)
+        {
+            return m_index.FindConfig(codecType, configOffset);
+        }
+        for (int32_t i = 0; i < (int32_t)m_table.size(); i++)
+        {
+            if (m_table[i].codecType == codecType &&
+                configOffset >= m_table[i].configStartIdx &&
+                configOffset < m_table[i].configStartIdx + m_table[i].configNum)
+            {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    bool GetAttrib(bool useIndex, int32_t idx, uint32_t type, uint32_t &value)
+    {
+        if (useIndex)
+        {
+            return m_index.GetAttrib(idx, type, value);
+        }
+        auto it = m_table[idx].attributes->find(type);
+        if (it == m_table[idx].attributes->end())
+        {
+            return false;
+        }
+        value = it->second;
+        return true;
+    }
+
+    uint32_t QueryAttribs(bool useIndex, int32_t idx)
+    {
+        uint32_t sum = 0;
+        if (useIndex)
+        {
+            for (uint32_t type = 0; type < m_index.GetAttribTypeNum(); type++)
+            {
+                uint32_t value = 0;
+                if (m_index.GetAttrib(idx, type, value) && value != attribNotSupported)
+                {
+                    sum += type + value;
+                }
+            }
+            return sum;
+        }
+        for (auto &attrib : *m_table[idx].attributes)
+        {
+            if (attrib.second != attribNotSupported)
+            {
+                sum += attrib.first + attrib.second;
+            }
+        }
+        return sum;
+    }
+
+    std::vector<ProfileEntrypoint> m_table;
+    MediaLibvaCapsIndex            m_index;
+
+private:
+    void AddEntry(int32_t profile, int32_t entrypoint, uint32_t codecType, int32_t configNum, int32_t *configCount)
+    {
+        ProfileEntrypoint entry = {profile, entrypoint, codecType, new std::map<uint32_t, uint32_t>,
+            configCount[codecType], configNum};
+        // Around 20 attributes per entry
+        for (uint32_t type = (profile + entrypoint) % 3; type < attribTypeNum; type += 3)
+        {
+            (*entry.attributes)[type] = (type % 7 == 0) ? attribNotSupported : type * 16 + entrypoint;
+        }
+        configCount[codecType] += configNum;
+        m_table.push_back(entry);
+    }
+};
+
+// Lookups of one config: vaGetConfigAttributes, vaCreateConfig, vaQueryConfigAttributes, vaCreateContext
+static uint32_t CreateConfig(Caps &caps, bool useIndex, const ProfileEntrypoint &entry)
+{
+    static const uint32_t appAttribs[] = {0, 3, 6, 9, 12, 21};
+    uint32_t              sum          = 0;
+    uint32_t              value        = 0;
+
+    int32_t idx = caps.GetProfileTableIdx(useIndex, entry.profile, entry.entrypoint);
+    for (auto type : appAttribs)
+    {
+        sum += caps.GetAttrib(useIndex, idx, type, value) ? value : 1;
+    }
+
+    idx = caps.GetProfileTableIdx(useIndex, entry.profile, entry.entrypoint);      // CreateConfig
+    idx = caps.GetProfileTableIdx(useIndex, entry.profile, entry.entrypoint);      // CheckAttribList
+    for (auto type : appAttribs)
+    {
+        sum += caps.GetAttrib(useIndex, idx, type, value) ? value : 1;
+    }
+
+    int32_t configOffset = entry.configStartIdx + entry.configNum - 1;
+    idx = caps.GetConfigIdx(useIndex, entry.codecType, configOffset);              // QueryConfigAttributes
+    sum += caps.QueryAttribs(useIndex, idx);
+    idx = caps.GetConfigIdx(useIndex, entry.codecType, configOffset);              // CreateContext
+    return sum + idx;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t configNum = MediaBenchArg(argc, argv, 1, 1000000);
+    Caps     caps;
+    double   ns[2]  = {};
+    uint64_t sum[2] = {};
+
+    for (uint32_t useIndex = 0; useIndex < 2; useIndex++)
+    {
+        MediaBenchTimer timer;
+        for (uint32_t i = 0; i < configNum; i++)
+        {
+            sum[useIndex] += CreateConfig(caps, useIndex != 0, caps.m_table[i % caps.m_table.size()]);
+        }
+        ns[useIndex] = timer.Ns();
+    }
+
+    printf("entries  configs  table scan ns/config  index ns/config\n");
+    printf("%7u  %7u  %20.1f  %15.1f\n", (uint32_t)caps.m_table.size(), configNum,
+        ns[0] / configNum, ns[1] / configNum);
+    if (sum[0] != sum[1])
+    {
+        fprintf(stderr, "Results differ\n");
+        return -1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,121 @@
+#
+# Copyright (c) 2026, Intel Corporation
+#
+# Permission is hereby granted, free of charge, to any person obtaining a
+# copy of this software and associated documentation files (the "Software"),
+# to deal in the Software without restriction, including without limitation
+# the rights to use, copy, modify, merge, publish, distribute, sublicense,
+# and/or sell copies of the Software, and to permit persons to whom the
+# Software is furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included
+# in all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+# OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+# THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+# OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+# ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+# OTHER DEALINGS IN THE SOFTWARE.
+
+# Convert the trace file written with GFX_MEDIA_TRACE_FILE to Chrome trace json,
+# see mos_trace_ring_specific.h for the file layout.
+
+import os, sys, re, struct, json
+import argparse
+
+FILE_MAGIC      = 0x4252544D
+FILE_HEADER     = struct.Struct('<IIIIQQQ')
+RECORD_HEADER   = struct.Struct('<HHIQ')
+RECORD_ALIGN    = 8
+RECORD_EVENT    = 0
+RECORD_DROP     = 1
+
+EVENT_MAGIC     = 0x494D5445
+EVENT_HEADER    = struct.Struct('<III')
+EVENT_PHASE     = {0: 'i', 1: 'B', 2: 'E', 3: 'i'}
+
+def load_event_names(header_file):
+    names = {}
+    with open(header_file, 'r', errors="ignore") as fh:
+        body = fh.read()
+    block = re.search(r'typedef enum _MEDIA_EVENT\s*\{(.*?)\}\s*MEDIA_EVENT;', body, re.S)
+    if not block:
+        return names
+    value = 0
+    for line in block.group(1).splitlines():
+        line = line.split('//')[0].strip().rstrip(',')
+        if not line:
+            continue
+        if '=' in line:
+            name, val = [s.strip() for s in line.split('=')]
+            value = int(val, 0)
+        else:
+            name = line
+        names[value] = name
+        value += 1
+    return names
+
+def decode(trace_file, names):
+    with open(trace_file, 'rb') as fh:
+        data = fh.read()
+
+    if len(data) < FILE_HEADER.size:
+        raise ValueError('%s: file too small' % trace_file)
+    magic, version, header_size, pid, data_size, dropped, start = FILE_HEADER.unpack_from(data, 0)
+    if magic != FILE_MAGIC:
+        raise ValueError('%s: bad magic 0x%x' % (trace_file, magic))
+
+    events = []
+    pos = header_size
+    end = min(len(data), header_size + data_size)
+    while pos + RECORD_HEADER.size <= end:
+        size, rtype, tid, timestamp = RECORD_HEADER.unpack_from(data, pos)
+        payload = data[pos + RECORD_HEADER.size : pos + RECORD_HEADER.size + size]
+        pos += (RECORD_HEADER.size + size + RECORD_ALIGN - 1) & ~(RECORD_ALIGN - 1)
+        ts = (timestamp - start) / 1000.0
+
+        if rtype == RECORD_DROP:
+            count = struct.unpack_from('<I', payload, 0)[0]
+            events.append({'name': 'dropped', 'ph': 'i', 's': 't', 'ts': ts, 'pid': pid, 'tid': tid,
+                           'args': {'count': count}})
+            continue
+        if rtype != RECORD_EVENT or size < EVENT_HEADER.size:
+            continue
+
+        tag, id_size, etype = EVENT_HEADER.unpack_from(payload, 0)
+        if tag != EVENT_MAGIC:
+            continue
+        event_id = id_size >> 16
+        event = {'name': names.get(event_id, 'event_%d' % event_id),
+                 'ph': EVENT_PHASE.get(etype, 'i'),
+                 'ts': ts, 'pid': pid, 'tid': tid}
+        if event['ph'] == 'i':
+            event['s'] = 't'
+        body = payload[EVENT_HEADER.size : EVENT_HEADER.size + (id_size & 0xffff)]
+        if body:
+            event['args'] = {'type': etype, 'data': body.hex()}
+        events.append(event)
+
+    return {'traceEvents': events, 'displayTimeUnit': 'ns',
+            'otherData': {'version': version, 'droppedCount': dropped}}
+
+def main():
+    parser = argparse.ArgumentParser(description='Convert media trace file to Chrome trace json')
+    parser.add_argument('input', help='trace file written with GFX_MEDIA_TRACE_FILE')
+    parser.add_argument('-o', '--output', help='json file, default is input with .json suffix')
+    parser.add_argument('-e', '--events', help='mos_os_trace_event.h to name the events')
+    args = parser.parse_args()
+
+    names = load_event_names(args.events) if args.events else {}
+    trace = decode(args.input, names)
+    output = args.output if args.output else os.path.splitext(args.input)[0] + '.json'
+    with open(output, 'w') as fh:
+        json.dump(trace, fh)
+
+    print('%d events, %d dropped, written to %s' % (len(trace['traceEvents']), trace['otherData']['droppedCount'], output))
+    return 0
+
+if __name__ == '__main__':
+    sys.exit(main())
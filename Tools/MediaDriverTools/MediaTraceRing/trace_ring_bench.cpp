@@ -0,0 +1,102 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     trace_ring_bench.cpp
+//! \brief    Events per second of the ring buffer trace backend, produced and written
+//! \details  Usage: TraceRingBench [file] [threads] [events per thread] [ring KB]
+//!
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+#include <vector>
+#include "mos_trace_ring_specific.h"
+#include "media_bench.h"
+
+static void WriteEvents(uint32_t eventNum, double *seconds)
+{
+    // same layout as MosTraceEvent: IMTE tag, id << 16 | data size, type, then data
+    uint32_t event[8] = {0x494D5445, (1 << 16) | 20, 1, 0, 0, 0, 0, 0};
+
+    MediaBenchTimer timer;
+    for (uint32_t i = 0; i < eventNum; i++)
+    {
+        event[2] = (i & 1) ? 2 : 1;
+        event[3] = i;
+        MosTraceRing::Write(event, sizeof(event));
+    }
+    *seconds = timer.Seconds();
+}
+
+int main(int argc, char **argv)
+{
+    const char *file      = MediaBenchStringArg(argc, argv, 1, "media_trace.bin");
+    uint32_t    maxThread = MediaBenchArg(argc, argv, 2, std::thread::hardware_concurrency());
+    uint32_t    eventNum  = MediaBenchArg(argc, argv, 3, 1000000);
+    uint32_t    ringSize  = MediaBenchArg(argc, argv, 4, MOS_TRACE_RING_DEFAULT_RING_SIZE >> 10) << 10;
+
+    if (maxThread == 0)
+    {
+        maxThread = 1;
+    }
+
+    // produced/s is the producer side cost, dropped events included. written/s counts
+    // the events that reached the file, from the first write until Close() drained the rings.
+    printf("threads  produced/s/thread  written/s total    written    dropped  file\n");
+    for (uint32_t threadNum = 1; threadNum <= maxThread; threadNum <<= 1)
+    {
+        uint64_t fileSize = (uint64_t)threadNum * eventNum * 48 + (1 << 20);
+        if (!MosTraceRing::Open(file, ringSize, fileSize))
+        {
+            fprintf(stderr, "Failed to open %s\n", file);
+            return -1;
+        }
+
+        std::vector<std::thread> threads;
+        std::vector<double>      seconds(threadNum);
+        MediaBenchTimer timer;
+        for (uint32_t i = 0; i < threadNum; i++)
+        {
+            threads.emplace_back(WriteEvents, eventNum, &seconds[i]);
+        }
+        for (auto &thread : threads)
+        {
+            thread.join();
+        }
+        MosTraceRing::Close();
+        double total = timer.Seconds();
+
+        double perThread = 0;
+        for (auto s : seconds)
+        {
+            perThread += eventNum / s;
+        }
+        perThread /= threadNum;
+        uint64_t dropped = MosTraceRing::GetDroppedCount();
+        uint64_t written = (uint64_t)threadNum * eventNum - dropped;
+        printf("%7u  %17.0f  %15.0f  %9llu  %9llu  %s\n", threadNum, perThread, written / total,
+            (unsigned long long)written, (unsigned long long)dropped, MosTraceRing::GetFilePath());
+    }
+
+    return 0;
+}
@@ -0,0 +1,125 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     heap_stub.cpp
+//! \brief    Heap and frame tracker token backed by host memory, so the block
+//!           manager runs without a graphics device
+//!
+
+#include <stdlib.h>
+#include "heap.h"
+#include "frame_tracker.h"
+
+Heap::Heap()
+{
+    m_id = m_invalidId;
+}
+
+Heap::Heap(uint32_t id)
+{
+    m_id = id;
+}
+
+Heap::~Heap()
+{
+    if (m_resource)
+    {
+        free(m_resource->pData);
+        delete m_resource;
+    }
+}
+
+MOS_STATUS Heap::RegisterOsInterface(PMOS_INTERFACE osInterface)
+{
+    HEAP_CHK_NULL(osInterface);
+    m_osInterface = osInterface;
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS Heap::Allocate(uint32_t heapSize, bool keepLocked)
+{
+    if (heapSize == 0 || m_resource != nullptr)
+    {
+        HEAP_ASSERTMESSAGE("Invalid heap allocation");
+        return MOS_STATUS_INVALID_PARAMETER;
+    }
+
+    m_resource = new (std::nothrow) MOS_RESOURCE();
+    HEAP_CHK_NULL(m_resource);
+    m_resource->pData = (uint8_t *)calloc(1, heapSize);
+    HEAP_CHK_NULL(m_resource->pData);
+
+    if (keepLocked)
+    {
+        m_lockedHeap = m_resource->pData;
+        m_keepLocked = keepLocked;
+    }
+    m_size      = heapSize;
+    m_freeSpace = m_size;
+
+    return MOS_STATUS_SUCCESS;
+}
+
+uint8_t *Heap::Lock()
+{
+    return m_resource ? m_resource->pData : nullptr;
+}
+
+MOS_STATUS Heap::Dump()
+{
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS Heap::AdjustFreeSpace(uint32_t addedSpace)
+{
+    if (addedSpace + m_freeSpace > m_size || m_usedSpace < addedSpace)
+    {
+        HEAP_ASSERTMESSAGE("Provided space will not fit in the heap");
+        return MOS_STATUS_INVALID_PARAMETER;
+    }
+    m_freeSpace += addedSpace;
+    m_usedSpace -= addedSpace;
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS Heap::AdjustUsedSpace(uint32_t addedSpace)
+{
+    if (addedSpace + m_usedSpace > m_size || m_freeSpace < addedSpace || m_freeInProgress)
+    {
+        HEAP_ASSERTMESSAGE("Provided space will not fit in the heap");
+        return MOS_STATUS_INVALID_PARAMETER;
+    }
+    m_freeSpace -= addedSpace;
+    m_usedSpace += addedSpace;
+    return MOS_STATUS_SUCCESS;
+}
+
+// The benchmark registers a tracker resource, not a producer
+bool FrameTrackerToken::IsExpired()
+{
+    return true;
+}
+
+void FrameTrackerToken::Merge(const FrameTrackerToken *token)
+{
+    m_holdTrackers.insert(token->m_holdTrackers.begin(), token->m_holdTrackers.end());
+}
@@ -0,0 +1,215 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     memory_block_manager_bench.cpp
+//! \brief    Block churn through MemoryBlockManager with the heap in host memory
+//! \details  Usage: MemoryBlockManagerBench [requests]
+//!           Each request acquires 1 to maxBlocks blocks of 64 B to 80 KB and
+//!           submits them under the current frame's tracker ID, a frame being 64
+//!           requests. The tracker lags 6 frames behind, plus a random lifetime of
+//!           up to lifetimeFrames frames per request. On NO_SPACE the tracker
+//!           catches up and the request is dropped. Every scenario is run once
+//!           with an overlap check of the live blocks, then timed.
+//!
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <map>
+#include <random>
+#include <vector>
+#include "memory_block_manager.h"
+#include "media_bench.h"
+
+// Friend of MemoryBlockManager, as in the driver
+class HeapManager
+{
+public:
+    struct Scenario
+    {
+        const char *name;
+        uint32_t    heapMb;
+        uint32_t    maxBlocks;
+        uint32_t    lifetimeFrames;
+    };
+
+    struct Result
+    {
+        uint64_t blocks;
+        uint64_t noSpace;
+        double   seconds;
+    };
+
+    static MOS_STATUS UnlockResource(PMOS_INTERFACE osInterface, PMOS_RESOURCE resource)
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+
+    bool Run(const Scenario &scenario, uint32_t requests, bool check, Result &result)
+    {
+        MemoryBlockManager manager;
+        MOS_INTERFACE      osInterface = {};
+        uint32_t           tracker     = 0;
+        uint32_t           heapSize    = scenario.heapMb << 20;
+
+        osInterface.pfnUnlockResource = UnlockResource;
+        if (manager.RegisterOsInterface(&osInterface) != MOS_STATUS_SUCCESS ||
+            manager.RegisterTrackerResource(&tracker) != MOS_STATUS_SUCCESS ||
+            manager.RegisterHeap(1, heapSize) != MOS_STATUS_SUCCESS)
+        {
+            return false;
+        }
+
+        std::mt19937                    rng(1234);
+        std::vector<uint32_t>           sizes;
+        std::vector<MemoryBlock>        blocks;
+        std::multimap<uint32_t, Live>   live;  // by tracker ID
+        uint32_t                        frame = 1;
+        result = {};
+
+        MediaBenchTimer timer;
+        for (uint32_t i = 0; i < requests; i++)
+        {
+            if (i % 64 == 0)
+            {
+                frame++;
+                tracker = frame > 6 ? frame - 6 : 0;
+                Retire(live, tracker);
+            }
+
+            sizes.clear();
+            uint32_t num = 1 + rng() % scenario.maxBlocks;
+            for (uint32_t j = 0; j < num; j++)
+            {
+                uint32_t r = rng() % 100;
+                sizes.push_back(r < 60 ? 64 + rng() % 1024 : r < 95 ? 1024 + rng() % 8192 : 16384 + rng() % 65536);
+            }
+            uint32_t trackerId = frame + (scenario.lifetimeFrames ? rng() % scenario.lifetimeFrames : 0);
+
+            MemoryBlockManager::AcquireParams params(trackerId, sizes);
+            uint32_t                          spaceNeeded = 0;
+            MOS_STATUS                        status      = manager.AcquireSpace(params, blocks, spaceNeeded);
+            if (status == MOS_STATUS_CLIENT_AR_NO_SPACE)
+            {
+                result.noSpace++;
+                bool blocksUpdated = false;
+                tracker = frame;
+                Retire(live, tracker);
+                manager.RefreshBlockStates(blocksUpdated);
+                continue;
+            }
+            if (status != MOS_STATUS_SUCCESS || manager.SubmitBlocks(blocks) != MOS_STATUS_SUCCESS)
+            {
+                printf("%s: request %u failed\n", scenario.name, i);
+                return false;
+            }
+            if (check && !Add(live, blocks, trackerId, tracker, scenario.name))
+            {
+                return false;
+            }
+            result.blocks += num;
+        }
+        result.seconds = timer.Seconds();
+
+        // everything retired merges back into one block of the whole heap
+        bool                     blocksUpdated = false;
+        std::vector<uint32_t>    whole         = {heapSize};
+        MemoryBlockManager::AcquireParams params(frame + 1, whole);
+        uint32_t                 spaceNeeded   = 0;
+        tracker = ~0u - 1;
+        manager.RefreshBlockStates(blocksUpdated);
+        if (manager.AcquireSpace(params, blocks, spaceNeeded) != MOS_STATUS_SUCCESS)
+        {
+            printf("%s: free space did not merge back\n", scenario.name);
+            return false;
+        }
+        manager.SubmitBlocks(blocks);
+
+        return MosBenchAssertCount() == 0;
+    }
+
+private:
+    struct Live
+    {
+        uint32_t offset;
+        uint32_t size;
+    };
+
+    static void Retire(std::multimap<uint32_t, Live> &live, uint32_t tracker)
+    {
+        live.erase(live.begin(), live.upper_bound(tracker));
+    }
+
+    static bool Add(std::multimap<uint32_t, Live> &live, std::vector<MemoryBlock> &blocks, uint32_t trackerId, uint32_t tracker, const char *name)
+    {
+        for (auto &block : blocks)
+        {
+            for (auto &entry : live)
+            {
+                if (block.GetOffset() < entry.second.offset + entry.second.size &&
+                    entry.second.offset < block.GetOffset() + block.GetSize())
+                {
+                    printf("%s: block at %u overlaps a live block at %u\n", name, block.GetOffset(), entry.second.offset);
+                    return false;
+                }
+            }
+        }
+        // the tracker already passed, the blocks may be reused on the next refresh
+        if (trackerId <= tracker)
+        {
+            return true;
+        }
+        for (auto &block : blocks)
+        {
+            live.insert({trackerId, {block.GetOffset(), block.GetSize()}});
+        }
+        return true;
+    }
+};
+
+int main(int argc, char **argv)
+{
+    uint32_t requests = MediaBenchArg(argc, argv, 1, 200000);
+
+    static const HeapManager::Scenario scenarios[] = {
+        {"no fragmentation, 4 MB heap", 4, 1, 0},
+        {"random lifetimes (32 frames), 4 MB", 4, 1, 32},
+        {"random lifetimes (32 frames), 16 MB", 16, 1, 32},
+        {"1-4 blocks per request, 4 MB", 4, 4, 32},
+    };
+
+    HeapManager manager;
+    printf("%-40s %10s %10s %10s\n", "scenario", "blocks", "NO_SPACE", "Mblk/s");
+    for (auto &scenario : scenarios)
+    {
+        HeapManager::Result result = {};
+        if (!manager.Run(scenario, requests / 10, true, result) ||
+            !manager.Run(scenario, requests, false, result))
+        {
+            printf("%s: failed, %d heap manager errors\n", scenario.name, (int32_t)MosBenchAssertCount());
+            return -1;
+        }
+        printf("%-40s %10llu %10llu %10.2f\n", scenario.name, (unsigned long long)result.blocks,
+            (unsigned long long)result.noSpace, result.blocks / result.seconds / 1e6);
+    }
+
+    return 0;
+}
@@ -0,0 +1,282 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     mhw_add_cmd_bench.cpp
+//! \brief    MHW commands added per second by mhw::Impl::AddCmd, set in place and through the staging copy
+//! \details  Usage: MhwAddCmdBench [rounds]
+//!
+
+#include <stdio.h>
+#include <vector>
+#include "mhw_impl.h"
+#include "mhw_mi_hwcmd_g12_X.h"
+#include "mhw_vdbox_hcp_hwcmd_g12_X.h"
+#include "mhw_vebox_hwcmd_g12_X.h"
+#include "media_bench.h"
+
+static const uint32_t cmdBufSize = 256 * 1024;
+
+// One MI, VDBOX and VEBOX command of Gen12
+struct BenchCmds
+{
+    using MI_STORE_DATA_IMM_CMD = mhw_mi_g12_X::MI_STORE_DATA_IMM_CMD;
+    using HCP_PIC_STATE_CMD     = mhw_vdbox_hcp_g12_X::HCP_PIC_STATE_CMD;
+    using VEBOX_STATE_CMD       = mhw_vebox_g12_X::VEBOX_STATE_CMD;
+};
+
+struct MI_STORE_DATA_IMM_PAR
+{
+    uint32_t dwValue;
+};
+
+struct HCP_PIC_STATE_PAR
+{
+    uint32_t frameWidthInMinCb;
+    uint32_t frameHeightInMinCb;
+    uint32_t frameNumber;
+    int8_t   cbQpOffset;
+    int8_t   crQpOffset;
+};
+
+struct VEBOX_STATE_PAR
+{
+    bool     dnEnable;
+    bool     diEnable;
+    uint64_t dndiStateOffset;
+    uint64_t iecpStateOffset;
+    bool     storeFrameNumber;  // adds MI_STORE_DATA_IMM from SETCMD_VEBOX_STATE
+    uint32_t frameNumber;
+};
+
+class BenchItf
+{
+public:
+    virtual ~BenchItf() = default;
+
+    _MHW_CMD_ALL_DEF_FOR_ITF(MI_STORE_DATA_IMM);
+    _MHW_CMD_ALL_DEF_FOR_ITF(HCP_PIC_STATE);
+    _MHW_CMD_ALL_DEF_FOR_ITF(VEBOX_STATE);
+};
+
+// SETCMDs in the form of the MI, HCP and VEBOX ones of media_softlet
+class BenchImpl : public BenchItf, public mhw::Impl
+{
+public:
+    using cmd_t  = BenchCmds;
+    using base_t = BenchItf;
+
+    BenchImpl(PMOS_INTERFACE osItf) : mhw::Impl(osItf) {}
+
+protected:
+    _MHW_SETCMD_OVERRIDE_DECL(MI_STORE_DATA_IMM)
+    {
+        _MHW_SETCMD_CALLBASE(MI_STORE_DATA_IMM);
+
+        cmd.DW0.UseGlobalGtt = 0;
+        cmd.DW0.StoreQword   = 0;
+        cmd.DW0.DwordLength--;
+        cmd.DW3.DataDword0 = params.dwValue;
+
+        return MOS_STATUS_SUCCESS;
+    }
+
+    _MHW_SETCMD_OVERRIDE_DECL(HCP_PIC_STATE)
+    {
+        _MHW_SETCMD_CALLBASE(HCP_PIC_STATE);
+
+        cmd.DW1.Framewidthinmincbminus1          = params.frameWidthInMinCb - 1;
+        cmd.DW1.Frameheightinmincbminus1         = params.frameHeightInMinCb - 1;
+        cmd.DW2.Mincusize                        = 0;
+        cmd.DW2.CtbsizeLcusize                   = 2;
+        cmd.DW2.Mintusize                        = 0;
+        cmd.DW2.Maxtusize                        = 3;
+        cmd.DW2.Minpcmsize                       = 0;
+        cmd.DW2.Maxpcmsize                       = 2;
+        cmd.DW3.FrameNumber                      = params.frameNumber & 0xf;
+        cmd.DW4.SampleAdaptiveOffsetEnabledFlag  = 1;
+        cmd.DW4.CuQpDeltaEnabledFlag             = 1;
+        cmd.DW4.DiffCuQpDeltaDepthOrNamedAsMaxDqpDepth = 2;
+        cmd.DW5.PicCbQpOffset                    = params.cbQpOffset & 0x1f;
+        cmd.DW5.PicCrQpOffset                    = params.crQpOffset & 0x1f;
+        cmd.DW5.MaxTransformHierarchyDepthIntraOrNamedAsTuMaxDepthIntra = 2;
+        cmd.DW5.MaxTransformHierarchyDepthInterOrNamedAsTuMaxDepthInter = 2;
+        cmd.DW6.LcuMaxBitsizeAllowed             = 0x1000;
+        cmd.DW7.Framebitratemax                  = 0x3fff;
+        cmd.DW7.Framebitratemaxunit              = 1;
+
+        return MOS_STATUS_SUCCESS;
+    }
+
+    _MHW_SETCMD_OVERRIDE_DECL(VEBOX_STATE)
+    {
+        _MHW_SETCMD_CALLBASE(VEBOX_STATE);
+
+        cmd.DW1.GlobalIecpEnable    = 1;
+        cmd.DW1.DnEnable            = params.dnEnable;
+        cmd.DW1.DiEnable            = params.diEnable;
+        cmd.DW1.DnDiFirstFrame      = params.frameNumber == 0;
+        cmd.DW2.DnDiStatePointerLow = (uint32_t)(params.dndiStateOffset >> 5);
+        cmd.DW3.DnDiStatePointerHigh = (uint32_t)(params.dndiStateOffset >> 32);
+        cmd.DW4.IecpStatePointerLow = (uint32_t)(params.iecpStateOffset >> 5);
+
+        if (params.storeFrameNumber)
+        {
+            auto &storeParams   = MHW_GETPAR_F(MI_STORE_DATA_IMM)();
+            storeParams.dwValue = params.frameNumber;
+            MHW_CHK_STATUS_RETURN(MHW_ADDCMD_F(MI_STORE_DATA_IMM)(this->m_currentCmdBuf, this->m_currentBatchBuf));
+        }
+
+        return MOS_STATUS_SUCCESS;
+    }
+
+    _MHW_CMD_ALL_DEF_FOR_IMPL(MI_STORE_DATA_IMM);
+    _MHW_CMD_ALL_DEF_FOR_IMPL(HCP_PIC_STATE);
+    _MHW_CMD_ALL_DEF_FOR_IMPL(VEBOX_STATE);
+};
+
+// Command buffer in host memory, on a part with or without local memory
+class BenchContext
+{
+public:
+    BenchContext(bool localMemory) : m_cmdBufData(cmdBufSize / sizeof(uint32_t))
+    {
+        m_sku.FtrLocalMemory     = localMemory;
+        m_osItf.pOsContext       = &m_sku;
+        m_osItf.pfnGetSkuTable   = [](PMOS_INTERFACE osItf) { return static_cast<MEDIA_FEATURE_TABLE *>(osItf->pOsContext); };
+        m_impl.reset(new BenchImpl(&m_osItf));
+        Reset();
+    }
+
+    void Reset()
+    {
+        m_cmdBuf.pCmdBase   = m_cmdBufData.data();
+        m_cmdBuf.pCmdPtr    = m_cmdBufData.data();
+        m_cmdBuf.iOffset    = 0;
+        m_cmdBuf.iRemaining = cmdBufSize;
+    }
+
+    MOS_STATUS AddFrame(uint32_t frameNumber, bool storeFrameNumber)
+    {
+        auto &miParams   = m_impl->MHW_GETPAR_F(MI_STORE_DATA_IMM)();
+        miParams.dwValue = frameNumber;
+        MHW_CHK_STATUS_RETURN(m_impl->MHW_ADDCMD_F(MI_STORE_DATA_IMM)(&m_cmdBuf));
+
+        auto &hcpParams              = m_impl->MHW_GETPAR_F(HCP_PIC_STATE)();
+        hcpParams.frameWidthInMinCb  = 240;
+        hcpParams.frameHeightInMinCb = 135;
+        hcpParams.frameNumber        = frameNumber;
+        hcpParams.cbQpOffset         = -2;
+        hcpParams.crQpOffset         = 1;
+        MHW_CHK_STATUS_RETURN(m_impl->MHW_ADDCMD_F(HCP_PIC_STATE)(&m_cmdBuf));
+
+        auto &veboxParams            = m_impl->MHW_GETPAR_F(VEBOX_STATE)();
+        veboxParams.dnEnable         = true;
+        veboxParams.diEnable         = frameNumber & 1;
+        veboxParams.dndiStateOffset  = 0x10000ull + frameNumber * 0x400;
+        veboxParams.iecpStateOffset  = 0x20000ull + frameNumber * 0x400;
+        veboxParams.storeFrameNumber = storeFrameNumber;
+        veboxParams.frameNumber      = frameNumber;
+        return m_impl->MHW_ADDCMD_F(VEBOX_STATE)(&m_cmdBuf);
+    }
+
+    std::unique_ptr<BenchImpl> m_impl;
+    MOS_INTERFACE              m_osItf = {};
+    MEDIA_FEATURE_TABLE        m_sku   = {};
+    MOS_COMMAND_BUFFER         m_cmdBuf = {};
+    std::vector<uint32_t>      m_cmdBufData;
+};
+
+// Commands added per second when the command buffer is filled with one command
+template <typename AddCmd>
+static double CmdPerSecond(BenchContext &ctx, uint32_t cmdSize, uint32_t rounds, AddCmd addCmd)
+{
+    uint32_t        cmdPerBuf = cmdBufSize / cmdSize;
+    MediaBenchTimer timer;
+    for (uint32_t round = 0; round < rounds; round++)
+    {
+        ctx.Reset();
+        for (uint32_t i = 0; i < cmdPerBuf; i++)
+        {
+            addCmd(i);
+        }
+    }
+    return (double)cmdPerBuf * rounds / timer.Seconds();
+}
+
+static void RunCmdBench(const char *name, uint32_t cmdSize, uint32_t rounds, void (*addCmd)(BenchContext &ctx, uint32_t i))
+{
+    BenchContext inPlace(false);
+    BenchContext staging(true);
+
+    double inPlaceRate = CmdPerSecond(inPlace, cmdSize, rounds, [&](uint32_t i) { addCmd(inPlace, i); });
+    double stagingRate = CmdPerSecond(staging, cmdSize, rounds, [&](uint32_t i) { addCmd(staging, i); });
+    printf("%-18s %4u B   %8.1f   %8.1f\n", name, cmdSize, stagingRate / 1e6, inPlaceRate / 1e6);
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t rounds = MediaBenchArg(argc, argv, 1, 2000);
+
+    // a frame of the three commands, with MI_STORE_DATA_IMM added from SETCMD_VEBOX_STATE
+    // every other frame, must come out the same whether commands are set in place or not
+    BenchContext inPlace(false);
+    BenchContext staging(true);
+    for (uint32_t frame = 0; frame < 64; frame++)
+    {
+        if (inPlace.AddFrame(frame, frame & 1) != MOS_STATUS_SUCCESS ||
+            staging.AddFrame(frame, frame & 1) != MOS_STATUS_SUCCESS)
+        {
+            printf("AddCmd failed\n");
+            return 1;
+        }
+    }
+    if (inPlace.m_cmdBuf.iOffset != staging.m_cmdBuf.iOffset ||
+        memcmp(inPlace.m_cmdBufData.data(), staging.m_cmdBufData.data(), inPlace.m_cmdBuf.iOffset) != 0)
+    {
+        printf("Commands set in place differ from the staging copy\n");
+        return 1;
+    }
+    printf("64 frames, %d bytes: set in place and staging copy identical\n\n", inPlace.m_cmdBuf.iOffset);
+
+    printf("Mcmd/s             size     staging   in place\n");
+    RunCmdBench("MI_STORE_DATA_IMM", sizeof(BenchCmds::MI_STORE_DATA_IMM_CMD), rounds, [](BenchContext &ctx, uint32_t i) {
+        ctx.m_impl->MHW_GETPAR_F(MI_STORE_DATA_IMM)().dwValue = i;
+        ctx.m_impl->MHW_ADDCMD_F(MI_STORE_DATA_IMM)(&ctx.m_cmdBuf);
+    });
+    RunCmdBench("HCP_PIC_STATE", sizeof(BenchCmds::HCP_PIC_STATE_CMD), rounds, [](BenchContext &ctx, uint32_t i) {
+        auto &params              = ctx.m_impl->MHW_GETPAR_F(HCP_PIC_STATE)();
+        params.frameWidthInMinCb  = 240;
+        params.frameHeightInMinCb = 135;
+        params.frameNumber        = i;
+        ctx.m_impl->MHW_ADDCMD_F(HCP_PIC_STATE)(&ctx.m_cmdBuf);
+    });
+    RunCmdBench("VEBOX_STATE", sizeof(BenchCmds::VEBOX_STATE_CMD), rounds, [](BenchContext &ctx, uint32_t i) {
+        auto &params           = ctx.m_impl->MHW_GETPAR_F(VEBOX_STATE)();
+        params.dnEnable        = true;
+        params.diEnable        = i & 1;
+        params.dndiStateOffset = 0x10000ull + i * 0x400;
+        params.frameNumber     = i;
+        ctx.m_impl->MHW_ADDCMD_F(VEBOX_STATE)(&ctx.m_cmdBuf);
+    });
+
+    return MosBenchAssertCount() ? 1 : 0;
+}
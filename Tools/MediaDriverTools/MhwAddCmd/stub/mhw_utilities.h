@@ -0,0 +1,109 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     mhw_utilities.h
+//! \brief    MHW command and batch buffers for the benchmark, in host memory
+//! \details  Commands are added as MosInterface::AddCommand and Mhw_AddCommandBB
+//!           add them, resources are not patched.
+//!
+#ifndef __MHW_UTILITIES_H__
+#define __MHW_UTILITIES_H__
+
+#include <string.h>
+#include "mos_os.h"
+#include "mos_util_debug.h"
+
+#define MHW_FUNCTION_ENTER
+#define MHW_ASSERTMESSAGE(_message, ...)           MOS_ASSERTMESSAGE(MOS_COMPONENT_HW, MOS_HW_SUBCOMP_ALL, _message, ##__VA_ARGS__)
+#define MHW_CHK_NULL_RETURN(_ptr)                  MOS_CHK_NULL_RETURN(MOS_COMPONENT_HW, MOS_HW_SUBCOMP_ALL, _ptr)
+#define MHW_CHK_NULL_NO_STATUS_RETURN(_ptr)        MOS_CHK_NULL_NO_STATUS_RETURN(MOS_COMPONENT_HW, MOS_HW_SUBCOMP_ALL, _ptr)
+#define MHW_CHK_STATUS_RETURN(_stmt)               MOS_CHK_STATUS_RETURN(MOS_COMPONENT_HW, MOS_HW_SUBCOMP_ALL, _stmt)
+
+struct MOS_COMMAND_BUFFER
+{
+    uint32_t *pCmdBase;
+    uint32_t *pCmdPtr;
+    int32_t   iOffset;
+    int32_t   iRemaining;
+};
+typedef MOS_COMMAND_BUFFER *PMOS_COMMAND_BUFFER;
+
+struct MHW_BATCH_BUFFER
+{
+    uint8_t *pData;
+    int32_t  iCurrent;
+    int32_t  iRemaining;
+};
+typedef MHW_BATCH_BUFFER *PMHW_BATCH_BUFFER;
+
+struct MHW_RESOURCE_PARAMS
+{
+    PMOS_RESOURCE presResource;
+    uint32_t     *pdwCmd;
+    uint32_t      dwLocationInCmd;
+};
+typedef MHW_RESOURCE_PARAMS *PMHW_RESOURCE_PARAMS;
+
+inline MOS_STATUS Mhw_AddResourceToCmd_GfxAddress(PMOS_INTERFACE, PMOS_COMMAND_BUFFER, PMHW_RESOURCE_PARAMS)
+{
+    return MOS_STATUS_SUCCESS;
+}
+
+inline MOS_STATUS Mhw_AddResourceToCmd_PatchList(PMOS_INTERFACE, PMOS_COMMAND_BUFFER, PMHW_RESOURCE_PARAMS)
+{
+    return MOS_STATUS_SUCCESS;
+}
+
+inline MOS_STATUS Mhw_AddCommandCmdOrBB(void *cmdBuffer, void *batchBuffer, const void *cmd, uint32_t cmdSize)
+{
+    if (cmdBuffer)
+    {
+        PMOS_COMMAND_BUFFER cmdBuf = (PMOS_COMMAND_BUFFER)cmdBuffer;
+        if (cmdBuf->iRemaining < (int32_t)cmdSize)
+        {
+            MHW_ASSERTMESSAGE("Unable to add command (no space).");
+            return MOS_STATUS_UNKNOWN;
+        }
+        memcpy(cmdBuf->pCmdPtr, cmd, cmdSize);
+        cmdBuf->iOffset += cmdSize;
+        cmdBuf->iRemaining -= cmdSize;
+        cmdBuf->pCmdPtr += cmdSize / sizeof(uint32_t);
+        return MOS_STATUS_SUCCESS;
+    }
+    if (batchBuffer)
+    {
+        PMHW_BATCH_BUFFER batchBuf = (PMHW_BATCH_BUFFER)batchBuffer;
+        batchBuf->iCurrent += cmdSize;
+        batchBuf->iRemaining -= cmdSize;
+        if (batchBuf->iRemaining < 0)
+        {
+            MHW_ASSERTMESSAGE("Unable to add command (no space).");
+            return MOS_STATUS_UNKNOWN;
+        }
+        memcpy(batchBuf->pData + batchBuf->iCurrent - cmdSize, cmd, cmdSize);
+        return MOS_STATUS_SUCCESS;
+    }
+    MHW_ASSERTMESSAGE("There is no valid command buffer or batch buffer.");
+    return MOS_STATUS_NULL_POINTER;
+}
+
+#endif  // __MHW_UTILITIES_H__
@@ -0,0 +1,100 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     fake_i915.cpp
+//! \brief    A fake i915 device for the bufmgr benchmarks
+//!
+
+#include <errno.h>
+#include "xf86drm.h"
+#include "i915_drm.h"
+#include "fake_i915.h"
+
+static std::atomic<uint32_t> g_nextHandle(1);
+static std::atomic<uint32_t> g_nextContext(1);
+
+FakeI915Counters &FakeI915()
+{
+    static FakeI915Counters counters;
+    return counters;
+}
+
+extern "C" int drmIoctl(int fd, unsigned long request, void *arg)
+{
+    switch (request)
+    {
+    case DRM_IOCTL_I915_GETPARAM:
+    {
+        drm_i915_getparam_t *gp = (drm_i915_getparam_t *)arg;
+        // A Gen12 device with softpin
+        *gp->value = (gp->param == I915_PARAM_CHIPSET_ID) ? 0x9a49 : 1;
+        return 0;
+    }
+    case DRM_IOCTL_I915_GEM_GET_APERTURE:
+        ((struct drm_i915_gem_get_aperture *)arg)->aper_available_size = 4ull << 30;
+        return 0;
+    case DRM_IOCTL_I915_GEM_CONTEXT_GETPARAM:
+        ((struct drm_i915_gem_context_param *)arg)->value = 1ull << 48;
+        return 0;
+    case DRM_IOCTL_I915_GEM_CONTEXT_CREATE:
+        ((struct drm_i915_gem_context_create *)arg)->ctx_id = g_nextContext++;
+        return 0;
+    case DRM_IOCTL_I915_GEM_CONTEXT_DESTROY:
+    case DRM_IOCTL_I915_GEM_CONTEXT_SETPARAM:
+        return 0;
+    case DRM_IOCTL_I915_GEM_CREATE:
+        ((struct drm_i915_gem_create *)arg)->handle = g_nextHandle++;
+        FakeI915().creates++;
+        return 0;
+    case DRM_IOCTL_GEM_CLOSE:
+        FakeI915().closes++;
+        return 0;
+    case DRM_IOCTL_I915_GEM_MADVISE:
+        ((struct drm_i915_gem_madvise *)arg)->retained = 1;
+        return 0;
+    case DRM_IOCTL_I915_GEM_BUSY:
+        ((struct drm_i915_gem_busy *)arg)->busy = 0;
+        return 0;
+    case DRM_IOCTL_I915_GEM_SET_TILING:
+    case DRM_IOCTL_I915_GEM_GET_TILING:
+        return 0;
+    case DRM_IOCTL_I915_GEM_EXECBUFFER2:
+    case DRM_IOCTL_I915_GEM_EXECBUFFER2_WR:
+        FakeI915().execs++;
+        FakeI915().objects += ((struct drm_i915_gem_execbuffer2 *)arg)->buffer_count;
+        return 0;
+    default:
+        // No local memory, no hwconfig, nothing else
+        errno = EINVAL;
+        return -1;
+    }
+}
+
+extern "C" int drmPrimeHandleToFD(int fd, uint32_t handle, uint32_t flags, int *primeFd)
+{
+    return -EINVAL;
+}
+
+extern "C" int drmPrimeFDToHandle(int fd, int primeFd, uint32_t *handle)
+{
+    return -EINVAL;
+}
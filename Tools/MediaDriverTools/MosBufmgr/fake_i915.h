@@ -0,0 +1,48 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     fake_i915.h
+//! \brief    A fake i915 device for the bufmgr benchmarks
+//! \details  drmIoctl() answers the ioctls mos_bufmgr.c issues to allocate, free
+//!           and submit buffer objects, without a device. GEM handles and context
+//!           ids are counters, madvise always retains the pages, no bo is ever busy
+//!           and every execbuffer succeeds.
+//!
+#ifndef __FAKE_I915_H__
+#define __FAKE_I915_H__
+
+#include <atomic>
+#include <stdint.h>
+
+#define FAKE_I915_FD 1000
+
+struct FakeI915Counters
+{
+    std::atomic<uint32_t> creates;  //!< DRM_IOCTL_I915_GEM_CREATE
+    std::atomic<uint32_t> closes;   //!< DRM_IOCTL_GEM_CLOSE
+    std::atomic<uint32_t> execs;    //!< DRM_IOCTL_I915_GEM_EXECBUFFER2(_WR)
+    std::atomic<uint32_t> objects;  //!< exec objects of all execbuffers
+};
+
+FakeI915Counters &FakeI915();
+
+#endif // __FAKE_I915_H__
@@ -0,0 +1,184 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     mos_bo_cache_bench.cpp
+//! \brief    Buffer object alloc/free churn through the i915 bufmgr and its bo cache
+//! \details  Usage: MosBoCacheBench [iterations per thread] [max threads]
+//!           mos_bufmgr.c runs on the fake i915 device of fake_i915.cpp. Each thread
+//!           keeps a window of live bos of 4 KB to 2 MB and replaces the oldest
+//!           one per iteration, so almost every alloc is served by the bo cache
+//!           and almost every free puts a bo back into it. Every thread count is
+//!           run once with a check that no bo is handed out to two threads, then
+//!           timed.
+//!
+
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <thread>
+#include <vector>
+#include "xf86drm.h"
+#include "i915_drm.h"
+#include "mos_bufmgr.h"
+#include "fake_i915.h"
+#include "media_bench.h"
+
+static const uint32_t liveBos       = 16;
+static const uint32_t maxHandles    = 1 << 20;
+
+// 1 while the bo of the handle is owned by a bench thread
+static std::atomic<uint8_t> g_owned[maxHandles];
+
+struct Result
+{
+    double   seconds;
+    uint64_t ops;
+    uint64_t p50Ns;
+    uint64_t p99Ns;
+    bool     ok;
+};
+
+static bool Churn(mos_bufmgr *bufmgr, uint32_t seed, uint32_t iterations, bool check, std::vector<uint64_t> &freeNs)
+{
+    std::mt19937        rng(seed);
+    MOS_LINUX_BO       *live[liveBos] = {};
+    bool                ok            = true;
+
+    for (uint32_t i = 0; i < iterations + liveBos; i++)
+    {
+        MOS_LINUX_BO *&slot = live[i % liveBos];
+        if (slot)
+        {
+            if (check)
+            {
+                g_owned[slot->handle] = 0;
+            }
+            MediaBenchTimer timer;
+            mos_bo_unreference(slot);
+            freeNs.push_back(timer.Ns());
+            slot = nullptr;
+        }
+        if (i >= iterations)
+        {
+            continue;
+        }
+
+        // 4 KB to 2 MB, in the bucket sizes the driver uses most
+        unsigned long size = 4096ul << (rng() % 10);
+        slot = mos_bo_alloc(bufmgr, "bench", size, 4096, MOS_MEMPOOL_SYSTEMMEMORY);
+        if (slot == nullptr || slot->handle >= maxHandles)
+        {
+            return false;
+        }
+        if (check)
+        {
+            uint8_t unowned = 0;
+            if (!g_owned[slot->handle].compare_exchange_strong(unowned, 1))
+            {
+                fprintf(stderr, "bo %u handed out twice\n", slot->handle);
+                ok = false;
+            }
+        }
+    }
+    return ok;
+}
+
+static Result Run(uint32_t threads, uint32_t iterations, bool check)
+{
+    Result                             result = {};
+    std::vector<std::vector<uint64_t>> freeNs(threads);
+    std::vector<std::thread>           workers;
+    std::atomic<bool>                  ok(true);
+
+    mos_bufmgr *bufmgr = mos_bufmgr_gem_init(FAKE_I915_FD, 16 * 4096);
+    if (bufmgr == nullptr)
+    {
+        return result;
+    }
+    mos_bufmgr_gem_enable_reuse(bufmgr);
+    mos_bufmgr_gem_enable_softpin(bufmgr, false);
+
+    MediaBenchTimer timer;
+    for (uint32_t t = 0; t < threads; t++)
+    {
+        freeNs[t].reserve(iterations);
+        workers.emplace_back([&, t]() {
+            if (!Churn(bufmgr, t + 1, iterations, check, freeNs[t]))
+            {
+                ok = false;
+            }
+        });
+    }
+    for (auto &worker : workers)
+    {
+        worker.join();
+    }
+    result.seconds = timer.Seconds();
+
+    mos_bufmgr_destroy(bufmgr);
+
+    std::vector<uint64_t> all;
+    for (auto &ns : freeNs)
+    {
+        all.insert(all.end(), ns.begin(), ns.end());
+    }
+    std::sort(all.begin(), all.end());
+    result.ops   = all.size();
+    result.p50Ns = all.empty() ? 0 : all[all.size() / 2];
+    result.p99Ns = all.empty() ? 0 : all[all.size() * 99 / 100];
+    result.ok    = ok && result.ops == (uint64_t)threads * iterations;
+    return result;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t iterations = MediaBenchArg(argc, argv, 1, 200000);
+    uint32_t maxThreads = MediaBenchArg(argc, argv, 2, 8);
+    bool     ok         = true;
+
+    printf("%-8s %14s %10s %10s %10s %10s\n", "threads", "alloc+free/s", "free p50", "free p99", "creates", "closes");
+    for (uint32_t threads = 1; threads <= maxThreads; threads *= 2)
+    {
+        Result checked = Run(threads, iterations / 10, true);
+        if (!checked.ok)
+        {
+            printf("%-8u check failed\n", threads);
+            ok = false;
+            continue;
+        }
+
+        FakeI915().creates = 0;
+        FakeI915().closes  = 0;
+        Result timed = Run(threads, iterations, false);
+        ok = ok && timed.ok;
+        printf("%-8u %14.0f %8lu ns %8lu ns %10u %10u\n",
+            threads,
+            timed.ops / timed.seconds,
+            (unsigned long)timed.p50Ns,
+            (unsigned long)timed.p99Ns,
+            FakeI915().creates.load(),
+            FakeI915().closes.load());
+    }
+    return ok ? 0 : 1;
+}
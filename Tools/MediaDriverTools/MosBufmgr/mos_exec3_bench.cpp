@@ -0,0 +1,221 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     mos_exec3_bench.cpp
+//! \brief    Multi pipe submissions through do_exec3() of the i915 bufmgr
+//! \details  Usage: MosExec3Bench [submissions]
+//!           mos_bufmgr.c runs on the fake i915 device of fake_i915.cpp. Like a
+//!           scalable decode or encode, every submission has one batch buffer per
+//!           pipe, each with softpin targets of which half are shared by all pipes.
+//!           mos_gem_bo_context_exec3() is timed, and the heap allocations it makes
+//!           are counted by wrapping malloc, calloc and realloc.
+//!
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <vector>
+#include "xf86drm.h"
+#include "i915_drm.h"
+#include "mos_bufmgr.h"
+#include "fake_i915.h"
+#include "media_bench.h"
+
+// The sanitizers bring their own allocator, do not wrap it
+#if defined(__SANITIZE_ADDRESS__) || defined(__SANITIZE_THREAD__)
+#define EXEC3_BENCH_COUNT_ALLOCS 0
+#else
+#define EXEC3_BENCH_COUNT_ALLOCS 1
+#endif
+
+static bool     g_countAllocs = false;
+static uint64_t g_allocs      = 0;
+
+#if EXEC3_BENCH_COUNT_ALLOCS
+extern "C" void *__libc_malloc(size_t size);
+extern "C" void *__libc_calloc(size_t num, size_t size);
+extern "C" void *__libc_realloc(void *ptr, size_t size);
+
+extern "C" void *malloc(size_t size)
+{
+    g_allocs += g_countAllocs;
+    return __libc_malloc(size);
+}
+
+extern "C" void *calloc(size_t num, size_t size)
+{
+    g_allocs += g_countAllocs;
+    return __libc_calloc(num, size);
+}
+
+extern "C" void *realloc(void *ptr, size_t size)
+{
+    g_allocs += g_countAllocs;
+    return __libc_realloc(ptr, size);
+}
+#endif
+
+struct Result
+{
+    uint64_t firstAllocs;   // allocations of the first submission
+    uint64_t allocs;        // allocations of all others
+    uint64_t p50Ns;
+    uint64_t p99Ns;
+    uint32_t objects;       // exec objects of the last submission
+    bool     ok;
+};
+
+static Result Run(uint32_t pipes, uint32_t targets, uint32_t submissions)
+{
+    Result result = {};
+
+    mos_bufmgr *bufmgr = mos_bufmgr_gem_init(FAKE_I915_FD, 16 * 4096);
+    if (bufmgr == nullptr)
+    {
+        return result;
+    }
+    mos_bufmgr_gem_enable_reuse(bufmgr);
+    mos_bufmgr_gem_enable_softpin(bufmgr, false);
+    mos_linux_context *ctx = mos_gem_context_create(bufmgr);
+
+    std::vector<MOS_LINUX_BO *> cmdBos(pipes);
+    std::vector<MOS_LINUX_BO *> shared(targets / 2);
+    std::vector<MOS_LINUX_BO *> own(pipes * (targets - targets / 2));
+    bool                        ok = ctx != nullptr;
+    for (auto &bo : cmdBos)
+    {
+        bo = mos_bo_alloc(bufmgr, "bench cmd", 64 * 1024, 4096, MOS_MEMPOOL_SYSTEMMEMORY);
+        ok = ok && bo != nullptr;
+    }
+    for (auto &bo : shared)
+    {
+        bo = mos_bo_alloc(bufmgr, "bench shared", 64 * 1024, 4096, MOS_MEMPOOL_SYSTEMMEMORY);
+        ok = ok && bo != nullptr;
+    }
+    for (auto &bo : own)
+    {
+        bo = mos_bo_alloc(bufmgr, "bench own", 4096, 4096, MOS_MEMPOOL_SYSTEMMEMORY);
+        ok = ok && bo != nullptr;
+    }
+
+    std::vector<uint64_t> ns;
+    ns.reserve(submissions);
+    for (uint32_t s = 0; ok && s < submissions; s++)
+    {
+        for (uint32_t p = 0; p < pipes; p++)
+        {
+            for (auto bo : shared)
+            {
+                ok = ok && mos_bo_add_softpin_target(cmdBos[p], bo, false) == 0;
+            }
+            for (uint32_t t = 0; t < targets - targets / 2; t++)
+            {
+                ok = ok && mos_bo_add_softpin_target(cmdBos[p], own[p * (targets - targets / 2) + t], true) == 0;
+            }
+        }
+
+        uint32_t objects = FakeI915().objects;
+        g_allocs         = 0;
+        g_countAllocs    = true;
+        MediaBenchTimer timer;
+        int ret = mos_gem_bo_context_exec3(cmdBos.data(), pipes, ctx, nullptr, 0, 0, I915_EXEC_DEFAULT, nullptr);
+        uint64_t elapsed = timer.Ns();
+        g_countAllocs    = false;
+
+        ok = ok && ret == 0;
+        ns.push_back(elapsed);
+        (s == 0 ? result.firstAllocs : result.allocs) += g_allocs;
+        result.objects = FakeI915().objects - objects;
+
+        for (auto bo : cmdBos)
+        {
+            mos_gem_bo_clear_relocs(bo, 0);
+        }
+    }
+
+    for (auto bo : own)
+    {
+        mos_bo_unreference(bo);
+    }
+    for (auto bo : shared)
+    {
+        mos_bo_unreference(bo);
+    }
+    for (auto bo : cmdBos)
+    {
+        mos_bo_unreference(bo);
+    }
+    if (ctx)
+    {
+        mos_gem_context_destroy(ctx);
+    }
+    mos_bufmgr_destroy(bufmgr);
+
+    std::sort(ns.begin(), ns.end());
+    result.p50Ns = ns.empty() ? 0 : ns[ns.size() / 2];
+    result.p99Ns = ns.empty() ? 0 : ns[ns.size() * 99 / 100];
+    // Every bo once, the shared ones deduplicated
+    result.ok = ok && ns.size() == submissions && result.objects == pipes + shared.size() + own.size();
+    return result;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t submissions = MediaBenchArg(argc, argv, 1, 20000);
+    bool     ok          = true;
+
+    if (submissions < 2)
+    {
+        submissions = 2;
+    }
+
+    printf("%-6s %-8s %8s %12s %12s %10s %10s\n",
+        "pipes", "targets", "objects", "first allocs", "allocs/exec", "exec p50", "exec p99");
+    for (uint32_t pipes = 2; pipes <= 4; pipes *= 2)
+    {
+        for (uint32_t targets = 64; targets <= 1024; targets *= 4)
+        {
+            Result result = Run(pipes, targets, targets > 256 ? submissions / 10 + 2 : submissions);
+            if (!result.ok)
+            {
+                printf("%-6u %-8u failed\n", pipes, targets);
+                ok = false;
+                continue;
+            }
+            uint32_t timed = targets > 256 ? submissions / 10 + 1 : submissions - 1;
+#if EXEC3_BENCH_COUNT_ALLOCS
+            printf("%-6u %-8u %8u %12lu %12.2f %7lu ns %7lu ns\n",
+                pipes, targets, result.objects,
+                (unsigned long)result.firstAllocs,
+                (double)result.allocs / timed,
+                (unsigned long)result.p50Ns,
+                (unsigned long)result.p99Ns);
+#else
+            printf("%-6u %-8u %8u %12s %12s %7lu ns %7lu ns\n",
+                pipes, targets, result.objects, "n/a", "n/a",
+                (unsigned long)result.p50Ns,
+                (unsigned long)result.p99Ns);
+#endif
+        }
+    }
+    return ok ? 0 : 1;
+}
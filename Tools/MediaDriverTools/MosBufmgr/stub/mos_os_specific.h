@@ -0,0 +1,59 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     mos_os_specific.h
+//! \brief    The OS context types mos_bufmgr.c takes from here, for the benchmark
+//!
+#ifndef __MOS_OS_SPECIFIC_H__
+#define __MOS_OS_SPECIFIC_H__
+
+#include <sys/user.h>
+#include <vector>
+#include "mos_os.h"
+#include "mos_util_debug.h"
+
+struct MEDIA_GT_SYSTEM_INFO;
+using MEDIA_SYSTEM_INFO = MEDIA_GT_SYSTEM_INFO;
+
+struct MOS_CONTEXT_OFFSET
+{
+    MOS_LINUX_CONTEXT *intel_context;
+    MOS_LINUX_BO      *target_bo;
+    uint64_t          offset64;
+};
+
+struct _MOS_OS_CONTEXT
+{
+    std::vector<struct MOS_CONTEXT_OFFSET> contextOffsetList;
+};
+
+#define MOS_OS_CHECK_CONDITION(_condition, _str, _ret)  \
+    do                                                  \
+    {                                                   \
+        if (_condition)                                 \
+        {                                               \
+            MOS_OS_ASSERTMESSAGE(_str);                 \
+            return _ret;                                \
+        }                                               \
+    } while (0)
+
+#endif  // __MOS_OS_SPECIFIC_H__
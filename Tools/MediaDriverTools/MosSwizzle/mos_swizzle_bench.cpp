@@ -0,0 +1,115 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     mos_swizzle_bench.cpp
+//! \brief    Time of MosSwizzleDataRows per surface, tile walk against per byte path
+//! \details  Usage: MosSwizzleBench [iterations]
+//!           Built with the driver's mos_utilities_swizzle.cpp.
+//!
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <vector>
+#include "mos_utilities.h"
+#include "media_bench.h"
+
+// ms per whole surface, the band [startRow, height) scaled to height rows
+static double Time(uint8_t *src, uint8_t *dst, MOS_TILE_TYPE srcTiling, MOS_TILE_TYPE dstTiling,
+    int32_t startRow, int32_t height, int32_t pitch, uint32_t iterations)
+{
+    MediaBenchTimer timer;
+    for (uint32_t i = 0; i < iterations; i++)
+    {
+        MosUtilities::MosSwizzleDataRows(src, dst, srcTiling, dstTiling, startRow, height - startRow, pitch, 0);
+    }
+    double ms = timer.Ms();
+    return ms / iterations * height / (height - startRow);
+}
+
+static bool Check(const uint8_t *tiled, const uint8_t *linear, MOS_TILE_TYPE tiling,
+    int32_t startRow, int32_t height, int32_t pitch)
+{
+    for (int32_t y = startRow; y < height; y++)
+    {
+        for (int32_t x = 0; x < pitch; x++)
+        {
+            if (tiled[MosUtilities::MosSwizzleOffset(x, y, pitch, tiling, false, 0)] != linear[y * pitch + x])
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t iterations = MediaBenchArg(argc, argv, 1, 20);
+
+    // NV12 surfaces, height includes the chroma plane
+    struct
+    {
+        const char    *name;
+        MOS_TILE_TYPE tiling;
+        int32_t       pitch;
+        int32_t       height;
+    } surfaces[] = {
+        {"1080p TileY", MOS_TILE_Y, 2048, 1088 * 3 / 2},
+        {"4K TileY",    MOS_TILE_Y, 3840, 2160 * 3 / 2},
+        {"1080p TileX", MOS_TILE_X, 2048, 1088 * 3 / 2},
+        {"4K TileX",    MOS_TILE_X, 4096, 2160 * 3 / 2},
+    };
+
+    int ret = 0;
+    printf("surface      direction   per byte ms  tile walk ms\n");
+    for (auto &surface : surfaces)
+    {
+        // The tiled surface is padded to a whole tile row
+        size_t               size = (size_t)surface.pitch * surface.height;
+        std::vector<uint8_t> tiled((size_t)surface.pitch * ((surface.height + 31) & ~31));
+        std::vector<uint8_t> linear(size);
+        for (size_t i = 0; i < tiled.size(); i++)
+        {
+            tiled[i] = (uint8_t)(i * 2654435761u >> 24);
+        }
+
+        for (int32_t toLinear = 1; toLinear >= 0; toLinear--)
+        {
+            uint8_t       *src       = toLinear ? tiled.data() : linear.data();
+            uint8_t       *dst       = toLinear ? linear.data() : tiled.data();
+            MOS_TILE_TYPE srcTiling = toLinear ? surface.tiling : MOS_TILE_LINEAR;
+            MOS_TILE_TYPE dstTiling = toLinear ? MOS_TILE_LINEAR : surface.tiling;
+
+            double perByte  = Time(src, dst, srcTiling, dstTiling, 1, surface.height, surface.pitch, iterations);
+            bool   match    = Check(tiled.data(), linear.data(), surface.tiling, 1, surface.height, surface.pitch);
+            double tileWalk = Time(src, dst, srcTiling, dstTiling, 0, surface.height, surface.pitch, iterations);
+            match = match && Check(tiled.data(), linear.data(), surface.tiling, 0, surface.height, surface.pitch);
+
+            printf("%-12s %-11s %11.2f  %12.2f%s\n", surface.name, toLinear ? "de-swizzle" : "swizzle",
+                perByte, tileWalk, match ? "" : "  MISMATCH");
+            ret = match ? ret : -1;
+        }
+    }
+
+    return MosBenchAssertCount() == 0 ? ret : -1;
+}
@@ -0,0 +1,204 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     user_setting_read_bench.cpp
+//! \brief    Reads per second of the media user setting, by name and by handle
+//! \details  Usage: UserSettingReadBench [reads]
+//!
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <thread>
+#include <vector>
+#include "media_user_setting.h"
+#include "media_bench.h"
+
+const std::map<uint32_t, MediaUserSetting::Internal::ExtPathCFG> MediaUserSetting::Internal::Configure::m_pathOption = {};
+
+using namespace MediaUserSetting;
+
+static const uint32_t g_keyNum = 300;
+
+#define CHECK(_expr)                                                         \
+    if (!(_expr))                                                            \
+    {                                                                        \
+        fprintf(stderr, "Check failed at line %d: %s\n", __LINE__, #_expr); \
+        exit(1);                                                             \
+    }
+
+// Names built per read, like call sites that format the key
+static double StringReads(MediaUserSettingSharedPtr userSetting, uint32_t readNum)
+{
+    uint64_t        sum = 0;
+    MediaBenchTimer timer;
+    for (uint32_t i = 0; i < readNum; i++)
+    {
+        int32_t value = 0;
+        ReadUserSetting(userSetting, value, "Bench Key " + std::to_string((i % 4) * 30), Group::Sequence);
+        sum += value;
+    }
+    double seconds = timer.Seconds();
+    CHECK(sum == readNum);
+    return readNum / seconds;
+}
+
+// One literal name, like the per frame call sites
+static double LiteralReads(MediaUserSettingSharedPtr userSetting, uint32_t readNum)
+{
+    uint64_t        sum = 0;
+    MediaBenchTimer timer;
+    for (uint32_t i = 0; i < readNum; i++)
+    {
+        bool value = false;
+        ReadUserSetting(userSetting, value, "Bench Key 90", Group::Sequence);
+        sum += value;
+    }
+    double seconds = timer.Seconds();
+    CHECK(sum == readNum);
+    return readNum / seconds;
+}
+
+#ifdef USER_SETTING_HANDLES
+static double HandleReads(MediaUserSettingSharedPtr userSetting, uint32_t readNum)
+{
+    Handle          handle = GetUserSettingHandle(userSetting, "Bench Key 90", Group::Sequence);
+    uint64_t        sum    = 0;
+    MediaBenchTimer timer;
+    for (uint32_t i = 0; i < readNum; i++)
+    {
+        bool value = false;
+        ReadUserSetting(userSetting, value, handle);
+        sum += value;
+    }
+    double seconds = timer.Seconds();
+    CHECK(sum == readNum);
+    return readNum / seconds;
+}
+
+// Value only, without the parse to the typed value
+static double HandleValueReads(MediaUserSettingSharedPtr userSetting, uint32_t readNum)
+{
+    Handle          handle = GetUserSettingHandle(userSetting, "Bench Key 90", Group::Sequence);
+    Value           value;
+    MediaBenchTimer timer;
+    for (uint32_t i = 0; i < readNum; i++)
+    {
+        userSetting->Read(value, handle);
+    }
+    double seconds = timer.Seconds();
+    CHECK(value.Get<bool>());
+    return readNum / seconds;
+}
+
+static void CheckHandles(MediaUserSettingSharedPtr userSetting)
+{
+    int32_t value = 0;
+
+    // A handle taken before the item is registered reads once it is
+    Handle early = GetUserSettingHandle(userSetting, "Late Key", Group::Frame);
+    CHECK(early != InvalidHandle);
+    CHECK(ReadUserSetting(userSetting, value, early) == MOS_STATUS_INVALID_HANDLE);
+    CHECK(DeclareUserSettingKey(userSetting, "Late Key", Group::Frame, (int32_t)11, false) == MOS_STATUS_SUCCESS);
+    CHECK(ReadUserSetting(userSetting, value, early) != MOS_STATUS_SUCCESS && value == 11);
+    CHECK(ReadUserSetting(userSetting, value, early, (int32_t)12, true) != MOS_STATUS_SUCCESS && value == 12);
+    CHECK(ReadUserSetting(userSetting, value, "Late Key", Group::Frame) != MOS_STATUS_SUCCESS && value == 11);
+
+    // Wrong group, unknown names and handles
+    CHECK(ReadUserSetting(userSetting, value, "Late Key", Group::Device) == MOS_STATUS_INVALID_HANDLE);
+    CHECK(ReadUserSetting(userSetting, value, "No Such Key", Group::Device) == MOS_STATUS_INVALID_HANDLE);
+    CHECK(ReadUserSetting(userSetting, value, (Handle)100000) == MOS_STATUS_INVALID_HANDLE);
+    CHECK(ReadUserSetting(userSetting, value, InvalidHandle) == MOS_STATUS_INVALID_HANDLE);
+
+    // Registry value
+    CHECK(DeclareUserSettingKey(userSetting, "File Key", Group::Device, (int32_t)0, false) == MOS_STATUS_SUCCESS);
+    CHECK(ReadUserSetting(userSetting, value, "File Key", Group::Device) == MOS_STATUS_SUCCESS && value == 7);
+
+    // Env value cached by the handle until Reload(), as done on the next device initialization,
+    // a read by name is not cached
+    CHECK(DeclareUserSettingKey(userSetting, "Env Key", Group::Sequence, (int32_t)1, false) == MOS_STATUS_SUCCESS);
+    Handle env = GetUserSettingHandle(userSetting, "Env Key", Group::Sequence);
+    setenv("Env_Key", "3", 1);
+    CHECK(ReadUserSetting(userSetting, value, env) == MOS_STATUS_SUCCESS && value == 3);
+    setenv("Env_Key", "4", 1);
+    CHECK(ReadUserSetting(userSetting, value, env) == MOS_STATUS_SUCCESS && value == 3);
+    CHECK(ReadUserSetting(userSetting, value, "Env Key", Group::Sequence) == MOS_STATUS_SUCCESS && value == 4);
+    userSetting->Reload();
+    CHECK(ReadUserSetting(userSetting, value, env) == MOS_STATUS_SUCCESS && value == 4);
+    unsetenv("Env_Key");
+    CHECK(ReadUserSetting(userSetting, value, "Env Key", Group::Sequence) != MOS_STATUS_SUCCESS && value == 1);
+    CHECK(ReadUserSetting(userSetting, value, env) == MOS_STATUS_SUCCESS && value == 4);
+
+    // A write that is not a report drops the cached value
+    CHECK(WriteUserSetting(userSetting, "Env Key", (int32_t)9, Group::Sequence) == MOS_STATUS_SUCCESS);
+    CHECK(ReadUserSetting(userSetting, value, env) != MOS_STATUS_SUCCESS && value == 1);
+
+    CHECK(DeclareUserSettingKey(userSetting, "Env Key", Group::Device, (int32_t)1, false) == MOS_STATUS_FILE_EXISTS);
+}
+#endif
+
+int main(int argc, char **argv)
+{
+    uint32_t readNum = MediaBenchArg(argc, argv, 1, 1000000);
+
+    // Registry values for every third bench key and the file key, loaded by Instance()
+    auto &keys = MosBenchRegistry()[USER_SETTING_CONFIG_PATH];
+    for (uint32_t i = 0; i < g_keyNum; i += 3)
+    {
+        keys["Bench Key " + std::to_string(i)] = "1";
+    }
+    keys["File Key"] = "7";
+
+    MediaUserSettingSharedPtr userSetting = MediaUserSetting::MediaUserSetting::Instance();
+    for (uint32_t i = 0; i < g_keyNum; i++)
+    {
+        DeclareUserSettingKey(userSetting, "Bench Key " + std::to_string(i), Group::Sequence, (int32_t)0, false);
+    }
+
+#ifdef USER_SETTING_HANDLES
+    CheckHandles(userSetting);
+#endif
+
+    printf("%u keys, one thread, reads/s\n", g_keyNum);
+    printf("by name, name built per read  %12.0f\n", StringReads(userSetting, readNum));
+    printf("by name, literal              %12.0f\n", LiteralReads(userSetting, readNum));
+#ifdef USER_SETTING_HANDLES
+    printf("by handle, typed              %12.0f\n", HandleReads(userSetting, readNum));
+    printf("by handle, Value only         %12.0f\n", HandleValueReads(userSetting, readNum));
+
+    // Concurrent reads, for the sanitizers
+    std::vector<std::thread> threads;
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        threads.emplace_back([&] {
+            HandleReads(userSetting, readNum / 10);
+            LiteralReads(userSetting, readNum / 10);
+            userSetting->Reload();
+        });
+    }
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+#endif
+
+    return 0;
+}
@@ -0,0 +1,153 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     va_get_image_bench.cpp
+//! \brief    vaGetImage throughput on 1080p and 4K NV12, P010 and YUY2 surfaces
+//! \details  Usage: VaGetImageBench [device] [iterations]
+//!           Each surface is filled once with vaPutImage, then read back with vaGetImage
+//!           into an image of the same format. Copy workers are set with the
+//!           "Media Copy Worker Number" user setting of the driver.
+//!
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <va/va.h>
+#include <va/va_drm.h>
+#include "media_bench.h"
+
+struct Format
+{
+    const char *name;
+    uint32_t    fourcc;
+    uint32_t    rtFormat;
+};
+
+static const Format formats[] =
+{
+    {"NV12", VA_FOURCC_NV12, VA_RT_FORMAT_YUV420},
+    {"P010", VA_FOURCC_P010, VA_RT_FORMAT_YUV420_10},
+    {"YUY2", VA_FOURCC_YUY2, VA_RT_FORMAT_YUV422},
+};
+
+static const uint32_t sizes[][2] = {{1920, 1080}, {3840, 2160}};
+
+#define VA_CHK(call)                                                        \
+    do                                                                      \
+    {                                                                       \
+        VAStatus status = (call);                                           \
+        if (status != VA_STATUS_SUCCESS)                                    \
+        {                                                                   \
+            fprintf(stderr, "%s failed: %s\n", #call, vaErrorStr(status));  \
+            return false;                                                   \
+        }                                                                   \
+    } while (0)
+
+static bool Run(VADisplay display, const Format &format, uint32_t width, uint32_t height, uint32_t iterations)
+{
+    VASurfaceAttrib attrib = {};
+    attrib.type            = VASurfaceAttribPixelFormat;
+    attrib.flags           = VA_SURFACE_ATTRIB_SETTABLE;
+    attrib.value.type      = VAGenericValueTypeInteger;
+    attrib.value.value.i   = format.fourcc;
+
+    VASurfaceID surface = VA_INVALID_SURFACE;
+    VA_CHK(vaCreateSurfaces(display, format.rtFormat, width, height, &surface, 1, &attrib, 1));
+
+    VAImageFormat imageFormat = {};
+    imageFormat.fourcc        = format.fourcc;
+    VAImage image             = {};
+    VA_CHK(vaCreateImage(display, &imageFormat, width, height, &image));
+
+    // some content so nothing is served from zero pages
+    void *data = nullptr;
+    VA_CHK(vaMapBuffer(display, image.buf, &data));
+    for (uint32_t i = 0; i < image.data_size; i++)
+    {
+        ((uint8_t *)data)[i] = (uint8_t)(i * 7 + i / 4096);
+    }
+    VA_CHK(vaUnmapBuffer(display, image.buf));
+    VA_CHK(vaPutImage(display, surface, image.image_id, 0, 0, width, height, 0, 0, width, height));
+    VA_CHK(vaSyncSurface(display, surface));
+
+    // first call warms up the staging buffer cache
+    VA_CHK(vaGetImage(display, surface, 0, 0, width, height, image.image_id));
+
+    MediaBenchTimer timer;
+    for (uint32_t i = 0; i < iterations; i++)
+    {
+        VA_CHK(vaGetImage(display, surface, 0, 0, width, height, image.image_id));
+    }
+    double ms = timer.Ms() / iterations;
+
+    printf("%s  %4ux%-4u  %10.3f  %8.1f\n", format.name, width, height, ms, image.data_size / ms / 1000.0);
+
+    vaDestroyImage(display, image.image_id);
+    vaDestroySurfaces(display, &surface, 1);
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    const char *device     = MediaBenchStringArg(argc, argv, 1, "/dev/dri/renderD128");
+    uint32_t    iterations = MediaBenchArg(argc, argv, 2, 200);
+    if (iterations == 0)
+    {
+        iterations = 1;
+    }
+
+    int fd = open(device, O_RDWR);
+    if (fd < 0)
+    {
+        fprintf(stderr, "Failed to open %s\n", device);
+        return -1;
+    }
+
+    VADisplay display = vaGetDisplayDRM(fd);
+    int       major   = 0;
+    int       minor   = 0;
+    if (display == nullptr || vaInitialize(display, &major, &minor) != VA_STATUS_SUCCESS)
+    {
+        fprintf(stderr, "Failed to initialize VA display on %s\n", device);
+        close(fd);
+        return -1;
+    }
+
+    int ret = 0;
+    printf("format  size       ms/image  MB/s\n");
+    for (auto &size : sizes)
+    {
+        for (auto &format : formats)
+        {
+            if (!Run(display, format, size[0], size[1], iterations))
+            {
+                ret = -1;
+            }
+        }
+    }
+
+    vaTerminate(display);
+    close(fd);
+    return ret;
+}
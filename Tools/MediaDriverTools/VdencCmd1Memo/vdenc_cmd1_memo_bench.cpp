@@ -0,0 +1,302 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     vdenc_cmd1_memo_bench.cpp
+//! \brief    Checks and times the VDENC_CMD1 const settings evaluated through ConstSettingsMemo
+//!           against running the lambdas for every command
+//!
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <random>
+#include "encode_hevc_vdenc_const_settings_xe_xpm_base.h"
+#include "encode_av1_vdenc_const_settings.h"
+#include "media_bench.h"
+
+using namespace encode;
+
+typedef mhw::vdbox::vdenc::_MHW_PAR_T(VDENC_CMD1) Cmd1Par;
+
+static const uint32_t g_inputNum      = 4;    //!< Distinct parameter blocks coming from the other features
+static const uint32_t g_cmdsPerFrame  = 2;    //!< HuC BRC update and VDEnc packet
+static const uint32_t g_intraPeriod   = 240;
+static const uint32_t g_sceneNum      = 8;
+static const uint32_t g_fieldNum      = 9;    //!< Signature fields Randomize() takes
+
+//!
+//! \brief  Frame parameters of one codec and the const settings built from them
+//!
+struct HevcCodec
+{
+    typedef HevcVdencFeatureSettings Settings;
+
+    HevcCodec(EncodeHevcVdencConstSettings *constSettings) : m_constSettings(constSettings)
+    {
+        EncoderParams params;
+        params.pSeqParams   = &m_seq;
+        params.pPicParams   = &m_pic;
+        params.pSliceParams = &m_slice;
+        m_constSettings->PrepareConstSettings();
+        m_constSettings->Update(&params);
+    }
+
+    ~HevcCodec()
+    {
+        delete m_constSettings;
+    }
+
+    //! Garbage in every field, then the fields of the signature in their valid range
+    bool Randomize(std::mt19937 &rng, const uint32_t *fields)
+    {
+        Fill(rng, &m_seq, sizeof(m_seq));
+        Fill(rng, &m_pic, sizeof(m_pic));
+        Fill(rng, &m_slice, sizeof(m_slice));
+        // slice QP within 1..51, the lambdas index their tables with QP - 1
+        Set(fields[1] % 3 + I_TYPE, fields[2] % 5, 7 + fields[3] % 39, (int8_t)(fields[4] % 13) - 6, 1 << (fields[5] % 5));
+        m_seq.LowDelayMode = fields[6] & 1;
+        m_seq.TargetUsage  = fields[7] % 8;
+        m_pic.NumROI       = fields[8] % 2 ? fields[8] % 16 : 0;
+        return fields[0] & 1;
+    }
+
+    void Set(uint8_t codingType, uint8_t level, uint8_t qp, int8_t qpDelta, uint8_t gopRefDist)
+    {
+        m_pic.CodingType         = codingType;
+        m_pic.HierarchLevelPlus1 = level;
+        m_pic.QpY                = qp;
+        m_slice.slice_qp_delta   = qpDelta;
+        m_seq.GopRefDist         = gopRefDist;
+    }
+
+    uint64_t Signature(bool isLowDelay)
+    {
+        return EncodeHevcVdencConstSettings::GetVdencCmd1Signature(&m_seq, &m_pic, &m_slice, isLowDelay);
+    }
+
+    static void Fill(std::mt19937 &rng, void *data, size_t size)
+    {
+        for (size_t i = 0; i < size; i++)
+        {
+            ((uint8_t *)data)[i] = (uint8_t)rng();
+        }
+    }
+
+    Settings *GetSettings() { return static_cast<Settings *>(m_constSettings->GetConstSettings()); }
+
+    EncodeHevcVdencConstSettings      *m_constSettings;
+    CODEC_HEVC_ENCODE_SEQUENCE_PARAMS m_seq   = {};
+    CODEC_HEVC_ENCODE_PICTURE_PARAMS  m_pic   = {};
+    CODEC_HEVC_ENCODE_SLICE_PARAMS    m_slice = {};
+};
+
+struct Av1Codec
+{
+    typedef Av1VdencFeatureSettings Settings;
+
+    Av1Codec() : m_constSettings(new EncodeAv1VdencConstSettings(OsInterface()))
+    {
+        EncoderParams params;
+        params.pSeqParams = &m_seq;
+        params.pPicParams = &m_pic;
+        m_constSettings->PrepareConstSettings();
+        m_constSettings->Update(&params);
+    }
+
+    ~Av1Codec()
+    {
+        delete m_constSettings;
+    }
+
+    bool Randomize(std::mt19937 &rng, const uint32_t *fields)
+    {
+        HevcCodec::Fill(rng, &m_seq, sizeof(m_seq));
+        HevcCodec::Fill(rng, &m_pic, sizeof(m_pic));
+        m_pic.PicFlags.fields.frame_type = fields[1] % 4;
+        m_pic.base_qindex                = fields[2] % 256;
+        return fields[0] & 1;
+    }
+
+    uint64_t Signature(bool isLowDelay)
+    {
+        return EncodeAv1VdencConstSettings::GetVdencCmd1Signature(&m_pic, isLowDelay);
+    }
+
+    Settings *GetSettings() { return static_cast<Settings *>(m_constSettings->GetConstSettings()); }
+
+    //! The AV1 const settings only build with an OS interface, they take no user settings from it
+    static PMOS_INTERFACE OsInterface()
+    {
+        static MOS_INTERFACE osInterface = {};
+        osInterface.pfnGetUserSettingInstance = [](PMOS_INTERFACE) { return MediaUserSettingSharedPtr(); };
+        return &osInterface;
+    }
+
+    EncodeAv1VdencConstSettings      *m_constSettings;
+    CODEC_AV1_ENCODE_SEQUENCE_PARAMS m_seq = {};
+    CODEC_AV1_ENCODE_PICTURE_PARAMS  m_pic = {};
+};
+
+//!
+//! \brief  What MHW_SETPAR_DECL_SRC(VDENC_CMD1) of the basic features did before the memo
+//!
+template <class TCodec>
+static MOS_STATUS RunLambdas(TCodec &codec, Cmd1Par &par, bool isLowDelay)
+{
+    for (const auto &lambda : codec.GetSettings()->vdencCmd1Settings)
+    {
+        MOS_STATUS status = lambda(par, isLowDelay);
+        if (status != MOS_STATUS_SUCCESS)
+        {
+            return status;
+        }
+    }
+    return MOS_STATUS_SUCCESS;
+}
+
+//!
+//! \brief  Random frames, every field the signature leaves out is garbage. Frames take the signature
+//!         fields of one of a few scenes, half of them with one field changed, so a signature missing
+//!         a field the lambdas read hits an entry evaluated for another value of that field.
+//!
+template <class TCodec>
+static uint32_t Check(TCodec &codec, uint32_t frames)
+{
+    std::mt19937 rng(1234);
+    Cmd1Par      inputs[g_inputNum];
+    for (auto &input : inputs)
+    {
+        HevcCodec::Fill(rng, &input, sizeof(input));
+    }
+    uint32_t scenes[g_sceneNum][g_fieldNum];
+    for (auto &scene : scenes)
+    {
+        for (auto &field : scene)
+        {
+            field = rng();
+        }
+    }
+
+    ConstSettingsMemo<Cmd1Par> memo;
+    uint32_t                   mismatches = 0;
+    for (uint32_t frame = 0; frame < frames; frame++)
+    {
+        uint32_t fields[g_fieldNum];
+        memcpy(fields, scenes[rng() % g_sceneNum], sizeof(fields));
+        if (rng() & 1)
+        {
+            fields[rng() % g_fieldNum] = rng();
+        }
+        bool     isLowDelay = codec.Randomize(rng, fields);
+        uint32_t input      = rng() % g_inputNum;
+        for (uint32_t cmd = 0; cmd < g_cmdsPerFrame; cmd++)
+        {
+            Cmd1Par expected = inputs[input];
+            Cmd1Par memoized = inputs[input];
+            if (RunLambdas(codec, expected, isLowDelay) != MOS_STATUS_SUCCESS ||
+                memo.Evaluate(codec.Signature(isLowDelay), memoized, codec.GetSettings()->vdencCmd1Settings, isLowDelay) != MOS_STATUS_SUCCESS)
+            {
+                printf("frame %u: lambda failed\n", frame);
+                return frames;
+            }
+            if (memcmp(&expected, &memoized, sizeof(Cmd1Par)) != 0)
+            {
+                mismatches++;
+            }
+        }
+    }
+    return mismatches;
+}
+
+//!
+//! \brief  HEVC frames of an IPPP or hierarchical B GOP, ns per frame for both commands
+//!
+static double Time(HevcCodec &codec, bool memoized, uint8_t gopRefDist, uint32_t qpSpread, uint32_t frames)
+{
+    std::mt19937               rng(5678);
+    ConstSettingsMemo<Cmd1Par> memo;
+    Cmd1Par                    par = {};
+    uint64_t                   ns  = 0;
+
+    for (uint32_t frame = 0; frame < frames; frame++)
+    {
+        uint32_t pos     = frame % g_intraPeriod;
+        uint8_t  type    = (pos == 0) ? I_TYPE : ((gopRefDist == 1 || pos % gopRefDist == 0) ? P_TYPE : B_TYPE);
+        uint8_t  level   = 1;
+        for (uint32_t step = gopRefDist; pos % step != 0 && step > 1; step /= 2)
+        {
+            level++;
+        }
+        int8_t   qpDelta = qpSpread ? (int8_t)(rng() % (qpSpread + 1)) - (int8_t)(qpSpread / 2) : 0;
+        codec.Set(type, level, 30 + level, qpDelta, gopRefDist);
+        codec.m_seq.LowDelayMode = 0;
+        codec.m_seq.TargetUsage  = 4;
+        codec.m_pic.NumROI       = 0;
+
+        MediaBenchTimer timer;
+        for (uint32_t cmd = 0; cmd < g_cmdsPerFrame; cmd++)
+        {
+            par = {};
+            if (memoized)
+            {
+                memo.Evaluate(codec.Signature(gopRefDist == 1), par, codec.GetSettings()->vdencCmd1Settings, gopRefDist == 1);
+            }
+            else
+            {
+                RunLambdas(codec, par, gopRefDist == 1);
+            }
+        }
+        ns += timer.Ns();
+    }
+
+    return (double)ns / frames;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t frames = MediaBenchArg(argc, argv, 1, 100000);
+
+    HevcCodec hevc(new EncodeHevcVdencConstSettings);
+    HevcCodec hevcXpm(new EncodeHevcVdencConstSettingsXe_Xpm_Base);
+    Av1Codec  av1;
+
+    uint32_t mismatches[] = {Check(hevc, frames), Check(hevcXpm, frames), Check(av1, frames)};
+    printf("check: %u frames, %u commands each, mismatches HEVC %u, HEVC Xe_XPM %u, AV1 %u\n",
+        frames, g_cmdsPerFrame, mismatches[0], mismatches[1], mismatches[2]);
+    if (mismatches[0] || mismatches[1] || mismatches[2])
+    {
+        return 1;
+    }
+
+    printf("HEVC Xe_XPM, intra period %u, %u VDENC_CMD1 per frame, ns per frame:\n", g_intraPeriod, g_cmdsPerFrame);
+    printf("                        lambdas     memo\n");
+    for (uint8_t gopRefDist : {1, 4, 8, 16})
+    {
+        printf("  CQP, GopRefDist %2u %10.1f %8.1f\n", gopRefDist,
+            Time(hevcXpm, false, gopRefDist, 0, frames), Time(hevcXpm, true, gopRefDist, 0, frames));
+    }
+    for (uint32_t qpSpread : {4, 12})
+    {
+        printf("  QP spread %2u     %10.1f %8.1f\n", qpSpread,
+            Time(hevcXpm, false, 4, qpSpread, frames), Time(hevcXpm, true, 4, qpSpread, frames));
+    }
+    return 0;
+}
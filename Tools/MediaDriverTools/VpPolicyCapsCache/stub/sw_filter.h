@@ -0,0 +1,210 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     sw_filter.h
+//! \brief    Feature parameters the policy caps cache key is built from
+//! \details  Subset of media_softlet/agnostic/common/vp/hal/feature_manager/sw_filter.h and
+//!           the vp_common.h types it uses, so that the bench builds without MOS and GMM.
+//!
+#ifndef __SW_FILTER_H__
+#define __SW_FILTER_H__
+
+#include <stdint.h>
+
+typedef struct tagRECT
+{
+    int32_t left;
+    int32_t top;
+    int32_t right;
+    int32_t bottom;
+} RECT;
+
+enum MOS_FORMAT
+{
+    Format_None,
+    Format_NV12,
+    Format_A8R8G8B8,
+};
+
+enum MOS_TILE_TYPE
+{
+    MOS_TILE_X,
+    MOS_TILE_Y,
+};
+
+enum VPHAL_CSPACE
+{
+    CSpace_None,
+    CSpace_BT709,
+    CSpace_sRGB,
+};
+
+enum VPHAL_SAMPLE_TYPE
+{
+    SAMPLE_PROGRESSIVE,
+};
+
+enum VPHAL_SCALING_MODE
+{
+    VPHAL_SCALING_NEAREST,
+    VPHAL_SCALING_BILINEAR,
+    VPHAL_SCALING_AVS,
+};
+
+enum VPHAL_SCALING_PREFERENCE
+{
+    VPHAL_SCALING_PREFER_SFC = 0,
+    VPHAL_SCALING_PREFER_COMP,
+    VPHAL_SCALING_PREFER_SFC_FOR_VEBOX,
+};
+
+enum VPHAL_ISCALING_TYPE
+{
+    ISCALING_NONE,
+};
+
+enum VPHAL_ROTATION
+{
+    VPHAL_ROTATION_IDENTITY,
+    VPHAL_ROTATION_90,
+};
+
+enum VPHAL_ALPHA_FILL_MODE
+{
+    VPHAL_ALPHA_FILL_MODE_NONE,
+};
+
+typedef struct _VPHAL_IEF_PARAMS
+{
+    bool bEnabled;
+} VPHAL_IEF_PARAMS, *PVPHAL_IEF_PARAMS;
+
+typedef struct _VPHAL_COLORFILL_PARAMS
+{
+    bool bDisableColorfillinSFC;
+    bool bOnePixelBiasinSFC;
+} VPHAL_COLORFILL_PARAMS, *PVPHAL_COLORFILL_PARAMS;
+
+typedef struct _VPHAL_ALPHA_PARAMS
+{
+    float                 fAlpha;
+    VPHAL_ALPHA_FILL_MODE AlphaMode;
+} VPHAL_ALPHA_PARAMS, *PVPHAL_ALPHA_PARAMS;
+
+union VP_EngineEntry
+{
+    struct
+    {
+        uint32_t bEnabled : 1;
+        uint32_t SfcNeeded : 1;
+        uint32_t VeboxNeeded : 1;
+        uint32_t RenderNeeded : 1;
+    };
+    uint32_t value;
+};
+
+namespace vp
+{
+enum FeatureType
+{
+    FeatureTypeInvalid  = 0,
+    FeatureTypeCsc      = 0x100,
+    FeatureTypeRotMir   = 0x200,
+    FeatureTypeScaling  = 0x300,
+    FeatureTypeAlpha    = 0x1900,
+};
+
+struct FeatureParam
+{
+    FeatureType type         = FeatureTypeInvalid;
+    MOS_FORMAT  formatInput  = Format_None;
+    MOS_FORMAT  formatOutput = Format_None;
+};
+
+struct FeatureParamCsc : public FeatureParam
+{
+    struct CSC_PARAMS
+    {
+        VPHAL_CSPACE    colorSpace      = CSpace_None;
+        uint32_t        chromaSiting    = 0;
+    };
+    CSC_PARAMS          input           = {};
+    CSC_PARAMS          output          = {};
+    PVPHAL_IEF_PARAMS   pIEFParams      = nullptr;
+    PVPHAL_ALPHA_PARAMS pAlphaParams    = nullptr;
+    FeatureParamCsc     *next           = nullptr;                //!< pointe to new/next generated CSC params
+};
+
+struct FeatureParamScaling : public FeatureParam
+{
+    struct SCALING_PARAMS
+    {
+        uint32_t                dwWidth  = 0;
+        uint32_t                dwHeight = 0;
+        RECT                    rcSrc    = {0, 0, 0, 0};
+        RECT                    rcDst    = {0, 0, 0, 0};  //!< Input dst rect without rotate being applied.
+        RECT                    rcMaxSrc = {0, 0, 0, 0};
+        VPHAL_SAMPLE_TYPE       sampleType = SAMPLE_PROGRESSIVE;
+    };
+
+    // Parameters maintained by scaling feature parameters
+    SCALING_PARAMS              input       = {};
+    SCALING_PARAMS              output      = {};
+    bool                        isPrimary   = false;
+    VPHAL_SCALING_MODE          scalingMode = VPHAL_SCALING_NEAREST;
+    VPHAL_SCALING_PREFERENCE    scalingPreference  = VPHAL_SCALING_PREFER_SFC;  //!< DDI indicate Scaling preference
+    bool                        bDirectionalScalar = false;     //!< Vebox Directional Scalar
+    bool                        bTargetRectangle   = false;     // Target rectangle enabled
+    PVPHAL_COLORFILL_PARAMS     pColorFillParams = nullptr;     //!< ColorFill - BG only
+    PVPHAL_ALPHA_PARAMS         pCompAlpha       = nullptr;     //!< Alpha for composited surfaces
+    VPHAL_ISCALING_TYPE         interlacedScalingType = ISCALING_NONE;
+
+    // Parameters maintained by other feature parameters.
+    struct {
+        VPHAL_CSPACE colorSpaceOutput = CSpace_None;
+    } csc;
+
+    struct {
+        bool                    rotationNeeded = false;                 //!< Whether rotate SwFilter exists on SwFilterPipe.
+    } rotation;
+
+    FeatureParamScaling        *next = nullptr;                           //!< pointe to new/next generated scaling params
+};
+
+struct FeatureParamRotMir : public FeatureParam
+{
+    // Parameters maintained by rotation feature parameters
+    VPHAL_ROTATION rotation = VPHAL_ROTATION_IDENTITY;
+
+    // Parameters maintained by other feature parameters.
+    struct {
+        MOS_TILE_TYPE tileOutput = MOS_TILE_X;
+    } surfInfo;
+};
+
+struct FeatureParamAlpha : public FeatureParam
+{
+    PVPHAL_ALPHA_PARAMS     compAlpha         = nullptr;      //!< Alpha for composited surface
+    bool                    calculatingAlpha  = false;        //!< Alpha calculation parameters
+};
+}
+#endif // __SW_FILTER_H__
@@ -0,0 +1,131 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     vp_policy_caps_cache_bench.cpp
+//! \brief    CPU time per frame of the policy engine caps cache
+//! \details  Usage: VpPolicyCapsCacheBench [frames] [configs]
+//!           A transcode stream submits the same scaling + csc + rotation pipe for every
+//!           frame, cycling through configs output sizes. Per frame, the key is built from
+//!           the feature parameters the way Policy::BuildCapsCacheKey does, and the cached
+//!           caps are applied on a hit, or resolved and saved on a miss.
+//!
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "vp_policy_caps_cache.h"
+#include "media_bench.h"
+
+using namespace vp;
+
+int main(int argc, char **argv)
+{
+    uint32_t frameNum  = MediaBenchArg(argc, argv, 1, 1000000);
+    uint32_t configNum = MediaBenchArg(argc, argv, 2, 1);
+
+    if (configNum == 0)
+    {
+        configNum = 1;
+    }
+
+    printf("configs  ns/frame        hit       miss  cached\n");
+    for (uint32_t configs = 1; configs <= configNum; configs <<= 1)
+    {
+        VpPolicyCapsCache                       cache;
+        std::vector<VpPolicyCapsCache::Feature> features;
+        FeatureParamCsc                         csc;
+        FeatureParamScaling                     scaling;
+        FeatureParamRotMir                      rotMir;
+        VP_EngineEntry                          cscCaps     = {};
+        VP_EngineEntry                          scalingCaps = {};
+        VP_EngineEntry                          rotMirCaps  = {};
+        uint64_t                                enabled     = 0;
+
+        csc.formatInput                 = Format_NV12;
+        csc.formatOutput                = Format_A8R8G8B8;
+        csc.input.colorSpace            = CSpace_BT709;
+        csc.output.colorSpace           = CSpace_sRGB;
+        scaling.formatInput             = Format_NV12;
+        scaling.formatOutput            = Format_A8R8G8B8;
+        scaling.input.dwWidth           = 1920;
+        scaling.input.dwHeight          = 1080;
+        scaling.input.rcSrc             = {0, 0, 1920, 1080};
+        scaling.isPrimary               = true;
+        scaling.scalingMode             = VPHAL_SCALING_AVS;
+        rotMir.formatInput              = Format_NV12;
+        rotMir.formatOutput             = Format_A8R8G8B8;
+        rotMir.rotation                 = VPHAL_ROTATION_90;
+        rotMir.surfInfo.tileOutput      = MOS_TILE_Y;
+
+        MediaBenchTimer timer;
+        for (uint32_t frame = 0; frame < frameNum; frame++)
+        {
+            int32_t width = 1280 + (frame % configs) * 64;
+
+            scaling.input.rcDst     = {0, 0, width, 720};
+            scaling.output.dwWidth  = width;
+            scaling.output.dwHeight = 720;
+            scaling.output.rcSrc    = {0, 0, width, 720};
+            scaling.output.rcDst    = {0, 0, width, 720};
+            cscCaps.value           = 0;
+            scalingCaps.value       = 0;
+            rotMirCaps.value        = 0;
+
+            cache.ResetKey();
+            cache.AddToKey(0);                  // sfc disabled
+            cache.AddToKey(0);                  // vebox output disabled
+            cache.AddToKey(1);                  // input pipes
+            cache.AddCscToKey(csc);
+            cache.AddScalingToKey(scaling);
+            cache.AddRotMirToKey(rotMir);
+            cache.AddToKey(FeatureTypeInvalid); // end of sub pipe
+            cache.AddToKey(0);                  // output pipes
+
+            features.clear();
+            features.push_back({&cscCaps, nullptr});
+            features.push_back({&scalingCaps, &scaling.scalingPreference});
+            features.push_back({&rotMirCaps, nullptr});
+
+            if (!cache.Apply(features))
+            {
+                cscCaps.bEnabled        = 1;
+                cscCaps.SfcNeeded       = 1;
+                scalingCaps.bEnabled    = 1;
+                scalingCaps.SfcNeeded   = 1;
+                rotMirCaps.bEnabled     = 1;
+                rotMirCaps.SfcNeeded    = 1;
+                cache.Save(features);
+            }
+            enabled += scalingCaps.bEnabled;
+        }
+        double ns = timer.Ns();
+
+        printf("%7u  %8.1f  %9llu  %9llu  %6u\n", configs, ns / frameNum,
+            (unsigned long long)cache.GetHitCount(), (unsigned long long)cache.GetMissCount(), cache.GetSize());
+        if (enabled != frameNum)
+        {
+            fprintf(stderr, "Caps not applied\n");
+            return -1;
+        }
+    }
+
+    return 0;
+}
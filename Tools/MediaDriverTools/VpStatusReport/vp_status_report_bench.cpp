@@ -0,0 +1,211 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     vp_status_report_bench.cpp
+//! \brief    CPU time of VP surface syncs with 1000 frames outstanding, table scan against index
+//! \details  Usage: VpStatusReportBench [rounds]
+//!
+
+#include <stdio.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "vp_status_table.h"
+#include "media_libva_vp_status.h"
+#include "media_bench.h"
+
+static const uint32_t contextNum      = 2;
+static const uint32_t framesPerContext = 500;
+
+// VP HAL status table with NullHW: every frame is done by GPU when reported
+class NullHwVpHal
+{
+public:
+    NullHwVpHal(bool useIndex) : m_useIndex(useIndex)
+    {
+        MOS_ZeroMemory(&m_table, sizeof(m_table));
+    }
+
+    void Submit(uint32_t statusFeedBackID)
+    {
+        PVPHAL_STATUS_ENTRY entry = VpHal_StatusTableAddEntry(&m_table, statusFeedBackID);
+        entry->dwStatus           = VPREP_NOTREADY;
+    }
+
+    MOS_STATUS GetStatusReport(PQUERY_STATUS_REPORT_APP pQueryReport, uint16_t numStatus)
+    {
+        uint32_t tableLen = VpHal_StatusTableLength(&m_table);
+        uint32_t i        = 0;
+        for (; i < numStatus && i < tableLen; i++)
+        {
+            PVPHAL_STATUS_ENTRY entry        = &m_table.aTableEntries[VPHAL_STATUS_TABLE_MASK(m_table.uiHead + i)];
+            entry->dwStatus                  = VPREP_OK;
+            pQueryReport[i].StatusFeedBackID = entry->StatusFeedBackID;
+            pQueryReport[i].dwStatus         = entry->dwStatus;
+        }
+        VpHal_StatusTableSetHead(&m_table, VPHAL_STATUS_TABLE_MASK(m_table.uiHead + i));
+        for (; i < numStatus; i++)
+        {
+            pQueryReport[i].StatusFeedBackID = 0;
+            pQueryReport[i].dwStatus         = VPREP_NOTAVAILABLE;
+        }
+        return MOS_STATUS_SUCCESS;
+    }
+
+    MOS_STATUS GetStatusReportEntryLength(uint32_t *puiLength)
+    {
+        *puiLength = VpHal_StatusTableLength(&m_table);
+        return MOS_STATUS_SUCCESS;
+    }
+
+    MOS_STATUS GetStatusReportEntryIndex(uint32_t statusFeedBackID, uint32_t *puiIndex)
+    {
+        if (m_useIndex)
+        {
+            *puiIndex = VpHal_StatusTableFindEntry(&m_table, statusFeedBackID);
+            return MOS_STATUS_SUCCESS;
+        }
+        // the scan from head the index replaced
+        uint32_t tableLen = VpHal_StatusTableLength(&m_table);
+        uint32_t i        = 0;
+        while (i < tableLen && m_table.aTableEntries[VPHAL_STATUS_TABLE_MASK(m_table.uiHead + i)].StatusFeedBackID != statusFeedBackID)
+        {
+            i++;
+        }
+        *puiIndex = i;
+        return MOS_STATUS_SUCCESS;
+    }
+
+private:
+    VPHAL_STATUS_TABLE m_table;
+    bool               m_useIndex;
+};
+
+struct Surface
+{
+    uint32_t context;
+    bool     pending;
+    uint32_t status;
+};
+
+// Submits framesPerContext frames to each context, then syncs every surface in order
+static uint64_t Round(std::vector<NullHwVpHal> &vpHals, std::vector<Surface> &surfaces, const std::vector<uint32_t> &order,
+    QUERY_STATUS_REPORT_APP *reports)
+{
+    for (uint32_t id = 0; id < surfaces.size(); id++)
+    {
+        surfaces[id].pending = true;
+        vpHals[surfaces[id].context].Submit(id);
+    }
+
+    MediaBenchTimer timer;
+    for (auto id : order)
+    {
+        if (!surfaces[id].pending)
+        {
+            continue;
+        }
+        DdiVp_DrainStatusReport(&vpHals[surfaces[id].context], reports, id, [&surfaces](const QUERY_STATUS_REPORT_APP &report) {
+            surfaces[report.StatusFeedBackID].pending = false;
+            surfaces[report.StatusFeedBackID].status  = report.dwStatus;
+        });
+    }
+    return timer.Ns();
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t                rounds = MediaBenchArg(argc, argv, 1, 2000);
+    const char             *names[] = {"submission", "reverse", "random"};
+    std::vector<uint32_t>   orders[3];
+    std::mt19937            rand(2026);
+    QUERY_STATUS_REPORT_APP reports[VPHAL_STATUS_TABLE_MAX_SIZE];
+
+    // the 2 contexts submit in turns, like two VP streams
+    std::vector<Surface> surfaces(contextNum * framesPerContext);
+    for (uint32_t id = 0; id < surfaces.size(); id++)
+    {
+        surfaces[id].context = id % contextNum;
+        orders[0].push_back(id);
+    }
+    orders[1].assign(orders[0].rbegin(), orders[0].rend());
+    orders[2] = orders[0];
+    std::shuffle(orders[2].begin(), orders[2].end(), rand);
+
+    printf("outstanding  sync order  table scan ns/sync  index ns/sync\n");
+    for (uint32_t o = 0; o < 3; o++)
+    {
+        double   ns[2]       = {};
+        uint64_t statusSum[2] = {};
+        for (uint32_t useIndex = 0; useIndex < 2; useIndex++)
+        {
+            std::vector<NullHwVpHal> vpHals(contextNum, NullHwVpHal(useIndex != 0));
+            uint64_t                 total = 0;
+            for (uint32_t r = 0; r < rounds; r++)
+            {
+                total += Round(vpHals, surfaces, orders[o], reports);
+                for (auto &surface : surfaces)
+                {
+                    statusSum[useIndex] += surface.pending ? 100 : surface.status;
+                }
+            }
+            ns[useIndex] = (double)total / rounds / surfaces.size();
+        }
+        printf("%11u  %10s  %18.1f  %13.1f\n", (uint32_t)surfaces.size(), names[o], ns[0], ns[1]);
+        if (statusSum[0] != statusSum[1])
+        {
+            fprintf(stderr, "Results differ\n");
+            return -1;
+        }
+    }
+
+    // the lookup alone, every outstanding frame found once per round
+    double   lookupNs[2]  = {};
+    uint64_t indexSum[2]  = {};
+    for (uint32_t useIndex = 0; useIndex < 2; useIndex++)
+    {
+        std::vector<NullHwVpHal> vpHals(contextNum, NullHwVpHal(useIndex != 0));
+        for (uint32_t id = 0; id < surfaces.size(); id++)
+        {
+            vpHals[surfaces[id].context].Submit(id);
+        }
+        MediaBenchTimer timer;
+        for (uint32_t r = 0; r < rounds; r++)
+        {
+            for (auto id : orders[2])
+            {
+                uint32_t index = 0;
+                vpHals[surfaces[id].context].GetStatusReportEntryIndex(id, &index);
+                indexSum[useIndex] += index;
+            }
+        }
+        lookupNs[useIndex] = (double)timer.Ns() / rounds / surfaces.size();
+    }
+    printf("%11u  %10s  %18.1f  %13.1f\n", (uint32_t)surfaces.size(), "no drain", lookupNs[0], lookupNs[1]);
+    if (indexSum[0] != indexSum[1])
+    {
+        fprintf(stderr, "Results differ\n");
+        return -1;
+    }
+
+    return 0;
+}
@@ -22,13 +22,15 @@
 #include "cm_perf_statistics.h"
 #include "cm_mem.h"
 #include "cm_sdk_provider.h"
+#include <algorithm>
 
 #if MDF_PROFILER_ENABLED
 
+thread_local ApiCallRing *CmPerfStatistics::m_threadRing = nullptr;
+
 CmPerfStatistics::CmPerfStatistics()
 {
 
-    m_apiCallRecordCount  = 0;
     m_apiCallFile         = nullptr;
 
     m_perfStatisticFile   = nullptr;
@@ -37,6 +39,12 @@ CmPerfStatistics::CmPerfStatistics()
     m_profilerOn      = false;
     m_profilerLevel    = CM_RT_PERF_LOG_LEVEL_DEFAULT;
 
+    CmSafeMemSet(m_functionNames, 0, sizeof(m_functionNames));
+
+    m_ticksPerMs     = 0;
+    m_startTimestamp = GetTimestamp();
+    QueryPerformanceCounter(&m_startCounter);
+
     GetProfilerLevel(); // get profiler level from env variable "CM_RT_PERF_LOG"
 
     if(m_profilerLevel >= CM_RT_PERF_LOG_LEVEL_ETW)
@@ -48,9 +56,17 @@ CmPerfStatistics::CmPerfStatistics()
 
 CmPerfStatistics::~CmPerfStatistics()
 {
+    CalibrateTicks();
+
     DumpApiCallRecords();
 
     DumpPerfStatisticRecords();
+
+    for (auto ring : m_apiCallRings)
+    {
+        CmSafeRelease(ring);
+    }
+    m_apiCallRings.clear();
 }
 
 void CmPerfStatistics::GetProfilerLevel()
@@ -60,65 +76,96 @@ void CmPerfStatistics::GetProfilerLevel()
     return;
 }
 
-//! Insert API Call Records Into m_apiCallRecords Array and Update Perf Statistic Array accordingly
-void CmPerfStatistics::InsertApiCallRecord(char *functionName, float time, LARGE_INTEGER start, LARGE_INTEGER end)
+//! Intern Function Name, Called Once per Profiled Function
+uint32_t CmPerfStatistics::RegisterFunction(const char *functionName)
 {
-    CLock locker(m_criticalSectionOnApiCallRecords);
+    CLock locker(m_criticalSectionOnPerfStatisticRecords);
 
-    ApiCallRecord *records = new ApiCallRecord ;
+    for (uint32_t index = 0; index < m_perfStatisticCount; index++)
+    {
+        if (!strcmp(functionName, m_functionNames[index]))
+        {
+            return index;
+        }
+    }
 
-    records->startTime = start;
-    records->endTime   = end;
-    records->duration   = time;
+    if (m_perfStatisticCount == MAX_PROFILED_FUNCTION_NUM)
+    {   // out of ids, account the call to the last registered function
+        return MAX_PROFILED_FUNCTION_NUM - 1;
+    }
 
-    CM_STRCPY(records->functionName, MSG_STRING_SIZE, functionName);
+    m_functionNames[m_perfStatisticCount] = functionName;
+    return m_perfStatisticCount++;
+}
 
-    m_apiCallRecords.push_back(records);
-    m_apiCallRecordCount++;
+ApiCallRing *CmPerfStatistics::GetThreadRing()
+{
+    if (m_threadRing == nullptr)
+    {
+        ApiCallRing *ring = new (std::nothrow) ApiCallRing;
+        if (ring == nullptr)
+        {
+            return nullptr;
+        }
+        CmSafeMemSet(ring->counters, 0, sizeof(ring->counters));
+        ring->recordCount = 0;
 
-    InsertPerfStatistic(records);
+        CLock locker(m_criticalSectionOnApiCallRecords);
+        ring->threadIndex = (uint32_t)m_apiCallRings.size();
+        m_apiCallRings.push_back(ring);
+        m_threadRing = ring;
+    }
 
+    return m_threadRing;
 }
 
-//Update Perf Statistic Array
-void CmPerfStatistics::InsertPerfStatistic(ApiCallRecord *record)
+//! Append API Call Record to the Calling Thread's Ring and Update its Counters
+void CmPerfStatistics::InsertApiCallRecord(uint32_t functionId, uint64_t start, uint64_t end)
 {
-    uint32_t index = 0;
-
-    for( index = 0 ; index < m_perfStatisticCount ; index ++)
+    ApiCallRing *ring = GetThreadRing();
+    if (ring == nullptr || functionId >= MAX_PROFILED_FUNCTION_NUM)
     {
-        ApiPerfStatistic *perfStatisticRecords = m_perfStatisticRecords[index];
-        if(perfStatisticRecords != nullptr)
-        {
-            if(!strcmp(record->functionName, perfStatisticRecords->functionName))
-            { // existing
-               perfStatisticRecords->callTimes ++ ;
-               perfStatisticRecords->time += record->duration;
+        return;
+    }
 
-               //Update statistic records
-               m_perfStatisticRecords[index] = perfStatisticRecords;
+    uint64_t count  = ring->recordCount.load(std::memory_order_relaxed);
+    uint64_t ticks  = end - start;
 
-               break;
-            }
-        }
-    }
+    ApiCallRecord &record = ring->records[count & (API_CALL_RING_SIZE - 1)];
+    record.functionId     = functionId;
+    record.threadIndex    = ring->threadIndex;
+    record.startTime      = start;
+    record.endTime        = end;
 
-    if(index == m_perfStatisticCount)
-    { // record does not exist, create new entry
-        ApiPerfStatistic *perfStatisticRecords = new ApiPerfStatistic;
-        CM_STRCPY(perfStatisticRecords->functionName, MSG_STRING_SIZE, record->functionName);
+    ApiPerfCounter &counter = ring->counters[functionId];
+    counter.callTimes++;
+    counter.ticks   += ticks;
+    counter.maxTicks = (ticks > counter.maxTicks) ? ticks : counter.maxTicks;
 
-        perfStatisticRecords->callTimes = 1;
-        perfStatisticRecords->time       = record->duration;
+    // publish the record to the dump at teardown
+    ring->recordCount.store(count + 1, std::memory_order_release);
+}
 
-        m_perfStatisticRecords.push_back(perfStatisticRecords);
-        m_perfStatisticCount ++;
+void CmPerfStatistics::CalibrateTicks()
+{
+    LARGE_INTEGER freq, counter;
+    QueryPerformanceFrequency(&freq);
+#if defined(__x86_64__) || defined(__i386__)
+    uint64_t timestamp = GetTimestamp();
+    QueryPerformanceCounter(&counter);
+
+    double elapsedMs = (double)(counter.QuadPart - m_startCounter.QuadPart) * 1000.0 / (double)freq.QuadPart;
+    if (elapsedMs > 0)
+    {
+        m_ticksPerMs = (double)(timestamp - m_startTimestamp) / elapsedMs;
+        return;
     }
-
-    return ;
+#endif
+    // timestamps are performance counter ticks
+    m_ticksPerMs = (double)freq.QuadPart / 1000.0;
 }
 
-//Dump APICall Records and Release m_apiCallRecords Array
+//Dump APICall Records Kept in the Rings, Oldest First
 void CmPerfStatistics::DumpApiCallRecords()
 {
     if(!m_profilerOn)
@@ -132,25 +179,33 @@ void CmPerfStatistics::DumpApiCallRecords()
         fprintf(stdout, "Fail to create file CmPerfLog.csv \n ");
         return ;
     }
-    fprintf(m_apiCallFile,  "%-40s %s \t %s \t %s \n", "FunctionName", "StartTime", "EndTime", "Duration");
+    fprintf(m_apiCallFile,  "%-40s %s \t %s \t %s \t %s \n", "FunctionName", "Thread", "StartTime", "EndTime", "Duration");
 
-    for(uint32_t i=0 ; i< m_apiCallRecordCount ; i++)
+    std::vector<ApiCallRecord> records;
+    for (auto ring : m_apiCallRings)
     {
-        ApiCallRecord *records = m_apiCallRecords[i];
-
-        fprintf(m_apiCallFile,  "%-40s  %lld \t %lld \t %fms \n", records->functionName,
-           records->startTime.QuadPart, records->endTime.QuadPart, records->duration);
-
-        CmSafeRelease(records);
+        uint64_t count = ring->recordCount.load(std::memory_order_acquire);
+        uint64_t first = (count > API_CALL_RING_SIZE) ? count - API_CALL_RING_SIZE : 0;
+        for (uint64_t i = first; i < count; i++)
+        {
+            records.push_back(ring->records[i & (API_CALL_RING_SIZE - 1)]);
+        }
     }
+    std::stable_sort(records.begin(), records.end(),
+        [](const ApiCallRecord &a, const ApiCallRecord &b) { return a.startTime < b.startTime; });
 
-    m_apiCallRecords.clear();
+    for (auto &record : records)
+    {
+        fprintf(m_apiCallFile,  "%-40s  %u \t %llu \t %llu \t %fms \n", m_functionNames[record.functionId], record.threadIndex,
+           (unsigned long long)record.startTime, (unsigned long long)record.endTime,
+           (record.endTime - record.startTime) / m_ticksPerMs);
+    }
 
     fclose(m_apiCallFile);
 
 }
 
-//Dump Perf Statistic Records and Release m_perfStatisticRecords Array
+//Aggregate the Rings into per API Latency Statistics and Dump them
 void CmPerfStatistics::DumpPerfStatisticRecords()
 {
     if(!m_profilerOn)
@@ -164,20 +219,46 @@ void CmPerfStatistics::DumpPerfStatisticRecords()
         fprintf(stdout, "Fail to create file CmPerfStatistics.txt \n ");
         return ;
     }
-    fprintf(m_perfStatisticFile,  "%-40s %s \t %s \n", "FunctionName", "Total Time(ms)", "Called Times");
+    fprintf(m_perfStatisticFile,  "%-40s %s \t %s \t %s \t %s \t %s \n", "FunctionName", "Total Time(ms)", "Called Times",
+        "P50(ms)", "P99(ms)", "Max(ms)");
+
+    // percentiles come from the records still in the rings, i.e. the last API_CALL_RING_SIZE calls of each thread
+    std::vector<std::vector<uint64_t>> durations(m_perfStatisticCount);
+    for (auto ring : m_apiCallRings)
+    {
+        uint64_t count = ring->recordCount.load(std::memory_order_acquire);
+        uint64_t first = (count > API_CALL_RING_SIZE) ? count - API_CALL_RING_SIZE : 0;
+        for (uint64_t i = first; i < count; i++)
+        {
+            const ApiCallRecord &record = ring->records[i & (API_CALL_RING_SIZE - 1)];
+            durations[record.functionId].push_back(record.endTime - record.startTime);
+        }
+    }
 
     for(uint32_t i=0 ; i< m_perfStatisticCount; i++)
     {
-        ApiPerfStatistic *perfStatisticRecords = m_perfStatisticRecords[i];
+        ApiPerfCounter total = {};
+        for (auto ring : m_apiCallRings)
+        {
+            total.callTimes += ring->counters[i].callTimes;
+            total.ticks     += ring->counters[i].ticks;
+            total.maxTicks   = (std::max)(total.maxTicks, ring->counters[i].maxTicks);
+        }
+        if (total.callTimes == 0)
+        {
+            continue;
+        }
 
-        fprintf(m_perfStatisticFile,  "%-40s %fms \t %d \n", perfStatisticRecords->functionName,
-           perfStatisticRecords->time, perfStatisticRecords->callTimes);
+        std::vector<uint64_t> &samples = durations[i];
+        std::sort(samples.begin(), samples.end());
+        uint64_t p50 = samples.empty() ? 0 : samples[(samples.size() - 1) * 50 / 100];
+        uint64_t p99 = samples.empty() ? 0 : samples[(samples.size() - 1) * 99 / 100];
 
-        CmSafeRelease(perfStatisticRecords);
+        fprintf(m_perfStatisticFile,  "%-40s %fms \t %llu \t %fms \t %fms \t %fms \n", m_functionNames[i],
+           total.ticks / m_ticksPerMs, (unsigned long long)total.callTimes,
+           p50 / m_ticksPerMs, p99 / m_ticksPerMs, total.maxTicks / m_ticksPerMs);
     }
 
-    m_perfStatisticRecords.clear();
-
     fclose(m_perfStatisticFile);
 
 }
@@ -29,23 +29,44 @@
 
 #if MDF_PROFILER_ENABLED
 
+#include <atomic>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
 #define MAX_RECORD_NUM  256
 #define MSG_STRING_SIZE 256
 #define INIT_ARRAY_ZIE  256
 
-struct ApiPerfStatistic
+#define MAX_PROFILED_FUNCTION_NUM   512     // interned API names, CM exports far less
+#define API_CALL_RING_SIZE          16384   // api call records kept per thread, power of 2
+
+struct ApiCallRecord
 {
-    char  functionName[MSG_STRING_SIZE];       // function name
-    float time;                                 // accumulative api duration
-    uint32_t callTimes;                           // called times
+    uint32_t functionId;                        // interned function name
+    uint32_t threadIndex;                       // index of the recording thread
+    uint64_t startTime;                         // start timestamp
+    uint64_t endTime;                           // end timestamp
 };
 
-struct ApiCallRecord
+struct ApiPerfCounter
 {
-    char  functionName[MSG_STRING_SIZE];       // function name
-    LARGE_INTEGER  startTime;                  // start time
-    LARGE_INTEGER  endTime;                    // end time
-    float          duration;                    // duration
+    uint64_t callTimes;                         // called times
+    uint64_t ticks;                             // accumulative api duration in timestamp ticks
+    uint64_t maxTicks;                          // longest api duration in timestamp ticks
+};
+
+//!
+//! \brief  Api call records of one thread
+//! \details Only the owning thread writes, records wrap around once API_CALL_RING_SIZE is reached.
+//!          The counters keep exact totals for the calls whose records were overwritten.
+//!
+struct ApiCallRing
+{
+    ApiCallRecord         records[API_CALL_RING_SIZE];
+    ApiPerfCounter        counters[MAX_PROFILED_FUNCTION_NUM];
+    std::atomic<uint64_t> recordCount;
+    uint32_t              threadIndex;
 };
 
 enum PerfLogLevel
@@ -62,26 +83,44 @@ public:
     ~CmPerfStatistics();
 
     //!
-    //! \brief    Insert API call record 
-    //! \details  Insert API call record which contains function name, start time, end and duration.
+    //! \brief    Get timestamp
+    //! \details  Read the time stamp counter, or the performance counter where there is none.
+    //!           Ticks are converted to ms when the records are dumped.
+    //! \return   uint64_t
+    //!           current timestamp in ticks
+    //!
+    static inline uint64_t GetTimestamp()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        LARGE_INTEGER counter;
+        QueryPerformanceCounter(&counter);
+        return counter.QuadPart;
+#endif
+    }
+
+    //!
+    //! \brief    Register function
+    //! \details  Intern the function name, called once per profiled function.
     //! \param    [in] functionName
-    //!           pointer to function name's string
-    //! \param    [in] time
-    //!           function's duration
-    //! \param    [in] start
-    //!           function's start time
-    //! \param    [in] end
-    //!           function's end time
+    //!           pointer to function name's string, must stay valid until teardown
+    //! \return   uint32_t
+    //!           function id to pass to InsertApiCallRecord
     //!
-    void InsertApiCallRecord(char *functionName, float time, LARGE_INTEGER start, LARGE_INTEGER end);
+    uint32_t RegisterFunction(const char *functionName);
 
     //!
-    //! \brief    Insert API call record into performace statistic record
-    //! \details  Insert API call record into performace statistic record.
-    //! \param    [in] pRecords
-    //!           pointer to API call record
+    //! \brief    Insert API call record 
+    //! \details  Append the API call record to the calling thread's ring, without lock nor allocation.
+    //! \param    [in] functionId
+    //!           function id returned by RegisterFunction
+    //! \param    [in] start
+    //!           function's start timestamp
+    //! \param    [in] end
+    //!           function's end timestamp
     //!
-    void InsertPerfStatistic(ApiCallRecord *records);
+    void InsertApiCallRecord(uint32_t functionId, uint64_t start, uint64_t end);
 
 private:
 
@@ -91,34 +130,53 @@ private:
     //!
     void GetProfilerLevel();
 
+    //!
+    //! \brief    Get the calling thread's ring
+    //! \details  Allocated on the first profiled call of the thread and kept until teardown.
+    //! \return   ApiCallRing*
+    //!           pointer to the ring, nullptr if it can't be allocated
+    //!
+    ApiCallRing *GetThreadRing();
+
+    //!
+    //! \brief    Calibrate timestamp ticks
+    //! \details  Measure the ticks per ms against the performance counter over the profiler's lifetime.
+    //!
+    void CalibrateTicks();
+
     //!
     //! \brief    Dump API call records into file
-    //! \details  Dump API call records into file, 
+    //! \details  Dump API call records kept in the rings into file, 
     //!           "CmPerfLog.csv" under app's location.
     //!
     void DumpApiCallRecords();
 
     //!
     //! \brief    Dump API call statistic records into file
-    //! \details  Dump API call statistic records into file, 
+    //! \details  Dump per API total time, called times and p50/p99/max latency into file, 
     //!           "CmPerfStatistics" under app's location.
     //!
     void DumpPerfStatisticRecords();
 
     CSync           m_criticalSectionOnApiCallRecords;
-    uint32_t        m_apiCallRecordCount;
     FILE           *m_apiCallFile;
 
     CSync           m_criticalSectionOnPerfStatisticRecords;
     FILE           *m_perfStatisticFile;
     uint32_t        m_perfStatisticCount;
 
-    std::vector<ApiCallRecord*>      m_apiCallRecords;  // array to store api call records
-    std::vector<ApiPerfStatistic*>   m_perfStatisticRecords; // array to store perf statistic information
+    std::vector<ApiCallRing*>        m_apiCallRings;      // rings of all threads which made profiled calls
+    const char                      *m_functionNames[MAX_PROFILED_FUNCTION_NUM]; // interned function names
+
+    uint64_t        m_startTimestamp;   // timestamp and performance counter at creation,
+    LARGE_INTEGER   m_startCounter;     // used to convert ticks to ms
+    double          m_ticksPerMs;
 
     PerfLogLevel m_profilerLevel; // profiler level
     bool m_profilerOn;   // profiler on or off
 
+    static thread_local ApiCallRing *m_threadRing;  // there is one profiler, gCmPerfStatistics
+
 private:
     CmPerfStatistics(const CmPerfStatistics &other);
     CmPerfStatistics &operator=(const CmPerfStatistics &other);
@@ -27,17 +27,11 @@
 #if MDF_PROFILER_ENABLED
 extern CmPerfStatistics gCmPerfStatistics;
 
-CmTimer::CmTimer(const char *functionName):
-    m_cycles(0),
-    m_funcName(const_cast<char*>(functionName))
+CmTimer::CmTimer(uint32_t functionId):
+    m_start(0),
+    m_end(0),
+    m_funcId(functionId)
 {
-    //Get frequency
-    QueryPerformanceFrequency(&m_freq);
-
-    // initialize private variables
-    m_start.QuadPart = 0;
-    m_end.QuadPart   = 0;
-
     //Start timer
     Start();
 
@@ -47,28 +41,26 @@ CmTimer::CmTimer(const char *functionName):
 CmTimer::~CmTimer()
 {
     Stop();
-    gCmPerfStatistics.InsertApiCallRecord(m_funcName, GetTimeinMs(), m_start,
-                                          m_end);
+    gCmPerfStatistics.InsertApiCallRecord(m_funcId, m_start, m_end);
+}
+
+uint32_t CmTimer::RegisterFunction(const char *functionName)
+{
+    return gCmPerfStatistics.RegisterFunction(functionName);
 }
 
 void CmTimer::Start()
 {
-    QueryPerformanceCounter(&m_start);  // recode API start time
+    m_start = CmPerfStatistics::GetTimestamp();  // recode API start time
     InsertEventStartFlag();
     return;
 }
 
 void CmTimer::Stop()
 {
-    QueryPerformanceCounter(&m_end);
-    m_cycles = m_end.QuadPart - m_start.QuadPart;
+    m_end = CmPerfStatistics::GetTimestamp();
     InsertEventEndFlag();
     return;
 }
 
-float CmTimer::GetTimeinMs()
-{
-    return (float)m_cycles * (float)1000.0 / (float)m_freq.QuadPart;
-}
-
 #endif  // #if MDF_PROFILER_ENABLED
@@ -32,30 +32,34 @@
 class CmTimer
 {
 public:
-    CmTimer(const char *functionName);
+    CmTimer(uint32_t functionId);
 
     ~CmTimer();
 
+    //!
+    //! \brief    Register function
+    //! \details  Intern the profiled function's name, once per function from INSERT_PROFILER_RECORD.
+    //! \param    [in] functionName
+    //!           pointer to function name's string
+    //! \return   uint32_t
+    //!           function id
+    //!
+    static uint32_t RegisterFunction(const char *functionName);
+
 private:
     void Start();
 
     void Stop();
 
-    float GetTimeinMs();
-
     void InsertEventStartFlag();
 
     void InsertEventEndFlag();
 
-    uint64_t m_cycles;
-
-    LARGE_INTEGER m_start;
-
-    LARGE_INTEGER m_end;
+    uint64_t m_start;
 
-    LARGE_INTEGER m_freq;
+    uint64_t m_end;
 
-    char *m_funcName;
+    uint32_t m_funcId;
 };
 
 #endif  // #if MDF_PROFILER_ENABLED
@@ -32,6 +32,7 @@
 #ifndef __MEMORY_BLOCK_MANAGER_H__
 #define __MEMORY_BLOCK_MANAGER_H__
 
+#include <algorithm>
 #include <list>
 #include <vector>
 #include <memory>
@@ -243,35 +244,23 @@ private:
     MOS_STATUS RegisterOsInterface(PMOS_INTERFACE osInterface);
 
     //!
-    //! \brief  Determines whether or not space is available, if not enough space returns
-    //!         the amount short in \a spaceNeeded
-    //! \param  [in] sortedSizes
-    //!         Requested block sizes sorted in decending order.
+    //! \brief  Sets up memory blocks for the requested space, if not enough space
+    //!         returns the amount short in \a spaceNeeded and leaves the free lists
+    //!         as they were before the call
     //! \param  [in] params
     //!         Parameters describing the requested space
+    //! \param  [out] blocks
+    //!         A vector containing the memory blocks allocated, entries are left
+    //!         invalid when not all of the space could be allocated
     //! \param  [out] spaceNeeded
     //!         Amount of space that the heap(s) are short of to complete space acquisition
     //! \return MOS_STATUS
     //!         MOS_STATUS_SUCCESS if success, else fail reason
     //!
-    MOS_STATUS IsSpaceAvailable(
-        AcquireParams &params,
-        uint32_t &spaceNeeded);
-
-    //!
-    //! \brief  Sets up memory blocks for the requested space
-    //! \param  [in] sortedSizes
-    //!         Requested block sizes sorted in decending order with original index saved from params.
-    //! \param  [in] params
-    //!         Parameters describing the requested space
-    //! \param  [out] blocks
-    //!         A vector containing the memory blocks allocated
-    //! \return MOS_STATUS
-    //!         MOS_STATUS_SUCCESS if success, else fail reason
-    //!
     MOS_STATUS AllocateSpace(
         AcquireParams &params,
-        std::vector<MemoryBlock> &blocks);
+        std::vector<MemoryBlock> &blocks,
+        uint32_t &spaceNeeded);
 
     //!
     //! \brief  Sets up memory blocks for the requested space
@@ -314,6 +303,57 @@ private:
         bool staticBlock,
         MemoryBlockInternal *freeBlock);
 
+    //!
+    //! \brief  Returns an allocated block to the free lists and coalesces it with
+    //!         its free neighbours in the heap
+    //! \param  [in] block
+    //!         Block to be freed, must not be in a sorted list
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS FreeBlock(MemoryBlockInternal *block);
+
+    //!
+    //! \brief  Maps a block size to its segregated free list \see m_freeLists
+    //! \param  [in] size
+    //!         Block size in bytes
+    //! \param  [out] fl
+    //!         First level index, power of two range of the size
+    //! \param  [out] sl
+    //!         Second level index, linear subdivision of the power of two range
+    //!
+    static void GetFreeListIndex(uint32_t size, uint32_t &fl, uint32_t &sl);
+
+    //!
+    //! \brief  Finds a free block of at least \a size bytes in O(1)
+    //! \details Picks the head of the smallest non-empty free list whose blocks are
+    //!          all large enough. Only when no such list exists is the list that may
+    //!          hold both smaller and larger blocks searched.
+    //! \param  [in] size
+    //!         Aligned size of the memory requested
+    //! \return MemoryBlockInternal*
+    //!         Free block which fits \a size, nullptr if there is none
+    //!
+    MemoryBlockInternal *FindFreeBlock(uint32_t size);
+
+    //!
+    //! \brief  Gets the first free block when walking the free lists from the largest
+    //!         size class down
+    //! \return MemoryBlockInternal*
+    //!         Valid pointer if there is a free block, nullptr otherwise
+    //!
+    MemoryBlockInternal *GetFirstFreeBlock();
+
+    //!
+    //! \brief  Gets the free block following \a block when walking the free lists from
+    //!         the largest size class down
+    //! \param  [in] block
+    //!         Free block currently in a free list
+    //! \return MemoryBlockInternal*
+    //!         Valid pointer if there is a next free block, nullptr otherwise
+    //!
+    MemoryBlockInternal *GetNextFreeBlock(MemoryBlockInternal *block);
+
     //!
     //! \brief  Sets up memory blocks for the requested space
     //! \param  [in] block
@@ -403,6 +443,7 @@ private:
             : m_originalIdx(originalIdx), m_blockSize(blockSize) {}
         uint32_t m_originalIdx = 0; //!< Original index of the requested block size \see AcquireParams::m_blockSizes
         uint32_t m_blockSize = 0;   //!< Aligned block size
+        MemoryBlockInternal *m_block = nullptr; //!< Block allocated for this size by AllocateSpace()
     };
 
     //! \brief Alignment for blocks in heap, currently fixed at a cacheline
@@ -411,6 +452,12 @@ private:
     static const uint16_t m_heapAlignment = MOS_PAGE_SIZE;
     //! \brief Number of submissions before a refresh, currently fixed
     static const uint16_t m_numSubmissionsForRefresh = 128;
+    //! \brief Each power of two size range is split into 2^m_freeListSlBits free lists
+    static const uint32_t m_freeListSlBits = 3;
+    //! \brief Number of second level free lists per power of two size range
+    static const uint32_t m_freeListSlCount = 1 << m_freeListSlBits;
+    //! \brief Number of first level free lists, one per power of two size range
+    static const uint32_t m_freeListFlCount = 32;
 
     //! \brief Total size of all managed heaps.
     uint32_t m_totalSizeOfHeaps = 0;
@@ -419,8 +466,15 @@ private:
     //! \brief List of block pools per heap for heaps in deletion process
     std::list<std::shared_ptr<HeapWithAdjacencyBlockList>> m_deletedHeaps;
     //! \brief Pools of memory blocks sorted by their states based on the state indicated
-    //!        by the latest TrackerId. The free pool is sorted in ascending order.
+    //!        by the latest TrackerId. Free blocks are kept in \see m_freeLists instead.
     MemoryBlockInternal *m_sortedBlockList[MemoryBlockInternal::State::stateCount] = {nullptr};
+    //! \brief   Segregated free lists indexed by size class \see GetFreeListIndex
+    //! \details Blocks within a list are unordered, so insertion and removal are O(1).
+    MemoryBlockInternal *m_freeLists[m_freeListFlCount][m_freeListSlCount] = {};
+    //! \brief Bit fl is set when any list in m_freeLists[fl] is non-empty
+    uint32_t m_freeListFlBitmap = 0;
+    //! \brief Bit sl of entry fl is set when m_freeLists[fl][sl] is non-empty
+    uint32_t m_freeListSlBitmap[m_freeListFlCount] = {0};
     //! \brief Number of entries in each sorted block list.
     uint32_t m_sortedBlockListNumEntries[MemoryBlockInternal::State::stateCount] = {0};
     //! \brief Sizes of each block pool.
@@ -436,11 +490,17 @@ private:
     //!          tracker data indicates that all blocks with tracker IDs less than or equal
     //!          to the udpated value may be re-used.
     uint32_t *m_trackerData = nullptr;
+    //! \brief   Value of \see m_trackerData at the last RefreshBlockStates()
+    //! \details While valid and unchanged, no submitted block can have become reusable,
+    //!          so the periodic refresh in AcquireSpace() is skipped.
+    uint32_t m_refreshedTrackerId = 0;
+    //! \brief Whether \see m_refreshedTrackerId may be used to skip a refresh
+    bool m_refreshedTrackerIdValid = false;
     PMOS_INTERFACE m_osInterface = nullptr; //!< OS interface used for managing graphics resources
     bool m_lockHeapsOnAllocate = false;             //!< All heaps allocated with the keep locked flag.
     
     //! \brief Persistent storage for the sorted sizes used during AcquireSpace()
-    std::list<SortedSizePair> m_sortedSizes;
+    std::vector<SortedSizePair> m_sortedSizes;
     //! \brief TrackerProducer
     FrameTrackerProducer *m_trackerProducer = nullptr;
     //! \bried Whether trackerProducer is set
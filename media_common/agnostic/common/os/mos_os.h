@@ -407,7 +407,8 @@ typedef struct _MOS_LOCK_PARAMS
             uint32_t ForceCached         : 1;                                    //!< Prefer normal map to global GTT map(Uncached) if both can work
             uint32_t DumpBeforeSubmit    : 1;                                    //!< Lock only for dump before submit
             uint32_t DumpAfterSubmit     : 1;                                    //!< Lock only for dump after submit
-            uint32_t Reserved            : 23;                                   //!< Reserved for expansion.
+            uint32_t WriteDiscard        : 1;                                    //!< Previous contents are not needed, every locked byte is overwritten.
+            uint32_t Reserved            : 22;                                   //!< Reserved for expansion.
         };
         uint32_t    Value;
     };
@@ -62,6 +62,8 @@
 #define __MEDIA_USER_FEATURE_VALUE_ENABLE_HCP_SCALABILITY_DECODE        "Enable HCP Scalability Decode"
 #define __MEDIA_USER_FEATURE_VALUE_ENABLE_VEBOX_SCALABILITY_MODE        "Enable Vebox Scalability"
 
+#define __MEDIA_USER_FEATURE_VALUE_COPY_WORKER_NUMBER                  "Media Copy Worker Number"      //!< vaGetImage plane copy threads, 0: copy on the calling thread only
+
 #if (_DEBUG || _RELEASE_INTERNAL)
 
 #define __MEDIA_USER_FEATURE_VALUE_MEDIA_RESET_ENABLE                   "Media Reset"
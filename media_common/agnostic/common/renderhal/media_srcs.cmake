@@ -20,6 +20,7 @@
 
 set(TMP_HEADERS_
     ${CMAKE_CURRENT_LIST_DIR}/renderhal.h
+    ${CMAKE_CURRENT_LIST_DIR}/renderhal_kernel_index.h
     ${CMAKE_CURRENT_LIST_DIR}/renderhal_platform_interface.h
 )
 
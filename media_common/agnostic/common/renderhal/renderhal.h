@@ -98,6 +98,17 @@ class XRenderHal_Platform_Interface;
 #define RENDERHAL_KERNEL_ALLOCATION_LOADING 4   // Kernel selected to be loaded (was stale or used)
 #define RENDERHAL_KERNEL_ALLOCATION_STALE   5   // Kernel memory block became invalid, needs to be reloaded
 
+//!
+//! \brief  Kernel allocation index (hash by KUID/KCID, free and LRU lists)
+//!
+#define RENDERHAL_KERNEL_HASH_BITS          8
+#define RENDERHAL_KERNEL_HASH_SIZE          (1 << RENDERHAL_KERNEL_HASH_BITS)
+#define RENDERHAL_KERNEL_INDEX_NONE         -1
+#define RENDERHAL_KERNEL_LIST_EMPTY         0   // Free entries not owning a kernel heap block
+#define RENDERHAL_KERNEL_LIST_FREE          1   // Free entries owning a kernel heap block for reuse
+#define RENDERHAL_KERNEL_LIST_LRU           2   // Loaded entries, least recently used first
+#define RENDERHAL_KERNEL_LIST_COUNT         3
+
 //!
 //! \brief  SSH defaults and limits
 //!
@@ -779,6 +790,27 @@ typedef struct _RENDERHAL_KRN_ALLOC_LIST
     int32_t                   iCount;                                           // Number of objects
 } RENDERHAL_KRN_ALLOC_LIST, *PRENDERHAL_KRN_ALLOC_LIST;
 
+//!
+//! \brief  Index links of a kernel allocation entry
+//! \details Kept in a table parallel to pKernelAllocation, so that whole
+//!          RENDERHAL_KRN_ALLOCATION copies never carry stale links.
+//!
+typedef struct _RENDERHAL_KRN_ALLOC_NODE
+{
+    int32_t                   iHashNext;                                        // Next entry in the same hash bucket
+    int32_t                   iBucket;                                          // Hash bucket (RENDERHAL_KERNEL_INDEX_NONE if not hashed)
+    int32_t                   iPrev;                                            // Prev entry in list
+    int32_t                   iNext;                                            // Next entry in list
+    int32_t                   iList;                                            // RENDERHAL_KERNEL_LIST_* (RENDERHAL_KERNEL_INDEX_NONE if not linked)
+} RENDERHAL_KRN_ALLOC_NODE, *PRENDERHAL_KRN_ALLOC_NODE;
+
+typedef struct _RENDERHAL_KRN_INDEX_LIST
+{
+    int32_t                   iHead;                                            // Head of the list
+    int32_t                   iTail;                                            // Tail of the list
+    int32_t                   iCount;                                           // Number of entries
+} RENDERHAL_KRN_INDEX_LIST, *PRENDERHAL_KRN_INDEX_LIST;
+
 typedef struct _RENDERHAL_MEDIA_STATE *PRENDERHAL_MEDIA_STATE;
 
 typedef struct _RENDERHAL_MEDIA_STATE
@@ -957,6 +989,11 @@ typedef struct _RENDERHAL_STATE_HEAP
 
     // Arrays created dynamically
     PRENDERHAL_KRN_ALLOCATION   pKernelAllocation;                              // Kernel allocation table (or linked list)
+    PRENDERHAL_KRN_ALLOC_NODE   pKernelAllocNode;                               // Kernel allocation index links (parallel to pKernelAllocation)
+
+    // Kernel allocation index
+    int32_t                     iKernelHash[RENDERHAL_KERNEL_HASH_SIZE];        // Hash bucket heads, by KUID/KCID
+    RENDERHAL_KRN_INDEX_LIST    KernelIndexList[RENDERHAL_KERNEL_LIST_COUNT];   // Empty, free and LRU lists
 
     // Dynamic Kernel States
     PMHW_MEMORY_POOL               pKernelAllocMemPool;                         // Kernel states memory pool (mallocs)
@@ -1891,6 +1928,43 @@ MOS_STATUS RenderHal_SendSurfaces_PatchList(
     PRENDERHAL_INTERFACE    pRenderHal,
     PMOS_COMMAND_BUFFER     pCmdBuffer);
 
+//!
+//! \brief    Load Kernel
+//! \details  Load a kernel into the kernel heap, defined in renderhal_kernel.cpp
+//!           with the other kernel heap functions so they can be tested alone
+//! \return   int32_t
+//!           Kernel allocation index, RENDERHAL_KERNEL_LOAD_FAIL if no space is available
+//!
+int32_t RenderHal_LoadKernel(
+    PRENDERHAL_INTERFACE       pRenderHal,
+    PCRENDERHAL_KERNEL_PARAM   pParameters,
+    PMHW_KERNEL_PARAM          pKernel,
+    Kdll_CacheEntry            *pKernelEntry);
+
+//!
+//! \brief    Unload Kernel
+//! \details  Unload a kernel from the kernel heap, keeping its block for reuse
+//! \return   MOS_STATUS
+//!
+MOS_STATUS RenderHal_UnloadKernel(
+    PRENDERHAL_INTERFACE pRenderHal,
+    int32_t              iKernelAllocationID);
+
+//!
+//! \brief    Touch Kernel
+//! \details  Mark a kernel most recently used and in use by the next submission
+//!
+void RenderHal_TouchKernel(
+    PRENDERHAL_INTERFACE pRenderHal,
+    int32_t              iKernelAllocationID);
+
+//!
+//! \brief    Reset Kernels
+//! \details  Unload all kernels and free the kernel heap
+//!
+void RenderHal_ResetKernels(
+    PRENDERHAL_INTERFACE pRenderHal);
+
 //!
 //! \brief    Init Special Interface
 //! \details  Initializes RenderHal Interface structure, responsible for HW
@@ -0,0 +1,321 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     renderhal_kernel_index.h
+//! \brief    Kernel allocation index of the render state heap
+//! \details  Hash of loaded kernels by unique ID and cache ID, and index lists of
+//!           empty, free and least recently used kernel allocation entries.
+//!           Links are kept in pKernelAllocNode, parallel to pKernelAllocation.
+//!
+#ifndef __RENDERHAL_KERNEL_INDEX_H__
+#define __RENDERHAL_KERNEL_INDEX_H__
+
+#include "renderhal.h"
+
+//!
+//! \brief    Kernel Hash
+//! \details  Hash bucket of a kernel allocation, by kernel unique ID and cache ID
+//! \param    int32_t iKUID
+//!           [in] Kernel unique ID
+//! \param    int32_t iKCID
+//!           [in] Kernel cache ID
+//! \return   int32_t
+//!           Hash bucket index
+//!
+static inline int32_t RenderHal_KernelHash(
+    int32_t iKUID,
+    int32_t iKCID)
+{
+    uint32_t dwHash = ((uint32_t)iKUID * 0x9E3779B1) ^ ((uint32_t)iKCID * 0x85EBCA6B);
+    return (int32_t)(dwHash >> (32 - RENDERHAL_KERNEL_HASH_BITS));
+}
+
+//!
+//! \brief    Link Kernel Allocation
+//! \details  Append a kernel allocation entry to the tail of an index list,
+//!           removing it from its current list first
+//! \param    PRENDERHAL_STATE_HEAP pStateHeap
+//!           [in] Pointer to State Heap
+//! \param    int32_t iKernelAllocationID
+//!           [in] Kernel allocation index
+//! \param    int32_t iList
+//!           [in] RENDERHAL_KERNEL_LIST_* list, RENDERHAL_KERNEL_INDEX_NONE to unlink only
+//! \return   void
+//!
+static inline void RenderHal_LinkKernelAllocation(
+    PRENDERHAL_STATE_HEAP pStateHeap,
+    int32_t               iKernelAllocationID,
+    int32_t               iList)
+{
+    PRENDERHAL_KRN_ALLOC_NODE pNodes = pStateHeap->pKernelAllocNode;
+    PRENDERHAL_KRN_ALLOC_NODE pNode  = &pNodes[iKernelAllocationID];
+    PRENDERHAL_KRN_INDEX_LIST pList;
+
+    // Remove from current list
+    if (pNode->iList != RENDERHAL_KERNEL_INDEX_NONE)
+    {
+        pList = &pStateHeap->KernelIndexList[pNode->iList];
+        if (pNode->iPrev != RENDERHAL_KERNEL_INDEX_NONE)
+        {
+            pNodes[pNode->iPrev].iNext = pNode->iNext;
+        }
+        else
+        {
+            pList->iHead = pNode->iNext;
+        }
+        if (pNode->iNext != RENDERHAL_KERNEL_INDEX_NONE)
+        {
+            pNodes[pNode->iNext].iPrev = pNode->iPrev;
+        }
+        else
+        {
+            pList->iTail = pNode->iPrev;
+        }
+        pList->iCount--;
+    }
+
+    pNode->iPrev = RENDERHAL_KERNEL_INDEX_NONE;
+    pNode->iNext = RENDERHAL_KERNEL_INDEX_NONE;
+    pNode->iList = iList;
+    if (iList == RENDERHAL_KERNEL_INDEX_NONE)
+    {
+        return;
+    }
+
+    // Append to tail
+    pList = &pStateHeap->KernelIndexList[iList];
+    pNode->iPrev = pList->iTail;
+    if (pList->iTail != RENDERHAL_KERNEL_INDEX_NONE)
+    {
+        pNodes[pList->iTail].iNext = iKernelAllocationID;
+    }
+    else
+    {
+        pList->iHead = iKernelAllocationID;
+    }
+    pList->iTail = iKernelAllocationID;
+    pList->iCount++;
+}
+
+//!
+//! \brief    Hash Kernel Allocation
+//! \details  Add a kernel allocation entry to the hash bucket of its KUID/KCID,
+//!           or remove it from its current bucket
+//! \param    PRENDERHAL_STATE_HEAP pStateHeap
+//!           [in] Pointer to State Heap
+//! \param    int32_t iKernelAllocationID
+//!           [in] Kernel allocation index
+//! \param    bool bInsert
+//!           [in] true to insert, false to remove
+//! \return   void
+//!
+static inline void RenderHal_HashKernelAllocation(
+    PRENDERHAL_STATE_HEAP pStateHeap,
+    int32_t               iKernelAllocationID,
+    bool                  bInsert)
+{
+    PRENDERHAL_KRN_ALLOC_NODE pNodes = pStateHeap->pKernelAllocNode;
+    PRENDERHAL_KRN_ALLOC_NODE pNode  = &pNodes[iKernelAllocationID];
+    PRENDERHAL_KRN_ALLOCATION pKernelAllocation;
+    int32_t                   *piLink;
+
+    if (pNode->iBucket != RENDERHAL_KERNEL_INDEX_NONE)
+    {
+        piLink = &pStateHeap->iKernelHash[pNode->iBucket];
+        while (*piLink != RENDERHAL_KERNEL_INDEX_NONE && *piLink != iKernelAllocationID)
+        {
+            piLink = &pNodes[*piLink].iHashNext;
+        }
+        if (*piLink == iKernelAllocationID)
+        {
+            *piLink = pNode->iHashNext;
+        }
+        pNode->iHashNext = RENDERHAL_KERNEL_INDEX_NONE;
+        pNode->iBucket   = RENDERHAL_KERNEL_INDEX_NONE;
+    }
+
+    if (bInsert)
+    {
+        pKernelAllocation = &pStateHeap->pKernelAllocation[iKernelAllocationID];
+        pNode->iBucket    = RenderHal_KernelHash(pKernelAllocation->iKUID, pKernelAllocation->iKCID);
+        pNode->iHashNext  = pStateHeap->iKernelHash[pNode->iBucket];
+        pStateHeap->iKernelHash[pNode->iBucket] = iKernelAllocationID;
+    }
+}
+
+//!
+//! \brief    Find Kernel Allocation
+//! \details  Look up a loaded kernel by unique ID and cache ID
+//! \param    PRENDERHAL_STATE_HEAP pStateHeap
+//!           [in] Pointer to State Heap
+//! \param    int32_t iKUID
+//!           [in] Kernel unique ID
+//! \param    int32_t iKCID
+//!           [in] Kernel cache ID
+//! \return   int32_t
+//!           Kernel allocation index, RENDERHAL_KERNEL_INDEX_NONE if not loaded
+//!
+static inline int32_t RenderHal_FindKernelAllocation(
+    PRENDERHAL_STATE_HEAP pStateHeap,
+    int32_t               iKUID,
+    int32_t               iKCID)
+{
+    PRENDERHAL_KRN_ALLOCATION pKernelAllocation;
+    int32_t                   iKernelAllocationID;
+
+    iKernelAllocationID = pStateHeap->iKernelHash[RenderHal_KernelHash(iKUID, iKCID)];
+    while (iKernelAllocationID != RENDERHAL_KERNEL_INDEX_NONE)
+    {
+        // Validate against the entry, the index only narrows the search
+        pKernelAllocation = &pStateHeap->pKernelAllocation[iKernelAllocationID];
+        if (pKernelAllocation->iKUID   == iKUID &&
+            pKernelAllocation->iKCID   == iKCID &&
+            pKernelAllocation->dwFlags != RENDERHAL_KERNEL_ALLOCATION_FREE)
+        {
+            break;
+        }
+        iKernelAllocationID = pStateHeap->pKernelAllocNode[iKernelAllocationID].iHashNext;
+    }
+
+    return iKernelAllocationID;
+}
+
+//!
+//! \brief    Reset Kernel Index
+//! \details  Clear the hash and link all kernel allocation entries as empty,
+//!           in allocation order
+//! \param    PRENDERHAL_STATE_HEAP pStateHeap
+//!           [in] Pointer to State Heap
+//! \param    int32_t iKernelCount
+//!           [in] Number of kernel allocation entries
+//! \return   void
+//!
+static inline void RenderHal_ResetKernelIndex(
+    PRENDERHAL_STATE_HEAP pStateHeap,
+    int32_t               iKernelCount)
+{
+    int32_t i;
+
+    for (i = 0; i < RENDERHAL_KERNEL_HASH_SIZE; i++)
+    {
+        pStateHeap->iKernelHash[i] = RENDERHAL_KERNEL_INDEX_NONE;
+    }
+
+    for (i = 0; i < RENDERHAL_KERNEL_LIST_COUNT; i++)
+    {
+        pStateHeap->KernelIndexList[i].iHead  = RENDERHAL_KERNEL_INDEX_NONE;
+        pStateHeap->KernelIndexList[i].iTail  = RENDERHAL_KERNEL_INDEX_NONE;
+        pStateHeap->KernelIndexList[i].iCount = 0;
+    }
+
+    for (i = 0; i < iKernelCount; i++)
+    {
+        pStateHeap->pKernelAllocNode[i].iHashNext = RENDERHAL_KERNEL_INDEX_NONE;
+        pStateHeap->pKernelAllocNode[i].iBucket   = RENDERHAL_KERNEL_INDEX_NONE;
+        pStateHeap->pKernelAllocNode[i].iList     = RENDERHAL_KERNEL_INDEX_NONE;
+        RenderHal_LinkKernelAllocation(pStateHeap, i, RENDERHAL_KERNEL_LIST_EMPTY);
+    }
+}
+
+//!
+//! \brief    Find Kernel Block
+//! \details  Find the smallest deallocated kernel heap block fitting a kernel
+//! \param    PRENDERHAL_STATE_HEAP pStateHeap
+//!           [in] Pointer to State Heap
+//! \param    int32_t iKernelSize
+//!           [in] Kernel size
+//! \return   int32_t
+//!           Kernel allocation index, RENDERHAL_KERNEL_INDEX_NONE if no block fits
+//!
+static inline int32_t RenderHal_FindKernelBlock(
+    PRENDERHAL_STATE_HEAP pStateHeap,
+    int32_t               iKernelSize)
+{
+    PRENDERHAL_KRN_ALLOCATION pKernelAllocation;
+    int32_t                   iKernelAllocationID;
+    int32_t                   iSearchIndex = RENDERHAL_KERNEL_INDEX_NONE;
+    int32_t                   iMinSize     = 0;
+
+    for (iKernelAllocationID = pStateHeap->KernelIndexList[RENDERHAL_KERNEL_LIST_FREE].iHead;
+         iKernelAllocationID != RENDERHAL_KERNEL_INDEX_NONE;
+         iKernelAllocationID = pStateHeap->pKernelAllocNode[iKernelAllocationID].iNext)
+    {
+        pKernelAllocation = &pStateHeap->pKernelAllocation[iKernelAllocationID];
+
+        // Allocate minimum available block
+        if (pKernelAllocation->iSize >= iKernelSize &&
+            (iSearchIndex < 0 || pKernelAllocation->iSize < iMinSize))
+        {
+            iSearchIndex = iKernelAllocationID;
+            iMinSize     = pKernelAllocation->iSize;
+        }
+    }
+
+    return iSearchIndex;
+}
+
+//!
+//! \brief    Find Kernel To Unload
+//! \details  Find the least recently used kernel that fits the new kernel and
+//!           is no longer in use by GPU
+//! \param    PRENDERHAL_STATE_HEAP pStateHeap
+//!           [in] Pointer to State Heap
+//! \param    int32_t iKernelSize
+//!           [in] Kernel size
+//! \return   int32_t
+//!           Kernel allocation index, RENDERHAL_KERNEL_INDEX_NONE if no kernel may be unloaded
+//!
+static inline int32_t RenderHal_FindKernelToUnload(
+    PRENDERHAL_STATE_HEAP pStateHeap,
+    int32_t               iKernelSize)
+{
+    PRENDERHAL_KRN_ALLOCATION pKernelAllocation;
+    int32_t                   iKernelAllocationID;
+
+    for (iKernelAllocationID = pStateHeap->KernelIndexList[RENDERHAL_KERNEL_LIST_LRU].iHead;
+         iKernelAllocationID != RENDERHAL_KERNEL_INDEX_NONE;
+         iKernelAllocationID = pStateHeap->pKernelAllocNode[iKernelAllocationID].iNext)
+    {
+        pKernelAllocation = &pStateHeap->pKernelAllocation[iKernelAllocationID];
+
+        // Skip unused entries and entries that would not fit
+        // Skip kernels flagged as locked (cannot be automatically deallocated)
+        if (pKernelAllocation->dwFlags == RENDERHAL_KERNEL_ALLOCATION_FREE ||
+            pKernelAllocation->dwFlags == RENDERHAL_KERNEL_ALLOCATION_LOCKED ||
+            pKernelAllocation->iSize < iKernelSize)
+        {
+            continue;
+        }
+
+        // Check if kernel may be replaced (not in use by GPU)
+        if ((int32_t)(pStateHeap->dwSyncTag - pKernelAllocation->dwSync) < 0)
+        {
+            continue;
+        }
+
+        break;
+    }
+
+    return iKernelAllocationID;
+}
+
+#endif // __RENDERHAL_KERNEL_INDEX_H__
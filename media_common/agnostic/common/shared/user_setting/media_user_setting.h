@@ -35,6 +35,9 @@
 //！             ReadUserSetting(value, "User Setting", MediaUserSetting::Device, m_osInterface->pOsContext, true, true);
 //!           If you don't want to provide the customized default value:
 //!              ReadUserSetting(value, "User Setting", MediaUserSetting::Device, m_osInterface->pOsContext);
+//!           On per frame paths, get the handle of the item once and read by handle, the value is cached:
+//!              m_handle = GetUserSettingHandle(m_userSettingPtr, "User Setting", MediaUserSetting::Device);
+//!              ReadUserSetting(m_userSettingPtr, value, m_handle);
 //!           3) If you want to write specific media user setting to configuration path, call:
 //!              WriteUserSetting("User Setting", MediaUserSetting::Value(false), m_osInterface->pOsContext)
 //!           If you just want to report the value of specific setting item, need to call like:
@@ -129,6 +132,47 @@ public:
         bool useCustomValue = false,
         uint32_t option = MEDIA_USER_SETTING_INTERNAL);
 
+    //!
+    //! \brief    Read value of specific item by handle
+    //! \details  The value is cached after the first read, until Reload() or a write to the item
+    //! \param    [out] value
+    //!           The return value of the item
+    //! \param    [in] handle
+    //!           Handle of the item, from GetHandle()
+    //! \param    [in] customValue
+    //!           The custom value when failed
+    //! \param    [in] useCustomValue
+    //!           Whether use costom value when failed
+    //! \return   MOS_STATUS
+    //!           MOS_STATUS_SUCCESS if no error, otherwise will return failed reason
+    //!
+    MOS_STATUS Read(Value &value,
+        Handle handle,
+        const Value &customValue = Value(),
+        bool useCustomValue = false);
+
+    //!
+    //! \brief    Get handle of specific item
+    //! \details  Resolve the item name once, e.g. at initialization, for the reads on per frame paths.
+    //!           The item does not need to be registered yet.
+    //! \param    [in] valueName
+    //!           Name of the item
+    //! \param    [in] group
+    //!           Group of the item
+    //! \return   Handle
+    //!           Handle of the item
+    //!
+    Handle GetHandle(const std::string &valueName, const Group &group);
+
+    //!
+    //! \brief    Drop the cached values of all items
+    //! \details  Called by MosOsUtilitiesInit on each device initialization. An env variable
+    //!           or reg value changed while a device is open is not seen by cached reads,
+    //!           reads by name included, until the next device initialization or Reload().
+    //! \return   void
+    //!
+    void Reload();
+
     //!
     //! \brief    Write value to specific item
     //! \param    [in] valueName
@@ -232,6 +276,48 @@ inline MOS_STATUS ReadUserSetting(
     return status;
 }
 
+inline MediaUserSetting::Handle GetUserSettingHandle(
+    MediaUserSettingSharedPtr       userSetting,
+    const std::string               &valueName,
+    const MediaUserSetting::Group   &group)
+{
+    MediaUserSettingSharedPtr  instance = userSetting;
+    if (userSetting == nullptr)
+    {
+        instance = MediaUserSetting::MediaUserSetting::Instance();
+    }
+    return instance->GetHandle(valueName, group);
+}
+
+inline MOS_STATUS ReadUserSetting(
+    MediaUserSettingSharedPtr       userSetting,
+    MediaUserSetting::Value         &value,
+    MediaUserSetting::Handle        handle,
+    const MediaUserSetting::Value   &customValue = MediaUserSetting::Value(),
+    bool                            useCustomValue = false)
+{
+    MediaUserSettingSharedPtr  instance = userSetting;
+    if (userSetting == nullptr)
+    {
+        instance = MediaUserSetting::MediaUserSetting::Instance();
+    }
+    return instance->Read(value, handle, customValue, useCustomValue);
+}
+
+template <typename T>
+inline MOS_STATUS ReadUserSetting(
+    MediaUserSettingSharedPtr       userSetting,
+    T                               &value,
+    MediaUserSetting::Handle        handle,
+    const MediaUserSetting::Value   &customValue = MediaUserSetting::Value(),
+    bool                            useCustomValue = false)
+{
+    MediaUserSetting::Value outValue;
+    MOS_STATUS  status = ReadUserSetting(userSetting, outValue, handle, customValue, useCustomValue);
+    value = outValue.Get<T>();
+    return status;
+}
+
 inline MOS_STATUS WriteUserSetting(
     MediaUserSettingSharedPtr userSetting,
     const std::string &valueName,
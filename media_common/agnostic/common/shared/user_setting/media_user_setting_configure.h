@@ -28,6 +28,7 @@
 #define __MEDIA_USER_SETTING_CONFIGURE__H__
 
 #include <string>
+#include <vector>
 #include "media_user_setting_definition.h"
 #include "mos_utilities.h"
 
@@ -90,6 +91,7 @@ public:
 
     //!
     //! \brief    Read value of specific item
+    //! \details  The value is read from the configuration on every call, use a handle on per frame paths
     //! \param    [out] value
     //!           The return value of the item
     //! \param    [in] itemName
@@ -112,6 +114,46 @@ public:
         bool useCustomValue = false,
         uint32_t option = MEDIA_USER_SETTING_INTERNAL);
 
+    //!
+    //! \brief    Read value of specific item by handle
+    //! \details  The value is read from the configuration on first use and cached in the slot
+    //!           until Reload() or a write to the item. The lock is not held while reading
+    //!           the configuration.
+    //! \param    [out] value
+    //!           The return value of the item
+    //! \param    [in] handle
+    //!           Handle of the item
+    //! \param    [in] customValue
+    //!           The custom value when failed
+    //! \param    [in] useCustomValue
+    //!           Whether use costom value when failed
+    //! \return   MOS_STATUS
+    //!           MOS_STATUS_SUCCESS if no error, MOS_STATUS_INVALID_HANDLE if the item is not registered,
+    //!           MOS_STATUS_USER_FEATURE_KEY_OPEN_FAILED if user setting is not set, otherwise will return specific failed reason
+    //!
+    MOS_STATUS Read(Value &value,
+        Handle handle,
+        const Value &customValue,
+        bool useCustomValue = false);
+
+    //!
+    //! \brief    Get handle of specific item
+    //! \details  The item may be registered later, the handle stays valid
+    //! \param    [in] itemName
+    //!           Name of the item
+    //! \param    [in] group
+    //!           Group of the item
+    //! \return   Handle
+    //!           Handle of the item
+    //!
+    Handle GetHandle(const std::string &itemName, const Group &group);
+
+    //!
+    //! \brief    Drop the cached values, the next reads go to the configuration again
+    //! \return   void
+    //!
+    void Reload();
+
     //!
     //! \brief    Write value to specific item
     //! \param    [in] itemName
@@ -212,12 +254,42 @@ protected:
         return HashFunc(str);
     }
 
+    //!
+    //! \brief    Read value of specific item from env variable or reg key
+    //! \return   MOS_STATUS
+    //!           MOS_STATUS_SUCCESS if no error, otherwise will return failed reason
+    //!
+    MOS_STATUS ReadConfig(
+        Value &value,
+        std::shared_ptr<Definition> def,
+        uint32_t option);
+
+    //!
+    //! \brief    Get handle of specific item, mutex must be held
+    //! \return   Handle
+    //!
+    Handle GetHandleLocked(size_t hash, const Group &group);
+
+    //!
+    //! \brief    Value slot of a media user setting item
+    //!
+    struct Slot
+    {
+        std::shared_ptr<Definition> def = nullptr;  //!< nullptr until the item is registered
+        Value value{};                              //!< value read from the configuration
+        MOS_STATUS status = MOS_STATUS_SUCCESS;     //!< status of the read
+        bool cached = false;                        //!< value and status are valid
+        uint32_t generation = 0;                    //!< changed when the cached value is dropped
+    };
+
 protected:
-    MosMutex m_mutexLock; //!< mutex for protecting definitions
+    MosMutex m_mutexLock; //!< mutex for protecting definitions and slots
     Definitions m_definitions[Group::MaxCount]{}; //!< definitions of media user setting
     bool m_isDebugMode = false; //!< whether in debug/release-internal mode
     RegBufferMap m_regBufferMap{};
     MOS_USER_FEATURE_KEY_PATH_INFO *m_keyPathInfo = nullptr;
+    std::vector<Slot> m_slots{};                            //!< value slots indexed by handle
+    std::map<std::size_t, Handle> m_handles[Group::MaxCount]{};  //!< handles of item name hash
 
     static const UFKEY_NEXT m_rootKey;
     static const char *m_configPath;
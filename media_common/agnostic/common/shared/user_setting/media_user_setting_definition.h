@@ -53,6 +53,13 @@ enum Group
     MaxCount
 };
 
+//!
+//! Handle of a media user setting item, the index of its value slot in the configure.
+//! Get it once by item name and group, then read without resolving the name again.
+//!
+using Handle = int32_t;
+const Handle InvalidHandle = -1;
+
 namespace Internal {
 
 class Definition
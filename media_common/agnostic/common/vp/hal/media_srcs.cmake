@@ -22,6 +22,7 @@ set(TMP_HEADERS_
     ${CMAKE_CURRENT_LIST_DIR}/vp_common.h
     ${CMAKE_CURRENT_LIST_DIR}/vp_common_hdr.h
     ${CMAKE_CURRENT_LIST_DIR}/vp_common_tools.h
+    ${CMAKE_CURRENT_LIST_DIR}/vp_status_table.h
 )
 
 set(VP_HEADERS_
@@ -44,16 +44,24 @@ typedef struct _VPHAL_STATUS_ENTRY
     uint32_t        dwStatus;       // 0:OK; 1:Not Ready; 2:Not Available; 3:Error;
     uint16_t        streamIndex;    // stream index corresponding to the gpucontext
     bool            isStreamIndexSet;
+    uint16_t        uiNextInBucket; // entry + 1 of the next frame in the same StatusFeedBackID bucket, 0 if none
  } VPHAL_STATUS_ENTRY, *PVPHAL_STATUS_ENTRY;
 
+// buckets of the StatusFeedBackID index of a status table, power of 2
+#define VPHAL_STATUS_TABLE_ID_BUCKETS  (VPHAL_STATUS_TABLE_MAX_SIZE * 2)
+
 //!
 //! \brief Structure to VPHAL Status table
+//! \details The entries from head to current are chained per StatusFeedBackID bucket in
+//!          submission order, see vp_status_table.h. A zeroed table is empty.
 //!
 typedef struct _VPHAL_STATUS_TABLE
 {
     VPHAL_STATUS_ENTRY  aTableEntries[VPHAL_STATUS_TABLE_MAX_SIZE];
     uint32_t            uiHead;
     uint32_t            uiCurrent;
+    uint16_t            aBucketHeads[VPHAL_STATUS_TABLE_ID_BUCKETS];   // entry + 1 of the oldest frame of each bucket, 0 if none
+    uint16_t            aBucketTails[VPHAL_STATUS_TABLE_ID_BUCKETS];   // entry + 1 of the newest frame of each bucket, 0 if none
 } VPHAL_STATUS_TABLE, *PVPHAL_STATUS_TABLE;
 
 //!
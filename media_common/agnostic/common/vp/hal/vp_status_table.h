@@ -0,0 +1,157 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     vp_status_table.h
+//! \brief    Adding, removing and finding the frames of a VPHAL status table
+//! \details  Shared by VphalState and VpPipelineAdapterBase. A frame is found by its
+//!           StatusFeedBackID through a bucket index kept up to date as frames are
+//!           added and removed, instead of scanning the table on every surface sync.
+//!
+#ifndef __VP_STATUS_TABLE_H__
+#define __VP_STATUS_TABLE_H__
+
+#include "mos_os.h"
+#include "vp_common_tools.h"
+
+#define VPHAL_STATUS_TABLE_MASK(_index)  ((_index) & (VPHAL_STATUS_TABLE_MAX_SIZE - 1))
+#define VPHAL_STATUS_TABLE_BUCKET(_id)   ((_id) & (VPHAL_STATUS_TABLE_ID_BUCKETS - 1))
+
+//!
+//! \brief    Get the number of frames in a status table
+//! \param    [in] pStatusTable
+//!           Status table
+//! \return   uint32_t
+//!           Entry length from head to current
+//!
+static __inline uint32_t VpHal_StatusTableLength(PVPHAL_STATUS_TABLE pStatusTable)
+{
+    return VPHAL_STATUS_TABLE_MASK(pStatusTable->uiCurrent - pStatusTable->uiHead);
+}
+
+//!
+//! \brief    Add the entry of a frame after its submission
+//! \details  A frame with the same StatusFeedBackID as the last one reuses its entry.
+//!           The caller fills in the rest of the entry.
+//! \param    [in] pStatusTable
+//!           Status table
+//! \param    [in] statusFeedBackID
+//!           StatusFeedBackID of the frame
+//! \return   PVPHAL_STATUS_ENTRY
+//!           Entry of the frame
+//!
+static __inline PVPHAL_STATUS_ENTRY VpHal_StatusTableAddEntry(
+    PVPHAL_STATUS_TABLE pStatusTable,
+    uint32_t            statusFeedBackID)
+{
+    uint32_t            uiLast = VPHAL_STATUS_TABLE_MASK(pStatusTable->uiCurrent - 1);
+    uint32_t            uiBucket;
+    PVPHAL_STATUS_ENTRY pStatusEntry;
+
+    if (pStatusTable->uiCurrent != pStatusTable->uiHead &&
+        pStatusTable->aTableEntries[uiLast].StatusFeedBackID == statusFeedBackID)
+    {
+        // same frame id as the last render, its entry is already in the bucket
+        return &pStatusTable->aTableEntries[uiLast];
+    }
+
+    uiBucket                        = VPHAL_STATUS_TABLE_BUCKET(statusFeedBackID);
+    pStatusEntry                    = &pStatusTable->aTableEntries[pStatusTable->uiCurrent];
+    pStatusEntry->StatusFeedBackID  = statusFeedBackID;
+    pStatusEntry->uiNextInBucket    = 0;
+    if (pStatusTable->aBucketTails[uiBucket])
+    {
+        pStatusTable->aTableEntries[pStatusTable->aBucketTails[uiBucket] - 1].uiNextInBucket = (uint16_t)(pStatusTable->uiCurrent + 1);
+    }
+    else
+    {
+        pStatusTable->aBucketHeads[uiBucket] = (uint16_t)(pStatusTable->uiCurrent + 1);
+    }
+    pStatusTable->aBucketTails[uiBucket] = (uint16_t)(pStatusTable->uiCurrent + 1);
+    pStatusTable->uiCurrent              = VPHAL_STATUS_TABLE_MASK(pStatusTable->uiCurrent + 1);
+
+    if (pStatusTable->uiCurrent == pStatusTable->uiHead)
+    {
+        // the table overflowed and reads as empty now, so does the index
+        MOS_ZeroMemory(pStatusTable->aBucketHeads, sizeof(pStatusTable->aBucketHeads));
+        MOS_ZeroMemory(pStatusTable->aBucketTails, sizeof(pStatusTable->aBucketTails));
+    }
+
+    return pStatusEntry;
+}
+
+//!
+//! \brief    Remove the frames from head up to a new head
+//! \details  Frames are removed in submission order, so each one is the oldest of its bucket.
+//! \param    [in] pStatusTable
+//!           Status table
+//! \param    [in] uiNewHead
+//!           Entry of the first frame left in the table
+//!
+static __inline void VpHal_StatusTableSetHead(
+    PVPHAL_STATUS_TABLE pStatusTable,
+    uint32_t            uiNewHead)
+{
+    uint32_t uiIndex;
+    uint32_t uiBucket;
+
+    for (uiIndex = pStatusTable->uiHead; uiIndex != uiNewHead; uiIndex = VPHAL_STATUS_TABLE_MASK(uiIndex + 1))
+    {
+        uiBucket = VPHAL_STATUS_TABLE_BUCKET(pStatusTable->aTableEntries[uiIndex].StatusFeedBackID);
+        pStatusTable->aBucketHeads[uiBucket] = pStatusTable->aTableEntries[uiIndex].uiNextInBucket;
+        if (pStatusTable->aBucketHeads[uiBucket] == 0)
+        {
+            pStatusTable->aBucketTails[uiBucket] = 0;
+        }
+    }
+    pStatusTable->uiHead = uiNewHead;
+}
+
+//!
+//! \brief    Get the index of the first entry of a frame, counted from head
+//! \param    [in] pStatusTable
+//!           Status table
+//! \param    [in] statusFeedBackID
+//!           StatusFeedBackID of the frame
+//! \return   uint32_t
+//!           Index of the entry, the entry length if no entry has the id
+//!
+static __inline uint32_t VpHal_StatusTableFindEntry(
+    PVPHAL_STATUS_TABLE pStatusTable,
+    uint32_t            statusFeedBackID)
+{
+    uint32_t uiTableLen = VpHal_StatusTableLength(pStatusTable);
+    uint32_t uiEntry    = pStatusTable->aBucketHeads[VPHAL_STATUS_TABLE_BUCKET(statusFeedBackID)];
+    uint32_t i;
+
+    for (i = 0; uiEntry != 0 && i < uiTableLen; i++)
+    {
+        if (pStatusTable->aTableEntries[uiEntry - 1].StatusFeedBackID == statusFeedBackID)
+        {
+            return VPHAL_STATUS_TABLE_MASK(uiEntry - 1 - pStatusTable->uiHead);
+        }
+        uiEntry = pStatusTable->aTableEntries[uiEntry - 1].uiNextInBucket;
+    }
+
+    return uiTableLen;
+}
+
+#endif  // __VP_STATUS_TABLE_H__
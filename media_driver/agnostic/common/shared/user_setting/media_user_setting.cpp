@@ -99,6 +99,29 @@ MOS_STATUS MediaUserSetting::Read(Value &value,
     return status;
 }
 
+MOS_STATUS MediaUserSetting::Read(Value &value,
+    Handle handle,
+    const Value &customValue,
+    bool useCustomValue)
+{
+    auto status = m_configure.Read(value, handle, customValue, useCustomValue);
+    if(status != MOS_STATUS_SUCCESS)
+    {
+        MOS_OS_NORMALMESSAGE("User setting handle %d read error", handle);
+    }
+    return status;
+}
+
+Handle MediaUserSetting::GetHandle(const std::string &valueName, const Group &group)
+{
+    return m_configure.GetHandle(valueName, group);
+}
+
+void MediaUserSetting::Reload()
+{
+    m_configure.Reload();
+}
+
 MOS_STATUS MediaUserSetting::Write(
     const std::string &valueName,
     const Value &value,
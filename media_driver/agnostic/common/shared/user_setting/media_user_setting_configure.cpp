@@ -105,18 +105,21 @@ MOS_STATUS Configure::Register(
         }
     }
 
-    defs.insert(
-        std::make_pair(
-            MakeHash(valueName),
-            std::make_shared<Definition>(
-                valueName,
-                defaultValue,
-                isReportKey,
-                debugOnly,
-                useCustomPath,
-                subPath,
-                m_rootKey,
-                statePath)));
+    auto def = std::make_shared<Definition>(
+        valueName,
+        defaultValue,
+        isReportKey,
+        debugOnly,
+        useCustomPath,
+        subPath,
+        m_rootKey,
+        statePath);
+    defs.insert(std::make_pair(MakeHash(valueName), def));
+
+    Slot &slot  = m_slots[GetHandleLocked(MakeHash(valueName), group)];
+    slot.def    = def;
+    slot.cached = false;
+    slot.generation++;
 
     m_mutexLock.Unlock();
 
@@ -130,11 +133,17 @@ MOS_STATUS Configure::Read(Value &value,
     bool useCustomValue,
     uint32_t option)
 {
-    int32_t ret = 0;
-
+    // Reads by name are not cached, only reads by handle are
+    std::shared_ptr<Definition> def = nullptr;
+    m_mutexLock.Lock();
     auto &defs = GetDefinitions(group);
+    auto it = defs.find(MakeHash(valueName));
+    if (it != defs.end())
+    {
+        def = it->second;
+    }
+    m_mutexLock.Unlock();
 
-    auto def = defs[MakeHash(valueName)];
     if (def == nullptr)
     {
         return MOS_STATUS_INVALID_HANDLE;
@@ -146,7 +155,88 @@ MOS_STATUS Configure::Read(Value &value,
         return MOS_STATUS_SUCCESS;
     }
 
-    std::string path = GetReadPath(def, option);
+    MOS_STATUS status = ReadConfig(value, def, option);
+
+    if (status != MOS_STATUS_SUCCESS && option == MEDIA_USER_SETTING_INTERNAL)
+    {
+        value = useCustomValue ? customValue : def->DefaultValue();
+    }
+
+    return status;
+}
+
+MOS_STATUS Configure::Read(Value &value,
+    Handle handle,
+    const Value &customValue,
+    bool useCustomValue)
+{
+    std::shared_ptr<Definition> def = nullptr;
+    Value       slotValue{};
+    MOS_STATUS  status     = MOS_STATUS_SUCCESS;
+    bool        cached     = false;
+    uint32_t    generation = 0;
+
+    m_mutexLock.Lock();
+    if (handle >= 0 && handle < (Handle)m_slots.size())
+    {
+        Slot &slot = m_slots[handle];
+        def        = slot.def;
+        cached     = slot.cached;
+        generation = slot.generation;
+        if (cached)
+        {
+            slotValue = slot.value;
+            status    = slot.status;
+        }
+    }
+    m_mutexLock.Unlock();
+
+    if (def == nullptr)
+    {
+        return MOS_STATUS_INVALID_HANDLE;
+    }
+
+    if (def->IsDebugOnly() && !m_isDebugMode)
+    {
+        value = useCustomValue ? customValue : def->DefaultValue();
+        return MOS_STATUS_SUCCESS;
+    }
+
+    if (!cached)
+    {
+        status = ReadConfig(slotValue, def, MEDIA_USER_SETTING_INTERNAL);
+
+        // Not cached if the slot was reloaded or written meanwhile
+        m_mutexLock.Lock();
+        Slot &slot = m_slots[handle];
+        if (slot.generation == generation)
+        {
+            slot.value  = slotValue;
+            slot.status = status;
+            slot.cached = true;
+        }
+        m_mutexLock.Unlock();
+    }
+
+    if (status == MOS_STATUS_SUCCESS)
+    {
+        value = slotValue;
+    }
+    else
+    {
+        value = useCustomValue ? customValue : def->DefaultValue();
+    }
+
+    return status;
+}
+
+MOS_STATUS Configure::ReadConfig(
+    Value &value,
+    std::shared_ptr<Definition> def,
+    uint32_t option)
+{
+    std::string valueName = def->ItemName();
+    std::string path      = GetReadPath(def, option);
 
     UFKEY_NEXT  key      = {};
     std::string strValue = "";
@@ -156,7 +246,7 @@ MOS_STATUS Configure::Read(Value &value,
     // read env variable first, if env value is set, return
     // else read the reg keys
     MOS_STATUS status = MosUtilities::MosReadEnvVariable(key, valueName, &type, strValue, &size);
- 
+
     if (status == MOS_STATUS_SUCCESS)
     {
         value = strValue;
@@ -164,7 +254,7 @@ MOS_STATUS Configure::Read(Value &value,
     }
 
     status = MosUtilities::MosOpenRegKey(m_rootKey, path, KEY_READ, &key, m_regBufferMap);
-    
+
     if (status == MOS_STATUS_SUCCESS)
     {
         strValue = "";
@@ -173,21 +263,53 @@ MOS_STATUS Configure::Read(Value &value,
 
         m_mutexLock.Lock();
         status = MosUtilities::MosGetRegValue(key, valueName, &type, strValue, &size, m_regBufferMap);
+        m_mutexLock.Unlock();
         if (status == MOS_STATUS_SUCCESS)
         {
             value = strValue;
         }
-        m_mutexLock.Unlock();
 
         MosUtilities::MosCloseRegKey(key);
     }
 
-    if (status != MOS_STATUS_SUCCESS && option == MEDIA_USER_SETTING_INTERNAL)
+    return status;
+}
+
+Handle Configure::GetHandle(const std::string &itemName, const Group &group)
+{
+    m_mutexLock.Lock();
+    Handle handle = GetHandleLocked(MakeHash(itemName), group);
+    m_mutexLock.Unlock();
+
+    return handle;
+}
+
+Handle Configure::GetHandleLocked(size_t hash, const Group &group)
+{
+    auto &handles = m_handles[(group < Group::Device || group >= Group::MaxCount) ? Group::Device : group];
+    auto it = handles.find(hash);
+    if (it != handles.end())
     {
-        value = useCustomValue ? customValue : def->DefaultValue();
+        return it->second;
     }
 
-    return status;
+    // Intern the name, the slot gets its definition on register
+    Handle handle = (Handle)m_slots.size();
+    m_slots.emplace_back();
+    handles.insert(std::make_pair(hash, handle));
+
+    return handle;
+}
+
+void Configure::Reload()
+{
+    m_mutexLock.Lock();
+    for (auto &slot : m_slots)
+    {
+        slot.cached = false;
+        slot.generation++;
+    }
+    m_mutexLock.Unlock();
 }
 
 MOS_STATUS Configure::Write(
@@ -197,9 +319,16 @@ MOS_STATUS Configure::Write(
     bool isForReport,
     uint32_t option)
 {
+    std::shared_ptr<Definition> def = nullptr;
+    m_mutexLock.Lock();
     auto &defs = GetDefinitions(group);
+    auto it = defs.find(MakeHash(valueName));
+    if (it != defs.end())
+    {
+        def = it->second;
+    }
+    m_mutexLock.Unlock();
 
-    auto def = defs[MakeHash(valueName)];
     if (def == nullptr)
     {
         return MOS_STATUS_INVALID_HANDLE;
@@ -231,6 +360,13 @@ MOS_STATUS Configure::Write(
 
         MosUtilities::MosCloseRegKey(key);
     }
+    // A write may change what the item reads back, a report goes to the report path only
+    if (!isForReport)
+    {
+        Slot &slot  = m_slots[GetHandleLocked(MakeHash(valueName), group)];
+        slot.cached = false;
+        slot.generation++;
+    }
     m_mutexLock.Unlock();
 
     if (status != MOS_STATUS_SUCCESS)
@@ -28,6 +28,7 @@
 #include "vphal.h"
 #include "mos_os.h"
 #include "mos_interface.h"
+#include "vp_status_table.h"
 #include "mhw_vebox.h"
 #include "renderhal_legacy.h"
 #include "vphal_renderer.h"
@@ -830,6 +831,11 @@ MOS_STATUS VphalState::GetStatusReport(
     uint32_t                       uiNewHead;
     PVPHAL_STATUS_ENTRY            pStatusEntry;
     bool                           bMarkNotReadyForRemains = false;
+    bool                           bCheckGpuHung           = true;
+    bool                           bNullRender             = false;
+    MOS_GPU_CONTEXT                lastGpuContext          = MOS_GPU_CONTEXT_INVALID_HANDLE;
+    uint16_t                       lastStreamIndex         = 0;
+    uint32_t                       dwLastGpuTag            = 0;
 
     VPHAL_PUBLIC_CHK_NULL(pQueryReport);
     VPHAL_PUBLIC_CHK_NULL(m_osInterface);
@@ -844,6 +850,11 @@ MOS_STATUS VphalState::GetStatusReport(
     // entry length from head to tail
     uiTableLen           = (pStatusTable->uiCurrent - pStatusTable->uiHead) & (VPHAL_STATUS_TABLE_MAX_SIZE - 1);
 
+#if (_DEBUG || _RELEASE_INTERNAL)
+    MOS_NULL_RENDERING_FLAGS NullRender = m_osInterface->pfnGetNullHWRenderFlags(m_osInterface);
+    bNullRender = (NullRender.Value != 0);
+#endif
+
     // step 1 - update pStatusEntry from driver if command associated with the dwTag is done by gpu
     for (i = 0; i < wStatusNum && i < uiTableLen; i++)
     {
@@ -869,17 +880,16 @@ MOS_STATUS VphalState::GetStatusReport(
             continue;
         }
 
-        dwGpuTag           = m_osInterface->pfnGetGpuStatusSyncTag(m_osInterface, pStatusEntry->GpuContextOrdinal);
-        bDoneByGpu         = (dwGpuTag >= pStatusEntry->dwTag);
-        bFailedOnSubmitCmd = (pStatusEntry->dwStatus == VPREP_ERROR);
-
-#if (_DEBUG || _RELEASE_INTERNAL)
-        MOS_NULL_RENDERING_FLAGS NullRender = m_osInterface->pfnGetNullHWRenderFlags(m_osInterface);
-        if (NullRender.Value != 0)
+        // entries in a row are mostly on one GPU context, read its tag once
+        if (pStatusEntry->GpuContextOrdinal != lastGpuContext || m_osInterface->streamIndex != lastStreamIndex)
         {
-            bDoneByGpu = true;
+            lastGpuContext  = pStatusEntry->GpuContextOrdinal;
+            lastStreamIndex = m_osInterface->streamIndex;
+            dwLastGpuTag    = m_osInterface->pfnGetGpuStatusSyncTag(m_osInterface, lastGpuContext);
         }
-#endif
+        dwGpuTag           = dwLastGpuTag;
+        bDoneByGpu         = (dwGpuTag >= pStatusEntry->dwTag) || bNullRender;
+        bFailedOnSubmitCmd = (pStatusEntry->dwStatus == VPREP_ERROR);
 
         if (bFailedOnSubmitCmd)
         {
@@ -901,9 +911,14 @@ MOS_STATUS VphalState::GetStatusReport(
             bMarkNotReadyForRemains = true;
         }
 
-        if (m_osInterface->pfnIsGPUHung(m_osInterface))
+        // reading the reset stats is an ioctl and a hang is reported only once, so check for the first entry only
+        if (bCheckGpuHung)
         {
-            pStatusEntry->dwStatus = VPREP_NOTREADY;
+            bCheckGpuHung = false;
+            if (m_osInterface->pfnIsGPUHung(m_osInterface))
+            {
+                pStatusEntry->dwStatus = VPREP_NOTREADY;
+            }
         }
 
         pQueryReport[i].dwStatus         = pStatusEntry->dwStatus;
@@ -914,7 +929,7 @@ MOS_STATUS VphalState::GetStatusReport(
             m_osInterface->streamIndex = oldStreamIndex;
         }
     }
-    pStatusTable->uiHead = uiNewHead;
+    VpHal_StatusTableSetHead(pStatusTable, uiNewHead);
 
     // step 2 - mark VPREP_NOTAVAILABLE for unused entry
     for (/* continue from previous i */; i < wStatusNum; i++)
@@ -959,6 +974,33 @@ finish:
     return eStatus;
 }
 
+//!
+//! \brief    Get the index of the first Status Report entry of a frame, counted from head
+//! \details  Get the index of the first Status Report entry of a frame, counted from head
+//! \param    [in] statusFeedBackID
+//!           StatusFeedBackID of the frame
+//! \param    [out] puiIndex
+//!           Pointer to the index, the entry length if no entry has the id
+//! \return   MOS_STATUS
+//!           Return MOS_STATUS_SUCCESS if successful, otherwise failed
+//!
+MOS_STATUS VphalState::GetStatusReportEntryIndex(
+    uint32_t                       statusFeedBackID,
+    uint32_t*                      puiIndex)
+{
+    MOS_STATUS                     eStatus = MOS_STATUS_SUCCESS;
+#if(!EMUL)        // this function is dummy for emul
+    VPHAL_PUBLIC_CHK_NULL(puiIndex);
+
+    *puiIndex = VpHal_StatusTableFindEntry(&m_statusTable, statusFeedBackID);
+finish:
+#else
+    MOS_UNUSED(statusFeedBackID);
+    MOS_UNUSED(puiIndex);
+#endif
+    return eStatus;
+}
+
 MOS_STATUS VphalState::GetVpMhwInterface(
     VP_MHWINTERFACE &vpMhwinterface)
 {
@@ -367,6 +367,20 @@ public:
     virtual MOS_STATUS GetStatusReportEntryLength(
         uint32_t                         *puiLength) override;
 
+    //!
+    //! \brief    Get the index of the first Status Report entry of a frame, counted from head
+    //! \details  Get the index of the first Status Report entry of a frame, counted from head
+    //! \param    [in] statusFeedBackID
+    //!           StatusFeedBackID of the frame
+    //! \param    [out] puiIndex
+    //!           Pointer to the index, the entry length if no entry has the id
+    //! \return   MOS_STATUS
+    //!           Return MOS_STATUS_SUCCESS if successful, otherwise failed
+    //!
+    virtual MOS_STATUS GetStatusReportEntryIndex(
+        uint32_t                         statusFeedBackID,
+        uint32_t                         *puiIndex) override;
+
     virtual PLATFORM &GetPlatform() override
     {
         return m_platform;
@@ -28,6 +28,7 @@
 #include "vphal_render_composite.h"
 #include "mos_os.h"
 #include "mos_solo_generic.h"
+#include "vp_status_table.h"
 #include "hal_oca_interface.h"
 
 extern const MEDIA_OBJECT_KA2_INLINE_DATA g_cInit_MEDIA_OBJECT_KA2_INLINE_DATA =
@@ -1675,7 +1676,6 @@ MOS_STATUS VpHal_RndrUpdateStatusTableAfterSubmit(
     MOS_STATUS                      eLastStatus)
 {
     PVPHAL_STATUS_ENTRY             pStatusEntry;
-    bool                            bEmptyTable;
     MOS_STATUS                      eStatus;
     uint32_t                        dwLastTag;
     PVPHAL_STATUS_TABLE             pStatusTable;
@@ -1699,24 +1699,12 @@ MOS_STATUS VpHal_RndrUpdateStatusTableAfterSubmit(
     VPHAL_RENDER_ASSERT(pStatusTable->uiHead < VPHAL_STATUS_TABLE_MAX_SIZE);
     VPHAL_RENDER_ASSERT(pStatusTable->uiCurrent < VPHAL_STATUS_TABLE_MAX_SIZE);
 
-    bEmptyTable = (pStatusTable->uiCurrent == pStatusTable->uiHead);
-    if (!bEmptyTable)
-    {
-        uint32_t uiLast                 = (pStatusTable->uiCurrent - 1) & (VPHAL_STATUS_TABLE_MAX_SIZE - 1);
-        bool bSameFrameIdWithLastRender = (pStatusTable->aTableEntries[uiLast].StatusFeedBackID == dwStatusFeedBackID);
-        if (bSameFrameIdWithLastRender)
-        {
-            pStatusTable->uiCurrent = uiLast;
-        }
-    }
-
-    pStatusEntry                    = &pStatusTable->aTableEntries[pStatusTable->uiCurrent];
-    pStatusEntry->StatusFeedBackID  = dwStatusFeedBackID;
+    // an entry with the same frame id as the last render is reused
+    pStatusEntry                    = VpHal_StatusTableAddEntry(pStatusTable, dwStatusFeedBackID);
     pStatusEntry->GpuContextOrdinal = eMosGpuContext;
     dwLastTag                       = pOsInterface->pfnGetGpuStatusTag(pOsInterface, eMosGpuContext) - 1;
     pStatusEntry->dwTag             = dwLastTag;
     pStatusEntry->dwStatus          = (eLastStatus == MOS_STATUS_SUCCESS)? VPREP_NOTREADY : VPREP_ERROR;
-    pStatusTable->uiCurrent         = (pStatusTable->uiCurrent + 1) & (VPHAL_STATUS_TABLE_MAX_SIZE - 1);
 
     // CM may use a different streamIndex, record it here
     if (pStatusTableUpdateParams->bUpdateStreamIndex)
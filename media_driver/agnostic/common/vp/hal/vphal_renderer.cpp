@@ -1437,6 +1437,17 @@ MOS_STATUS VphalRenderer::Initialize(
         goto finish;
     }
 
+    // Preload combined kernels built by previous processes (optional)
+    {
+        MediaUserSetting::Value outValue;
+        ReadUserSetting(
+            m_userSettingPtr,
+            outValue,
+            __VPHAL_KDLL_CACHE_DIRECTORY,
+            MediaUserSetting::Group::Sequence);
+        KernelDll_LoadDiskCache(pKernelDllState, outValue.ConstString().c_str());
+    }
+
     // Set up SIP debug kernel if enabled
     if (m_pRenderHal->bIsaAsmDebugEnable)
     {
@@ -39,6 +39,7 @@
 
 #endif // EMUL | VPHAL_LIB
 
+#include <stddef.h>  // offsetof
 #include "hal_kerneldll.h"
 #include "vphal.h"
 
@@ -2900,6 +2901,7 @@ void KernelDll_ReleaseStates(Kdll_State *pState)
     VPHAL_RENDER_FUNCTION_ENTER;
 
     if (!pState) return;
+    KernelDll_ReleaseDiskCache(pState);
     KernelDll_ReleaseAdditionalCacheEntries(&pState->KernelCache);
     MOS_FreeMemory(pState->ComponentKernelCache.pCache);
     MOS_FreeMemory(pState->CmFcPatchCache.pCache);
@@ -3292,7 +3294,10 @@ Kdll_CacheEntry *KernelDll_GetCombinedKernel(
 
     // No entries
     entry = pHashTable->wHashTable[folded_hash];
-    if (entry == 0 || entry > DL_MAX_COMBINED_KERNELS ) return nullptr;
+    if (entry == 0 || entry > DL_MAX_COMBINED_KERNELS )
+    {   // Not in memory, try persistent cache
+        return KernelDll_GetDiskCachedKernel(pState, pFilter, iFilterSize, dwHash);
+    }
 
     entries = (&pHashTable->HashEntry[0]) - 1;  // all indices are 1 based (0 means null)
     curr    = &entries[entry];
@@ -3315,11 +3320,15 @@ Kdll_CacheEntry *KernelDll_GetCombinedKernel(
     if (curr)
     {   // Kernel already cached
         curr->pCacheEntry->dwRefresh = pState->dwRefresh++;
+        if (pState->pDiskCache)
+        {
+            KernelDll_TouchDiskCachedKernel(pState, curr->pCacheEntry);
+        }
         return (curr->pCacheEntry);
     }
     else
-    {   // Kernel must be built
-        return nullptr;
+    {   // Kernel must be built, unless found in persistent cache
+        return KernelDll_GetDiskCachedKernel(pState, pFilter, iFilterSize, dwHash);
     }
 }
 
@@ -3648,14 +3657,20 @@ KernelDll_GetComponentKernel(Kdll_State *pState,
 }
 
 //--------------------------------------------------------------
-// KernelDll_AddKernel - Add kernel into hash table and kernel cache
+// KernelDll_InsertKernel - Insert combined kernel and its metadata
+//                          into hash table and kernel cache
 //--------------------------------------------------------------
-Kdll_CacheEntry *
-KernelDll_AddKernel(Kdll_State       *pState,           // Kernel Dll state
-                    Kdll_SearchState *pSearchState,     // Search state
-                    Kdll_FilterEntry *pFilter,          // Original filter
-                    int32_t           iFilterSize,      // Original filter size
-                    uint32_t          dwHash)
+static Kdll_CacheEntry *
+KernelDll_InsertKernel(Kdll_State       *pState,           // Kernel Dll state
+                       Kdll_FilterEntry *pFilter,          // Original filter
+                       int32_t           iFilterSize,      // Original filter size
+                       uint32_t          dwHash,           // Original filter hash
+                       Kdll_FilterEntry *pModFilter,       // Modified filter
+                       int32_t           iModFilterSize,   // Modified filter size
+                       Kdll_CSC_Params  *pCscParams,       // CSC parameters
+                       VPHAL_CSPACE      colorfill_cspace, // Intermediate color space for colorfill
+                       uint8_t          *pKernel,          // Kernel binary
+                       int32_t           iKernelSize)      // Kernel size
 {
     Kdll_CacheEntry      *pCacheEntry;
     Kdll_KernelHashTable *pHashTable;
@@ -3664,21 +3679,13 @@ KernelDll_AddKernel(Kdll_State       *pState,           // Kernel Dll state
     int32_t size;
     uint8_t *ptr;
 
-    VPHAL_RENDER_FUNCTION_ENTER;
-
-    // Check kernel
-    if (pSearchState->KernelSize <= 0)
-    {
-        return nullptr;
-    }
-
     // Get hash table
     pHashTable = &pState->KernelHashTable;
     pHashEntry = &pHashTable->HashEntry[0] - 1;  // all indices are 1 based (0 = null)
 
     // allocate space in kernel cache to store the kernel, filter, CSC parameters
-    size  = pSearchState->KernelSize +                                  // Kernel
-            pSearchState->iFilterSize * sizeof(Kdll_FilterEntry) * 2 +  // Original + Modified Filter
+    size  = iKernelSize +                                               // Kernel
+            (iModFilterSize + iFilterSize) * sizeof(Kdll_FilterEntry) + // Original + Modified Filter
             sizeof(Kdll_CSC_Params) +                                   // CSC parameters
             sizeof(VPHAL_CSPACE);                                       // Intermediate Color Space for colorfill
 
@@ -3709,22 +3716,22 @@ KernelDll_AddKernel(Kdll_State       *pState,           // Kernel Dll state
     pCacheEntry->wHashEntry  = entry;
 
     // Save kernel
-    pCacheEntry->iSize = pSearchState->KernelSize;
-    MOS_SecureMemcpy(pCacheEntry->pBinary, pSearchState->KernelSize, (void *)pSearchState->Kernel, pSearchState->KernelSize);
-    ptr = pCacheEntry->pBinary + pSearchState->KernelSize;
+    pCacheEntry->iSize = iKernelSize;
+    MOS_SecureMemcpy(pCacheEntry->pBinary, iKernelSize, (void *)pKernel, iKernelSize);
+    ptr = pCacheEntry->pBinary + iKernelSize;
 
     // Save modified filter
-    pCacheEntry->iFilterSize = pSearchState->iFilterSize;
+    pCacheEntry->iFilterSize = iModFilterSize;
     pCacheEntry->pFilter     = (Kdll_FilterEntry *) (ptr);
-    MOS_SecureMemcpy(ptr, pSearchState->iFilterSize * sizeof(Kdll_FilterEntry), (void *)pSearchState->Filter, pSearchState->iFilterSize * sizeof(Kdll_FilterEntry));
-    ptr += pSearchState->iFilterSize * sizeof(Kdll_FilterEntry);
+    MOS_SecureMemcpy(ptr, iModFilterSize * sizeof(Kdll_FilterEntry), (void *)pModFilter, iModFilterSize * sizeof(Kdll_FilterEntry));
+    ptr += iModFilterSize * sizeof(Kdll_FilterEntry);
 
     // Save CSC parameters associated with the kernel
     pCacheEntry->pCscParams = (Kdll_CSC_Params *) (ptr);
-    MOS_SecureMemcpy(ptr, sizeof(Kdll_CSC_Params), (void *)&pSearchState->CscParams, sizeof(Kdll_CSC_Params));
+    MOS_SecureMemcpy(ptr, sizeof(Kdll_CSC_Params), (void *)pCscParams, sizeof(Kdll_CSC_Params));
     ptr += sizeof(Kdll_CSC_Params);
     // Save intermediate color space for colorfill
-    pCacheEntry->colorfill_cspace = pState->colorfill_cspace;
+    pCacheEntry->colorfill_cspace = colorfill_cspace;
     ptr += sizeof(VPHAL_CSPACE);
 
     // increment KCID (Range = 0x00010000 - 0x7fffffff)
@@ -3742,6 +3749,646 @@ KernelDll_AddKernel(Kdll_State       *pState,           // Kernel Dll state
     return pCacheEntry;
 }
 
+//--------------------------------------------------------------
+// Persistent combined kernel cache
+//
+// A combined kernel only depends on the search filter, the component
+// kernel binary, the CMFC patch binary and the rule table. Kernels built
+// by a process are written to the cache directory when the Kdll state is
+// released, so the next processes skip search and linking. The file name
+// and header carry the checksums of the binaries and rules, so different
+// platforms and driver builds do not share files.
+//--------------------------------------------------------------
+
+//--------------------------------------------------------------
+// KernelDll_DiskCacheChecksum - FNV-1a over dwords, continues hash
+//--------------------------------------------------------------
+static uint32_t KernelDll_DiskCacheChecksum(uint32_t hash, const void *pData, int32_t iSize)
+{
+    static const uint32_t k = 0x1000193;
+    const uint8_t *p = (const uint8_t *)pData;
+    uint32_t dw;
+
+    for (; iSize >= (int32_t)sizeof(uint32_t); iSize -= sizeof(uint32_t), p += sizeof(uint32_t))
+    {
+        memcpy(&dw, p, sizeof(uint32_t));
+        hash ^= dw;
+        hash *= k;
+    }
+
+    for (; iSize > 0; iSize--)
+    {
+        hash ^= (*p++);
+        hash *= k;
+    }
+
+    return hash;
+}
+
+//--------------------------------------------------------------
+// KernelDll_RuleTableChecksum - Checksum of rule table up to EOF
+//--------------------------------------------------------------
+static uint32_t KernelDll_RuleTableChecksum(const Kdll_RuleEntry *pRuleTable)
+{
+    const Kdll_RuleEntry *pRule = pRuleTable;
+
+    if (!pRule)
+    {
+        return 0;
+    }
+
+    for (; pRule->id != RID_Op_EOF; pRule++)
+    {
+        // Skip extended rules (variable length)
+        if (RID_IS_EXTENDED(pRule->id))
+        {
+            pRule += pRule->value;
+        }
+    }
+
+    return KernelDll_DiskCacheChecksum(DL_DISK_CACHE_HASH_SEED,
+                                       pRuleTable,
+                                       (int32_t)((pRule - pRuleTable + 1) * sizeof(Kdll_RuleEntry)));
+}
+
+//--------------------------------------------------------------
+// KernelDll_DiskCacheDataSize - Size of data following a record
+//--------------------------------------------------------------
+static int32_t KernelDll_DiskCacheDataSize(const Kdll_DiskCacheRecord *pRecord)
+{
+    return (pRecord->iFilterSize + pRecord->iModFilterSize) * sizeof(Kdll_FilterEntry) +
+           sizeof(Kdll_CSC_Params) +
+           pRecord->iKernelSize;
+}
+
+//--------------------------------------------------------------
+// KernelDll_DiskCacheRecordChecksum - Checksum of record and data
+//--------------------------------------------------------------
+static uint32_t KernelDll_DiskCacheRecordChecksum(const Kdll_DiskCacheRecord *pRecord, const uint8_t *pData)
+{
+    uint32_t hash;
+
+    hash = KernelDll_DiskCacheChecksum(DL_DISK_CACHE_HASH_SEED, pRecord, offsetof(Kdll_DiskCacheRecord, dwDataHash));
+    return KernelDll_DiskCacheChecksum(hash, pData, KernelDll_DiskCacheDataSize(pRecord));
+}
+
+//--------------------------------------------------------------
+// KernelDll_IsDiskCachedEntryLoaded - Check if record is still
+//                                     loaded in kernel cache
+//--------------------------------------------------------------
+static bool KernelDll_IsDiskCachedEntryLoaded(Kdll_DiskCacheEntry *pEntry)
+{
+    // Cache entries are reused after garbage collection, KCID is unique
+    return (pEntry->pCacheEntry && pEntry->pCacheEntry->iKCID == pEntry->iKCID);
+}
+
+//--------------------------------------------------------------
+// KernelDll_MarkDiskCachedEntryUsed - Mark record as used in this
+//                                     session (LRU)
+//--------------------------------------------------------------
+static void KernelDll_MarkDiskCachedEntryUsed(Kdll_DiskCache *pCache, Kdll_DiskCacheEntry *pEntry)
+{
+    if (pEntry->Record.dwLastUse != pCache->Header.dwUseCounter)
+    {
+        // Only preloaded records are loaded before their first use
+        if (pEntry->pCacheEntry)
+        {
+            pCache->iUntouched--;
+        }
+        pEntry->Record.dwLastUse = pCache->Header.dwUseCounter;
+    }
+}
+
+//--------------------------------------------------------------
+// KernelDll_LoadDiskCachedEntry - Insert record into hash table
+//                                 and kernel cache
+//--------------------------------------------------------------
+static Kdll_CacheEntry *KernelDll_LoadDiskCachedEntry(Kdll_State *pState, Kdll_DiskCacheEntry *pEntry)
+{
+    Kdll_DiskCacheRecord *pRecord    = &pEntry->Record;
+    Kdll_FilterEntry     *pFilter    = (Kdll_FilterEntry *)pEntry->pData;
+    Kdll_FilterEntry     *pModFilter = pFilter + pRecord->iFilterSize;
+    Kdll_CSC_Params      *pCscParams = (Kdll_CSC_Params *)(pModFilter + pRecord->iModFilterSize);
+    uint8_t              *pKernel    = (uint8_t *)(pCscParams + 1);
+
+    pEntry->pCacheEntry = KernelDll_InsertKernel(pState,
+                                                 pFilter,
+                                                 pRecord->iFilterSize,
+                                                 pRecord->dwHash,
+                                                 pModFilter,
+                                                 pRecord->iModFilterSize,
+                                                 pCscParams,
+                                                 (VPHAL_CSPACE)pRecord->colorfill_cspace,
+                                                 pKernel,
+                                                 pRecord->iKernelSize);
+    pEntry->iKCID = (pEntry->pCacheEntry) ? pEntry->pCacheEntry->iKCID : -1;
+
+    return pEntry->pCacheEntry;
+}
+
+//--------------------------------------------------------------
+// KernelDll_RemoveDiskCachedEntry - Remove record from cache
+//--------------------------------------------------------------
+static void KernelDll_RemoveDiskCachedEntry(Kdll_DiskCache *pCache, int32_t iEntry)
+{
+    Kdll_DiskCacheEntry *pEntry = &pCache->Entries[iEntry];
+
+    // Keep count of preloaded records not used yet
+    KernelDll_MarkDiskCachedEntryUsed(pCache, pEntry);
+
+    pCache->iTotalSize -= KernelDll_DiskCacheDataSize(&pEntry->Record);
+    MOS_FreeMemory(pEntry->pData);
+
+    // Move last record into the free slot
+    pCache->iEntries--;
+    *pEntry = pCache->Entries[pCache->iEntries];
+    MOS_ZeroMemory(&pCache->Entries[pCache->iEntries], sizeof(Kdll_DiskCacheEntry));
+    pCache->bDirty = true;
+}
+
+//--------------------------------------------------------------
+// KernelDll_FindDiskCachedEntry - Search record of a filter
+//--------------------------------------------------------------
+static int32_t KernelDll_FindDiskCachedEntry(Kdll_DiskCache   *pCache,
+                                             Kdll_FilterEntry *pFilter,
+                                             int32_t           iFilterSize,
+                                             uint32_t          dwHash)
+{
+    Kdll_DiskCacheEntry *pEntry = pCache->Entries;
+    int32_t i;
+
+    for (i = 0; i < pCache->iEntries; i++, pEntry++)
+    {
+        if (pEntry->Record.dwHash      == dwHash &&
+            pEntry->Record.iFilterSize == iFilterSize &&
+            memcmp(pEntry->pData, pFilter, iFilterSize * sizeof(Kdll_FilterEntry)) == 0)
+        {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+//--------------------------------------------------------------
+// KernelDll_AddDiskCachedKernel - Record new combined kernel,
+//                                 evict least recently used
+//--------------------------------------------------------------
+static void KernelDll_AddDiskCachedKernel(Kdll_State       *pState,
+                                          Kdll_CacheEntry  *pCacheEntry,
+                                          Kdll_FilterEntry *pFilter,
+                                          int32_t           iFilterSize,
+                                          uint32_t          dwHash)
+{
+    Kdll_DiskCache       *pCache = pState->pDiskCache;
+    Kdll_DiskCacheEntry  *pEntry;
+    Kdll_DiskCacheRecord  record;
+    uint8_t              *pData;
+    int32_t               iDataSize;
+    int32_t               i, iOldest;
+
+    // Procamp coefficients are versioned by the process, such kernels are always rebuilt
+    for (i = 0; i < iFilterSize; i++)
+    {
+        if (pFilter[i].procamp != DL_PROCAMP_DISABLED)
+        {
+            return;
+        }
+    }
+
+    record.dwHash           = dwHash;
+    record.dwLastUse        = pCache->Header.dwUseCounter;
+    record.iFilterSize      = iFilterSize;
+    record.iModFilterSize   = pCacheEntry->iFilterSize;
+    record.iKernelSize      = pCacheEntry->iSize;
+    record.colorfill_cspace = pCacheEntry->colorfill_cspace;
+    record.dwDataHash       = 0;
+
+    iDataSize = KernelDll_DiskCacheDataSize(&record);
+    if (iDataSize > DL_DISK_CACHE_MAX_SIZE)
+    {
+        return;
+    }
+
+    // Replace previous record of the same filter
+    i = KernelDll_FindDiskCachedEntry(pCache, pFilter, iFilterSize, dwHash);
+    if (i >= 0)
+    {
+        KernelDll_RemoveDiskCachedEntry(pCache, i);
+    }
+
+    // Evict least recently used records
+    while (pCache->iEntries >= DL_DISK_CACHE_MAX_RECORDS ||
+           pCache->iTotalSize + iDataSize > DL_DISK_CACHE_MAX_SIZE)
+    {
+        iOldest = 0;
+        for (i = 1; i < pCache->iEntries; i++)
+        {
+            if (pCache->Entries[i].Record.dwLastUse < pCache->Entries[iOldest].Record.dwLastUse)
+            {
+                iOldest = i;
+            }
+        }
+        KernelDll_RemoveDiskCachedEntry(pCache, iOldest);
+    }
+
+    pData = (uint8_t *)MOS_AllocMemory(iDataSize);
+    if (!pData)
+    {
+        return;
+    }
+
+    // Original filter, modified filter, CSC parameters, kernel
+    MOS_SecureMemcpy(pData,
+                     iFilterSize * sizeof(Kdll_FilterEntry),
+                     pFilter,
+                     iFilterSize * sizeof(Kdll_FilterEntry));
+    MOS_SecureMemcpy(pData + iFilterSize * sizeof(Kdll_FilterEntry),
+                     record.iModFilterSize * sizeof(Kdll_FilterEntry),
+                     pCacheEntry->pFilter,
+                     record.iModFilterSize * sizeof(Kdll_FilterEntry));
+    MOS_SecureMemcpy(pData + (iFilterSize + record.iModFilterSize) * sizeof(Kdll_FilterEntry),
+                     sizeof(Kdll_CSC_Params),
+                     pCacheEntry->pCscParams,
+                     sizeof(Kdll_CSC_Params));
+    MOS_SecureMemcpy(pData + iDataSize - record.iKernelSize,
+                     record.iKernelSize,
+                     pCacheEntry->pBinary,
+                     record.iKernelSize);
+
+    pEntry              = &pCache->Entries[pCache->iEntries++];
+    pEntry->Record      = record;
+    pEntry->pData       = pData;
+    pEntry->pCacheEntry = pCacheEntry;
+    pEntry->iKCID       = pCacheEntry->iKCID;
+
+    pCache->iTotalSize += iDataSize;
+    pCache->bDirty      = true;
+}
+
+//--------------------------------------------------------------
+// KernelDll_SaveDiskCache - Write cache file
+//--------------------------------------------------------------
+static bool KernelDll_SaveDiskCache(Kdll_DiskCache *pCache)
+{
+    Kdll_DiskCacheHeader *pHeader;
+    Kdll_DiskCacheRecord *pRecord;
+    Kdll_DiskCacheEntry  *pEntry;
+    uint8_t              *pFile;
+    uint8_t              *ptr;
+    uint32_t              uFileSize;
+    int32_t               iDataSize;
+    int32_t               i;
+    MOS_STATUS            eStatus;
+
+    uFileSize = sizeof(Kdll_DiskCacheHeader) + pCache->iTotalSize +
+                pCache->iEntries * sizeof(Kdll_DiskCacheRecord);
+
+    pFile = (uint8_t *)MOS_AllocMemory(uFileSize);
+    if (!pFile)
+    {
+        return false;
+    }
+
+    pHeader               = (Kdll_DiskCacheHeader *)pFile;
+    *pHeader              = pCache->Header;
+    pHeader->dwRecords    = pCache->iEntries;
+    pHeader->dwHeaderHash = KernelDll_DiskCacheChecksum(DL_DISK_CACHE_HASH_SEED, pHeader, offsetof(Kdll_DiskCacheHeader, dwHeaderHash));
+    ptr                   = (uint8_t *)(pHeader + 1);
+
+    for (i = 0, pEntry = pCache->Entries; i < pCache->iEntries; i++, pEntry++)
+    {
+        // Last use may have changed since the record was loaded
+        pRecord             = (Kdll_DiskCacheRecord *)ptr;
+        *pRecord            = pEntry->Record;
+        pRecord->dwDataHash = KernelDll_DiskCacheRecordChecksum(pRecord, pEntry->pData);
+        ptr                += sizeof(Kdll_DiskCacheRecord);
+
+        iDataSize = KernelDll_DiskCacheDataSize(pRecord);
+        MOS_SecureMemcpy(ptr, iDataSize, pEntry->pData, iDataSize);
+        ptr += iDataSize;
+    }
+
+    // Concurrent processes never read a partial file (last writer wins)
+    eStatus = KernelDll_WriteDiskCacheFile(pCache->szFileName, pFile, uFileSize);
+    if (eStatus != MOS_STATUS_SUCCESS)
+    {
+        VPHAL_RENDER_NORMALMESSAGE("Failed to write kernel cache file %s.", pCache->szFileName);
+    }
+
+    MOS_FreeMemory(pFile);
+
+    return (eStatus == MOS_STATUS_SUCCESS);
+}
+
+//--------------------------------------------------------------
+// KernelDll_LoadDiskCache - Load persistent kernel cache, preload
+//                           most recently used kernels
+//--------------------------------------------------------------
+bool KernelDll_LoadDiskCache(Kdll_State *pState,
+                             const char *pcCacheDir)
+{
+    Kdll_DiskCache             *pCache;
+    Kdll_DiskCacheHeader       *pHeader;
+    const Kdll_DiskCacheHeader *pFileHeader;
+    Kdll_DiskCacheRecord        record;
+    Kdll_DiskCacheEntry        *pEntry;
+    uint8_t                    *pFile;
+    const uint8_t              *ptr;
+    uint32_t                    uFileSize;
+    uint32_t                    uLeft;
+    uint8_t                    *pData;
+    int32_t                     iDataSize;
+    int32_t                     i, iBest, iPreload;
+    uint32_t                    dwRecord, dwRecords;
+    MOS_STATUS                  eStatus;
+
+    VPHAL_RENDER_FUNCTION_ENTER;
+
+    // Disabled unless a cache directory is set
+    if (!pState || pState->pDiskCache || !pcCacheDir || !pcCacheDir[0])
+    {
+        return false;
+    }
+
+    pCache = (Kdll_DiskCache *)MOS_AllocAndZeroMemory(sizeof(Kdll_DiskCache));
+    if (!pCache)
+    {
+        return false;
+    }
+
+    // Cache keys
+    pHeader                    = &pCache->Header;
+    pHeader->dwMagic           = DL_DISK_CACHE_MAGIC;
+    pHeader->dwVersion         = DL_DISK_CACHE_VERSION;
+    pHeader->dwKernelBinHash   = KernelDll_DiskCacheChecksum(DL_DISK_CACHE_HASH_SEED,
+                                                             pState->ComponentKernelCache.pCache,
+                                                             pState->ComponentKernelCache.iCacheSize);
+    pHeader->dwFcPatchBinHash  = (pState->bEnableCMFC && pState->CmFcPatchCache.pCache) ?
+                                 KernelDll_DiskCacheChecksum(DL_DISK_CACHE_HASH_SEED,
+                                                             pState->CmFcPatchCache.pCache,
+                                                             pState->CmFcPatchCache.iCacheSize) : 0;
+    pHeader->dwRuleTableHash   = KernelDll_RuleTableChecksum(pState->pRuleTableDefault);
+    pHeader->dwFilterEntrySize = sizeof(Kdll_FilterEntry);
+    pHeader->dwCscParamsSize   = sizeof(Kdll_CSC_Params);
+
+    MOS_SecureStringPrint(pCache->szFileName, MOS_MAX_PATH_LENGTH, MOS_MAX_PATH_LENGTH,
+                          "%s/kdll_%08x_%08x_%08x.bin", pcCacheDir,
+                          pHeader->dwKernelBinHash, pHeader->dwFcPatchBinHash, pHeader->dwRuleTableHash);
+
+    eStatus = KernelDll_ReadDiskCacheFile(pCache->szFileName, &pFile, &uFileSize);
+
+    // No file yet, kernels built by this process create it
+    if (eStatus == MOS_STATUS_FILE_NOT_FOUND)
+    {
+        pState->pDiskCache = pCache;
+        return true;
+    }
+
+    // The kernels run on the GPU, only take them from a file nobody else
+    // may write. Otherwise the cache stays off, so the file is not replaced either.
+    if (eStatus != MOS_STATUS_SUCCESS)
+    {
+        VPHAL_RENDER_NORMALMESSAGE("Kernel cache file %s can not be used, kernel cache disabled.", pCache->szFileName);
+        MOS_FreeMemory(pCache);
+        return false;
+    }
+
+    pState->pDiskCache = pCache;
+
+    // Keys must match (checksum collision or corrupted file otherwise)
+    pFileHeader = (const Kdll_DiskCacheHeader *)pFile;
+    if (uFileSize < sizeof(Kdll_DiskCacheHeader) ||
+        pFileHeader->dwHeaderHash != KernelDll_DiskCacheChecksum(DL_DISK_CACHE_HASH_SEED, pFileHeader, offsetof(Kdll_DiskCacheHeader, dwHeaderHash)) ||
+        memcmp(pFileHeader, pHeader, offsetof(Kdll_DiskCacheHeader, dwUseCounter)) != 0 ||
+        pFileHeader->dwRecords > DL_DISK_CACHE_MAX_RECORDS)
+    {
+        VPHAL_RENDER_NORMALMESSAGE("Invalid kernel cache file %s, discarded.", pCache->szFileName);
+        pCache->bDirty = true;
+        MOS_FreeMemory(pFile);
+        return true;
+    }
+
+    // New session for LRU
+    pHeader->dwUseCounter = pFileHeader->dwUseCounter + 1;
+    dwRecords             = pFileHeader->dwRecords;
+
+    ptr   = (const uint8_t *)(pFileHeader + 1);
+    uLeft = uFileSize - sizeof(Kdll_DiskCacheHeader);
+    for (dwRecord = 0; dwRecord < dwRecords; dwRecord++)
+    {
+        if (uLeft < sizeof(Kdll_DiskCacheRecord))
+        {
+            break;
+        }
+
+        MOS_SecureMemcpy(&record, sizeof(record), ptr, sizeof(record));
+        ptr   += sizeof(record);
+        uLeft -= sizeof(record);
+
+        if (record.iFilterSize    <= 0 || record.iFilterSize    > DL_MAX_SEARCH_FILTER_SIZE ||
+            record.iModFilterSize <= 0 || record.iModFilterSize > DL_MAX_SEARCH_FILTER_SIZE ||
+            record.iKernelSize    <= 0 || record.iKernelSize    > DL_MAX_KERNEL_SIZE)
+        {
+            break;
+        }
+
+        iDataSize = KernelDll_DiskCacheDataSize(&record);
+        if ((uint32_t)iDataSize > uLeft ||
+            pCache->iTotalSize + iDataSize > DL_DISK_CACHE_MAX_SIZE)
+        {
+            break;
+        }
+
+        // Data must match record checksum, original filter must match search hash
+        if (record.dwDataHash != KernelDll_DiskCacheRecordChecksum(&record, ptr) ||
+            record.dwHash     != KernelDll_SimpleHash((void *)ptr, record.iFilterSize * sizeof(Kdll_FilterEntry)))
+        {
+            break;
+        }
+
+        pData = (uint8_t *)MOS_AllocMemory(iDataSize);
+        if (!pData)
+        {
+            break;
+        }
+        MOS_SecureMemcpy(pData, iDataSize, ptr, iDataSize);
+        ptr   += iDataSize;
+        uLeft -= iDataSize;
+
+        pEntry         = &pCache->Entries[pCache->iEntries++];
+        pEntry->Record = record;
+        pEntry->pData  = pData;
+        pEntry->iKCID  = -1;
+
+        pCache->iTotalSize += iDataSize;
+    }
+    MOS_FreeMemory(pFile);
+
+    // Keep valid records, rewrite file without the corrupted ones
+    if (dwRecord < dwRecords)
+    {
+        VPHAL_RENDER_NORMALMESSAGE("Kernel cache file %s corrupted at record %u.", pCache->szFileName, dwRecord);
+        pCache->bDirty = true;
+    }
+
+    // Preload most recently used kernels, others are loaded on first use
+    for (iPreload = 0; iPreload < DL_DEFAULT_COMBINED_KERNELS; iPreload++)
+    {
+        iBest = -1;
+        for (i = 0; i < pCache->iEntries; i++)
+        {
+            if (!pCache->Entries[i].pCacheEntry &&
+                (iBest < 0 || pCache->Entries[i].Record.dwLastUse > pCache->Entries[iBest].Record.dwLastUse))
+            {
+                iBest = i;
+            }
+        }
+
+        if (iBest < 0 || !KernelDll_LoadDiskCachedEntry(pState, &pCache->Entries[iBest]))
+        {
+            break;
+        }
+        pCache->iUntouched++;
+    }
+
+    return true;
+}
+
+//--------------------------------------------------------------
+// KernelDll_ReleaseDiskCache - Write back persistent kernel cache
+//                              if modified, release it
+//--------------------------------------------------------------
+void KernelDll_ReleaseDiskCache(Kdll_State *pState)
+{
+    Kdll_DiskCache *pCache = pState->pDiskCache;
+    int32_t i;
+
+    if (!pCache)
+    {
+        return;
+    }
+
+    // Last use of kernels is only written along with new kernels
+    if (pCache->bDirty)
+    {
+        KernelDll_SaveDiskCache(pCache);
+    }
+
+    for (i = 0; i < pCache->iEntries; i++)
+    {
+        MOS_FreeMemory(pCache->Entries[i].pData);
+    }
+
+    MOS_FreeMemory(pCache);
+    pState->pDiskCache = nullptr;
+}
+
+//--------------------------------------------------------------
+// KernelDll_GetDiskCachedKernel - Load kernel missing in hash
+//                                 table from persistent cache
+//--------------------------------------------------------------
+Kdll_CacheEntry *
+KernelDll_GetDiskCachedKernel(Kdll_State       *pState,
+                              Kdll_FilterEntry *pFilter,
+                              int32_t           iFilterSize,
+                              uint32_t          dwHash)
+{
+    Kdll_DiskCache      *pCache = pState->pDiskCache;
+    Kdll_DiskCacheEntry *pEntry;
+    int32_t i;
+
+    if (!pCache)
+    {
+        return nullptr;
+    }
+
+    i = KernelDll_FindDiskCachedEntry(pCache, pFilter, iFilterSize, dwHash);
+    if (i < 0)
+    {
+        return nullptr;
+    }
+
+    pEntry = &pCache->Entries[i];
+    KernelDll_MarkDiskCachedEntryUsed(pCache, pEntry);
+
+    if (!KernelDll_IsDiskCachedEntryLoaded(pEntry) &&
+        !KernelDll_LoadDiskCachedEntry(pState, pEntry))
+    {
+        return nullptr;
+    }
+
+    return pEntry->pCacheEntry;
+}
+
+//--------------------------------------------------------------
+// KernelDll_TouchDiskCachedKernel - Mark preloaded kernel as used
+//                                   in this session
+//--------------------------------------------------------------
+void KernelDll_TouchDiskCachedKernel(Kdll_State      *pState,
+                                     Kdll_CacheEntry *pCacheEntry)
+{
+    Kdll_DiskCache      *pCache = pState->pDiskCache;
+    Kdll_DiskCacheEntry *pEntry;
+    int32_t i;
+
+    // Kernels built or loaded on demand are marked already
+    if (!pCache || pCache->iUntouched <= 0)
+    {
+        return;
+    }
+
+    for (i = 0, pEntry = pCache->Entries; i < pCache->iEntries; i++, pEntry++)
+    {
+        if (pEntry->pCacheEntry == pCacheEntry &&
+            pEntry->iKCID == pCacheEntry->iKCID)
+        {
+            KernelDll_MarkDiskCachedEntryUsed(pCache, pEntry);
+            return;
+        }
+    }
+}
+
+//--------------------------------------------------------------
+// KernelDll_AddKernel - Add kernel into hash table and kernel cache
+//--------------------------------------------------------------
+Kdll_CacheEntry *
+KernelDll_AddKernel(Kdll_State       *pState,           // Kernel Dll state
+                    Kdll_SearchState *pSearchState,     // Search state
+                    Kdll_FilterEntry *pFilter,          // Original filter
+                    int32_t           iFilterSize,      // Original filter size
+                    uint32_t          dwHash)
+{
+    Kdll_CacheEntry *pCacheEntry;
+
+    VPHAL_RENDER_FUNCTION_ENTER;
+
+    // Check kernel
+    if (pSearchState->KernelSize <= 0)
+    {
+        return nullptr;
+    }
+
+    pCacheEntry = KernelDll_InsertKernel(pState,
+                                         pFilter,
+                                         iFilterSize,
+                                         dwHash,
+                                         pSearchState->Filter,
+                                         pSearchState->iFilterSize,
+                                         &pSearchState->CscParams,
+                                         pState->colorfill_cspace,
+                                         pSearchState->Kernel,
+                                         pSearchState->KernelSize);
+
+    // Keep new kernel for the next processes
+    if (pCacheEntry && pState->pDiskCache)
+    {
+        KernelDll_AddDiskCachedKernel(pState, pCacheEntry, pFilter, iFilterSize, dwHash);
+    }
+
+    return pCacheEntry;
+}
+
 //--------------------------------------------------------------
 // KernelDll_BuildKernel - build kernel
 //--------------------------------------------------------------
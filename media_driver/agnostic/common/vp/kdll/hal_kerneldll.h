@@ -63,6 +63,12 @@
 #define DL_CACHE_BLOCK_SIZE             (128*1024)   // Kernel allocation block size
 #define DL_COMBINED_KERNEL_CACHE_SIZE   (DL_CACHE_BLOCK_SIZE*DL_NEW_COMBINED_KERNELS) // Combined kernel size
 
+#define DL_DISK_CACHE_MAGIC             0x4843444B   // 'KDCH'
+#define DL_DISK_CACHE_VERSION           1            // Bump on any change of the file layout
+#define DL_DISK_CACHE_MAX_SIZE          (4*1024*1024) // Max size of the kernel records in the file
+#define DL_DISK_CACHE_MAX_RECORDS       256          // Max number of kernel records in the file
+#define DL_DISK_CACHE_HASH_SEED         0x811c9dc5   // FNV-1a offset basis
+
 #define DL_PROCAMP_DISABLED             -1       // procamp is disabled
 #define DL_PROCAMP_MAX                   1       // 1 Procamp entry
 
@@ -158,6 +164,56 @@ typedef struct tagKdll_LinkFileHeader
 } Kdll_LinkFileHeader;
 #pragma pack()
 
+//------------------------------------------------------------
+// PERSISTENT COMBINED KERNEL CACHE
+//------------------------------------------------------------
+// File: header, then dwRecords x (record, original filter, modified filter, CSC params, kernel)
+#pragma pack(4)
+typedef struct tagKdll_DiskCacheHeader
+{
+    uint32_t dwMagic;               // DL_DISK_CACHE_MAGIC
+    uint32_t dwVersion;             // DL_DISK_CACHE_VERSION
+    uint32_t dwKernelBinHash;       // Checksum of the component kernel binary
+    uint32_t dwFcPatchBinHash;      // Checksum of the CMFC patch binary (0 if CMFC is disabled)
+    uint32_t dwRuleTableHash;       // Checksum of the default rule table
+    uint32_t dwFilterEntrySize;     // sizeof(Kdll_FilterEntry)
+    uint32_t dwCscParamsSize;       // sizeof(Kdll_CSC_Params)
+    uint32_t dwUseCounter;          // Counter of the last session that updated the file
+    uint32_t dwRecords;             // Number of kernel records
+    uint32_t dwHeaderHash;          // Checksum of the fields above
+} Kdll_DiskCacheHeader;
+
+typedef struct tagKdll_DiskCacheRecord
+{
+    uint32_t dwHash;                // Search hash (KernelDll_SimpleHash of the original filter)
+    uint32_t dwLastUse;             // Counter of the last session that used the kernel (LRU)
+    int32_t  iFilterSize;           // Original filter size
+    int32_t  iModFilterSize;        // Modified filter size
+    int32_t  iKernelSize;           // Kernel size
+    int32_t  colorfill_cspace;      // Intermediate color space for colorfill
+    uint32_t dwDataHash;            // Checksum of the fields above and of the record data
+} Kdll_DiskCacheRecord;
+#pragma pack()
+
+typedef struct tagKdll_DiskCacheEntry
+{
+    Kdll_DiskCacheRecord Record;
+    uint8_t             *pData;         // Original filter, modified filter, CSC params, kernel
+    Kdll_CacheEntry     *pCacheEntry;   // Combined kernel cache entry holding the kernel (nullptr if not loaded)
+    int                  iKCID;         // Kernel cache id of pCacheEntry when loaded
+} Kdll_DiskCacheEntry;
+
+typedef struct tagKdll_DiskCache
+{
+    char                 szFileName[MOS_MAX_PATH_LENGTH];  // Cache file
+    Kdll_DiskCacheHeader Header;                           // Keys of the current Kdll state
+    int32_t              iEntries;                         // Number of records
+    int32_t              iUntouched;                       // Loaded records not used yet in this session
+    int32_t              iTotalSize;                       // Size of all records
+    bool                 bDirty;                           // File must be rewritten
+    Kdll_DiskCacheEntry  Entries[DL_DISK_CACHE_MAX_RECORDS];
+} Kdll_DiskCache;
+
 //---------------------------------
 // Kernel DLL function prototypes
 //---------------------------------
@@ -257,6 +313,34 @@ KernelDll_AddKernel(Kdll_State       *pState,
                     int               iFilterSize,
                     uint32_t          dwHash);
 
+// Load persistent kernel cache from a directory, preload most recently used kernels
+bool KernelDll_LoadDiskCache(Kdll_State *pState,
+                             const char *pcCacheDir);
+
+// Write back persistent kernel cache if modified, release it
+void KernelDll_ReleaseDiskCache(Kdll_State *pState);
+
+// Load kernel missing in hash table from persistent kernel cache
+Kdll_CacheEntry *
+KernelDll_GetDiskCachedKernel(Kdll_State       *pState,
+                              Kdll_FilterEntry *pFilter,
+                              int32_t           iFilterSize,
+                              uint32_t          dwHash);
+
+// Mark kernel as used in this session for LRU eviction
+void KernelDll_TouchDiskCachedKernel(Kdll_State      *pState,
+                                     Kdll_CacheEntry *pCacheEntry);
+
+// Read persistent kernel cache file (OS specific), only a file nobody else may write
+MOS_STATUS KernelDll_ReadDiskCacheFile(const char *pcFileName,
+                                       uint8_t   **ppData,
+                                       uint32_t   *puSize);
+
+// Replace persistent kernel cache file at once (OS specific)
+MOS_STATUS KernelDll_WriteDiskCacheFile(const char    *pcFileName,
+                                        const uint8_t *pData,
+                                        uint32_t       uSize);
+
 // Search kernel, output is in pSearchState
 bool KernelDll_SearchKernel(
     Kdll_State          *pState,
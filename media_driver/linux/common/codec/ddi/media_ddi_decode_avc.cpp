@@ -862,7 +862,7 @@ void DdiDecodeAVC::FreeResourceBuffer()
 
     bufMgr = &(m_ddiDecodeCtx->BufMgr);
 
-    for (i = 0; i < DDI_CODEC_MAX_BITSTREAM_BUFFER; i++)
+    for (i = 0; i < DDI_CODEC_MAX_BITSTREAM_BUFFER_POOL; i++)
     {
         if (bufMgr->pBitStreamBase[i])
         {
@@ -376,6 +376,12 @@ VAStatus DdiMediaDecode::DecodeCombineBitstream(DDI_MEDIA_CONTEXT *mediaCtx)
     //set new bitstream buffer
     bufMgr->pBitStreamBuffObject[bufMgr->dwBitstreamIndex] = newBitstreamBuffer;
     bufMgr->pBitStreamBase[bufMgr->dwBitstreamIndex]       = newBitStreamBase;
+
+    // let the following frames get buffers large enough to skip the combination,
+    // until no frame needed more than dwMaxBsSize for the idle window
+    bufMgr->dwLargeBsSize    = MOS_MAX(bufMgr->dwLargeBsSize, (uint32_t)newBitstreamBuffer->iSize);
+    bufMgr->ui64LargeBsOrder = bufMgr->ui64BitstreamOrder;
+    bufMgr->BitstreamPoolStats.dwOverSizeCount++;
     DdiMedia_MediaBufferToMosResource(m_ddiDecodeCtx->BufMgr.pBitStreamBuffObject[bufMgr->dwBitstreamIndex], &m_ddiDecodeCtx->BufMgr.resBitstreamBuffer);
 
     return VA_STATUS_SUCCESS;
@@ -461,9 +467,9 @@ void DdiMediaDecode::DestroyContext(VADriverContextP ctx)
 int32_t DdiMediaDecode::GetBitstreamBufIndexFromBuffer(DDI_CODEC_COM_BUFFER_MGR *bufMgr, DDI_MEDIA_BUFFER *buf)
 {
     int32_t i;
-    for(i = 0; i < DDI_CODEC_MAX_BITSTREAM_BUFFER; i++)
+    for(i = 0; i < DDI_CODEC_MAX_BITSTREAM_BUFFER_POOL; i++)
     {
-        if(bufMgr->pBitStreamBuffObject[i]->bo == buf->bo)
+        if(bufMgr->pBitStreamBuffObject[i] != nullptr && bufMgr->pBitStreamBuffObject[i]->bo == buf->bo)
         {
             return i;
         }
@@ -472,16 +478,216 @@ int32_t DdiMediaDecode::GetBitstreamBufIndexFromBuffer(DDI_CODEC_COM_BUFFER_MGR
     return DDI_CODEC_INVALID_BUFFER_INDEX;
 }
 
+VAStatus DdiMediaDecode::AcquireBitstreamBuffer(
+    DDI_CODEC_COM_BUFFER_MGR *bufMgr,
+    uint32_t                  size)
+{
+    DDI_CODEC_BITSTREAM_POOL_STATS *stats     = &bufMgr->BitstreamPoolStats;
+    int32_t                         index     = DDI_CODEC_INVALID_BUFFER_INDEX;
+    int32_t                         freeIndex = DDI_CODEC_INVALID_BUFFER_INDEX;
+    int32_t                         lruIndex  = DDI_CODEC_INVALID_BUFFER_INDEX;
+    // HW finishes the frames of one context in order, so buffers used after a
+    // busy one are busy as well and need no busy query
+    uint64_t                        busyOrder = UINT64_MAX;
+
+    // large frames enlarge the buffers for the idle window only
+    if (size > bufMgr->dwMaxBsSize)
+    {
+        bufMgr->dwLargeBsSize    = MOS_MAX(bufMgr->dwLargeBsSize, size);
+        bufMgr->ui64LargeBsOrder = bufMgr->ui64BitstreamOrder;
+    }
+    else if (bufMgr->ui64BitstreamOrder - bufMgr->ui64LargeBsOrder >= DDI_CODEC_BITSTREAM_POOL_IDLE_FRAMES)
+    {
+        bufMgr->dwLargeBsSize = 0;
+    }
+    uint32_t bsSize = MOS_MAX(bufMgr->dwMaxBsSize, bufMgr->dwLargeBsSize);
+
+    // prefer low indexes, so buffers at the end of the pool go idle and get released
+    for (int32_t i = 0; i < DDI_CODEC_MAX_BITSTREAM_BUFFER_POOL; i++)
+    {
+        DDI_MEDIA_BUFFER *bsBufObj = bufMgr->pBitStreamBuffObject[i];
+        if (bsBufObj == nullptr || bsBufObj->bo == nullptr)
+        {
+            if (freeIndex == DDI_CODEC_INVALID_BUFFER_INDEX)
+            {
+                freeIndex = i;
+            }
+            continue;
+        }
+        if (lruIndex == DDI_CODEC_INVALID_BUFFER_INDEX ||
+            bufMgr->ui64BitstreamUseOrder[i] < bufMgr->ui64BitstreamUseOrder[lruIndex])
+        {
+            lruIndex = i;
+        }
+        if (index == DDI_CODEC_INVALID_BUFFER_INDEX && bufMgr->ui64BitstreamUseOrder[i] < busyOrder)
+        {
+            if (mos_bo_busy(bsBufObj->bo))
+            {
+                busyOrder = bufMgr->ui64BitstreamUseOrder[i];
+            }
+            else
+            {
+                index = i;
+            }
+        }
+    }
+
+    bool orphan = false;
+    if (index != DDI_CODEC_INVALID_BUFFER_INDEX)
+    {
+        // replaced buffers were used before this one, so HW is done with them as well
+        bufMgr->dwBitstreamOrphans = 0;
+    }
+    else if (freeIndex != DDI_CODEC_INVALID_BUFFER_INDEX)
+    {
+        index = freeIndex;
+        if (lruIndex != DDI_CODEC_INVALID_BUFFER_INDEX)
+        {
+            stats->dwGrowCount++;
+        }
+    }
+    else if (bufMgr->dwBitstreamOrphans < DDI_CODEC_BITSTREAM_POOL_MAX_ORPHANS)
+    {
+        // the graphics memory is reference counted, HW keeps the old one until it is done
+        index  = lruIndex;
+        orphan = true;
+        bufMgr->dwBitstreamOrphans++;
+        stats->dwOrphanCount++;
+    }
+    else
+    {
+        // bound the graphics memory held by HW, the replaced buffers are done once this one is
+        index = lruIndex;
+        mos_bo_wait_rendering(bufMgr->pBitStreamBuffObject[index]->bo);
+        bufMgr->dwBitstreamOrphans = 0;
+        stats->dwWaitCount++;
+    }
+
+    DDI_MEDIA_BUFFER *bsBufObj = bufMgr->pBitStreamBuffObject[index];
+    if (bsBufObj == nullptr)
+    {
+        bsBufObj = (DDI_MEDIA_BUFFER *)MOS_AllocAndZeroMemory(sizeof(DDI_MEDIA_BUFFER));
+        if (bsBufObj == nullptr)
+        {
+            return VA_STATUS_ERROR_ALLOCATION_FAILED;
+        }
+        bsBufObj->iSize                      = bsSize;
+        bsBufObj->uiType                     = VASliceDataBufferType;
+        bsBufObj->format                     = Media_Format_Buffer;
+        bsBufObj->uiOffset                   = 0;
+        bsBufObj->bo                         = nullptr;
+        bufMgr->pBitStreamBuffObject[index]  = bsBufObj;
+        bufMgr->pBitStreamBase[index]        = nullptr;
+    }
+    bsBufObj->pMediaCtx = m_ddiDecodeCtx->pMediaCtx;
+
+    // an idle buffer enlarged for a large frame is reallocated once the idle window passed
+    bool resize = (uint32_t)bsBufObj->iSize < bsSize ||
+                  (!orphan && bufMgr->dwLargeBsSize == 0 && (uint32_t)bsBufObj->iSize > bsSize);
+    if (bsBufObj->bo != nullptr && (orphan || resize))
+    {
+        if (!orphan)
+        {
+            stats->dwReallocCount++;
+        }
+        if (bufMgr->pBitStreamBase[index])
+        {
+            DdiMediaUtil_UnlockBuffer(bsBufObj);
+            bufMgr->pBitStreamBase[index] = nullptr;
+        }
+        DdiMediaUtil_FreeBuffer(bsBufObj);
+        stats->dwAllocatedBuffers--;
+    }
+
+    if (bsBufObj->bo == nullptr)
+    {
+        bsBufObj->iSize = bsSize;
+        if (VA_STATUS_SUCCESS != DdiMediaUtil_CreateBuffer(bsBufObj, m_ddiDecodeCtx->pMediaCtx->pDrmBufMgr))
+        {
+            return VA_STATUS_ERROR_ALLOCATION_FAILED;
+        }
+
+        uint8_t *bsBufBaseAddr = (uint8_t *)DdiMediaUtil_LockBuffer(bsBufObj, MOS_LOCKFLAG_WRITEONLY);
+        if (bsBufBaseAddr == nullptr)
+        {
+            DdiMediaUtil_FreeBuffer(bsBufObj);
+            return VA_STATUS_ERROR_ALLOCATION_FAILED;
+        }
+        bufMgr->pBitStreamBase[index] = bsBufBaseAddr;
+
+        stats->dwAllocatedBuffers++;
+        stats->dwPeakAllocatedBuffers = MOS_MAX(stats->dwPeakAllocatedBuffers, stats->dwAllocatedBuffers);
+    }
+
+    bufMgr->dwBitstreamIndex             = index;
+    bufMgr->ui64BitstreamUseOrder[index] = ++bufMgr->ui64BitstreamOrder;
+
+    ShrinkBitstreamPool(bufMgr);
+
+    return VA_STATUS_SUCCESS;
+}
+
+void DdiMediaDecode::ShrinkBitstreamPool(DDI_CODEC_COM_BUFFER_MGR *bufMgr)
+{
+    DDI_CODEC_BITSTREAM_POOL_STATS *stats = &bufMgr->BitstreamPoolStats;
+
+    if (stats->dwAllocatedBuffers <= DDI_CODEC_BITSTREAM_POOL_MIN_BUFFERS ||
+        bufMgr->ui64BitstreamOrder <= DDI_CODEC_BITSTREAM_POOL_IDLE_FRAMES)
+    {
+        return;
+    }
+
+    uint64_t idleOrder = bufMgr->ui64BitstreamOrder - DDI_CODEC_BITSTREAM_POOL_IDLE_FRAMES;
+    // release at most one buffer per frame, from the end of the pool
+    for (int32_t i = DDI_CODEC_MAX_BITSTREAM_BUFFER_POOL - 1; i >= 0; i--)
+    {
+        DDI_MEDIA_BUFFER *bsBufObj = bufMgr->pBitStreamBuffObject[i];
+        if (bsBufObj == nullptr || bsBufObj->bo == nullptr || bufMgr->ui64BitstreamUseOrder[i] > idleOrder)
+        {
+            continue;
+        }
+        if (mos_bo_busy(bsBufObj->bo))
+        {
+            return;
+        }
+        if (bufMgr->pBitStreamBase[i])
+        {
+            DdiMediaUtil_UnlockBuffer(bsBufObj);
+            bufMgr->pBitStreamBase[i] = nullptr;
+        }
+        DdiMediaUtil_FreeBuffer(bsBufObj);
+        stats->dwAllocatedBuffers--;
+        stats->dwShrinkCount++;
+        return;
+    }
+}
+
+VAStatus DdiMediaDecode::GetBitstreamPoolStats(DDI_CODEC_BITSTREAM_POOL_STATS *stats)
+{
+    DDI_CHK_NULL(stats, "nullptr stats", VA_STATUS_ERROR_INVALID_PARAMETER);
+    DDI_CHK_NULL(m_ddiDecodeCtx, "nullptr m_ddiDecodeCtx", VA_STATUS_ERROR_INVALID_CONTEXT);
+
+    DDI_CODEC_COM_BUFFER_MGR *bufMgr = &(m_ddiDecodeCtx->BufMgr);
+    *stats         = bufMgr->BitstreamPoolStats;
+    stats->dwSlots = 0;
+    for (int32_t i = 0; i < DDI_CODEC_MAX_BITSTREAM_BUFFER_POOL; i++)
+    {
+        if (bufMgr->pBitStreamBuffObject[i] != nullptr)
+        {
+            stats->dwSlots++;
+        }
+    }
+
+    return VA_STATUS_SUCCESS;
+}
+
 VAStatus DdiMediaDecode::AllocBsBuffer(
     DDI_CODEC_COM_BUFFER_MGR    *bufMgr,
     DDI_MEDIA_BUFFER            *buf)
 {
-    uint32_t          index, i;
+    uint32_t          index;
     VAStatus          vaStatus;
     uint8_t          *sliceBuf;
-    DDI_MEDIA_BUFFER *bsBufObj = nullptr;
-    uint8_t          *bsBufBaseAddr = nullptr;
-    bool              createBsBuffer = false;
 
     if ( nullptr == bufMgr || nullptr == buf || nullptr == (m_ddiDecodeCtx->pMediaCtx) )
     {
@@ -536,73 +742,10 @@ VAStatus DdiMediaDecode::AllocBsBuffer(
     else
     {
         bufMgr->bIsSliceOverSize = false;
-        for (i = 0; i < DDI_CODEC_MAX_BITSTREAM_BUFFER; i++)
-        {
-            if (bufMgr->pBitStreamBuffObject[i]->bo != nullptr)
-            {
-                if (!mos_bo_busy(bufMgr->pBitStreamBuffObject[i]->bo))
-                {
-                    //find a bitstream buffer whoes graphic memory is allocated but not used by HW now.
-                    break;
-                }
-            }
-            else
-            {
-                //find a new bitstream buffer whoes graphic memory is not allocated yet
-                break;
-            }
-        }
-
-        if (i == DDI_CODEC_MAX_BITSTREAM_BUFFER)
-        {
-            //find the oldest bistream buffer which is the most possible one to become free in the shortest time.
-            bufMgr->dwBitstreamIndex = (bufMgr->ui64BitstreamOrder >> (DDI_CODEC_BITSTREAM_BUFFER_INDEX_BITS * DDI_CODEC_MAX_BITSTREAM_BUFFER_MINUS1)) & DDI_CODEC_MAX_BITSTREAM_BUFFER_INDEX;
-            // wait until decode complete
-            mos_bo_wait_rendering(bufMgr->pBitStreamBuffObject[bufMgr->dwBitstreamIndex]->bo);
-        }
-        else
-        {
-            bufMgr->dwBitstreamIndex = i;
-        }
-        bufMgr->ui64BitstreamOrder = (bufMgr->ui64BitstreamOrder << 4) + bufMgr->dwBitstreamIndex;
-
-        bsBufObj                   = bufMgr->pBitStreamBuffObject[bufMgr->dwBitstreamIndex];
-        bsBufObj ->pMediaCtx       = m_ddiDecodeCtx->pMediaCtx;
-        bsBufBaseAddr              = bufMgr->pBitStreamBase[bufMgr->dwBitstreamIndex];
-
-        if(bsBufBaseAddr == nullptr)
-        {
-            createBsBuffer = true;
-            if (buf->iSize > bsBufObj->iSize)
-            {
-                bsBufObj->iSize = buf->iSize;
-            }
-        }
-        else if(buf->iSize > bsBufObj->iSize)
-        {
-           //free bo
-            DdiMediaUtil_UnlockBuffer(bsBufObj);
-            DdiMediaUtil_FreeBuffer(bsBufObj);
-            bsBufBaseAddr = nullptr;
-
-            createBsBuffer = true;
-            bsBufObj->iSize = buf->iSize;
-        }
-
-        if (createBsBuffer)
+        vaStatus = AcquireBitstreamBuffer(bufMgr, buf->iSize);
+        if (vaStatus != VA_STATUS_SUCCESS)
         {
-            if(VA_STATUS_SUCCESS != DdiMediaUtil_CreateBuffer(bsBufObj, m_ddiDecodeCtx->pMediaCtx->pDrmBufMgr))
-            {
-               return VA_STATUS_ERROR_ALLOCATION_FAILED;
-            }
-
-            bsBufBaseAddr = (uint8_t*)DdiMediaUtil_LockBuffer(bsBufObj, MOS_LOCKFLAG_WRITEONLY);
-            if(bsBufBaseAddr == nullptr)
-            {
-                DdiMediaUtil_FreeBuffer(bsBufObj);
-                return VA_STATUS_ERROR_ALLOCATION_FAILED;
-            }
-            bufMgr->pBitStreamBase[bufMgr->dwBitstreamIndex] = bsBufBaseAddr;
+            return vaStatus;
         }
     }
 
@@ -743,10 +886,11 @@ VAStatus DdiMediaDecode::ExtraDownScaling(
     {
         //check vp context
         VAContextID vpCtxID = VA_INVALID_ID;
-        if (mediaCtx->pVpCtxHeap != nullptr && mediaCtx->pVpCtxHeap->pHeapBase != nullptr)
+        PDDI_MEDIA_VACONTEXT_HEAP_ELEMENT vpCtxHeapElmt = (PDDI_MEDIA_VACONTEXT_HEAP_ELEMENT)DdiMediaUtil_GetHeapElementByIndex(mediaCtx->pVpCtxHeap, 0);
+        if (vpCtxHeapElmt != nullptr)
         {
             //Get VP Context from heap.
-            vpCtxID = (VAContextID)(0 + DDI_MEDIA_VACONTEXTID_OFFSET_VP);
+            vpCtxID = (VAContextID)(vpCtxHeapElmt->uiVaContextID + DDI_MEDIA_VACONTEXTID_OFFSET_VP);
         }
         else
         {
@@ -319,6 +319,16 @@ public:
     //!
     VAStatus DecodeCombineBitstream(DDI_MEDIA_CONTEXT *mediaCtx);
 
+    //! \brief    Get occupancy statistics of the bitstream buffer pool
+    //!
+    //! \param    [out] stats
+    //!           DDI_CODEC_BITSTREAM_POOL_STATS *
+    //!
+    //! \return   VAStatus
+    //!           VA_STATUS_SUCCESS if success, else fail reason
+    //!
+    VAStatus GetBitstreamPoolStats(DDI_CODEC_BITSTREAM_POOL_STATS *stats);
+
 protected:
     //! \brief    the decode_config_attr related with Decode_CONTEXT
     DDI_DECODE_CONFIG_ATTR *m_ddiDecodeAttr = nullptr;
@@ -346,6 +356,37 @@ protected:
     //!
     uint32_t GetBsBufOffset(int32_t sliceGroup);
 
+    //!
+    //! \brief    Pick the bitstream buffer of a new frame
+    //! \details  Reuses the least recently used bitstream buffer if HW is done
+    //!           with it, otherwise grows the pool. When the pool is at
+    //!           DDI_CODEC_MAX_BITSTREAM_BUFFER_POOL the oldest busy buffer gets new
+    //!           graphics memory, up to DDI_CODEC_BITSTREAM_POOL_MAX_ORPHANS times
+    //!           before waiting for HW. Buffers are sized for dwMaxBsSize, or for the
+    //!           largest frame of the last DDI_CODEC_BITSTREAM_POOL_IDLE_FRAMES frames
+    //!           that needed more. Sets bufMgr->dwBitstreamIndex.
+    //!
+    //! \param    [in] bufMgr
+    //!           DDI_CODEC_COM_BUFFER_MGR *
+    //! \param    [in] size
+    //!           minimal size of the bitstream buffer
+    //!
+    //! \return   VAStatus
+    //!           VA_STATUS_SUCCESS if success, else fail reason
+    //!
+    VAStatus AcquireBitstreamBuffer(
+        DDI_CODEC_COM_BUFFER_MGR *bufMgr,
+        uint32_t                  size);
+
+    //!
+    //! \brief    Free graphics memory of one bitstream buffer idle for
+    //!           DDI_CODEC_BITSTREAM_POOL_IDLE_FRAMES frames
+    //!
+    //! \param    [in] bufMgr
+    //!           DDI_CODEC_COM_BUFFER_MGR *
+    //!
+    void ShrinkBitstreamPool(DDI_CODEC_COM_BUFFER_MGR *bufMgr);
+
     //! \brief    Parse the processing buffer if needed.
     //! \details  Helps to parse the Video-post processing buffer for Decoding
     //!
@@ -108,12 +108,51 @@ VAStatus DdiEncodeBase::AddToStatusReportQueue(void *codedBuf)
     {
         return VA_STATUS_ERROR_INVALID_BUFFER;
     }
+    AddStatusReportCompletionBo(idx, codedBuf);
     m_encodeCtx->statusReportBuf.ulHeadPosition = (m_encodeCtx->statusReportBuf.ulHeadPosition + 1) % DDI_ENCODE_MAX_STATUS_REPORT_BUFFER;
+    ResetStatusReportCompletion(m_encodeCtx->statusReportBuf.ulHeadPosition);
 
     return VA_STATUS_SUCCESS;
 
 }
 
+void DdiEncodeBase::AddStatusReportCompletionBo(uint32_t idx, void *bo)
+{
+    DdiEncode_AddCompletionBo(&m_encodeCtx->statusReportBuf.completions[idx], bo, [](void *bo) {
+        mos_bo_reference((MOS_LINUX_BO *)bo);
+    });
+}
+
+void DdiEncodeBase::RemoveStatusReportCompletionBo(uint32_t idx, void *bo)
+{
+    DdiEncode_RemoveCompletionBo(&m_encodeCtx->statusReportBuf.completions[idx], bo, [](void *bo) {
+        mos_bo_unreference((MOS_LINUX_BO *)bo);
+    });
+}
+
+void DdiEncodeBase::ResetStatusReportCompletion(uint32_t idx)
+{
+    DdiEncode_ResetCompletion(&m_encodeCtx->statusReportBuf.completions[idx], [](void *bo) {
+        mos_bo_unreference((MOS_LINUX_BO *)bo);
+    });
+}
+
+bool DdiEncodeBase::WaitStatusReportCompletion(DDI_ENCODE_DEADLINE deadline)
+{
+    // the codechal status is queried in sequence, so the frame waited is the one at the update position
+    DDI_ENCODE_COMPLETION *completion = &m_encodeCtx->statusReportBuf.completions[m_encodeCtx->statusReportBuf.ulUpdatePosition];
+
+    return DdiEncode_WaitCompletion<std::chrono::steady_clock>(
+        completion,
+        deadline,
+        [](void *bo, int64_t timeoutNs) {
+            return mos_gem_bo_wait((MOS_LINUX_BO *)bo, timeoutNs);
+        },
+        [](uint32_t us) {
+            usleep(us);
+        });
+}
+
 VAStatus DdiEncodeBase::InitCompBuffer()
 {
     DDI_CHK_NULL(m_encodeCtx, "Null m_encodeCtx.", VA_STATUS_ERROR_INVALID_CONTEXT);
@@ -154,6 +193,12 @@ void DdiEncodeBase::FreeCompBuffer()
     // free status report struct
     MOS_FreeMemory(bufMgr->pCodedBufferSegment);
     bufMgr->pCodedBufferSegment = nullptr;
+
+    // release the bo referenced by the status report slots
+    for (uint32_t i = 0; i < DDI_ENCODE_MAX_STATUS_REPORT_BUFFER; i++)
+    {
+        ResetStatusReportCompletion(i);
+    }
 }
 
 VAStatus DdiEncodeBase::StatusReport(
@@ -170,8 +215,9 @@ VAStatus DdiEncodeBase::StatusReport(
     uint32_t size         = 0;
     int32_t  index        = 0;
     uint32_t status       = 0;
-    uint32_t timeOutCount = 0;
     VAStatus eStatus      = VA_STATUS_SUCCESS;
+    //set max wait time to 1s, other wise return error.
+    DDI_ENCODE_DEADLINE deadline = DdiEncode_GetDeadline(1000000);
 
     // Get encoded frame information from status buffer queue.
     while (VA_STATUS_SUCCESS == (eStatus = GetSizeFromStatusReportBuffer(mediaBuf, &size, &status, &index)))
@@ -262,13 +308,8 @@ VAStatus DdiEncodeBase::StatusReport(
                 break;
             }
             // Wait until encode PAK complete, sometimes we application detect encoded buffer object is Idle, may Enc done, but Pak not.
-            uint32_t maxTimeOut                               = 100000;  //set max sleep times to 100000 = 1s, other wise return error.
-            if (timeOutCount < maxTimeOut)
+            if (WaitStatusReportCompletion(deadline))
             {
-                //sleep 10 us to wait encode complete, it won't impact the performance.
-                uint32_t sleepTime                            = 10;      //sleep 10 us when encode is not complete.
-                usleep(sleepTime);
-                timeOutCount++;
                 continue;
             }
             else
@@ -315,9 +356,8 @@ VAStatus DdiEncodeBase::EncStatusReport(
 
     EncodeStatusReport* encodeStatusReport = (EncodeStatusReport*)m_encodeCtx->pEncodeStatusReport;
     uint16_t numStatus    = 1;
-    uint32_t maxTimeOut   = 500000;  //set max sleep times to 500000 = 5s, other wise return error.
-    uint32_t sleepTime    = 10;  //sleep 10 us when encode is not complete.
-    uint32_t timeOutCount = 0;
+    //set max wait time to 5s, other wise return error.
+    DDI_ENCODE_DEADLINE deadline = DdiEncode_GetDeadline(5000000);
 
     //when this function is called, there must be a frame is ready, will wait until get the right information.
     while (1)
@@ -339,11 +379,8 @@ VAStatus DdiEncodeBase::EncStatusReport(
         else if (CODECHAL_STATUS_INCOMPLETE == encodeStatusReport[0].CodecStatus)
         {
             // Wait until encode PAK complete, sometimes we application detect encoded buffer object is Idle, may Enc done, but Pak not.
-            if (timeOutCount < maxTimeOut)
+            if (WaitStatusReportCompletion(deadline))
             {
-                //sleep 10 us to wait encode complete, it won't impact the performance.
-                usleep(sleepTime);
-                timeOutCount++;
                 continue;
             }
             else
@@ -375,9 +412,8 @@ VAStatus DdiEncodeBase::PreEncStatusReport(
 
     EncodeStatusReport* encodeStatusReport = (EncodeStatusReport*)m_encodeCtx->pEncodeStatusReport;
     uint16_t numStatus    = 1;
-    uint32_t maxTimeOut   = 500000;  //set max sleep times to 500000 = 5s, other wise return error.
-    uint32_t sleepTime    = 10;  //sleep 10 us when encode is not complete.
-    uint32_t timeOutCount = 0;
+    //set max wait time to 5s, other wise return error.
+    DDI_ENCODE_DEADLINE deadline = DdiEncode_GetDeadline(5000000);
 
     //when this function is called, there must be a frame is ready, will wait until get the right information.
     while (1)
@@ -399,11 +435,8 @@ VAStatus DdiEncodeBase::PreEncStatusReport(
         else if (CODECHAL_STATUS_INCOMPLETE == encodeStatusReport[0].CodecStatus)
         {
             // Wait until encode PAK complete, sometimes we application detect encoded buffer object is Idle, may Enc done, but Pak not.
-            if (timeOutCount < maxTimeOut)
+            if (WaitStatusReportCompletion(deadline))
             {
-                //sleep 10 us to wait encode complete, it won't impact the performance.
-                usleep(sleepTime);
-                timeOutCount++;
                 continue;
             }
             else
@@ -447,6 +480,7 @@ VAStatus DdiEncodeBase::RemoveFromStatusReportQueue(DDI_MEDIA_BUFFER *buf)
     {
         m_encodeCtx->statusReportBuf.infos[index].pCodedBuf = nullptr;
         m_encodeCtx->statusReportBuf.infos[index].uiSize    = 0;
+        RemoveStatusReportCompletionBo(index, buf->bo);
     }
     return eStatus;
 }
@@ -478,6 +512,7 @@ VAStatus DdiEncodeBase::RemoveFromEncStatusReportQueue(
     if (index >= 0)
     {
         m_encodeCtx->statusReportBuf.encInfos[index].pEncBuf[typeIdx] = nullptr;
+        RemoveStatusReportCompletionBo(index, buf->bo);
     }
 
     return eStatus;
@@ -519,6 +554,7 @@ VAStatus DdiEncodeBase::RemoveFromPreEncStatusReportQueue(
     {
         m_encodeCtx->statusReportBuf.preencInfos[index].pPreEncBuf[typeIdx] = nullptr;
         m_encodeCtx->statusReportBuf.preencInfos[index].uiBuffers = 0;
+        RemoveStatusReportCompletionBo(index, buf->bo);
     }
 
     return eStatus;
@@ -359,6 +359,48 @@ protected:
     //!
     VAStatus AddToStatusReportQueue(void *codedBuf);
 
+    //!
+    //! \brief    Register a bo written by the frame of a status report slot
+    //! \details  The bo is referenced until it is removed from the queue or the slot is reset.
+    //!
+    //! \param    [in] idx
+    //!           Status report slot
+    //! \param    [in] bo
+    //!           MOS_LINUX_BO of the coded buffer, or of a FEI output buffer
+    //!
+    void AddStatusReportCompletionBo(uint32_t idx, void *bo);
+
+    //!
+    //! \brief    Release a bo of a status report slot, when its buffer is removed from the queue
+    //!
+    //! \param    [in] idx
+    //!           Status report slot
+    //! \param    [in] bo
+    //!           MOS_LINUX_BO of the buffer
+    //!
+    void RemoveStatusReportCompletionBo(uint32_t idx, void *bo);
+
+    //!
+    //! \brief    Release all bo of a status report slot, before it is reused or on context destroy
+    //!
+    //! \param    [in] idx
+    //!           Status report slot
+    //!
+    void ResetStatusReportCompletion(uint32_t idx);
+
+    //!
+    //! \brief    Wait for the frame at the status report update position
+    //! \details  Called while its codechal status is incomplete. Blocks on the bo
+    //!           registered for the frame, then falls back to polling.
+    //!
+    //! \param    [in] deadline
+    //!           Time the frame is considered hung
+    //!
+    //! \return   bool
+    //!           false if the deadline has passed
+    //!
+    bool WaitStatusReportCompletion(DDI_ENCODE_DEADLINE deadline);
+
     //!
     //! \brief    Convert rate control method in VAAPI to the term in HAL
     //!
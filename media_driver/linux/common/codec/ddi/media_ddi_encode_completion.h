@@ -0,0 +1,171 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     media_ddi_encode_completion.h
+//! \brief    Completion object of an encode submission, waited by the status report
+//! \details  Each status report slot records the bo its frame writes. The status report
+//!           blocks on them in the kernel instead of polling the codechal status, and
+//!           only polls once they are idle, e.g. when the status is stored by a later batch.
+//!
+
+#ifndef __MEDIA_DDI_ENCODE_COMPLETION_H__
+#define __MEDIA_DDI_ENCODE_COMPLETION_H__
+
+#include <stdint.h>
+#include <chrono>
+
+#define DDI_ENCODE_COMPLETION_MAX_BO    3       // coded buffer, or FEI ENC/PreENC output buffers
+#define DDI_ENCODE_COMPLETION_POLL_US   10      // status poll interval once all bo are idle
+
+typedef struct _DDI_ENCODE_COMPLETION
+{
+    void           *bo[DDI_ENCODE_COMPLETION_MAX_BO];   // MOS_LINUX_BO written by the frame, referenced while in the slot
+    uint32_t        boNum;
+    uint32_t        boWaited;                           // bo[0, boWaited) are idle or can not be waited
+} DDI_ENCODE_COMPLETION;
+
+typedef std::chrono::steady_clock::time_point DDI_ENCODE_DEADLINE;
+
+//!
+//! \brief    Release the bo of a completion object and empty it
+//! \param    [in] completion
+//!           Completion object, zero initialized or previously used
+//! \param    [in] unreference
+//!           void(void *bo), mos_bo_unreference in the driver
+//!
+template <typename Unreference>
+static __inline void DdiEncode_ResetCompletion(DDI_ENCODE_COMPLETION *completion, Unreference unreference)
+{
+    for (uint32_t i = 0; i < completion->boNum; i++)
+    {
+        unreference(completion->bo[i]);
+        completion->bo[i] = nullptr;
+    }
+    completion->boNum    = 0;
+    completion->boWaited = 0;
+}
+
+//!
+//! \brief    Register a bo written by the frame
+//! \details  The bo is referenced, so it stays valid if its buffer is destroyed
+//!           before the slot is reused.
+//! \param    [in] reference
+//!           void(void *bo), mos_bo_reference in the driver
+//!
+template <typename Reference>
+static __inline void DdiEncode_AddCompletionBo(DDI_ENCODE_COMPLETION *completion, void *bo, Reference reference)
+{
+    if (bo == nullptr)
+    {
+        return;
+    }
+    for (uint32_t i = 0; i < completion->boNum; i++)
+    {
+        if (completion->bo[i] == bo)
+        {
+            return;
+        }
+    }
+    if (completion->boNum < DDI_ENCODE_COMPLETION_MAX_BO)
+    {
+        reference(bo);
+        completion->bo[completion->boNum++] = bo;
+    }
+}
+
+//!
+//! \brief    Release a bo of the frame, when its buffer is removed from the status report queue
+//! \param    [in] unreference
+//!           void(void *bo), mos_bo_unreference in the driver
+//!
+template <typename Unreference>
+static __inline void DdiEncode_RemoveCompletionBo(DDI_ENCODE_COMPLETION *completion, void *bo, Unreference unreference)
+{
+    for (uint32_t i = 0; i < completion->boNum; i++)
+    {
+        if (completion->bo[i] != bo)
+        {
+            continue;
+        }
+        unreference(bo);
+        for (uint32_t j = i + 1; j < completion->boNum; j++)
+        {
+            completion->bo[j - 1] = completion->bo[j];
+        }
+        completion->boNum--;
+        completion->bo[completion->boNum] = nullptr;
+        if (i < completion->boWaited)
+        {
+            completion->boWaited--;
+        }
+        return;
+    }
+}
+
+static __inline DDI_ENCODE_DEADLINE DdiEncode_GetDeadline(uint32_t timeoutUs)
+{
+    return std::chrono::steady_clock::now() + std::chrono::microseconds(timeoutUs);
+}
+
+//!
+//! \brief    Wait for the frame of a completion object
+//! \details  Block on the next bo of the frame until it is idle or the deadline passes.
+//!           Once all bo are waited, poll one interval. Called each time the frame
+//!           status is still incomplete, the caller queries the status again after it.
+//! \param    [in] completion
+//!           Completion object of the frame, nullptr to only poll
+//! \param    [in] deadline
+//!           Time of Clock the frame is considered hung
+//! \param    [in] waitBo
+//!           int(void *bo, int64_t timeoutNs), 0 if the bo is idle, mos_gem_bo_wait in the driver
+//! \param    [in] poll
+//!           void(uint32_t us), usleep in the driver
+//! \return   bool
+//!           false if the deadline has passed
+//!
+template <typename Clock, typename WaitBo, typename Poll>
+static __inline bool DdiEncode_WaitCompletion(
+    DDI_ENCODE_COMPLETION       *completion,
+    typename Clock::time_point  deadline,
+    WaitBo                      waitBo,
+    Poll                        poll)
+{
+    auto now = Clock::now();
+    if (now >= deadline)
+    {
+        return false;
+    }
+
+    if (completion != nullptr && completion->boWaited < completion->boNum)
+    {
+        // On timeout the next call returns false, other errors fall back to the poll
+        int64_t timeoutNs = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - now).count();
+        waitBo(completion->bo[completion->boWaited], timeoutNs);
+        completion->boWaited++;
+        return true;
+    }
+
+    poll(DDI_ENCODE_COMPLETION_POLL_US);
+    return true;
+}
+
+#endif  // __MEDIA_DDI_ENCODE_COMPLETION_H__
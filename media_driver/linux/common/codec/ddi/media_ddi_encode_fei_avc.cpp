@@ -691,6 +691,7 @@ VAStatus DdiEncodeAvcFei::AddToEncStatusReportQueue(
     m_encodeCtx->statusReportBuf.encInfos[idx].pEncBuf[typeIdx] = encBuf;
     m_encodeCtx->statusReportBuf.encInfos[idx].uiStatus         = 0;
     m_encodeCtx->statusReportBuf.encInfos[idx].uiBuffers++;
+    AddStatusReportCompletionBo(idx, encBuf);
 
     return VA_STATUS_SUCCESS;
 }
@@ -711,6 +712,7 @@ VAStatus DdiEncodeAvcFei::AddToEncStatusReportQueueUpdatePos()
         m_encodeCtx->statusReportBuf.encInfos[i].uiBuffers != 0)
     {
         m_encodeCtx->statusReportBuf.ulHeadPosition = (m_encodeCtx->statusReportBuf.ulHeadPosition + 1) % DDI_ENCODE_MAX_STATUS_REPORT_BUFFER;
+        ResetStatusReportCompletion(m_encodeCtx->statusReportBuf.ulHeadPosition);
     }
 
     return VA_STATUS_SUCCESS;
@@ -737,6 +739,7 @@ VAStatus DdiEncodeAvcFei::AddToPreEncStatusReportQueue(
     m_encodeCtx->statusReportBuf.preencInfos[i].pPreEncBuf[typeIdx] = preEncBuf;
     m_encodeCtx->statusReportBuf.preencInfos[i].uiStatus            = 0;
     m_encodeCtx->statusReportBuf.preencInfos[i].uiBuffers++;
+    AddStatusReportCompletionBo(i, preEncBuf);
 
     return VA_STATUS_SUCCESS;
 }
@@ -759,6 +762,7 @@ VAStatus DdiEncodeAvcFei::AddToPreEncStatusReportQueueUpdatePos()
         m_encodeCtx->statusReportBuf.preencInfos[i].uiBuffers != 0)
     {
         m_encodeCtx->statusReportBuf.ulHeadPosition = (m_encodeCtx->statusReportBuf.ulHeadPosition + 1) % DDI_ENCODE_MAX_STATUS_REPORT_BUFFER;
+        ResetStatusReportCompletion(m_encodeCtx->statusReportBuf.ulHeadPosition);
     }
 
     return VA_STATUS_SUCCESS;
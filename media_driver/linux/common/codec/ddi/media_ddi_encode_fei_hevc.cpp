@@ -527,6 +527,7 @@ VAStatus DdiEncodeHevcFei::AddToEncStatusReportQueue(
     m_encodeCtx->statusReportBuf.encInfos[idx].pEncBuf[typeIdx] = encBuf;
     m_encodeCtx->statusReportBuf.encInfos[idx].uiStatus         = 0;
     m_encodeCtx->statusReportBuf.encInfos[idx].uiBuffers++;
+    AddStatusReportCompletionBo(idx, encBuf);
 
     return VA_STATUS_SUCCESS;
 }
@@ -546,6 +547,7 @@ VAStatus DdiEncodeHevcFei::AddToEncStatusReportQueueUpdatePos()
     if((m_encodeCtx->statusReportBuf.encInfos[i].uiBuffers == (feiPicParams->bCTBCmdCuRecordEnable * 2 + feiPicParams->bDistortionEnable)) &&  m_encodeCtx->statusReportBuf.encInfos[i].uiBuffers != 0)
     {
         m_encodeCtx->statusReportBuf.ulHeadPosition = (m_encodeCtx->statusReportBuf.ulHeadPosition + 1) % DDI_ENCODE_MAX_STATUS_REPORT_BUFFER;
+        ResetStatusReportCompletion(m_encodeCtx->statusReportBuf.ulHeadPosition);
     }
 
 finish:
@@ -211,8 +211,9 @@ VAStatus DdiEncodeVp8::StatusReport(
     uint32_t size         = 0;
     int32_t  index        = 0;
     uint32_t status       = 0;
-    uint32_t timeOutCount = 0;
     VAStatus vaStatus     = VA_STATUS_SUCCESS;
+    //set max wait time to 1s, other wise return error.
+    DDI_ENCODE_DEADLINE deadline = DdiEncode_GetDeadline(1000000);
 
     // Get encoded frame information from status buffer queue.
     while (VA_STATUS_SUCCESS == (vaStatus = GetSizeFromStatusReportBuffer(mediaBuf, &size, &status, &index)))
@@ -284,13 +285,8 @@ VAStatus DdiEncodeVp8::StatusReport(
                 break;
             }
             // Wait until encode PAK complete, sometimes we application detect encoded buffer object is Idle, may Enc done, but Pak not.
-            uint32_t maxTimeOut                               = 100000;  //set max sleep times to 100000 = 1s, other wise return error.
-            if (timeOutCount < maxTimeOut)
+            if (WaitStatusReportCompletion(deadline))
             {
-                //sleep 10 us to wait encode complete, it won't impact the performance.
-                uint32_t sleepTime                            = 10;      //sleep 10 us when encode is not complete.
-                usleep(sleepTime);
-                timeOutCount++;
                 continue;
             }
             else
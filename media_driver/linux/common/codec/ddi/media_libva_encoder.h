@@ -29,6 +29,7 @@
 
 #include "media_libva.h"
 #include "media_libva_cp_interface.h"
+#include "media_ddi_encode_completion.h"
 #include <vector>
 
 // change to 0x1000 for memory optimization, double check when implement slice header packing in app
@@ -81,6 +82,7 @@ typedef struct _DDI_ENCODE_STATUS_REPORT_INFO_BUF
     DDI_ENCODE_STATUS_REPORT_INFO          infos[DDI_ENCODE_MAX_STATUS_REPORT_BUFFER];
     DDI_ENCODE_STATUS_REPORT_ENC_INFO      encInfos[DDI_ENCODE_MAX_STATUS_REPORT_BUFFER];
     DDI_ENCODE_STATUS_REPORT_PREENC_INFO   preencInfos[DDI_ENCODE_MAX_STATUS_REPORT_BUFFER];
+    DDI_ENCODE_COMPLETION                  completions[DDI_ENCODE_MAX_STATUS_REPORT_BUFFER];   // registered when the frame is added to the queue
     uint32_t                               ulHeadPosition;
     uint32_t                               ulUpdatePosition;
 } DDI_ENCODE_STATUS_REPORT_INFO_BUF;
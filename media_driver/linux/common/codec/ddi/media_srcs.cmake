@@ -28,6 +28,7 @@ set(TMP_1_SOURCES_
 set(TMP_1_HEADERS_
     ${CMAKE_CURRENT_LIST_DIR}/media_ddi_decode_base.h
     ${CMAKE_CURRENT_LIST_DIR}/media_ddi_encode_base.h
+    ${CMAKE_CURRENT_LIST_DIR}/media_ddi_encode_completion.h
     ${CMAKE_CURRENT_LIST_DIR}/media_ddi_decode_const.h
     ${CMAKE_CURRENT_LIST_DIR}/media_libva_decoder.h
     ${CMAKE_CURRENT_LIST_DIR}/media_ddi_encode_const.h
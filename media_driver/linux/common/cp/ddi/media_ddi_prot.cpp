@@ -326,40 +326,34 @@ void DdiMedia_FreeProtectedSessionHeap(
     int32_t vaContextOffset,
     int32_t ctxNums)
 {
-    PDDI_MEDIA_VACONTEXT_HEAP_ELEMENT mediaContextHeapBase = (PDDI_MEDIA_VACONTEXT_HEAP_ELEMENT)contextHeap->pHeapBase;
-    if (nullptr == mediaContextHeapBase)
-        return;
-
-    for (int32_t elementId = 0; elementId < ctxNums; ++elementId)
+    for (uint32_t elementId = 0; elementId < contextHeap->uiAllocatedHeapElements && ctxNums > 0; ++elementId)
     {
-        PDDI_MEDIA_VACONTEXT_HEAP_ELEMENT mediaContextHeapElmt = &mediaContextHeapBase[elementId];
+        PDDI_MEDIA_VACONTEXT_HEAP_ELEMENT mediaContextHeapElmt = (PDDI_MEDIA_VACONTEXT_HEAP_ELEMENT)DdiMediaUtil_GetHeapElementByIndex(contextHeap, elementId);
         if (nullptr == mediaContextHeapElmt->pVaContext)
             continue;
         VAContextID vaCtxID = (VAContextID)(mediaContextHeapElmt->uiVaContextID + vaContextOffset);
         DdiMediaProtected::DdiMedia_DestroyProtectedSession(ctx, vaCtxID);
+        --ctxNums;
     }
 }
 
 static void* DdiMedia_GetVaContextFromHeap(
     PDDI_MEDIA_HEAP mediaHeap,
-    uint32_t index,
-    PMEDIA_MUTEX_T mutex)
+    uint32_t index)
 {
     PDDI_MEDIA_VACONTEXT_HEAP_ELEMENT  vaCtxHeapElmt = nullptr;
-    void                              *context = nullptr;
 
-    DdiMediaUtil_LockMutex(mutex);
-    if(nullptr == mediaHeap || index >= mediaHeap->uiAllocatedHeapElements)
+    if(nullptr == mediaHeap)
+    {
+        return nullptr;
+    }
+    vaCtxHeapElmt  = (PDDI_MEDIA_VACONTEXT_HEAP_ELEMENT)DdiMediaUtil_GetHeapElement(mediaHeap, index);
+    if(nullptr == vaCtxHeapElmt)
     {
-        DdiMediaUtil_UnLockMutex(mutex);
         return nullptr;
     }
-    vaCtxHeapElmt  = (PDDI_MEDIA_VACONTEXT_HEAP_ELEMENT)mediaHeap->pHeapBase;
-    vaCtxHeapElmt += index;
-    context        = vaCtxHeapElmt->pVaContext;
-    DdiMediaUtil_UnLockMutex(mutex);
 
-    return context;
+    return __atomic_load_n(&vaCtxHeapElmt->pVaContext, __ATOMIC_ACQUIRE);
 }
 
 void* DdiMedia_GetContextFromProtectedSessionID(
@@ -391,10 +385,10 @@ void* DdiMedia_GetContextFromProtectedSessionID(
     {
         DDI_VERBOSEMESSAGE("LP protected session detected: 0x%x", vaID);
         *ctxType = DDI_MEDIA_CONTEXT_TYPE_PROTECTED_LINK;
-        return DdiMedia_GetVaContextFromHeap(mediaCtx->pProtCtxHeap, heap_index, &mediaCtx->ProtMutex);
+        return DdiMedia_GetVaContextFromHeap(mediaCtx->pProtCtxHeap, heap_index);
     }
 
     DDI_VERBOSEMESSAGE("CP protected session detected: 0x%x", vaID);
     *ctxType = DDI_MEDIA_CONTEXT_TYPE_PROTECTED_CONTENT;
-    return DdiMedia_GetVaContextFromHeap(mediaCtx->pProtCtxHeap, heap_index, &mediaCtx->ProtMutex);
+    return DdiMedia_GetVaContextFromHeap(mediaCtx->pProtCtxHeap, heap_index);
 }
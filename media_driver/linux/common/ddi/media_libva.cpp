@@ -47,6 +47,7 @@
 #include "media_libva_putsurface_linux.h"
 #endif
 #include "media_libva_vp.h"
+#include "media_libva_vp_status.h"
 #include "media_ddi_prot.h"
 #include "mos_os.h"
 
@@ -763,14 +764,9 @@ static void DdiMedia_FreeSurfaceHeapElements(PDDI_MEDIA_CONTEXT mediaCtx)
     if (nullptr == surfaceHeap)
         return;
 
-    PDDI_MEDIA_SURFACE_HEAP_ELEMENT mediaSurfaceHeapBase = (PDDI_MEDIA_SURFACE_HEAP_ELEMENT)surfaceHeap->pHeapBase;
-    if (nullptr == mediaSurfaceHeapBase)
-        return;
-
-    int32_t surfaceNums = mediaCtx->uiNumSurfaces;
-    for (int32_t elementId = 0; elementId < surfaceNums; elementId++)
+    for (uint32_t elementId = 0; elementId < surfaceHeap->uiAllocatedHeapElements && mediaCtx->uiNumSurfaces > 0; elementId++)
     {
-        PDDI_MEDIA_SURFACE_HEAP_ELEMENT mediaSurfaceHeapElmt = &mediaSurfaceHeapBase[elementId];
+        PDDI_MEDIA_SURFACE_HEAP_ELEMENT mediaSurfaceHeapElmt = (PDDI_MEDIA_SURFACE_HEAP_ELEMENT)DdiMediaUtil_GetHeapElementByIndex(surfaceHeap, elementId);
         if (nullptr == mediaSurfaceHeapElmt->pSurface)
             continue;
 
@@ -798,14 +794,10 @@ static void DdiMedia_FreeBufferHeapElements(VADriverContextP    ctx)
     if (nullptr == bufferHeap)
         return;
 
-    PDDI_MEDIA_BUFFER_HEAP_ELEMENT mediaBufferHeapBase = (PDDI_MEDIA_BUFFER_HEAP_ELEMENT)bufferHeap->pHeapBase;
-    if (nullptr == mediaBufferHeapBase)
-        return;
-
     int32_t bufNums = mediaCtx->uiNumBufs;
-    for (int32_t elementId = 0; bufNums > 0; ++elementId)
+    for (uint32_t elementId = 0; elementId < bufferHeap->uiAllocatedHeapElements && bufNums > 0; ++elementId)
     {
-        PDDI_MEDIA_BUFFER_HEAP_ELEMENT mediaBufferHeapElmt = &mediaBufferHeapBase[elementId];
+        PDDI_MEDIA_BUFFER_HEAP_ELEMENT mediaBufferHeapElmt = (PDDI_MEDIA_BUFFER_HEAP_ELEMENT)DdiMediaUtil_GetHeapElementByIndex(bufferHeap, elementId);
         if (nullptr == mediaBufferHeapElmt->pBuffer)
             continue;
         DdiMedia_DestroyBuffer(ctx,mediaBufferHeapElmt->uiVaBufferID);
@@ -831,14 +823,9 @@ static void DdiMedia_FreeImageHeapElements(VADriverContextP    ctx)
     if (nullptr == imageHeap)
         return;
 
-    PDDI_MEDIA_IMAGE_HEAP_ELEMENT mediaImageHeapBase = (PDDI_MEDIA_IMAGE_HEAP_ELEMENT)imageHeap->pHeapBase;
-    if (nullptr == mediaImageHeapBase)
-        return;
-
-    int32_t imageNums = mediaCtx->uiNumImages;
-    for (int32_t elementId = 0; elementId < imageNums; ++elementId)
+    for (uint32_t elementId = 0; elementId < imageHeap->uiAllocatedHeapElements && mediaCtx->uiNumImages > 0; ++elementId)
     {
-        PDDI_MEDIA_IMAGE_HEAP_ELEMENT mediaImageHeapElmt = &mediaImageHeapBase[elementId];
+        PDDI_MEDIA_IMAGE_HEAP_ELEMENT mediaImageHeapElmt = (PDDI_MEDIA_IMAGE_HEAP_ELEMENT)DdiMediaUtil_GetHeapElementByIndex(imageHeap, elementId);
         if (nullptr == mediaImageHeapElmt->pImage)
             continue;
         DdiMedia_DestroyImage(ctx,mediaImageHeapElmt->uiVaImageID);
@@ -855,17 +842,14 @@ static void DdiMedia_FreeImageHeapElements(VADriverContextP    ctx)
 /////////////////////////////////////////////////////////////////////////////
 static void DdiMedia_FreeContextHeap(VADriverContextP ctx, PDDI_MEDIA_HEAP contextHeap,int32_t vaContextOffset, int32_t ctxNums)
 {
-    PDDI_MEDIA_VACONTEXT_HEAP_ELEMENT mediaContextHeapBase = (PDDI_MEDIA_VACONTEXT_HEAP_ELEMENT)contextHeap->pHeapBase;
-    if (nullptr == mediaContextHeapBase)
-        return;
-
-    for (int32_t elementId = 0; elementId < ctxNums; ++elementId)
+    for (uint32_t elementId = 0; elementId < contextHeap->uiAllocatedHeapElements && ctxNums > 0; ++elementId)
     {
-        PDDI_MEDIA_VACONTEXT_HEAP_ELEMENT mediaContextHeapElmt = &mediaContextHeapBase[elementId];
+        PDDI_MEDIA_VACONTEXT_HEAP_ELEMENT mediaContextHeapElmt = (PDDI_MEDIA_VACONTEXT_HEAP_ELEMENT)DdiMediaUtil_GetHeapElementByIndex(contextHeap, elementId);
         if (nullptr == mediaContextHeapElmt->pVaContext)
             continue;
         VAContextID vaCtxID = (VAContextID)(mediaContextHeapElmt->uiVaContextID + vaContextOffset);
         DdiMedia_DestroyContext(ctx,vaCtxID);
+        --ctxNums;
     }
 
 }
@@ -936,11 +920,19 @@ static void DdiMedia_FreeContextCMElements(VADriverContextP ctx)
     if (nullptr == mediaCtx)
         return;
 
+    PDDI_MEDIA_HEAP cmHeap = mediaCtx->pCmCtxHeap;
+    if (nullptr == cmHeap)
+        return;
+
     int32_t cmnums = mediaCtx->uiNumCMs;
-    for (int32_t elementId = 0; elementId < cmnums; elementId++)
+    for (uint32_t elementId = 0; elementId < cmHeap->uiAllocatedHeapElements && cmnums > 0; elementId++)
     {
-        VAContextID vaCtxID = elementId + DDI_MEDIA_VACONTEXTID_OFFSET_CM;
+        PDDI_MEDIA_VACONTEXT_HEAP_ELEMENT cmHeapElmt = (PDDI_MEDIA_VACONTEXT_HEAP_ELEMENT)DdiMediaUtil_GetHeapElementByIndex(cmHeap, elementId);
+        if (nullptr == cmHeapElmt->pVaContext)
+            continue;
+        VAContextID vaCtxID = cmHeapElmt->uiVaContextID + DDI_MEDIA_VACONTEXTID_OFFSET_CM;
         DdiDestroyContextCM(ctx,vaCtxID);
+        --cmnums;
     }
 }
 
@@ -960,12 +952,9 @@ VAImage* DdiMedia_GetVAImageFromVAImageID (PDDI_MEDIA_CONTEXT mediaCtx, VAImageI
     DDI_CHK_NULL(mediaCtx, "nullptr mediaCtx", nullptr);
 
     uint32_t i       = (uint32_t)imageID;
-    DDI_CHK_LESS(i, mediaCtx->pImageHeap->uiAllocatedHeapElements, "invalid image id", nullptr);
-    DdiMediaUtil_LockMutex(&mediaCtx->ImageMutex);
-    PDDI_MEDIA_IMAGE_HEAP_ELEMENT imageElement = (PDDI_MEDIA_IMAGE_HEAP_ELEMENT)mediaCtx->pImageHeap->pHeapBase;
-    imageElement    += i;
-    VAImage *vaImage = imageElement->pImage;
-    DdiMediaUtil_UnLockMutex(&mediaCtx->ImageMutex);
+    PDDI_MEDIA_IMAGE_HEAP_ELEMENT imageElement = (PDDI_MEDIA_IMAGE_HEAP_ELEMENT)DdiMediaUtil_GetHeapElement(mediaCtx->pImageHeap, i);
+    DDI_CHK_NULL(imageElement, "invalid image id", nullptr);
+    VAImage *vaImage = __atomic_load_n(&imageElement->pImage, __ATOMIC_ACQUIRE);
 
     return vaImage;
 }
@@ -986,12 +975,9 @@ void* DdiMedia_GetCtxFromVABufferID (PDDI_MEDIA_CONTEXT mediaCtx, VABufferID buf
     DDI_CHK_NULL(mediaCtx, "nullptr mediaCtx", nullptr);
 
     uint32_t i      = (uint32_t)bufferID;
-    DDI_CHK_LESS(i, mediaCtx->pBufferHeap->uiAllocatedHeapElements, "invalid buffer id", nullptr);
-    DdiMediaUtil_LockMutex(&mediaCtx->BufferMutex);
-    PDDI_MEDIA_BUFFER_HEAP_ELEMENT bufHeapElement  = (PDDI_MEDIA_BUFFER_HEAP_ELEMENT)mediaCtx->pBufferHeap->pHeapBase;
-    bufHeapElement += i;
+    PDDI_MEDIA_BUFFER_HEAP_ELEMENT bufHeapElement  = (PDDI_MEDIA_BUFFER_HEAP_ELEMENT)DdiMediaUtil_GetHeapElement(mediaCtx->pBufferHeap, i);
+    DDI_CHK_NULL(bufHeapElement, "invalid buffer id", nullptr);
     void *temp      = bufHeapElement->pCtx;
-    DdiMediaUtil_UnLockMutex(&mediaCtx->BufferMutex);
 
     return temp;
 }
@@ -1012,12 +998,9 @@ uint32_t DdiMedia_GetCtxTypeFromVABufferID (PDDI_MEDIA_CONTEXT mediaCtx, VABuffe
     DDI_CHK_NULL(mediaCtx, "nullptr mediaCtx", DDI_MEDIA_CONTEXT_TYPE_NONE);
 
     uint32_t i       = (uint32_t)bufferID;
-    DDI_CHK_LESS(i, mediaCtx->pBufferHeap->uiAllocatedHeapElements, "invalid buffer id", DDI_MEDIA_CONTEXT_TYPE_NONE);
-    DdiMediaUtil_LockMutex(&mediaCtx->BufferMutex);
-    PDDI_MEDIA_BUFFER_HEAP_ELEMENT bufHeapElement  = (PDDI_MEDIA_BUFFER_HEAP_ELEMENT)mediaCtx->pBufferHeap->pHeapBase;
-    bufHeapElement  += i;
+    PDDI_MEDIA_BUFFER_HEAP_ELEMENT bufHeapElement  = (PDDI_MEDIA_BUFFER_HEAP_ELEMENT)DdiMediaUtil_GetHeapElement(mediaCtx->pBufferHeap, i);
+    DDI_CHK_NULL(bufHeapElement, "invalid buffer id", DDI_MEDIA_CONTEXT_TYPE_NONE);
     uint32_t ctxType = bufHeapElement->uiCtxType;
-    DdiMediaUtil_UnLockMutex(&mediaCtx->BufferMutex);
 
     return ctxType;
 
@@ -1372,38 +1355,47 @@ static VAStatus DdiMedia_HeapInitialize(
     mediaCtx->pSurfaceHeap = (DDI_MEDIA_HEAP *)MOS_AllocAndZeroMemory(sizeof(DDI_MEDIA_HEAP));
     DDI_CHK_NULL(mediaCtx->pSurfaceHeap, "nullptr pSurfaceHeap", VA_STATUS_ERROR_ALLOCATION_FAILED);
     mediaCtx->pSurfaceHeap->uiHeapElementSize = sizeof(DDI_MEDIA_SURFACE_HEAP_ELEMENT);
+    mediaCtx->pSurfaceHeap->uiGenerationMask  = DDI_MEDIA_HEAP_GENERATION_MASK;
 
     mediaCtx->pBufferHeap = (DDI_MEDIA_HEAP *)MOS_AllocAndZeroMemory(sizeof(DDI_MEDIA_HEAP));
     DDI_CHK_NULL(mediaCtx->pBufferHeap, "nullptr BufferHeap", VA_STATUS_ERROR_ALLOCATION_FAILED);
     mediaCtx->pBufferHeap->uiHeapElementSize = sizeof(DDI_MEDIA_BUFFER_HEAP_ELEMENT);
+    mediaCtx->pBufferHeap->uiGenerationMask  = DDI_MEDIA_HEAP_GENERATION_MASK;
 
     mediaCtx->pImageHeap = (DDI_MEDIA_HEAP *)MOS_AllocAndZeroMemory(sizeof(DDI_MEDIA_HEAP));
     DDI_CHK_NULL(mediaCtx->pImageHeap, "nullptr ImageHeap", VA_STATUS_ERROR_ALLOCATION_FAILED);
     mediaCtx->pImageHeap->uiHeapElementSize = sizeof(DDI_MEDIA_IMAGE_HEAP_ELEMENT);
+    mediaCtx->pImageHeap->uiGenerationMask  = DDI_MEDIA_HEAP_GENERATION_MASK;
 
     mediaCtx->pDecoderCtxHeap = (DDI_MEDIA_HEAP *)MOS_AllocAndZeroMemory(sizeof(DDI_MEDIA_HEAP));
     DDI_CHK_NULL(mediaCtx->pDecoderCtxHeap, "nullptr DecoderCtxHeap", VA_STATUS_ERROR_ALLOCATION_FAILED);
     mediaCtx->pDecoderCtxHeap->uiHeapElementSize = sizeof(DDI_MEDIA_VACONTEXT_HEAP_ELEMENT);
+    mediaCtx->pDecoderCtxHeap->uiGenerationMask  = DDI_MEDIA_HEAP_CTX_GENERATION_MASK;
 
     mediaCtx->pEncoderCtxHeap = (DDI_MEDIA_HEAP *)MOS_AllocAndZeroMemory(sizeof(DDI_MEDIA_HEAP));
     DDI_CHK_NULL(mediaCtx->pEncoderCtxHeap, "nullptr EncoderCtxHeap", VA_STATUS_ERROR_ALLOCATION_FAILED);
     mediaCtx->pEncoderCtxHeap->uiHeapElementSize = sizeof(DDI_MEDIA_VACONTEXT_HEAP_ELEMENT);
+    mediaCtx->pEncoderCtxHeap->uiGenerationMask  = DDI_MEDIA_HEAP_CTX_GENERATION_MASK;
 
     mediaCtx->pVpCtxHeap = (DDI_MEDIA_HEAP *)MOS_AllocAndZeroMemory(sizeof(DDI_MEDIA_HEAP));
     DDI_CHK_NULL(mediaCtx->pVpCtxHeap, "nullptr VpCtxHeap", VA_STATUS_ERROR_ALLOCATION_FAILED);
     mediaCtx->pVpCtxHeap->uiHeapElementSize = sizeof(DDI_MEDIA_VACONTEXT_HEAP_ELEMENT);
+    mediaCtx->pVpCtxHeap->uiGenerationMask  = DDI_MEDIA_HEAP_CTX_GENERATION_MASK;
 
     mediaCtx->pProtCtxHeap = (DDI_MEDIA_HEAP *)MOS_AllocAndZeroMemory(sizeof(DDI_MEDIA_HEAP));
     DDI_CHK_NULL(mediaCtx->pProtCtxHeap, "nullptr pProtCtxHeap", VA_STATUS_ERROR_ALLOCATION_FAILED);
     mediaCtx->pProtCtxHeap->uiHeapElementSize = sizeof(DDI_MEDIA_VACONTEXT_HEAP_ELEMENT);
+    mediaCtx->pProtCtxHeap->uiGenerationMask  = DDI_MEDIA_HEAP_CTX_GENERATION_MASK;
 
     mediaCtx->pCmCtxHeap = (DDI_MEDIA_HEAP *)MOS_AllocAndZeroMemory(sizeof(DDI_MEDIA_HEAP));
     DDI_CHK_NULL(mediaCtx->pCmCtxHeap, "nullptr CmCtxHeap", VA_STATUS_ERROR_ALLOCATION_FAILED);
     mediaCtx->pCmCtxHeap->uiHeapElementSize = sizeof(DDI_MEDIA_VACONTEXT_HEAP_ELEMENT);
+    mediaCtx->pCmCtxHeap->uiGenerationMask  = DDI_MEDIA_HEAP_CTX_GENERATION_MASK;
 
     mediaCtx->pMfeCtxHeap = (DDI_MEDIA_HEAP *)MOS_AllocAndZeroMemory(sizeof(DDI_MEDIA_HEAP));
     DDI_CHK_NULL(mediaCtx->pMfeCtxHeap, "nullptr MfeCtxHeap", VA_STATUS_ERROR_ALLOCATION_FAILED);
     mediaCtx->pMfeCtxHeap->uiHeapElementSize = sizeof(DDI_MEDIA_VACONTEXT_HEAP_ELEMENT);
+    mediaCtx->pMfeCtxHeap->uiGenerationMask  = DDI_MEDIA_HEAP_CTX_GENERATION_MASK;
 
     // init the mutexs
     DdiMediaUtil_InitMutex(&mediaCtx->SurfaceMutex);
@@ -1415,6 +1407,7 @@ static VAStatus DdiMedia_HeapInitialize(
     DdiMediaUtil_InitMutex(&mediaCtx->ProtMutex);
     DdiMediaUtil_InitMutex(&mediaCtx->CmMutex);
     DdiMediaUtil_InitMutex(&mediaCtx->MfeMutex);
+    DdiMediaUtil_InitMutex(&mediaCtx->CopyMutex);
 
     return VA_STATUS_SUCCESS;
 }
@@ -1433,32 +1426,33 @@ static VAStatus DdiMedia_HeapDestroy(
 {
     DDI_CHK_NULL(mediaCtx, "nullptr ctx", VA_STATUS_ERROR_INVALID_CONTEXT);
     // destroy heaps
-    MOS_FreeMemory(mediaCtx->pSurfaceHeap->pHeapBase);
+    DdiMediaUtil_FreeHeapSegments(mediaCtx->pSurfaceHeap);
     MOS_FreeMemory(mediaCtx->pSurfaceHeap);
 
-    MOS_FreeMemory(mediaCtx->pBufferHeap->pHeapBase);
+    DdiMediaUtil_FreeHeapSegments(mediaCtx->pBufferHeap);
     MOS_FreeMemory(mediaCtx->pBufferHeap);
 
-    MOS_FreeMemory(mediaCtx->pImageHeap->pHeapBase);
+    DdiMediaUtil_FreeHeapSegments(mediaCtx->pImageHeap);
     MOS_FreeMemory(mediaCtx->pImageHeap);
 
-    MOS_FreeMemory(mediaCtx->pDecoderCtxHeap->pHeapBase);
+    DdiMediaUtil_FreeHeapSegments(mediaCtx->pDecoderCtxHeap);
     MOS_FreeMemory(mediaCtx->pDecoderCtxHeap);
 
-    MOS_FreeMemory(mediaCtx->pEncoderCtxHeap->pHeapBase);
+    DdiMediaUtil_FreeHeapSegments(mediaCtx->pEncoderCtxHeap);
     MOS_FreeMemory(mediaCtx->pEncoderCtxHeap);
 
-    MOS_FreeMemory(mediaCtx->pVpCtxHeap->pHeapBase);
+    DdiMediaUtil_FreeHeapSegments(mediaCtx->pVpCtxHeap);
     MOS_FreeMemory(mediaCtx->pVpCtxHeap);
 
-    MOS_FreeMemory(mediaCtx->pProtCtxHeap->pHeapBase);
+    DdiMediaUtil_FreeHeapSegments(mediaCtx->pProtCtxHeap);
     MOS_FreeMemory(mediaCtx->pProtCtxHeap);
 
-    MOS_FreeMemory(mediaCtx->pCmCtxHeap->pHeapBase);
+    DdiMediaUtil_FreeHeapSegments(mediaCtx->pCmCtxHeap);
     MOS_FreeMemory(mediaCtx->pCmCtxHeap);
 
-    MOS_FreeMemory(mediaCtx->pMfeCtxHeap->pHeapBase);
+    DdiMediaUtil_FreeHeapSegments(mediaCtx->pMfeCtxHeap);
     MOS_FreeMemory(mediaCtx->pMfeCtxHeap);
+    DdiMediaUtil_FreeCopyResources(mediaCtx);
     // destroy the mutexs
     DdiMediaUtil_DestroyMutex(&mediaCtx->SurfaceMutex);
     DdiMediaUtil_DestroyMutex(&mediaCtx->BufferMutex);
@@ -1469,6 +1463,7 @@ static VAStatus DdiMedia_HeapDestroy(
     DdiMediaUtil_DestroyMutex(&mediaCtx->ProtMutex);
     DdiMediaUtil_DestroyMutex(&mediaCtx->CmMutex);
     DdiMediaUtil_DestroyMutex(&mediaCtx->MfeMutex);
+    DdiMediaUtil_DestroyMutex(&mediaCtx->CopyMutex);
 
     //resource checking
     if (mediaCtx->uiNumSurfaces != 0)
@@ -1545,6 +1540,7 @@ void DestroyMediaContextMutex(PDDI_MEDIA_CONTEXT mediaCtx)
     DdiMediaUtil_DestroyMutex(&mediaCtx->VpMutex);
     DdiMediaUtil_DestroyMutex(&mediaCtx->CmMutex);
     DdiMediaUtil_DestroyMutex(&mediaCtx->MfeMutex);
+    DdiMediaUtil_DestroyMutex(&mediaCtx->CopyMutex);
 #if !defined(ANDROID) && defined(X11_FOUND)
     DdiMediaUtil_DestroyMutex(&mediaCtx->PutSurfaceRenderMutex);
     DdiMediaUtil_DestroyMutex(&mediaCtx->PutSurfaceSwapBufferMutex);
@@ -2032,6 +2028,11 @@ VAStatus DdiMedia_InitMediaContext (
         FreeForMediaContext(mediaCtx);
         return VA_STATUS_ERROR_ALLOCATION_FAILED;
     }
+    if (mediaCtx->m_caps->BuildProfileIndex() != VA_STATUS_SUCCESS)
+    {
+        // Not fatal, the caps lookups scan the profile table instead
+        DDI_NORMALMESSAGE("Caps profile index not built.");
+    }
     ctx->max_image_formats = mediaCtx->m_caps->GetImageFormatsMaxNum();
 
 #ifdef _MANUAL_SOFTLET_
@@ -2064,6 +2065,7 @@ VAStatus DdiMedia_InitMediaContext (
 #endif
 
     DdiMediaUtil_SetMediaResetEnableFlag(mediaCtx);
+    DdiMediaUtil_InitCopyWorkers(mediaCtx);
 
     DdiMediaUtil_UnLockMutex(&GlobalMutex);
 
@@ -2509,7 +2511,7 @@ VAStatus DdiMedia_DestroySurfaces (
     PDDI_MEDIA_SURFACE surface = nullptr;
     for(int32_t i = 0; i < num_surfaces; i++)
     {
-        DDI_CHK_LESS((uint32_t)surfaces[i], mediaCtx->pSurfaceHeap->uiAllocatedHeapElements, "Invalid surfaces", VA_STATUS_ERROR_INVALID_SURFACE);
+        DDI_CHK_LESS(DDI_MEDIA_HEAP_ID_INDEX(surfaces[i]), mediaCtx->pSurfaceHeap->uiAllocatedHeapElements, "Invalid surfaces", VA_STATUS_ERROR_INVALID_SURFACE);
         surface = DdiMedia_GetSurfaceFromVASurfaceID(mediaCtx, surfaces[i]);
         DDI_CHK_NULL(surface, "nullptr surface", VA_STATUS_ERROR_INVALID_SURFACE);
         if(surface->pCurrentFrameSemaphore)
@@ -2526,7 +2528,7 @@ VAStatus DdiMedia_DestroySurfaces (
 
     for(int32_t i = 0; i < num_surfaces; i++)
     {
-        DDI_CHK_LESS((uint32_t)surfaces[i], mediaCtx->pSurfaceHeap->uiAllocatedHeapElements, "Invalid surfaces", VA_STATUS_ERROR_INVALID_SURFACE);
+        DDI_CHK_LESS(DDI_MEDIA_HEAP_ID_INDEX(surfaces[i]), mediaCtx->pSurfaceHeap->uiAllocatedHeapElements, "Invalid surfaces", VA_STATUS_ERROR_INVALID_SURFACE);
         surface = DdiMedia_GetSurfaceFromVASurfaceID(mediaCtx, surfaces[i]);
         DDI_CHK_NULL(surface, "nullptr surface", VA_STATUS_ERROR_INVALID_SURFACE);
         if(surface->pCurrentFrameSemaphore)
@@ -3160,7 +3162,7 @@ VAStatus DdiMedia_CreateContext (
         for(int32_t i = 0; i < num_render_targets; i++)
         {
             uint32_t surfaceId = (uint32_t)render_targets[i];
-            DDI_CHK_LESS(surfaceId, mediaDrvCtx->pSurfaceHeap->uiAllocatedHeapElements, "Invalid Surface", VA_STATUS_ERROR_INVALID_SURFACE);
+            DDI_CHK_LESS(DDI_MEDIA_HEAP_ID_INDEX(surfaceId), mediaDrvCtx->pSurfaceHeap->uiAllocatedHeapElements, "Invalid Surface", VA_STATUS_ERROR_INVALID_SURFACE);
         }
     }
 
@@ -3280,7 +3282,7 @@ VAStatus DdiMedia_BufferSetNumElements (
     DDI_CHK_NULL(mediaCtx,              "nullptr mediaCtx",              VA_STATUS_ERROR_INVALID_CONTEXT);
 
     DDI_CHK_NULL(mediaCtx->pBufferHeap, "nullptr mediaCtx->pBufferHeap", VA_STATUS_ERROR_INVALID_CONTEXT);
-    DDI_CHK_LESS((uint32_t)buf_id, mediaCtx->pBufferHeap->uiAllocatedHeapElements, "Invalid buf_id", VA_STATUS_ERROR_INVALID_BUFFER);
+    DDI_CHK_LESS(DDI_MEDIA_HEAP_ID_INDEX(buf_id), mediaCtx->pBufferHeap->uiAllocatedHeapElements, "Invalid buf_id", VA_STATUS_ERROR_INVALID_BUFFER);
 
     DDI_MEDIA_BUFFER *buf       = DdiMedia_GetBufferFromVABufferID(mediaCtx, buf_id);
     DDI_CHK_NULL(buf, "Invalid buffer.", VA_STATUS_ERROR_INVALID_BUFFER);
@@ -3338,7 +3340,7 @@ VAStatus DdiMedia_MapBufferInternal (
     DDI_CHK_NULL(mediaCtx,              "nullptr mediaCtx",              VA_STATUS_ERROR_INVALID_CONTEXT);
 
     DDI_CHK_NULL(mediaCtx->pBufferHeap, "nullptr mediaCtx->pBufferHeap", VA_STATUS_ERROR_INVALID_CONTEXT);
-    DDI_CHK_LESS((uint32_t)buf_id, mediaCtx->pBufferHeap->uiAllocatedHeapElements, "Invalid bufferId", VA_STATUS_ERROR_INVALID_CONTEXT);
+    DDI_CHK_LESS(DDI_MEDIA_HEAP_ID_INDEX(buf_id), mediaCtx->pBufferHeap->uiAllocatedHeapElements, "Invalid bufferId", VA_STATUS_ERROR_INVALID_CONTEXT);
 
     DDI_MEDIA_BUFFER   *buf     = DdiMedia_GetBufferFromVABufferID(mediaCtx, buf_id);
     DDI_CHK_NULL(buf, "nullptr buf", VA_STATUS_ERROR_INVALID_BUFFER);
@@ -3623,7 +3625,7 @@ VAStatus DdiMedia_UnmapBuffer (
     DDI_CHK_NULL(mediaCtx,               "nullptr mediaCtx",               VA_STATUS_ERROR_INVALID_CONTEXT);
 
     DDI_CHK_NULL( mediaCtx->pBufferHeap, "nullptr  mediaCtx->pBufferHeap", VA_STATUS_ERROR_INVALID_CONTEXT);
-    DDI_CHK_LESS((uint32_t)buf_id, mediaCtx->pBufferHeap->uiAllocatedHeapElements, "Invalid buf_id", VA_STATUS_ERROR_INVALID_BUFFER);
+    DDI_CHK_LESS(DDI_MEDIA_HEAP_ID_INDEX(buf_id), mediaCtx->pBufferHeap->uiAllocatedHeapElements, "Invalid buf_id", VA_STATUS_ERROR_INVALID_BUFFER);
 
     DDI_MEDIA_BUFFER   *buf     = DdiMedia_GetBufferFromVABufferID(mediaCtx,  buf_id);
     DDI_CHK_NULL(buf, "nullptr buf", VA_STATUS_ERROR_INVALID_BUFFER);
@@ -3722,7 +3724,7 @@ VAStatus DdiMedia_DestroyBuffer (
     DDI_CHK_NULL(mediaCtx,              "nullptr mediaCtx",              VA_STATUS_ERROR_INVALID_CONTEXT);
 
     DDI_CHK_NULL(mediaCtx->pBufferHeap, "nullptr mediaCtx->pBufferHeap", VA_STATUS_ERROR_INVALID_CONTEXT);
-    DDI_CHK_LESS((uint32_t)buffer_id, mediaCtx->pBufferHeap->uiAllocatedHeapElements, "Invalid bufferId", VA_STATUS_ERROR_INVALID_CONTEXT);
+    DDI_CHK_LESS(DDI_MEDIA_HEAP_ID_INDEX(buffer_id), mediaCtx->pBufferHeap->uiAllocatedHeapElements, "Invalid bufferId", VA_STATUS_ERROR_INVALID_CONTEXT);
 
     DDI_MEDIA_BUFFER   *buf     = DdiMedia_GetBufferFromVABufferID(mediaCtx,  buffer_id);
     DDI_CHK_NULL(buf, "nullptr buf", VA_STATUS_ERROR_INVALID_BUFFER);
@@ -3912,7 +3914,7 @@ VAStatus DdiMedia_BeginPicture (
 
     DDI_CHK_NULL(mediaCtx,               "nullptr mediaCtx",               VA_STATUS_ERROR_INVALID_CONTEXT);
     DDI_CHK_NULL(mediaCtx->pSurfaceHeap, "nullptr mediaCtx->pSurfaceHeap", VA_STATUS_ERROR_INVALID_CONTEXT);
-    DDI_CHK_LESS((uint32_t)render_target, mediaCtx->pSurfaceHeap->uiAllocatedHeapElements, "render_target", VA_STATUS_ERROR_INVALID_SURFACE);
+    DDI_CHK_LESS(DDI_MEDIA_HEAP_ID_INDEX(render_target), mediaCtx->pSurfaceHeap->uiAllocatedHeapElements, "render_target", VA_STATUS_ERROR_INVALID_SURFACE);
 
     uint32_t ctxType = DDI_MEDIA_CONTEXT_TYPE_NONE;
     void     *ctxPtr = DdiMedia_GetContextFromContextID(ctx, context, &ctxType);
@@ -3967,7 +3969,7 @@ VAStatus DdiMedia_RenderPicture (
 
     for(int32_t i = 0; i < num_buffers; i++)
     {
-       DDI_CHK_LESS((uint32_t)buffers[i], mediaCtx->pBufferHeap->uiAllocatedHeapElements, "Invalid Buffer", VA_STATUS_ERROR_INVALID_BUFFER);
+       DDI_CHK_LESS(DDI_MEDIA_HEAP_ID_INDEX(buffers[i]), mediaCtx->pBufferHeap->uiAllocatedHeapElements, "Invalid Buffer", VA_STATUS_ERROR_INVALID_BUFFER);
     }
 
     uint32_t ctxType = DDI_MEDIA_CONTEXT_TYPE_NONE;
@@ -4022,6 +4024,46 @@ VAStatus DdiMedia_EndPicture (
     return vaStatus;
 }
 
+//!
+//! \brief  Update the status of surfaces reported by VP
+//! \details Take the VP status reports out of the table up to the frame of the queried
+//!          surface, and update the surface of each. StatusFeedBackID of a report is the
+//!          target surface id set in BeginPicture, which indexes the surface heap directly.
+//!          Frames submitted after the queried one stay pending in the table.
+//!
+//! \param  [in] mediaCtx
+//!         Pointer to media context
+//! \param  [in] vpCtx
+//!         Pointer to VP context
+//! \param  [in] surface_id
+//!         VA surface id being queried
+//!
+//! \return VAStatus
+//!         VA_STATUS_SUCCESS if success, else fail reason
+//!
+static VAStatus DdiMedia_UpdateVpStatusReport(
+    PDDI_MEDIA_CONTEXT mediaCtx,
+    PDDI_VP_CONTEXT    vpCtx,
+    VASurfaceID        surface_id)
+{
+    DdiMediaUtil_LockGuard guard(&mediaCtx->SurfaceMutex);
+
+    DdiVp_DrainStatusReport(vpCtx->pVpHal, vpCtx->StatusReports, surface_id, [mediaCtx](const QUERY_STATUS_REPORT_APP &report) {
+        // the surface of an earlier frame may be destroyed already, its report is dropped
+        DDI_MEDIA_SURFACE *tempSurface = DdiMedia_GetSurfaceFromVASurfaceID(mediaCtx, report.StatusFeedBackID);
+        if (tempSurface == nullptr)
+        {
+            return;
+        }
+
+        // Update the status of the surface which is reported.
+        tempSurface->curStatusReport.vpp.status = (uint32_t)report.dwStatus;
+        tempSurface->curStatusReportQueryState  = DDI_MEDIA_STATUS_REPORT_QUERY_STATE_COMPLETED;
+    });
+
+    return VA_STATUS_SUCCESS;
+}
+
 static VAStatus DdiMedia_StatusCheck (
     PDDI_MEDIA_CONTEXT mediaCtx,
     DDI_MEDIA_SURFACE  *surface,
@@ -4033,7 +4075,6 @@ static VAStatus DdiMedia_StatusCheck (
     DDI_CHK_NULL(mediaCtx, "nullptr mediaCtx", VA_STATUS_ERROR_INVALID_CONTEXT);
     DDI_CHK_NULL(surface,  "nullptr surface",  VA_STATUS_ERROR_INVALID_CONTEXT);
 
-    uint32_t i = 0;
     PDDI_DECODE_CONTEXT decCtx = (PDDI_DECODE_CONTEXT)surface->pDecCtx;
     if (decCtx && surface->curCtxType == DDI_MEDIA_CONTEXT_TYPE_DECODER)
     {
@@ -4064,37 +4105,12 @@ static VAStatus DdiMedia_StatusCheck (
         DDI_CHK_NULL(vpCtx ,        "nullptr vpCtx",         VA_STATUS_ERROR_INVALID_CONTEXT);
         DDI_CHK_NULL(vpCtx->pVpHal ,"nullptr vpCtx->pVpHal", VA_STATUS_ERROR_INVALID_CONTEXT);
 
-        QUERY_STATUS_REPORT_APP tempVpReport;
-        MOS_ZeroMemory(&tempVpReport, sizeof(QUERY_STATUS_REPORT_APP));
-
-        // Get reported surfaces' count
-        uint32_t tableLen = 0;
-        vpCtx->pVpHal->GetStatusReportEntryLength(&tableLen);
-
-        if (tableLen > 0 && surface->curStatusReportQueryState == DDI_MEDIA_STATUS_REPORT_QUERY_STATE_PENDING)
+        if (surface->curStatusReportQueryState == DDI_MEDIA_STATUS_REPORT_QUERY_STATE_PENDING)
         {
-            // Query the status for all of surfaces which have finished
-            for(i = 0; i < tableLen; i++)
+            VAStatus vaStatus = DdiMedia_UpdateVpStatusReport(mediaCtx, vpCtx, surface_id);
+            if (vaStatus != VA_STATUS_SUCCESS)
             {
-                MOS_ZeroMemory(&tempVpReport, sizeof(QUERY_STATUS_REPORT_APP));
-                vpCtx->pVpHal->GetStatusReport(&tempVpReport, 1);
-
-                // StatusFeedBackID is last time submitted Target Surface ID which is set in BeginPicture,
-                // So we can know the report is for which surface here.
-                DDI_MEDIA_SURFACE *tempSurface = DdiMedia_GetSurfaceFromVASurfaceID(mediaCtx, tempVpReport.StatusFeedBackID);
-                if(tempSurface == nullptr)
-                {
-                    return VA_STATUS_ERROR_OPERATION_FAILED;
-                }
-
-                // Update the status of the surface which is reported.
-                tempSurface->curStatusReport.vpp.status = (uint32_t)tempVpReport.dwStatus;
-                tempSurface->curStatusReportQueryState  = DDI_MEDIA_STATUS_REPORT_QUERY_STATE_COMPLETED;
-
-                if(tempVpReport.StatusFeedBackID == surface_id)
-                {
-                    break;
-                }
+                return vaStatus;
             }
         }
 
@@ -4139,7 +4155,7 @@ VAStatus DdiMedia_SyncSurface (
     DDI_CHK_NULL(mediaCtx,               "nullptr mediaCtx",               VA_STATUS_ERROR_INVALID_CONTEXT);
     DDI_CHK_NULL(mediaCtx->pSurfaceHeap, "nullptr mediaCtx->pSurfaceHeap", VA_STATUS_ERROR_INVALID_CONTEXT);
 
-    DDI_CHK_LESS((uint32_t)render_target, mediaCtx->pSurfaceHeap->uiAllocatedHeapElements, "Invalid render_target", VA_STATUS_ERROR_INVALID_SURFACE);
+    DDI_CHK_LESS(DDI_MEDIA_HEAP_ID_INDEX(render_target), mediaCtx->pSurfaceHeap->uiAllocatedHeapElements, "Invalid render_target", VA_STATUS_ERROR_INVALID_SURFACE);
 
     DDI_MEDIA_SURFACE  *surface = DdiMedia_GetSurfaceFromVASurfaceID(mediaCtx, render_target);
     DDI_CHK_NULL(surface,    "nullptr surface",      VA_STATUS_ERROR_INVALID_CONTEXT);
@@ -4180,7 +4196,7 @@ VAStatus DdiMedia_SyncSurface2 (
     DDI_CHK_NULL(mediaCtx,               "nullptr mediaCtx",               VA_STATUS_ERROR_INVALID_CONTEXT);
     DDI_CHK_NULL(mediaCtx->pSurfaceHeap, "nullptr mediaCtx->pSurfaceHeap", VA_STATUS_ERROR_INVALID_CONTEXT);
 
-    DDI_CHK_LESS((uint32_t)surface_id, mediaCtx->pSurfaceHeap->uiAllocatedHeapElements, "Invalid render_target", VA_STATUS_ERROR_INVALID_SURFACE);
+    DDI_CHK_LESS(DDI_MEDIA_HEAP_ID_INDEX(surface_id), mediaCtx->pSurfaceHeap->uiAllocatedHeapElements, "Invalid render_target", VA_STATUS_ERROR_INVALID_SURFACE);
 
     DDI_MEDIA_SURFACE  *surface = DdiMedia_GetSurfaceFromVASurfaceID(mediaCtx, surface_id);
     DDI_CHK_NULL(surface,    "nullptr surface",      VA_STATUS_ERROR_INVALID_CONTEXT);
@@ -4251,7 +4267,7 @@ VAStatus DdiMedia_SyncBuffer (
     DDI_CHK_NULL(mediaCtx,               "nullptr mediaCtx",               VA_STATUS_ERROR_INVALID_CONTEXT);
     DDI_CHK_NULL(mediaCtx->pBufferHeap,  "nullptr mediaCtx->pBufferHeap",  VA_STATUS_ERROR_INVALID_CONTEXT);
 
-    DDI_CHK_LESS((uint32_t)buf_id, mediaCtx->pBufferHeap->uiAllocatedHeapElements, "Invalid buffer", VA_STATUS_ERROR_INVALID_BUFFER);
+    DDI_CHK_LESS(DDI_MEDIA_HEAP_ID_INDEX(buf_id), mediaCtx->pBufferHeap->uiAllocatedHeapElements, "Invalid buffer", VA_STATUS_ERROR_INVALID_BUFFER);
 
     DDI_MEDIA_BUFFER  *buffer = DdiMedia_GetBufferFromVABufferID(mediaCtx, buf_id);
     DDI_CHK_NULL(buffer,    "nullptr buffer",      VA_STATUS_ERROR_INVALID_CONTEXT);
@@ -4316,7 +4332,7 @@ VAStatus DdiMedia_QuerySurfaceStatus (
     DDI_CHK_NULL(mediaCtx,                  "nullptr mediaCtx",               VA_STATUS_ERROR_INVALID_CONTEXT);
     DDI_CHK_NULL(mediaCtx->pSurfaceHeap,    "nullptr mediaCtx->pSurfaceHeap", VA_STATUS_ERROR_INVALID_CONTEXT);
 
-    DDI_CHK_LESS((uint32_t)render_target, mediaCtx->pSurfaceHeap->uiAllocatedHeapElements, "Invalid render_target", VA_STATUS_ERROR_INVALID_SURFACE);
+    DDI_CHK_LESS(DDI_MEDIA_HEAP_ID_INDEX(render_target), mediaCtx->pSurfaceHeap->uiAllocatedHeapElements, "Invalid render_target", VA_STATUS_ERROR_INVALID_SURFACE);
     DDI_MEDIA_SURFACE *surface   = DdiMedia_GetSurfaceFromVASurfaceID(mediaCtx, render_target);
     DDI_CHK_NULL(surface,    "nullptr surface",    VA_STATUS_ERROR_INVALID_SURFACE);
 
@@ -4484,12 +4500,13 @@ VAStatus DdiMedia_PutSurface(
     DDI_CHK_NULL(mediaDrvCtx,               "nullptr mediaDrvCtx",               VA_STATUS_ERROR_INVALID_CONTEXT);
     DDI_CHK_NULL(mediaDrvCtx->pSurfaceHeap, "nullptr mediaDrvCtx->pSurfaceHeap", VA_STATUS_ERROR_INVALID_CONTEXT);
 
-    DDI_CHK_LESS((uint32_t)surface, mediaDrvCtx->pSurfaceHeap->uiAllocatedHeapElements, "Invalid surface", VA_STATUS_ERROR_INVALID_SURFACE);
+    DDI_CHK_LESS(DDI_MEDIA_HEAP_ID_INDEX(surface), mediaDrvCtx->pSurfaceHeap->uiAllocatedHeapElements, "Invalid surface", VA_STATUS_ERROR_INVALID_SURFACE);
 
-    if (nullptr != mediaDrvCtx->pVpCtxHeap->pHeapBase)
+    PDDI_MEDIA_VACONTEXT_HEAP_ELEMENT vpCtxHeapElmt = (PDDI_MEDIA_VACONTEXT_HEAP_ELEMENT)DdiMediaUtil_GetHeapElementByIndex(mediaDrvCtx->pVpCtxHeap, 0);
+    if (nullptr != vpCtxHeapElmt)
     {
         uint32_t ctxType = DDI_MEDIA_CONTEXT_TYPE_NONE;
-        vpCtx = DdiMedia_GetContextFromContextID(ctx, (VAContextID)(0 + DDI_MEDIA_VACONTEXTID_OFFSET_VP), &ctxType);
+        vpCtx = DdiMedia_GetContextFromContextID(ctx, (VAContextID)(vpCtxHeapElmt->uiVaContextID + DDI_MEDIA_VACONTEXTID_OFFSET_VP), &ctxType);
     }
 
 #if defined(ANDROID) || !defined(X11_FOUND)
@@ -4768,7 +4785,7 @@ VAStatus DdiMedia_DeriveImage (
     DDI_CHK_NULL(mediaCtx, "nullptr mediaCtx", VA_STATUS_ERROR_INVALID_CONTEXT);
 
     DDI_CHK_NULL(mediaCtx->pSurfaceHeap, "nullptr mediaCtx->pSurfaceHeap", VA_STATUS_ERROR_INVALID_CONTEXT);
-    DDI_CHK_LESS((uint32_t)surface, mediaCtx->pSurfaceHeap->uiAllocatedHeapElements, "Invalid surface", VA_STATUS_ERROR_INVALID_SURFACE);
+    DDI_CHK_LESS(DDI_MEDIA_HEAP_ID_INDEX(surface), mediaCtx->pSurfaceHeap->uiAllocatedHeapElements, "Invalid surface", VA_STATUS_ERROR_INVALID_SURFACE);
 
     DDI_MEDIA_SURFACE *mediaSurface = DdiMedia_GetSurfaceFromVASurfaceID(mediaCtx, surface);
     DDI_CHK_NULL(mediaSurface, "nullptr mediaSurface", VA_STATUS_ERROR_INVALID_SURFACE);
@@ -5071,7 +5088,7 @@ VAStatus DdiMedia_DestroyImage (
 
     DDI_CHK_NULL(mediaCtx,             "nullptr Media",                        VA_STATUS_ERROR_INVALID_CONTEXT);
     DDI_CHK_NULL(mediaCtx->pImageHeap, "nullptr mediaCtx->pImageHeap",        VA_STATUS_ERROR_INVALID_CONTEXT);
-    DDI_CHK_LESS((uint32_t)image, mediaCtx->pImageHeap->uiAllocatedHeapElements, "Invalid image", VA_STATUS_ERROR_INVALID_IMAGE);
+    DDI_CHK_LESS(DDI_MEDIA_HEAP_ID_INDEX(image), mediaCtx->pImageHeap->uiAllocatedHeapElements, "Invalid image", VA_STATUS_ERROR_INVALID_IMAGE);
 
     VAImage *vaImage = DdiMedia_GetVAImageFromVAImageID(mediaCtx, image);
     if (vaImage == nullptr)
@@ -5150,33 +5167,48 @@ VAStatus SwizzleSurface(PDDI_MEDIA_CONTEXT mediaCtx, PGMM_RESOURCE_INFO pGmmResI
 }
 
 //!
-//! \brief  Copy plane from src to dst row by row when src and dst strides are different
+//! \brief  Check whether image planes have the same layout as surface planes
 //!
-//! \param  [in] dst
-//!         Destination plane
-//! \param  [in] dstPitch
-//!         Destination plane pitch
-//! \param  [in] src
-//!         Source plane
-//! \param  [in] srcPitch
-//!         Source plane pitch
-//! \param  [in] height
-//!         Plane hight
-//!
-static void DdiMedia_CopyPlane(
-    uint8_t *dst,
-    uint32_t dstPitch,
-    uint8_t *src,
-    uint32_t srcPitch,
-    uint32_t height)
+//! \param  [in] surface
+//!         Pointer to surface
+//! \param  [in] image
+//!         Pointer to image
+//!
+//! \return bool
+//!     true if the surface can be de-swizzled into the image buffer directly
+//!
+static bool DdiMedia_IsImageLayoutSameAsSurface(
+    DDI_MEDIA_SURFACE *surface,
+    VAImage           *image)
 {
-    uint32_t rowSize = std::min(dstPitch, srcPitch);
-    for (int y = 0; y < height; y += 1)
+    if (surface->pGmmResourceInfo == nullptr ||
+        image->offsets[0] != 0 ||
+        image->pitches[0] != (uint32_t)surface->iPitch ||
+        image->height > (uint32_t)surface->iHeight ||
+        image->data_size < surface->pGmmResourceInfo->GetSizeSurface())
     {
-        memcpy(dst, src, rowSize);
-        dst += dstPitch;
-        src += srcPitch;
+        return false;
     }
+
+    if (image->num_planes > 1)
+    {
+        uint32_t chromaPitch  = 0;
+        uint32_t chromaHeight = 0;
+        DdiMedia_GetChromaPitchHeight(DdiMedia_MediaFormatToOsFormat(surface->format), surface->iPitch, surface->iHeight, &chromaPitch, &chromaHeight);
+        if (image->offsets[1] != (uint32_t)(surface->iPitch * surface->iHeight) ||
+            image->pitches[1] != chromaPitch)
+        {
+            return false;
+        }
+        if (image->num_planes > 2 &&
+            (image->offsets[2] != image->offsets[1] + chromaPitch * chromaHeight ||
+             image->pitches[2] != chromaPitch))
+        {
+            return false;
+        }
+    }
+
+    return true;
 }
 
 //!
@@ -5240,22 +5272,35 @@ static VAStatus DdiMedia_CopySurfaceToImage(
     uint8_t *ySrc = nullptr;
     uint8_t *yDst = (uint8_t*)imageData;
 
-    uint8_t* swizzleData = nullptr;
+    uint8_t* swizzleData     = nullptr;
+    uint32_t swizzleDataSize = 0;
+    // rows read straight from a write combined surface mapping need streaming loads
+    bool     srcUncached     = surface->bMapWC;
 
     if (!surface->pMediaCtx->bIsAtomSOC && surface->TileType != I915_TILING_NONE && image->format.fourcc != VA_FOURCC_NV12)
     {
-        swizzleData = (uint8_t*)MOS_AllocMemory(surface->data_size);
-        if (nullptr != swizzleData)
+        if (DdiMedia_IsImageLayoutSameAsSurface(surface, image))
         {
-            SwizzleSurface(surface->pMediaCtx, surface->pGmmResourceInfo, surfData, (MOS_TILE_TYPE)surface->TileType, (uint8_t*)swizzleData, false);
-            ySrc = swizzleData;
+            // de-swizzle into the image buffer, no plane copy needed
+            SwizzleSurface(surface->pMediaCtx, surface->pGmmResourceInfo, surfData, (MOS_TILE_TYPE)surface->TileType, yDst, false);
         }
         else
         {
-             DDI_ASSERTMESSAGE("nullptr swizzleData.");
-             DdiMedia_UnmapBuffer(ctx, image->buf);
-             DdiMediaUtil_UnlockSurface(surface);
-             return VA_STATUS_ERROR_INVALID_BUFFER;
+            swizzleDataSize = surface->data_size;
+            swizzleData     = (uint8_t*)DdiMediaUtil_AcquireStagingBuffer(mediaCtx, &swizzleDataSize);
+            if (nullptr != swizzleData)
+            {
+                SwizzleSurface(surface->pMediaCtx, surface->pGmmResourceInfo, surfData, (MOS_TILE_TYPE)surface->TileType, (uint8_t*)swizzleData, false);
+                ySrc        = swizzleData;
+                srcUncached = false;
+            }
+            else
+            {
+                 DDI_ASSERTMESSAGE("nullptr swizzleData.");
+                 DdiMedia_UnmapBuffer(ctx, image->buf);
+                 DdiMediaUtil_UnlockSurface(surface);
+                 return VA_STATUS_ERROR_INVALID_BUFFER;
+            }
         }
     }
     else
@@ -5263,30 +5308,34 @@ static VAStatus DdiMedia_CopySurfaceToImage(
         ySrc = (uint8_t*)surfData;
     }
 
-    DdiMedia_CopyPlane(yDst, image->pitches[0], ySrc, surface->iPitch, image->height);
-    if (image->num_planes > 1)
+    // ySrc stays nullptr if the surface was de-swizzled into the image directly
+    if (nullptr != ySrc)
     {
-        uint8_t *uSrc = ySrc + surface->iPitch * surface->iHeight;
-        uint8_t *uDst = yDst + image->offsets[1];
-        uint32_t chromaPitch       = 0;
-        uint32_t chromaHeight      = 0;
-        uint32_t imageChromaPitch  = 0;
-        uint32_t imageChromaHeight = 0;
-        DdiMedia_GetChromaPitchHeight(DdiMedia_MediaFormatToOsFormat(surface->format), surface->iPitch, surface->iHeight, &chromaPitch, &chromaHeight);
-        DdiMedia_GetChromaPitchHeight(image->format.fourcc, image->pitches[0], image->height, &imageChromaPitch, &imageChromaHeight);
-        DdiMedia_CopyPlane(uDst, image->pitches[1], uSrc, chromaPitch, imageChromaHeight);
-
-        if(image->num_planes > 2)
+        DdiMediaUtil_CopyPlane(mediaCtx, yDst, image->pitches[0], ySrc, surface->iPitch, image->height, srcUncached);
+        if (image->num_planes > 1)
         {
-            uint8_t *vSrc = uSrc + chromaPitch * chromaHeight;
-            uint8_t *vDst = yDst + image->offsets[2];
-            DdiMedia_CopyPlane(vDst, image->pitches[2], vSrc, chromaPitch, imageChromaHeight);
+            uint8_t *uSrc = ySrc + surface->iPitch * surface->iHeight;
+            uint8_t *uDst = yDst + image->offsets[1];
+            uint32_t chromaPitch       = 0;
+            uint32_t chromaHeight      = 0;
+            uint32_t imageChromaPitch  = 0;
+            uint32_t imageChromaHeight = 0;
+            DdiMedia_GetChromaPitchHeight(DdiMedia_MediaFormatToOsFormat(surface->format), surface->iPitch, surface->iHeight, &chromaPitch, &chromaHeight);
+            DdiMedia_GetChromaPitchHeight(image->format.fourcc, image->pitches[0], image->height, &imageChromaPitch, &imageChromaHeight);
+            DdiMediaUtil_CopyPlane(mediaCtx, uDst, image->pitches[1], uSrc, chromaPitch, imageChromaHeight, srcUncached);
+
+            if(image->num_planes > 2)
+            {
+                uint8_t *vSrc = uSrc + chromaPitch * chromaHeight;
+                uint8_t *vDst = yDst + image->offsets[2];
+                DdiMediaUtil_CopyPlane(mediaCtx, vDst, image->pitches[2], vSrc, chromaPitch, imageChromaHeight, srcUncached);
+            }
         }
     }
 
     if (nullptr != swizzleData)
     {
-        MOS_FreeMemory(swizzleData);
+        DdiMediaUtil_ReleaseStagingBuffer(mediaCtx, swizzleData, swizzleDataSize);
         swizzleData = nullptr;
     }
     vaStatus = DdiMedia_UnmapBuffer(ctx, image->buf);
@@ -5345,8 +5394,8 @@ VAStatus DdiMedia_GetImage(
 
     DDI_CHK_NULL(mediaCtx->pSurfaceHeap,    "nullptr mediaCtx->pSurfaceHeap.",   VA_STATUS_ERROR_INVALID_CONTEXT);
     DDI_CHK_NULL(mediaCtx->pImageHeap,      "nullptr mediaCtx->pImageHeap.",     VA_STATUS_ERROR_INVALID_CONTEXT);
-    DDI_CHK_LESS((uint32_t)surface, mediaCtx->pSurfaceHeap->uiAllocatedHeapElements, "Invalid surface.", VA_STATUS_ERROR_INVALID_SURFACE);
-    DDI_CHK_LESS((uint32_t)image,   mediaCtx->pImageHeap->uiAllocatedHeapElements,   "Invalid image.",   VA_STATUS_ERROR_INVALID_IMAGE);
+    DDI_CHK_LESS(DDI_MEDIA_HEAP_ID_INDEX(surface), mediaCtx->pSurfaceHeap->uiAllocatedHeapElements, "Invalid surface.", VA_STATUS_ERROR_INVALID_SURFACE);
+    DDI_CHK_LESS(DDI_MEDIA_HEAP_ID_INDEX(image), mediaCtx->pImageHeap->uiAllocatedHeapElements,   "Invalid image.",   VA_STATUS_ERROR_INVALID_IMAGE);
 
     VAImage *vaimg = DdiMedia_GetVAImageFromVAImageID(mediaCtx, image);
     DDI_CHK_NULL(vaimg,     "nullptr vaimg.",       VA_STATUS_ERROR_INVALID_IMAGE);
@@ -5511,8 +5560,8 @@ VAStatus DdiMedia_PutImage(
 
     DDI_CHK_NULL(mediaCtx->pSurfaceHeap, "nullptr mediaCtx->pSurfaceHeap.",   VA_STATUS_ERROR_INVALID_CONTEXT);
     DDI_CHK_NULL(mediaCtx->pImageHeap,   "nullptr mediaCtx->pImageHeap.",     VA_STATUS_ERROR_INVALID_CONTEXT);
-    DDI_CHK_LESS((uint32_t)surface, mediaCtx->pSurfaceHeap->uiAllocatedHeapElements, "Invalid surface.", VA_STATUS_ERROR_INVALID_SURFACE);
-    DDI_CHK_LESS((uint32_t)image, mediaCtx->pImageHeap->uiAllocatedHeapElements,     "Invalid image.",   VA_STATUS_ERROR_INVALID_IMAGE);
+    DDI_CHK_LESS(DDI_MEDIA_HEAP_ID_INDEX(surface), mediaCtx->pSurfaceHeap->uiAllocatedHeapElements, "Invalid surface.", VA_STATUS_ERROR_INVALID_SURFACE);
+    DDI_CHK_LESS(DDI_MEDIA_HEAP_ID_INDEX(image), mediaCtx->pImageHeap->uiAllocatedHeapElements,     "Invalid image.",   VA_STATUS_ERROR_INVALID_IMAGE);
 
     DDI_MEDIA_SURFACE *mediaSurface = DdiMedia_GetSurfaceFromVASurfaceID(mediaCtx, surface);
     DDI_CHK_NULL(mediaSurface,     "nullptr mediaSurface.", VA_STATUS_ERROR_INVALID_SURFACE);
@@ -5655,7 +5704,7 @@ VAStatus DdiMedia_PutImage(
         {
             uint8_t *ySrc = (uint8_t *)imageData + vaimg->offsets[0];
             uint8_t *yDst = (uint8_t *)surfData;
-            DdiMedia_CopyPlane(yDst, mediaSurface->iPitch, ySrc, vaimg->pitches[0], src_height);
+            DdiMediaUtil_CopyPlane(mediaCtx, yDst, mediaSurface->iPitch, ySrc, vaimg->pitches[0], src_height, false);
 
             if (vaimg->num_planes > 1)
             {
@@ -5670,12 +5719,12 @@ VAStatus DdiMedia_PutImage(
 
                 uint8_t *uSrc = (uint8_t *)imageData + vaimg->offsets[1];
                 uint8_t *uDst = yDst + mediaSurface->iPitch * mediaSurface->iHeight;
-                DdiMedia_CopyPlane(uDst, chromaPitch, uSrc, vaimg->pitches[1], chromaHeight);
+                DdiMediaUtil_CopyPlane(mediaCtx, uDst, chromaPitch, uSrc, vaimg->pitches[1], chromaHeight, false);
                 if (vaimg->num_planes > 2)
                 {
                     uint8_t *vSrc = (uint8_t *)imageData + vaimg->offsets[2];
                     uint8_t *vDst = uDst + chromaPitch * chromaHeight;
-                    DdiMedia_CopyPlane(vDst, chromaPitch, vSrc, vaimg->pitches[2], chromaHeight);
+                    DdiMediaUtil_CopyPlane(mediaCtx, vDst, chromaPitch, vSrc, vaimg->pitches[2], chromaHeight, false);
                 }
             }
         } 
@@ -6196,7 +6245,7 @@ DdiMedia_Copy(
 
     if (dst_obj->obj_type == VACopyObjectSurface)
     {
-        DDI_CHK_LESS((uint32_t)dst_obj->object.surface_id, mediaCtx->pSurfaceHeap->uiAllocatedHeapElements, "copy_dst", VA_STATUS_ERROR_INVALID_SURFACE);
+        DDI_CHK_LESS(DDI_MEDIA_HEAP_ID_INDEX(dst_obj->object.surface_id), mediaCtx->pSurfaceHeap->uiAllocatedHeapElements, "copy_dst", VA_STATUS_ERROR_INVALID_SURFACE);
         dst_surface = DdiMedia_GetSurfaceFromVASurfaceID(mediaCtx, dst_obj->object.surface_id);
         DDI_CHK_NULL(dst_surface, "nullptr surface", VA_STATUS_ERROR_INVALID_SURFACE);
         DDI_CHK_NULL(dst_surface->pGmmResourceInfo, "nullptr dst_surface->pGmmResourceInfo", VA_STATUS_ERROR_INVALID_PARAMETER);
@@ -6206,7 +6255,7 @@ DdiMedia_Copy(
     }
     else if (dst_obj->obj_type == VACopyObjectBuffer)
     {
-        DDI_CHK_LESS((uint32_t)dst_obj->object.buffer_id, mediaCtx->pBufferHeap->uiAllocatedHeapElements, "Invalid copy dst buf_id", VA_STATUS_ERROR_INVALID_BUFFER);
+        DDI_CHK_LESS(DDI_MEDIA_HEAP_ID_INDEX(dst_obj->object.buffer_id), mediaCtx->pBufferHeap->uiAllocatedHeapElements, "Invalid copy dst buf_id", VA_STATUS_ERROR_INVALID_BUFFER);
         dst_buffer = DdiMedia_GetBufferFromVABufferID(mediaCtx, dst_obj->object.buffer_id);
         DDI_CHK_NULL(dst_buffer, "nullptr buffer", VA_STATUS_ERROR_INVALID_BUFFER);
         DDI_CHK_NULL(dst_buffer->pGmmResourceInfo, "nullptr dst_buffer->pGmmResourceInfo", VA_STATUS_ERROR_INVALID_PARAMETER);
@@ -6221,7 +6270,7 @@ DdiMedia_Copy(
 
     if (src_obj->obj_type == VACopyObjectSurface)
     {
-        DDI_CHK_LESS((uint32_t)src_obj->object.surface_id, mediaCtx->pSurfaceHeap->uiAllocatedHeapElements, "copy_src", VA_STATUS_ERROR_INVALID_SURFACE);
+        DDI_CHK_LESS(DDI_MEDIA_HEAP_ID_INDEX(src_obj->object.surface_id), mediaCtx->pSurfaceHeap->uiAllocatedHeapElements, "copy_src", VA_STATUS_ERROR_INVALID_SURFACE);
         src_surface = DdiMedia_GetSurfaceFromVASurfaceID(mediaCtx, src_obj->object.surface_id);
         DDI_CHK_NULL(src_surface, "nullptr surface", VA_STATUS_ERROR_INVALID_SURFACE);
         DDI_CHK_NULL(src_surface->pGmmResourceInfo, "nullptr src_surface->pGmmResourceInfo", VA_STATUS_ERROR_INVALID_PARAMETER);
@@ -6231,7 +6280,7 @@ DdiMedia_Copy(
     }
     else if (src_obj->obj_type == VACopyObjectBuffer)
     {
-        DDI_CHK_LESS((uint32_t)src_obj->object.buffer_id, mediaCtx->pBufferHeap->uiAllocatedHeapElements, "Invalid copy dst buf_id", VA_STATUS_ERROR_INVALID_BUFFER);
+        DDI_CHK_LESS(DDI_MEDIA_HEAP_ID_INDEX(src_obj->object.buffer_id), mediaCtx->pBufferHeap->uiAllocatedHeapElements, "Invalid copy dst buf_id", VA_STATUS_ERROR_INVALID_BUFFER);
         src_buffer = DdiMedia_GetBufferFromVABufferID(mediaCtx, src_obj->object.buffer_id);
         DDI_CHK_NULL(src_buffer, "nullptr buffer", VA_STATUS_ERROR_INVALID_BUFFER);
         DDI_CHK_NULL(src_buffer->pGmmResourceInfo, "nullptr src_buffer->pGmmResourceInfo", VA_STATUS_ERROR_INVALID_PARAMETER);
@@ -6329,7 +6378,7 @@ VAStatus DdiMedia_BufferInfo (
         return VA_STATUS_ERROR_INVALID_CONTEXT;
 
     DDI_CHK_NULL(mediaCtx->pBufferHeap, "nullptr mediaCtx->pBufferHeap", VA_STATUS_ERROR_INVALID_CONTEXT);
-    DDI_CHK_LESS((uint32_t)buf_id, mediaCtx->pBufferHeap->uiAllocatedHeapElements, "Invalid buf_id", VA_STATUS_ERROR_INVALID_BUFFER);
+    DDI_CHK_LESS(DDI_MEDIA_HEAP_ID_INDEX(buf_id), mediaCtx->pBufferHeap->uiAllocatedHeapElements, "Invalid buf_id", VA_STATUS_ERROR_INVALID_BUFFER);
 
     DDI_MEDIA_BUFFER *buf  = DdiMedia_GetBufferFromVABufferID(mediaCtx, buf_id);
     if (nullptr == buf)
@@ -6403,7 +6452,7 @@ VAStatus DdiMedia_LockSurface (
     PDDI_MEDIA_CONTEXT mediaCtx          = DdiMedia_GetMediaContext(ctx);
     DDI_CHK_NULL(mediaCtx,               "nullptr Media",                   VA_STATUS_ERROR_INVALID_CONTEXT);
     DDI_CHK_NULL(mediaCtx->pSurfaceHeap, "nullptr mediaCtx->pSurfaceHeap", VA_STATUS_ERROR_INVALID_CONTEXT);
-    DDI_CHK_LESS((uint32_t)surface, mediaCtx->pSurfaceHeap->uiAllocatedHeapElements, "Invalid surface", VA_STATUS_ERROR_INVALID_SURFACE);
+    DDI_CHK_LESS(DDI_MEDIA_HEAP_ID_INDEX(surface), mediaCtx->pSurfaceHeap->uiAllocatedHeapElements, "Invalid surface", VA_STATUS_ERROR_INVALID_SURFACE);
 
     DDI_MEDIA_SURFACE *mediaSurface = DdiMedia_GetSurfaceFromVASurfaceID(mediaCtx, surface);
     
@@ -6482,7 +6531,7 @@ VAStatus DdiMedia_UnlockSurface (
     PDDI_MEDIA_CONTEXT mediaCtx = DdiMedia_GetMediaContext(ctx);
     DDI_CHK_NULL(mediaCtx,               "nullptr mediaCtx",                 VA_STATUS_ERROR_INVALID_CONTEXT);
     DDI_CHK_NULL(mediaCtx->pSurfaceHeap, "nullptr mediaCtx->pSurfaceHeap",   VA_STATUS_ERROR_INVALID_CONTEXT);
-    DDI_CHK_LESS((uint32_t)surface, mediaCtx->pSurfaceHeap->uiAllocatedHeapElements, "Invalid surface", VA_STATUS_ERROR_INVALID_SURFACE);
+    DDI_CHK_LESS(DDI_MEDIA_HEAP_ID_INDEX(surface), mediaCtx->pSurfaceHeap->uiAllocatedHeapElements, "Invalid surface", VA_STATUS_ERROR_INVALID_SURFACE);
 
     DDI_MEDIA_SURFACE *mediaSurface = DdiMedia_GetSurfaceFromVASurfaceID(mediaCtx, surface);
     DDI_CHK_NULL(mediaSurface, "nullptr mediaSurface", VA_STATUS_ERROR_INVALID_SURFACE);
@@ -7156,7 +7205,7 @@ VAStatus DdiMedia_ExportSurfaceHandle(
     PDDI_MEDIA_CONTEXT mediaCtx = DdiMedia_GetMediaContext(ctx);
     DDI_CHK_NULL(mediaCtx,               "nullptr mediaCtx",               VA_STATUS_ERROR_INVALID_CONTEXT);
     DDI_CHK_NULL(mediaCtx->pSurfaceHeap, "nullptr mediaCtx->pSurfaceHeap", VA_STATUS_ERROR_INVALID_CONTEXT);
-    DDI_CHK_LESS((uint32_t)(surface_id), mediaCtx->pSurfaceHeap->uiAllocatedHeapElements, "Invalid surfaces", VA_STATUS_ERROR_INVALID_SURFACE);
+    DDI_CHK_LESS(DDI_MEDIA_HEAP_ID_INDEX(surface_id), mediaCtx->pSurfaceHeap->uiAllocatedHeapElements, "Invalid surfaces", VA_STATUS_ERROR_INVALID_SURFACE);
 
     DDI_MEDIA_SURFACE  *mediaSurface = DdiMedia_GetSurfaceFromVASurfaceID(mediaCtx, surface_id);
     DDI_CHK_NULL(mediaSurface,                   "nullptr mediaSurface",                   VA_STATUS_ERROR_INVALID_SURFACE);
@@ -7484,7 +7533,7 @@ MEDIAAPI_EXPORT VAStatus DdiMedia_ExtGetSurfaceHandle(
     PDDI_MEDIA_CONTEXT mediaCtx = DdiMedia_GetMediaContext(ctx);
     DDI_CHK_NULL(mediaCtx,               "nullptr mediaCtx",               VA_STATUS_ERROR_INVALID_CONTEXT);
     DDI_CHK_NULL(mediaCtx->pSurfaceHeap, "nullptr mediaCtx->pSurfaceHeap", VA_STATUS_ERROR_INVALID_CONTEXT);
-    DDI_CHK_LESS((uint32_t)(*surface), mediaCtx->pSurfaceHeap->uiAllocatedHeapElements, "Invalid surfaces", VA_STATUS_ERROR_INVALID_SURFACE);
+    DDI_CHK_LESS(DDI_MEDIA_HEAP_ID_INDEX(*surface), mediaCtx->pSurfaceHeap->uiAllocatedHeapElements, "Invalid surfaces", VA_STATUS_ERROR_INVALID_SURFACE);
 
     DDI_MEDIA_SURFACE  *mediaSurface = DdiMedia_GetSurfaceFromVASurfaceID(mediaCtx, *surface);
     if (mediaSurface)
@@ -7541,6 +7590,38 @@ MEDIAAPI_EXPORT VAStatus DdiMedia_MapBuffer2(
     return DdiMedia_MapBufferInternal(ctx, buf_id, pbuf, flag);
 }
 
+#ifdef _MEDIA_ULT_SUPPORTED
+//!
+//! \brief  Build or drop the caps profile lookup index, for devult to compare
+//!         the config lookups with and without it
+//!
+//! \param  [in] ctx
+//!         Pointer to VA driver context
+//! \param  [in] enable
+//!         Build the index if true, drop it if false
+//!
+//! \return VAStatus
+//!     VA_STATUS_SUCCESS if success, else fail reason
+//!
+MEDIAAPI_EXPORT VAStatus DdiMedia_UltSetCapsProfileIndex(
+    VADriverContextP    ctx,
+    bool                enable)
+{
+    DDI_CHK_NULL(ctx,                "nullptr ctx",              VA_STATUS_ERROR_INVALID_CONTEXT);
+
+    PDDI_MEDIA_CONTEXT mediaCtx = DdiMedia_GetMediaContext(ctx);
+    DDI_CHK_NULL(mediaCtx,           "nullptr mediaCtx",         VA_STATUS_ERROR_INVALID_CONTEXT);
+    DDI_CHK_NULL(mediaCtx->m_caps,   "nullptr mediaCtx->m_caps", VA_STATUS_ERROR_INVALID_CONTEXT);
+
+    if (enable)
+    {
+        return mediaCtx->m_caps->BuildProfileIndex();
+    }
+    mediaCtx->m_caps->DropProfileIndex();
+    return VA_STATUS_SUCCESS;
+}
+#endif // _MEDIA_ULT_SUPPORTED
+
 #ifdef __cplusplus
 }
 #endif
@@ -90,9 +90,10 @@
 #define DDI_CODEC_NUM_QUERY_ATTR_VP   9
 
 #define DDI_CODEC_MAX_BITSTREAM_BUFFER        16
-#define DDI_CODEC_MAX_BITSTREAM_BUFFER_MINUS1 (DDI_CODEC_MAX_BITSTREAM_BUFFER - 1)
-#define DDI_CODEC_BITSTREAM_BUFFER_INDEX_BITS 4  //the bitstream buffer index is 4 bits length
-#define DDI_CODEC_MAX_BITSTREAM_BUFFER_INDEX  0xF  // the maximum bitstream buffer index is 0xF
+#define DDI_CODEC_MAX_BITSTREAM_BUFFER_POOL   64  // bitstream buffer pool grows from DDI_CODEC_MAX_BITSTREAM_BUFFER up to this when HW is behind
+#define DDI_CODEC_BITSTREAM_POOL_IDLE_FRAMES  256 // graphics memory of a bitstream buffer not used for this many frames is released
+#define DDI_CODEC_BITSTREAM_POOL_MIN_BUFFERS  2   // bitstream buffers kept allocated when the pool shrinks
+#define DDI_CODEC_BITSTREAM_POOL_MAX_ORPHANS  16  // busy bitstream buffers given new graphics memory before the pool waits for HW
 #define DDI_CODEC_INVALID_BUFFER_INDEX        -1
 #define DDI_CODEC_VP8_MAX_REF_FRAMES          5
 #define DDI_CODEC_MIN_VALUE_OF_MAX_BS_SIZE    10240
@@ -151,6 +152,19 @@ typedef struct _DDI_CODEC_BITSTREAM_BUFFER_INFO
     uint8_t            *pSliceBuf;
 } DDI_CODEC_BITSTREAM_BUFFER_INFO;
 
+typedef struct _DDI_CODEC_BITSTREAM_POOL_STATS
+{
+    uint32_t            dwSlots;                // bitstream buffer objects created
+    uint32_t            dwAllocatedBuffers;     // bitstream buffers backed by graphics memory now
+    uint32_t            dwPeakAllocatedBuffers; // maximum of dwAllocatedBuffers
+    uint32_t            dwGrowCount;            // buffers allocated because all allocated ones were busy
+    uint32_t            dwShrinkCount;          // buffers released after being idle
+    uint32_t            dwReallocCount;         // buffers reallocated to hold a larger bitstream
+    uint32_t            dwOrphanCount;          // busy buffers replaced as the pool is at its limit
+    uint32_t            dwWaitCount;            // frames which waited for HW as DDI_CODEC_BITSTREAM_POOL_MAX_ORPHANS buffers were replaced
+    uint32_t            dwOverSizeCount;        // frames whose slices had to be combined into a new buffer
+} DDI_CODEC_BITSTREAM_POOL_STATS;
+
 typedef struct _DDI_CODEC_BUFFER_PARAM_H264
 {
     // slice control buffer
@@ -253,10 +267,16 @@ typedef struct _DDI_CODEC_BUFFER_PARAM_VP9
 typedef struct _DDI_CODEC_COM_BUFFER_MGR
 {
     // bitstream buffer
-    DDI_MEDIA_BUFFER                            *pBitStreamBuffObject[DDI_CODEC_MAX_BITSTREAM_BUFFER];
-    uint8_t                                     *pBitStreamBase[DDI_CODEC_MAX_BITSTREAM_BUFFER];
+    // the first DDI_CODEC_MAX_BITSTREAM_BUFFER objects are created by each codec, the others on demand
+    DDI_MEDIA_BUFFER                            *pBitStreamBuffObject[DDI_CODEC_MAX_BITSTREAM_BUFFER_POOL];
+    uint8_t                                     *pBitStreamBase[DDI_CODEC_MAX_BITSTREAM_BUFFER_POOL];
+    uint64_t                                     ui64BitstreamUseOrder[DDI_CODEC_MAX_BITSTREAM_BUFFER_POOL]; // ui64BitstreamOrder of the last frame using each bitstream buffer
     uint32_t                                     dwBitstreamIndex;   //indicating which bitstream buffer is used now
-    uint64_t                                     ui64BitstreamOrder; //save  bitstream buffer index used by previous 15 frames and current frame. the MSB is the oldest one, the LSB is current one.
+    uint64_t                                     ui64BitstreamOrder; //number of frames which have got a bitstream buffer
+    uint32_t                                     dwBitstreamOrphans; //busy bitstream buffers replaced since HW was last seen done with one
+    uint32_t                                     dwLargeBsSize;      //largest bitstream of the frames above dwMaxBsSize in the idle window
+    uint64_t                                     ui64LargeBsOrder;   //ui64BitstreamOrder of the last frame above dwMaxBsSize
+    DDI_CODEC_BITSTREAM_POOL_STATS               BitstreamPoolStats;
     MOS_RESOURCE                                 resBitstreamBuffer;
     uint8_t                                     *pBitstreamBuffer;
     DDI_CODEC_BITSTREAM_BUFFER_INFO             *pSliceData;
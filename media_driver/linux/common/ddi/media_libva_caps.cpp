@@ -236,15 +236,26 @@ VAStatus MediaLibvaCaps::GetProfileEntrypointFromConfigId(
     }
 
     int32_t i;
-    for (i = 0; i < m_profileEntryCount; i++)
+    if (m_profileIndex.IsValid() && codecType != videoProtect)
     {
-        if (CheckEntrypointCodecType(m_profileEntryTbl[i].m_entrypoint, codecType))
+        i = m_profileIndex.FindConfig(codecType, configOffset);
+        if (i < 0)
         {
-            int32_t configStart = m_profileEntryTbl[i].m_configStartIdx;
-            int32_t configEnd = m_profileEntryTbl[i].m_configStartIdx + m_profileEntryTbl[i].m_configNum;
-            if (configOffset >= configStart && configOffset < configEnd)
+            i = m_profileEntryCount;
+        }
+    }
+    else
+    {
+        for (i = 0; i < m_profileEntryCount; i++)
+        {
+            if (CheckEntrypointCodecType(m_profileEntryTbl[i].m_entrypoint, codecType))
             {
-                break;
+                int32_t configStart = m_profileEntryTbl[i].m_configStartIdx;
+                int32_t configEnd = m_profileEntryTbl[i].m_configStartIdx + m_profileEntryTbl[i].m_configNum;
+                if (configOffset >= configStart && configOffset < configEnd)
+                {
+                    break;
+                }
             }
         }
     }
@@ -274,6 +285,7 @@ VAStatus MediaLibvaCaps::AddProfileEntry(
         DDI_ASSERTMESSAGE("Invalid profile entrypoint number");
         return VA_STATUS_ERROR_INVALID_PARAMETER;
     }
+    m_profileIndex.Clear();
     m_profileEntryTbl[m_profileEntryCount].m_profile = profile;
     m_profileEntryTbl[m_profileEntryCount].m_entrypoint = entrypoint;
     m_profileEntryTbl[m_profileEntryCount].m_attributes = attributeList;
@@ -286,6 +298,11 @@ VAStatus MediaLibvaCaps::AddProfileEntry(
 
 int32_t MediaLibvaCaps::GetProfileTableIdx(VAProfile profile, VAEntrypoint entrypoint)
 {
+    if (m_profileIndex.IsValid())
+    {
+        return m_profileIndex.FindProfileEntry(profile, entrypoint);
+    }
+
     // initialize ret value to "invalid profile"
     int32_t ret = -1;
     for (int32_t i = 0; i < m_profileEntryCount; i++)
@@ -304,6 +321,69 @@ int32_t MediaLibvaCaps::GetProfileTableIdx(VAProfile profile, VAEntrypoint entry
     return ret;
 }
 
+bool MediaLibvaCaps::GetProfileAttrib(int32_t profileTableIdx, VAConfigAttribType type, uint32_t &value)
+{
+    if (m_profileIndex.IsValid())
+    {
+        return m_profileIndex.GetAttrib(profileTableIdx, type, value);
+    }
+
+    AttribMap *attributes = m_profileEntryTbl[profileTableIdx].m_attributes;
+    auto it = attributes->find(type);
+    if (it == attributes->end())
+    {
+        return false;
+    }
+    value = it->second;
+    return true;
+}
+
+VAStatus MediaLibvaCaps::BuildProfileIndex()
+{
+    m_profileIndex.Clear();
+
+    uint32_t attribTypeNum = 0;
+    for (int32_t i = 0; i < m_profileEntryCount; i++)
+    {
+        DDI_CHK_NULL(m_profileEntryTbl[i].m_attributes, "Null pointer", VA_STATUS_ERROR_INVALID_PARAMETER);
+        for (auto &attrib : *m_profileEntryTbl[i].m_attributes)
+        {
+            DDI_CHK_CONDITION(((uint32_t)attrib.first >= MediaLibvaCapsIndex::m_maxAttribTypes),
+                "Attribute type out of index range", VA_STATUS_ERROR_INVALID_PARAMETER);
+            attribTypeNum = MOS_MAX(attribTypeNum, (uint32_t)attrib.first + 1);
+        }
+    }
+    DDI_CHK_CONDITION(!m_profileIndex.InitAttribs(m_profileEntryCount, attribTypeNum),
+        "Failed to allocate attribute index", VA_STATUS_ERROR_INVALID_PARAMETER);
+
+    for (int32_t i = 0; i < m_profileEntryCount; i++)
+    {
+        DDI_CHK_CONDITION(!m_profileIndex.AddProfileEntry(m_profileEntryTbl[i].m_profile, m_profileEntryTbl[i].m_entrypoint, i),
+            "Failed to add profile index", VA_STATUS_ERROR_INVALID_PARAMETER);
+        for (auto &attrib : *m_profileEntryTbl[i].m_attributes)
+        {
+            m_profileIndex.SetAttrib(i, attrib.first, attrib.second);
+        }
+    }
+
+    // Protected entrypoints are decided at runtime, leave their configs to the table scan
+    const CodecType codecTypes[] = {videoEncode, videoDecode, videoProcess};
+    for (auto codecType : codecTypes)
+    {
+        for (int32_t i = 0; i < m_profileEntryCount; i++)
+        {
+            if (CheckEntrypointCodecType(m_profileEntryTbl[i].m_entrypoint, codecType))
+            {
+                DDI_CHK_CONDITION(!m_profileIndex.AddConfigs(codecType, m_profileEntryTbl[i].m_configStartIdx, m_profileEntryTbl[i].m_configNum, i),
+                    "Failed to add config index", VA_STATUS_ERROR_INVALID_PARAMETER);
+            }
+        }
+    }
+
+    m_profileIndex.SetValid();
+    return VA_STATUS_SUCCESS;
+}
+
 VAStatus MediaLibvaCaps::CreateAttributeList(AttribMap **attributeList)
 {
     DDI_CHK_NULL(attributeList, "Null pointer", VA_STATUS_ERROR_INVALID_PARAMETER);
@@ -360,12 +440,14 @@ VAStatus MediaLibvaCaps::SetAttribute(
     auto attribList = m_profileEntryTbl[idx].m_attributes;
     DDI_CHK_NULL(attribList, "Null pointer", VA_STATUS_ERROR_INVALID_PARAMETER);
 
+    m_profileIndex.Clear();
     (*attribList)[type] = value;
     return VA_STATUS_SUCCESS;
 }
 
 VAStatus MediaLibvaCaps::FreeAttributeList()
 {
+    m_profileIndex.Clear();
     uint32_t attribListCount = m_attributeLists.size();
     for (uint32_t i = 0; i < attribListCount; i++)
     {
@@ -484,8 +566,8 @@ VAStatus MediaLibvaCaps::CheckAttribList(
             }
         }
 
-        if (m_profileEntryTbl[idx].m_attributes->find(attrib[j].type) !=
-            m_profileEntryTbl[idx].m_attributes->end())
+        uint32_t attribValue = 0;
+        if (GetProfileAttrib(idx, attrib[j].type, attribValue))
         {
             isValidAttrib = false;
 
@@ -503,7 +585,7 @@ VAStatus MediaLibvaCaps::CheckAttribList(
              ||attrib[j].type == VAConfigAttribFEIFunctionType
              ||attrib[j].type == VAConfigAttribEncryption)
             {
-                if(((*m_profileEntryTbl[idx].m_attributes)[attrib[j].type] & attrib[j].value) == attrib[j].value)
+                if((attribValue & attrib[j].value) == attrib[j].value)
                 {
                     isValidAttrib = true;
                     continue;
@@ -513,20 +595,20 @@ VAStatus MediaLibvaCaps::CheckAttribList(
                     return VA_STATUS_ERROR_UNSUPPORTED_RT_FORMAT;
                 }
             }
-            else if((*m_profileEntryTbl[idx].m_attributes)[attrib[j].type] == attrib[j].value)
+            else if(attribValue == attrib[j].value)
             {
                 isValidAttrib = true;
                 continue;
             }
             else if(attrib[j].type == VAConfigAttribEncSliceStructure)
             {
-                if(((*m_profileEntryTbl[idx].m_attributes)[attrib[j].type] & attrib[j].value) == attrib[j].value)
+                if((attribValue & attrib[j].value) == attrib[j].value)
                 {
                     isValidAttrib = true;
                     continue;
                 }
 
-                if((*m_profileEntryTbl[idx].m_attributes)[attrib[j].type] & VA_ENC_SLICE_STRUCTURE_ARBITRARY_MACROBLOCKS)
+                if(attribValue & VA_ENC_SLICE_STRUCTURE_ARBITRARY_MACROBLOCKS)
                 {
                     if((attrib[j].value & VA_ENC_SLICE_STRUCTURE_EQUAL_ROWS)
                        ||(attrib[j].value & VA_ENC_SLICE_STRUCTURE_EQUAL_MULTI_ROWS)
@@ -537,7 +619,7 @@ VAStatus MediaLibvaCaps::CheckAttribList(
                         continue;
                     }
                 }
-                else if ((*m_profileEntryTbl[idx].m_attributes)[attrib[j].type] &
+                else if (attribValue &
                          (VA_ENC_SLICE_STRUCTURE_EQUAL_ROWS | VA_ENC_SLICE_STRUCTURE_MAX_SLICE_SIZE))
                 {
                     if((attrib[j].value & VA_ENC_SLICE_STRUCTURE_ARBITRARY_MACROBLOCKS)
@@ -554,7 +636,7 @@ VAStatus MediaLibvaCaps::CheckAttribList(
                  || (attrib[j].type == VAConfigAttribEncROI)
                  || (attrib[j].type == VAConfigAttribEncDirtyRect))
             {
-                if(attrib[j].value <= (*m_profileEntryTbl[idx].m_attributes)[attrib[j].type])
+                if(attrib[j].value <= attribValue)
                 {
                     isValidAttrib = true;
                     continue;
@@ -562,8 +644,8 @@ VAStatus MediaLibvaCaps::CheckAttribList(
             }
             else if(attrib[j].type == VAConfigAttribEncMaxRefFrames)
             {
-                if(((attrib[j].value & 0xffff) <= ((*m_profileEntryTbl[idx].m_attributes)[attrib[j].type] & 0xffff))
-                 &&(attrib[j].value <= (*m_profileEntryTbl[idx].m_attributes)[attrib[j].type]))  //high16 bit  can compare with this way
+                if(((attrib[j].value & 0xffff) <= (attribValue & 0xffff))
+                 &&(attrib[j].value <= attribValue))  //high16 bit  can compare with this way
                 {
                     isValidAttrib = true;
                     continue;
@@ -573,7 +655,7 @@ VAStatus MediaLibvaCaps::CheckAttribList(
             {
                 VAConfigAttribValEncJPEG jpegValue, jpegSetValue;
                 jpegValue.value = attrib[j].value;
-                jpegSetValue.value = (*m_profileEntryTbl[idx].m_attributes)[attrib[j].type];
+                jpegSetValue.value = attribValue;
                 if((jpegValue.bits.max_num_quantization_tables <= jpegSetValue.bits.max_num_quantization_tables)
                    &&(jpegValue.bits.max_num_huffman_tables <= jpegSetValue.bits.max_num_huffman_tables)
                    &&(jpegValue.bits.max_num_scans <= jpegSetValue.bits.max_num_scans)
@@ -1978,10 +2060,10 @@ VAStatus MediaLibvaCaps::GetConfigAttributes(VAProfile profile,
     DDI_CHK_NULL(m_profileEntryTbl[i].m_attributes, "Null pointer", VA_STATUS_ERROR_INVALID_PARAMETER);
     for (int32_t j = 0; j < numAttribs; j++)
     {
-        if (m_profileEntryTbl[i].m_attributes->find(attribList[j].type) !=
-                m_profileEntryTbl[i].m_attributes->end())
+        uint32_t attribValue = 0;
+        if (GetProfileAttrib(i, attribList[j].type, attribValue))
         {
-            attribList[j].value = (*m_profileEntryTbl[i].m_attributes)[attribList[j].type];
+            attribList[j].value = attribValue;
         }
         else
         {
@@ -2403,13 +2485,30 @@ VAStatus MediaLibvaCaps::QueryConfigAttributes(
     DDI_CHK_NULL(allAttribsList, "Null pointer", VA_STATUS_ERROR_INVALID_CONFIG);
 
     uint32_t j = 0;
-    for (auto it = allAttribsList->begin(); it != allAttribsList->end(); ++it)
+    if (m_profileIndex.IsValid())
     {
-        if (it->second != VA_ATTRIB_NOT_SUPPORTED)
+        // Same order as the map, by attribute type
+        for (uint32_t type = 0; type < m_profileIndex.GetAttribTypeNum(); type++)
         {
-            attribList[j].type = it->first;
-            attribList[j].value = it->second;
-            j++;
+            uint32_t value = 0;
+            if (m_profileIndex.GetAttrib(profileTableIdx, type, value) && value != VA_ATTRIB_NOT_SUPPORTED)
+            {
+                attribList[j].type = (VAConfigAttribType)type;
+                attribList[j].value = value;
+                j++;
+            }
+        }
+    }
+    else
+    {
+        for (auto it = allAttribsList->begin(); it != allAttribsList->end(); ++it)
+        {
+            if (it->second != VA_ATTRIB_NOT_SUPPORTED)
+            {
+                attribList[j].type = it->first;
+                attribList[j].value = it->second;
+                j++;
+            }
         }
     }
 
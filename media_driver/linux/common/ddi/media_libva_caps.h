@@ -31,6 +31,7 @@
 
 #include <vector>
 #include <map>
+#include "media_libva_caps_index.h"
 
 #ifndef CONTEXT_PRIORITY_MAX
 #define CONTEXT_PRIORITY_MAX 1024
@@ -732,6 +733,25 @@ public:
         return VA_STATUS_SUCCESS;
     }
 
+    //!
+    //! \brief    Build the lookup index of the profile & entrypoint table
+    //! \details  Called once Init() has loaded the table. Adding entries or attributes
+    //!           later drops the index, and lookups fall back to scanning the table.
+    //!
+    //! \return   VAStatus
+    //!           VA_STATUS_SUCCESS if the index is built
+    //!
+    VAStatus BuildProfileIndex();
+
+    //!
+    //! \brief    Drop the lookup index of the profile & entrypoint table
+    //! \details  Lookups scan the table until BuildProfileIndex() is called again
+    //!
+    void DropProfileIndex()
+    {
+        m_profileIndex.Clear();
+    }
+
     //! \brief Get surface drm modifier
     //!
     //! \param    [in] mediaSurface
@@ -900,6 +920,7 @@ protected:
     //!
     ProfileEntrypoint m_profileEntryTbl[m_maxProfileEntries];
     uint16_t m_profileEntryCount = 0; //!< Count valid entries in m_profileEntryTbl
+    MediaLibvaCapsIndex m_profileIndex; //!< Lookup index of m_profileEntryTbl
 
     //!
     //! \brief  Store attribute list pointers
@@ -1031,6 +1052,23 @@ protected:
     //!
     int32_t GetProfileTableIdx(VAProfile profile, VAEntrypoint entrypoint);
 
+    //!
+    //! \brief    Get the attribute value of a profile table entry
+    //!
+    //! \param    [in] profileTableIdx
+    //!           The index in m_profileEntryTbl
+    //!
+    //! \param    [in] type
+    //!           Attribute type
+    //!
+    //! \param    [out] value
+    //!           Attribute value
+    //!
+    //! \return   bool
+    //!           true if the entry has the attribute
+    //!
+    bool GetProfileAttrib(int32_t profileTableIdx, VAConfigAttribType type, uint32_t &value);
+
     //!
     //! \brief    Create attributes map
     //!
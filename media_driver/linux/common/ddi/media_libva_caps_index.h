@@ -0,0 +1,271 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     media_libva_caps_index.h
+//! \brief    Lookup index of the profile & entrypoint table of MediaLibvaCaps
+//! \details  Built once the caps are loaded, it replaces the linear scans of the profile
+//!           & entrypoint table done by vaCreateConfig, vaGetConfigAttributes and
+//!           vaQueryConfigAttributes:
+//!           - (profile, entrypoint) to table index, in an open addressing hash table
+//!           - config offset to table index, in a flat array per codec type
+//!           - attributes of each table entry, in a flat array indexed by attribute type
+//!
+#ifndef __MEDIA_LIBVA_CAPS_INDEX_H__
+#define __MEDIA_LIBVA_CAPS_INDEX_H__
+
+#include <stdint.h>
+#include <vector>
+
+class MediaLibvaCapsIndex
+{
+public:
+    static const uint32_t m_hashBits        = 8;
+    static const uint32_t m_hashSize        = 1 << m_hashBits;  //!< Keeps the load under 1/2 for 64 profile & entrypoint entries
+    static const uint32_t m_maxAttribTypes  = 256;              //!< Larger attribute type disables the index
+    static const uint32_t m_maxCodecTypes   = 4;
+    static const uint32_t m_maxConfigs      = 0x10000;          //!< Configs per codec type
+
+    //!
+    //! \brief    Drop the index, lookups go back to the tables until it is built again
+    //!
+    void Clear()
+    {
+        for (auto &slot : m_entrySlots)
+        {
+            slot.used = false;
+        }
+        for (auto &slot : m_profileSlots)
+        {
+            slot.used = false;
+        }
+        for (auto &configs : m_configIdx)
+        {
+            configs.clear();
+        }
+        m_attribValues.clear();
+        m_attribValid.clear();
+        m_attribTypeNum = 0;
+        m_entryNum      = 0;
+        m_valid         = false;
+    }
+
+    bool IsValid() const
+    {
+        return m_valid;
+    }
+
+    //!
+    //! \brief    Mark the index complete, called after all entries are added
+    //!
+    void SetValid()
+    {
+        m_valid = true;
+    }
+
+    //!
+    //! \brief    Allocate the attribute arrays
+    //! \param    [in] entryNum
+    //!           Number of profile & entrypoint entries
+    //! \param    [in] attribTypeNum
+    //!           Largest attribute type of all entries plus one
+    //! \return   bool
+    //!           false if attribTypeNum is over m_maxAttribTypes
+    //!
+    bool InitAttribs(uint32_t entryNum, uint32_t attribTypeNum)
+    {
+        if (attribTypeNum > m_maxAttribTypes)
+        {
+            return false;
+        }
+        m_entryNum      = entryNum;
+        m_attribTypeNum = attribTypeNum;
+        m_attribValues.assign(entryNum * attribTypeNum, 0);
+        m_attribValid.assign(entryNum * attribTypeNum, 0);
+        return true;
+    }
+
+    //!
+    //! \brief    Add a profile & entrypoint table entry
+    //! \details  Entries need to be added in table order, the first one wins for the
+    //!           same profile and entrypoint as the linear scan does.
+    //! \return   bool
+    //!           false if the hash table is full
+    //!
+    bool AddProfileEntry(int32_t profile, int32_t entrypoint, int32_t idx)
+    {
+        return Insert(m_entrySlots, Key(profile, entrypoint), idx) &&
+               Insert(m_profileSlots, Key(profile, 0), idx);
+    }
+
+    //!
+    //! \brief    Find the table index by profile and entrypoint
+    //! \return   int32_t
+    //!           Table index, -2 if only the profile is supported, -1 if not
+    //!
+    int32_t FindProfileEntry(int32_t profile, int32_t entrypoint) const
+    {
+        int32_t idx = Find(m_entrySlots, Key(profile, entrypoint));
+        if (idx >= 0)
+        {
+            return idx;
+        }
+        return Find(m_profileSlots, Key(profile, 0)) >= 0 ? -2 : -1;
+    }
+
+    void SetAttrib(int32_t idx, uint32_t type, uint32_t value)
+    {
+        uint32_t pos        = idx * m_attribTypeNum + type;
+        m_attribValues[pos] = value;
+        m_attribValid[pos]  = 1;
+    }
+
+    //!
+    //! \brief    Get the attribute of a table entry
+    //! \return   bool
+    //!           false if the entry does not have the attribute
+    //!
+    bool GetAttrib(int32_t idx, uint32_t type, uint32_t &value) const
+    {
+        if (idx < 0 || (uint32_t)idx >= m_entryNum || type >= m_attribTypeNum)
+        {
+            return false;
+        }
+        uint32_t pos = idx * m_attribTypeNum + type;
+        if (!m_attribValid[pos])
+        {
+            return false;
+        }
+        value = m_attribValues[pos];
+        return true;
+    }
+
+    uint32_t GetAttribTypeNum() const
+    {
+        return m_attribTypeNum;
+    }
+
+    //!
+    //! \brief    Map the configs of a table entry, first added entry wins for the same offset
+    //! \return   bool
+    //!           false if the configs are out of the range of the index
+    //!
+    bool AddConfigs(uint32_t codecType, int32_t configStart, int32_t configNum, int32_t idx)
+    {
+        if (codecType >= m_maxCodecTypes || configStart < 0 || configNum < 0 ||
+            (uint32_t)configStart + configNum > m_maxConfigs)
+        {
+            return false;
+        }
+        std::vector<int16_t> &configs = m_configIdx[codecType];
+        if (configs.size() < (uint32_t)(configStart + configNum))
+        {
+            configs.resize(configStart + configNum, -1);
+        }
+        for (int32_t i = configStart; i < configStart + configNum; i++)
+        {
+            if (configs[i] < 0)
+            {
+                configs[i] = (int16_t)idx;
+            }
+        }
+        return true;
+    }
+
+    //!
+    //! \brief    Find the table index by config offset
+    //! \return   int32_t
+    //!           Table index, -1 if no entry has the config
+    //!
+    int32_t FindConfig(uint32_t codecType, int32_t configOffset) const
+    {
+        if (codecType >= m_maxCodecTypes || configOffset < 0 ||
+            (uint32_t)configOffset >= m_configIdx[codecType].size())
+        {
+            return -1;
+        }
+        return m_configIdx[codecType][configOffset];
+    }
+
+private:
+    struct Slot
+    {
+        uint64_t key  = 0;
+        int32_t  idx  = -1;
+        bool     used = false;
+    };
+
+    static uint64_t Key(int32_t profile, int32_t entrypoint)
+    {
+        return ((uint64_t)(uint32_t)profile << 32) | (uint32_t)entrypoint;
+    }
+
+    static uint32_t Hash(uint64_t key)
+    {
+        return (uint32_t)((key * 0x9e3779b97f4a7c15ull) >> (64 - m_hashBits));
+    }
+
+    static bool Insert(Slot *slots, uint64_t key, int32_t idx)
+    {
+        for (uint32_t i = Hash(key), n = 0; n < m_hashSize; i = (i + 1) & (m_hashSize - 1), n++)
+        {
+            if (!slots[i].used)
+            {
+                slots[i].key  = key;
+                slots[i].idx  = idx;
+                slots[i].used = true;
+                return true;
+            }
+            if (slots[i].key == key)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static int32_t Find(const Slot *slots, uint64_t key)
+    {
+        for (uint32_t i = Hash(key), n = 0; n < m_hashSize; i = (i + 1) & (m_hashSize - 1), n++)
+        {
+            if (!slots[i].used)
+            {
+                return -1;
+            }
+            if (slots[i].key == key)
+            {
+                return slots[i].idx;
+            }
+        }
+        return -1;
+    }
+
+    Slot                    m_entrySlots[m_hashSize];
+    Slot                    m_profileSlots[m_hashSize];
+    std::vector<int16_t>    m_configIdx[m_maxCodecTypes];
+    std::vector<uint32_t>   m_attribValues;             //!< Entry major, indexed by attribute type
+    std::vector<uint8_t>    m_attribValid;
+    uint32_t                m_attribTypeNum = 0;
+    uint32_t                m_entryNum      = 0;
+    bool                    m_valid         = false;
+};
+
+#endif // __MEDIA_LIBVA_CAPS_INDEX_H__
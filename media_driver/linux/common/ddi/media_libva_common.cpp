@@ -30,23 +30,21 @@
 #include "mos_interface.h"
 #include "media_libva_caps.h"
 
-static void* DdiMedia_GetVaContextFromHeap(PDDI_MEDIA_HEAP  mediaHeap, uint32_t index, PMEDIA_MUTEX_T mutex)
+static void* DdiMedia_GetVaContextFromHeap(PDDI_MEDIA_HEAP  mediaHeap, uint32_t index)
 {
     PDDI_MEDIA_VACONTEXT_HEAP_ELEMENT  vaCtxHeapElmt = nullptr;
-    void                              *context = nullptr;
 
-    DdiMediaUtil_LockMutex(mutex);
-    if(nullptr == mediaHeap || index >= mediaHeap->uiAllocatedHeapElements)
+    if(nullptr == mediaHeap)
+    {
+        return nullptr;
+    }
+    vaCtxHeapElmt  = (PDDI_MEDIA_VACONTEXT_HEAP_ELEMENT)DdiMediaUtil_GetHeapElement(mediaHeap, index);
+    if(nullptr == vaCtxHeapElmt)
     {
-        DdiMediaUtil_UnLockMutex(mutex);
         return nullptr;
     }
-    vaCtxHeapElmt  = (PDDI_MEDIA_VACONTEXT_HEAP_ELEMENT)mediaHeap->pHeapBase;
-    vaCtxHeapElmt += index;
-    context        = vaCtxHeapElmt->pVaContext;
-    DdiMediaUtil_UnLockMutex(mutex);
 
-    return context;
+    return __atomic_load_n(&vaCtxHeapElmt->pVaContext, __ATOMIC_ACQUIRE);
 }
 
 void DdiMedia_MediaSurfaceToMosResource(DDI_MEDIA_SURFACE *mediaSurface, MOS_RESOURCE  *mosResource)
@@ -93,33 +91,33 @@ void* DdiMedia_GetContextFromContextID (VADriverContextP ctx, VAContextID vaCtxI
         DDI_VERBOSEMESSAGE("Protected session detected: 0x%x", vaCtxID);
         *ctxType = DDI_MEDIA_CONTEXT_TYPE_PROTECTED;
         index = index & DDI_MEDIA_MASK_VAPROTECTEDSESSION_ID;
-        return DdiMedia_GetVaContextFromHeap(mediaCtx->pProtCtxHeap, index, &mediaCtx->ProtMutex);
+        return DdiMedia_GetVaContextFromHeap(mediaCtx->pProtCtxHeap, index);
     }
     else if ((vaCtxID&DDI_MEDIA_MASK_VACONTEXT_TYPE) == DDI_MEDIA_VACONTEXTID_OFFSET_DECODER)
     {
         DDI_VERBOSEMESSAGE("Decode context detected: 0x%x", vaCtxID);
         *ctxType = DDI_MEDIA_CONTEXT_TYPE_DECODER;
-        return DdiMedia_GetVaContextFromHeap(mediaCtx->pDecoderCtxHeap, index, &mediaCtx->DecoderMutex);
+        return DdiMedia_GetVaContextFromHeap(mediaCtx->pDecoderCtxHeap, index);
     }
     else if ((vaCtxID&DDI_MEDIA_MASK_VACONTEXT_TYPE) == DDI_MEDIA_VACONTEXTID_OFFSET_ENCODER)
     {
         *ctxType = DDI_MEDIA_CONTEXT_TYPE_ENCODER;
-        return DdiMedia_GetVaContextFromHeap(mediaCtx->pEncoderCtxHeap, index, &mediaCtx->EncoderMutex);
+        return DdiMedia_GetVaContextFromHeap(mediaCtx->pEncoderCtxHeap, index);
     }
     else if ((vaCtxID & DDI_MEDIA_MASK_VACONTEXT_TYPE) == DDI_MEDIA_VACONTEXTID_OFFSET_VP)
     {
         *ctxType = DDI_MEDIA_CONTEXT_TYPE_VP;
-        return DdiMedia_GetVaContextFromHeap(mediaCtx->pVpCtxHeap, index, &mediaCtx->VpMutex);
+        return DdiMedia_GetVaContextFromHeap(mediaCtx->pVpCtxHeap, index);
     }
     else if ((vaCtxID & DDI_MEDIA_MASK_VACONTEXT_TYPE) == DDI_MEDIA_VACONTEXTID_OFFSET_CM)
     {
         *ctxType = DDI_MEDIA_CONTEXT_TYPE_CM;
-        return DdiMedia_GetVaContextFromHeap(mediaCtx->pCmCtxHeap, index, &mediaCtx->CmMutex);
+        return DdiMedia_GetVaContextFromHeap(mediaCtx->pCmCtxHeap, index);
     }
     else if ((vaCtxID & DDI_MEDIA_MASK_VACONTEXT_TYPE) == DDI_MEDIA_VACONTEXTID_OFFSET_MFE)
     {
         *ctxType = DDI_MEDIA_CONTEXT_TYPE_MFE;
-        return DdiMedia_GetVaContextFromHeap(mediaCtx->pMfeCtxHeap, index, &mediaCtx->MfeMutex);
+        return DdiMedia_GetVaContextFromHeap(mediaCtx->pMfeCtxHeap, index);
     }
     else
     {
@@ -142,12 +140,9 @@ DDI_MEDIA_SURFACE* DdiMedia_GetSurfaceFromVASurfaceID (PDDI_MEDIA_CONTEXT mediaC
     bool validSurface = (i != VA_INVALID_SURFACE);
     if(validSurface)
     {
-        DDI_CHK_LESS(i, mediaCtx->pSurfaceHeap->uiAllocatedHeapElements, "invalid surface id", nullptr);
-        DdiMediaUtil_LockMutex(&mediaCtx->SurfaceMutex);
-        surfaceElement  = (PDDI_MEDIA_SURFACE_HEAP_ELEMENT)mediaCtx->pSurfaceHeap->pHeapBase;
-        surfaceElement += i;
-        surface         = surfaceElement->pSurface;
-        DdiMediaUtil_UnLockMutex(&mediaCtx->SurfaceMutex);
+        surfaceElement  = (PDDI_MEDIA_SURFACE_HEAP_ELEMENT)DdiMediaUtil_GetHeapElement(mediaCtx->pSurfaceHeap, i);
+        DDI_CHK_NULL(surfaceElement, "invalid surface id", nullptr);
+        surface         = __atomic_load_n(&surfaceElement->pSurface, __ATOMIC_ACQUIRE);
     }
 
     return surface;
@@ -157,14 +152,15 @@ VASurfaceID DdiMedia_GetVASurfaceIDFromSurface(PDDI_MEDIA_SURFACE surface)
 {
     DDI_CHK_NULL(surface, "nullptr surface", VA_INVALID_SURFACE);
 
-    PDDI_MEDIA_SURFACE_HEAP_ELEMENT  surfaceElement = (PDDI_MEDIA_SURFACE_HEAP_ELEMENT)surface->pMediaCtx->pSurfaceHeap->pHeapBase;
-    for(uint32_t i = 0; i < surface->pMediaCtx->pSurfaceHeap->uiAllocatedHeapElements; i ++)
+    PDDI_MEDIA_HEAP surfaceHeap = surface->pMediaCtx->pSurfaceHeap;
+    uint32_t        surfaceNum  = __atomic_load_n(&surfaceHeap->uiAllocatedHeapElements, __ATOMIC_ACQUIRE);
+    for(uint32_t i = 0; i < surfaceNum; i ++)
     {
-        if(surface == surfaceElement->pSurface)
+        PDDI_MEDIA_SURFACE_HEAP_ELEMENT surfaceElement = (PDDI_MEDIA_SURFACE_HEAP_ELEMENT)DdiMediaUtil_GetHeapElementByIndex(surfaceHeap, i);
+        if(surface == __atomic_load_n(&surfaceElement->pSurface, __ATOMIC_ACQUIRE))
         {
             return surfaceElement->uiVaSurfaceID;
         }
-        surfaceElement ++;
     }
     return VA_INVALID_SURFACE;
 }
@@ -173,7 +169,7 @@ PDDI_MEDIA_SURFACE DdiMedia_ReplaceSurfaceWithNewFormat(PDDI_MEDIA_SURFACE surfa
 {
     DDI_CHK_NULL(surface, "nullptr surface", nullptr);
 
-    PDDI_MEDIA_SURFACE_HEAP_ELEMENT  surfaceElement = (PDDI_MEDIA_SURFACE_HEAP_ELEMENT)surface->pMediaCtx->pSurfaceHeap->pHeapBase;
+    PDDI_MEDIA_SURFACE_HEAP_ELEMENT  surfaceElement = nullptr;
     PDDI_MEDIA_CONTEXT mediaCtx = surface->pMediaCtx;
 
     //check some conditions
@@ -183,11 +179,6 @@ PDDI_MEDIA_SURFACE DdiMedia_ReplaceSurfaceWithNewFormat(PDDI_MEDIA_SURFACE surfa
     }
     //create new dst surface and copy the structure
     PDDI_MEDIA_SURFACE dstSurface = (DDI_MEDIA_SURFACE *)MOS_AllocAndZeroMemory(sizeof(DDI_MEDIA_SURFACE));
-    if (nullptr == surfaceElement)
-    {
-        MOS_FreeMemory(dstSurface);
-        return nullptr;
-    }
 
     MOS_SecureMemcpy(dstSurface,sizeof(DDI_MEDIA_SURFACE),surface,sizeof(DDI_MEDIA_SURFACE));
     DDI_CHK_NULL(dstSurface, "nullptr dstSurface", nullptr);
@@ -201,11 +192,11 @@ PDDI_MEDIA_SURFACE DdiMedia_ReplaceSurfaceWithNewFormat(PDDI_MEDIA_SURFACE surfa
     //get current element heap and index
     for(i = 0; i < mediaCtx->pSurfaceHeap->uiAllocatedHeapElements; i ++)
     {
+        surfaceElement = (PDDI_MEDIA_SURFACE_HEAP_ELEMENT)DdiMediaUtil_GetHeapElementByIndex(mediaCtx->pSurfaceHeap, i);
         if(surface == surfaceElement->pSurface)
         {
             break;
         }
-        surfaceElement ++;
     }
     //if cant find
     if(i == surface->pMediaCtx->pSurfaceHeap->uiAllocatedHeapElements)
@@ -246,16 +237,11 @@ PDDI_MEDIA_SURFACE DdiMedia_ReplaceSurfaceWithVariant(PDDI_MEDIA_SURFACE surface
         return nullptr;
     }
 
-    DdiMediaUtil_LockMutex(&mediaCtx->BufferMutex);
-    PDDI_MEDIA_SURFACE_HEAP_ELEMENT  surfaceElement = (PDDI_MEDIA_SURFACE_HEAP_ELEMENT)surface->pMediaCtx->pSurfaceHeap->pHeapBase;
-    DdiMediaUtil_UnLockMutex(&mediaCtx->BufferMutex);
+    PDDI_MEDIA_SURFACE_HEAP_ELEMENT  surfaceElement = (PDDI_MEDIA_SURFACE_HEAP_ELEMENT)DdiMediaUtil_GetHeapElement(mediaCtx->pSurfaceHeap, vaID);
     if (nullptr == surfaceElement)
     {
         return nullptr;
     }
-    DdiMediaUtil_LockMutex(&mediaCtx->BufferMutex);
-    surfaceElement += vaID;
-    DdiMediaUtil_UnLockMutex(&mediaCtx->BufferMutex);
 
     aligned_format = surface->format;
     switch (surface->format)
@@ -321,9 +307,7 @@ PDDI_MEDIA_SURFACE DdiMedia_ReplaceSurfaceWithVariant(PDDI_MEDIA_SURFACE surface
     }
     //replace the surface
     DdiMediaUtil_LockMutex(&mediaCtx->BufferMutex);
-    surfaceElement = (PDDI_MEDIA_SURFACE_HEAP_ELEMENT)surface->pMediaCtx->pSurfaceHeap->pHeapBase;
-    surfaceElement += vaID;
-    surfaceElement->pSurface = dstSurface;
+    __atomic_store_n(&surfaceElement->pSurface, dstSurface, __ATOMIC_RELEASE);
     DdiMediaUtil_UnLockMutex(&mediaCtx->BufferMutex);
     //FreeSurface
     DdiMediaUtil_FreeSurface(surface);
@@ -339,12 +323,9 @@ DDI_MEDIA_BUFFER* DdiMedia_GetBufferFromVABufferID (PDDI_MEDIA_CONTEXT mediaCtx,
     PDDI_MEDIA_BUFFER              buf = nullptr;
 
     i                = (uint32_t)bufferID;
-    DDI_CHK_LESS(i, mediaCtx->pBufferHeap->uiAllocatedHeapElements, "invalid buffer id", nullptr);
-    DdiMediaUtil_LockMutex(&mediaCtx->BufferMutex);
-    bufHeapElement  = (PDDI_MEDIA_BUFFER_HEAP_ELEMENT)mediaCtx->pBufferHeap->pHeapBase;
-    bufHeapElement += i;
-    buf             = bufHeapElement->pBuffer;
-    DdiMediaUtil_UnLockMutex(&mediaCtx->BufferMutex);
+    bufHeapElement  = (PDDI_MEDIA_BUFFER_HEAP_ELEMENT)DdiMediaUtil_GetHeapElement(mediaCtx->pBufferHeap, i);
+    DDI_CHK_NULL(bufHeapElement, "invalid buffer id", nullptr);
+    buf             = __atomic_load_n(&bufHeapElement->pBuffer, __ATOMIC_ACQUIRE);
 
     return buf;
 }
@@ -365,12 +346,9 @@ void* DdiMedia_GetContextFromVABufferID (PDDI_MEDIA_CONTEXT mediaCtx, VABufferID
     void *                         ctx;
 
     i                = (uint32_t)bufferID;
-    DDI_CHK_LESS(i, mediaCtx->pBufferHeap->uiAllocatedHeapElements, "invalid buffer id", nullptr);
-    DdiMediaUtil_LockMutex(&mediaCtx->BufferMutex);
-    bufHeapElement  = (PDDI_MEDIA_BUFFER_HEAP_ELEMENT)mediaCtx->pBufferHeap->pHeapBase;
-    bufHeapElement += bufferID;
+    bufHeapElement  = (PDDI_MEDIA_BUFFER_HEAP_ELEMENT)DdiMediaUtil_GetHeapElement(mediaCtx->pBufferHeap, i);
+    DDI_CHK_NULL(bufHeapElement, "invalid buffer id", nullptr);
     ctx            = bufHeapElement->pCtx;
-    DdiMediaUtil_UnLockMutex(&mediaCtx->BufferMutex);
 
     return ctx;
 }
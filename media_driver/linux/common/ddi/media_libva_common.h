@@ -95,6 +95,16 @@ static int32_t atrace_switch            = 0;
 
 // heap
 #define DDI_MEDIA_HEAP_INCREMENTAL_SIZE      8
+#define DDI_MEDIA_HEAP_SEGMENT_NUM           17      // segment n holds DDI_MEDIA_HEAP_INCREMENTAL_SIZE << n elements
+#define DDI_MEDIA_HEAP_INDEX_BITS            20
+#define DDI_MEDIA_HEAP_INDEX_MASK            ((1u << DDI_MEDIA_HEAP_INDEX_BITS) - 1)
+// Generation bits of the IDs, bumped on each release of the element. A stale ID is
+// accepted again only after 2048 (surface, buffer, image) or 128 (context) reuses of
+// its element; context IDs keep bits 27..31 for the context type and protected
+// session flag, and contexts are created far less often than the other objects.
+#define DDI_MEDIA_HEAP_GENERATION_MASK       0x7FF00000      // bit 31 stays clear, no ID equals VA_INVALID_ID
+#define DDI_MEDIA_HEAP_CTX_GENERATION_MASK   0x07F00000      // below context type and protected session flag bits
+#define DDI_MEDIA_HEAP_ID_INDEX(id)          ((uint32_t)(id) & DDI_MEDIA_HEAP_INDEX_MASK)
 
 #define DDI_MEDIA_VACONTEXTID_OFFSET_DECODER       0x10000000
 #define DDI_MEDIA_VACONTEXTID_OFFSET_ENCODER       0x20000000
@@ -124,6 +134,8 @@ static int32_t atrace_switch            = 0;
 
 #define DDI_MEDIA_MAX_COLOR_PLANES                 4       //Maximum color planes supported by media driver, like (A/R/G/B in different planes)
 
+#define DDI_MEDIA_STAGING_BUFFER_NUM               2       //Cached de-swizzle staging buffers per media context
+
 typedef pthread_mutex_t  MEDIA_MUTEX_T, *PMEDIA_MUTEX_T;
 #define MEDIA_MUTEX_INITIALIZER  PTHREAD_MUTEX_INITIALIZER
 
@@ -323,6 +335,7 @@ typedef struct _DDI_MEDIA_SURFACE
     _DDI_MEDIA_BUFFER       *pShadowBuffer;
 
     uint32_t                uiMapFlag;
+    bool                    bMapWC;                   // pData is a write combined mapping, slow to read with plain loads
 
     uint32_t                uiVariantFlag;
     int                     memType;
@@ -359,42 +372,61 @@ typedef struct _DDI_MEDIA_BUFFER
     PDDI_MEDIA_CONTEXT     pMediaCtx         = nullptr; // Media driver Context
 } DDI_MEDIA_BUFFER, *PDDI_MEDIA_BUFFER;
 
+//!
+//! \brief  Common head of all heap elements
+//! \details    VA IDs are the element index in the heap plus a generation
+//!             which changes each time the element is released, so stale IDs
+//!             are rejected by DdiMediaUtil_GetHeapElement.
+//!
+typedef struct _DDI_MEDIA_HEAP_ELEMENT
+{
+    uint32_t                                uiVaID;
+    uint32_t                                uiNextFree;     // index + 1 of next free element, 0 for none
+}DDI_MEDIA_HEAP_ELEMENT, *PDDI_MEDIA_HEAP_ELEMENT;
+
 typedef struct _DDI_MEDIA_SURFACE_HEAP_ELEMENT
 {
-    PDDI_MEDIA_SURFACE                      pSurface;
     uint32_t                                uiVaSurfaceID;
-    struct _DDI_MEDIA_SURFACE_HEAP_ELEMENT *pNextFree;
+    uint32_t                                uiNextFree;
+    PDDI_MEDIA_SURFACE                      pSurface;
 }DDI_MEDIA_SURFACE_HEAP_ELEMENT, *PDDI_MEDIA_SURFACE_HEAP_ELEMENT;
 
 typedef struct _DDI_MEDIA_BUFFER_HEAP_ELEMENT
 {
+    uint32_t                                uiVaBufferID;
+    uint32_t                                uiNextFree;
     PDDI_MEDIA_BUFFER                       pBuffer;
     void                                   *pCtx;
     uint32_t                                uiCtxType;
-    uint32_t                                uiVaBufferID;
-    struct _DDI_MEDIA_BUFFER_HEAP_ELEMENT  *pNextFree;
 }DDI_MEDIA_BUFFER_HEAP_ELEMENT, *PDDI_MEDIA_BUFFER_HEAP_ELEMENT;
 
 typedef struct _DDI_MEDIA_IMAGE_HEAP_ELEMENT
 {
-    VAImage                                *pImage;
     uint32_t                                uiVaImageID;
-    struct _DDI_MEDIA_IMAGE_HEAP_ELEMENT   *pNextFree;
+    uint32_t                                uiNextFree;
+    VAImage                                *pImage;
 }DDI_MEDIA_IMAGE_HEAP_ELEMENT, *PDDI_MEDIA_IMAGE_HEAP_ELEMENT;
 
 typedef struct _DDI_MEDIA_VACONTEXT_HEAP_ELEMENT
 {
-    void                                       *pVaContext;
     uint32_t                                    uiVaContextID;
-    struct _DDI_MEDIA_VACONTEXT_HEAP_ELEMENT   *pNextFree;
+    uint32_t                                    uiNextFree;
+    void                                       *pVaContext;
 }DDI_MEDIA_VACONTEXT_HEAP_ELEMENT, *PDDI_MEDIA_VACONTEXT_HEAP_ELEMENT;
 
+//!
+//! \brief  Heap of VA objects
+//! \details    Elements live in segments which are never moved or freed before
+//!             the heap is destroyed, so lookups need no lock. Alloc and release
+//!             use a lock-free free list.
+//!
 typedef struct _DDI_MEDIA_HEAP
 {
-    void               *pHeapBase;
+    void               *pHeapSegments[DDI_MEDIA_HEAP_SEGMENT_NUM];
     uint32_t            uiHeapElementSize;
+    uint32_t            uiGenerationMask;           // DDI_MEDIA_HEAP_GENERATION_MASK or DDI_MEDIA_HEAP_CTX_GENERATION_MASK
     uint32_t            uiAllocatedHeapElements;
-    void               *pFirstFreeHeapElement;
+    uint64_t            uiFirstFreeHeapElement;     // ABA tag << 32 | index + 1
 }DDI_MEDIA_HEAP, *PDDI_MEDIA_HEAP;
 
 #ifndef ANDROID
@@ -412,6 +444,8 @@ typedef struct _DDI_X11_FUNC_TABLE
 }DDI_X11_FUNC_TABLE, *PDDI_X11_FUNC_TABLE;
 #endif
 
+struct DDI_MEDIA_COPY_WORKERS;
+
 //!
 //! \struct DDI_MEDIA_CONTEXT
 //! \brief  Media heap for shared internal structures
@@ -481,6 +515,12 @@ struct DDI_MEDIA_CONTEXT
     MEDIA_MUTEX_T       ProtMutex;
     MEDIA_MUTEX_T       CmMutex;
     MEDIA_MUTEX_T       MfeMutex;
+    MEDIA_MUTEX_T       CopyMutex;
+
+    // staging buffers and row band workers for vaGetImage/vaPutImage CPU copies
+    void               *pStagingBuf[DDI_MEDIA_STAGING_BUFFER_NUM];
+    uint32_t            uiStagingBufSize[DDI_MEDIA_STAGING_BUFFER_NUM];
+    DDI_MEDIA_COPY_WORKERS *pCopyWorkers;
 
     // GT system Info
     MEDIA_SYSTEM_INFO  *pGtSystemInfo;
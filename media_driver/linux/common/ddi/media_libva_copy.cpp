@@ -0,0 +1,250 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     media_libva_copy.cpp
+//! \brief    Plane copies of vaGetImage, split into row bands over the copy
+//!           workers of media context
+//!
+
+#include <algorithm>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <system_error>
+
+#include "media_libva_util.h"
+#include "cm_mem.h"
+
+// planes smaller than this are copied by the calling thread only
+#define DDI_MEDIA_COPY_BAND_MIN_SIZE    (4 * 1024 * 1024)
+#define DDI_MEDIA_COPY_WORKER_MAX       3
+
+//!
+//! \brief  Rows of a plane copied by one thread
+//!
+struct DDI_MEDIA_COPY_BAND
+{
+    uint8_t       *dst;
+    uint32_t       dstPitch;
+    const uint8_t *src;
+    uint32_t       srcPitch;
+    uint32_t       rowSize;
+    uint32_t       height;
+    bool           srcUncached;
+};
+
+//!
+//! \brief  Worker threads copying row bands for DdiMediaUtil_CopyPlane
+//!
+struct DDI_MEDIA_COPY_WORKERS
+{
+    std::mutex              submitMutex;    // one banded copy at a time, other callers copy serially
+    std::mutex              jobMutex;
+    std::condition_variable jobCond;
+    std::condition_variable doneCond;
+    DDI_MEDIA_COPY_BAND     bands[DDI_MEDIA_COPY_WORKER_MAX];
+    uint64_t                jobId;
+    uint32_t                pending;
+    uint32_t                workerNum;
+    bool                    exit;
+    std::thread             threads[DDI_MEDIA_COPY_WORKER_MAX];
+};
+
+static void DdiMediaUtil_CopyBand(const DDI_MEDIA_COPY_BAND &band)
+{
+    static const CPU_INSTRUCTION_LEVEL cpuInstructionLevel = GetCpuInstructionLevel();
+
+    uint8_t       *dst = band.dst;
+    const uint8_t *src = band.src;
+    if (band.height == 0)
+    {
+        return;
+    }
+
+    // contiguous rows can go as one copy
+    uint32_t rowSize = band.rowSize;
+    uint32_t height  = band.height;
+    if (band.dstPitch == band.srcPitch && rowSize == band.srcPitch)
+    {
+        rowSize *= height;
+        height   = 1;
+    }
+
+    for (uint32_t y = 0; y < height; y++)
+    {
+        if (band.srcUncached)
+        {
+            CmFastMemCopyFromWC(dst, src, rowSize, cpuInstructionLevel);
+        }
+        else
+        {
+            memcpy(dst, src, rowSize);
+        }
+        dst += band.dstPitch;
+        src += band.srcPitch;
+    }
+}
+
+static void DdiMediaUtil_CopyWorkerLoop(DDI_MEDIA_COPY_WORKERS *workers, uint32_t index)
+{
+    uint64_t lastJob = 0;
+    std::unique_lock<std::mutex> lock(workers->jobMutex);
+    while (true)
+    {
+        workers->jobCond.wait(lock, [&] { return workers->exit || workers->jobId != lastJob; });
+        if (workers->exit)
+        {
+            return;
+        }
+        lastJob = workers->jobId;
+        DDI_MEDIA_COPY_BAND band = workers->bands[index];
+
+        lock.unlock();
+        DdiMediaUtil_CopyBand(band);
+        lock.lock();
+
+        if (--workers->pending == 0)
+        {
+            workers->doneCond.notify_one();
+        }
+    }
+}
+
+static void DdiMediaUtil_JoinCopyWorkers(DDI_MEDIA_COPY_WORKERS *workers, uint32_t started)
+{
+    {
+        std::lock_guard<std::mutex> lock(workers->jobMutex);
+        workers->exit = true;
+    }
+    workers->jobCond.notify_all();
+    for (uint32_t i = 0; i < started; i++)
+    {
+        workers->threads[i].join();
+    }
+    MOS_Delete(workers);
+}
+
+VAStatus DdiMediaUtil_StartCopyWorkers(PDDI_MEDIA_CONTEXT mediaCtx, uint32_t workerNum)
+{
+    DDI_CHK_NULL(mediaCtx, "nullptr mediaCtx", VA_STATUS_ERROR_INVALID_CONTEXT);
+
+    mediaCtx->pCopyWorkers = nullptr;
+
+    workerNum = std::min<uint32_t>(workerNum, DDI_MEDIA_COPY_WORKER_MAX);
+    if (workerNum == 0)
+    {
+        return VA_STATUS_SUCCESS;
+    }
+
+    DDI_MEDIA_COPY_WORKERS *workers = MOS_New(DDI_MEDIA_COPY_WORKERS);
+    DDI_CHK_NULL(workers, "nullptr workers", VA_STATUS_ERROR_ALLOCATION_FAILED);
+    workers->jobId     = 0;
+    workers->pending   = 0;
+    workers->exit      = false;
+    workers->workerNum = workerNum;
+
+    uint32_t started = 0;
+    try
+    {
+        for (; started < workers->workerNum; started++)
+        {
+            workers->threads[started] = std::thread(DdiMediaUtil_CopyWorkerLoop, workers, started);
+        }
+    }
+    catch (const std::system_error &)
+    {
+        DDI_NORMALMESSAGE("Failed to create copy worker, copy planes serially.");
+        DdiMediaUtil_JoinCopyWorkers(workers, started);
+        return VA_STATUS_SUCCESS;
+    }
+
+    mediaCtx->pCopyWorkers = workers;
+    return VA_STATUS_SUCCESS;
+}
+
+void DdiMediaUtil_CopyPlane(
+    PDDI_MEDIA_CONTEXT mediaCtx,
+    uint8_t           *dst,
+    uint32_t           dstPitch,
+    const uint8_t     *src,
+    uint32_t           srcPitch,
+    uint32_t           height,
+    bool               srcUncached)
+{
+    DDI_MEDIA_COPY_BAND band = {dst, dstPitch, src, srcPitch, std::min(dstPitch, srcPitch), height, srcUncached};
+
+    // workers live as long as the media context, see DdiMediaUtil_InitCopyWorkers
+    DDI_MEDIA_COPY_WORKERS *workers = nullptr;
+    if (mediaCtx != nullptr && (uint64_t)band.rowSize * height >= DDI_MEDIA_COPY_BAND_MIN_SIZE)
+    {
+        workers = mediaCtx->pCopyWorkers;
+    }
+    if (workers == nullptr || !workers->submitMutex.try_lock())
+    {
+        DdiMediaUtil_CopyBand(band);
+        return;
+    }
+
+    // the calling thread copies the last band itself
+    uint32_t bandNum    = workers->workerNum + 1;
+    uint32_t bandHeight = (height + bandNum - 1) / bandNum;
+    DDI_MEDIA_COPY_BAND bands[DDI_MEDIA_COPY_WORKER_MAX + 1];
+    for (uint32_t i = 0; i < bandNum; i++)
+    {
+        uint32_t start  = std::min(i * bandHeight, height);
+        bands[i]        = band;
+        bands[i].dst    = dst + (size_t)start * dstPitch;
+        bands[i].src    = src + (size_t)start * srcPitch;
+        bands[i].height = std::min(bandHeight, height - start);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(workers->jobMutex);
+        for (uint32_t i = 0; i < workers->workerNum; i++)
+        {
+            workers->bands[i] = bands[i];
+        }
+        workers->pending = workers->workerNum;
+        workers->jobId++;
+    }
+    workers->jobCond.notify_all();
+
+    DdiMediaUtil_CopyBand(bands[workers->workerNum]);
+
+    {
+        std::unique_lock<std::mutex> lock(workers->jobMutex);
+        workers->doneCond.wait(lock, [&] { return workers->pending == 0; });
+    }
+    workers->submitMutex.unlock();
+}
+
+void DdiMediaUtil_StopCopyWorkers(PDDI_MEDIA_CONTEXT mediaCtx)
+{
+    DDI_CHK_NULL(mediaCtx, "nullptr mediaCtx", );
+
+    DDI_MEDIA_COPY_WORKERS *workers = mediaCtx->pCopyWorkers;
+    mediaCtx->pCopyWorkers = nullptr;
+    if (workers != nullptr)
+    {
+        DdiMediaUtil_JoinCopyWorkers(workers, workers->workerNum);
+    }
+}
@@ -34,6 +34,7 @@
 #include <fcntl.h>
 #include <dlfcn.h>
 #include <errno.h>
+#include <thread>
 
 #include "media_libva_util.h"
 #include "mos_utilities.h"
@@ -1273,15 +1274,21 @@ void* DdiMediaUtil_LockSurfaceInternal(DDI_MEDIA_SURFACE  *surface, uint32_t fla
     surface->uiMapFlag = flag;
     if (surface->pShadowBuffer)
     {
-        surface->pData = (uint8_t *)surface->pShadowBuffer->bo->virt;
+        surface->pData  = (uint8_t *)surface->pShadowBuffer->bo->virt;
+        surface->bMapWC = true;    // local memory is mapped write combined
     }
     else if (surface->pSystemShadow)
     {
-        surface->pData = surface->pSystemShadow;
+        surface->pData  = surface->pSystemShadow;
+        surface->bMapWC = false;
     }
     else
     {
-        surface->pData = (uint8_t*) surface->bo->virt;
+        surface->pData  = (uint8_t*) surface->bo->virt;
+        // GTT mappings are write combined, mos_bo_map is cached unless the bo is in local memory
+        surface->bMapWC = surface->pMediaCtx->bIsAtomSOC ||
+                          MEDIA_IS_SKU(&surface->pMediaCtx->SkuTable, FtrLocalMemory) ||
+                          (surface->TileType != I915_TILING_NONE && !(flag & MOS_LOCKFLAG_NO_SWIZZLE));
     }
     surface->data_size = surface->bo->size;
     surface->bMapped = true;
@@ -1622,37 +1629,194 @@ void DdiMediaUtil_PostSemaphore(PMEDIA_SEM_T  sem)
 }
 
 // heap related
-PDDI_MEDIA_SURFACE_HEAP_ELEMENT DdiMediaUtil_AllocPMediaSurfaceFromHeap(PDDI_MEDIA_HEAP surfaceHeap)
+//!
+//! \brief  Get segment and offset of a heap element index
+//! \details    Segment n holds DDI_MEDIA_HEAP_INCREMENTAL_SIZE << n elements and
+//!             starts at index DDI_MEDIA_HEAP_INCREMENTAL_SIZE * (2^n - 1).
+//!
+static inline uint32_t DdiMediaUtil_HeapSegment(uint32_t index, uint32_t *offset)
 {
-    DDI_CHK_NULL(surfaceHeap, "nullptr surfaceHeap", nullptr);
+    uint32_t biased  = index + DDI_MEDIA_HEAP_INCREMENTAL_SIZE;
+    uint32_t segment = (31 - __builtin_clz(biased)) - (31 - __builtin_clz(DDI_MEDIA_HEAP_INCREMENTAL_SIZE));
+    *offset          = biased - (DDI_MEDIA_HEAP_INCREMENTAL_SIZE << segment);
+    return segment;
+}
+
+static inline PDDI_MEDIA_HEAP_ELEMENT DdiMediaUtil_HeapElementAt(PDDI_MEDIA_HEAP heap, uint32_t index)
+{
+    uint32_t offset  = 0;
+    uint32_t segment = DdiMediaUtil_HeapSegment(index, &offset);
+    if (segment >= DDI_MEDIA_HEAP_SEGMENT_NUM)
+    {
+        return nullptr;
+    }
+    uint8_t *base    = (uint8_t *)__atomic_load_n(&heap->pHeapSegments[segment], __ATOMIC_ACQUIRE);
+    if (base == nullptr)
+    {
+        return nullptr;
+    }
+    return (PDDI_MEDIA_HEAP_ELEMENT)(base + (size_t)offset * heap->uiHeapElementSize);
+}
+
+void* DdiMediaUtil_GetHeapElementByIndex(PDDI_MEDIA_HEAP heap, uint32_t index)
+{
+    DDI_CHK_NULL(heap, "nullptr heap", nullptr);
+    return DdiMediaUtil_HeapElementAt(heap, index);
+}
+
+void* DdiMediaUtil_GetHeapElement(PDDI_MEDIA_HEAP heap, uint32_t vaID)
+{
+    PDDI_MEDIA_HEAP_ELEMENT element = (PDDI_MEDIA_HEAP_ELEMENT)DdiMediaUtil_GetHeapElementByIndex(heap, DDI_MEDIA_HEAP_ID_INDEX(vaID));
+    if (element == nullptr || __atomic_load_n(&element->uiVaID, __ATOMIC_ACQUIRE) != vaID)
+    {
+        return nullptr;
+    }
+    return element;
+}
 
-    PDDI_MEDIA_SURFACE_HEAP_ELEMENT  mediaSurfaceHeapElmt = nullptr;
+//!
+//! \brief  Push the element chain [first, last] to the heap free list
+//!
+static void DdiMediaUtil_PushFreeHeapElements(PDDI_MEDIA_HEAP heap, PDDI_MEDIA_HEAP_ELEMENT first, PDDI_MEDIA_HEAP_ELEMENT last)
+{
+    uint64_t head = __atomic_load_n(&heap->uiFirstFreeHeapElement, __ATOMIC_RELAXED);
+    uint64_t next = 0;
+    do
+    {
+        __atomic_store_n(&last->uiNextFree, (uint32_t)head, __ATOMIC_RELAXED);
+        next = ((head >> 32) + 1) << 32 | (DDI_MEDIA_HEAP_ID_INDEX(first->uiVaID) + 1);
+    } while (!__atomic_compare_exchange_n(&heap->uiFirstFreeHeapElement, &head, next, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+}
+
+//!
+//! \brief  Add the next segment to the heap
+//!
+//! \return PDDI_MEDIA_HEAP_ELEMENT
+//!     First element of the new segment, owned by the caller; nullptr if
+//!     another thread grew the heap meanwhile or the heap is full
+//!
+static PDDI_MEDIA_HEAP_ELEMENT DdiMediaUtil_GrowHeap(PDDI_MEDIA_HEAP heap, bool *full)
+{
+    uint32_t allocated = __atomic_load_n(&heap->uiAllocatedHeapElements, __ATOMIC_ACQUIRE);
+    uint32_t offset    = 0;
+    uint32_t segment   = DdiMediaUtil_HeapSegment(allocated, &offset);
+    if (segment >= DDI_MEDIA_HEAP_SEGMENT_NUM)
+    {
+        *full = true;
+        return nullptr;
+    }
+    if (__atomic_load_n(&heap->pHeapSegments[segment], __ATOMIC_ACQUIRE) != nullptr)
+    {
+        return nullptr;
+    }
 
-    if (nullptr == surfaceHeap->pFirstFreeHeapElement)
+    uint32_t count = DDI_MEDIA_HEAP_INCREMENTAL_SIZE << segment;
+    uint8_t *base  = (uint8_t *)MOS_AllocAndZeroMemory((size_t)count * heap->uiHeapElementSize);
+    if (base == nullptr)
+    {
+        *full = true;
+        return nullptr;
+    }
+    for (uint32_t i = 0; i < count; i++)
     {
-        void *newHeapBase = MOS_ReallocMemory(surfaceHeap->pHeapBase, (surfaceHeap->uiAllocatedHeapElements + DDI_MEDIA_HEAP_INCREMENTAL_SIZE) * sizeof(DDI_MEDIA_SURFACE_HEAP_ELEMENT));
+        PDDI_MEDIA_HEAP_ELEMENT element = (PDDI_MEDIA_HEAP_ELEMENT)(base + (size_t)i * heap->uiHeapElementSize);
+        element->uiVaID     = allocated + i;
+        element->uiNextFree = (i == count - 1) ? 0 : allocated + i + 2;
+    }
 
-        if (nullptr == newHeapBase)
+    void *expected = nullptr;
+    if (!__atomic_compare_exchange_n(&heap->pHeapSegments[segment], &expected, (void *)base, false, __ATOMIC_RELEASE, __ATOMIC_ACQUIRE))
+    {
+        MOS_FreeMemory(base);
+        return nullptr;
+    }
+    // publish the free elements before the new size, so other allocators wait
+    // for them instead of growing the heap once more
+    if (count > 1)
+    {
+        DdiMediaUtil_PushFreeHeapElements(
+            heap,
+            (PDDI_MEDIA_HEAP_ELEMENT)(base + heap->uiHeapElementSize),
+            (PDDI_MEDIA_HEAP_ELEMENT)(base + (size_t)(count - 1) * heap->uiHeapElementSize));
+    }
+    __atomic_store_n(&heap->uiAllocatedHeapElements, allocated + count, __ATOMIC_RELEASE);
+    return (PDDI_MEDIA_HEAP_ELEMENT)base;
+}
+
+static PDDI_MEDIA_HEAP_ELEMENT DdiMediaUtil_AllocHeapElement(PDDI_MEDIA_HEAP heap)
+{
+    while (true)
+    {
+        uint64_t head = __atomic_load_n(&heap->uiFirstFreeHeapElement, __ATOMIC_ACQUIRE);
+        uint32_t first = (uint32_t)head;
+        if (first != 0)
         {
-            DDI_ASSERTMESSAGE("DDI: realloc failed.");
-            return nullptr;
+            // elements are never freed, reading a stale next link is harmless as the tag check fails
+            PDDI_MEDIA_HEAP_ELEMENT element = DdiMediaUtil_HeapElementAt(heap, first - 1);
+            uint64_t next = ((head >> 32) + 1) << 32 | __atomic_load_n(&element->uiNextFree, __ATOMIC_RELAXED);
+            if (__atomic_compare_exchange_n(&heap->uiFirstFreeHeapElement, &head, next, true, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+            {
+                return element;
+            }
+            continue;
+        }
+
+        bool full = false;
+        PDDI_MEDIA_HEAP_ELEMENT element = DdiMediaUtil_GrowHeap(heap, &full);
+        if (element != nullptr)
+        {
+            return element;
         }
-        surfaceHeap->pHeapBase                    = newHeapBase;
-        PDDI_MEDIA_SURFACE_HEAP_ELEMENT surfaceHeapBase  = (PDDI_MEDIA_SURFACE_HEAP_ELEMENT)surfaceHeap->pHeapBase;
-        surfaceHeap->pFirstFreeHeapElement        = (void*)(&surfaceHeapBase[surfaceHeap->uiAllocatedHeapElements]);
-        for (int32_t i = 0; i < (DDI_MEDIA_HEAP_INCREMENTAL_SIZE); i++)
+        if (full)
         {
-            mediaSurfaceHeapElmt                  = &surfaceHeapBase[surfaceHeap->uiAllocatedHeapElements + i];
-            mediaSurfaceHeapElmt->pNextFree       = (i == (DDI_MEDIA_HEAP_INCREMENTAL_SIZE - 1))? nullptr : &surfaceHeapBase[surfaceHeap->uiAllocatedHeapElements + i + 1];
-            mediaSurfaceHeapElmt->uiVaSurfaceID   = surfaceHeap->uiAllocatedHeapElements + i;
+            DDI_ASSERTMESSAGE("DDI: heap is full.");
+            return nullptr;
         }
-        surfaceHeap->uiAllocatedHeapElements     += DDI_MEDIA_HEAP_INCREMENTAL_SIZE;
     }
+}
 
-    mediaSurfaceHeapElmt                          = (PDDI_MEDIA_SURFACE_HEAP_ELEMENT)surfaceHeap->pFirstFreeHeapElement;
-    surfaceHeap->pFirstFreeHeapElement            = mediaSurfaceHeapElmt->pNextFree;
+//!
+//! \brief  Retire vaID and put its element back to the free list
+//!
+//! \return bool
+//!     false if vaID is invalid or already released
+//!
+static bool DdiMediaUtil_ReleaseHeapElement(PDDI_MEDIA_HEAP heap, uint32_t vaID)
+{
+    PDDI_MEDIA_HEAP_ELEMENT element = (PDDI_MEDIA_HEAP_ELEMENT)DdiMediaUtil_GetHeapElement(heap, vaID);
+    if (element == nullptr)
+    {
+        return false;
+    }
 
-    return mediaSurfaceHeapElmt;
+    uint32_t generation = (vaID & heap->uiGenerationMask) + (1u << DDI_MEDIA_HEAP_INDEX_BITS);
+    uint32_t retiredID  = DDI_MEDIA_HEAP_ID_INDEX(vaID) | (generation & heap->uiGenerationMask);
+    if (!__atomic_compare_exchange_n(&element->uiVaID, &vaID, retiredID, false, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED))
+    {
+        return false;
+    }
+
+    DdiMediaUtil_PushFreeHeapElements(heap, element, element);
+    return true;
+}
+
+void DdiMediaUtil_FreeHeapSegments(PDDI_MEDIA_HEAP heap)
+{
+    DDI_CHK_NULL(heap, "nullptr heap", );
+    for (uint32_t i = 0; i < DDI_MEDIA_HEAP_SEGMENT_NUM; i++)
+    {
+        MOS_FreeMemory(heap->pHeapSegments[i]);
+        heap->pHeapSegments[i] = nullptr;
+    }
+    heap->uiAllocatedHeapElements = 0;
+    heap->uiFirstFreeHeapElement  = 0;
+}
+
+PDDI_MEDIA_SURFACE_HEAP_ELEMENT DdiMediaUtil_AllocPMediaSurfaceFromHeap(PDDI_MEDIA_HEAP surfaceHeap)
+{
+    DDI_CHK_NULL(surfaceHeap, "nullptr surfaceHeap", nullptr);
+
+    return (PDDI_MEDIA_SURFACE_HEAP_ELEMENT)DdiMediaUtil_AllocHeapElement(surfaceHeap);
 }
 
 
@@ -1660,16 +1824,11 @@ void DdiMediaUtil_ReleasePMediaSurfaceFromHeap(PDDI_MEDIA_HEAP surfaceHeap, uint
 {
     DDI_CHK_NULL(surfaceHeap, "nullptr surfaceHeap", );
 
-    DDI_CHK_LESS(vaSurfaceID, surfaceHeap->uiAllocatedHeapElements, "invalid surface id", );
-    PDDI_MEDIA_SURFACE_HEAP_ELEMENT mediaSurfaceHeapBase                   = (PDDI_MEDIA_SURFACE_HEAP_ELEMENT)surfaceHeap->pHeapBase;
-    DDI_CHK_NULL(mediaSurfaceHeapBase, "nullptr mediaSurfaceHeapBase", );
-
-    PDDI_MEDIA_SURFACE_HEAP_ELEMENT mediaSurfaceHeapElmt                   = &mediaSurfaceHeapBase[vaSurfaceID];
+    PDDI_MEDIA_SURFACE_HEAP_ELEMENT mediaSurfaceHeapElmt = (PDDI_MEDIA_SURFACE_HEAP_ELEMENT)DdiMediaUtil_GetHeapElement(surfaceHeap, vaSurfaceID);
+    DDI_CHK_NULL(mediaSurfaceHeapElmt, "invalid surface id", );
     DDI_CHK_NULL(mediaSurfaceHeapElmt->pSurface, "surface is already released", );
-    void *firstFree                         = surfaceHeap->pFirstFreeHeapElement;
-    surfaceHeap->pFirstFreeHeapElement     = (void*)mediaSurfaceHeapElmt;
-    mediaSurfaceHeapElmt->pNextFree        = (PDDI_MEDIA_SURFACE_HEAP_ELEMENT)firstFree;
-    mediaSurfaceHeapElmt->pSurface         = nullptr;
+    __atomic_store_n(&mediaSurfaceHeapElmt->pSurface, nullptr, __ATOMIC_RELEASE);
+    DDI_CHK_CONDITION(!DdiMediaUtil_ReleaseHeapElement(surfaceHeap, vaSurfaceID), "surface is already released", );
 }
 
 
@@ -1677,30 +1836,7 @@ PDDI_MEDIA_BUFFER_HEAP_ELEMENT DdiMediaUtil_AllocPMediaBufferFromHeap(PDDI_MEDIA
 {
     DDI_CHK_NULL(bufferHeap, "nullptr bufferHeap", nullptr);
 
-    PDDI_MEDIA_BUFFER_HEAP_ELEMENT  mediaBufferHeapElmt = nullptr;
-    if (nullptr == bufferHeap->pFirstFreeHeapElement)
-    {
-        void *newHeapBase = MOS_ReallocMemory(bufferHeap->pHeapBase, (bufferHeap->uiAllocatedHeapElements + DDI_MEDIA_HEAP_INCREMENTAL_SIZE) * sizeof(DDI_MEDIA_BUFFER_HEAP_ELEMENT));
-        if (nullptr == newHeapBase)
-        {
-            DDI_ASSERTMESSAGE("DDI: realloc failed.");
-            return nullptr;
-        }
-        bufferHeap->pHeapBase                                 = newHeapBase;
-        PDDI_MEDIA_BUFFER_HEAP_ELEMENT mediaBufferHeapBase    = (PDDI_MEDIA_BUFFER_HEAP_ELEMENT)bufferHeap->pHeapBase;
-        bufferHeap->pFirstFreeHeapElement     = (void*)(&mediaBufferHeapBase[bufferHeap->uiAllocatedHeapElements]);
-        for (int32_t i = 0; i < (DDI_MEDIA_HEAP_INCREMENTAL_SIZE); i++)
-        {
-            mediaBufferHeapElmt               = &mediaBufferHeapBase[bufferHeap->uiAllocatedHeapElements + i];
-            mediaBufferHeapElmt->pNextFree    = (i == (DDI_MEDIA_HEAP_INCREMENTAL_SIZE - 1))? nullptr : &mediaBufferHeapBase[bufferHeap->uiAllocatedHeapElements + i + 1];
-            mediaBufferHeapElmt->uiVaBufferID = bufferHeap->uiAllocatedHeapElements + i;
-        }
-        bufferHeap->uiAllocatedHeapElements  += DDI_MEDIA_HEAP_INCREMENTAL_SIZE;
-    }
-
-    mediaBufferHeapElmt                       = (PDDI_MEDIA_BUFFER_HEAP_ELEMENT)bufferHeap->pFirstFreeHeapElement;
-    bufferHeap->pFirstFreeHeapElement         = mediaBufferHeapElmt->pNextFree;
-    return mediaBufferHeapElmt;
+    return (PDDI_MEDIA_BUFFER_HEAP_ELEMENT)DdiMediaUtil_AllocHeapElement(bufferHeap);
 }
 
 
@@ -1708,97 +1844,41 @@ void DdiMediaUtil_ReleasePMediaBufferFromHeap(PDDI_MEDIA_HEAP bufferHeap, uint32
 {
     DDI_CHK_NULL(bufferHeap, "nullptr bufferHeap", );
 
-    DDI_CHK_LESS(vaBufferID, bufferHeap->uiAllocatedHeapElements, "invalid buffer id", );
-    PDDI_MEDIA_BUFFER_HEAP_ELEMENT mediaBufferHeapBase                    = (PDDI_MEDIA_BUFFER_HEAP_ELEMENT)bufferHeap->pHeapBase;
-    PDDI_MEDIA_BUFFER_HEAP_ELEMENT mediaBufferHeapElmt                    = &mediaBufferHeapBase[vaBufferID];
+    PDDI_MEDIA_BUFFER_HEAP_ELEMENT mediaBufferHeapElmt = (PDDI_MEDIA_BUFFER_HEAP_ELEMENT)DdiMediaUtil_GetHeapElement(bufferHeap, vaBufferID);
+    DDI_CHK_NULL(mediaBufferHeapElmt, "invalid buffer id", );
     DDI_CHK_NULL(mediaBufferHeapElmt->pBuffer, "buffer is already released", );
-    void *firstFree                        = bufferHeap->pFirstFreeHeapElement;
-    bufferHeap->pFirstFreeHeapElement      = (void*)mediaBufferHeapElmt;
-    mediaBufferHeapElmt->pNextFree         = (PDDI_MEDIA_BUFFER_HEAP_ELEMENT)firstFree;
-    mediaBufferHeapElmt->pBuffer           = nullptr;
+    __atomic_store_n(&mediaBufferHeapElmt->pBuffer, nullptr, __ATOMIC_RELEASE);
+    DDI_CHK_CONDITION(!DdiMediaUtil_ReleaseHeapElement(bufferHeap, vaBufferID), "buffer is already released", );
 }
 
 PDDI_MEDIA_IMAGE_HEAP_ELEMENT DdiMediaUtil_AllocPVAImageFromHeap(PDDI_MEDIA_HEAP imageHeap)
 {
-    PDDI_MEDIA_IMAGE_HEAP_ELEMENT   vaimageHeapElmt = nullptr;
-
     DDI_CHK_NULL(imageHeap, "nullptr imageHeap", nullptr);
 
-    if (nullptr == imageHeap->pFirstFreeHeapElement)
-    {
-        void *newHeapBase = MOS_ReallocMemory(imageHeap->pHeapBase, (imageHeap->uiAllocatedHeapElements + DDI_MEDIA_HEAP_INCREMENTAL_SIZE) * sizeof(DDI_MEDIA_IMAGE_HEAP_ELEMENT));
-
-        if (nullptr == newHeapBase)
-        {
-            DDI_ASSERTMESSAGE("DDI: realloc failed.");
-            return nullptr;
-        }
-        imageHeap->pHeapBase                           = newHeapBase;
-        PDDI_MEDIA_IMAGE_HEAP_ELEMENT vaimageHeapBase  = (PDDI_MEDIA_IMAGE_HEAP_ELEMENT)imageHeap->pHeapBase;
-        imageHeap->pFirstFreeHeapElement               = (void*)(&vaimageHeapBase[imageHeap->uiAllocatedHeapElements]);
-        for (int32_t i = 0; i < (DDI_MEDIA_HEAP_INCREMENTAL_SIZE); i++)
-        {
-            vaimageHeapElmt                   = &vaimageHeapBase[imageHeap->uiAllocatedHeapElements + i];
-            vaimageHeapElmt->pNextFree        = (i == (DDI_MEDIA_HEAP_INCREMENTAL_SIZE - 1))? nullptr : &vaimageHeapBase[imageHeap->uiAllocatedHeapElements + i + 1];
-            vaimageHeapElmt->uiVaImageID      = imageHeap->uiAllocatedHeapElements + i;
-        }
-        imageHeap->uiAllocatedHeapElements   += DDI_MEDIA_HEAP_INCREMENTAL_SIZE;
-
-    }
-
-    vaimageHeapElmt                           = (PDDI_MEDIA_IMAGE_HEAP_ELEMENT)imageHeap->pFirstFreeHeapElement;
-    imageHeap->pFirstFreeHeapElement          = vaimageHeapElmt->pNextFree;
-    return vaimageHeapElmt;
+    return (PDDI_MEDIA_IMAGE_HEAP_ELEMENT)DdiMediaUtil_AllocHeapElement(imageHeap);
 }
 
 
 void DdiMediaUtil_ReleasePVAImageFromHeap(PDDI_MEDIA_HEAP imageHeap, uint32_t vaImageID)
 {
-    PDDI_MEDIA_IMAGE_HEAP_ELEMENT    vaImageHeapBase = nullptr;
-    PDDI_MEDIA_IMAGE_HEAP_ELEMENT    vaImageHeapElmt = nullptr;
-    void                            *firstFree      = nullptr;
-
     DDI_CHK_NULL(imageHeap, "nullptr imageHeap", );
 
-    DDI_CHK_LESS(vaImageID, imageHeap->uiAllocatedHeapElements, "invalid image id", );
-    vaImageHeapBase                    = (PDDI_MEDIA_IMAGE_HEAP_ELEMENT)imageHeap->pHeapBase;
-    vaImageHeapElmt                    = &vaImageHeapBase[vaImageID];
+    PDDI_MEDIA_IMAGE_HEAP_ELEMENT vaImageHeapElmt = (PDDI_MEDIA_IMAGE_HEAP_ELEMENT)DdiMediaUtil_GetHeapElement(imageHeap, vaImageID);
+    DDI_CHK_NULL(vaImageHeapElmt, "invalid image id", );
     DDI_CHK_NULL(vaImageHeapElmt->pImage, "image is already released", );
-    firstFree                          = imageHeap->pFirstFreeHeapElement;
-    imageHeap->pFirstFreeHeapElement   = (void*)vaImageHeapElmt;
-    vaImageHeapElmt->pNextFree         = (PDDI_MEDIA_IMAGE_HEAP_ELEMENT)firstFree;
-    vaImageHeapElmt->pImage            = nullptr;
+    __atomic_store_n(&vaImageHeapElmt->pImage, nullptr, __ATOMIC_RELEASE);
+    DDI_CHK_CONDITION(!DdiMediaUtil_ReleaseHeapElement(imageHeap, vaImageID), "image is already released", );
 }
 
 PDDI_MEDIA_VACONTEXT_HEAP_ELEMENT DdiMediaUtil_AllocPVAContextFromHeap(PDDI_MEDIA_HEAP vaContextHeap)
 {
-    PDDI_MEDIA_VACONTEXT_HEAP_ELEMENT   vacontextHeapElmt = nullptr;
     DDI_CHK_NULL(vaContextHeap, "nullptr vaContextHeap", nullptr);
 
-    if (nullptr == vaContextHeap->pFirstFreeHeapElement)
+    PDDI_MEDIA_VACONTEXT_HEAP_ELEMENT vacontextHeapElmt = (PDDI_MEDIA_VACONTEXT_HEAP_ELEMENT)DdiMediaUtil_AllocHeapElement(vaContextHeap);
+    if (vacontextHeapElmt != nullptr)
     {
-        void *newHeapBase = MOS_ReallocMemory(vaContextHeap->pHeapBase, (vaContextHeap->uiAllocatedHeapElements + DDI_MEDIA_HEAP_INCREMENTAL_SIZE) * sizeof(DDI_MEDIA_VACONTEXT_HEAP_ELEMENT));
-
-        if (nullptr == newHeapBase)
-        {
-            DDI_ASSERTMESSAGE("DDI: realloc failed.");
-            return nullptr;
-        }
-        vaContextHeap->pHeapBase                            = newHeapBase;
-        PDDI_MEDIA_VACONTEXT_HEAP_ELEMENT vacontextHeapBase = (PDDI_MEDIA_VACONTEXT_HEAP_ELEMENT)vaContextHeap->pHeapBase;
-        vaContextHeap->pFirstFreeHeapElement        = (void*)(&(vacontextHeapBase[vaContextHeap->uiAllocatedHeapElements]));
-        for (int32_t i = 0; i < (DDI_MEDIA_HEAP_INCREMENTAL_SIZE); i++)
-        {
-            vacontextHeapElmt                       = &vacontextHeapBase[vaContextHeap->uiAllocatedHeapElements + i];
-            vacontextHeapElmt->pNextFree            = (i == (DDI_MEDIA_HEAP_INCREMENTAL_SIZE - 1))? nullptr : &vacontextHeapBase[vaContextHeap->uiAllocatedHeapElements + i + 1];
-            vacontextHeapElmt->uiVaContextID        = vaContextHeap->uiAllocatedHeapElements + i;
-            vacontextHeapElmt->pVaContext           = nullptr;
-        }
-        vaContextHeap->uiAllocatedHeapElements     += DDI_MEDIA_HEAP_INCREMENTAL_SIZE;
+        vacontextHeapElmt->pVaContext = nullptr;
     }
-
-    vacontextHeapElmt                               = (PDDI_MEDIA_VACONTEXT_HEAP_ELEMENT)vaContextHeap->pFirstFreeHeapElement;
-    vaContextHeap->pFirstFreeHeapElement            = vacontextHeapElmt->pNextFree;
     return vacontextHeapElmt;
 }
 
@@ -1806,14 +1886,12 @@ PDDI_MEDIA_VACONTEXT_HEAP_ELEMENT DdiMediaUtil_AllocPVAContextFromHeap(PDDI_MEDI
 void DdiMediaUtil_ReleasePVAContextFromHeap(PDDI_MEDIA_HEAP vaContextHeap, uint32_t vaContextID)
 {
     DDI_CHK_NULL(vaContextHeap, "nullptr vaContextHeap", );
-    DDI_CHK_LESS(vaContextID, vaContextHeap->uiAllocatedHeapElements, "invalid context id", );
-    PDDI_MEDIA_VACONTEXT_HEAP_ELEMENT vaContextHeapBase = (PDDI_MEDIA_VACONTEXT_HEAP_ELEMENT)vaContextHeap->pHeapBase;
-    PDDI_MEDIA_VACONTEXT_HEAP_ELEMENT vaContextHeapElmt = &vaContextHeapBase[vaContextID];
+
+    PDDI_MEDIA_VACONTEXT_HEAP_ELEMENT vaContextHeapElmt = (PDDI_MEDIA_VACONTEXT_HEAP_ELEMENT)DdiMediaUtil_GetHeapElement(vaContextHeap, vaContextID);
+    DDI_CHK_NULL(vaContextHeapElmt, "invalid context id", );
     DDI_CHK_NULL(vaContextHeapElmt->pVaContext, "context is already released", );
-    void *firstFree                        = vaContextHeap->pFirstFreeHeapElement;
-    vaContextHeap->pFirstFreeHeapElement   = (void*)vaContextHeapElmt;
-    vaContextHeapElmt->pNextFree           = (PDDI_MEDIA_VACONTEXT_HEAP_ELEMENT)firstFree;
-    vaContextHeapElmt->pVaContext          = nullptr;
+    __atomic_store_n(&vaContextHeapElmt->pVaContext, nullptr, __ATOMIC_RELEASE);
+    DDI_CHK_CONDITION(!DdiMediaUtil_ReleaseHeapElement(vaContextHeap, vaContextID), "context is already released", );
 }
 
 void DdiMediaUtil_UnRefBufObjInMediaBuffer(PDDI_MEDIA_BUFFER buf)
@@ -1866,15 +1944,13 @@ VAStatus DdiMediaUtil_UnRegisterRTSurfaces(
     //Look through all decode contexts to unregister the surface in each decode context's RTtable.
     if (mediaCtx->pDecoderCtxHeap != nullptr)
     {
-        PDDI_MEDIA_VACONTEXT_HEAP_ELEMENT decVACtxHeapBase;
-
         DdiMediaUtil_LockMutex(&mediaCtx->DecoderMutex);
-        decVACtxHeapBase  = (PDDI_MEDIA_VACONTEXT_HEAP_ELEMENT)mediaCtx->pDecoderCtxHeap->pHeapBase;
         for (uint32_t j = 0; j < mediaCtx->pDecoderCtxHeap->uiAllocatedHeapElements; j++)
         {
-            if (decVACtxHeapBase[j].pVaContext != nullptr)
+            PDDI_MEDIA_VACONTEXT_HEAP_ELEMENT decVACtxHeapElmt = (PDDI_MEDIA_VACONTEXT_HEAP_ELEMENT)DdiMediaUtil_GetHeapElementByIndex(mediaCtx->pDecoderCtxHeap, j);
+            if (decVACtxHeapElmt->pVaContext != nullptr)
             {
-                PDDI_DECODE_CONTEXT  decCtx = (PDDI_DECODE_CONTEXT)decVACtxHeapBase[j].pVaContext;
+                PDDI_DECODE_CONTEXT  decCtx = (PDDI_DECODE_CONTEXT)decVACtxHeapElmt->pVaContext;
                 if (decCtx && decCtx->m_ddiDecode)
                 {
                     //not check the return value since the surface may not be registered in the context. pay attention to LOGW.
@@ -1886,15 +1962,13 @@ VAStatus DdiMediaUtil_UnRegisterRTSurfaces(
     }
     if (mediaCtx->pEncoderCtxHeap != nullptr)
     {
-        PDDI_MEDIA_VACONTEXT_HEAP_ELEMENT pEncVACtxHeapBase;
-
         DdiMediaUtil_LockMutex(&mediaCtx->EncoderMutex);
-        pEncVACtxHeapBase  = (PDDI_MEDIA_VACONTEXT_HEAP_ELEMENT)mediaCtx->pEncoderCtxHeap->pHeapBase;
         for (uint32_t j = 0; j < mediaCtx->pEncoderCtxHeap->uiAllocatedHeapElements; j++)
         {
-            if (pEncVACtxHeapBase[j].pVaContext != nullptr)
+            PDDI_MEDIA_VACONTEXT_HEAP_ELEMENT pEncVACtxHeapElmt = (PDDI_MEDIA_VACONTEXT_HEAP_ELEMENT)DdiMediaUtil_GetHeapElementByIndex(mediaCtx->pEncoderCtxHeap, j);
+            if (pEncVACtxHeapElmt->pVaContext != nullptr)
             {
-                PDDI_ENCODE_CONTEXT  pEncCtx = (PDDI_ENCODE_CONTEXT)pEncVACtxHeapBase[j].pVaContext;
+                PDDI_ENCODE_CONTEXT  pEncCtx = (PDDI_ENCODE_CONTEXT)pEncVACtxHeapElmt->pVaContext;
                 if (pEncCtx && pEncCtx->m_encode)
                 {
                     //not check the return value since the surface may not be registered in the context. pay attention to LOGW.
@@ -1945,3 +2019,117 @@ VAStatus DdiMediaUtil_SetMediaResetEnableFlag(PDDI_MEDIA_CONTEXT mediaCtx)
 
     return VA_STATUS_SUCCESS;
 }
+
+void* DdiMediaUtil_AcquireStagingBuffer(PDDI_MEDIA_CONTEXT mediaCtx, uint32_t *size)
+{
+    DDI_CHK_NULL(mediaCtx, "nullptr mediaCtx", nullptr);
+    DDI_CHK_NULL(size, "nullptr size", nullptr);
+
+    void    *buf     = nullptr;
+    uint32_t bufSize = 0;
+
+    DdiMediaUtil_LockMutex(&mediaCtx->CopyMutex);
+    // take the smallest cached buffer which is big enough
+    int32_t best = -1;
+    for (int32_t i = 0; i < DDI_MEDIA_STAGING_BUFFER_NUM; i++)
+    {
+        if (mediaCtx->pStagingBuf[i] != nullptr &&
+            mediaCtx->uiStagingBufSize[i] >= *size &&
+            (best < 0 || mediaCtx->uiStagingBufSize[i] < mediaCtx->uiStagingBufSize[best]))
+        {
+            best = i;
+        }
+    }
+    if (best >= 0)
+    {
+        buf     = mediaCtx->pStagingBuf[best];
+        bufSize = mediaCtx->uiStagingBufSize[best];
+        mediaCtx->pStagingBuf[best]      = nullptr;
+        mediaCtx->uiStagingBufSize[best] = 0;
+    }
+    DdiMediaUtil_UnLockMutex(&mediaCtx->CopyMutex);
+
+    if (buf == nullptr)
+    {
+        buf     = MOS_AllocMemory(*size);
+        bufSize = *size;
+    }
+
+    *size = bufSize;
+    return buf;
+}
+
+void DdiMediaUtil_ReleaseStagingBuffer(PDDI_MEDIA_CONTEXT mediaCtx, void *buf, uint32_t size)
+{
+    if (buf == nullptr)
+    {
+        return;
+    }
+    if (mediaCtx == nullptr)
+    {
+        MOS_FreeMemory(buf);
+        return;
+    }
+
+    void *evicted = buf;
+
+    DdiMediaUtil_LockMutex(&mediaCtx->CopyMutex);
+    // keep the buffer in a free slot, otherwise in place of a smaller one
+    int32_t slot = -1;
+    for (int32_t i = 0; i < DDI_MEDIA_STAGING_BUFFER_NUM; i++)
+    {
+        if (mediaCtx->pStagingBuf[i] == nullptr)
+        {
+            slot = i;
+            break;
+        }
+        if (mediaCtx->uiStagingBufSize[i] < size &&
+            (slot < 0 || mediaCtx->uiStagingBufSize[i] < mediaCtx->uiStagingBufSize[slot]))
+        {
+            slot = i;
+        }
+    }
+    if (slot >= 0)
+    {
+        evicted = mediaCtx->pStagingBuf[slot];
+        mediaCtx->pStagingBuf[slot]      = buf;
+        mediaCtx->uiStagingBufSize[slot] = size;
+    }
+    DdiMediaUtil_UnLockMutex(&mediaCtx->CopyMutex);
+
+    MOS_FreeMemory(evicted);
+}
+
+VAStatus DdiMediaUtil_InitCopyWorkers(PDDI_MEDIA_CONTEXT mediaCtx)
+{
+    DDI_CHK_NULL(mediaCtx, "nullptr mediaCtx", VA_STATUS_ERROR_INVALID_CONTEXT);
+
+    uint32_t workerNum = 0;
+    ReadUserSetting(
+        nullptr,
+        workerNum,
+        __MEDIA_USER_FEATURE_VALUE_COPY_WORKER_NUMBER,
+        MediaUserSetting::Group::Device);
+
+    // the calling thread copies a band too, leave it a core
+    uint32_t cpuNum = std::thread::hardware_concurrency();
+    workerNum = MOS_MIN(workerNum, cpuNum > 1 ? cpuNum - 1 : 0);
+
+    return DdiMediaUtil_StartCopyWorkers(mediaCtx, workerNum);
+}
+
+void DdiMediaUtil_FreeCopyResources(PDDI_MEDIA_CONTEXT mediaCtx)
+{
+    DDI_CHK_NULL(mediaCtx, "nullptr mediaCtx", );
+
+    DdiMediaUtil_LockMutex(&mediaCtx->CopyMutex);
+    for (int32_t i = 0; i < DDI_MEDIA_STAGING_BUFFER_NUM; i++)
+    {
+        MOS_FreeMemory(mediaCtx->pStagingBuf[i]);
+        mediaCtx->pStagingBuf[i]      = nullptr;
+        mediaCtx->uiStagingBufSize[i] = 0;
+    }
+    DdiMediaUtil_UnLockMutex(&mediaCtx->CopyMutex);
+
+    DdiMediaUtil_StopCopyWorkers(mediaCtx);
+}
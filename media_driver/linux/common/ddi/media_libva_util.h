@@ -262,6 +262,41 @@ VAStatus DdiMediaUtil_FillPositionToRect(RECT *rect, int16_t offset_x, int16_t o
 //!
 bool     DdiMediaUtil_IsExternalSurface(PDDI_MEDIA_SURFACE surface);
 
+//!
+//! \brief  Get heap element from VA ID
+//! \details    Wait-free, does not need the heap mutex.
+//!
+//! \param  [in] heap
+//!         Pointer to ddi media heap
+//! \param  [in] vaID
+//!         VA ID of the element, context type bits masked off
+//!
+//! \return void*
+//!     Pointer to heap element, nullptr if vaID is invalid or was released
+//!
+void*    DdiMediaUtil_GetHeapElement(PDDI_MEDIA_HEAP heap, uint32_t vaID);
+
+//!
+//! \brief  Get heap element by index, used to walk all elements of heap
+//!
+//! \param  [in] heap
+//!         Pointer to ddi media heap
+//! \param  [in] index
+//!         Element index, less than heap->uiAllocatedHeapElements
+//!
+//! \return void*
+//!     Pointer to heap element, nullptr if its segment is not allocated
+//!
+void*    DdiMediaUtil_GetHeapElementByIndex(PDDI_MEDIA_HEAP heap, uint32_t index);
+
+//!
+//! \brief  Free all element segments of heap
+//!
+//! \param  [in] heap
+//!         Pointer to ddi media heap
+//!
+void     DdiMediaUtil_FreeHeapSegments(PDDI_MEDIA_HEAP heap);
+
 //!
 //! \brief  Allocate pmedia surface from heap
 //! 
@@ -389,6 +424,104 @@ VAStatus DdiMediaUtil_UnRegisterRTSurfaces(VADriverContextP    ctx,PDDI_MEDIA_SU
 //!
 VAStatus DdiMediaUtil_SetMediaResetEnableFlag(PDDI_MEDIA_CONTEXT mediaCtx);
 
+//!
+//! \brief  Get a staging buffer of at least size bytes from the media context cache
+//!
+//! \param  [in] mediaCtx
+//!         Pointer to ddi media context
+//! \param  [in, out] size
+//!         Required buffer size in bytes, returns the size of the buffer got
+//!
+//! \return void*
+//!     Pointer to staging buffer, nullptr if allocation failed
+//!
+void*    DdiMediaUtil_AcquireStagingBuffer(PDDI_MEDIA_CONTEXT mediaCtx, uint32_t *size);
+
+//!
+//! \brief  Return a staging buffer to the media context cache
+//!
+//! \param  [in] mediaCtx
+//!         Pointer to ddi media context
+//! \param  [in] buf
+//!         Buffer got from DdiMediaUtil_AcquireStagingBuffer
+//! \param  [in] size
+//!         Buffer size returned by DdiMediaUtil_AcquireStagingBuffer
+//!
+void     DdiMediaUtil_ReleaseStagingBuffer(PDDI_MEDIA_CONTEXT mediaCtx, void *buf, uint32_t size);
+
+//!
+//! \brief  Copy plane from src to dst row by row
+//! \details    Large planes are split into row bands copied in parallel by the
+//!             copy workers of media context.
+//!
+//! \param  [in] mediaCtx
+//!         Pointer to ddi media context
+//! \param  [in] dst
+//!         Destination plane
+//! \param  [in] dstPitch
+//!         Destination plane pitch
+//! \param  [in] src
+//!         Source plane
+//! \param  [in] srcPitch
+//!         Source plane pitch
+//! \param  [in] height
+//!         Plane height
+//! \param  [in] srcUncached
+//!         Source is a WC/uncached mapping, read it with streaming loads
+//!
+void     DdiMediaUtil_CopyPlane(
+    PDDI_MEDIA_CONTEXT mediaCtx,
+    uint8_t           *dst,
+    uint32_t           dstPitch,
+    const uint8_t     *src,
+    uint32_t           srcPitch,
+    uint32_t           height,
+    bool               srcUncached);
+
+//!
+//! \brief  Start the copy workers of media context
+//! \details Number of workers comes from the "Media Copy Worker Number" user setting,
+//!          0 by default, and is capped to leave the calling thread a CPU.
+//!
+//! \param  [in] mediaCtx
+//!         Pointer to ddi media context
+//!
+//! \return VAStatus
+//!     VA_STATUS_SUCCESS if success, else fail reason
+//!
+VAStatus DdiMediaUtil_InitCopyWorkers(PDDI_MEDIA_CONTEXT mediaCtx);
+
+//!
+//! \brief  Start copy workers for media context
+//! \details The number of workers is capped by DDI_MEDIA_COPY_WORKER_MAX. With no
+//!          workers, DdiMediaUtil_CopyPlane copies on the calling thread.
+//!
+//! \param  [in] mediaCtx
+//!         Pointer to ddi media context
+//! \param  [in] workerNum
+//!         Number of workers requested
+//!
+//! \return VAStatus
+//!     VA_STATUS_SUCCESS if success, else fail reason
+//!
+VAStatus DdiMediaUtil_StartCopyWorkers(PDDI_MEDIA_CONTEXT mediaCtx, uint32_t workerNum);
+
+//!
+//! \brief  Stop the copy workers of media context
+//!
+//! \param  [in] mediaCtx
+//!         Pointer to ddi media context
+//!
+void     DdiMediaUtil_StopCopyWorkers(PDDI_MEDIA_CONTEXT mediaCtx);
+
+//!
+//! \brief  Free the staging buffers and stop the copy workers of media context
+//!
+//! \param  [in] mediaCtx
+//!         Pointer to ddi media context
+//!
+void     DdiMediaUtil_FreeCopyResources(PDDI_MEDIA_CONTEXT mediaCtx);
+
 //------------------------------------------------------------------------------
 // Macros for debug messages, Assert, Null check and condition check within ddi files
 //------------------------------------------------------------------------------
@@ -23,6 +23,7 @@ set(TMP_SOURCES_
     ${CMAKE_CURRENT_LIST_DIR}/media_libva.cpp
     ${CMAKE_CURRENT_LIST_DIR}/media_libva_caps.cpp
     ${CMAKE_CURRENT_LIST_DIR}/media_libva_common.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/media_libva_copy.cpp
     ${CMAKE_CURRENT_LIST_DIR}/media_libva_util.cpp
     ${CMAKE_CURRENT_LIST_DIR}/media_libva_apo_decision.cpp
 )
@@ -34,6 +35,7 @@ set(TMP_HEADERS_
     ${CMAKE_CURRENT_LIST_DIR}/media_libva.h
     ${CMAKE_CURRENT_LIST_DIR}/media_libva_caps.h
     ${CMAKE_CURRENT_LIST_DIR}/media_libva_caps_factory.h
+    ${CMAKE_CURRENT_LIST_DIR}/media_libva_caps_index.h
     ${CMAKE_CURRENT_LIST_DIR}/media_libva_common.h
     ${CMAKE_CURRENT_LIST_DIR}/media_libva_util.h
     ${CMAKE_CURRENT_LIST_DIR}/media_libva_apo_decision.h
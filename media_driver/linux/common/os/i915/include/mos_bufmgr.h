@@ -153,6 +153,14 @@ struct mos_aub_annotation {
     uint32_t ending_offset;
 };
 
+struct mos_bo_cache_stats {
+    unsigned long size;
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evicts;
+    uint32_t cached_count;
+};
+
 #define BO_ALLOC_FOR_RENDER (1<<0)
 
 struct mos_linux_bo *mos_bo_alloc(struct mos_bufmgr *bufmgr, const char *name,
@@ -234,6 +242,9 @@ void mos_bufmgr_gem_enable_softpin(struct mos_bufmgr *bufmgr, bool va1m_align);
 void mos_bufmgr_gem_set_vma_cache_size(struct mos_bufmgr *bufmgr,
                          int limit);
 int mos_bufmgr_gem_get_memory_info(struct mos_bufmgr *bufmgr, char *info, uint32_t length);
+int mos_bufmgr_gem_get_bo_cache_stats(struct mos_bufmgr *bufmgr,
+                    struct mos_bo_cache_stats *stats,
+                    int count);
 int mos_gem_bo_map_unsynchronized(struct mos_linux_bo *bo);
 int mos_gem_bo_map_gtt(struct mos_linux_bo *bo);
 int mos_gem_bo_unmap_gtt(struct mos_linux_bo *bo);
@@ -0,0 +1,107 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     mos_exec3_arena.h
+//! \brief    scratch storage reused by do_exec3() across submissions
+//!
+
+#ifndef __MOS_EXEC3_ARENA_H__
+#define __MOS_EXEC3_ARENA_H__
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "i915_drm.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MOS_EXEC3_ARENA_MIN_SIZE 512
+
+/* a slot is valid only while its generation matches the current submission */
+struct mos_exec3_handle_slot {
+    uint32_t handle;
+    uint32_t generation;
+};
+
+/**
+ * Scratch storage for do_exec3(), kept in the bufmgr and reused across
+ * submissions so that a virtual engine submit does no heap allocation once
+ * the arrays have grown to the working set size. Protected by
+ * bufmgr_gem->lock.
+ */
+struct mos_exec3_arena {
+    /* merged exec objects of all batches, batch buffers last */
+    struct drm_i915_gem_exec_object2 *obj;
+    uint32_t obj_size;
+    /* exec object of each batch buffer */
+    struct drm_i915_gem_exec_object2 *batch_obj;
+    uint32_t batch_size;
+    /* copies of the batch buffer relocations, indexed by reloc_offset */
+    struct drm_i915_gem_relocation_entry *relocs;
+    uint32_t relocs_size;
+    uint32_t *reloc_offset;
+    uint32_t reloc_offset_size;
+    /* open addressed set of gem handles already placed in obj */
+    struct mos_exec3_handle_slot *handle_set;
+    uint32_t handle_set_size;
+    uint32_t generation;
+};
+
+/**
+ * Grows @array of *@size elements of @elem_size bytes to hold @required
+ * elements, doubling from MOS_EXEC3_ARENA_MIN_SIZE. The contents are kept.
+ * Returns 0 or -ENOMEM, in which case @array and @size are unchanged.
+ */
+int
+mos_exec3_arena_reserve(void **array, uint32_t *size, uint32_t required, size_t elem_size);
+
+/**
+ * Starts the dedup set of a new submission. The set is cleared only when
+ * the generation wraps around.
+ */
+void
+mos_exec3_arena_begin(struct mos_exec3_arena *arena);
+
+/**
+ * Adds @handle to the dedup set of the current submission.
+ * Returns false if it was already there.
+ */
+bool
+mos_exec3_handle_insert(struct mos_exec3_arena *arena, uint32_t handle);
+
+/**
+ * Makes room for @count handles in the dedup set, keeping it at most half
+ * full. The set is rebuilt from the first @obj_count objects already merged.
+ */
+int
+mos_exec3_handle_set_reserve(struct mos_exec3_arena *arena, uint32_t obj_count, uint32_t count);
+
+void
+mos_exec3_arena_destroy(struct mos_exec3_arena *arena);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __MOS_EXEC3_ARENA_H__
@@ -31,6 +31,7 @@ if(NOT ENABLE_PRODUCTION_KMD)
     set(TMP_SOURCES_
         ${TMP_SOURCES_}
         ${CMAKE_CURRENT_LIST_DIR}/mos_bufmgr.c
+        ${CMAKE_CURRENT_LIST_DIR}/mos_exec3_arena.c
     )
 endif()
 
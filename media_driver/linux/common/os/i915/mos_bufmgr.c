@@ -64,6 +64,7 @@
 
 #include "i915_drm.h"
 #include "mos_vma.h"
+#include "mos_exec3_arena.h"
 
 #ifdef HAVE_VALGRIND
 #include <valgrind.h>
@@ -112,6 +113,13 @@
 struct mos_gem_bo_bucket {
     drmMMListHead head;
     unsigned long size;
+
+    /** Protects head and the statistics below */
+    pthread_mutex_t lock;
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evicts;
+    uint32_t cached_count;
 };
 
 struct mos_bufmgr_gem {
@@ -166,6 +174,8 @@ struct mos_bufmgr_gem {
     mos_vma_heap vma_heap[MEMZONE_COUNT];
     bool use_softpin;
     bool softpin_va1Malign;
+
+    struct mos_exec3_arena *exec3_arena;
 } mos_bufmgr_gem;
 
 #define DRM_INTEL_RELOC_FENCE (1<<0)
@@ -331,22 +341,6 @@ struct mos_bo_gem {
     int mem_region;
 };
 
-struct mos_exec_info {
-    /* save all exec2_objects for res*/
-    struct drm_i915_gem_exec_object2* obj;
-    /* save batch buffer*/
-    struct drm_i915_gem_exec_object2* batch_obj;
-    /* save previous ptr to void mem leak when free*/
-    struct drm_i915_gem_exec_object2* pSavePreviousExec2Objects;
-    /*bo resource count*/
-    uint32_t obj_count;
-    /*batch buffer bo count*/
-    uint32_t batch_count;
-    /*remain size of 'obj'*/
-    uint32_t obj_remain_size;
-#define      OBJ512_SIZE    512
-};
-
 static unsigned int
 mos_gem_estimate_batch_space(struct mos_linux_bo ** bo_array, int count);
 
@@ -420,21 +414,43 @@ mos_gem_bo_tile_pitch(struct mos_bufmgr_gem *bufmgr_gem,
     return ROUND_UP_TO(pitch, tile_width);
 }
 
+/**
+ * Returns the index of the smallest cache bucket able to hold @size.
+ *
+ * Mirrors the layout built by init_cache_buckets(): three buckets for one
+ * to three pages, then every power of two from 16KB on followed by its
+ * three quarter steps.
+ */
+static int
+mos_gem_bo_bucket_index(unsigned long size)
+{
+    unsigned long base, quarter;
+    int log2_base;
+
+    if (size <= 4096 * 3)
+        return size <= 4096 ? 0 : (int)((size + 4095) / 4096) - 1;
+    if (size <= 4096 * 4)
+        return 3;
+
+    /* size lies in (base, 2 * base], pick the quarter step covering it */
+    log2_base = (int)(sizeof(unsigned long) * 8 - 1) - __builtin_clzl(size - 1);
+    base = 1UL << log2_base;
+    quarter = base >> 2;
+
+    return 3 + 4 * (log2_base - 14) + (int)((size - base + quarter - 1) / quarter);
+}
+
 static struct mos_gem_bo_bucket *
 mos_gem_bo_bucket_for_size(struct mos_bufmgr_gem *bufmgr_gem,
                  unsigned long size)
 {
-    int i;
+    int i = mos_gem_bo_bucket_index(size);
 
-    for (i = 0; i < bufmgr_gem->num_buckets; i++) {
-        struct mos_gem_bo_bucket *bucket =
-            &bufmgr_gem->cache_bucket[i];
-        if (bucket->size >= size) {
-            return bucket;
-        }
-    }
+    if (i >= bufmgr_gem->num_buckets)
+        return nullptr;
 
-    return nullptr;
+    assert(bufmgr_gem->cache_bucket[i].size >= size);
+    return &bufmgr_gem->cache_bucket[i];
 }
 
 static void
@@ -840,11 +856,13 @@ mos_gem_bo_madvise(struct mos_linux_bo *bo, int madv)
          madv);
 }
 
-/* drop the oldest entries that have been purged by the kernel */
+/* drop the oldest entries that have been purged by the kernel,
+ * must be called with bufmgr_gem->lock held */
 static void
 mos_gem_bo_cache_purge_bucket(struct mos_bufmgr_gem *bufmgr_gem,
                     struct mos_gem_bo_bucket *bucket)
 {
+    pthread_mutex_lock(&bucket->lock);
     while (!DRMLISTEMPTY(&bucket->head)) {
         struct mos_bo_gem *bo_gem;
 
@@ -855,8 +873,29 @@ mos_gem_bo_cache_purge_bucket(struct mos_bufmgr_gem *bufmgr_gem,
             break;
 
         DRMLISTDEL(&bo_gem->head);
+        bucket->cached_count--;
+        bucket->evicts++;
         mos_gem_bo_free(&bo_gem->bo);
     }
+    pthread_mutex_unlock(&bucket->lock);
+}
+
+/* release a bo taken out of the cache which turned out to be unusable */
+static void
+mos_gem_bo_cache_discard(struct mos_bufmgr_gem *bufmgr_gem,
+                    struct mos_gem_bo_bucket *bucket,
+                    struct mos_bo_gem *bo_gem,
+                    bool purge)
+{
+    pthread_mutex_lock(&bufmgr_gem->lock);
+    mos_gem_bo_free(&bo_gem->bo);
+    if (purge)
+        mos_gem_bo_cache_purge_bucket(bufmgr_gem, bucket);
+    pthread_mutex_unlock(&bufmgr_gem->lock);
+
+    pthread_mutex_lock(&bucket->lock);
+    bucket->evicts++;
+    pthread_mutex_unlock(&bucket->lock);
 }
 
 static int
@@ -1015,60 +1054,70 @@ mos_gem_bo_alloc_internal(struct mos_bufmgr *bufmgr,
         bo_size = bucket->size;
     }
 
-    pthread_mutex_lock(&bufmgr_gem->lock);
-    /* Get a buffer out of the cache if available */
+    /* Get a buffer out of the cache if available. Only the bucket is
+     * locked while the bo is taken off its list; revalidating it is done
+     * unlocked since the bo is owned by this thread from then on.
+     */
 retry:
     alloc_from_cache = false;
-    if (bucket != nullptr && !DRMLISTEMPTY(&bucket->head)) {
-        if (for_render) {
-            /* Allocate new render-target BOs from the tail (MRU)
-             * of the list, as it will likely be hot in the GPU
-             * cache and in the aperture for us.
-             */
-            bo_gem = DRMLISTENTRY(struct mos_bo_gem,
-                          bucket->head.prev, head);
-            DRMLISTDEL(&bo_gem->head);
-            alloc_from_cache = true;
-            bo_gem->bo.align = alignment;
-        } else {
-            assert(alignment == 0);
-            /* For non-render-target BOs (where we're probably
-             * going to map it first thing in order to fill it
-             * with data), check if the last BO in the cache is
-             * unbusy, and only reuse in that case. Otherwise,
-             * allocating a new buffer is probably faster than
-             * waiting for the GPU to finish.
-             */
-            bo_gem = DRMLISTENTRY(struct mos_bo_gem,
-                          bucket->head.next, head);
-            if (!mos_gem_bo_busy(&bo_gem->bo)) {
-                alloc_from_cache = true;
+    if (bucket != nullptr) {
+        pthread_mutex_lock(&bucket->lock);
+        if (!DRMLISTEMPTY(&bucket->head)) {
+            if (for_render) {
+                /* Allocate new render-target BOs from the tail (MRU)
+                 * of the list, as it will likely be hot in the GPU
+                 * cache and in the aperture for us.
+                 */
+                bo_gem = DRMLISTENTRY(struct mos_bo_gem,
+                              bucket->head.prev, head);
                 DRMLISTDEL(&bo_gem->head);
+                alloc_from_cache = true;
+                bo_gem->bo.align = alignment;
+            } else {
+                assert(alignment == 0);
+                /* For non-render-target BOs (where we're probably
+                 * going to map it first thing in order to fill it
+                 * with data), check if the last BO in the cache is
+                 * unbusy, and only reuse in that case. Otherwise,
+                 * allocating a new buffer is probably faster than
+                 * waiting for the GPU to finish.
+                 */
+                bo_gem = DRMLISTENTRY(struct mos_bo_gem,
+                              bucket->head.next, head);
+                if (!mos_gem_bo_busy(&bo_gem->bo)) {
+                    alloc_from_cache = true;
+                    DRMLISTDEL(&bo_gem->head);
+                }
             }
         }
 
         if (alloc_from_cache) {
-            if (!mos_gem_bo_madvise_internal
-                (bufmgr_gem, bo_gem, I915_MADV_WILLNEED)) {
-                mos_gem_bo_free(&bo_gem->bo);
-                mos_gem_bo_cache_purge_bucket(bufmgr_gem,
-                                    bucket);
-                goto retry;
-            }
+            bucket->cached_count--;
+            bucket->hits++;
+        } else {
+            bucket->misses++;
+        }
+        pthread_mutex_unlock(&bucket->lock);
+    }
 
-            if (mos_gem_bo_set_tiling_internal(&bo_gem->bo,
-                                 tiling_mode,
-                                 stride)) {
-                mos_gem_bo_free(&bo_gem->bo);
-                goto retry;
-            }
-            if (bufmgr_gem->has_lmem && mos_gem_bo_check_mem_region_internal(&bo_gem->bo, mem_type)) {
-                mos_gem_bo_free(&bo_gem->bo);
-                goto retry;
-            }
+    if (alloc_from_cache) {
+        if (!mos_gem_bo_madvise_internal
+            (bufmgr_gem, bo_gem, I915_MADV_WILLNEED)) {
+            mos_gem_bo_cache_discard(bufmgr_gem, bucket, bo_gem, true);
+            goto retry;
+        }
+
+        if (mos_gem_bo_set_tiling_internal(&bo_gem->bo,
+                             tiling_mode,
+                             stride)) {
+            mos_gem_bo_cache_discard(bufmgr_gem, bucket, bo_gem, false);
+            goto retry;
+        }
+        if (bufmgr_gem->has_lmem && mos_gem_bo_check_mem_region_internal(&bo_gem->bo, mem_type)) {
+            mos_gem_bo_cache_discard(bufmgr_gem, bucket, bo_gem, false);
+            goto retry;
         }
     }
-    pthread_mutex_unlock(&bufmgr_gem->lock);
 
     if (!alloc_from_cache) {
 
@@ -1147,7 +1196,10 @@ retry:
 
     mos_bo_gem_set_in_aperture_size(bufmgr_gem, bo_gem, alignment);
 
-    if (bufmgr_gem->use_softpin)
+    /* A bo from the cache keeps its address, don't take the bufmgr lock
+     * for it again.
+     */
+    if (bufmgr_gem->use_softpin && !bo_gem->is_softpin)
     {
         mos_bo_set_softpin(&bo_gem->bo);
     }
@@ -1564,6 +1616,7 @@ mos_gem_cleanup_bo_cache(struct mos_bufmgr_gem *bufmgr_gem, time_t time)
         struct mos_gem_bo_bucket *bucket =
             &bufmgr_gem->cache_bucket[i];
 
+        pthread_mutex_lock(&bucket->lock);
         while (!DRMLISTEMPTY(&bucket->head)) {
             struct mos_bo_gem *bo_gem;
 
@@ -1573,20 +1626,26 @@ mos_gem_cleanup_bo_cache(struct mos_bufmgr_gem *bufmgr_gem, time_t time)
                 break;
 
             DRMLISTDEL(&bo_gem->head);
+            bucket->cached_count--;
+            bucket->evicts++;
 
             mos_gem_bo_free(&bo_gem->bo);
         }
+        pthread_mutex_unlock(&bucket->lock);
     }
 
     bufmgr_gem->time = time;
 }
 
-drm_export void
-mos_gem_bo_unreference_final(struct mos_linux_bo *bo, time_t time)
+/**
+ * Releases the bo private data once its last reference is dropped, before
+ * the bo goes back into the cache or is freed.
+ */
+static void
+mos_gem_bo_release(struct mos_linux_bo *bo, time_t time)
 {
     struct mos_bufmgr_gem *bufmgr_gem = (struct mos_bufmgr_gem *) bo->bufmgr;
     struct mos_bo_gem *bo_gem = (struct mos_bo_gem *) bo;
-    struct mos_gem_bo_bucket *bucket;
     int i;
 
     /* Unreference all the target buffers */
@@ -1632,21 +1691,45 @@ mos_gem_bo_unreference_final(struct mos_linux_bo *bo, time_t time)
     }
 
     DRMLISTDEL(&bo_gem->name_list);
+}
+
+/**
+ * Puts a released bo into our internal cache for reuse if we can. Only the
+ * bucket is locked. Returns false if the bo must be freed instead.
+ */
+static bool
+mos_gem_bo_cache_put(struct mos_linux_bo *bo, time_t time)
+{
+    struct mos_bufmgr_gem *bufmgr_gem = (struct mos_bufmgr_gem *) bo->bufmgr;
+    struct mos_bo_gem *bo_gem = (struct mos_bo_gem *) bo;
+    struct mos_gem_bo_bucket *bucket;
 
     bucket = mos_gem_bo_bucket_for_size(bufmgr_gem, bo->size);
-    /* Put the buffer into our internal cache for reuse if we can. */
-    if (bufmgr_gem->bo_reuse && bo_gem->reusable && bucket != nullptr &&
-        mos_gem_bo_madvise_internal(bufmgr_gem, bo_gem,
-                          I915_MADV_DONTNEED)) {
-        bo_gem->free_time = time;
+    if (!bufmgr_gem->bo_reuse || !bo_gem->reusable || bucket == nullptr ||
+        !mos_gem_bo_madvise_internal(bufmgr_gem, bo_gem,
+                          I915_MADV_DONTNEED))
+        return false;
 
-        bo_gem->name = nullptr;
-        bo_gem->validate_index = -1;
+    bo_gem->free_time = time;
 
-        DRMLISTADDTAIL(&bo_gem->head, &bucket->head);
-    } else {
+    bo_gem->name = nullptr;
+    bo_gem->validate_index = -1;
+
+    pthread_mutex_lock(&bucket->lock);
+    DRMLISTADDTAIL(&bo_gem->head, &bucket->head);
+    bucket->cached_count++;
+    pthread_mutex_unlock(&bucket->lock);
+
+    return true;
+}
+
+drm_export void
+mos_gem_bo_unreference_final(struct mos_linux_bo *bo, time_t time)
+{
+    mos_gem_bo_release(bo, time);
+
+    if (!mos_gem_bo_cache_put(bo, time))
         mos_gem_bo_free(bo);
-    }
 }
 
 static void mos_gem_bo_unreference_locked_timed(struct mos_linux_bo *bo,
@@ -1672,6 +1755,37 @@ static void mos_gem_bo_unreference(struct mos_linux_bo *bo)
 
         clock_gettime(CLOCK_MONOTONIC, &time);
 
+        /* Named, exported and userptr bos are not reusable, so a reusable
+         * bo can not be looked up and revived by another thread. Without
+         * targets to unreference, its release only touches its own data and
+         * its bucket: only the VMA and the cache cleanup need the bufmgr lock.
+         */
+        if (bo_gem->reusable &&
+            bo_gem->reloc_count == 0 &&
+            bo_gem->softpin_target_count == 0) {
+            bool cached;
+
+            if (!atomic_dec_and_test(&bo_gem->refcount))
+                return;
+
+            mos_gem_bo_release(bo, time.tv_sec);
+
+            /* Once cached, the bo may be reused by another thread. The
+             * cleanup time is only written under the bufmgr lock, a stale
+             * read just runs or skips the cleanup once more.
+             */
+            cached = mos_gem_bo_cache_put(bo, time.tv_sec);
+            if (cached && bufmgr_gem->time == time.tv_sec)
+                return;
+
+            pthread_mutex_lock(&bufmgr_gem->lock);
+            if (!cached)
+                mos_gem_bo_free(bo);
+            mos_gem_cleanup_bo_cache(bufmgr_gem, time.tv_sec);
+            pthread_mutex_unlock(&bufmgr_gem->lock);
+            return;
+        }
+
         pthread_mutex_lock(&bufmgr_gem->lock);
 
         if (atomic_dec_and_test(&bo_gem->refcount)) {
@@ -2424,6 +2538,7 @@ mos_bufmgr_gem_destroy(struct mos_bufmgr *bufmgr)
     free(bufmgr_gem->exec2_objects);
     free(bufmgr_gem->exec_objects);
     free(bufmgr_gem->exec_bos);
+    mos_exec3_arena_destroy(bufmgr_gem->exec3_arena);
     pthread_mutex_destroy(&bufmgr_gem->lock);
 
     /* Free any cached buffer objects we were going to reuse */
@@ -2439,6 +2554,7 @@ mos_bufmgr_gem_destroy(struct mos_bufmgr *bufmgr)
 
             mos_gem_bo_free(&bo_gem->bo);
         }
+        pthread_mutex_destroy(&bucket->lock);
     }
 
     /* Release userptr bo kept hanging around for optimisation. */
@@ -3163,27 +3279,37 @@ do_exec3(struct mos_linux_bo **bo, int _num_bo, struct mos_linux_context *ctx,
 
     struct mos_bufmgr_gem           *bufmgr_gem = (struct mos_bufmgr_gem *)bo[0]->bufmgr;
     struct drm_i915_gem_execbuffer2 execbuf;
+    struct drm_i915_gem_exec_object2 *saved_exec2_objects;
+    struct mos_exec3_arena          *arena;
+    uint32_t                        obj_count = 0;
+    uint32_t                        reloc_total = 0;
     int                             ret = 0;
     int                             i;
 
     pthread_mutex_lock(&bufmgr_gem->lock);
 
-    struct mos_exec_info exec_info;
-    memset(static_cast<void*>(&exec_info), 0, sizeof(exec_info));
-    exec_info.batch_obj = (struct drm_i915_gem_exec_object2 *) calloc (num_bo, sizeof(struct drm_i915_gem_exec_object2));
-    if(exec_info.batch_obj == nullptr)
+    if (bufmgr_gem->exec3_arena == nullptr)
     {
-        ret = -ENOMEM;
-        goto skip_execution;
+        bufmgr_gem->exec3_arena = (struct mos_exec3_arena *)calloc(1, sizeof(struct mos_exec3_arena));
+        if (bufmgr_gem->exec3_arena == nullptr)
+        {
+            ret = -ENOMEM;
+            goto skip_execution;
+        }
     }
-    exec_info.obj_remain_size = OBJ512_SIZE;
-    exec_info.obj = (struct drm_i915_gem_exec_object2 *) calloc (OBJ512_SIZE, sizeof(struct drm_i915_gem_exec_object2));
-    if(exec_info.obj == nullptr)
+    arena = bufmgr_gem->exec3_arena;
+
+    if (mos_exec3_arena_reserve((void **)&arena->batch_obj, &arena->batch_size,
+            num_bo, sizeof(*arena->batch_obj)) ||
+        mos_exec3_arena_reserve((void **)&arena->reloc_offset, &arena->reloc_offset_size,
+            num_bo, sizeof(*arena->reloc_offset)))
     {
         ret = -ENOMEM;
         goto skip_execution;
     }
 
+    mos_exec3_arena_begin(arena);
+
     for(i = 0; i < num_bo; i++)
     {
         if (to_bo_gem(bo[i])->has_error)
@@ -3200,63 +3326,37 @@ do_exec3(struct mos_linux_bo **bo, int _num_bo, struct mos_linux_context *ctx,
          */
         mos_add_validate_buffer2(bo[i], 0);
 
-        if((bufmgr_gem->exec_count - 1 + num_bo) > exec_info.obj_remain_size)
-        {
-            // origin size + OBJ512_SIZE + obj_count + batch_count;
-            uint32_t new_obj_size = exec_info.obj_count + exec_info.obj_remain_size + OBJ512_SIZE + bufmgr_gem->exec_count - 1 + num_bo;
-            struct drm_i915_gem_exec_object2 *new_obj = (struct drm_i915_gem_exec_object2 *)realloc(exec_info.obj, new_obj_size * sizeof(struct drm_i915_gem_exec_object2));
-            if(new_obj == nullptr)
-            {
-                ret = -ENOMEM;
-                goto skip_execution;
-            }
-            exec_info.obj_remain_size = new_obj_size - exec_info.obj_count;
-            exec_info.obj = new_obj;
-        }
-        if(0 == i)
+        uint32_t res_count = bufmgr_gem->exec_count - 1;
+        if (mos_exec3_arena_reserve((void **)&arena->obj, &arena->obj_size,
+                obj_count + res_count + num_bo, sizeof(*arena->obj)) ||
+            mos_exec3_handle_set_reserve(arena, obj_count, obj_count + res_count))
         {
-            uint32_t cp_size = (bufmgr_gem->exec_count - 1) * sizeof(struct drm_i915_gem_exec_object2);
-            memcpy(exec_info.obj, bufmgr_gem->exec2_objects, cp_size);
-            exec_info.obj_count += (bufmgr_gem->exec_count - 1);
-            exec_info.obj_remain_size -= (bufmgr_gem->exec_count - 1);
+            ret = -ENOMEM;
+            goto skip_execution;
         }
-        else
+
+        // skip the bos already added for a previous batch buffer
+        for (uint32_t e = 0; e < res_count; e++)
         {
-            for(int e2 = 0; e2 < bufmgr_gem->exec_count - 1; e2++)
+            if (mos_exec3_handle_insert(arena, bufmgr_gem->exec2_objects[e].handle))
             {
-                int e1;
-                for(e1 = 0; e1 < exec_info.obj_count; e1++)
-                {
-                    // skip the duplicated bo if it is already in the list of exec_info.obj
-                    if(bufmgr_gem->exec2_objects[e2].handle == exec_info.obj[e1].handle)
-                    {
-                        break;
-                    }
-                }
-                //if no duplicated bo found, add it into list of exec_info.obj
-                if(e1 == exec_info.obj_count)
-                {
-                    exec_info.obj[exec_info.obj_count] = bufmgr_gem->exec2_objects[e2];
-                    exec_info.obj_count++;
-                    exec_info.obj_remain_size--;
-                }
+                arena->obj[obj_count++] = bufmgr_gem->exec2_objects[e];
             }
         }
-        memcpy(&exec_info.batch_obj[i], &bufmgr_gem->exec2_objects[bufmgr_gem->exec_count - 1], sizeof(struct drm_i915_gem_exec_object2));
-        exec_info.batch_count++;
-        uint32_t reloc_count = bufmgr_gem->exec2_objects[bufmgr_gem->exec_count - 1].relocation_count;
-        uint32_t cp_size = (reloc_count * sizeof(struct drm_i915_gem_relocation_entry));
-        
-        struct drm_i915_gem_relocation_entry* ptr_reloc = (struct drm_i915_gem_relocation_entry *)calloc(reloc_count,sizeof(struct drm_i915_gem_relocation_entry));
-        if(ptr_reloc == nullptr)
+
+        arena->batch_obj[i] = bufmgr_gem->exec2_objects[res_count];
+        uint32_t reloc_count = arena->batch_obj[i].relocation_count;
+        if (mos_exec3_arena_reserve((void **)&arena->relocs, &arena->relocs_size,
+                reloc_total + reloc_count, sizeof(*arena->relocs)))
         {
             ret = -ENOMEM;
             goto skip_execution;
         }
-        memcpy(ptr_reloc, (struct drm_i915_gem_relocation_entry *)bufmgr_gem->exec2_objects[bufmgr_gem->exec_count - 1].relocs_ptr, cp_size);
-
-        exec_info.batch_obj[i].relocs_ptr = (uintptr_t)ptr_reloc;
-        exec_info.batch_obj[i].relocation_count = reloc_count;
+        memcpy(&arena->relocs[reloc_total],
+            (struct drm_i915_gem_relocation_entry *)arena->batch_obj[i].relocs_ptr,
+            reloc_count * sizeof(struct drm_i915_gem_relocation_entry));
+        arena->reloc_offset[i] = reloc_total;
+        reloc_total += reloc_count;
 
         //clear bo
         if (bufmgr_gem->bufmgr.debug)
@@ -3279,18 +3379,18 @@ do_exec3(struct mos_linux_bo **bo, int _num_bo, struct mos_linux_context *ctx,
         bufmgr_gem->exec_count = 0;
     }
 
-    //add back batch obj to the last position
+    //add back batch obj to the last position, relocs are fixed up only now
+    //since the reloc copies may have moved while growing
     for(i = 0; i < num_bo; i++)
     {
-       exec_info.obj[exec_info.obj_count] = exec_info.batch_obj[i];
-       exec_info.obj_count++;
-       exec_info.obj_remain_size--;
+       arena->batch_obj[i].relocs_ptr = (uintptr_t)&arena->relocs[arena->reloc_offset[i]];
+       arena->obj[obj_count++] = arena->batch_obj[i];
     }
 
     //save previous ptr
-    exec_info.pSavePreviousExec2Objects = bufmgr_gem->exec2_objects;
-    bufmgr_gem->exec_count = exec_info.obj_count;
-    bufmgr_gem->exec2_objects = exec_info.obj;
+    saved_exec2_objects = bufmgr_gem->exec2_objects;
+    bufmgr_gem->exec_count = obj_count;
+    bufmgr_gem->exec2_objects = arena->obj;
 
     memclear(execbuf);
     execbuf.buffers_ptr = (uintptr_t)bufmgr_gem->exec2_objects;
@@ -3316,7 +3416,10 @@ do_exec3(struct mos_linux_bo **bo, int _num_bo, struct mos_linux_context *ctx,
     }
 
     if (bufmgr_gem->no_exec)
+    {
+        bufmgr_gem->exec2_objects = saved_exec2_objects;
         goto skip_execution;
+    }
 
    ret = drmIoctl(bufmgr_gem->fd,
                DRM_IOCTL_I915_GEM_EXECBUFFER2_WR,
@@ -3335,7 +3438,7 @@ do_exec3(struct mos_linux_bo **bo, int _num_bo, struct mos_linux_context *ctx,
         }
     }
 
-    bufmgr_gem->exec2_objects = exec_info.pSavePreviousExec2Objects;
+    bufmgr_gem->exec2_objects = saved_exec2_objects;
 
     if(flags & I915_EXEC_FENCE_OUT)
     {
@@ -3347,15 +3450,6 @@ skip_execution:
         mos_gem_dump_validation_list(bufmgr_gem);
 
     bufmgr_gem->exec_count = 0;
-    if(exec_info.batch_obj)
-    {
-        for(i = 0; i < num_bo; i++)
-        {
-            mos_safe_free((struct drm_i915_gem_relocation_entry *)exec_info.batch_obj[i].relocs_ptr);
-        }
-    }
-    mos_safe_free(exec_info.obj);
-    mos_safe_free(exec_info.batch_obj);
     pthread_mutex_unlock(&bufmgr_gem->lock);
 
     return ret;
@@ -3988,8 +4082,11 @@ add_bucket(struct mos_bufmgr_gem *bufmgr_gem, int size)
     unsigned int i = bufmgr_gem->num_buckets;
 
     assert(i < ARRAY_SIZE(bufmgr_gem->cache_bucket));
+    /* bucket lookup is computed, the layout must stay in sync with it */
+    assert(mos_gem_bo_bucket_index(size) == (int)i);
 
     DRMINITLISTHEAD(&bufmgr_gem->cache_bucket[i].head);
+    pthread_mutex_init(&bufmgr_gem->cache_bucket[i].lock, nullptr);
     bufmgr_gem->cache_bucket[i].size = size;
     bufmgr_gem->num_buckets++;
 }
@@ -4504,6 +4601,40 @@ mos_bufmgr_gem_get_memory_info(struct mos_bufmgr *bufmgr, char *info, uint32_t l
     return 0;
 }
 
+/**
+ * Reports the reuse statistics of each bo cache bucket.
+ *
+ * \param stats Array receiving one entry per bucket.
+ * \param count Number of entries available in @stats.
+ * \return Number of entries written.
+ */
+int
+mos_bufmgr_gem_get_bo_cache_stats(struct mos_bufmgr *bufmgr,
+                    struct mos_bo_cache_stats *stats,
+                    int count)
+{
+    struct mos_bufmgr_gem *bufmgr_gem = (struct mos_bufmgr_gem *) bufmgr;
+    int i;
+
+    if (bufmgr_gem == nullptr || stats == nullptr)
+        return 0;
+
+    for (i = 0; i < bufmgr_gem->num_buckets && i < count; i++) {
+        struct mos_gem_bo_bucket *bucket =
+            &bufmgr_gem->cache_bucket[i];
+
+        pthread_mutex_lock(&bucket->lock);
+        stats[i].size = bucket->size;
+        stats[i].hits = bucket->hits;
+        stats[i].misses = bucket->misses;
+        stats[i].evicts = bucket->evicts;
+        stats[i].cached_count = bucket->cached_count;
+        pthread_mutex_unlock(&bucket->lock);
+    }
+
+    return i;
+}
+
 void mos_bufmgr_gem_enable_softpin(struct mos_bufmgr *bufmgr, bool va1m_align)
 {
     struct mos_bufmgr_gem *bufmgr_gem = (struct mos_bufmgr_gem *)bufmgr;
@@ -0,0 +1,127 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     mos_exec3_arena.c
+//! \brief    scratch storage reused by do_exec3() across submissions
+//!
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include "mos_exec3_arena.h"
+
+int
+mos_exec3_arena_reserve(void **array, uint32_t *size, uint32_t required, size_t elem_size)
+{
+    uint32_t new_size;
+    void *new_array;
+
+    if (required <= *size)
+        return 0;
+
+    new_size = *size ? *size : MOS_EXEC3_ARENA_MIN_SIZE;
+    while (new_size < required)
+        new_size *= 2;
+
+    new_array = realloc(*array, new_size * elem_size);
+    if (new_array == nullptr)
+        return -ENOMEM;
+
+    *array = new_array;
+    *size = new_size;
+    return 0;
+}
+
+void
+mos_exec3_arena_begin(struct mos_exec3_arena *arena)
+{
+    if (++arena->generation == 0)
+    {
+        if (arena->handle_set)
+        {
+            memset(arena->handle_set, 0, arena->handle_set_size * sizeof(*arena->handle_set));
+        }
+        arena->generation = 1;
+    }
+}
+
+static inline uint32_t
+mos_exec3_handle_hash(uint32_t handle, uint32_t mask)
+{
+    return (handle * 0x9E3779B1u) & mask;
+}
+
+bool
+mos_exec3_handle_insert(struct mos_exec3_arena *arena, uint32_t handle)
+{
+    uint32_t mask = arena->handle_set_size - 1;
+    uint32_t i = mos_exec3_handle_hash(handle, mask);
+
+    while (arena->handle_set[i].generation == arena->generation) {
+        if (arena->handle_set[i].handle == handle)
+            return false;
+        i = (i + 1) & mask;
+    }
+    arena->handle_set[i].handle = handle;
+    arena->handle_set[i].generation = arena->generation;
+    return true;
+}
+
+int
+mos_exec3_handle_set_reserve(struct mos_exec3_arena *arena, uint32_t obj_count, uint32_t count)
+{
+    uint32_t new_size = arena->handle_set_size ? arena->handle_set_size : MOS_EXEC3_ARENA_MIN_SIZE * 2;
+    struct mos_exec3_handle_slot *new_set;
+    uint32_t i;
+
+    while (new_size < 2 * count)
+        new_size *= 2;
+    if (new_size == arena->handle_set_size)
+        return 0;
+
+    new_set = (struct mos_exec3_handle_slot *)calloc(new_size, sizeof(*new_set));
+    if (new_set == nullptr)
+        return -ENOMEM;
+
+    free(arena->handle_set);
+    arena->handle_set = new_set;
+    arena->handle_set_size = new_size;
+    arena->generation = 1;
+    for (i = 0; i < obj_count; i++)
+        mos_exec3_handle_insert(arena, arena->obj[i].handle);
+
+    return 0;
+}
+
+void
+mos_exec3_arena_destroy(struct mos_exec3_arena *arena)
+{
+    if (arena == nullptr)
+        return;
+
+    free(arena->obj);
+    free(arena->batch_obj);
+    free(arena->relocs);
+    free(arena->reloc_offset);
+    free(arena->handle_set);
+    free(arena);
+}
@@ -26,11 +26,344 @@
 
 #include "mos_vma.h"
 
+#define MOS_VMA_HOLE_SLAB_COUNT 64
+
+typedef struct _mos_vma_hole_slab {
+    struct list_head link;
+    mos_vma_hole holes[MOS_VMA_HOLE_SLAB_COUNT];
+} mos_vma_hole_slab;
+
+#define MOS_VMA_MAX(A, B) ((A) > (B) ? (A) : (B))
+
+/* Deep enough for any AVL tree that fits in memory */
+#define MOS_VMA_TREE_MAX_DEPTH 96
+
+static mos_vma_hole *
+mos_vma_hole_get(mos_vma_heap *heap)
+{
+    if (heap->free_holes == nullptr)
+    {
+        /* Hole nodes are carved from slabs so that splitting a hole does
+        * not hit the system allocator.
+        */
+        mos_vma_hole_slab *slab = (mos_vma_hole_slab *)calloc(1, sizeof(*slab));
+        if (slab == nullptr)
+        {
+            return nullptr;
+        }
+        list_addtail(&slab->link, &heap->hole_slabs);
+        for (int i = 0; i < MOS_VMA_HOLE_SLAB_COUNT; i++)
+        {
+            slab->holes[i].left = heap->free_holes;
+            heap->free_holes = &slab->holes[i];
+        }
+    }
+
+    mos_vma_hole *hole = heap->free_holes;
+    heap->free_holes = hole->left;
+    memset(hole, 0, sizeof(*hole));
+    return hole;
+}
+
+static void
+mos_vma_hole_put(mos_vma_heap *heap, mos_vma_hole *hole)
+{
+    hole->left = heap->free_holes;
+    hole->right = nullptr;
+    heap->free_holes = hole;
+}
+
+static inline int
+mos_vma_hole_height(mos_vma_hole *hole)
+{
+    return hole ? hole->height : 0;
+}
+
+static inline uint64_t
+mos_vma_hole_max_size(mos_vma_hole *hole)
+{
+    return hole ? hole->max_size : 0;
+}
+
+static void
+mos_vma_hole_update(mos_vma_hole *hole)
+{
+    hole->height = 1 + MOS_VMA_MAX(mos_vma_hole_height(hole->left),
+                                   mos_vma_hole_height(hole->right));
+    hole->max_size = MOS_VMA_MAX(hole->size,
+                                 MOS_VMA_MAX(mos_vma_hole_max_size(hole->left),
+                                             mos_vma_hole_max_size(hole->right)));
+}
+
+static mos_vma_hole *
+mos_vma_rotate_right(mos_vma_hole *hole)
+{
+    mos_vma_hole *pivot = hole->left;
+    hole->left = pivot->right;
+    pivot->right = hole;
+    mos_vma_hole_update(hole);
+    mos_vma_hole_update(pivot);
+    return pivot;
+}
+
+static mos_vma_hole *
+mos_vma_rotate_left(mos_vma_hole *hole)
+{
+    mos_vma_hole *pivot = hole->right;
+    hole->right = pivot->left;
+    pivot->left = hole;
+    mos_vma_hole_update(hole);
+    mos_vma_hole_update(pivot);
+    return pivot;
+}
+
+static mos_vma_hole *
+mos_vma_balance(mos_vma_hole *hole)
+{
+    mos_vma_hole_update(hole);
+
+    int balance = mos_vma_hole_height(hole->left) - mos_vma_hole_height(hole->right);
+    if (balance > 1)
+    {
+        if (mos_vma_hole_height(hole->left->left) < mos_vma_hole_height(hole->left->right))
+        {
+            hole->left = mos_vma_rotate_left(hole->left);
+        }
+        return mos_vma_rotate_right(hole);
+    }
+    if (balance < -1)
+    {
+        if (mos_vma_hole_height(hole->right->right) < mos_vma_hole_height(hole->right->left))
+        {
+            hole->right = mos_vma_rotate_right(hole->right);
+        }
+        return mos_vma_rotate_left(hole);
+    }
+    return hole;
+}
+
+static mos_vma_hole *
+mos_vma_tree_insert(mos_vma_hole *root, mos_vma_hole *hole)
+{
+    if (root == nullptr)
+    {
+        hole->left = hole->right = nullptr;
+        mos_vma_hole_update(hole);
+        return hole;
+    }
+
+    if (hole->offset < root->offset)
+    {
+        root->left = mos_vma_tree_insert(root->left, hole);
+    }
+    else
+    {
+        root->right = mos_vma_tree_insert(root->right, hole);
+    }
+    return mos_vma_balance(root);
+}
+
+static mos_vma_hole *
+mos_vma_tree_remove_min(mos_vma_hole *root, mos_vma_hole **min)
+{
+    if (root->left == nullptr)
+    {
+        *min = root;
+        return root->right;
+    }
+    root->left = mos_vma_tree_remove_min(root->left, min);
+    return mos_vma_balance(root);
+}
+
+static mos_vma_hole *
+mos_vma_tree_remove(mos_vma_hole *root, mos_vma_hole *hole)
+{
+    assert(root);
+
+    if (hole->offset < root->offset)
+    {
+        root->left = mos_vma_tree_remove(root->left, hole);
+        return mos_vma_balance(root);
+    }
+    if (hole->offset > root->offset)
+    {
+        root->right = mos_vma_tree_remove(root->right, hole);
+        return mos_vma_balance(root);
+    }
+
+    assert(root == hole);
+    if (root->left == nullptr)
+    {
+        return root->right;
+    }
+    if (root->right == nullptr)
+    {
+        return root->left;
+    }
+
+    mos_vma_hole *successor = nullptr;
+    mos_vma_hole *right = mos_vma_tree_remove_min(root->right, &successor);
+    successor->left = root->left;
+    successor->right = right;
+    return mos_vma_balance(successor);
+}
+
+/* Change the range of a hole without changing its position in the tree,
+* i.e. the new offset must stay between the neighbouring holes.
+*/
+static void
+mos_vma_hole_resize(mos_vma_heap *heap, mos_vma_hole *hole, uint64_t offset, uint64_t size)
+{
+    mos_vma_hole *path[MOS_VMA_TREE_MAX_DEPTH];
+    int depth = 0;
+
+    for (mos_vma_hole *node = heap->root; node != hole; )
+    {
+        assert(node && depth < MOS_VMA_TREE_MAX_DEPTH);
+        path[depth++] = node;
+        node = hole->offset < node->offset ? node->left : node->right;
+    }
+
+    hole->offset = offset;
+    hole->size = size;
+    mos_vma_hole_update(hole);
+    while (depth > 0)
+    {
+        mos_vma_hole_update(path[--depth]);
+    }
+}
+
+/* Find the highest hole which has a suitably aligned range of the given size */
+static mos_vma_hole *
+mos_vma_find_high(mos_vma_hole *root, uint64_t size, uint64_t alignment, uint64_t *offset)
+{
+    if (root == nullptr || root->max_size < size)
+    {
+        return nullptr;
+    }
+
+    mos_vma_hole *hole = mos_vma_find_high(root->right, size, alignment, offset);
+    if (hole)
+    {
+        return hole;
+    }
+
+    if (size <= root->size)
+    {
+        /* Compute the offset as the highest address where a chunk of the
+        * given size can be without going over the top of the hole.
+        *
+        * This calculation is known to not overflow because we know that
+        * hole->size + hole->offset can only overflow to 0 and size > 0.
+        */
+        uint64_t candidate = (root->size - size) + root->offset;
+
+        /* Align the offset.  We align down and not up because we are
+        * allocating from the top of the hole and not the bottom.
+        */
+        candidate = (candidate / alignment) * alignment;
+
+        if (candidate >= root->offset)
+        {
+            *offset = candidate;
+            return root;
+        }
+    }
+
+    return mos_vma_find_high(root->left, size, alignment, offset);
+}
+
+/* Find the lowest hole which has a suitably aligned range of the given size */
+static mos_vma_hole *
+mos_vma_find_low(mos_vma_hole *root, uint64_t size, uint64_t alignment, uint64_t *offset)
+{
+    if (root == nullptr || root->max_size < size)
+    {
+        return nullptr;
+    }
+
+    mos_vma_hole *hole = mos_vma_find_low(root->left, size, alignment, offset);
+    if (hole)
+    {
+        return hole;
+    }
+
+    if (size <= root->size)
+    {
+        uint64_t candidate = root->offset;
+        bool     fits      = true;
+
+        /* Align the offset */
+        uint64_t misalign = candidate % alignment;
+        if (misalign) {
+            uint64_t pad = alignment - misalign;
+            if (pad > root->size - size)
+                fits = false;
+
+            candidate += pad;
+        }
+
+        if (fits)
+        {
+            *offset = candidate;
+            return root;
+        }
+    }
+
+    return mos_vma_find_low(root->right, size, alignment, offset);
+}
+
+/* Find the highest hole starting at or below offset */
+static mos_vma_hole *
+mos_vma_find_floor(mos_vma_heap *heap, uint64_t offset)
+{
+    mos_vma_hole *floor = nullptr;
+
+    for (mos_vma_hole *node = heap->root; node; )
+    {
+        if (node->offset <= offset)
+        {
+            floor = node;
+            node = node->right;
+        }
+        else
+        {
+            node = node->left;
+        }
+    }
+    return floor;
+}
+
+/* Find the lowest hole starting above offset */
+static mos_vma_hole *
+mos_vma_find_ceil(mos_vma_heap *heap, uint64_t offset)
+{
+    mos_vma_hole *ceil = nullptr;
+
+    for (mos_vma_hole *node = heap->root; node; )
+    {
+        if (node->offset > offset)
+        {
+            ceil = node;
+            node = node->left;
+        }
+        else
+        {
+            node = node->right;
+        }
+    }
+    return ceil;
+}
+
 void
 mos_vma_heap_init(mos_vma_heap *heap, uint64_t start, uint64_t size)
 {
     assert(heap);
-    list_inithead(&heap->holes);
+    heap->root = nullptr;
+    heap->free_holes = nullptr;
+    heap->hole_count = 0;
+    heap->free_size = 0;
+    list_inithead(&heap->hole_slabs);
     mos_vma_heap_free(heap, start, size);
 
     /* Default to using high addresses */
@@ -41,51 +374,74 @@ void
 mos_vma_heap_finish(mos_vma_heap *heap)
 {
     assert(heap);
-    list_for_each_entry_safe(mos_vma_hole, hole, &heap->holes, link)
+    list_for_each_entry_safe(mos_vma_hole_slab, slab, &heap->hole_slabs, link)
     {
-        free(hole);
+        free(slab);
     }
+    list_inithead(&heap->hole_slabs);
+    heap->root = nullptr;
+    heap->free_holes = nullptr;
+    heap->hole_count = 0;
+    heap->free_size = 0;
 }
 
 #ifdef _DEBUG
+static uint32_t
+mos_vma_tree_validate(mos_vma_hole *hole, mos_vma_hole **prev)
+{
+    if (hole == nullptr)
+    {
+        return 0;
+    }
+
+    uint32_t count = mos_vma_tree_validate(hole->left, prev);
+
+    assert(hole->offset > 0);
+    assert(hole->size > 0);
+    assert(hole->max_size == MOS_VMA_MAX(hole->size,
+                                         MOS_VMA_MAX(mos_vma_hole_max_size(hole->left),
+                                                     mos_vma_hole_max_size(hole->right))));
+    int balance = mos_vma_hole_height(hole->left) - mos_vma_hole_height(hole->right);
+    assert(balance >= -1 && balance <= 1);
+
+    if (*prev)
+    {
+        /* Holes below the top-most one must not overflow and must be strictly
+        * lower than the next hole.  If they touch, we failed to join holes
+        * during a mos_vma_heap_free.
+        */
+        assert((*prev)->size + (*prev)->offset > (*prev)->offset &&
+                (*prev)->size + (*prev)->offset < hole->offset);
+    }
+    *prev = hole;
+
+    return count + 1 + mos_vma_tree_validate(hole->right, prev);
+}
+
 static void
 mos_vma_heap_validate(mos_vma_heap *heap)
 {
     assert(heap);
-    uint64_t prev_offset = 0;
+    mos_vma_hole *top = nullptr;
 
-    list_for_each_entry(mos_vma_hole, hole, &heap->holes, link)
-    {
-        assert(hole->offset > 0);
-        assert(hole->size > 0);
+    uint32_t count = mos_vma_tree_validate(heap->root, &top);
+    assert(count == heap->hole_count);
 
-        if (&hole->link == heap->holes.next)
-        {
-            /* This must be the top-most hole.  Assert that, if it overflows, it
-            * overflows to 0, i.e. 2^64.
-            */
-            assert(hole->size + hole->offset == 0 ||
-                    hole->size + hole->offset > hole->offset);
-        }
-        else
-        {
-            /* This is not the top-most hole so it must not overflow and, in
-            * fact, must be strictly lower than the top-most hole.  If
-            * hole->size + hole->offset == prev_offset, then we failed to join
-            * holes during a mos_vma_heap_free.
-            */
-            assert(hole->size + hole->offset > hole->offset &&
-                    hole->size + hole->offset < prev_offset);
-        }
-        prev_offset = hole->offset;
-   }
+    if (top)
+    {
+        /* This must be the top-most hole.  Assert that, if it overflows, it
+        * overflows to 0, i.e. 2^64.
+        */
+        assert(top->size + top->offset == 0 ||
+                top->size + top->offset > top->offset);
+    }
 }
 #else
 #define mos_vma_heap_validate(heap)
 #endif
 
-static void
-mos_vma_hole_alloc(mos_vma_hole *hole, uint64_t offset, uint64_t size)
+static bool
+mos_vma_hole_alloc(mos_vma_heap *heap, mos_vma_hole *hole, uint64_t offset, uint64_t size)
 {
     assert(hole);
     assert(hole->offset <= offset);
@@ -93,34 +449,37 @@ mos_vma_hole_alloc(mos_vma_hole *hole, uint64_t offset, uint64_t size)
 
     if (offset == hole->offset && size == hole->size) {
         /* Just get rid of the hole. */
-        list_del(&hole->link);
-        free(hole);
-        return;
+        heap->root = mos_vma_tree_remove(heap->root, hole);
+        mos_vma_hole_put(heap, hole);
+        heap->hole_count--;
+        heap->free_size -= size;
+        return true;
     }
 
     uint64_t waste = (hole->size - size) - (offset - hole->offset);
     if (waste == 0) {
         /* We allocated at the top.  Shrink the hole down. */
-        hole->size -= size;
-        return;
+        mos_vma_hole_resize(heap, hole, hole->offset, hole->size - size);
+        heap->free_size -= size;
+        return true;
     }
 
     if (offset == hole->offset) {
         /* We allocated at the bottom. Shrink the hole up. */
-        hole->offset += size;
-        hole->size -= size;
-        return;
+        mos_vma_hole_resize(heap, hole, hole->offset + size, hole->size - size);
+        heap->free_size -= size;
+        return true;
     }
 
     /* We allocated in the middle.  We need to split the old hole into two
     * holes, one high and one low.
     */
-    mos_vma_hole *high_hole = (mos_vma_hole*)calloc(1, sizeof(*hole));
+    mos_vma_hole *high_hole = mos_vma_hole_get(heap);
     if(high_hole == nullptr)
     {
         assert(high_hole);
 
-        return;
+        return false;
     }
 
     high_hole->offset = offset + size;
@@ -129,12 +488,12 @@ mos_vma_hole_alloc(mos_vma_hole *hole, uint64_t offset, uint64_t size)
     /* Adjust the hole to be the amount of space left at he bottom of the
     * original hole.
     */
-    hole->size = offset - hole->offset;
+    mos_vma_hole_resize(heap, hole, hole->offset, offset - hole->offset);
 
-    /* Place the new hole before the old hole so that the list is in order
-    * from high to low.
-    */
-    list_addtail(&high_hole->link, &hole->link);
+    heap->root = mos_vma_tree_insert(heap->root, high_hole);
+    heap->hole_count++;
+    heap->free_size -= size;
+    return true;
 }
 
 uint64_t
@@ -147,53 +506,15 @@ mos_vma_heap_alloc(mos_vma_heap *heap, uint64_t size, uint64_t alignment)
 
     mos_vma_heap_validate(heap);
 
-    if (heap->alloc_high) {
-        list_for_each_entry_safe(mos_vma_hole, hole, &heap->holes, link)
-        {
-            if (size > hole->size)
-                continue;
-
-            /* Compute the offset as the highest address where a chunk of the
-            * given size can be without going over the top of the hole.
-            *
-            * This calculation is known to not overflow because we know that
-            * hole->size + hole->offset can only overflow to 0 and size > 0.
-            */
-            uint64_t offset = (hole->size - size) + hole->offset;
-
-            /* Align the offset.  We align down and not up because we are
-            * allocating from the top of the hole and not the bottom.
-            */
-            offset = (offset / alignment) * alignment;
-
-            if (offset < hole->offset)
-            continue;
-
-            mos_vma_hole_alloc(hole, offset, size);
-            mos_vma_heap_validate(heap);
-            return offset;
-        }
-    } else {
-        list_for_each_entry_safe_rev(mos_vma_hole, hole, &heap->holes, link) {
-            if (size > hole->size)
-                continue;
-
-            uint64_t offset = hole->offset;
+    uint64_t      offset = 0;
+    mos_vma_hole *hole   = heap->alloc_high ?
+        mos_vma_find_high(heap->root, size, alignment, &offset) :
+        mos_vma_find_low(heap->root, size, alignment, &offset);
 
-            /* Align the offset */
-            uint64_t misalign = offset % alignment;
-            if (misalign) {
-                uint64_t pad = alignment - misalign;
-                if (pad > hole->size - size)
-                    continue;
-
-                offset += pad;
-            }
-
-            mos_vma_hole_alloc(hole, offset, size);
-            mos_vma_heap_validate(heap);
-            return offset;
-        }
+    if (hole && mos_vma_hole_alloc(heap, hole, offset, size))
+    {
+        mos_vma_heap_validate(heap);
+        return offset;
     }
 
     /* Failed to allocate */
@@ -217,26 +538,18 @@ mos_vma_heap_alloc_addr(mos_vma_heap *heap, uint64_t offset, uint64_t size)
     */
     assert(offset + size == 0 || offset + size > offset);
 
-    /* Find the hole if one exists. */
-    list_for_each_entry_safe(mos_vma_hole, hole, &heap->holes, link)
+    /* The highest hole starting at or below offset is the only one which can
+    * contain the requested range.  If it's not big enough, then the
+    * allocation fails.
+    */
+    mos_vma_hole *hole = mos_vma_find_floor(heap, offset);
+    if (hole == nullptr || hole->size < offset - hole->offset + size)
     {
-        if (hole->offset > offset)
-            continue;
-
-        /* Holes are ordered high-to-low so the first hole we find with
-        * hole->offset <= is our hole.  If it's not big enough to contain the
-        * requested range, then the allocation fails.
-        */
-        assert(hole->offset <= offset);
-        if (hole->size < offset - hole->offset + size)
-            return false;
-
-        mos_vma_hole_alloc(hole, offset, size);
-        return true;
+        /* We didn't find a suitable hole */
+        return false;
     }
 
-    /* We didn't find a suitable hole */
-    return false;
+    return mos_vma_hole_alloc(heap, hole, offset, size);
 }
 
 void
@@ -259,15 +572,8 @@ mos_vma_heap_free(mos_vma_heap *heap, uint64_t offset, uint64_t size)
     mos_vma_heap_validate(heap);
 
     /* Find immediately higher and lower holes if they exist. */
-    mos_vma_hole *high_hole = NULL, *low_hole = NULL;
-    list_for_each_entry(mos_vma_hole, hole, &heap->holes, link)
-    {
-        if (hole->offset <= offset) {
-            low_hole = hole;
-            break;
-        }
-        high_hole = hole;
-    }
+    mos_vma_hole *high_hole = mos_vma_find_ceil(heap, offset);
+    mos_vma_hole *low_hole  = mos_vma_find_floor(heap, offset);
 
     if (high_hole)
     {
@@ -284,32 +590,42 @@ mos_vma_heap_free(mos_vma_heap *heap, uint64_t offset, uint64_t size)
 
     if (low_adjacent && high_adjacent) {
         /* Merge the two holes */
-        low_hole->size += size + high_hole->size;
-        list_del(&high_hole->link);
-        free(high_hole);
+        uint64_t merged_size = low_hole->size + size + high_hole->size;
+        heap->root = mos_vma_tree_remove(heap->root, high_hole);
+        mos_vma_hole_put(heap, high_hole);
+        heap->hole_count--;
+        mos_vma_hole_resize(heap, low_hole, low_hole->offset, merged_size);
     } else if (low_adjacent) {
         /* Merge into the low hole */
-        low_hole->size += size;
+        mos_vma_hole_resize(heap, low_hole, low_hole->offset, low_hole->size + size);
     } else if (high_adjacent) {
         /* Merge into the high hole */
-        high_hole->offset = offset;
-        high_hole->size += size;
+        mos_vma_hole_resize(heap, high_hole, offset, high_hole->size + size);
     } else {
         /* Neither hole is adjacent; make a new one */
-        mos_vma_hole *hole = (mos_vma_hole*)calloc(1, sizeof(*hole));
+        mos_vma_hole *hole = mos_vma_hole_get(heap);
         assert(hole);
-        if(hole)
+        if (hole == nullptr)
         {
-            hole->offset = offset;
-            hole->size = size;
-
-            /* Add it after the high hole so we maintain high-to-low ordering */
-            if (high_hole)
-                list_add(&hole->link, &high_hole->link);
-            else
-                list_add(&hole->link, &heap->holes);
+            return;
         }
+        hole->offset = offset;
+        hole->size = size;
+        heap->root = mos_vma_tree_insert(heap->root, hole);
+        heap->hole_count++;
     }
+    heap->free_size += size;
 
     mos_vma_heap_validate(heap);
 }
+
+void
+mos_vma_heap_get_stats(mos_vma_heap *heap, mos_vma_heap_stats *stats)
+{
+    assert(heap);
+    assert(stats);
+
+    stats->hole_count   = heap->hole_count;
+    stats->free_size    = heap->free_size;
+    stats->largest_hole = mos_vma_hole_max_size(heap->root);
+}
@@ -31,14 +31,37 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "list.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+typedef struct _mos_vma_hole {
+   /* Holes are kept in an AVL tree ordered by offset. Each node also keeps
+    * the largest hole size of its subtree so fitting holes are found in
+    * O(log n).
+    */
+   struct _mos_vma_hole *left;
+   struct _mos_vma_hole *right;
+   uint64_t offset;
+   uint64_t size;
+   uint64_t max_size;
+   int height;
+} mos_vma_hole;
+
 typedef struct _mos_vma_heap {
-   struct list_head holes;
+   mos_vma_hole *root;
+
+   /** Unused hole nodes, chained through their left pointer */
+   mos_vma_hole *free_holes;
+
+   /** Slabs the hole nodes are carved from */
+   struct list_head hole_slabs;
+
+   uint32_t hole_count;
+   uint64_t free_size;
 
    /** If true, util_vma_heap_alloc will prefer high addresses
     *
@@ -47,11 +70,14 @@ typedef struct _mos_vma_heap {
    bool alloc_high;
 } mos_vma_heap;
 
-typedef struct _mos_vma_hole {
-   struct list_head link;
-   uint64_t offset;
-   uint64_t size;
-} mos_vma_hole;
+typedef struct _mos_vma_heap_stats {
+   /** Number of free ranges in the heap */
+   uint32_t hole_count;
+   /** Total free space */
+   uint64_t free_size;
+   /** Size of the largest free range */
+   uint64_t largest_hole;
+} mos_vma_heap_stats;
 
 //!
 //! \brief  Initialize vma heap
@@ -120,6 +146,18 @@ bool mos_vma_heap_alloc_addr(mos_vma_heap *heap, uint64_t addr, uint64_t size);
 //!
 void mos_vma_heap_free(mos_vma_heap *heap, uint64_t offset, uint64_t size);
 
+//!
+//! \brief  Get fragmentation statistics of a specific vma heap
+//!
+//! \param  [in] heap
+//!         Pointer to vma heap
+//! \param  [out] stats
+//!         Hole count, free size and largest hole of the heap
+//!
+//! \return void
+//!
+void mos_vma_heap_get_stats(mos_vma_heap *heap, mos_vma_heap_stats *stats);
+
 #ifdef __cplusplus
 } /* extern C */
 #endif
@@ -96,6 +96,9 @@ typedef struct DDI_VP_CONTEXT
 
     DDI_VP_FRAMEID_TRACER                     FrameIDTracer       = {};
 
+    // status reports drained from VP HAL in one call, used under SurfaceMutex
+    QUERY_STATUS_REPORT_APP                   StatusReports[VPHAL_STATUS_TABLE_MAX_SIZE] = {};
+
 #if (_DEBUG || _RELEASE_INTERNAL)
     DDI_VP_DUMP_PARAM                         *pCurVpDumpDDIParam = nullptr;
     DDI_VP_DUMP_PARAM                         *pPreVpDumpDDIParam = nullptr;
@@ -0,0 +1,99 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     media_libva_vp_status.h
+//! \brief    Drain of the VP status report table on surface sync
+//! \details  Reports are taken out of the VP HAL table in order, up to the frame of the
+//!           queried surface. Frames submitted after it stay in the table, pending.
+//!
+
+#ifndef __MEDIA_LIBVA_VP_STATUS_H__
+#define __MEDIA_LIBVA_VP_STATUS_H__
+
+#include "mos_os.h"
+#include "vp_common_tools.h"
+
+//!
+//! \brief    Take the VP status reports out of the table, up to the frame of a surface
+//! \details  Fetches the reports in one GetStatusReport call. VP HAL on Linux removes the
+//!           frames done by GPU and the first one not done. Later frames are reported but
+//!           stay in the table, so the call is repeated until the queried frame is removed.
+//!           If the surface has no report in the table, the whole table is drained.
+//! \param    [in] vpHal
+//!           VpBase, or a class with its status report functions
+//! \param    [in] reports
+//!           Buffer of VPHAL_STATUS_TABLE_MAX_SIZE reports
+//! \param    [in] surfaceId
+//!           StatusFeedBackID of the queried surface
+//! \param    [in] updateSurface
+//!           void(const QUERY_STATUS_REPORT_APP &report), called for each report removed from the table
+//! \return   uint32_t
+//!           Number of GetStatusReport calls
+//!
+template <typename VpHal, typename UpdateSurface>
+static __inline uint32_t DdiVp_DrainStatusReport(
+    VpHal                   *vpHal,
+    QUERY_STATUS_REPORT_APP *reports,
+    uint32_t                surfaceId,
+    UpdateSurface           updateSurface)
+{
+    uint32_t tableLen = 0;
+    vpHal->GetStatusReportEntryLength(&tableLen);
+
+    uint32_t reportNum = tableLen;
+    if (vpHal->GetStatusReportEntryIndex(surfaceId, &reportNum) != MOS_STATUS_SUCCESS)
+    {
+        reportNum = tableLen;
+    }
+    else if (reportNum < tableLen)
+    {
+        reportNum++;
+    }
+
+    uint32_t callNum  = 0;
+    uint32_t reported = 0;
+    while (reported < reportNum)
+    {
+        uint32_t len       = 0;
+        uint32_t remainLen = 0;
+        vpHal->GetStatusReportEntryLength(&len);
+        MOS_ZeroMemory(reports, (reportNum - reported) * sizeof(QUERY_STATUS_REPORT_APP));
+        vpHal->GetStatusReport(reports, (uint16_t)(reportNum - reported));
+        vpHal->GetStatusReportEntryLength(&remainLen);
+        callNum++;
+
+        uint32_t removedLen = (remainLen < len) ? (len - remainLen) : 0;
+        if (removedLen == 0)
+        {
+            break;
+        }
+        for (uint32_t i = 0; i < removedLen; i++)
+        {
+            updateSurface(reports[i]);
+        }
+        reported += removedLen;
+    }
+
+    return callNum;
+}
+
+#endif  // __MEDIA_LIBVA_VP_STATUS_H__
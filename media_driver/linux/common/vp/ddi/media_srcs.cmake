@@ -25,6 +25,7 @@ set(TMP_SOURCES_
 
 set(TMP_HEADERS_
     ${CMAKE_CURRENT_LIST_DIR}/media_libva_vp.h
+    ${CMAKE_CURRENT_LIST_DIR}/media_libva_vp_status.h
     ${CMAKE_CURRENT_LIST_DIR}/media_libva_vp_tools.h
 )
 
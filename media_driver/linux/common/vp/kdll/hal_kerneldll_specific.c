@@ -0,0 +1,160 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     hal_kerneldll_specific.c
+//! \brief    Linux file access of the persistent combined kernel cache
+//!
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include "hal_kerneldll.h"
+#include "vphal.h"
+
+//--------------------------------------------------------------
+// KernelDll_ReadDiskCacheFile - Read cache file, only from a
+//                               regular file of this user that
+//                               nobody else may write
+//--------------------------------------------------------------
+MOS_STATUS KernelDll_ReadDiskCacheFile(const char *pcFileName,
+                                       uint8_t   **ppData,
+                                       uint32_t   *puSize)
+{
+    struct stat fileStat;
+    uint8_t    *pData;
+    ssize_t     iRead;
+    size_t      uDone;
+    int         fd;
+
+    VPHAL_RENDER_CHK_NULL_RETURN(pcFileName);
+    VPHAL_RENDER_CHK_NULL_RETURN(ppData);
+    VPHAL_RENDER_CHK_NULL_RETURN(puSize);
+
+    *ppData = nullptr;
+    *puSize = 0;
+
+    // Never follow a link planted in the cache directory
+    fd = open(pcFileName, O_RDONLY | O_NOFOLLOW);
+    if (fd < 0)
+    {
+        return (errno == ENOENT) ? MOS_STATUS_FILE_NOT_FOUND : MOS_STATUS_FILE_OPEN_FAILED;
+    }
+
+    if (fstat(fd, &fileStat) != 0 ||
+        !S_ISREG(fileStat.st_mode) ||
+        fileStat.st_uid != geteuid() ||
+        (fileStat.st_mode & (S_IWGRP | S_IWOTH)) ||
+        fileStat.st_size > UINT32_MAX)
+    {
+        close(fd);
+        return MOS_STATUS_FILE_OPEN_FAILED;
+    }
+
+    pData = (uint8_t *)MOS_AllocMemory(fileStat.st_size ? fileStat.st_size : 1);
+    if (!pData)
+    {
+        close(fd);
+        return MOS_STATUS_NO_SPACE;
+    }
+
+    for (uDone = 0; uDone < (size_t)fileStat.st_size; uDone += iRead)
+    {
+        iRead = read(fd, pData + uDone, fileStat.st_size - uDone);
+        if (iRead < 0 && errno == EINTR)
+        {
+            iRead = 0;
+        }
+        else if (iRead <= 0)
+        {
+            break;
+        }
+    }
+    close(fd);
+
+    if (uDone != (size_t)fileStat.st_size)
+    {
+        MOS_FreeMemory(pData);
+        return MOS_STATUS_FILE_READ_FAILED;
+    }
+
+    *ppData = pData;
+    *puSize = (uint32_t)uDone;
+
+    return MOS_STATUS_SUCCESS;
+}
+
+//--------------------------------------------------------------
+// KernelDll_WriteDiskCacheFile - Write a private temporary file,
+//                                then replace the cache file at once
+//--------------------------------------------------------------
+MOS_STATUS KernelDll_WriteDiskCacheFile(const char    *pcFileName,
+                                        const uint8_t *pData,
+                                        uint32_t       uSize)
+{
+    char    szTempName[MOS_MAX_PATH_LENGTH];
+    ssize_t iWritten;
+    size_t  uDone;
+    bool    bResult;
+    int     fd;
+
+    VPHAL_RENDER_CHK_NULL_RETURN(pcFileName);
+    VPHAL_RENDER_CHK_NULL_RETURN(pData);
+
+    // mkstemp creates a new file readable by this user only, it never opens
+    // a file or link planted in the cache directory.
+    if (MOS_SecureStringPrint(szTempName, MOS_MAX_PATH_LENGTH, MOS_MAX_PATH_LENGTH,
+                              "%s.XXXXXX", pcFileName) >= MOS_MAX_PATH_LENGTH)
+    {
+        return MOS_STATUS_INVALID_PARAMETER;
+    }
+
+    fd = mkstemp(szTempName);
+    if (fd < 0)
+    {
+        return MOS_STATUS_FILE_OPEN_FAILED;
+    }
+
+    for (uDone = 0; uDone < uSize; uDone += iWritten)
+    {
+        iWritten = write(fd, pData + uDone, uSize - uDone);
+        if (iWritten < 0 && errno == EINTR)
+        {
+            iWritten = 0;
+        }
+        else if (iWritten <= 0)
+        {
+            break;
+        }
+    }
+
+    bResult = (close(fd) == 0) && (uDone == uSize);
+    bResult = bResult && (rename(szTempName, pcFileName) == 0);
+
+    if (!bResult)
+    {
+        unlink(szTempName);
+        return MOS_STATUS_FILE_WRITE_FAILED;
+    }
+
+    return MOS_STATUS_SUCCESS;
+}
@@ -290,6 +290,12 @@ struct mos_bo_gem {
     */
     bool exec_async;
 
+    /**
+     * ULT: set once a busy query reported this buffer busy. Waits on
+     * it from then on are stalls on the GPU and counted.
+     */
+    bool mock_reported_busy;
+
     /**
      * Size in bytes of this buffer and its relocation descendents.
      *
@@ -338,6 +344,43 @@ static inline struct mos_bo_gem *to_bo_gem(struct mos_linux_bo *bo)
 {
         return (struct mos_bo_gem *)bo;
 }
+/**
+ * ULT controls: bos allocated with mock_busy_name report busy. Live bos of that
+ * name are counted, and so are waits on them once a busy query returned true,
+ * so tests can check the driver does not stall on them. The cache flush wait on
+ * a newly written buffer comes before any busy query and is not counted.
+ */
+static const char *mock_busy_name = nullptr;
+static int mock_busy_bo_count = 0;
+static int mock_busy_wait_count = 0;
+
+static bool
+mos_gem_bo_mock_is_busy_name(struct mos_bo_gem *bo_gem)
+{
+    const char *busy_name = __atomic_load_n(&mock_busy_name, __ATOMIC_ACQUIRE);
+    return busy_name && bo_gem->name && strcmp(bo_gem->name, busy_name) == 0;
+}
+
+drm_export void
+mos_bufmgr_mock_set_busy_name(const char *name)
+{
+    __atomic_store_n(&mock_busy_bo_count, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&mock_busy_wait_count, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&mock_busy_name, name, __ATOMIC_RELEASE);
+}
+
+drm_export int
+mos_bufmgr_mock_get_busy_bo_count(void)
+{
+    return __atomic_load_n(&mock_busy_bo_count, __ATOMIC_RELAXED);
+}
+
+drm_export int
+mos_bufmgr_mock_get_busy_wait_count(void)
+{
+    return __atomic_load_n(&mock_busy_wait_count, __ATOMIC_RELAXED);
+}
+
 static int GetDrmMode()
 {
     return 1;//We always use SW Mode in libdrm mock.
@@ -762,6 +805,12 @@ mos_gem_bo_busy(struct mos_linux_bo *bo)
     struct drm_i915_gem_busy busy;
     int ret;
 
+    if (mos_gem_bo_mock_is_busy_name(bo_gem))
+    {
+        bo_gem->mock_reported_busy = true;
+        return true;
+    }
+
     if (bo_gem->reusable && bo_gem->idle)
         return false;
 
@@ -913,6 +962,9 @@ mos_gem_bo_alloc_internal(struct mos_bufmgr *bufmgr,
         bo_gem->bo.handle = -1;
         bo_gem->bo.bufmgr = bufmgr;
         bo_gem->bo.align = alignment;
+        bo_gem->name = name;
+        if (mos_gem_bo_mock_is_busy_name(bo_gem))
+            __atomic_add_fetch(&mock_busy_bo_count, 1, __ATOMIC_RELAXED);
 #ifdef __cplusplus
             bo_gem->bo.virt = malloc(bo_size);
             bo_gem->mem_virtual = bo_gem->bo.virt;
@@ -1383,6 +1435,8 @@ mos_gem_bo_free(struct mos_linux_bo *bo)
     int ret;
     if(GetDrmMode())//libdrm_mock
     {
+        if (mos_gem_bo_mock_is_busy_name(bo_gem))
+            __atomic_sub_fetch(&mock_busy_bo_count, 1, __ATOMIC_RELAXED);
         free(bo_gem->mem_virtual);
         free(bo);
         return;
@@ -2073,6 +2127,9 @@ mos_gem_get_pipe_from_crtc_id(struct mos_bufmgr *bufmgr, int crtc_id)
 static void
 mos_gem_bo_wait_rendering(struct mos_linux_bo *bo)
 {
+    if (((struct mos_bo_gem *) bo)->mock_reported_busy)
+        __atomic_add_fetch(&mock_busy_wait_count, 1, __ATOMIC_RELAXED);
+
     mos_gem_bo_start_gtt_access(bo, 1);
 }
 
@@ -2107,7 +2164,11 @@ drm_export int
 mos_gem_bo_wait(struct mos_linux_bo *bo, int64_t timeout_ns)
 {
     if(GetDrmMode())
+    {
+        if (((struct mos_bo_gem *) bo)->mock_reported_busy)
+            __atomic_add_fetch(&mock_busy_wait_count, 1, __ATOMIC_RELAXED);
         return 0; //libdrm_mock
+    }
 
     struct mos_bufmgr_gem *bufmgr_gem = (struct mos_bufmgr_gem *) bo->bufmgr;
     struct mos_bo_gem *bo_gem = (struct mos_bo_gem *) bo;
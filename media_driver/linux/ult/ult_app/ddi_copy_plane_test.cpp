@@ -0,0 +1,128 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <string.h>
+#include <random>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+#include "mos_os.h"
+#include "media_libva_util.h"
+
+using namespace std;
+
+// DdiMediaUtil_CopyPlane on a media context with copy workers started directly,
+// the "Media Copy Worker Number" user setting is not read
+class DdiCopyPlaneTest : public testing::Test
+{
+protected:
+    void SetUp()
+    {
+        memset(&m_mediaCtx, 0, sizeof(m_mediaCtx));
+    }
+
+    void TearDown()
+    {
+        DdiMediaUtil_StopCopyWorkers(&m_mediaCtx);
+        EXPECT_EQ(nullptr, m_mediaCtx.pCopyWorkers);
+    }
+
+    // Copies a random plane and checks every row and the dst padding
+    void CheckCopy(uint32_t dstPitch, uint32_t srcPitch, uint32_t height, bool srcUncached, uint32_t seed)
+    {
+        mt19937         rng(seed);
+        vector<uint8_t> src((size_t)srcPitch * height);
+        vector<uint8_t> dst((size_t)dstPitch * height, 0xcd);
+        for (auto &byte : src)
+        {
+            byte = (uint8_t)rng();
+        }
+
+        DdiMediaUtil_CopyPlane(&m_mediaCtx, dst.data(), dstPitch, src.data(), srcPitch, height, srcUncached);
+
+        uint32_t rowSize = min(dstPitch, srcPitch);
+        for (uint32_t y = 0; y < height; y++)
+        {
+            const uint8_t *dstRow = &dst[(size_t)y * dstPitch];
+            ASSERT_EQ(0, memcmp(dstRow, &src[(size_t)y * srcPitch], rowSize))
+                << "pitch " << dstPitch << "/" << srcPitch << ", height " << height << ", row " << y;
+            for (uint32_t x = rowSize; x < dstPitch; x++)
+            {
+                ASSERT_EQ(0xcd, dstRow[x]) << "padding written, row " << y << ", x " << x;
+            }
+        }
+    }
+
+    void CheckCopies()
+    {
+        // 4 MB and up are split into bands, heights not divisible by the band count
+        CheckCopy(4096, 4096, 1088, false, 1);
+        CheckCopy(4096, 4096, 1087, true, 2);
+        CheckCopy(4096, 3840, 2160, false, 3);
+        CheckCopy(3840, 4096, 1621, true, 4);
+        // fewer rows than bands
+        CheckCopy(4 << 20, 4 << 20, 2, false, 5);
+        // copied by the calling thread only
+        CheckCopy(2048, 1920, 100, false, 6);
+    }
+
+    DDI_MEDIA_CONTEXT m_mediaCtx;
+};
+
+TEST_F(DdiCopyPlaneTest, NoWorkers)
+{
+    ASSERT_EQ(VA_STATUS_SUCCESS, DdiMediaUtil_StartCopyWorkers(&m_mediaCtx, 0));
+    EXPECT_EQ(nullptr, m_mediaCtx.pCopyWorkers);
+    CheckCopies();
+}
+
+TEST_F(DdiCopyPlaneTest, Workers)
+{
+    for (uint32_t workerNum = 1; workerNum <= 4; workerNum++)
+    {
+        ASSERT_EQ(VA_STATUS_SUCCESS, DdiMediaUtil_StartCopyWorkers(&m_mediaCtx, workerNum));
+        ASSERT_NE(nullptr, m_mediaCtx.pCopyWorkers) << workerNum << " workers";
+        CheckCopies();
+        DdiMediaUtil_StopCopyWorkers(&m_mediaCtx);
+    }
+}
+
+TEST_F(DdiCopyPlaneTest, ConcurrentCallers)
+{
+    // one caller gets the workers, the others copy serially
+    ASSERT_EQ(VA_STATUS_SUCCESS, DdiMediaUtil_StartCopyWorkers(&m_mediaCtx, 3));
+    ASSERT_NE(nullptr, m_mediaCtx.pCopyWorkers);
+
+    vector<thread> callers;
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        callers.emplace_back([this, i] {
+            for (uint32_t j = 0; j < 8; j++)
+            {
+                CheckCopy(4096, 4096, 1088 + i, j % 2, i * 8 + j);
+            }
+        });
+    }
+    for (auto &caller : callers)
+    {
+        caller.join();
+    }
+}
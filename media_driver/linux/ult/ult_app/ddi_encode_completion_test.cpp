@@ -0,0 +1,304 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <errno.h>
+#include <vector>
+#include "gtest/gtest.h"
+#include "media_ddi_encode_completion.h"
+
+// Fake time, only moved by the bo waits and the polls of the test
+struct FakeClock
+{
+    typedef std::chrono::nanoseconds        duration;
+    typedef duration::rep                   rep;
+    typedef duration::period                period;
+    typedef std::chrono::time_point<FakeClock> time_point;
+    static const bool                       is_steady = true;
+
+    static time_point now()
+    {
+        return m_now;
+    }
+
+    static time_point m_now;
+};
+
+FakeClock::time_point FakeClock::m_now;
+
+// Fake bufmgr: a bo turns idle at a given time and counts its references.
+// A wait moves the time to the idle time or the timeout, like DRM_IOCTL_I915_GEM_WAIT.
+struct MockBo
+{
+    FakeClock::time_point idleTime;
+    int32_t               refCount;
+};
+
+static void ReferenceBo(void *bo)
+{
+    static_cast<MockBo *>(bo)->refCount++;
+}
+
+static void UnreferenceBo(void *bo)
+{
+    static_cast<MockBo *>(bo)->refCount--;
+}
+
+class DdiEncodeCompletionTest : public testing::Test
+{
+protected:
+    void SetUp()
+    {
+        FakeClock::m_now = FakeClock::time_point();
+        m_completion     = {};
+        m_waitError      = 0;
+        m_queryCount     = 0;
+        m_pollCount      = 0;
+        m_lastTimeoutNs  = 0;
+    }
+
+    static FakeClock::time_point After(uint32_t ms)
+    {
+        return FakeClock::time_point() + std::chrono::milliseconds(ms);
+    }
+
+    void Add(MockBo *bo)
+    {
+        DdiEncode_AddCompletionBo(&m_completion, bo, ReferenceBo);
+    }
+
+    int WaitBo(void *bo, int64_t timeoutNs)
+    {
+        m_waited.push_back(static_cast<MockBo *>(bo));
+        m_lastTimeoutNs = timeoutNs;
+        if (m_waitError)
+        {
+            return m_waitError;
+        }
+        auto timeout     = FakeClock::now() + std::chrono::nanoseconds(timeoutNs);
+        auto idle        = static_cast<MockBo *>(bo)->idleTime;
+        FakeClock::m_now = idle < timeout ? idle : timeout;
+        return FakeClock::now() >= idle ? 0 : -ETIME;
+    }
+
+    void Poll(uint32_t us)
+    {
+        m_pollCount++;
+        FakeClock::m_now += std::chrono::microseconds(us);
+    }
+
+    // Same shape as the status report loops: query, then wait while incomplete
+    bool WaitFrame(FakeClock::time_point statusTime, uint32_t timeoutUs, DDI_ENCODE_COMPLETION *completion)
+    {
+        FakeClock::time_point deadline = FakeClock::now() + std::chrono::microseconds(timeoutUs);
+        while (true)
+        {
+            m_queryCount++;
+            if (FakeClock::now() >= statusTime)
+            {
+                return true;
+            }
+            if (!DdiEncode_WaitCompletion<FakeClock>(
+                    completion,
+                    deadline,
+                    [this](void *bo, int64_t timeoutNs) { return WaitBo(bo, timeoutNs); },
+                    [this](uint32_t us) { Poll(us); }))
+            {
+                return false;
+            }
+        }
+    }
+
+    DDI_ENCODE_COMPLETION m_completion;
+    std::vector<MockBo *> m_waited;
+    int                   m_waitError;
+    int64_t               m_lastTimeoutNs;
+    uint32_t              m_queryCount;
+    uint32_t              m_pollCount;
+};
+
+TEST_F(DdiEncodeCompletionTest, AddBoTakesReference)
+{
+    MockBo bo[DDI_ENCODE_COMPLETION_MAX_BO + 1] = {};
+
+    Add(nullptr);
+    EXPECT_EQ(0u, m_completion.boNum);
+
+    Add(&bo[0]);
+    Add(&bo[0]);
+    EXPECT_EQ(1u, m_completion.boNum);
+    EXPECT_EQ(1, bo[0].refCount);
+
+    for (auto &b : bo)
+    {
+        Add(&b);
+    }
+    EXPECT_EQ((uint32_t)DDI_ENCODE_COMPLETION_MAX_BO, m_completion.boNum);
+    for (uint32_t i = 0; i < DDI_ENCODE_COMPLETION_MAX_BO; i++)
+    {
+        EXPECT_EQ(1, bo[i].refCount);
+    }
+    // not registered, not referenced
+    EXPECT_EQ(0, bo[DDI_ENCODE_COMPLETION_MAX_BO].refCount);
+}
+
+TEST_F(DdiEncodeCompletionTest, ResetReleasesReferences)
+{
+    MockBo bo[2] = {};
+    Add(&bo[0]);
+    Add(&bo[1]);
+    m_completion.boWaited = 1;
+
+    DdiEncode_ResetCompletion(&m_completion, UnreferenceBo);
+    EXPECT_EQ(0u, m_completion.boNum);
+    EXPECT_EQ(0u, m_completion.boWaited);
+    EXPECT_EQ(0, bo[0].refCount);
+    EXPECT_EQ(0, bo[1].refCount);
+
+    // the slot is reset again when it is reused, nothing left to release
+    DdiEncode_ResetCompletion(&m_completion, UnreferenceBo);
+    EXPECT_EQ(0, bo[0].refCount);
+}
+
+TEST_F(DdiEncodeCompletionTest, RemoveBoReleasesReference)
+{
+    MockBo bo[3] = {};
+    for (auto &b : bo)
+    {
+        Add(&b);
+    }
+    m_completion.boWaited = 2;
+
+    // buffer of a waited bo removed from the status report queue
+    DdiEncode_RemoveCompletionBo(&m_completion, &bo[0], UnreferenceBo);
+    EXPECT_EQ(0, bo[0].refCount);
+    EXPECT_EQ(2u, m_completion.boNum);
+    EXPECT_EQ(1u, m_completion.boWaited);
+    EXPECT_EQ(&bo[1], m_completion.bo[0]);
+    EXPECT_EQ(&bo[2], m_completion.bo[1]);
+
+    // not waited yet
+    DdiEncode_RemoveCompletionBo(&m_completion, &bo[2], UnreferenceBo);
+    EXPECT_EQ(0, bo[2].refCount);
+    EXPECT_EQ(1u, m_completion.boNum);
+    EXPECT_EQ(1u, m_completion.boWaited);
+
+    // not in the slot
+    DdiEncode_RemoveCompletionBo(&m_completion, &bo[2], UnreferenceBo);
+    EXPECT_EQ(0, bo[2].refCount);
+    EXPECT_EQ(1u, m_completion.boNum);
+    EXPECT_EQ(1, bo[1].refCount);
+}
+
+TEST_F(DdiEncodeCompletionTest, RemovedBoIsNotWaited)
+{
+    MockBo bo[2] = {{After(30)}, {After(10)}};
+    Add(&bo[0]);
+    Add(&bo[1]);
+    DdiEncode_RemoveCompletionBo(&m_completion, &bo[0], UnreferenceBo);
+
+    EXPECT_TRUE(WaitFrame(After(10), 1000000, &m_completion));
+    ASSERT_EQ(1u, m_waited.size());
+    EXPECT_EQ(&bo[1], m_waited[0]);
+    EXPECT_EQ(After(10), FakeClock::now());
+}
+
+TEST_F(DdiEncodeCompletionTest, BlockOnBoUntilComplete)
+{
+    MockBo bo = {After(30)};
+    Add(&bo);
+
+    EXPECT_TRUE(WaitFrame(After(30), 1000000, &m_completion));
+    EXPECT_EQ(After(30), FakeClock::now());
+    EXPECT_EQ(1u, m_waited.size());
+    // one query before the wait, one after, no polling
+    EXPECT_EQ(2u, m_queryCount);
+    EXPECT_EQ(0u, m_pollCount);
+}
+
+TEST_F(DdiEncodeCompletionTest, WaitEachBo)
+{
+    MockBo bo[3] = {{After(5)}, {After(10)}, {After(20)}};
+    for (auto &b : bo)
+    {
+        Add(&b);
+    }
+
+    EXPECT_TRUE(WaitFrame(After(20), 1000000, &m_completion));
+    ASSERT_EQ(3u, m_waited.size());
+    EXPECT_EQ(&bo[0], m_waited[0]);
+    EXPECT_EQ(&bo[2], m_waited[2]);
+    EXPECT_EQ(4u, m_queryCount);
+    EXPECT_EQ(0u, m_pollCount);
+}
+
+TEST_F(DdiEncodeCompletionTest, PollWhenStatusLaterThanBo)
+{
+    // e.g. the status is stored by a batch that does not use the coded buffer
+    MockBo bo = {After(10)};
+    Add(&bo);
+
+    EXPECT_TRUE(WaitFrame(After(20), 1000000, &m_completion));
+    EXPECT_EQ(After(20), FakeClock::now());
+    EXPECT_EQ(1u, m_waited.size());
+    EXPECT_EQ(10000u / DDI_ENCODE_COMPLETION_POLL_US, m_pollCount);
+    EXPECT_EQ(m_pollCount + 2, m_queryCount);
+}
+
+TEST_F(DdiEncodeCompletionTest, PollWhenWaitFails)
+{
+    MockBo bo = {After(10)};
+    Add(&bo);
+    m_waitError = -EINVAL;
+
+    EXPECT_TRUE(WaitFrame(After(10), 1000000, &m_completion));
+    EXPECT_EQ(1u, m_waited.size());
+    EXPECT_EQ(10000u / DDI_ENCODE_COMPLETION_POLL_US, m_pollCount);
+}
+
+TEST_F(DdiEncodeCompletionTest, PollWithoutCompletion)
+{
+    EXPECT_TRUE(WaitFrame(After(5), 1000000, nullptr));
+    EXPECT_EQ(0u, m_waited.size());
+    EXPECT_EQ(5000u / DDI_ENCODE_COMPLETION_POLL_US, m_pollCount);
+}
+
+TEST_F(DdiEncodeCompletionTest, TimeoutWhenBoStaysBusy)
+{
+    // hung frame: the bo wait is bounded by the deadline, not by the bo
+    MockBo bo = {After(10000)};
+    Add(&bo);
+
+    EXPECT_FALSE(WaitFrame(After(10000), 20000, &m_completion));
+    EXPECT_EQ(20000000, m_lastTimeoutNs);
+    EXPECT_EQ(After(20), FakeClock::now());
+    EXPECT_EQ(1u, m_waited.size());
+    EXPECT_EQ(0u, m_pollCount);
+}
+
+TEST_F(DdiEncodeCompletionTest, TimeoutWhenStatusNeverWritten)
+{
+    MockBo bo = {After(5)};
+    Add(&bo);
+
+    EXPECT_FALSE(WaitFrame(After(10000), 20000, &m_completion));
+    EXPECT_EQ(After(20), FakeClock::now());
+    EXPECT_EQ(15000u / DDI_ENCODE_COMPLETION_POLL_US, m_pollCount);
+}
@@ -0,0 +1,193 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+#include "driver_loader.h"
+
+using namespace std;
+
+// VA object heaps hand out IDs lock-free and tag them with a generation, so an ID
+// stays invalid after its object is destroyed even when the element is reused.
+class DdiHeapTest : public testing::Test
+{
+protected:
+    void SetUp()
+    {
+        ASSERT_EQ(VA_STATUS_SUCCESS, m_driverLoader.InitDriver(m_driverLoader.GetPlatforms()[0]));
+        m_ctx = &m_driverLoader.m_ctx;
+    }
+
+    void TearDown()
+    {
+        m_driverLoader.CloseDriver();
+    }
+
+    VAStatus CreateImage(VAImage &image)
+    {
+        VAImageFormat format = {};
+        format.fourcc        = VA_FOURCC_NV12;
+        return m_ctx->vtable->vaCreateImage(m_ctx, &format, 16, 16, &image);
+    }
+
+    // Image and its buffer both resolve and carry the tag written through the mapping
+    bool CheckImage(const VAImage &image, uint32_t tag)
+    {
+        void *data = nullptr;
+        if (m_ctx->vtable->vaMapBuffer(m_ctx, image.buf, &data) != VA_STATUS_SUCCESS || data == nullptr)
+        {
+            return false;
+        }
+        bool ok = *(uint32_t *)data == tag;
+        m_ctx->vtable->vaUnmapBuffer(m_ctx, image.buf);
+        return ok;
+    }
+
+    bool WriteImage(const VAImage &image, uint32_t tag)
+    {
+        void *data = nullptr;
+        if (m_ctx->vtable->vaMapBuffer(m_ctx, image.buf, &data) != VA_STATUS_SUCCESS || data == nullptr)
+        {
+            return false;
+        }
+        *(uint32_t *)data = tag;
+        m_ctx->vtable->vaUnmapBuffer(m_ctx, image.buf);
+        return true;
+    }
+
+    DriverDllLoader  m_driverLoader;
+    VADriverContextP m_ctx = nullptr;
+};
+
+TEST_F(DdiHeapTest, StaleIdRejectedAfterReuse)
+{
+    VAImage first = {};
+    ASSERT_EQ(VA_STATUS_SUCCESS, CreateImage(first));
+    ASSERT_EQ(VA_STATUS_SUCCESS, m_ctx->vtable->vaDestroyImage(m_ctx, first.image_id));
+
+    // The free lists are LIFO, every new image reuses the elements just released.
+    // IDs must not repeat before the generation wraps.
+    vector<VAImageID>  imageIds = {first.image_id};
+    vector<VABufferID> bufIds   = {first.buf};
+    for (uint32_t i = 0; i < 2000; i++)
+    {
+        VAImage image = {};
+        ASSERT_EQ(VA_STATUS_SUCCESS, CreateImage(image));
+        EXPECT_EQ(first.image_id & 0xfffff, image.image_id & 0xfffff);
+        imageIds.push_back(image.image_id);
+        bufIds.push_back(image.buf);
+
+        void *data = nullptr;
+        EXPECT_NE(VA_STATUS_SUCCESS, m_ctx->vtable->vaMapBuffer(m_ctx, first.buf, &data));
+        EXPECT_NE(VA_STATUS_SUCCESS, m_ctx->vtable->vaDestroyImage(m_ctx, first.image_id));
+
+        ASSERT_EQ(VA_STATUS_SUCCESS, m_ctx->vtable->vaDestroyImage(m_ctx, image.image_id));
+    }
+
+    sort(imageIds.begin(), imageIds.end());
+    sort(bufIds.begin(), bufIds.end());
+    EXPECT_TRUE(adjacent_find(imageIds.begin(), imageIds.end()) == imageIds.end());
+    EXPECT_TRUE(adjacent_find(bufIds.begin(), bufIds.end()) == bufIds.end());
+}
+
+TEST_F(DdiHeapTest, ConcurrentCreateDestroy)
+{
+    const uint32_t threadNum  = 8;
+    const uint32_t iterations = 2000;
+    atomic<uint32_t> errors(0);
+
+    auto worker = [&](uint32_t seed) {
+        mt19937                       rng(seed);
+        vector<pair<VAImage, uint32_t>> live;
+        vector<VAImage>               dead;
+        for (uint32_t i = 0; i < iterations; i++)
+        {
+            uint32_t op = rng() % 4;
+            if (op < 2 || live.empty())
+            {
+                VAImage  image = {};
+                uint32_t tag   = seed << 16 | i;
+                if (CreateImage(image) != VA_STATUS_SUCCESS || !WriteImage(image, tag))
+                {
+                    errors++;
+                    continue;
+                }
+                live.push_back({image, tag});
+            }
+            else if (op == 2)
+            {
+                // objects of this thread are untouched by the others
+                auto &entry = live[rng() % live.size()];
+                if (!CheckImage(entry.first, entry.second))
+                {
+                    errors++;
+                }
+            }
+            else
+            {
+                size_t idx = rng() % live.size();
+                VAImage image = live[idx].first;
+                live[idx]     = live.back();
+                live.pop_back();
+                if (m_ctx->vtable->vaDestroyImage(m_ctx, image.image_id) != VA_STATUS_SUCCESS)
+                {
+                    errors++;
+                }
+                dead.push_back(image);
+            }
+
+            // IDs destroyed earlier stay invalid while other threads reuse their elements
+            if (!dead.empty() && i % 16 == 0)
+            {
+                VAImage &image = dead[rng() % dead.size()];
+                void    *data  = nullptr;
+                if (m_ctx->vtable->vaMapBuffer(m_ctx, image.buf, &data) == VA_STATUS_SUCCESS)
+                {
+                    errors++;
+                }
+            }
+        }
+        for (auto &entry : live)
+        {
+            if (!CheckImage(entry.first, entry.second) ||
+                m_ctx->vtable->vaDestroyImage(m_ctx, entry.first.image_id) != VA_STATUS_SUCCESS)
+            {
+                errors++;
+            }
+        }
+    };
+
+    vector<thread> threads;
+    for (uint32_t i = 0; i < threadNum; i++)
+    {
+        threads.emplace_back(worker, i + 1);
+    }
+    for (auto &t : threads)
+    {
+        t.join();
+    }
+
+    EXPECT_EQ(0u, errors.load());
+}
@@ -20,6 +20,7 @@
 * OTHER DEALINGS IN THE SOFTWARE.
 */
 #include <algorithm>
+#include <set>
 #include <string>
 #include "ddi_test_caps.h"
 
@@ -112,6 +113,251 @@ TEST_F(MediaCapsDdiTest, DecodeEncodeProfile)
     }
 }
 
+// vaGetConfigAttributes, vaCreateConfig and vaQueryConfigAttributes go through the caps
+// lookup index, while vaQueryConfigEntrypoints still scans the profile table.
+TEST_F(MediaCapsDdiTest, ConfigLookup)
+{
+    vector<Platform_t> platforms = m_driverLoader.GetPlatforms();
+
+    for (int i = 0; i < m_driverLoader.GetPlatformNum(); i++)
+    {
+        int ret = m_driverLoader.InitDriver(platforms[i]);
+        EXPECT_EQ(VA_STATUS_SUCCESS , ret) << "Platform = " << g_platformName[platforms[i]]
+            << ", Failed function = m_driverLoader.InitDriver" << endl;
+
+        VADriverContextP  ctx = &m_driverLoader.m_ctx;
+        vector<FeatureID> features;
+        ret = Test_QueryConfigProfiles(ctx, features);
+        EXPECT_EQ(VA_STATUS_SUCCESS , ret) << "Platform = " << g_platformName[platforms[i]]
+            << ", Failed function = Test_QueryConfigProfiles" << endl;
+
+        set<int32_t> profiles    = {VAProfileVP9Profile3, 1000};
+        set<int32_t> entrypoints = {VAEntrypointIZZ, 1000};
+        for (auto &feature : features)
+        {
+            profiles.insert(feature.profile);
+            entrypoints.insert(feature.entrypoint);
+        }
+
+        vector<VAConfigAttrib> attribs(VAConfigAttribTypeMax);
+        vector<VAConfigAttrib> queriedAttribs(VAConfigAttribTypeMax);
+        for (auto profile : profiles)
+        {
+            bool profileSupported = any_of(features.begin(), features.end(), [=](const FeatureID &feature) {
+                return feature.profile == profile;
+            });
+
+            for (auto entrypoint : entrypoints)
+            {
+                FeatureID feature   = {(VAProfile)profile, (VAEntrypoint)entrypoint};
+                bool      supported = find(features.begin(), features.end(), feature) != features.end();
+                VAStatus  expected  = supported ? VA_STATUS_SUCCESS :
+                                      (profileSupported ? VA_STATUS_ERROR_UNSUPPORTED_ENTRYPOINT : VA_STATUS_ERROR_UNSUPPORTED_PROFILE);
+
+                for (uint32_t type = 0; type < attribs.size(); type++)
+                {
+                    attribs[type].type  = (VAConfigAttribType)type;
+                    attribs[type].value = 0;
+                }
+                ret = ctx->vtable->vaGetConfigAttributes(ctx, feature.profile, feature.entrypoint, attribs.data(), attribs.size());
+                EXPECT_EQ(expected, ret) << "Platform = " << g_platformName[platforms[i]]
+                    << ", profile = " << profile << ", entrypoint = " << entrypoint
+                    << ", Failed function = vaGetConfigAttributes" << endl;
+
+                VAConfigID configId = VA_INVALID_ID;
+                ret = ctx->vtable->vaCreateConfig(ctx, feature.profile, feature.entrypoint, nullptr, 0, &configId);
+                if (!supported)
+                {
+                    EXPECT_EQ(expected, ret) << "Platform = " << g_platformName[platforms[i]]
+                        << ", profile = " << profile << ", entrypoint = " << entrypoint
+                        << ", Failed function = vaCreateConfig" << endl;
+                    continue;
+                }
+                if (ret != VA_STATUS_SUCCESS)
+                {
+                    // e.g. entrypoint needs attributes to create a config
+                    continue;
+                }
+
+                VAProfile    queriedProfile    = VAProfileNone;
+                VAEntrypoint queriedEntrypoint = (VAEntrypoint)0;
+                int32_t      numAttribs        = 0;
+                ret = ctx->vtable->vaQueryConfigAttributes(ctx, configId, &queriedProfile, &queriedEntrypoint,
+                    queriedAttribs.data(), &numAttribs);
+                EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platforms[i]]
+                    << ", profile = " << profile << ", entrypoint = " << entrypoint
+                    << ", Failed function = vaQueryConfigAttributes" << endl;
+                EXPECT_EQ(feature.profile, queriedProfile);
+                EXPECT_EQ(feature.entrypoint, queriedEntrypoint);
+                for (int32_t j = 0; j < numAttribs; j++)
+                {
+                    ASSERT_LT((uint32_t)queriedAttribs[j].type, attribs.size());
+                    EXPECT_EQ(attribs[queriedAttribs[j].type].value, queriedAttribs[j].value)
+                        << "Platform = " << g_platformName[platforms[i]] << ", profile = " << profile
+                        << ", entrypoint = " << entrypoint << ", attribute = " << queriedAttribs[j].type << endl;
+                }
+
+                ctx->vtable->vaDestroyConfig(ctx, configId);
+            }
+        }
+
+        ret = m_driverLoader.CloseDriver();
+        EXPECT_EQ (VA_STATUS_SUCCESS , ret) << "Platform = " << g_platformName[platforms[i]]
+            << ", Failed function = m_driverLoader.CloseDriver" << endl;
+    }
+}
+
+// Result of one caps lookup through the DDI
+struct CapsLookup
+{
+    string   call;
+    uint32_t result;
+
+    bool operator==(const CapsLookup &other) const
+    {
+        return call == other.call && result == other.result;
+    }
+};
+
+// Looks up the caps by profile & entrypoint, with and without attributes to check, and by config id
+void Test_CollectConfigLookups(VADriverContextP ctx, const vector<FeatureID> &features, vector<CapsLookup> &lookups)
+{
+    set<int32_t> profiles    = {-2, 1000};
+    set<int32_t> entrypoints = {0, 1000};
+    for (auto &feature : features)
+    {
+        profiles.insert({feature.profile - 1, feature.profile, feature.profile + 1});
+        entrypoints.insert({feature.entrypoint - 1, feature.entrypoint, feature.entrypoint + 1});
+    }
+
+    vector<VAConfigAttrib> attribs(VAConfigAttribTypeMax);
+    for (auto profile : profiles)
+    {
+        for (auto entrypoint : entrypoints)
+        {
+            string     pair   = "profile " + to_string(profile) + ", entrypoint " + to_string(entrypoint);
+            VAConfigID config = VA_INVALID_ID;
+            VAStatus   ret    = ctx->vtable->vaCreateConfig(ctx, (VAProfile)profile, (VAEntrypoint)entrypoint, nullptr, 0, &config);
+            lookups.push_back({"vaCreateConfig, " + pair, (uint32_t)ret});
+            if (ret == VA_STATUS_SUCCESS)
+            {
+                lookups.push_back({"vaCreateConfig, " + pair + ", config", config});
+                ctx->vtable->vaDestroyConfig(ctx, config);
+            }
+
+            for (uint32_t type = 0; type < attribs.size(); type++)
+            {
+                attribs[type].type  = (VAConfigAttribType)type;
+                attribs[type].value = 0;
+            }
+            ret = ctx->vtable->vaGetConfigAttributes(ctx, (VAProfile)profile, (VAEntrypoint)entrypoint, attribs.data(), attribs.size());
+            lookups.push_back({"vaGetConfigAttributes, " + pair, (uint32_t)ret});
+            if (ret != VA_STATUS_SUCCESS)
+            {
+                continue;
+            }
+
+            for (auto &attrib : attribs)
+            {
+                string type = ", attribute " + to_string(attrib.type);
+                lookups.push_back({"vaGetConfigAttributes, " + pair + type, attrib.value});
+                if (attrib.value == VA_ATTRIB_NOT_SUPPORTED)
+                {
+                    continue;
+                }
+
+                // The supported value, and values CheckAttribList may reject
+                for (uint32_t value : {attrib.value, attrib.value + 1, 0u})
+                {
+                    VAConfigAttrib requested = {attrib.type, value};
+                    string         call      = "vaCreateConfig, " + pair + type + " = " + to_string(value);
+                    ret = ctx->vtable->vaCreateConfig(ctx, (VAProfile)profile, (VAEntrypoint)entrypoint, &requested, 1, &config);
+                    lookups.push_back({call, (uint32_t)ret});
+                    if (ret == VA_STATUS_SUCCESS)
+                    {
+                        lookups.push_back({call + ", config", config});
+                        ctx->vtable->vaDestroyConfig(ctx, config);
+                    }
+                }
+            }
+        }
+    }
+
+    // Decode, encode, VP and CP config ids, up to past the CP config id base
+    const VAConfigID       maxConfigId = 4096 + 64;
+    vector<VAConfigAttrib> queriedAttribs(ctx->max_attributes);
+    for (VAConfigID config = 0; config < maxConfigId; config++)
+    {
+        VAProfile    profile    = VAProfileNone;
+        VAEntrypoint entrypoint = (VAEntrypoint)0;
+        int32_t      numAttribs = 0;
+        string       call       = "vaQueryConfigAttributes, config " + to_string(config);
+        VAStatus     ret        = ctx->vtable->vaQueryConfigAttributes(ctx, config, &profile, &entrypoint,
+            queriedAttribs.data(), &numAttribs);
+        lookups.push_back({call, (uint32_t)ret});
+        if (ret != VA_STATUS_SUCCESS)
+        {
+            continue;
+        }
+
+        lookups.push_back({call + ", profile", (uint32_t)profile});
+        lookups.push_back({call + ", entrypoint", (uint32_t)entrypoint});
+        for (int32_t j = 0; j < numAttribs; j++)
+        {
+            lookups.push_back({call + ", attribute " + to_string(queriedAttribs[j].type), queriedAttribs[j].value});
+        }
+    }
+}
+
+// The caps lookups give the same results with the profile index as by scanning the profile table
+TEST_F(MediaCapsDdiTest, ConfigLookupIndex)
+{
+    vector<Platform_t> platforms = m_driverLoader.GetPlatforms();
+
+    for (int i = 0; i < m_driverLoader.GetPlatformNum(); i++)
+    {
+        int ret = m_driverLoader.InitDriver(platforms[i]);
+        EXPECT_EQ(VA_STATUS_SUCCESS , ret) << "Platform = " << g_platformName[platforms[i]]
+            << ", Failed function = m_driverLoader.InitDriver" << endl;
+
+        VADriverContextP  ctx = &m_driverLoader.m_ctx;
+        vector<FeatureID> features;
+        ret = Test_QueryConfigProfiles(ctx, features);
+        EXPECT_EQ(VA_STATUS_SUCCESS , ret) << "Platform = " << g_platformName[platforms[i]]
+            << ", Failed function = Test_QueryConfigProfiles" << endl;
+
+        auto               setCapsProfileIndex = m_driverLoader.GetDriverSymbols().DdiMedia_UltSetCapsProfileIndex;
+        vector<CapsLookup> indexed;
+        vector<CapsLookup> scanned;
+
+        ret = setCapsProfileIndex(ctx, true);
+        EXPECT_EQ(VA_STATUS_SUCCESS , ret) << "Platform = " << g_platformName[platforms[i]]
+            << ", Failed function = DdiMedia_UltSetCapsProfileIndex" << endl;
+        Test_CollectConfigLookups(ctx, features, indexed);
+
+        ret = setCapsProfileIndex(ctx, false);
+        EXPECT_EQ(VA_STATUS_SUCCESS , ret) << "Platform = " << g_platformName[platforms[i]]
+            << ", Failed function = DdiMedia_UltSetCapsProfileIndex" << endl;
+        Test_CollectConfigLookups(ctx, features, scanned);
+
+        EXPECT_EQ(scanned.size(), indexed.size()) << "Platform = " << g_platformName[platforms[i]] << endl;
+        for (uint32_t j = 0; j < min(scanned.size(), indexed.size()); j++)
+        {
+            if (!(indexed[j] == scanned[j]))
+            {
+                ADD_FAILURE() << "Platform = " << g_platformName[platforms[i]]
+                    << ", with index: " << indexed[j].call << " -> " << indexed[j].result
+                    << ", without index: " << scanned[j].call << " -> " << scanned[j].result << endl;
+                break;
+            }
+        }
+
+        ret = m_driverLoader.CloseDriver();
+        EXPECT_EQ (VA_STATUS_SUCCESS , ret) << "Platform = " << g_platformName[platforms[i]]
+            << ", Failed function = m_driverLoader.CloseDriver" << endl;
+    }
+}
+
 int testfunction(int a)
 {
     return a + 1;
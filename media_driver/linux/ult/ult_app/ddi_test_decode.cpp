@@ -39,7 +39,19 @@ TEST_F(MediaDecodeDdiTest, DecodeAVCLong)
     delete pDecData;
 }
 
-void MediaDecodeDdiTest::ExectueDecodeTest(DecTestData *pDecData)
+TEST_F(MediaDecodeDdiTest, DecodeAVCDeepPipeline)
+{
+    // Submit more frames than the bitstream buffer pool holds before syncing, with the
+    // mock reporting the bitstream buffers busy. The pool has to grow to its maximum,
+    // then hand out a bounded number of busy buffers with new graphics memory before
+    // it waits for HW.
+    m_GpuCmdFactory = g_gpuCmdFactoryDecodeAVCLong;
+    DecTestData *pDecData = m_decDataFactory.GetDecTestData("AVC-Long");
+    ExectueDecodeTest(pDecData, DEC_DEEP_PIPELINE_LOOPS, false);
+    delete pDecData;
+}
+
+void MediaDecodeDdiTest::ExectueDecodeTest(DecTestData *pDecData, int loops, bool syncEachFrame)
 {
     vector<Platform_t> platforms = m_driverLoader.GetPlatforms();
     for (int i = 0; i < m_driverLoader.GetPlatformNum(); i++)
@@ -48,12 +60,12 @@ void MediaDecodeDdiTest::ExectueDecodeTest(DecTestData *pDecData)
             pDecData->GetFeatureID()))
         {
             CmdValidator::GpuCmdsValidationInit(m_GpuCmdFactory, platforms[i]);
-            DecodeExecute(pDecData, platforms[i]);
+            DecodeExecute(pDecData, platforms[i], loops, syncEachFrame);
         }
     }
 }
 
-void MediaDecodeDdiTest::DecodeExecute(DecTestData *pDecData, Platform_t platform)
+void MediaDecodeDdiTest::DecodeExecute(DecTestData *pDecData, Platform_t platform, int loops, bool syncEachFrame)
 {
     VAConfigID      config_id;
     VAContextID     context_id;
@@ -83,8 +95,18 @@ void MediaDecodeDdiTest::DecodeExecute(DecTestData *pDecData, Platform_t platfor
     EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
         << ", Failed function = m_driverLoader.m_ctx.vtable->vaCreateContext" << endl;
 
-    for (int i = 0; i < pDecData->m_num_frames; i++)
+    // Without per frame sync, bitstream buffers stay busy as on HW that has not caught up
+    const DriverSymbols &drvSyms = m_driverLoader.GetDriverSymbols();
+    if (!syncEachFrame)
     {
+        ASSERT_TRUE(drvSyms.mos_bufmgr_mock_set_busy_name != nullptr) << "libdrm mock has no busy controls" << endl;
+        drvSyms.mos_bufmgr_mock_set_busy_name(DEC_BITSTREAM_BUFFER_NAME);
+    }
+
+    for (int n = 0; n < loops * pDecData->m_num_frames; n++)
+    {
+        int i = n % pDecData->m_num_frames;
+
         // As BeginPicture would reset some parameters, so it should be called before RenderPicture.
         ret = m_driverLoader.m_ctx.vtable->vaBeginPicture(&m_driverLoader.m_ctx, context_id, resources[0]);
         EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
@@ -113,11 +135,14 @@ void MediaDecodeDdiTest::DecodeExecute(DecTestData *pDecData, Platform_t platfor
         EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
             << ", Failed function = m_driverLoader.m_ctx.vtable->vaEndPicture" << endl;
 
-        do
+        if (syncEachFrame)
         {
-            ret = m_driverLoader.m_ctx.vtable->vaQuerySurfaceStatus(
-                &m_driverLoader.m_ctx, resources[0], &surface_status);
-        } while (surface_status != VASurfaceReady);
+            do
+            {
+                ret = m_driverLoader.m_ctx.vtable->vaQuerySurfaceStatus(
+                    &m_driverLoader.m_ctx, resources[0], &surface_status);
+            } while (surface_status != VASurfaceReady);
+        }
 
         for (int j = 0; j < compBufs[i].size(); j++)
         {
@@ -127,6 +152,24 @@ void MediaDecodeDdiTest::DecodeExecute(DecTestData *pDecData, Platform_t platfor
         }
       }
 
+    if (!syncEachFrame)
+    {
+        // The pool is full of busy buffers. The next DEC_BITSTREAM_POOL_MAX_ORPHANS frames get
+        // new graphics memory, the one after waits for HW and the rest get new memory again
+        int frames = loops * pDecData->m_num_frames;
+        EXPECT_GT(frames, DEC_BITSTREAM_POOL_MAX + DEC_BITSTREAM_POOL_MAX_ORPHANS);
+        EXPECT_LE(frames, DEC_BITSTREAM_POOL_MAX + 2 * DEC_BITSTREAM_POOL_MAX_ORPHANS + 1);
+        EXPECT_EQ(DEC_BITSTREAM_POOL_MAX, drvSyms.mos_bufmgr_mock_get_busy_bo_count()) << "Platform = "
+            << g_platformName[platform] << endl;
+        EXPECT_EQ(1, drvSyms.mos_bufmgr_mock_get_busy_wait_count()) << "Platform = "
+            << g_platformName[platform] << endl;
+        drvSyms.mos_bufmgr_mock_set_busy_name(nullptr);
+
+        ret = m_driverLoader.m_ctx.vtable->vaSyncSurface(&m_driverLoader.m_ctx, resources[0]);
+        EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
+            << ", Failed function = m_driverLoader.m_ctx.vtable->vaSyncSurface" << endl;
+    }
+
     ret = m_driverLoader.m_ctx.vtable->vaDestroySurfaces(&m_driverLoader.m_ctx, &resources[0], resources.size());
     EXPECT_EQ(VA_STATUS_SUCCESS, ret) << "Platform = " << g_platformName[platform]
         << ", Failed function = m_driverLoader.m_ctx.vtable->vaDestroySurfaces" << endl;
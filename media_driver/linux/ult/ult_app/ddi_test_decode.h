@@ -50,9 +50,9 @@ protected:
 
     virtual void TearDown() { }
 
-    void DecodeExecute(DecTestData *pDecData, Platform_t platform);
+    void DecodeExecute(DecTestData *pDecData, Platform_t platform, int loops = 1, bool syncEachFrame = true);
 
-    void ExectueDecodeTest(DecTestData *pDecData);
+    void ExectueDecodeTest(DecTestData *pDecData, int loops = 1, bool syncEachFrame = true);
 
 protected:
 
@@ -0,0 +1,307 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <map>
+#include <random>
+#include <vector>
+#include "gtest/gtest.h"
+#include "media_libva_vp_status.h"
+#include "vp_status_table.h"
+
+// Status report table of VP HAL on Linux, on the table helpers VP HAL uses: GetStatusReport
+// removes the frames done by GPU and the first one not done, and reports the frames after
+// it without removing them. Frames are done in submission order.
+class MockVpHal
+{
+public:
+    MockVpHal()
+    {
+        MOS_ZeroMemory(&m_table, sizeof(m_table));
+    }
+
+    void Submit(uint32_t statusFeedBackID)
+    {
+        PVPHAL_STATUS_ENTRY entry = VpHal_StatusTableAddEntry(&m_table, statusFeedBackID);
+        entry->dwTag              = ++m_lastTag;
+        entry->dwStatus           = VPREP_NOTREADY;
+    }
+
+    void Complete(uint32_t count)
+    {
+        m_gpuTag = std::min(m_gpuTag + count, m_lastTag);
+    }
+
+    MOS_STATUS GetStatusReport(PQUERY_STATUS_REPORT_APP pQueryReport, uint16_t numStatus)
+    {
+        m_reportCalls++;
+        uint32_t tableLen = VpHal_StatusTableLength(&m_table);
+        uint32_t newHead  = m_table.uiHead;
+        bool     notReady = false;
+        uint32_t i        = 0;
+        for (; i < numStatus && i < tableLen; i++)
+        {
+            uint32_t            index = VPHAL_STATUS_TABLE_MASK(m_table.uiHead + i);
+            PVPHAL_STATUS_ENTRY entry = &m_table.aTableEntries[index];
+            if (!notReady)
+            {
+                notReady = m_gpuTag < entry->dwTag;
+                entry->dwStatus = notReady ? VPREP_NOTREADY : VPREP_OK;
+                newHead         = VPHAL_STATUS_TABLE_MASK(index + 1);
+            }
+            pQueryReport[i].StatusFeedBackID = entry->StatusFeedBackID;
+            pQueryReport[i].dwStatus         = entry->dwStatus;
+        }
+        VpHal_StatusTableSetHead(&m_table, newHead);
+        for (; i < numStatus; i++)
+        {
+            pQueryReport[i].StatusFeedBackID = 0;
+            pQueryReport[i].dwStatus         = VPREP_NOTAVAILABLE;
+        }
+        return MOS_STATUS_SUCCESS;
+    }
+
+    MOS_STATUS GetStatusReportEntryLength(uint32_t *puiLength)
+    {
+        *puiLength = VpHal_StatusTableLength(&m_table);
+        return MOS_STATUS_SUCCESS;
+    }
+
+    MOS_STATUS GetStatusReportEntryIndex(uint32_t statusFeedBackID, uint32_t *puiIndex)
+    {
+        if (!m_hasIndex)
+        {
+            return MOS_STATUS_UNIMPLEMENTED;
+        }
+        *puiIndex = VpHal_StatusTableFindEntry(&m_table, statusFeedBackID);
+        return MOS_STATUS_SUCCESS;
+    }
+
+    uint32_t Length()
+    {
+        return VpHal_StatusTableLength(&m_table);
+    }
+
+    uint32_t HeadId()
+    {
+        return m_table.aTableEntries[m_table.uiHead].StatusFeedBackID;
+    }
+
+    VPHAL_STATUS_TABLE m_table;
+    uint32_t           m_lastTag     = 0;
+    uint32_t           m_gpuTag      = 0;
+    uint32_t           m_reportCalls = 0;
+    bool               m_hasIndex    = true;
+};
+
+// Surfaces as DdiMedia_UpdateVpStatusReport updates them: a surface without a status is pending
+class DdiVpStatusTest : public testing::Test
+{
+protected:
+    uint32_t Sync(uint32_t surfaceId)
+    {
+        return DdiVp_DrainStatusReport(&m_vpHal, m_reports, surfaceId, [this](const QUERY_STATUS_REPORT_APP &report) {
+            m_status[report.StatusFeedBackID] = report.dwStatus;
+        });
+    }
+
+    bool IsPending(uint32_t surfaceId)
+    {
+        return m_status.find(surfaceId) == m_status.end();
+    }
+
+    MockVpHal                    m_vpHal;
+    QUERY_STATUS_REPORT_APP      m_reports[VPHAL_STATUS_TABLE_MAX_SIZE];
+    std::map<uint32_t, uint32_t> m_status;
+};
+
+TEST_F(DdiVpStatusTest, TwoFramesInFlightFirstDone)
+{
+    m_vpHal.Submit(1);
+    m_vpHal.Submit(2);
+    m_vpHal.Complete(1);
+
+    EXPECT_EQ(1u, Sync(1));
+    EXPECT_EQ((uint32_t)VPREP_OK, m_status[1]);
+    EXPECT_TRUE(IsPending(2));
+    EXPECT_EQ(1u, m_vpHal.Length());
+
+    m_vpHal.Complete(1);
+    Sync(2);
+    EXPECT_EQ((uint32_t)VPREP_OK, m_status[2]);
+    EXPECT_EQ(0u, m_vpHal.Length());
+}
+
+TEST_F(DdiVpStatusTest, TwoFramesInFlightNoneDone)
+{
+    m_vpHal.Submit(1);
+    m_vpHal.Submit(2);
+
+    // the queried frame is removed not ready, the next one is left in the table
+    EXPECT_EQ(1u, Sync(1));
+    EXPECT_EQ((uint32_t)VPREP_NOTREADY, m_status[1]);
+    EXPECT_TRUE(IsPending(2));
+    ASSERT_EQ(1u, m_vpHal.Length());
+    EXPECT_EQ(2u, m_vpHal.HeadId());
+
+    m_vpHal.Complete(2);
+    Sync(2);
+    EXPECT_EQ((uint32_t)VPREP_OK, m_status[2]);
+}
+
+TEST_F(DdiVpStatusTest, TwoFramesInFlightQuerySecond)
+{
+    m_vpHal.Submit(1);
+    m_vpHal.Submit(2);
+
+    // frame 2 is behind the not ready frame 1, it is taken out by a second call
+    EXPECT_EQ(2u, Sync(2));
+    EXPECT_EQ((uint32_t)VPREP_NOTREADY, m_status[1]);
+    EXPECT_EQ((uint32_t)VPREP_NOTREADY, m_status[2]);
+    EXPECT_EQ(0u, m_vpHal.Length());
+}
+
+TEST_F(DdiVpStatusTest, AllDoneInOneCall)
+{
+    for (uint32_t i = 1; i <= 100; i++)
+    {
+        m_vpHal.Submit(i);
+    }
+    m_vpHal.Complete(100);
+
+    EXPECT_EQ(1u, Sync(60));
+    EXPECT_EQ(60u, m_status.size());
+    EXPECT_EQ((uint32_t)VPREP_OK, m_status[60]);
+    EXPECT_TRUE(IsPending(61));
+    EXPECT_EQ(40u, m_vpHal.Length());
+}
+
+TEST_F(DdiVpStatusTest, SurfaceNotInTable)
+{
+    m_vpHal.Submit(1);
+    m_vpHal.Submit(2);
+    m_vpHal.Complete(2);
+
+    Sync(3);
+    EXPECT_EQ((uint32_t)VPREP_OK, m_status[1]);
+    EXPECT_EQ((uint32_t)VPREP_OK, m_status[2]);
+    EXPECT_TRUE(IsPending(3));
+    EXPECT_EQ(0u, m_vpHal.Length());
+}
+
+TEST_F(DdiVpStatusTest, EmptyTable)
+{
+    EXPECT_EQ(0u, Sync(1));
+    EXPECT_EQ(0u, m_vpHal.m_reportCalls);
+    EXPECT_TRUE(IsPending(1));
+}
+
+TEST_F(DdiVpStatusTest, HalWithoutIndexDrainsTheTable)
+{
+    m_vpHal.m_hasIndex = false;
+    m_vpHal.Submit(1);
+    m_vpHal.Submit(2);
+    m_vpHal.Complete(2);
+
+    Sync(1);
+    EXPECT_EQ((uint32_t)VPREP_OK, m_status[2]);
+    EXPECT_EQ(0u, m_vpHal.Length());
+}
+
+// The StatusFeedBackID index of the table, checked against the scan from head it replaced
+class VpStatusTableTest : public testing::Test
+{
+protected:
+    uint32_t Scan(uint32_t statusFeedBackID)
+    {
+        uint32_t tableLen = VpHal_StatusTableLength(&m_vpHal.m_table);
+        uint32_t i        = 0;
+        while (i < tableLen &&
+               m_vpHal.m_table.aTableEntries[VPHAL_STATUS_TABLE_MASK(m_vpHal.m_table.uiHead + i)].StatusFeedBackID != statusFeedBackID)
+        {
+            i++;
+        }
+        return i;
+    }
+
+    void CheckIndex(uint32_t maxId)
+    {
+        for (uint32_t id = 0; id <= maxId; id++)
+        {
+            ASSERT_EQ(Scan(id), VpHal_StatusTableFindEntry(&m_vpHal.m_table, id)) << "id " << id;
+        }
+    }
+
+    MockVpHal               m_vpHal;
+    QUERY_STATUS_REPORT_APP m_reports[VPHAL_STATUS_TABLE_MAX_SIZE];
+};
+
+TEST_F(VpStatusTableTest, RandomSubmitAndReport)
+{
+    std::mt19937 rand(2026);
+    // few ids, so frames of one surface are in the table more than once and buckets are
+    // shared, and enough operations to wrap the table many times
+    const uint32_t maxId = 3 * VPHAL_STATUS_TABLE_ID_BUCKETS;
+    uint32_t       lastId = 0;
+    for (uint32_t op = 0; op < 20000; op++)
+    {
+        uint32_t r = rand() % 16;
+        if (r < 9 && m_vpHal.Length() < VPHAL_STATUS_TABLE_MAX_SIZE - 1)
+        {
+            // same id as the last frame now and then, it reuses the entry
+            lastId = (r == 0) ? lastId : rand() % maxId;
+            m_vpHal.Submit(lastId);
+        }
+        else if (r < 12)
+        {
+            m_vpHal.Complete(rand() % 8);
+        }
+        else
+        {
+            uint32_t num = rand() % (m_vpHal.Length() + 1);
+            m_vpHal.GetStatusReport(m_reports, (uint16_t)num);
+        }
+        if (op % 64 == 0)
+        {
+            CheckIndex(maxId);
+            if (HasFatalFailure())
+            {
+                return;
+            }
+        }
+        ASSERT_EQ(Scan(lastId), VpHal_StatusTableFindEntry(&m_vpHal.m_table, lastId));
+    }
+}
+
+TEST_F(VpStatusTableTest, Overflow)
+{
+    // the table holds one frame less than its size, one more and it reads as empty
+    for (uint32_t id = 1; id <= VPHAL_STATUS_TABLE_MAX_SIZE; id++)
+    {
+        m_vpHal.Submit(id);
+    }
+    EXPECT_EQ(0u, m_vpHal.Length());
+    CheckIndex(VPHAL_STATUS_TABLE_MAX_SIZE);
+
+    m_vpHal.Submit(7);
+    m_vpHal.Submit(8);
+    EXPECT_EQ(1u, VpHal_StatusTableFindEntry(&m_vpHal.m_table, 8));
+    CheckIndex(VPHAL_STATUS_TABLE_MAX_SIZE);
+}
@@ -161,7 +161,13 @@ VAStatus DriverDllLoader::LoadDriverSymbols()
             m_drvSyms.MOS_SetUltFlag            = (MOS_SetUltFlagFunc)dlsym(m_umdhandle, "MOS_SetUltFlag");
             m_drvSyms.MOS_GetMemNinjaCounter    = (MOS_GetMemNinjaCounterFunc)dlsym(m_umdhandle, "MOS_GetMemNinjaCounter");
             m_drvSyms.MOS_GetMemNinjaCounterGfx = (MOS_GetMemNinjaCounterFunc)dlsym(m_umdhandle, "MOS_GetMemNinjaCounterGfx");
+            m_drvSyms.DdiMedia_UltSetCapsProfileIndex = (DdiMedia_UltSetCapsProfileIndexFunc)dlsym(m_umdhandle, "DdiMedia_UltSetCapsProfileIndex");
             m_drvSyms.ppfnUltGetCmdBuf          = (UltGetCmdBufFunc *)dlsym(m_umdhandle, "pfnUltGetCmdBuf");
+
+            // libdrm mock is preloaded, not a dependency of the driver
+            m_drvSyms.mos_bufmgr_mock_set_busy_name       = (MockSetBusyNameFunc)dlsym(RTLD_DEFAULT, "mos_bufmgr_mock_set_busy_name");
+            m_drvSyms.mos_bufmgr_mock_get_busy_bo_count   = (MockGetCountFunc)dlsym(RTLD_DEFAULT, "mos_bufmgr_mock_get_busy_bo_count");
+            m_drvSyms.mos_bufmgr_mock_get_busy_wait_count = (MockGetCountFunc)dlsym(RTLD_DEFAULT, "mos_bufmgr_mock_get_busy_wait_count");
             break;
         }
     }
@@ -80,6 +80,12 @@ typedef int32_t (*MOS_GetMemNinjaCounterFunc)();
 
 typedef void (*UltGetCmdBufFunc)(PMOS_COMMAND_BUFFER pCmdBuffer);
 
+typedef VAStatus (*DdiMedia_UltSetCapsProfileIndexFunc)(VADriverContextP ctx, bool enable);
+
+typedef void (*MockSetBusyNameFunc)(const char *name);
+
+typedef int (*MockGetCountFunc)();
+
 struct DriverSymbols
 {
     bool Initialized() const
@@ -89,6 +95,7 @@ struct DriverSymbols
             !MOS_SetUltFlag            ||
             !MOS_GetMemNinjaCounter    ||
             !MOS_GetMemNinjaCounterGfx ||
+            !DdiMedia_UltSetCapsProfileIndex ||
             !ppfnUltGetCmdBuf)
         {
             return false;
@@ -102,6 +109,12 @@ struct DriverSymbols
     MOS_SetUltFlagFunc          MOS_SetUltFlag;
     MOS_GetMemNinjaCounterFunc  MOS_GetMemNinjaCounter;
     MOS_GetMemNinjaCounterFunc  MOS_GetMemNinjaCounterGfx;
+    DdiMedia_UltSetCapsProfileIndexFunc DdiMedia_UltSetCapsProfileIndex;
+
+    // libdrm mock controls, only set when the driver is linked with the in-tree mock
+    MockSetBusyNameFunc         mos_bufmgr_mock_set_busy_name;
+    MockGetCountFunc            mos_bufmgr_mock_get_busy_bo_count;
+    MockGetCountFunc            mos_bufmgr_mock_get_busy_wait_count;
 
     // Data
     UltGetCmdBufFunc            *ppfnUltGetCmdBuf;
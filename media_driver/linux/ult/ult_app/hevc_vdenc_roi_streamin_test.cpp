@@ -0,0 +1,478 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <random>
+#include <vector>
+#include "gtest/gtest.h"
+#include "encode_utils.h"
+#include "encode_hevc_vdenc_roi_overlap.h"
+#include "encode_hevc_vdenc_roi_zigzag.h"
+
+using namespace std;
+using namespace encode;
+
+// Streamin LUT and incremental streamin write of HevcVdencRoi. The writers
+// below write records shaped like the native ROI, dirty ROI and QP map
+// strategies; the QP map one is LCU position dependent like QPMapROI.
+namespace
+{
+const uint32_t recordSize = 64;
+
+struct Rect
+{
+    uint32_t top;
+    uint32_t bottom;
+    uint32_t left;
+    uint32_t right;
+};
+
+class RoiWriter : public RoiStreaminWriter
+{
+public:
+    MOS_STATUS WriteStreaminData(
+        uint32_t lcuIndex,
+        RoiOverlap::OverlapMarker marker,
+        uint32_t roiRegionIndex,
+        uint8_t *streamInBuffer) override
+    {
+        uint32_t *record = (uint32_t *)(streamInBuffer + lcuIndex * recordSize);
+        bool      align  = marker == RoiOverlap::mkRoi || marker == RoiOverlap::mkRoiBk;
+
+        if (marker == RoiOverlap::mkRoi || marker == RoiOverlap::mkRoiNone64Align)
+        {
+            if (roiRegionIndex >= 16)
+            {
+                return MOS_STATUS_INVALID_PARAMETER;
+            }
+            record[0] |= (uint8_t)deltaQp[roiRegionIndex];
+        }
+        else if (marker != RoiOverlap::mkRoiBk && marker != RoiOverlap::mkRoiBkNone64Align)
+        {
+            return MOS_STATUS_INVALID_PARAMETER;
+        }
+        record[0] |= (align ? maxTuSize : 1) << 8;
+        record[6] = align ? 0x43210000 : 0x22220000;
+        return MOS_STATUS_SUCCESS;
+    }
+
+    bool IsLcuPositionDependent() const override { return false; }
+
+    int8_t   deltaQp[16] = {};
+    uint32_t maxTuSize   = 3;
+};
+
+class DirtyRoiWriter : public RoiStreaminWriter
+{
+public:
+    MOS_STATUS WriteStreaminData(
+        uint32_t lcuIndex,
+        RoiOverlap::OverlapMarker marker,
+        uint32_t roiRegionIndex,
+        uint8_t *streamInBuffer) override
+    {
+        uint32_t *record = (uint32_t *)(streamInBuffer + lcuIndex * recordSize);
+
+        switch (marker)
+        {
+        case RoiOverlap::mkDirtyRoi:
+            record[0] = 0x3 << 8;
+            break;
+        case RoiOverlap::mkDirtyRoiNone64Align:
+            record[0] = 0x2 << 8;
+            break;
+        case RoiOverlap::mkDirtyRoiBk:
+            record[0] = 0x1 << 8;
+            record[6] = 0x11110000;
+            break;
+        case RoiOverlap::mkDirtyRoiBkNone64Align:
+            record[6] = 0x11110000;
+            break;
+        default:
+            return MOS_STATUS_INVALID_PARAMETER;
+        }
+        return MOS_STATUS_SUCCESS;
+    }
+
+    bool IsLcuPositionDependent() const override { return false; }
+};
+
+// Like QPMapROI, the QP comes from the LCU position and the last LCU of a
+// 64x64 block rewrites the TU settings of all four
+class QpMapWriter : public RoiStreaminWriter
+{
+public:
+    MOS_STATUS WriteStreaminData(
+        uint32_t lcuIndex,
+        RoiOverlap::OverlapMarker marker,
+        uint32_t roiRegionIndex,
+        uint8_t *streamInBuffer) override
+    {
+        uint32_t *record = (uint32_t *)(streamInBuffer + lcuIndex * recordSize);
+        record[7]        = 0xf << 16;
+        record[14]       = qpMap[lcuIndex % qpMap.size()];
+
+        if (lcuIndex % 4 == 3)
+        {
+            uint32_t *first = record - 3 * recordSize / sizeof(uint32_t);
+            bool      align = first[14] == record[14];
+            for (uint32_t i = 0; i < 4; i++)
+            {
+                first[i * recordSize / sizeof(uint32_t)] = (align ? 3 : 1) << 8;
+            }
+        }
+        return MOS_STATUS_SUCCESS;
+    }
+
+    bool IsLcuPositionDependent() const override { return true; }
+
+    vector<uint32_t> qpMap = vector<uint32_t>(97, 26);
+};
+}  // namespace
+
+class RoiZigZagLutTest : public testing::Test
+{
+protected:
+    // The index each CU had before the LUT
+    UintVector PerCu(uint32_t width, const Rect &rect)
+    {
+        UintVector lcus;
+        for (uint32_t y = rect.top; y < rect.bottom; y++)
+        {
+            for (uint32_t x = rect.left; x < rect.right; x++)
+            {
+                uint32_t offset = 0, xyOffset = 0;
+                RoiZigZagLut::ZigZagToLinear(width, x, y, &offset, &xyOffset);
+                lcus.push_back(offset + xyOffset);
+            }
+        }
+        return lcus;
+    }
+
+    RoiZigZagLut m_lut;
+    mt19937      m_rand{2026};
+};
+
+TEST_F(RoiZigZagLutTest, MapsCusInZigZagOrder)
+{
+    // four 64x64 LCUs, each holding its 32x32 CUs in zigzag order
+    UintVector expected = {0, 1, 4, 5,
+                           2, 3, 6, 7,
+                           8, 9, 12, 13,
+                           10, 11, 14, 15};
+    UintVector lcus;
+    m_lut.GetLcus(4, 0, 4, 0, 4, lcus);
+    EXPECT_EQ(expected, lcus);
+    EXPECT_EQ(expected, PerCu(4, {0, 4, 0, 4}));
+
+    lcus.clear();
+    m_lut.GetLcus(4, 1, 3, 1, 3, lcus);
+    EXPECT_EQ(UintVector({3, 6, 9, 12}), lcus);
+}
+
+TEST_F(RoiZigZagLutTest, RegionsMatchPerCuMapping)
+{
+    uint32_t width  = 0;
+    uint32_t height = 0;
+
+    for (uint32_t frame = 0; frame < 2000; frame++)
+    {
+        // new widths, and heights both growing and shrinking on the same LUT
+        if (frame % 50 == 0)
+        {
+            width  = 2 + 2 * (m_rand() % 40);
+            height = 2 + 2 * (m_rand() % 40);
+        }
+
+        for (uint32_t i = 0; i < 8; i++)
+        {
+            Rect rect;
+            rect.top    = m_rand() % height;
+            rect.bottom = rect.top + m_rand() % (height - rect.top + 1);
+            rect.left   = m_rand() % width;
+            // sometimes over the right border, where the LUT has no entry
+            rect.right  = rect.left + m_rand() % (width - rect.left + 3);
+
+            UintVector lcus = {7};
+            m_lut.GetLcus(width, rect.top, rect.bottom, rect.left, rect.right, lcus);
+
+            UintVector expected = PerCu(width, rect);
+            expected.insert(expected.begin(), 7);
+            ASSERT_EQ(expected, lcus) << "frame " << frame << " width " << width
+                                      << " rect " << rect.top << "," << rect.bottom << ","
+                                      << rect.left << "," << rect.right;
+        }
+    }
+}
+
+class HevcVdencRoiStreaminTest : public testing::Test
+{
+protected:
+    enum Mode
+    {
+        modeRoi,
+        modeDirtyRoi,
+        modeRoiAndDirtyRoi,
+        modeQpMap,
+    };
+
+    static const uint32_t maxCuNum = 48;
+    static const uint32_t bufferNum = 3;
+
+    void SetUp() override
+    {
+        m_buffers.assign(bufferNum, vector<uint8_t>(maxCuNum * maxCuNum * recordSize));
+        for (uint32_t i = 0; i < bufferNum; i++)
+        {
+            Reallocate(i);
+        }
+    }
+
+    // A new allocation starts with garbage and gets a new identity
+    void Reallocate(uint32_t index)
+    {
+        for (auto &byte : m_buffers[index])
+        {
+            byte = (uint8_t)m_rand();
+        }
+        m_allocationIds[index] = m_nextAllocationId++;
+    }
+
+    Rect RandomRect(uint32_t maxSize)
+    {
+        Rect rect;
+        rect.left   = m_rand() % m_width;
+        rect.right  = min(m_width, rect.left + 1 + (uint32_t)(m_rand() % maxSize));
+        rect.top    = m_rand() % m_height;
+        rect.bottom = min(m_height, rect.top + 1 + (uint32_t)(m_rand() % maxSize));
+        return rect;
+    }
+
+    bool Aligned(const Rect &rect)
+    {
+        return rect.top % 2 == 0 && rect.bottom % 2 == 0 && rect.left % 2 == 0 && rect.right % 2 == 0;
+    }
+
+    void NewScene()
+    {
+        m_width     = 2 + m_rand() % (maxCuNum - 2);
+        m_height    = 2 + m_rand() % (maxCuNum - 2);
+        m_lcuNumber = max(m_lcuNumber, m_width * m_height);
+        m_rois.clear();
+        for (uint32_t i = 0; i < 1 + m_rand() % 16; i++)
+        {
+            m_rois.push_back(RandomRect(16));
+        }
+    }
+
+    void NextFrame(Mode mode)
+    {
+        switch (m_rand() % 4)
+        {
+        case 0:
+            m_rois[m_rand() % m_rois.size()] = RandomRect(16);
+            break;
+        case 1:
+            m_roi.deltaQp[m_rand() % 16] = (int8_t)(m_rand() % 16) - 8;
+            break;
+        case 2:
+            m_roi.maxTuSize = m_rand() % 4;
+            break;
+        default:
+            m_qpMap.qpMap[m_rand() % m_qpMap.qpMap.size()] = 10 + m_rand() % 42;
+            break;
+        }
+        m_dirtyRects.clear();
+        if (mode == modeDirtyRoi || mode == modeRoiAndDirtyRoi)
+        {
+            for (uint32_t i = 0; i < m_rand() % 4; i++)
+            {
+                m_dirtyRects.push_back(RandomRect(24));
+            }
+        }
+    }
+
+    // Marks the LCUs the way DirtyROI::SetupRoi and RoiStrategy::SetupRoi do,
+    // dirty ROI first
+    void Mark(Mode mode)
+    {
+        m_overlap.Update(m_width * m_height);
+
+        // dirty ROI is only enabled with dirty rects
+        UintVector lcus;
+        if (!m_dirtyRects.empty())
+        {
+            for (uint32_t i = 0; i < m_width * m_height; i++)
+            {
+                m_overlap.MarkLcu(i, (i % 3) ? RoiOverlap::mkDirtyRoiBk : RoiOverlap::mkDirtyRoiBkNone64Align);
+            }
+            for (auto &rect : m_dirtyRects)
+            {
+                lcus.clear();
+                m_lut.GetLcus(m_width, rect.top, rect.bottom, rect.left, rect.right, lcus);
+                m_overlap.MarkLcus(lcus, Aligned(rect) ? RoiOverlap::mkDirtyRoi : RoiOverlap::mkDirtyRoiNone64Align);
+            }
+        }
+
+        if (mode == modeDirtyRoi)
+        {
+            return;
+        }
+
+        bool align = true;
+        for (auto &rect : m_rois)
+        {
+            align = align && Aligned(rect);
+        }
+        for (int32_t i = (int32_t)m_rois.size() - 1; i >= 0; i--)
+        {
+            lcus.clear();
+            m_lut.GetLcus(m_width, m_rois[i].top, m_rois[i].bottom, m_rois[i].left, m_rois[i].right, lcus);
+            m_overlap.MarkLcus(lcus, align ? RoiOverlap::mkRoi : RoiOverlap::mkRoiNone64Align, i);
+        }
+        for (uint32_t i = 0; i < m_width * m_height; i++)
+        {
+            m_overlap.MarkLcu(i, align ? RoiOverlap::mkRoiBk : RoiOverlap::mkRoiBkNone64Align);
+        }
+    }
+
+    // Writes the buffer like HevcVdencRoi::WriteStreaminData
+    MOS_STATUS Write(RoiStreaminWriter *roi, RoiStreaminWriter *dirtyRoi, uint32_t index)
+    {
+        vector<uint8_t> &buffer = m_buffers[index];
+
+        if (roi == nullptr || !roi->IsLcuPositionDependent())
+        {
+            return m_overlap.WriteStreaminDataIncremental(roi, dirtyRoi, m_allocationIds[index], buffer.data());
+        }
+
+        vector<uint8_t> temp(buffer.size(), 0);
+        MOS_STATUS      status = m_overlap.WriteStreaminData(roi, dirtyRoi, temp.data());
+        buffer                 = temp;
+        m_overlap.ResetStreaminHistory(m_allocationIds[index]);
+        return status;
+    }
+
+    void Run(const vector<Mode> &modes, uint32_t frames)
+    {
+        for (uint32_t frame = 0; frame < frames; frame++)
+        {
+            if (frame % 200 == 0)
+            {
+                NewScene();
+            }
+            Mode mode = modes[frame % modes.size()];
+            NextFrame(mode);
+            Mark(mode);
+
+            RoiStreaminWriter *roi      = (mode == modeQpMap) ? (RoiStreaminWriter *)&m_qpMap : &m_roi;
+            RoiStreaminWriter *dirtyRoi = m_dirtyRects.empty() ? nullptr : &m_dirtyRoi;
+            if (mode == modeDirtyRoi)
+            {
+                roi = nullptr;
+            }
+            if (roi == nullptr && dirtyRoi == nullptr)
+            {
+                continue;
+            }
+
+            vector<uint8_t> expected(m_buffers[0].size(), 0);
+            ASSERT_EQ(MOS_STATUS_SUCCESS, m_overlap.WriteStreaminData(roi, dirtyRoi, expected.data()));
+
+            uint32_t index = frame % bufferNum;
+            ASSERT_EQ(MOS_STATUS_SUCCESS, Write(roi, dirtyRoi, index));
+
+            ASSERT_TRUE(equal(expected.begin(), expected.begin() + m_lcuNumber * recordSize, m_buffers[index].begin()))
+                << "frame " << frame << " mode " << mode;
+
+            // now and then a recycled buffer is freed and allocated again
+            if (m_rand() % 50 == 0)
+            {
+                Reallocate(m_rand() % bufferNum);
+            }
+        }
+    }
+
+    RoiOverlap              m_overlap;
+    RoiZigZagLut            m_lut;
+    RoiWriter               m_roi;
+    DirtyRoiWriter          m_dirtyRoi;
+    QpMapWriter             m_qpMap;
+    vector<Rect>            m_rois;
+    vector<Rect>            m_dirtyRects;
+    vector<vector<uint8_t>> m_buffers;
+    uint64_t                m_allocationIds[bufferNum] = {};
+    uint64_t                m_nextAllocationId         = 0x10000;
+    uint32_t                m_width                    = 0;
+    uint32_t                m_height                   = 0;
+    uint32_t                m_lcuNumber                = 0;
+    mt19937                 m_rand{1234};
+};
+
+TEST_F(HevcVdencRoiStreaminTest, RoiMatchesFullWrite)
+{
+    Run({modeRoi}, 1000);
+}
+
+TEST_F(HevcVdencRoiStreaminTest, DirtyRoiMatchesFullWrite)
+{
+    Run({modeDirtyRoi}, 1000);
+}
+
+TEST_F(HevcVdencRoiStreaminTest, RoiAndDirtyRoiMatchFullWrite)
+{
+    Run({modeRoiAndDirtyRoi}, 1000);
+}
+
+TEST_F(HevcVdencRoiStreaminTest, QpMapFramesInterleavedMatchFullWrite)
+{
+    Run({modeRoi, modeQpMap, modeRoiAndDirtyRoi, modeRoi, modeQpMap, modeQpMap, modeDirtyRoi}, 1400);
+}
+
+TEST_F(HevcVdencRoiStreaminTest, RejectsPositionDependentWriters)
+{
+    NewScene();
+    Mark(modeQpMap);
+    EXPECT_EQ(MOS_STATUS_INVALID_PARAMETER,
+        m_overlap.WriteStreaminDataIncremental(&m_qpMap, nullptr, m_allocationIds[0], m_buffers[0].data()));
+}
+
+TEST_F(HevcVdencRoiStreaminTest, ReallocatedBufferIsWrittenInFull)
+{
+    NewScene();
+    NextFrame(modeRoi);
+    Mark(modeRoi);
+
+    vector<uint8_t> expected(m_buffers[0].size(), 0);
+    ASSERT_EQ(MOS_STATUS_SUCCESS, m_overlap.WriteStreaminData(&m_roi, nullptr, expected.data()));
+
+    // same frame into the same allocation twice, then into a new allocation
+    // of the same buffer
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        if (i == 2)
+        {
+            Reallocate(0);
+        }
+        ASSERT_EQ(MOS_STATUS_SUCCESS, Write(&m_roi, nullptr, 0));
+        ASSERT_TRUE(equal(expected.begin(), expected.begin() + m_lcuNumber * recordSize, m_buffers[0].begin()))
+            << "write " << i;
+    }
+}
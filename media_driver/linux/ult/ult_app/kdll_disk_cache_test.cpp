@@ -0,0 +1,283 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+#include "hal_kerneldll.h"
+
+using namespace std;
+
+// Persistent combined kernel cache: kernels added to one Kdll state are
+// written to the cache directory on release and found by the next state
+// built from the same binaries; damaged or foreign files are not used.
+class KdllDiskCacheTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        char dir[] = "/tmp/kdll_cache_XXXXXX";
+        ASSERT_NE(nullptr, mkdtemp(dir));
+        m_dir = dir;
+
+        m_rules[0].id    = RID_Op_EOF;
+        m_rules[0].value = 0;
+        m_rules[0].logic = Kdll_None;
+
+        m_search = (Kdll_SearchState *)calloc(1, sizeof(Kdll_SearchState));
+        ASSERT_NE(nullptr, m_search);
+
+        // Original filter, procamp disabled so the kernel may be kept
+        for (auto &entry : m_filter)
+        {
+            memset(&entry, 0, sizeof(entry));
+            entry.layer   = Layer_MainVideo;
+            entry.procamp = DL_PROCAMP_DISABLED;
+            entry.matrix  = DL_CSC_DISABLED;
+        }
+        m_filter[1].layer = Layer_RenderTarget;
+        m_hash = KernelDll_SimpleHash(m_filter, sizeof(m_filter));
+
+        // Modified filter and combined kernel as left by the kernel search
+        m_search->iFilterSize = 3;
+        for (int i = 0; i < m_search->iFilterSize; i++)
+        {
+            m_search->Filter[i]         = m_filter[i % 2];
+            m_search->Filter[i].matrix  = i;
+        }
+        m_search->KernelSize = 4096 + 64;
+        for (int i = 0; i < m_search->KernelSize; i++)
+        {
+            m_search->Kernel[i] = (uint8_t)(i * 7 + 3);
+        }
+    }
+
+    void TearDown() override
+    {
+        free(m_search);
+        for (auto &name : Files())
+        {
+            unlink(name.c_str());
+        }
+        rmdir(m_dir.c_str());
+    }
+
+    // Component kernel binary with an empty link file, the only kernel
+    // AllocateStates requires. seed changes the binary, hence the cache file.
+    Kdll_State *Allocate(uint32_t seed = 0)
+    {
+        uint32_t  offsets = (IDR_VP_TOTAL_NUM_KERNELS + 1) * sizeof(uint32_t);
+        uint32_t  size    = offsets + IDR_VP_LINKFILE_HEADER + sizeof(seed);
+        uint8_t  *bin     = (uint8_t *)MOS_AllocAndZeroMemory(size);
+        uint32_t *pOffset = (uint32_t *)bin;
+
+        for (int i = IDR_VP_LinkFile + 1; i <= IDR_VP_TOTAL_NUM_KERNELS; i++)
+        {
+            pOffset[i] = IDR_VP_LINKFILE_HEADER;
+        }
+        Kdll_LinkFileHeader *header = (Kdll_LinkFileHeader *)(bin + offsets);
+        header->dwVersion = IDR_VP_LINKFILE_VERSION;
+        header->dwSize    = IDR_VP_LINKFILE_HEADER;
+        memcpy(bin + offsets + IDR_VP_LINKFILE_HEADER, &seed, sizeof(seed));
+
+        return KernelDll_AllocateStates(bin, size, nullptr, 0, m_rules, nullptr);
+    }
+
+    vector<string> Files()
+    {
+        vector<string> names;
+        DIR *dir = opendir(m_dir.c_str());
+        for (struct dirent *entry = dir ? readdir(dir) : nullptr; entry; entry = readdir(dir))
+        {
+            if (entry->d_name[0] != '.')
+            {
+                names.push_back(m_dir + "/" + entry->d_name);
+            }
+        }
+        if (dir)
+        {
+            closedir(dir);
+        }
+        return names;
+    }
+
+    // Cache file of the binaries, the only file left in the directory
+    string FileName()
+    {
+        vector<string> names = Files();
+        return names.size() == 1 ? names[0] : string();
+    }
+
+    // Builds the kernel in a first state, released to write the file
+    void WriteCache()
+    {
+        Kdll_State *state = Allocate();
+        ASSERT_NE(nullptr, state);
+        ASSERT_TRUE(KernelDll_LoadDiskCache(state, m_dir.c_str()));
+        ASSERT_EQ(nullptr, KernelDll_GetCombinedKernel(state, m_filter, 2, m_hash));
+        ASSERT_NE(nullptr, KernelDll_AddKernel(state, m_search, m_filter, 2, m_hash));
+        KernelDll_ReleaseStates(state);
+        ASSERT_FALSE(FileName().empty());
+    }
+
+    void ExpectKernel(Kdll_CacheEntry *entry)
+    {
+        ASSERT_NE(nullptr, entry);
+        ASSERT_EQ(m_search->KernelSize, entry->iSize);
+        EXPECT_EQ(0, memcmp(m_search->Kernel, entry->pBinary, entry->iSize));
+        ASSERT_EQ(m_search->iFilterSize, entry->iFilterSize);
+        EXPECT_EQ(0, memcmp(m_search->Filter, entry->pFilter, entry->iFilterSize * sizeof(Kdll_FilterEntry)));
+    }
+
+    void Patch(long offset, uint8_t mask)
+    {
+        FILE *file = fopen(FileName().c_str(), "r+b");
+        ASSERT_NE(nullptr, file);
+        ASSERT_EQ(0, fseek(file, offset, offset < 0 ? SEEK_END : SEEK_SET));
+        int c = fgetc(file);
+        ASSERT_EQ(0, fseek(file, -1, SEEK_CUR));
+        fputc(c ^ mask, file);
+        fclose(file);
+    }
+
+    string            m_dir;
+    Kdll_RuleEntry    m_rules[1];
+    Kdll_FilterEntry  m_filter[2];
+    uint32_t          m_hash   = 0;
+    Kdll_SearchState *m_search = nullptr;
+};
+
+TEST_F(KdllDiskCacheTest, RoundTrip)
+{
+    WriteCache();
+
+    Kdll_State *state = Allocate();
+    ASSERT_NE(nullptr, state);
+    ASSERT_TRUE(KernelDll_LoadDiskCache(state, m_dir.c_str()));
+    ExpectKernel(KernelDll_GetCombinedKernel(state, m_filter, 2, m_hash));
+    KernelDll_ReleaseStates(state);
+}
+
+TEST_F(KdllDiskCacheTest, OtherBinaryDoesNotShareFile)
+{
+    WriteCache();
+
+    Kdll_State *state = Allocate(1);
+    ASSERT_NE(nullptr, state);
+    ASSERT_TRUE(KernelDll_LoadDiskCache(state, m_dir.c_str()));
+    EXPECT_EQ(nullptr, KernelDll_GetCombinedKernel(state, m_filter, 2, m_hash));
+    KernelDll_ReleaseStates(state);
+}
+
+TEST_F(KdllDiskCacheTest, RejectsCorruptedKernel)
+{
+    WriteCache();
+
+    // Last byte of the kernel, covered by the record checksum only
+    Patch(-1, 0x5a);
+
+    Kdll_State *state = Allocate();
+    ASSERT_NE(nullptr, state);
+    ASSERT_TRUE(KernelDll_LoadDiskCache(state, m_dir.c_str()));
+    EXPECT_EQ(nullptr, KernelDll_GetCombinedKernel(state, m_filter, 2, m_hash));
+    KernelDll_ReleaseStates(state);
+
+    // The file was rewritten without the bad record
+    state = Allocate();
+    ASSERT_NE(nullptr, state);
+    ASSERT_TRUE(KernelDll_LoadDiskCache(state, m_dir.c_str()));
+    EXPECT_EQ(nullptr, KernelDll_GetCombinedKernel(state, m_filter, 2, m_hash));
+    KernelDll_ReleaseStates(state);
+}
+
+TEST_F(KdllDiskCacheTest, RejectsCorruptedHeader)
+{
+    WriteCache();
+    Patch(offsetof(Kdll_DiskCacheHeader, dwRecords), 0x01);
+
+    Kdll_State *state = Allocate();
+    ASSERT_NE(nullptr, state);
+    ASSERT_TRUE(KernelDll_LoadDiskCache(state, m_dir.c_str()));
+    EXPECT_EQ(nullptr, KernelDll_GetCombinedKernel(state, m_filter, 2, m_hash));
+    KernelDll_ReleaseStates(state);
+}
+
+TEST_F(KdllDiskCacheTest, RejectsTruncatedFile)
+{
+    WriteCache();
+    string name = FileName();
+    struct stat fileStat;
+    ASSERT_EQ(0, stat(name.c_str(), &fileStat));
+    ASSERT_EQ(0, truncate(name.c_str(), fileStat.st_size - 1));
+
+    Kdll_State *state = Allocate();
+    ASSERT_NE(nullptr, state);
+    ASSERT_TRUE(KernelDll_LoadDiskCache(state, m_dir.c_str()));
+    EXPECT_EQ(nullptr, KernelDll_GetCombinedKernel(state, m_filter, 2, m_hash));
+    KernelDll_ReleaseStates(state);
+}
+
+TEST_F(KdllDiskCacheTest, RejectsFileWritableByOthers)
+{
+    WriteCache();
+    string name = FileName();
+    ASSERT_EQ(0, chmod(name.c_str(), 0666));
+
+    Kdll_State *state = Allocate();
+    ASSERT_NE(nullptr, state);
+    EXPECT_FALSE(KernelDll_LoadDiskCache(state, m_dir.c_str()));
+    EXPECT_EQ(nullptr, KernelDll_GetCombinedKernel(state, m_filter, 2, m_hash));
+    KernelDll_ReleaseStates(state);
+
+    // Cache stays off, the file is left alone
+    struct stat fileStat;
+    ASSERT_EQ(0, stat(name.c_str(), &fileStat));
+    EXPECT_EQ(0666u, fileStat.st_mode & 0777);
+}
+
+TEST_F(KdllDiskCacheTest, RejectsLink)
+{
+    WriteCache();
+    string name   = FileName();
+    string target = name + ".target";
+    ASSERT_EQ(0, rename(name.c_str(), target.c_str()));
+    ASSERT_EQ(0, symlink(target.c_str(), name.c_str()));
+
+    Kdll_State *state = Allocate();
+    ASSERT_NE(nullptr, state);
+    EXPECT_FALSE(KernelDll_LoadDiskCache(state, m_dir.c_str()));
+    KernelDll_ReleaseStates(state);
+}
+
+TEST_F(KdllDiskCacheTest, DisabledWithoutDirectory)
+{
+    Kdll_State *state = Allocate();
+    ASSERT_NE(nullptr, state);
+    EXPECT_FALSE(KernelDll_LoadDiskCache(state, ""));
+    ASSERT_NE(nullptr, KernelDll_AddKernel(state, m_search, m_filter, 2, m_hash));
+    KernelDll_ReleaseStates(state);
+    EXPECT_TRUE(FileName().empty());
+}
@@ -0,0 +1,205 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "gtest/gtest.h"
+#include "media_copy_engine_scheduler.h"
+
+using namespace std;
+
+static uint64_t g_mockTimeUs = 0;
+
+static uint64_t MockGetTimeUs()
+{
+    return g_mockTimeUs;
+}
+
+// MediaCopyEngineScheduler on a mock clock
+class MediaCopyEngineSchedulerTest : public testing::Test
+{
+protected:
+    void SetUp()
+    {
+        g_mockTimeUs = 1000000;
+    }
+
+    MediaCopyEngineScheduler m_scheduler{MockGetTimeUs};
+    MCPY_ENGINE_CAPS         m_allEngines = {1, 1, 1, 0};
+};
+
+TEST_F(MediaCopyEngineSchedulerTest, ProjectionDrainsWithClock)
+{
+    uint64_t cost = m_scheduler.EstimateCopyCost(MCPY_ENGINE_BLT, 6000000, MOS_TILE_LINEAR, MOS_TILE_LINEAR);
+    EXPECT_EQ(1020u, cost);
+
+    m_scheduler.AddCopy(MCPY_ENGINE_BLT, 6000000, MOS_TILE_LINEAR, MOS_TILE_LINEAR);
+    EXPECT_EQ(cost, m_scheduler.GetEngineCounters(MCPY_ENGINE_BLT).projectedBusyUs);
+
+    // a second copy queues behind the first one
+    m_scheduler.AddCopy(MCPY_ENGINE_BLT, 6000000, MOS_TILE_LINEAR, MOS_TILE_LINEAR);
+    EXPECT_EQ(2 * cost, m_scheduler.GetEngineCounters(MCPY_ENGINE_BLT).projectedBusyUs);
+
+    g_mockTimeUs += 500;
+    EXPECT_EQ(2 * cost - 500, m_scheduler.GetEngineCounters(MCPY_ENGINE_BLT).projectedBusyUs);
+
+    g_mockTimeUs += 2 * cost;
+    MCPY_ENGINE_COUNTERS counters = m_scheduler.GetEngineCounters(MCPY_ENGINE_BLT);
+    EXPECT_EQ(0u, counters.projectedBusyUs);
+    EXPECT_EQ(2u, counters.copyNum);
+    EXPECT_EQ(12000000u, counters.byteNum);
+    EXPECT_EQ(0u, m_scheduler.GetEngineCounters(MCPY_ENGINE_VEBOX).copyNum);
+}
+
+TEST_F(MediaCopyEngineSchedulerTest, EngineLoadUpdate)
+{
+    m_scheduler.UpdateEngineLoad(MCPY_ENGINE_VEBOX, 3);
+    MCPY_ENGINE_COUNTERS counters = m_scheduler.GetEngineCounters(MCPY_ENGINE_VEBOX);
+    EXPECT_EQ(3u, counters.inFlightNum);
+    EXPECT_EQ(1500u, counters.projectedBusyUs);
+
+    // copies start after the reported load
+    m_scheduler.AddCopy(MCPY_ENGINE_VEBOX, 0, MOS_TILE_Y, MOS_TILE_Y);
+    EXPECT_EQ(1530u, m_scheduler.GetEngineCounters(MCPY_ENGINE_VEBOX).projectedBusyUs);
+
+    // a later update replaces the reported load, not the routed copies
+    g_mockTimeUs += 1000;
+    m_scheduler.UpdateEngineLoad(MCPY_ENGINE_VEBOX, 0);
+    EXPECT_EQ(530u, m_scheduler.GetEngineCounters(MCPY_ENGINE_VEBOX).projectedBusyUs);
+}
+
+TEST_F(MediaCopyEngineSchedulerTest, SelectEngine)
+{
+    MCPY_ENGINE engine = MCPY_ENGINE_RENDER;
+    ASSERT_EQ(MOS_STATUS_SUCCESS, m_scheduler.SelectEngine(m_allEngines, 64 * 1024, MOS_TILE_Y, MOS_TILE_Y, engine));
+    EXPECT_EQ(MCPY_ENGINE_BLT, engine);
+
+    // blt busy, the small copy goes to the idle vebox
+    m_scheduler.AddCopy(MCPY_ENGINE_BLT, 8 * 1024 * 1024, MOS_TILE_Y, MOS_TILE_Y);
+    ASSERT_EQ(MOS_STATUS_SUCCESS, m_scheduler.SelectEngine(m_allEngines, 64 * 1024, MOS_TILE_Y, MOS_TILE_Y, engine));
+    EXPECT_EQ(MCPY_ENGINE_VEBOX, engine);
+
+    // caps win over load
+    MCPY_ENGINE_CAPS bltOnly = {0, 1, 0, 0};
+    ASSERT_EQ(MOS_STATUS_SUCCESS, m_scheduler.SelectEngine(bltOnly, 64 * 1024, MOS_TILE_Y, MOS_TILE_Y, engine));
+    EXPECT_EQ(MCPY_ENGINE_BLT, engine);
+
+    MCPY_ENGINE_CAPS none = {0, 0, 0, 0};
+    engine = MCPY_ENGINE_RENDER;
+    EXPECT_EQ(MOS_STATUS_INVALID_PARAMETER, m_scheduler.SelectEngine(none, 64 * 1024, MOS_TILE_Y, MOS_TILE_Y, engine));
+    EXPECT_EQ(MCPY_ENGINE_RENDER, engine);
+
+    // once the blt copy is done blt is the best engine again
+    g_mockTimeUs += 10000;
+    ASSERT_EQ(MOS_STATUS_SUCCESS, m_scheduler.SelectEngine(m_allEngines, 64 * 1024, MOS_TILE_Y, MOS_TILE_Y, engine));
+    EXPECT_EQ(MCPY_ENGINE_BLT, engine);
+}
+
+// Frames of copies on engines that run the cost model with jitter, next to vebox jobs
+// of a VP stream. Static BALANCE sends every copy to vebox, LOADBALANCE spreads them.
+class MediaCopyEngineSchedulerSimTest : public MediaCopyEngineSchedulerTest
+{
+protected:
+    struct SimResult
+    {
+        uint64_t meanUs;
+        uint64_t maxUs;
+    };
+
+    SimResult Run(bool loadBalance, uint32_t vpJobsPerFrame)
+    {
+        const uint64_t      frameUs      = 16667;
+        const uint64_t      vpJobUs      = 500;
+        const uint64_t      sizes[]      = {8 * 1024 * 1024, 4 * 1024 * 1024, 64 * 1024};
+        const MOS_TILE_TYPE tiles[]      = {MOS_TILE_LINEAR, MOS_TILE_Y};
+        MediaCopyEngineScheduler scheduler(MockGetTimeUs);
+        mt19937                  rng(5678);
+        uint64_t                 gpuBusyUntil[MCPY_ENGINE_NUM] = {};
+        vector<uint64_t>         vpJobEnds;
+        uint64_t                 totalUs = 0;
+        uint64_t                 maxUs   = 0;
+        uint32_t                 copies  = 0;
+
+        g_mockTimeUs = 0;
+        for (uint32_t frame = 0; frame < 600; frame++)
+        {
+            g_mockTimeUs = frame * frameUs;
+
+            for (uint32_t i = 0; i < vpJobsPerFrame; i++)
+            {
+                gpuBusyUntil[MCPY_ENGINE_VEBOX] = max(gpuBusyUntil[MCPY_ENGINE_VEBOX], g_mockTimeUs) + vpJobUs;
+                vpJobEnds.push_back(gpuBusyUntil[MCPY_ENGINE_VEBOX]);
+            }
+
+            uint64_t frameStart = g_mockTimeUs;
+            for (uint32_t i = 0; i < 12; i++)
+            {
+                // load feedback, as the status tags would report it
+                uint32_t inFlight = 0;
+                for (auto end : vpJobEnds)
+                {
+                    inFlight += end > g_mockTimeUs;
+                }
+                scheduler.UpdateEngineLoad(MCPY_ENGINE_VEBOX, inFlight);
+
+                uint64_t      size    = sizes[i % 3];
+                MOS_TILE_TYPE srcTile = tiles[rng() % 2];
+                MOS_TILE_TYPE dstTile = tiles[rng() % 2];
+                MCPY_ENGINE   engine  = MCPY_ENGINE_VEBOX;
+                if (loadBalance)
+                {
+                    EXPECT_EQ(MOS_STATUS_SUCCESS, scheduler.SelectEngine(m_allEngines, size, srcTile, dstTile, engine));
+                }
+                scheduler.AddCopy(engine, size, srcTile, dstTile);
+
+                // service time of the model +-25%
+                uint64_t cost = scheduler.EstimateCopyCost(engine, size, srcTile, dstTile);
+                cost          = cost * (75 + rng() % 51) / 100;
+                gpuBusyUntil[engine] = max(gpuBusyUntil[engine], g_mockTimeUs) + cost;
+
+                uint64_t latency = gpuBusyUntil[engine] - frameStart;
+                totalUs += latency;
+                maxUs    = max(maxUs, latency);
+                copies++;
+
+                // copies of a frame are issued 100us apart
+                g_mockTimeUs += 100;
+            }
+        }
+
+        return {totalUs / copies, maxUs};
+    }
+};
+
+TEST_F(MediaCopyEngineSchedulerSimTest, LoadBalanceBeatsStaticOrder)
+{
+    for (uint32_t vpJobs = 0; vpJobs <= 3; vpJobs++)
+    {
+        SimResult balance     = Run(false, vpJobs);
+        SimResult loadBalance = Run(true, vpJobs);
+
+        EXPECT_LT(loadBalance.meanUs, balance.meanUs) << "vp jobs per frame " << vpJobs;
+        EXPECT_LE(loadBalance.maxUs, balance.maxUs) << "vp jobs per frame " << vpJobs;
+        // the copies of one frame fit in the frame once they are spread
+        EXPECT_LT(loadBalance.maxUs, 16667u) << "vp jobs per frame " << vpJobs;
+    }
+}
@@ -0,0 +1,167 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "gtest/gtest.h"
+#include "driver_loader.h"
+#include "media_libva_caps_index.h"
+
+// Lookups of the index built by hand. MediaCapsDdiTest.ConfigLookupIndex compares the caps
+// lookups of the driver with and without the index for every platform.
+class MediaLibvaCapsIndexTest : public testing::Test
+{
+protected:
+    enum
+    {
+        videoEncode,
+        videoDecode,
+        videoProcess,
+        videoProtect
+    };
+
+    MediaLibvaCapsIndex m_index;
+};
+
+TEST_F(MediaLibvaCapsIndexTest, ProfileEntries)
+{
+    ASSERT_TRUE(m_index.InitAttribs(3, 0));
+    ASSERT_TRUE(m_index.AddProfileEntry(VAProfileH264Main, VAEntrypointVLD, 0));
+    ASSERT_TRUE(m_index.AddProfileEntry(VAProfileH264Main, VAEntrypointEncSlice, 1));
+    ASSERT_TRUE(m_index.AddProfileEntry(VAProfileNone, VAEntrypointVideoProc, 2));
+    m_index.SetValid();
+
+    EXPECT_EQ(0, m_index.FindProfileEntry(VAProfileH264Main, VAEntrypointVLD));
+    EXPECT_EQ(1, m_index.FindProfileEntry(VAProfileH264Main, VAEntrypointEncSlice));
+    EXPECT_EQ(2, m_index.FindProfileEntry(VAProfileNone, VAEntrypointVideoProc));
+
+    // Supported profile without the entrypoint, unsupported profile
+    EXPECT_EQ(-2, m_index.FindProfileEntry(VAProfileH264Main, VAEntrypointEncSliceLP));
+    EXPECT_EQ(-2, m_index.FindProfileEntry(VAProfileNone, VAEntrypointVLD));
+    EXPECT_EQ(-1, m_index.FindProfileEntry(VAProfileHEVCMain, VAEntrypointVLD));
+    EXPECT_EQ(-1, m_index.FindProfileEntry(VAProfileH264High, VAEntrypointEncSlice));
+}
+
+TEST_F(MediaLibvaCapsIndexTest, Configs)
+{
+    ASSERT_TRUE(m_index.InitAttribs(3, 0));
+    ASSERT_TRUE(m_index.AddConfigs(videoDecode, 0, 3, 0));
+    ASSERT_TRUE(m_index.AddConfigs(videoDecode, 3, 2, 2));
+    ASSERT_TRUE(m_index.AddConfigs(videoEncode, 0, 4, 1));
+    m_index.SetValid();
+
+    const int32_t decode[] = {0, 0, 0, 2, 2, -1};
+    for (int32_t offset = 0; offset < 6; offset++)
+    {
+        EXPECT_EQ(decode[offset], m_index.FindConfig(videoDecode, offset)) << "config " << offset;
+    }
+    const int32_t encode[] = {1, 1, 1, 1, -1};
+    for (int32_t offset = 0; offset < 5; offset++)
+    {
+        EXPECT_EQ(encode[offset], m_index.FindConfig(videoEncode, offset)) << "config " << offset;
+    }
+    EXPECT_EQ(-1, m_index.FindConfig(videoDecode, -1));
+    EXPECT_EQ(-1, m_index.FindConfig(videoProcess, 0));
+}
+
+TEST_F(MediaLibvaCapsIndexTest, Attribs)
+{
+    ASSERT_TRUE(m_index.InitAttribs(2, VAConfigAttribTypeMax));
+    EXPECT_EQ((uint32_t)VAConfigAttribTypeMax, m_index.GetAttribTypeNum());
+    m_index.SetAttrib(0, VAConfigAttribRTFormat, VA_RT_FORMAT_YUV420);
+    m_index.SetAttrib(1, VAConfigAttribRTFormat, VA_RT_FORMAT_YUV420_10);
+    m_index.SetAttrib(1, VAConfigAttribRateControl, 0);
+    m_index.SetValid();
+
+    uint32_t value = 0;
+    EXPECT_TRUE(m_index.GetAttrib(0, VAConfigAttribRTFormat, value));
+    EXPECT_EQ((uint32_t)VA_RT_FORMAT_YUV420, value);
+    EXPECT_TRUE(m_index.GetAttrib(1, VAConfigAttribRTFormat, value));
+    EXPECT_EQ((uint32_t)VA_RT_FORMAT_YUV420_10, value);
+
+    // A zero value is set, an unset attribute is not
+    value = 1;
+    EXPECT_TRUE(m_index.GetAttrib(1, VAConfigAttribRateControl, value));
+    EXPECT_EQ(0u, value);
+    EXPECT_FALSE(m_index.GetAttrib(0, VAConfigAttribRateControl, value));
+    EXPECT_FALSE(m_index.GetAttrib(0, VAConfigAttribTypeMax, value));
+}
+
+TEST_F(MediaLibvaCapsIndexTest, FirstEntryWins)
+{
+    // The table scans stop at the first matching entry
+    ASSERT_TRUE(m_index.InitAttribs(3, 0));
+    ASSERT_TRUE(m_index.AddProfileEntry(VAProfileH264Main, VAEntrypointVLD, 0));
+    ASSERT_TRUE(m_index.AddProfileEntry(VAProfileH264Main, VAEntrypointEncSlice, 1));
+    ASSERT_TRUE(m_index.AddProfileEntry(VAProfileH264Main, VAEntrypointVLD, 2));
+    ASSERT_TRUE(m_index.AddConfigs(videoDecode, 0, 4, 0));
+    ASSERT_TRUE(m_index.AddConfigs(videoDecode, 2, 4, 2));
+    m_index.SetValid();
+
+    EXPECT_EQ(0, m_index.FindProfileEntry(VAProfileH264Main, VAEntrypointVLD));
+    EXPECT_EQ(0, m_index.FindConfig(videoDecode, 3));
+    EXPECT_EQ(2, m_index.FindConfig(videoDecode, 4));
+}
+
+TEST_F(MediaLibvaCapsIndexTest, FullTable)
+{
+    // 64 entries, the most MediaLibvaCaps holds, over few profiles and many entrypoints
+    ASSERT_TRUE(m_index.InitAttribs(64, 0));
+    for (int32_t i = 0; i < 64; i++)
+    {
+        ASSERT_TRUE(m_index.AddProfileEntry(i % 5 - 1, i / 5 + 1, i));
+    }
+    m_index.SetValid();
+
+    for (int32_t i = 0; i < 64; i++)
+    {
+        EXPECT_EQ(i, m_index.FindProfileEntry(i % 5 - 1, i / 5 + 1)) << "entry " << i;
+    }
+    EXPECT_EQ(-2, m_index.FindProfileEntry(0, 1000));
+    EXPECT_EQ(-1, m_index.FindProfileEntry(4, 1));
+}
+
+TEST_F(MediaLibvaCapsIndexTest, Invalid)
+{
+    EXPECT_FALSE(m_index.IsValid());
+    EXPECT_FALSE(m_index.InitAttribs(4, MediaLibvaCapsIndex::m_maxAttribTypes + 1));
+    EXPECT_FALSE(m_index.AddConfigs(videoDecode, -1, 1, 0));
+    EXPECT_FALSE(m_index.AddConfigs(videoDecode, MediaLibvaCapsIndex::m_maxConfigs, 1, 0));
+    EXPECT_FALSE(m_index.AddConfigs(MediaLibvaCapsIndex::m_maxCodecTypes, 0, 1, 0));
+
+    ASSERT_TRUE(m_index.InitAttribs(2, 1));
+    ASSERT_TRUE(m_index.AddProfileEntry(VAProfileNone, VAEntrypointVideoProc, 0));
+    ASSERT_TRUE(m_index.AddProfileEntry(VAProfileNone, VAEntrypointVLD, 1));
+    ASSERT_TRUE(m_index.AddConfigs(videoProcess, 0, 1, 0));
+    m_index.SetAttrib(1, 0, 1);
+    m_index.SetValid();
+    EXPECT_TRUE(m_index.IsValid());
+
+    // Out of the entries, or past the attribute types of an entry into the next one
+    uint32_t value = 0;
+    EXPECT_FALSE(m_index.GetAttrib(-1, 0, value));
+    EXPECT_FALSE(m_index.GetAttrib(2, 0, value));
+    EXPECT_FALSE(m_index.GetAttrib(0, 1, value));
+    EXPECT_EQ(-1, m_index.FindConfig(videoProtect, 0));
+
+    m_index.Clear();
+    EXPECT_FALSE(m_index.IsValid());
+    EXPECT_EQ(-1, m_index.FindProfileEntry(VAProfileNone, VAEntrypointVideoProc));
+    EXPECT_EQ(-1, m_index.FindConfig(videoProcess, 0));
+}
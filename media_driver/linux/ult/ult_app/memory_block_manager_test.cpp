@@ -0,0 +1,212 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <stdlib.h>
+#include <vector>
+#include "gtest/gtest.h"
+#include "memory_block_manager.h"
+
+using namespace std;
+
+static const uint32_t HEAP_SIZE  = 64 * 1024;
+static const uint32_t FREE_STATE = 1;  // MemoryBlockInternal::State::free, protected
+
+// Friend of MemoryBlockManager, as in the driver, on a heap in host memory
+class HeapManager
+{
+public:
+    HeapManager()
+    {
+        memset(&m_osInterface, 0, sizeof(m_osInterface));
+        m_osInterface.pfnAllocateResource = AllocateResource;
+        m_osInterface.pfnFreeResource     = FreeResource;
+        m_osInterface.pfnSkipResourceSync = SkipResourceSync;
+        m_osInterface.pfnLockResource     = LockResource;
+        m_osInterface.pfnUnlockResource   = UnlockResource;
+    }
+
+    MOS_STATUS Init()
+    {
+        MOS_STATUS status = m_manager.RegisterOsInterface(&m_osInterface);
+        if (status == MOS_STATUS_SUCCESS)
+        {
+            status = m_manager.RegisterTrackerResource(&m_tracker);
+        }
+        if (status == MOS_STATUS_SUCCESS)
+        {
+            status = m_manager.RegisterHeap(1, HEAP_SIZE);
+        }
+        return status;
+    }
+
+    MOS_STATUS Acquire(uint32_t trackerId, vector<uint32_t> sizes, vector<MemoryBlock> &blocks, uint32_t &spaceNeeded)
+    {
+        MemoryBlockManager::AcquireParams params(trackerId, sizes);
+        return m_manager.AcquireSpace(params, blocks, spaceNeeded);
+    }
+
+    MOS_STATUS Submit(vector<MemoryBlock> &blocks)
+    {
+        return m_manager.SubmitBlocks(blocks);
+    }
+
+    bool Retire(uint32_t tracker)
+    {
+        bool blocksUpdated = false;
+        m_tracker = tracker;
+        EXPECT_EQ(MOS_STATUS_SUCCESS, m_manager.RefreshBlockStates(blocksUpdated));
+        return blocksUpdated;
+    }
+
+    uint32_t FreeBlocks()
+    {
+        return m_manager.m_sortedBlockListNumEntries[FREE_STATE];
+    }
+
+    uint32_t FreeSize()
+    {
+        return m_manager.m_sortedBlockListSizes[FREE_STATE];
+    }
+
+private:
+#if MOS_MESSAGES_ENABLED
+    static MOS_STATUS AllocateResource(PMOS_INTERFACE osInterface, PMOS_ALLOC_GFXRES_PARAMS params,
+        const char *functionName, const char *filename, int32_t line, PMOS_RESOURCE resource)
+#else
+    static MOS_STATUS AllocateResource(PMOS_INTERFACE osInterface, PMOS_ALLOC_GFXRES_PARAMS params, PMOS_RESOURCE resource)
+#endif
+    {
+        // the heap memory stands in for the bo
+        resource->bo = reinterpret_cast<MOS_LINUX_BO *>(calloc(1, params->dwBytes));
+        return resource->bo ? MOS_STATUS_SUCCESS : MOS_STATUS_NO_SPACE;
+    }
+
+#if MOS_MESSAGES_ENABLED
+    static void FreeResource(PMOS_INTERFACE osInterface, const char *functionName, const char *filename, int32_t line, PMOS_RESOURCE resource)
+#else
+    static void FreeResource(PMOS_INTERFACE osInterface, PMOS_RESOURCE resource)
+#endif
+    {
+        free(resource->bo);
+        resource->bo = nullptr;
+    }
+
+    static MOS_STATUS SkipResourceSync(PMOS_RESOURCE resource)
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+
+    static void *LockResource(PMOS_INTERFACE osInterface, PMOS_RESOURCE resource, PMOS_LOCK_PARAMS flags)
+    {
+        return resource->bo;
+    }
+
+    static MOS_STATUS UnlockResource(PMOS_INTERFACE osInterface, PMOS_RESOURCE resource)
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+
+    MOS_INTERFACE      m_osInterface;
+    uint32_t           m_tracker = 0;
+    MemoryBlockManager m_manager;
+};
+
+class MemoryBlockManagerTest : public testing::Test
+{
+protected:
+    void SetUp()
+    {
+        ASSERT_EQ(MOS_STATUS_SUCCESS, m_heap.Init());
+        ASSERT_EQ(1u, m_heap.FreeBlocks());
+        ASSERT_EQ(HEAP_SIZE, m_heap.FreeSize());
+    }
+
+    HeapManager         m_heap;
+    vector<MemoryBlock> m_blocks;
+    uint32_t            m_spaceNeeded = 0;
+};
+
+TEST_F(MemoryBlockManagerTest, SplitLeavesRemainderFree)
+{
+    ASSERT_EQ(MOS_STATUS_SUCCESS, m_heap.Acquire(1, {1000}, m_blocks, m_spaceNeeded));
+    ASSERT_EQ(1u, m_blocks.size());
+    EXPECT_TRUE(m_blocks[0].IsValid());
+    EXPECT_EQ(1024u, m_blocks[0].GetSize());  // aligned to the 64 B blocks
+    EXPECT_EQ(1u, m_heap.FreeBlocks());
+    EXPECT_EQ(HEAP_SIZE - 1024, m_heap.FreeSize());
+
+    // the smaller request comes out of the remainder, both are disjoint
+    ASSERT_EQ(MOS_STATUS_SUCCESS, m_heap.Submit(m_blocks));
+    ASSERT_EQ(MOS_STATUS_SUCCESS, m_heap.Acquire(1, {8192, 64}, m_blocks, m_spaceNeeded));
+    ASSERT_EQ(2u, m_blocks.size());
+    EXPECT_EQ(8192u, m_blocks[0].GetSize());
+    EXPECT_EQ(64u, m_blocks[1].GetSize());
+    EXPECT_TRUE(m_blocks[0].GetOffset() + 8192 <= m_blocks[1].GetOffset() ||
+                m_blocks[1].GetOffset() + 64 <= m_blocks[0].GetOffset());
+    EXPECT_EQ(HEAP_SIZE - 1024 - 8192 - 64, m_heap.FreeSize());
+}
+
+TEST_F(MemoryBlockManagerTest, RetiredBlocksMergeBack)
+{
+    vector<MemoryBlock> later;
+    ASSERT_EQ(MOS_STATUS_SUCCESS, m_heap.Acquire(1, {4096, 4096, 4096}, m_blocks, m_spaceNeeded));
+    ASSERT_EQ(MOS_STATUS_SUCCESS, m_heap.Submit(m_blocks));
+    ASSERT_EQ(MOS_STATUS_SUCCESS, m_heap.Acquire(2, {4096}, later, m_spaceNeeded));
+    ASSERT_EQ(MOS_STATUS_SUCCESS, m_heap.Submit(later));
+    EXPECT_EQ(HEAP_SIZE - 4 * 4096, m_heap.FreeSize());
+
+    // blocks of tracker 1 retire, the one of tracker 2 still splits the heap
+    EXPECT_TRUE(m_heap.Retire(1));
+    EXPECT_EQ(HEAP_SIZE - 4096, m_heap.FreeSize());
+    EXPECT_FALSE(m_heap.Acquire(3, {HEAP_SIZE}, m_blocks, m_spaceNeeded) == MOS_STATUS_SUCCESS);
+
+    EXPECT_TRUE(m_heap.Retire(2));
+    EXPECT_EQ(1u, m_heap.FreeBlocks());
+    EXPECT_EQ(HEAP_SIZE, m_heap.FreeSize());
+    ASSERT_EQ(MOS_STATUS_SUCCESS, m_heap.Acquire(3, {HEAP_SIZE}, m_blocks, m_spaceNeeded));
+    ASSERT_EQ(1u, m_blocks.size());
+    EXPECT_EQ(0u, m_blocks[0].GetOffset());
+    EXPECT_EQ(HEAP_SIZE, m_blocks[0].GetSize());
+}
+
+TEST_F(MemoryBlockManagerTest, NoSpaceRollsBack)
+{
+    vector<MemoryBlock> held;
+    ASSERT_EQ(MOS_STATUS_SUCCESS, m_heap.Acquire(1, {8192}, held, m_spaceNeeded));
+    ASSERT_EQ(MOS_STATUS_SUCCESS, m_heap.Submit(held));
+    uint32_t freeBlocks = m_heap.FreeBlocks();
+    uint32_t freeSize   = m_heap.FreeSize();
+
+    // the first two fit, the last does not: nothing is kept
+    m_blocks.resize(3);
+    EXPECT_EQ(MOS_STATUS_CLIENT_AR_NO_SPACE,
+        m_heap.Acquire(2, {HEAP_SIZE / 2, HEAP_SIZE / 4, HEAP_SIZE / 4}, m_blocks, m_spaceNeeded));
+    EXPECT_EQ(HEAP_SIZE / 4, m_spaceNeeded);
+    EXPECT_TRUE(m_blocks.empty());
+    EXPECT_EQ(freeBlocks, m_heap.FreeBlocks());
+    EXPECT_EQ(freeSize, m_heap.FreeSize());
+
+    // the split blocks merged back, the whole free space is one block
+    ASSERT_EQ(MOS_STATUS_SUCCESS, m_heap.Acquire(2, {HEAP_SIZE - 8192}, m_blocks, m_spaceNeeded));
+    ASSERT_EQ(1u, m_blocks.size());
+    EXPECT_EQ(HEAP_SIZE - 8192, m_blocks[0].GetSize());
+    EXPECT_EQ(0u, m_heap.FreeBlocks());
+}
@@ -0,0 +1,151 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <random>
+#include <vector>
+#include "gtest/gtest.h"
+#include "mos_bo_index_map.h"
+
+using namespace std;
+
+static const uint32_t g_maxIndexes = 16;
+
+// Registration as done by GpuContextSpecificNext::RegisterResource, checked against
+// the linear scan of the registered bos it replaced
+class MosBoIndexMapTest : public testing::Test
+{
+protected:
+    void SetUp()
+    {
+        // Distinct keys, close together like bos from one allocator
+        m_bos.resize(3 * g_maxIndexes);
+        m_keys.push_back(nullptr);
+        for (auto &bo : m_bos)
+        {
+            m_keys.push_back(&bo);
+        }
+    }
+
+    int32_t LinearScan(const void *bo)
+    {
+        for (uint32_t i = 0; i < m_registered.size(); i++)
+        {
+            if (m_registered[i] == bo)
+            {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    // Returns the allocation index, -1 when the list is full
+    int32_t Register(const void *bo)
+    {
+        int32_t index = m_map.Find(bo);
+        EXPECT_EQ(LinearScan(bo), index);
+        if (index >= 0)
+        {
+            return index;
+        }
+        if (m_registered.size() >= g_maxIndexes)
+        {
+            return -1;
+        }
+        m_map.Add(bo, m_registered.size());
+        m_registered.push_back(bo);
+        return m_registered.size() - 1;
+    }
+
+    void Submit()
+    {
+        m_map.Reset();
+        m_registered.clear();
+    }
+
+    MosBoIndexMap<g_maxIndexes> m_map;
+    vector<const void *>        m_registered;
+    vector<uint64_t>            m_bos;
+    vector<const void *>        m_keys;
+};
+
+TEST_F(MosBoIndexMapTest, RandomAgainstLinearScan)
+{
+    mt19937 rng(1234);
+
+    // More submissions than the 16-bit epoch holds, so the map is cleared on the wrap
+    for (uint32_t n = 0; n < 70000; n++)
+    {
+        uint32_t regs = rng() % (2 * g_maxIndexes);
+        for (uint32_t i = 0; i < regs; i++)
+        {
+            const void *bo = m_keys[rng() % m_keys.size()];
+            Register(bo);
+            ASSERT_FALSE(HasFailure()) << "submission " << n << ", registration " << i;
+        }
+        // bos of this submission are found, others are not
+        for (auto bo : m_keys)
+        {
+            ASSERT_EQ(LinearScan(bo), m_map.Find(bo)) << "submission " << n;
+        }
+        Submit();
+    }
+}
+
+TEST_F(MosBoIndexMapTest, FullList)
+{
+    for (uint32_t i = 0; i < g_maxIndexes; i++)
+    {
+        EXPECT_EQ((int32_t)i, Register(m_keys[i]));
+    }
+    // a full list still finds registered bos and refuses new ones
+    EXPECT_EQ(-1, Register(m_keys[g_maxIndexes]));
+    EXPECT_EQ(-1, m_map.Find(m_keys[g_maxIndexes]));
+    for (uint32_t i = 0; i < g_maxIndexes; i++)
+    {
+        EXPECT_EQ((int32_t)i, Register(m_keys[i]));
+    }
+
+    // nothing survives a submission, new registrations start at index 0
+    Submit();
+    for (uint32_t i = 0; i < g_maxIndexes; i++)
+    {
+        EXPECT_EQ(-1, m_map.Find(m_keys[i]));
+    }
+    EXPECT_EQ(0, Register(m_keys[g_maxIndexes]));
+}
+
+TEST_F(MosBoIndexMapTest, EpochWrap)
+{
+    for (uint32_t i = 0; i < g_maxIndexes; i++)
+    {
+        Register(m_keys[i]);
+    }
+    // empty submissions until the epoch of the bos above comes around again
+    for (uint32_t n = 0; n < 0x10000; n++)
+    {
+        Submit();
+        ASSERT_EQ(-1, m_map.Find(m_keys[0])) << "submission " << n;
+    }
+    for (uint32_t i = 0; i < g_maxIndexes; i++)
+    {
+        EXPECT_EQ(-1, m_map.Find(m_keys[i]));
+    }
+}
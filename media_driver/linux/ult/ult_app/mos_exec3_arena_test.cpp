@@ -0,0 +1,193 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <stdlib.h>
+#include <set>
+#include <vector>
+#include "gtest/gtest.h"
+#include "mos_exec3_arena.h"
+
+using namespace std;
+
+class MosExec3ArenaTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_arena = (struct mos_exec3_arena *)calloc(1, sizeof(struct mos_exec3_arena));
+        ASSERT_NE(nullptr, m_arena);
+    }
+
+    void TearDown() override
+    {
+        mos_exec3_arena_destroy(m_arena);
+    }
+
+    // Merges the handles of one submission into m_arena->obj the way do_exec3() does,
+    // returns the number of distinct handles
+    uint32_t Submit(const vector<vector<uint32_t>> &batches)
+    {
+        uint32_t objCount = 0;
+        mos_exec3_arena_begin(m_arena);
+        for (auto &batch : batches)
+        {
+            uint32_t count = (uint32_t)batch.size();
+            EXPECT_EQ(0, mos_exec3_arena_reserve((void **)&m_arena->obj, &m_arena->obj_size,
+                objCount + count, sizeof(*m_arena->obj)));
+            EXPECT_EQ(0, mos_exec3_handle_set_reserve(m_arena, objCount, objCount + count));
+            for (auto handle : batch)
+            {
+                if (mos_exec3_handle_insert(m_arena, handle))
+                {
+                    m_arena->obj[objCount++].handle = handle;
+                }
+            }
+        }
+        return objCount;
+    }
+
+    struct mos_exec3_arena *m_arena = nullptr;
+};
+
+TEST_F(MosExec3ArenaTest, ReserveGrowsAndKeepsContents)
+{
+    uint32_t *array = nullptr;
+    uint32_t  size  = 0;
+
+    EXPECT_EQ(0, mos_exec3_arena_reserve((void **)&array, &size, 0, sizeof(*array)));
+    EXPECT_EQ(nullptr, array);
+
+    EXPECT_EQ(0, mos_exec3_arena_reserve((void **)&array, &size, 1, sizeof(*array)));
+    ASSERT_NE(nullptr, array);
+    EXPECT_EQ((uint32_t)MOS_EXEC3_ARENA_MIN_SIZE, size);
+    for (uint32_t i = 0; i < size; i++)
+    {
+        array[i] = i;
+    }
+
+    // Within the size nothing moves
+    uint32_t *before = array;
+    EXPECT_EQ(0, mos_exec3_arena_reserve((void **)&array, &size, MOS_EXEC3_ARENA_MIN_SIZE, sizeof(*array)));
+    EXPECT_EQ(before, array);
+    EXPECT_EQ((uint32_t)MOS_EXEC3_ARENA_MIN_SIZE, size);
+
+    // Grows by doubling, up to the first power of two multiple that fits
+    EXPECT_EQ(0, mos_exec3_arena_reserve((void **)&array, &size, MOS_EXEC3_ARENA_MIN_SIZE * 3, sizeof(*array)));
+    EXPECT_EQ((uint32_t)MOS_EXEC3_ARENA_MIN_SIZE * 4, size);
+    for (uint32_t i = 0; i < MOS_EXEC3_ARENA_MIN_SIZE; i++)
+    {
+        ASSERT_EQ(i, array[i]);
+    }
+    free(array);
+}
+
+TEST_F(MosExec3ArenaTest, DedupPerSubmission)
+{
+    EXPECT_EQ(4u, Submit({{1, 2, 3}, {3, 2, 4}, {1}}));
+    EXPECT_EQ(1u, m_arena->obj[0].handle);
+    EXPECT_EQ(4u, m_arena->obj[3].handle);
+
+    // The next submission sees none of the handles of the previous one
+    EXPECT_EQ(2u, Submit({{4}, {1, 4}}));
+    EXPECT_EQ(4u, m_arena->obj[0].handle);
+    EXPECT_EQ(1u, m_arena->obj[1].handle);
+}
+
+TEST_F(MosExec3ArenaTest, HandlesOfOneSlot)
+{
+    ASSERT_EQ(0, mos_exec3_handle_set_reserve(m_arena, 0, 1));
+    uint32_t size = m_arena->handle_set_size;
+
+    // Multiples of the set size hash alike and are probed past each other
+    mos_exec3_arena_begin(m_arena);
+    for (uint32_t i = 1; i <= size / 2; i++)
+    {
+        ASSERT_TRUE(mos_exec3_handle_insert(m_arena, i * size)) << i;
+    }
+    for (uint32_t i = 1; i <= size / 2; i++)
+    {
+        ASSERT_FALSE(mos_exec3_handle_insert(m_arena, i * size)) << i;
+    }
+}
+
+TEST_F(MosExec3ArenaTest, GrowsKeepingMergedHandles)
+{
+    vector<uint32_t> first, second;
+    for (uint32_t i = 0; i < MOS_EXEC3_ARENA_MIN_SIZE; i++)
+    {
+        first.push_back(i * 2 + 1);
+    }
+    // The second batch holds the handles of the first, the merged list outgrows the initial set
+    for (uint32_t i = 0; i < MOS_EXEC3_ARENA_MIN_SIZE * 2; i++)
+    {
+        second.push_back(i + 1);
+    }
+
+    EXPECT_EQ((uint32_t)MOS_EXEC3_ARENA_MIN_SIZE * 2, Submit({first, second}));
+    EXPECT_GT(m_arena->handle_set_size, (uint32_t)MOS_EXEC3_ARENA_MIN_SIZE * 2);
+
+    set<uint32_t> merged;
+    for (uint32_t i = 0; i < MOS_EXEC3_ARENA_MIN_SIZE * 2; i++)
+    {
+        EXPECT_TRUE(merged.insert(m_arena->obj[i].handle).second) << m_arena->obj[i].handle;
+    }
+    EXPECT_EQ(1u, *merged.begin());
+    EXPECT_EQ((uint32_t)MOS_EXEC3_ARENA_MIN_SIZE * 2, *merged.rbegin());
+}
+
+TEST_F(MosExec3ArenaTest, ReusedOnceGrown)
+{
+    vector<uint32_t> large;
+    for (uint32_t i = 0; i < 3000; i++)
+    {
+        large.push_back(i + 1);
+    }
+    EXPECT_EQ(3000u, Submit({large, {1, 2, 3}}));
+
+    struct drm_i915_gem_exec_object2 *obj     = m_arena->obj;
+    struct mos_exec3_handle_slot     *set     = m_arena->handle_set;
+    uint32_t                          objSize = m_arena->obj_size;
+    uint32_t                          setSize = m_arena->handle_set_size;
+
+    // Smaller and equal submissions reuse the arrays
+    for (uint32_t n = 0; n < 100; n++)
+    {
+        EXPECT_EQ(3u, Submit({{7, 8}, {8, 9}}));
+        EXPECT_EQ(3000u, Submit({large}));
+    }
+    EXPECT_EQ(obj, m_arena->obj);
+    EXPECT_EQ(set, m_arena->handle_set);
+    EXPECT_EQ(objSize, m_arena->obj_size);
+    EXPECT_EQ(setSize, m_arena->handle_set_size);
+}
+
+TEST_F(MosExec3ArenaTest, GenerationWrap)
+{
+    EXPECT_EQ(3u, Submit({{1, 2, 3}}));
+
+    // Slots left with the last generation before the wrap are cleared
+    m_arena->generation = UINT32_MAX - 1;
+    EXPECT_EQ(3u, Submit({{1, 2, 3}}));
+    EXPECT_EQ(UINT32_MAX, m_arena->generation);
+    EXPECT_EQ(3u, Submit({{1, 2, 3}}));
+    EXPECT_EQ(1u, m_arena->generation);
+    EXPECT_EQ(3u, Submit({{3, 2, 1}}));
+}
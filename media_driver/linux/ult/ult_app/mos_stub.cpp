@@ -19,10 +19,18 @@
 * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
 * OTHER DEALINGS IN THE SOFTWARE.
 */
+#include <cstdlib>
 #include <cstring>
+#include <time.h>
 #include "mos_utilities.h"
+#include "mos_interface.h"
+#include "null_hardware.h"
 using namespace std;
 
+int32_t      MosUtilities::m_mosMemAllocCounter = 0;
+bool         NullHW::m_enabled                  = false;
+PerfUtility *g_perfutility                      = nullptr;
+
 void MosUtilities::MosZeroMemory(void *pDestination, size_t stLength)
 {
     if(pDestination != nullptr)
@@ -31,3 +39,220 @@ void MosUtilities::MosZeroMemory(void *pDestination, size_t stLength)
     }
 }
 
+#if MOS_MESSAGES_ENABLED
+void *MosUtilities::MosAllocMemoryUtils(size_t size, const char *functionName, const char *filename, int32_t line)
+#else
+void *MosUtilities::MosAllocMemory(size_t size)
+#endif
+{
+    return malloc(size);
+}
+
+#if MOS_MESSAGES_ENABLED
+void *MosUtilities::MosAllocAndZeroMemoryUtils(size_t size, const char *functionName, const char *filename, int32_t line)
+#else
+void *MosUtilities::MosAllocAndZeroMemory(size_t size)
+#endif
+{
+    return calloc(1, size);
+}
+
+#if MOS_MESSAGES_ENABLED
+void MosUtilities::MosFreeMemoryUtils(void *ptr, const char *functionName, const char *filename, int32_t line)
+#else
+void MosUtilities::MosFreeMemory(void *ptr)
+#endif
+{
+    free(ptr);
+}
+
+int32_t MosUtilities::MosQueryPerformanceFrequency(uint64_t *pFrequency)
+{
+    struct timespec Res;
+
+    if (pFrequency == nullptr || clock_getres(CLOCK_MONOTONIC, &Res) != 0 || Res.tv_sec != 0)
+    {
+        return false;
+    }
+    *pFrequency = (uint64_t)((1000 * 1000 * 1000) / Res.tv_nsec);
+
+    return true;
+}
+
+int32_t MosUtilities::MosQueryPerformanceCounter(uint64_t *pPerformanceCount)
+{
+    struct timespec Res;
+    struct timespec t;
+
+    if (pPerformanceCount == nullptr || clock_getres(CLOCK_MONOTONIC, &Res) != 0 || Res.tv_sec != 0 ||
+        clock_gettime(CLOCK_MONOTONIC, &t) != 0)
+    {
+        return false;
+    }
+    *pPerformanceCount = (uint64_t)((1000 * 1000 * 1000 * t.tv_sec + t.tv_nsec) / Res.tv_nsec);
+
+    return true;
+}
+
+int32_t MosUtilities::MosSecureStringPrint(char *buffer, size_t bufSize, size_t length, const char * const format, ...)
+{
+    int32_t iRet = -1;
+    va_list var_args;
+
+    if ((buffer == nullptr) || (format == nullptr) || (bufSize < length))
+    {
+        return iRet;
+    }
+
+    va_start(var_args, format);
+    iRet = vsnprintf(buffer, length, format, var_args);
+    va_end(var_args);
+
+    return iRet;
+}
+
+MOS_STATUS MosUtilities::MosSecureMemcpy(void *pDestination, size_t dstLength, PCVOID pSource, size_t srcLength)
+{
+    if (pDestination == nullptr || pSource == nullptr || dstLength < srcLength)
+    {
+        return MOS_STATUS_INVALID_PARAMETER;
+    }
+    if (pDestination != pSource)
+    {
+        memcpy(pDestination, pSource, srcLength);
+    }
+    return MOS_STATUS_SUCCESS;
+}
+
+int32_t MosUtilities::MosAtomicIncrement(int32_t *pValue)
+{
+    return __sync_add_and_fetch(pValue, 1);
+}
+
+int32_t MosUtilities::MosAtomicDecrement(int32_t *pValue)
+{
+    return __sync_sub_and_fetch(pValue, 1);
+}
+
+double MosUtilities::MosGetTime()
+{
+    return 0;
+}
+
+MOS_STATUS MosUtilities::MosWriteFileFromPtr(const char *pFilename, void *lpBuffer, uint32_t writeSize)
+{
+    // No dumps from the tests
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS MosUtilities::MosUserFeatureReadValueID(
+    PMOS_USER_FEATURE_INTERFACE  pOsUserFeatureInterface,
+    uint32_t                     ValueID,
+    PMOS_USER_FEATURE_VALUE_DATA pValueData,
+    MOS_CONTEXT_HANDLE           mosCtx)
+{
+    // No registry: callers keep their default value
+    return MOS_STATUS_USER_FEATURE_KEY_READ_FAILED;
+}
+
+MOS_STATUS MosUtilities::MosUserFeatureWriteValuesID(
+    PMOS_USER_FEATURE_INTERFACE        pOsUserFeatureInterface,
+    PMOS_USER_FEATURE_VALUE_WRITE_DATA pWriteValues,
+    uint32_t                           uiNumOfValues,
+    MOS_CONTEXT_HANDLE                 mosCtx)
+{
+    return MOS_STATUS_SUCCESS;
+}
+
+void MosInterface::MosResetResource(PMOS_RESOURCE resource)
+{
+    if (resource == nullptr)
+    {
+        return;
+    }
+
+    MosUtilities::MosZeroMemory(resource, sizeof(MOS_RESOURCE));
+    resource->Format = Format_None;
+    for (int32_t i = 0; i < MOS_GPU_CONTEXT_MAX; i++)
+    {
+        resource->iAllocationIndex[i] = MOS_INVALID_ALLOC_INDEX;
+    }
+}
+
+bool MosInterface::MosResourceIsNull(PMOS_RESOURCE resource)
+{
+    if (nullptr == resource)
+    {
+        return true;
+    }
+
+    return ((resource->bo == nullptr)
+#if (_DEBUG || _RELEASE_INTERNAL)
+         && ((resource->pData == nullptr) )
+#endif // (_DEBUG || _RELEASE_INTERNAL)
+    );
+}
+
+bool MosInterface::IsAsyncDevice(MOS_STREAM_HANDLE streamState)
+{
+    return false;
+}
+
+bool MosInterface::IsCompressibelSurfaceSupported(MEDIA_FEATURE_TABLE *skuTable)
+{
+    if (skuTable)
+    {
+        return MEDIA_IS_SKU(skuTable, FtrCompressibleSurfaceDefault);
+    }
+    return true;
+}
+
+#if (_DEBUG || _RELEASE_INTERNAL)
+bool MosUtilities::MosSimulateAllocMemoryFail(
+    size_t      size,
+    size_t      alignment,
+    const char *functionName,
+    const char *filename,
+    int32_t     line)
+{
+    return false;
+}
+#endif
+
+#if MOS_MESSAGES_ENABLED
+// g_perfutility is not set in the ULT, the perf ticks of VP_FUNC_CALL are never taken
+void PerfUtility::startTick(std::string tag)
+{
+}
+
+void PerfUtility::stopTick(std::string tag)
+{
+}
+
+void MosUtilities::MosTraceEvent(
+    uint16_t   usId,
+    uint8_t    ucType,
+    const void *pArg1,
+    uint32_t   dwSize1,
+    const void *pArg2,
+    uint32_t   dwSize2)
+{
+}
+
+void MosUtilDebug::MosMessage(
+    MOS_MESSAGE_LEVEL level,
+    MOS_COMPONENT_ID  compID,
+    uint8_t           subCompID,
+    const PCCHAR      functionName,
+    int32_t           lineNum,
+    const PCCHAR      message,
+    ...)
+{
+}
+#endif
+
+#if MOS_ASSERT_ENABLED
+void MosUtilDebug::MosAssert(MOS_COMPONENT_ID compID, uint8_t subCompID)
+{
+}
+#endif
@@ -0,0 +1,191 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <random>
+#include <vector>
+#include "gtest/gtest.h"
+#include "mos_utilities.h"
+#include "mos_system_shadow.h"
+
+using namespace std;
+
+// Nested band locks of a s/w swizzled surface, as done by
+// GraphicsResourceSpecificNext::Lock/Unlock, on a mock bo. Checked bit-exact
+// against the full surface de-swizzle and re-swizzle the shadow used before.
+class MosSystemShadowTest : public testing::Test
+{
+protected:
+    enum LockMode
+    {
+        lockRead,
+        lockWrite,
+        lockWriteDiscard,
+    };
+
+    struct Lock
+    {
+        uint32_t offsetY;
+        uint32_t height;
+        LockMode mode;
+    };
+
+    void Init(uint32_t pitch, uint32_t height)
+    {
+        m_pitch  = pitch;
+        m_height = height;
+        // the bo covers whole tile rows
+        m_bo.resize((size_t)pitch * ((height + 31) & ~31));
+        for (auto &b : m_bo)
+        {
+            b = (uint8_t)m_rand();
+        }
+        m_linear.resize((size_t)pitch * height);
+        MosUtilities::MosSwizzleData(m_bo.data(), m_linear.data(), MOS_TILE_Y, MOS_TILE_LINEAR, height, pitch, 0);
+        m_expected = m_bo;
+    }
+
+    // Runs the locks nested in one map of the bo, then unlocks
+    void Run(const vector<Lock> &locks)
+    {
+        MosSystemShadow shadow;
+        ASSERT_EQ(MOS_STATUS_SUCCESS, shadow.Allocate(m_linear.size(), m_pitch, m_height, 0));
+
+        for (auto &lock : locks)
+        {
+            ASSERT_EQ(MOS_STATUS_SUCCESS, shadow.Update(m_bo.data(), lock.offsetY, lock.height,
+                                              lock.mode != lockRead, lock.mode == lockWriteDiscard));
+
+            uint32_t endY = (lock.height == 0) ? m_height : min(m_height, lock.offsetY + lock.height);
+            size_t   start = (size_t)lock.offsetY * m_pitch;
+            size_t   end   = (size_t)endY * m_pitch;
+            uint8_t *data  = shadow.GetData();
+            if (lock.mode != lockWriteDiscard)
+            {
+                for (size_t i = start; i < end; i++)
+                {
+                    ASSERT_EQ(m_linear[i], data[i]) << "row " << i / m_pitch;
+                }
+            }
+            if (lock.mode == lockRead)
+            {
+                continue;
+            }
+            // a write lock writes some bytes of its band, a discard lock all of them
+            for (size_t i = start; i < end; i++)
+            {
+                if (lock.mode == lockWriteDiscard || m_rand() % 4 == 0)
+                {
+                    data[i] = m_linear[i] = (uint8_t)m_rand();
+                }
+            }
+        }
+
+        shadow.Flush(m_bo.data());
+        shadow.Free();
+
+        bool written = false;
+        for (auto &lock : locks)
+        {
+            written = written || lock.mode != lockRead;
+        }
+        if (written)
+        {
+            MosUtilities::MosSwizzleData(m_linear.data(), m_expected.data(), MOS_TILE_LINEAR, MOS_TILE_Y, m_height, m_pitch, 0);
+        }
+        ASSERT_EQ(m_expected, m_bo);
+    }
+
+    Lock RandomLock()
+    {
+        Lock lock;
+        lock.offsetY = m_rand() % m_height;
+        lock.height  = (m_rand() % 4 == 0) ? 0 : 1 + m_rand() % (m_height - lock.offsetY);
+        if (lock.height == 0)
+        {
+            lock.offsetY = 0;
+        }
+        lock.mode = (LockMode)(m_rand() % 3);
+        return lock;
+    }
+
+    mt19937         m_rand{2026};
+    uint32_t        m_pitch  = 0;
+    uint32_t        m_height = 0;
+    vector<uint8_t> m_bo;
+    vector<uint8_t> m_linear;
+    vector<uint8_t> m_expected;
+};
+
+TEST_F(MosSystemShadowTest, WholeSurfaceLock)
+{
+    Init(512, 96);
+    Run({{0, 0, lockWrite}});
+    Init(512, 96);
+    Run({{0, 0, lockRead}});
+}
+
+TEST_F(MosSystemShadowTest, BandLocks)
+{
+    Init(256, 200);
+    // band inside one tile row, band across tile rows, band up to a partial last tile row
+    Run({{40, 8, lockWrite}, {20, 50, lockRead}, {150, 50, lockWrite}});
+}
+
+TEST_F(MosSystemShadowTest, WriteDiscardKeepsRowsOutsideTheBand)
+{
+    Init(384, 160);
+    // partly covered edge tile rows are de-swizzled, covered ones are not
+    Run({{10, 100, lockWriteDiscard}});
+    Init(384, 160);
+    Run({{32, 64, lockWriteDiscard}, {0, 0, lockRead}});
+}
+
+TEST_F(MosSystemShadowTest, ReadOnlyLocksLeaveTheBo)
+{
+    Init(128, 64);
+    Run({{0, 16, lockRead}, {8, 48, lockRead}});
+}
+
+TEST_F(MosSystemShadowTest, RandomNestedLocks)
+{
+    for (uint32_t i = 0; i < 200; i++)
+    {
+        Init(128 * (1 + m_rand() % 8), 1 + m_rand() % 150);
+        vector<Lock> locks(1 + m_rand() % 4);
+        for (auto &lock : locks)
+        {
+            lock = RandomLock();
+        }
+        Run(locks);
+        if (HasFatalFailure())
+        {
+            return;
+        }
+    }
+}
+
+TEST_F(MosSystemShadowTest, BandBelowTheSurface)
+{
+    Init(128, 64);
+    MosSystemShadow shadow;
+    ASSERT_EQ(MOS_STATUS_SUCCESS, shadow.Allocate(m_linear.size(), m_pitch, m_height, 0));
+    EXPECT_EQ(MOS_STATUS_INVALID_PARAMETER, shadow.Update(m_bo.data(), 64, 1, false, false));
+}
@@ -0,0 +1,274 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <map>
+#include <random>
+#include <vector>
+#include "gtest/gtest.h"
+#include "mos_vma.h"
+
+using namespace std;
+
+// Free ranges kept as a map, allocating with the rules of the original sorted hole list:
+// the highest (or lowest) hole that fits wins, at its highest (or lowest) aligned address.
+class RefVmaHeap
+{
+public:
+    RefVmaHeap(uint64_t start, uint64_t size, bool allocHigh) : m_allocHigh(allocHigh)
+    {
+        m_holes[start] = size;
+    }
+
+    uint64_t Alloc(uint64_t size, uint64_t alignment)
+    {
+        if (m_allocHigh)
+        {
+            for (auto it = m_holes.rbegin(); it != m_holes.rend(); ++it)
+            {
+                if (size > it->second)
+                {
+                    continue;
+                }
+                uint64_t offset = (it->first + it->second - size) / alignment * alignment;
+                if (offset >= it->first)
+                {
+                    Take(it->first, offset, size);
+                    return offset;
+                }
+            }
+        }
+        else
+        {
+            for (auto it = m_holes.begin(); it != m_holes.end(); ++it)
+            {
+                if (size > it->second)
+                {
+                    continue;
+                }
+                uint64_t pad = (alignment - it->first % alignment) % alignment;
+                if (pad <= it->second - size)
+                {
+                    uint64_t offset = it->first + pad;
+                    Take(it->first, offset, size);
+                    return offset;
+                }
+            }
+        }
+        return 0;
+    }
+
+    bool AllocAddr(uint64_t offset, uint64_t size)
+    {
+        auto it = m_holes.upper_bound(offset);
+        if (it == m_holes.begin())
+        {
+            return false;
+        }
+        --it;
+        if (offset + size > it->first + it->second)
+        {
+            return false;
+        }
+        Take(it->first, offset, size);
+        return true;
+    }
+
+    void Free(uint64_t offset, uint64_t size)
+    {
+        auto next = m_holes.find(offset + size);
+        if (next != m_holes.end())
+        {
+            size += next->second;
+            m_holes.erase(next);
+        }
+        auto prev = m_holes.lower_bound(offset);
+        if (prev != m_holes.begin() && (--prev)->first + prev->second == offset)
+        {
+            prev->second += size;
+            return;
+        }
+        m_holes[offset] = size;
+    }
+
+    void GetStats(mos_vma_heap_stats &stats) const
+    {
+        stats = {};
+        for (auto &hole : m_holes)
+        {
+            stats.hole_count++;
+            stats.free_size   += hole.second;
+            stats.largest_hole = max(stats.largest_hole, hole.second);
+        }
+    }
+
+private:
+    void Take(uint64_t holeOffset, uint64_t offset, uint64_t size)
+    {
+        uint64_t holeSize = m_holes[holeOffset];
+        m_holes.erase(holeOffset);
+        if (offset > holeOffset)
+        {
+            m_holes[holeOffset] = offset - holeOffset;
+        }
+        if (offset + size < holeOffset + holeSize)
+        {
+            m_holes[offset + size] = holeOffset + holeSize - offset - size;
+        }
+    }
+
+    map<uint64_t, uint64_t> m_holes;
+    bool                    m_allocHigh;
+};
+
+static const uint64_t g_vmaStart = 1ull << 32;
+static const uint64_t g_vmaSize  = 1ull << 40;
+
+class MosVmaTest : public testing::TestWithParam<bool>
+{
+protected:
+    struct Range
+    {
+        uint64_t offset;
+        uint64_t size;
+    };
+
+    void SetUp()
+    {
+        mos_vma_heap_init(&m_heap, g_vmaStart, g_vmaSize);
+        m_heap.alloc_high = GetParam();
+    }
+
+    void TearDown()
+    {
+        mos_vma_heap_finish(&m_heap);
+    }
+
+    void ExpectStats(const RefVmaHeap &ref)
+    {
+        mos_vma_heap_stats stats    = {};
+        mos_vma_heap_stats refStats = {};
+        mos_vma_heap_get_stats(&m_heap, &stats);
+        ref.GetStats(refStats);
+        EXPECT_EQ(refStats.hole_count, stats.hole_count);
+        EXPECT_EQ(refStats.free_size, stats.free_size);
+        EXPECT_EQ(refStats.largest_hole, stats.largest_hole);
+    }
+
+    mos_vma_heap m_heap;
+};
+
+TEST_P(MosVmaTest, RandomAgainstReference)
+{
+    RefVmaHeap    ref(g_vmaStart, g_vmaSize, GetParam());
+    vector<Range> live;
+    mt19937_64    rng(1234);
+
+    for (uint32_t i = 0; i < 20000; i++)
+    {
+        uint32_t op = rng() % 10;
+        if (op < 6 || live.empty())
+        {
+            // Mostly small buffers, some large ones to fill the heap
+            uint64_t size      = (rng() % 4096 + 1) * 4096 * ((rng() % 8 == 0) ? 256 : 1);
+            uint64_t alignment = 4096ull << (rng() % 9);
+            uint64_t offset    = mos_vma_heap_alloc(&m_heap, size, alignment);
+            ASSERT_EQ(ref.Alloc(size, alignment), offset) << "alloc " << i;
+            if (offset)
+            {
+                live.push_back({offset, size});
+            }
+        }
+        else if (op < 9)
+        {
+            size_t idx   = rng() % live.size();
+            Range  range = live[idx];
+            live[idx]    = live.back();
+            live.pop_back();
+            mos_vma_heap_free(&m_heap, range.offset, range.size);
+            ref.Free(range.offset, range.size);
+        }
+        else
+        {
+            uint64_t offset = (g_vmaStart + rng() % g_vmaSize) & ~0xfffull;
+            uint64_t size   = (rng() % 64 + 1) * 4096;
+            bool     ret    = mos_vma_heap_alloc_addr(&m_heap, offset, size);
+            ASSERT_EQ(ref.AllocAddr(offset, size), ret) << "alloc_addr " << i;
+            if (ret)
+            {
+                live.push_back({offset, size});
+            }
+        }
+
+        if (i % 100 == 0)
+        {
+            ExpectStats(ref);
+        }
+    }
+    ExpectStats(ref);
+
+    // Everything freed merges back into a single hole
+    for (auto &range : live)
+    {
+        mos_vma_heap_free(&m_heap, range.offset, range.size);
+    }
+    mos_vma_heap_stats stats = {};
+    mos_vma_heap_get_stats(&m_heap, &stats);
+    EXPECT_EQ(1u, stats.hole_count);
+    EXPECT_EQ(g_vmaSize, stats.free_size);
+    EXPECT_EQ(g_vmaSize, stats.largest_hole);
+}
+
+TEST_P(MosVmaTest, Exhaust)
+{
+    const uint64_t size = g_vmaSize / 64;
+    vector<Range>  live;
+
+    for (uint32_t i = 0; i < 64; i++)
+    {
+        uint64_t offset = mos_vma_heap_alloc(&m_heap, size, 4096);
+        ASSERT_NE(0u, offset);
+        live.push_back({offset, size});
+    }
+    EXPECT_EQ(0u, mos_vma_heap_alloc(&m_heap, 4096, 4096));
+    EXPECT_FALSE(mos_vma_heap_alloc_addr(&m_heap, g_vmaStart, 4096));
+
+    // Free every other range, then the rest in reverse: holes split and merge back
+    for (uint32_t i = 0; i < live.size(); i += 2)
+    {
+        mos_vma_heap_free(&m_heap, live[i].offset, live[i].size);
+    }
+    mos_vma_heap_stats stats = {};
+    mos_vma_heap_get_stats(&m_heap, &stats);
+    EXPECT_EQ(32u, stats.hole_count);
+    EXPECT_EQ(g_vmaSize / 2, stats.free_size);
+    EXPECT_EQ(size, stats.largest_hole);
+    EXPECT_EQ(0u, mos_vma_heap_alloc(&m_heap, size * 2, 4096));
+
+    for (int32_t i = live.size() - 1; i > 0; i -= 2)
+    {
+        mos_vma_heap_free(&m_heap, live[i].offset, live[i].size);
+    }
+    mos_vma_heap_get_stats(&m_heap, &stats);
+    EXPECT_EQ(1u, stats.hole_count);
+    EXPECT_EQ(g_vmaSize, stats.largest_hole);
+}
+
+INSTANTIATE_TEST_CASE_P(AllocPolicy, MosVmaTest, testing::Values(true, false));
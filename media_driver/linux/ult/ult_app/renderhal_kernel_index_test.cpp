@@ -0,0 +1,300 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <cstring>
+#include "gtest/gtest.h"
+#include "renderhal.h"
+#include "renderhal_kernel_index.h"
+#include "hal_kerneldll_next.h"
+
+static const int32_t KERNEL_COUNT = 8;
+static const int32_t BLOCK_SIZE   = 64;
+static const int32_t HEAP_SIZE    = KERNEL_COUNT * BLOCK_SIZE;
+static const int32_t KERNEL_BASE  = 128;
+static const int32_t KUID_COUNT   = 4 * KERNEL_COUNT;
+
+static MOS_STATUS RefreshSync(PRENDERHAL_INTERFACE pRenderHal)
+{
+    // The test completes submissions by setting dwSyncTag itself
+    return MOS_STATUS_SUCCESS;
+}
+
+// Kernel heap of a render HAL set up as RenderHal_AllocateStateHeaps does, loaded,
+// unloaded and touched through the RenderHal_* kernel functions of renderhal_kernel.cpp
+class RenderHalKernelIndexTest : public testing::Test
+{
+protected:
+    void SetUp()
+    {
+        m_stateHeap.pKernelAllocation = m_allocations;
+        m_stateHeap.pKernelAllocNode  = m_nodes;
+        m_stateHeap.pIshBuffer        = m_ish;
+        m_stateHeap.dwKernelBase      = KERNEL_BASE;
+        m_stateHeap.bGshLocked        = true;
+
+        m_renderHal.pStateHeap                         = &m_stateHeap;
+        m_renderHal.StateHeapSettings.iKernelCount     = KERNEL_COUNT;
+        m_renderHal.StateHeapSettings.iKernelHeapSize  = HEAP_SIZE;
+        m_renderHal.StateHeapSettings.iKernelBlockSize = BLOCK_SIZE;
+        m_renderHal.pfnRefreshSync                     = RefreshSync;
+        m_renderHal.pfnLoadKernel                      = RenderHal_LoadKernel;
+        m_renderHal.pfnUnloadKernel                    = RenderHal_UnloadKernel;
+        m_renderHal.pfnTouchKernel                     = RenderHal_TouchKernel;
+        m_renderHal.pfnResetKernels                    = RenderHal_ResetKernels;
+        m_renderHal.pfnResetKernels(&m_renderHal);
+    }
+
+    // Kernel binary of kuid, each byte tells the kernel apart
+    void FillBinary(int32_t kuid, int32_t size)
+    {
+        memset(m_binary, kuid + 1, size);
+    }
+
+    int32_t Load(int32_t kuid, int32_t size = BLOCK_SIZE)
+    {
+        RENDERHAL_KERNEL_PARAM parameters = {};
+        MHW_KERNEL_PARAM       kernel     = {};
+
+        FillBinary(kuid, size);
+        kernel.pBinary = m_binary;
+        kernel.iSize   = size;
+        kernel.iKUID   = kuid;
+        kernel.iKCID   = 0;
+        return m_renderHal.pfnLoadKernel(&m_renderHal, &parameters, &kernel, &m_entries[kuid]);
+    }
+
+    bool Unload(int32_t id)
+    {
+        return m_renderHal.pfnUnloadKernel(&m_renderHal, id) == MOS_STATUS_SUCCESS &&
+               m_allocations[id].dwFlags == RENDERHAL_KERNEL_ALLOCATION_FREE;
+    }
+
+    // Submit the kernels touched so far and emit a new sync tag
+    void Submit()
+    {
+        m_stateHeap.dwNextTag++;
+    }
+
+    // GPU completes submissions up to tag
+    void Complete(uint32_t tag)
+    {
+        m_stateHeap.dwSyncTag = tag;
+    }
+
+    // Kernel kuid is loaded in entry id, its binary in the heap block of the entry
+    void ExpectLoaded(int32_t kuid, int32_t id)
+    {
+        EXPECT_EQ(id, RenderHal_FindKernelAllocation(&m_stateHeap, kuid, 0));
+        EXPECT_EQ(kuid, m_allocations[id].iKUID);
+        EXPECT_EQ(1u, m_entries[kuid].dwLoaded);
+
+        uint32_t offset = m_allocations[id].dwOffset;
+        ASSERT_GE(offset, (uint32_t)KERNEL_BASE);
+        ASSERT_LE(offset + BLOCK_SIZE, (uint32_t)(KERNEL_BASE + HEAP_SIZE));
+        for (int32_t i = 0; i < BLOCK_SIZE; i++)
+        {
+            ASSERT_EQ((uint8_t)(kuid + 1), m_ish[offset + i]) << "kernel " << kuid << ", byte " << i;
+        }
+    }
+
+    int32_t ListCount(int32_t list)
+    {
+        int32_t count = 0;
+        for (int32_t id = m_stateHeap.KernelIndexList[list].iHead;
+             id != RENDERHAL_KERNEL_INDEX_NONE;
+             id = m_nodes[id].iNext)
+        {
+            count++;
+        }
+        EXPECT_EQ(count, m_stateHeap.KernelIndexList[list].iCount);
+        return count;
+    }
+
+    RENDERHAL_INTERFACE       m_renderHal   = {};
+    RENDERHAL_STATE_HEAP      m_stateHeap   = {};
+    RENDERHAL_KRN_ALLOCATION  m_allocations[KERNEL_COUNT] = {};
+    RENDERHAL_KRN_ALLOC_NODE  m_nodes[KERNEL_COUNT]       = {};
+    Kdll_CacheEntry           m_entries[KUID_COUNT]       = {};
+    uint8_t                   m_ish[KERNEL_BASE + HEAP_SIZE] = {};
+    uint8_t                   m_binary[HEAP_SIZE]            = {};
+};
+
+TEST_F(RenderHalKernelIndexTest, FindsLoadedKernels)
+{
+    for (int32_t kuid = 0; kuid < KERNEL_COUNT; kuid++)
+    {
+        EXPECT_EQ(kuid, Load(kuid));
+    }
+    for (int32_t kuid = 0; kuid < KERNEL_COUNT; kuid++)
+    {
+        ExpectLoaded(kuid, kuid);
+    }
+    EXPECT_EQ(RENDERHAL_KERNEL_INDEX_NONE, RenderHal_FindKernelAllocation(&m_stateHeap, 0, 1));
+    EXPECT_EQ(RENDERHAL_KERNEL_INDEX_NONE, RenderHal_FindKernelAllocation(&m_stateHeap, KERNEL_COUNT, 0));
+
+    // A loaded kernel is not copied again
+    EXPECT_EQ(2, Load(2));
+    EXPECT_EQ(HEAP_SIZE, m_stateHeap.iKernelUsed);
+
+    EXPECT_TRUE(Unload(3));
+    EXPECT_EQ(0u, m_entries[3].dwLoaded);
+    EXPECT_EQ(RENDERHAL_KERNEL_INDEX_NONE, RenderHal_FindKernelAllocation(&m_stateHeap, 3, 0));
+    EXPECT_EQ(1, ListCount(RENDERHAL_KERNEL_LIST_FREE));
+    EXPECT_EQ(KERNEL_COUNT - 1, ListCount(RENDERHAL_KERNEL_LIST_LRU));
+
+    // Reload reuses the deallocated block
+    EXPECT_EQ(3, Load(KERNEL_COUNT));
+    EXPECT_EQ(HEAP_SIZE, m_stateHeap.iKernelUsed);
+    ExpectLoaded(KERNEL_COUNT, 3);
+
+    m_renderHal.pfnResetKernels(&m_renderHal);
+    EXPECT_EQ(KERNEL_COUNT, ListCount(RENDERHAL_KERNEL_LIST_EMPTY));
+    EXPECT_EQ(0, ListCount(RENDERHAL_KERNEL_LIST_LRU));
+    EXPECT_EQ(0, m_stateHeap.iKernelUsed);
+    EXPECT_EQ(0u, m_entries[0].dwLoaded);
+    EXPECT_EQ(RENDERHAL_KERNEL_INDEX_NONE, RenderHal_FindKernelAllocation(&m_stateHeap, 0, 0));
+}
+
+TEST_F(RenderHalKernelIndexTest, EvictsLeastRecentlyUsed)
+{
+    for (int32_t kuid = 0; kuid < KERNEL_COUNT; kuid++)
+    {
+        Load(kuid);
+    }
+    Submit();
+    Complete(m_stateHeap.dwNextTag);
+
+    // Kernel 0 used again, kernel 1 is now the oldest
+    EXPECT_EQ(0, Load(0));
+    EXPECT_EQ(1, RenderHal_FindKernelToUnload(&m_stateHeap, BLOCK_SIZE));
+    EXPECT_EQ(1, Load(KERNEL_COUNT));
+    EXPECT_EQ(0u, m_entries[1].dwLoaded);
+    EXPECT_EQ(RENDERHAL_KERNEL_INDEX_NONE, RenderHal_FindKernelAllocation(&m_stateHeap, 1, 0));
+    ExpectLoaded(KERNEL_COUNT, 1);
+    ExpectLoaded(0, 0);
+
+    // Locked kernels and blocks too small are skipped
+    m_allocations[2].dwFlags = RENDERHAL_KERNEL_ALLOCATION_LOCKED;
+    m_allocations[3].iSize   = BLOCK_SIZE / 2;
+    EXPECT_EQ(4, RenderHal_FindKernelToUnload(&m_stateHeap, BLOCK_SIZE));
+    EXPECT_EQ(4, Load(KERNEL_COUNT + 1));
+    ExpectLoaded(KERNEL_COUNT + 1, 4);
+}
+
+TEST_F(RenderHalKernelIndexTest, EvictionUnderSyncTagPressure)
+{
+    // Every kernel is in a different submission still in flight
+    m_stateHeap.dwNextTag = 1;
+    for (int32_t kuid = 0; kuid < KERNEL_COUNT; kuid++)
+    {
+        Load(kuid);
+        Submit();
+    }
+    Complete(0);
+    EXPECT_EQ(RENDERHAL_KERNEL_INDEX_NONE, RenderHal_FindKernelToUnload(&m_stateHeap, BLOCK_SIZE));
+    EXPECT_EQ(RENDERHAL_KERNEL_LOAD_FAIL, Load(KERNEL_COUNT));
+
+    // Oldest submissions retire one at a time, evictions follow in LRU order
+    for (int32_t kuid = 0; kuid < KERNEL_COUNT; kuid++)
+    {
+        Complete(kuid + 1);
+        EXPECT_EQ(kuid, Load(KERNEL_COUNT + kuid));
+        EXPECT_EQ(RENDERHAL_KERNEL_LOAD_FAIL, Load(2 * KERNEL_COUNT + kuid));
+    }
+    for (int32_t kuid = 0; kuid < KERNEL_COUNT; kuid++)
+    {
+        ExpectLoaded(KERNEL_COUNT + kuid, kuid);
+    }
+    EXPECT_EQ(KERNEL_COUNT, ListCount(RENDERHAL_KERNEL_LIST_LRU));
+}
+
+TEST_F(RenderHalKernelIndexTest, EvictionSkipsInFlightAcrossTagWrap)
+{
+    m_stateHeap.dwNextTag = 0xFFFFFFFE;
+    m_stateHeap.dwSyncTag = 0xFFFFFFFD;
+
+    for (int32_t kuid = 0; kuid < KERNEL_COUNT; kuid++)
+    {
+        Load(kuid);
+        Submit();
+    }
+
+    // Touched again in the newest submission: oldest in LRU order, but busy
+    Load(0);
+    Load(1);
+    Submit();
+
+    // Tags wrapped; kernels 2..5 completed, 6, 7, 0 and 1 still in flight
+    Complete(3);
+    EXPECT_EQ(2, RenderHal_FindKernelToUnload(&m_stateHeap, BLOCK_SIZE));
+    EXPECT_EQ(2, Load(KERNEL_COUNT));
+    EXPECT_EQ(3, Load(KERNEL_COUNT + 1));
+    EXPECT_EQ(4, Load(KERNEL_COUNT + 2));
+    EXPECT_EQ(5, Load(KERNEL_COUNT + 3));
+    EXPECT_EQ(RENDERHAL_KERNEL_LOAD_FAIL, Load(KERNEL_COUNT + 4));
+    EXPECT_FALSE(Unload(6));
+
+    // Last submission retires: the least recently used kernel not touched since is 6
+    Complete(m_stateHeap.dwNextTag);
+    EXPECT_EQ(6, RenderHal_FindKernelToUnload(&m_stateHeap, BLOCK_SIZE));
+    EXPECT_EQ(6, Load(KERNEL_COUNT + 4));
+    ExpectLoaded(KERNEL_COUNT + 4, 6);
+}
+
+TEST_F(RenderHalKernelIndexTest, FreeBlockReuse)
+{
+    for (int32_t kuid = 0; kuid < KERNEL_COUNT; kuid++)
+    {
+        Load(kuid);
+    }
+    Submit();
+    Complete(m_stateHeap.dwNextTag);
+
+    // Two blocks freed, the kernel fits the first one in the free list
+    EXPECT_TRUE(Unload(5));
+    EXPECT_TRUE(Unload(2));
+    EXPECT_EQ(2, ListCount(RENDERHAL_KERNEL_LIST_FREE));
+    int32_t id = Load(KERNEL_COUNT, BLOCK_SIZE / 2);
+    EXPECT_TRUE(id == 2 || id == 5);
+    EXPECT_EQ(BLOCK_SIZE, m_allocations[id].iSize);
+    EXPECT_EQ(1, ListCount(RENDERHAL_KERNEL_LIST_FREE));
+
+    // The rest of the block is cleared
+    uint32_t offset = m_allocations[id].dwOffset;
+    for (int32_t i = BLOCK_SIZE / 2; i < BLOCK_SIZE; i++)
+    {
+        EXPECT_EQ(0, m_ish[offset + i]);
+    }
+
+    // Loaded blocks never overlap
+    for (int32_t i = 0; i < KERNEL_COUNT; i++)
+    {
+        for (int32_t j = i + 1; j < KERNEL_COUNT; j++)
+        {
+            if (m_allocations[i].dwFlags == RENDERHAL_KERNEL_ALLOCATION_FREE ||
+                m_allocations[j].dwFlags == RENDERHAL_KERNEL_ALLOCATION_FREE)
+            {
+                continue;
+            }
+            EXPECT_NE(m_allocations[i].dwOffset, m_allocations[j].dwOffset);
+        }
+    }
+}
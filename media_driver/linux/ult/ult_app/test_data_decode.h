@@ -29,6 +29,10 @@
 #include "driver_loader.h"
 
 #define DEC_FRAME_NUM 3
+#define DEC_DEEP_PIPELINE_LOOPS 32 // 96 frames, more than the bitstream buffer pool can hold
+#define DEC_BITSTREAM_POOL_MAX 64 // DDI_CODEC_MAX_BITSTREAM_BUFFER_POOL
+#define DEC_BITSTREAM_POOL_MAX_ORPHANS 16 // DDI_CODEC_BITSTREAM_POOL_MAX_ORPHANS
+#define DEC_BITSTREAM_BUFFER_NAME "Media Buffer" // bo name of the bitstream buffers
 
 const FeatureID TEST_Intel_Decode_HEVC = { VAProfileHEVCMain, VAEntrypointVLD, };
 const FeatureID TEST_Intel_Decode_AVC  = { VAProfileH264Main, VAEntrypointVLD, };
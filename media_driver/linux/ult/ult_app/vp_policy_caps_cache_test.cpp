@@ -0,0 +1,272 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <functional>
+#include "gtest/gtest.h"
+#include "vp_policy_caps_cache.h"
+
+using namespace vp;
+
+// Parameters of a scaling + csc + rotation pipe, as the SwFilters of one input hold them
+struct CapsCachePipe
+{
+    FeatureParamCsc     csc;
+    FeatureParamScaling scaling;
+    FeatureParamRotMir  rotMir;
+    VP_EngineEntry      cscCaps     = {};
+    VP_EngineEntry      scalingCaps = {};
+    VP_EngineEntry      rotMirCaps  = {};
+};
+
+class VpPolicyCapsCacheTest : public testing::Test
+{
+protected:
+    static CapsCachePipe MakePipe(uint32_t outputWidth, uint32_t outputHeight)
+    {
+        CapsCachePipe pipe;
+        pipe.csc.formatInput                  = Format_NV12;
+        pipe.csc.formatOutput                 = Format_A8R8G8B8;
+        pipe.csc.input.colorSpace             = CSpace_BT709;
+        pipe.csc.output.colorSpace            = CSpace_sRGB;
+        pipe.scaling.formatInput              = Format_NV12;
+        pipe.scaling.formatOutput             = Format_A8R8G8B8;
+        pipe.scaling.input.dwWidth            = 1920;
+        pipe.scaling.input.dwHeight           = 1080;
+        pipe.scaling.input.rcSrc              = {0, 0, 1920, 1080};
+        pipe.scaling.input.rcDst              = {0, 0, (int32_t)outputWidth, (int32_t)outputHeight};
+        pipe.scaling.output.dwWidth           = outputWidth;
+        pipe.scaling.output.dwHeight          = outputHeight;
+        pipe.scaling.output.rcSrc             = {0, 0, (int32_t)outputWidth, (int32_t)outputHeight};
+        pipe.scaling.output.rcDst             = {0, 0, (int32_t)outputWidth, (int32_t)outputHeight};
+        pipe.scaling.scalingMode              = VPHAL_SCALING_AVS;
+        pipe.scaling.scalingPreference        = VPHAL_SCALING_PREFER_SFC;
+        pipe.rotMir.formatInput               = Format_NV12;
+        pipe.rotMir.formatOutput              = Format_A8R8G8B8;
+        pipe.rotMir.rotation                  = VPHAL_ROTATION_90;
+        pipe.rotMir.surfInfo.tileOutput       = MOS_TILE_Y;
+        return pipe;
+    }
+
+    // Stands in for the per-feature caps query of Policy::BuildExecutionEngines: the caps
+    // are a function of the parameters, and the scaling query may force its preference.
+    static void ResolveCaps(CapsCachePipe &pipe)
+    {
+        bool downscale = pipe.scaling.output.dwWidth < pipe.scaling.input.dwWidth;
+
+        pipe.cscCaps.bEnabled     = 1;
+        pipe.cscCaps.SfcNeeded    = pipe.csc.output.colorSpace != pipe.csc.input.colorSpace;
+        pipe.cscCaps.VeboxNeeded  = 1;
+
+        pipe.scalingCaps.bEnabled       = 1;
+        pipe.scalingCaps.SfcNeeded      = 1;
+        pipe.scalingCaps.RenderNeeded   = pipe.scaling.output.dwWidth * 8 < pipe.scaling.input.dwWidth;
+        pipe.scalingCaps.sfc2PassScalingNeededX = downscale && pipe.scaling.output.dwWidth * 4 < pipe.scaling.input.dwWidth;
+        if (pipe.scalingCaps.RenderNeeded)
+        {
+            pipe.scaling.scalingPreference = VPHAL_SCALING_PREFER_COMP;
+        }
+
+        pipe.rotMirCaps.bEnabled  = 1;
+        pipe.rotMirCaps.SfcNeeded = pipe.rotMir.surfInfo.tileOutput == MOS_TILE_Y;
+        pipe.rotMirCaps.RenderNeeded = !pipe.rotMirCaps.SfcNeeded;
+    }
+
+    // Same flow as Policy::GetExecuteCaps for a cacheable pipe
+    bool BuildKey(CapsCachePipe &pipe)
+    {
+        m_cache.ResetKey();
+        m_cache.AddToKey(0);    // sfc disabled
+        m_cache.AddToKey(0);    // vebox output disabled
+        m_cache.AddToKey(1);    // input pipes
+        m_cache.AddCscToKey(pipe.csc);
+        m_cache.AddScalingToKey(pipe.scaling);
+        m_cache.AddRotMirToKey(pipe.rotMir);
+        m_cache.AddToKey(FeatureTypeInvalid);
+
+        m_features.clear();
+        m_features.push_back({&pipe.cscCaps, nullptr});
+        m_features.push_back({&pipe.scalingCaps, &pipe.scaling.scalingPreference});
+        m_features.push_back({&pipe.rotMirCaps, nullptr});
+        return true;
+    }
+
+    bool GetCaps(CapsCachePipe &pipe)
+    {
+        BuildKey(pipe);
+        if (m_cache.Apply(m_features))
+        {
+            return true;
+        }
+        ResolveCaps(pipe);
+        m_cache.Save(m_features);
+        return false;
+    }
+
+    static void ExpectSameCaps(const CapsCachePipe &expected, const CapsCachePipe &actual)
+    {
+        EXPECT_EQ(expected.cscCaps.value, actual.cscCaps.value);
+        EXPECT_EQ(expected.scalingCaps.value, actual.scalingCaps.value);
+        EXPECT_EQ(expected.rotMirCaps.value, actual.rotMirCaps.value);
+        EXPECT_EQ(expected.scaling.scalingPreference, actual.scaling.scalingPreference);
+    }
+
+    bool IsHit(CapsCachePipe pipe)
+    {
+        BuildKey(pipe);
+        return m_cache.Apply(m_features);
+    }
+
+    VpPolicyCapsCache                       m_cache;
+    std::vector<VpPolicyCapsCache::Feature> m_features;
+};
+
+TEST_F(VpPolicyCapsCacheTest, CachedRunMatchesUncachedRun)
+{
+    // a stream switching between 3 output sizes, one of them forcing the scaling preference
+    const uint32_t sizes[][2] = {{1280, 720}, {640, 360}, {200, 112}};
+
+    for (uint32_t frame = 0; frame < 30; frame++)
+    {
+        const uint32_t *size = sizes[frame % 3];
+
+        CapsCachePipe uncached = MakePipe(size[0], size[1]);
+        ResolveCaps(uncached);
+
+        CapsCachePipe cached = MakePipe(size[0], size[1]);
+        EXPECT_EQ(frame >= 3, GetCaps(cached));
+        ExpectSameCaps(uncached, cached);
+    }
+
+    EXPECT_EQ(27u, m_cache.GetHitCount());
+    EXPECT_EQ(3u, m_cache.GetMissCount());
+}
+
+TEST_F(VpPolicyCapsCacheTest, KeyCoversParameters)
+{
+    VPHAL_ALPHA_PARAMS     alpha     = {};
+    VPHAL_COLORFILL_PARAMS colorFill = {};
+    VPHAL_IEF_PARAMS       ief       = {};
+
+    CapsCachePipe base = MakePipe(1280, 720);
+    GetCaps(base);
+    EXPECT_TRUE(IsHit(MakePipe(1280, 720)));
+
+    std::vector<std::function<void(CapsCachePipe &)>> changes = {
+        [](CapsCachePipe &p) { p.csc.formatOutput = Format_X8R8G8B8; },
+        [](CapsCachePipe &p) { p.csc.input.colorSpace = CSpace_BT601; },
+        [](CapsCachePipe &p) { p.csc.output.chromaSiting = 1; },
+        [&](CapsCachePipe &p) { p.csc.pIEFParams = &ief; },
+        [&](CapsCachePipe &p) { p.csc.pAlphaParams = &alpha; },
+        [](CapsCachePipe &p) { p.scaling.input.dwHeight = 1088; },
+        [](CapsCachePipe &p) { p.scaling.input.rcSrc.left = 2; },
+        [](CapsCachePipe &p) { p.scaling.output.rcDst.bottom = 700; },
+        [](CapsCachePipe &p) { p.scaling.input.sampleType = SAMPLE_SINGLE_TOP_FIELD; },
+        [](CapsCachePipe &p) { p.scaling.isPrimary = true; },
+        [](CapsCachePipe &p) { p.scaling.scalingMode = VPHAL_SCALING_BILINEAR; },
+        [](CapsCachePipe &p) { p.scaling.scalingPreference = VPHAL_SCALING_PREFER_SFC_FOR_VEBOX; },
+        [](CapsCachePipe &p) { p.scaling.interlacedScalingType = ISCALING_INTERLEAVED_TO_INTERLEAVED; },
+        [&](CapsCachePipe &p) { p.scaling.pColorFillParams = &colorFill; },
+        [&](CapsCachePipe &p) { p.scaling.pCompAlpha = &alpha; },
+        [](CapsCachePipe &p) { p.rotMir.rotation = VPHAL_ROTATION_180; },
+        [](CapsCachePipe &p) { p.rotMir.surfInfo.tileOutput = MOS_TILE_LINEAR; },
+    };
+
+    for (uint32_t i = 0; i < changes.size(); i++)
+    {
+        CapsCachePipe pipe = MakePipe(1280, 720);
+        changes[i](pipe);
+        EXPECT_FALSE(IsHit(pipe)) << "change " << i;
+    }
+
+    // flags of the parameters pointed to
+    CapsCachePipe pipe = MakePipe(1280, 720);
+    pipe.scaling.pColorFillParams = &colorFill;
+    GetCaps(pipe);
+    colorFill.bDisableColorfillinSFC = true;
+    EXPECT_FALSE(IsHit(pipe));
+    alpha.AlphaMode = VPHAL_ALPHA_FILL_MODE_SOURCE_STREAM;
+    pipe.scaling.pColorFillParams = nullptr;
+    pipe.scaling.pCompAlpha       = &alpha;
+    GetCaps(pipe);
+    alpha.AlphaMode = VPHAL_ALPHA_FILL_MODE_BACKGROUND;
+    EXPECT_FALSE(IsHit(pipe));
+}
+
+TEST_F(VpPolicyCapsCacheTest, ApplyOnMissKeepsCaps)
+{
+    CapsCachePipe pipe = MakePipe(1280, 720);
+    pipe.scaling.scalingPreference = VPHAL_SCALING_PREFER_SFC_FOR_VEBOX;
+    BuildKey(pipe);
+    EXPECT_FALSE(m_cache.Apply(m_features));
+    EXPECT_EQ(0u, pipe.scalingCaps.value);
+    EXPECT_EQ(VPHAL_SCALING_PREFER_SFC_FOR_VEBOX, pipe.scaling.scalingPreference);
+}
+
+TEST_F(VpPolicyCapsCacheTest, EvictLeastRecentlyUsed)
+{
+    for (uint32_t i = 0; i < VP_POLICY_CAPS_CACHE_MAX_SIZE; i++)
+    {
+        CapsCachePipe pipe = MakePipe(640 + i * 16, 360);
+        GetCaps(pipe);
+    }
+    EXPECT_EQ((uint32_t)VP_POLICY_CAPS_CACHE_MAX_SIZE, m_cache.GetSize());
+
+    // the first configuration is used again, the second one is now the oldest
+    EXPECT_TRUE(IsHit(MakePipe(640, 360)));
+
+    CapsCachePipe pipe = MakePipe(1920, 1080);
+    GetCaps(pipe);
+    EXPECT_EQ((uint32_t)VP_POLICY_CAPS_CACHE_MAX_SIZE, m_cache.GetSize());
+
+    EXPECT_TRUE(IsHit(MakePipe(640, 360)));
+    EXPECT_FALSE(IsHit(MakePipe(640 + 16, 360)));
+    for (uint32_t i = 2; i < VP_POLICY_CAPS_CACHE_MAX_SIZE; i++)
+    {
+        EXPECT_TRUE(IsHit(MakePipe(640 + i * 16, 360))) << i;
+    }
+    EXPECT_TRUE(IsHit(MakePipe(1920, 1080)));
+
+    m_cache.Clear();
+    EXPECT_EQ(0u, m_cache.GetSize());
+    EXPECT_FALSE(IsHit(MakePipe(1920, 1080)));
+}
+
+TEST_F(VpPolicyCapsCacheTest, ReplaceEntry)
+{
+    CapsCachePipe pipe = MakePipe(1280, 720);
+    BuildKey(pipe);
+    m_cache.Add({1, 2, 3, 4});
+    m_cache.Add({5, 6, 0, 8});
+    EXPECT_EQ(1u, m_cache.GetSize());
+
+    EXPECT_TRUE(IsHit(pipe));
+    CapsCachePipe cached = MakePipe(1280, 720);
+    BuildKey(cached);
+    EXPECT_TRUE(m_cache.Apply(m_features));
+    EXPECT_EQ(5u, cached.cscCaps.value);
+    EXPECT_EQ(6u, cached.scalingCaps.value);
+    EXPECT_EQ(VPHAL_SCALING_PREFER_SFC, cached.scaling.scalingPreference);
+    EXPECT_EQ(8u, cached.rotMirCaps.value);
+
+    // caps saved for another feature layout are not applied
+    m_cache.Add({1});
+    EXPECT_FALSE(IsHit(pipe));
+}
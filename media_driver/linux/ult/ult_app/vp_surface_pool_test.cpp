@@ -0,0 +1,618 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <set>
+#include <vector>
+#include "gtest/gtest.h"
+#include "vp_allocator.h"
+#include "media_mem_compression.h"
+
+using namespace vp;
+
+static const uint32_t SLOT_NUM = 4;     // e.g. vebox output surfaces
+
+// media_mem_compression.cpp takes the MI interface from MhwMiInterface, which the
+// allocator never uses: the ULT builds the MMC without one.
+MediaMemComp::MediaMemComp(PMOS_INTERFACE osInterface, MhwMiInterface *miInterface) :
+    MediaMemCompNext(osInterface, nullptr),
+    m_mhwMiInterface(miInterface)
+{
+}
+
+class MockMmc : public MediaMemComp
+{
+public:
+    MockMmc(PMOS_INTERFACE osInterface) : MediaMemComp(osInterface, nullptr)
+    {
+    }
+
+    void Enable()
+    {
+        m_mmcEnabled = true;
+    }
+};
+
+// Resource of the fake bufmgr, with the parameters it was allocated with
+struct MockBo
+{
+    MOS_ALLOC_GFXRES_PARAMS params;
+    std::vector<uint8_t>    data;
+};
+
+// MOS interface over a fake bufmgr, counting the resources allocated and freed
+struct MockOsInterface : public MOS_INTERFACE
+{
+    MockOsInterface()
+    {
+        MOS_INTERFACE *osInterface = this;
+        memset(osInterface, 0, sizeof(MOS_INTERFACE));
+        pfnAllocateResource         = AllocateResource;
+        pfnFreeResource             = FreeResource;
+        pfnFreeResourceWithFlag     = FreeResourceWithFlag;
+        pfnGetResourceInfo          = GetResourceInfo;
+        pfnLockResource             = LockResource;
+        pfnUnlockResource           = UnlockResource;
+        pfnGetSkuTable              = GetSkuTable;
+        pfnGetUserSettingInstance   = GetUserSettingInstance;
+        pfnGetMemoryCompressionMode = GetMemoryCompressionMode;
+        pfnGetMemoryCompressionFormat = GetMemoryCompressionFormat;
+    }
+
+    static MockOsInterface &Get(PMOS_INTERFACE osInterface)
+    {
+        return *static_cast<MockOsInterface *>(osInterface);
+    }
+
+    static MockBo *Bo(PMOS_RESOURCE resource)
+    {
+        return reinterpret_cast<MockBo *>(resource->bo);
+    }
+
+#if MOS_MESSAGES_ENABLED
+    static MOS_STATUS AllocateResource(PMOS_INTERFACE osInterface, PMOS_ALLOC_GFXRES_PARAMS params,
+        const char *functionName, const char *filename, int32_t line, PMOS_RESOURCE resource)
+#else
+    static MOS_STATUS AllocateResource(PMOS_INTERFACE osInterface, PMOS_ALLOC_GFXRES_PARAMS params, PMOS_RESOURCE resource)
+#endif
+    {
+        MockOsInterface &os = Get(osInterface);
+        MockBo          *bo = new MockBo;
+
+        bo->params    = *params;
+        resource->bo  = reinterpret_cast<MOS_LINUX_BO *>(bo);
+        os.m_live.insert(bo);
+        os.m_allocCount++;
+        if (params->pSystemMemory)
+        {
+            os.m_systemMemoryCount++;
+        }
+        return MOS_STATUS_SUCCESS;
+    }
+
+    static void Free(PMOS_INTERFACE osInterface, PMOS_RESOURCE resource)
+    {
+        MockOsInterface &os = Get(osInterface);
+        MockBo          *bo = Bo(resource);
+
+        EXPECT_EQ(1u, os.m_live.erase(bo)) << "resource freed twice or never allocated";
+        delete bo;
+        resource->bo = nullptr;
+        os.m_freeCount++;
+    }
+
+#if MOS_MESSAGES_ENABLED
+    static void FreeResource(PMOS_INTERFACE osInterface, const char *functionName, const char *filename, int32_t line, PMOS_RESOURCE resource)
+#else
+    static void FreeResource(PMOS_INTERFACE osInterface, PMOS_RESOURCE resource)
+#endif
+    {
+        Free(osInterface, resource);
+    }
+
+#if MOS_MESSAGES_ENABLED
+    static void FreeResourceWithFlag(PMOS_INTERFACE osInterface, PMOS_RESOURCE resource, const char *functionName, const char *filename, int32_t line, uint32_t flag)
+#else
+    static void FreeResourceWithFlag(PMOS_INTERFACE osInterface, PMOS_RESOURCE resource, uint32_t flag)
+#endif
+    {
+        Free(osInterface, resource);
+    }
+
+    static MOS_STATUS GetResourceInfo(PMOS_INTERFACE osInterface, PMOS_RESOURCE resource, PMOS_SURFACE details)
+    {
+        MockBo *bo = Bo(resource);
+        if (nullptr == bo)
+        {
+            return MOS_STATUS_NULL_POINTER;
+        }
+        details->Format          = bo->params.Format;
+        details->Type            = bo->params.Type;
+        details->TileType        = bo->params.TileType;
+        details->dwWidth         = bo->params.dwWidth;
+        details->dwHeight        = bo->params.dwHeight;
+        details->dwDepth         = 1;
+        details->dwPitch         = MOS_ALIGN_CEIL(bo->params.dwWidth, 64);
+        details->dwSize          = details->dwPitch * bo->params.dwHeight * 3 / 2;
+        details->bCompressible   = bo->params.bIsCompressible;
+        details->CompressionMode = bo->params.CompressionMode;
+        return MOS_STATUS_SUCCESS;
+    }
+
+    static void *LockResource(PMOS_INTERFACE osInterface, PMOS_RESOURCE resource, PMOS_LOCK_PARAMS flags)
+    {
+        MockBo *bo = Bo(resource);
+        bo->data.resize((size_t)MOS_ALIGN_CEIL(bo->params.dwWidth, 64) * bo->params.dwHeight * 3 / 2, 0xff);
+        Get(osInterface).m_lockCount++;
+        return bo->data.data();
+    }
+
+    static MOS_STATUS UnlockResource(PMOS_INTERFACE osInterface, PMOS_RESOURCE resource)
+    {
+        return MOS_STATUS_SUCCESS;
+    }
+
+    static MEDIA_FEATURE_TABLE *GetSkuTable(PMOS_INTERFACE osInterface)
+    {
+        return nullptr;
+    }
+
+    static MediaUserSettingSharedPtr GetUserSettingInstance(PMOS_INTERFACE osInterface)
+    {
+        return nullptr;
+    }
+
+    static MOS_STATUS GetMemoryCompressionMode(PMOS_INTERFACE osInterface, PMOS_RESOURCE resource, PMOS_MEMCOMP_STATE mmcMode)
+    {
+        MockBo *bo = Bo(resource);
+        *mmcMode   = bo->params.bIsCompressible ? (MOS_MEMCOMP_STATE)bo->params.CompressionMode : MOS_MEMCOMP_DISABLED;
+        return MOS_STATUS_SUCCESS;
+    }
+
+    static MOS_STATUS GetMemoryCompressionFormat(PMOS_INTERFACE osInterface, PMOS_RESOURCE resource, uint32_t *mmcFormat)
+    {
+        *mmcFormat = 0;
+        return MOS_STATUS_SUCCESS;
+    }
+
+    std::set<MockBo *> m_live;
+    uint32_t           m_allocCount        = 0;
+    uint32_t           m_freeCount         = 0;
+    uint32_t           m_lockCount         = 0;
+    uint32_t           m_systemMemoryCount = 0;
+};
+
+// Intermediate surfaces reallocated through VpAllocator::ReAllocateSurface, as
+// VpResourceManager does for every frame
+class VpSurfacePoolTest : public testing::Test
+{
+protected:
+    void SetUp()
+    {
+        m_mmc       = new MockMmc(&m_osInterface);
+        m_allocator = new VpAllocator(&m_osInterface, m_mmc);
+    }
+
+    void TearDown()
+    {
+        for (auto &slot : m_slots)
+        {
+            m_allocator->DestroyVpSurface(slot);
+        }
+        delete m_allocator;
+        delete m_mmc;
+        EXPECT_EQ(0u, m_osInterface.m_live.size());
+        EXPECT_EQ(m_osInterface.m_allocCount, m_osInterface.m_freeCount);
+    }
+
+    MOS_STATUS ReAllocate(VP_SURFACE *&surface, uint32_t width, uint32_t height, bool &allocated,
+        bool deferred = false, MOS_FORMAT format = Format_NV12, bool zeroOnAllocate = false, void *systemMemory = nullptr)
+    {
+        return m_allocator->ReAllocateSurface(surface, "VeboxOutput", format, MOS_GFXRES_2D, MOS_TILE_Y,
+            width, height, false, MOS_MMC_DISABLED, allocated, zeroOnAllocate, deferred,
+            MOS_HW_RESOURCE_DEF_MAX, MOS_TILE_UNSET_GMM, MOS_MEMPOOL_VIDEOMEMORY, false, systemMemory);
+    }
+
+    void Frame(uint32_t width, uint32_t height)
+    {
+        for (auto &slot : m_slots)
+        {
+            bool allocated = false;
+            ASSERT_EQ(MOS_STATUS_SUCCESS, ReAllocate(slot, width, height, allocated));
+            ASSERT_NE(nullptr, slot);
+            EXPECT_EQ(width, slot->osSurface->dwWidth);
+            EXPECT_EQ(height, slot->osSurface->dwHeight);
+        }
+    }
+
+    const VpSurfacePool<VP_SURFACE> &Pool()
+    {
+        return m_allocator->GetSurfacePool();
+    }
+
+    MockOsInterface m_osInterface;
+    MockMmc        *m_mmc                = nullptr;
+    VpAllocator    *m_allocator          = nullptr;
+    VP_SURFACE     *m_slots[SLOT_NUM]   = {};
+};
+
+TEST_F(VpSurfacePoolTest, LadderSwitch)
+{
+    const uint32_t ladder[][2] = {{1920, 1080}, {1280, 720}, {854, 480}};
+
+    // First pass over the ladder allocates every rung once
+    for (auto &rung : ladder)
+    {
+        Frame(rung[0], rung[1]);
+    }
+    EXPECT_EQ(3 * SLOT_NUM, m_osInterface.m_allocCount);
+
+    // Switching back and forth afterwards only reuses pooled surfaces
+    for (uint32_t i = 0; i < 30; i++)
+    {
+        auto &rung = ladder[(i * 7) % 3];
+        Frame(rung[0], rung[1]);
+        Frame(rung[0], rung[1]);
+    }
+    EXPECT_EQ(3 * SLOT_NUM, m_osInterface.m_allocCount);
+    EXPECT_EQ(0u, m_osInterface.m_freeCount);
+    EXPECT_EQ(m_osInterface.m_allocCount, Pool().GetAllocCount());
+    EXPECT_GT(Pool().GetReuseCount(), 0u);
+    EXPECT_EQ(0u, Pool().GetEvictCount());
+    EXPECT_EQ(2 * SLOT_NUM, Pool().GetCount());
+}
+
+TEST_F(VpSurfacePoolTest, ReuseResetsSurface)
+{
+    VP_SURFACE *surface   = nullptr;
+    bool        allocated = false;
+
+    ASSERT_EQ(MOS_STATUS_SUCCESS, ReAllocate(surface, 1920, 1080, allocated));
+    EXPECT_TRUE(allocated);
+    VP_SURFACE *first = surface;
+    MockBo     *bo    = MockOsInterface::Bo(&surface->osSurface->OsResource);
+
+    // Same parameters: nothing to do
+    ASSERT_EQ(MOS_STATUS_SUCCESS, ReAllocate(surface, 1920, 1080, allocated));
+    EXPECT_FALSE(allocated);
+    EXPECT_EQ(first, surface);
+
+    // State left by the previous user of the surface
+    surface->ColorSpace   = CSpace_BT2020;
+    surface->ChromaSiting = CHROMA_SITING_VERT_CENTER;
+    surface->SampleType   = SAMPLE_SINGLE_TOP_FIELD;
+    surface->rcSrc        = {16, 16, 960, 540};
+    surface->rcDst        = {0, 0, 640, 360};
+    surface->rcMaxSrc     = surface->rcSrc;
+    surface->bVEBOXCroppingUsed = true;
+
+    ASSERT_EQ(MOS_STATUS_SUCCESS, ReAllocate(surface, 1280, 720, allocated));
+    ASSERT_EQ(MOS_STATUS_SUCCESS, ReAllocate(surface, 1920, 1080, allocated));
+    EXPECT_TRUE(allocated);
+    EXPECT_EQ(2u, m_osInterface.m_allocCount);
+
+    ASSERT_EQ(first, surface);
+    EXPECT_EQ(bo, MockOsInterface::Bo(&surface->osSurface->OsResource));
+    EXPECT_TRUE(surface->isResourceOwner);
+    EXPECT_EQ(CSpace_None, surface->ColorSpace);
+    EXPECT_EQ(0u, surface->ChromaSiting);
+    EXPECT_EQ(SAMPLE_PROGRESSIVE, surface->SampleType);
+    EXPECT_FALSE(surface->bVEBOXCroppingUsed);
+    for (auto rect : {surface->rcSrc, surface->rcDst, surface->rcMaxSrc})
+    {
+        EXPECT_EQ(0, rect.left);
+        EXPECT_EQ(0, rect.top);
+        EXPECT_EQ(1920, rect.right);
+        EXPECT_EQ(1080, rect.bottom);
+    }
+
+    m_allocator->DestroyVpSurface(surface);
+}
+
+TEST_F(VpSurfacePoolTest, ReuseBufferKeepsBufferSize)
+{
+    VP_SURFACE *surface   = nullptr;
+    bool        allocated = false;
+
+    ASSERT_EQ(MOS_STATUS_SUCCESS, ReAllocate(surface, 256, 64, allocated, false, Format_Buffer));
+    VP_SURFACE *first = surface;
+    ASSERT_EQ(MOS_STATUS_SUCCESS, ReAllocate(surface, 128, 64, allocated, false, Format_Buffer));
+    ASSERT_EQ(MOS_STATUS_SUCCESS, ReAllocate(surface, 256, 64, allocated, false, Format_Buffer));
+
+    ASSERT_EQ(first, surface);
+    EXPECT_EQ(2u, m_osInterface.m_allocCount);
+    EXPECT_EQ(256u, surface->bufferWidth);
+    EXPECT_EQ(64u, surface->bufferHeight);
+
+    // Same parameters: nothing to do
+    ASSERT_EQ(MOS_STATUS_SUCCESS, ReAllocate(surface, 256, 64, allocated, false, Format_Buffer));
+    EXPECT_FALSE(allocated);
+
+    m_allocator->DestroyVpSurface(surface);
+}
+
+TEST_F(VpSurfacePoolTest, ChangedSurfaceNotPooled)
+{
+    VP_SURFACE *surface   = nullptr;
+    bool        allocated = false;
+
+    ASSERT_EQ(MOS_STATUS_SUCCESS, ReAllocate(surface, 1920, 1080, allocated));
+    // The user reinterprets the surface, it no longer matches the parameters it was allocated with
+    surface->osSurface->Format = Format_P010;
+
+    ASSERT_EQ(MOS_STATUS_SUCCESS, ReAllocate(surface, 1280, 720, allocated));
+    EXPECT_EQ(1u, m_osInterface.m_freeCount);
+    EXPECT_EQ(0u, Pool().GetCount());
+
+    ASSERT_EQ(MOS_STATUS_SUCCESS, ReAllocate(surface, 1920, 1080, allocated));
+    EXPECT_EQ(3u, m_osInterface.m_allocCount);
+    EXPECT_EQ(Format_NV12, surface->osSurface->Format);
+
+    m_allocator->DestroyVpSurface(surface);
+}
+
+TEST_F(VpSurfacePoolTest, ZeroedAndSystemMemorySurfacesNotPooled)
+{
+    VP_SURFACE *surface   = nullptr;
+    bool        allocated = false;
+    uint8_t     systemMemory[64];
+
+    // Surface to be zeroed is not taken from the pool
+    Frame(1920, 1080);
+    Frame(1280, 720);
+    ASSERT_EQ(MOS_STATUS_SUCCESS, ReAllocate(surface, 1920, 1080, allocated, false, Format_NV12, true));
+    EXPECT_EQ(2 * SLOT_NUM + 1, m_osInterface.m_allocCount);
+    EXPECT_EQ(1u, m_osInterface.m_lockCount);
+    EXPECT_EQ(SLOT_NUM, Pool().GetCount());
+
+    // Surface backed by system memory is not put into the pool
+    ASSERT_EQ(MOS_STATUS_SUCCESS, ReAllocate(surface, 16, 4, allocated, false, Format_NV12, false, systemMemory));
+    EXPECT_EQ(1u, m_osInterface.m_systemMemoryCount);
+    ASSERT_EQ(MOS_STATUS_SUCCESS, ReAllocate(surface, 32, 4, allocated));
+    EXPECT_EQ(1u, m_osInterface.m_freeCount);
+    EXPECT_EQ(SLOT_NUM + 1, Pool().GetCount());
+
+    m_allocator->DestroyVpSurface(surface);
+}
+
+TEST_F(VpSurfacePoolTest, DeferredReleaseAfterCleanRecycler)
+{
+    VP_SURFACE *surface   = nullptr;
+    VP_SURFACE *other     = nullptr;
+    bool        allocated = false;
+
+    ASSERT_EQ(MOS_STATUS_SUCCESS, ReAllocate(surface, 1920, 1080, allocated));
+    VP_SURFACE *first = surface;
+
+    // Released by a later pipe of the frame: still in use by the GPU
+    ASSERT_EQ(MOS_STATUS_SUCCESS, ReAllocate(surface, 1280, 720, allocated, true));
+    EXPECT_EQ(0u, Pool().GetCount());
+    ASSERT_EQ(MOS_STATUS_SUCCESS, ReAllocate(other, 1920, 1080, allocated));
+    EXPECT_NE(first, other);
+    EXPECT_EQ(3u, m_osInterface.m_allocCount);
+    m_allocator->DestroyVpSurface(other);
+
+    // Reused once the frame is done
+    m_allocator->CleanRecycler();
+    EXPECT_EQ(1u, Pool().GetCount());
+    ASSERT_EQ(MOS_STATUS_SUCCESS, ReAllocate(other, 1920, 1080, allocated));
+    EXPECT_EQ(first, other);
+    EXPECT_EQ(3u, m_osInterface.m_allocCount);
+    EXPECT_EQ(1u, m_osInterface.m_freeCount);
+
+    m_allocator->DestroyVpSurface(surface);
+    m_allocator->DestroyVpSurface(other);
+}
+
+TEST_F(VpSurfacePoolTest, EvictedSurfacesFreed)
+{
+    // One slot switching through more sizes than the pool keeps
+    const uint32_t sizeNum = VP_SURFACE_POOL_MAX_COUNT + 6;
+
+    for (uint32_t i = 0; i < sizeNum; i++)
+    {
+        bool allocated = false;
+        ASSERT_EQ(MOS_STATUS_SUCCESS, ReAllocate(m_slots[0], 64 + i * 16, 64, allocated));
+    }
+    EXPECT_EQ(sizeNum, m_osInterface.m_allocCount);
+    EXPECT_EQ((uint32_t)VP_SURFACE_POOL_MAX_COUNT, Pool().GetCount());
+    EXPECT_EQ(sizeNum - 1 - VP_SURFACE_POOL_MAX_COUNT, Pool().GetEvictCount());
+    EXPECT_EQ(Pool().GetEvictCount(), m_osInterface.m_freeCount);
+    EXPECT_EQ(sizeNum - m_osInterface.m_freeCount, m_osInterface.m_live.size());
+
+    // The least recently released sizes are the evicted ones
+    bool allocated = false;
+    ASSERT_EQ(MOS_STATUS_SUCCESS, ReAllocate(m_slots[1], 64, 64, allocated));
+    EXPECT_EQ(sizeNum + 1, m_osInterface.m_allocCount);
+    ASSERT_EQ(MOS_STATUS_SUCCESS, ReAllocate(m_slots[2], 64 + (sizeNum - 2) * 16, 64, allocated));
+    EXPECT_EQ(sizeNum + 1, m_osInterface.m_allocCount);
+}
+
+TEST_F(VpSurfacePoolTest, SetLimits)
+{
+    VP_SURFACE *surface   = nullptr;
+    bool        allocated = false;
+
+    Frame(1920, 1080);
+    Frame(1280, 720);
+    Frame(854, 480);
+    EXPECT_EQ(2 * SLOT_NUM, Pool().GetCount());
+    EXPECT_EQ(0u, m_osInterface.m_freeCount);
+
+    // Lowering the limits frees the least recently released surfaces at once
+    m_allocator->SetSurfacePoolLimits(UINT64_MAX, SLOT_NUM);
+    EXPECT_EQ(SLOT_NUM, Pool().GetCount());
+    EXPECT_EQ(SLOT_NUM, m_osInterface.m_freeCount);
+    ASSERT_EQ(MOS_STATUS_SUCCESS, ReAllocate(surface, 1280, 720, allocated));
+    EXPECT_EQ(3 * SLOT_NUM, m_osInterface.m_allocCount);
+    ASSERT_EQ(MOS_STATUS_SUCCESS, ReAllocate(surface, 1920, 1080, allocated));
+    EXPECT_EQ(3 * SLOT_NUM + 1, m_osInterface.m_allocCount);
+    m_allocator->DestroyVpSurface(surface);
+
+    // Size limit of one surface
+    uint64_t surfaceSize = Pool().GetSize() / Pool().GetCount();
+    m_allocator->SetSurfacePoolLimits(surfaceSize, SLOT_NUM);
+    EXPECT_EQ(1u, Pool().GetCount());
+    EXPECT_EQ(surfaceSize, Pool().GetSize());
+
+    // No surface is kept with a count limit of 0
+    m_allocator->SetSurfacePoolLimits(UINT64_MAX, 0);
+    EXPECT_EQ(0u, Pool().GetCount());
+    uint32_t freeCount = m_osInterface.m_freeCount;
+    Frame(1280, 720);
+    EXPECT_EQ(0u, Pool().GetCount());
+    EXPECT_EQ(freeCount + SLOT_NUM, m_osInterface.m_freeCount);
+}
+
+TEST_F(VpSurfacePoolTest, CompressedSurfacesKeptApart)
+{
+    m_mmc->Enable();
+
+    VP_SURFACE *surface   = nullptr;
+    bool        allocated = false;
+
+    ASSERT_EQ(MOS_STATUS_SUCCESS, m_allocator->ReAllocateSurface(surface, "Compressed", Format_NV12, MOS_GFXRES_2D, MOS_TILE_Y,
+        1920, 1080, true, MOS_MMC_MC, allocated));
+    EXPECT_TRUE(surface->osSurface->bCompressible);
+    VP_SURFACE *compressed = surface;
+    ASSERT_EQ(MOS_STATUS_SUCCESS, ReAllocate(surface, 1280, 720, allocated));
+
+    // Uncompressed request does not get the compressed surface
+    ASSERT_EQ(MOS_STATUS_SUCCESS, ReAllocate(surface, 1920, 1080, allocated));
+    EXPECT_NE(compressed, surface);
+    EXPECT_FALSE(surface->osSurface->bCompressible);
+    EXPECT_EQ(3u, m_osInterface.m_allocCount);
+
+    ASSERT_EQ(MOS_STATUS_SUCCESS, m_allocator->ReAllocateSurface(surface, "Compressed", Format_NV12, MOS_GFXRES_2D, MOS_TILE_Y,
+        1920, 1080, true, MOS_MMC_MC, allocated));
+    EXPECT_EQ(compressed, surface);
+    EXPECT_EQ(3u, m_osInterface.m_allocCount);
+
+    m_allocator->DestroyVpSurface(surface);
+}
+
+TEST_F(VpSurfacePoolTest, DestroyFreesPool)
+{
+    VP_SURFACE *surface   = nullptr;
+    bool        allocated = false;
+
+    Frame(1920, 1080);
+    Frame(1280, 720);
+    ASSERT_EQ(MOS_STATUS_SUCCESS, ReAllocate(surface, 854, 480, allocated));
+    ASSERT_EQ(MOS_STATUS_SUCCESS, ReAllocate(surface, 640, 360, allocated, true));
+    EXPECT_EQ(SLOT_NUM, Pool().GetCount());
+
+    // Pooled and deferred released surfaces are freed with the allocator
+    for (auto &slot : m_slots)
+    {
+        m_allocator->DestroyVpSurface(slot);
+    }
+    m_allocator->DestroyVpSurface(surface);
+    delete m_allocator;
+    m_allocator = nullptr;
+    EXPECT_EQ(0u, m_osInterface.m_live.size());
+
+    m_allocator = new VpAllocator(&m_osInterface, m_mmc);
+}
+
+// VpSurfacePool on its own, with surfaces standing in for VP_SURFACE
+struct MockSurface
+{
+    VP_SURFACE_POOL_KEY key;
+};
+
+static VP_SURFACE_POOL_KEY PoolKey(uint32_t width, uint32_t height, uint32_t format = 1)
+{
+    VP_SURFACE_POOL_KEY key = {};
+    key.format   = format;
+    key.tileType = 2;
+    key.width    = width;
+    key.height   = height;
+    return key;
+}
+
+static uint64_t PoolSize(const VP_SURFACE_POOL_KEY &key)
+{
+    return (uint64_t)key.width * key.height * 3 / 2;
+}
+
+TEST(VpSurfacePoolKeyTest, KeyMismatch)
+{
+    VpSurfacePool<MockSurface> pool;
+    std::vector<MockSurface *> evicted;
+    MockSurface                surface = {PoolKey(1920, 1080)};
+
+    pool.Release(surface.key, &surface, PoolSize(surface.key), evicted);
+    EXPECT_EQ(nullptr, pool.Acquire(PoolKey(1920, 1080, 2)));
+    EXPECT_EQ(nullptr, pool.Acquire(PoolKey(1920, 1088)));
+    EXPECT_EQ(&surface, pool.Acquire(PoolKey(1920, 1080)));
+    EXPECT_EQ(nullptr, pool.Acquire(PoolKey(1920, 1080)));
+    EXPECT_EQ(0u, pool.GetCount());
+    EXPECT_EQ(0u, pool.GetSize());
+    EXPECT_TRUE(evicted.empty());
+}
+
+TEST(VpSurfacePoolKeyTest, EvictLeastRecentlyReleased)
+{
+    VpSurfacePool<MockSurface> pool(UINT64_MAX, 2);
+    std::vector<MockSurface *> evicted;
+    MockSurface                surfaces[3] = {{PoolKey(1920, 1080)}, {PoolKey(1280, 720)}, {PoolKey(1920, 1080)}};
+
+    for (auto &s : surfaces)
+    {
+        pool.Release(s.key, &s, PoolSize(s.key), evicted);
+    }
+    ASSERT_EQ(1u, evicted.size());
+    EXPECT_EQ(&surfaces[0], evicted[0]);
+    EXPECT_EQ(1u, pool.GetEvictCount());
+
+    // Evicted surface is no longer handed out
+    EXPECT_EQ(&surfaces[2], pool.Acquire(PoolKey(1920, 1080)));
+    EXPECT_EQ(nullptr, pool.Acquire(PoolKey(1920, 1080)));
+    EXPECT_EQ(&surfaces[1], pool.Acquire(PoolKey(1280, 720)));
+}
+
+TEST(VpSurfacePoolKeyTest, SizeLimit)
+{
+    const uint64_t             maxSize = PoolSize(PoolKey(1920, 1080)) * 2;
+    VpSurfacePool<MockSurface> pool(maxSize, UINT32_MAX);
+    std::vector<MockSurface *> evicted;
+    MockSurface                surfaces[8];
+
+    for (uint32_t i = 0; i < 8; i++)
+    {
+        surfaces[i].key = PoolKey(1920, 1080 + i);
+        pool.Release(surfaces[i].key, &surfaces[i], PoolSize(PoolKey(1920, 1080)), evicted);
+        EXPECT_LE(pool.GetSize(), maxSize);
+    }
+    EXPECT_EQ(2u, pool.GetCount());
+    EXPECT_EQ(6u, evicted.size());
+
+    // Surface larger than the limit is evicted right away
+    MockSurface huge = {PoolKey(7680, 4320)};
+    pool.Release(huge.key, &huge, maxSize + 1, evicted);
+    EXPECT_EQ(0u, pool.GetCount());
+    EXPECT_EQ(0u, pool.GetSize());
+    EXPECT_EQ(&huge, evicted.back());
+
+    std::vector<MockSurface *> surfacesLeft;
+    pool.Clear(surfacesLeft);
+    EXPECT_TRUE(surfacesLeft.empty());
+}
@@ -29,6 +29,12 @@ option (MEDIA_RUN_TEST_SUITE "run google test module after install" ON)
 include(${MEDIA_DRIVER_CMAKE}/media_gen_flags.cmake)
 include(${MEDIA_DRIVER_CMAKE}/media_feature_flags.cmake)
 
+# devult is only built for release-internal, the test hooks it calls in the
+# driver are left out of every other build
+if(MEDIA_RUN_TEST_SUITE AND ENABLE_KERNELS AND ENABLE_NONFREE_KERNELS AND "${CMAKE_BUILD_TYPE}" STREQUAL "ReleaseInternal")
+    set(MEDIA_BUILD_ULT ON)
+    add_definitions(-D_MEDIA_ULT_SUPPORTED)
+endif()
 
 if(NOT DEFINED SKIP_GMM_CHECK)
     # checking dependencies
@@ -283,7 +289,7 @@ endif(NOT DEFINED INCLUDED_LIBS OR "${INCLUDED_LIBS}" STREQUAL "")
 # post target attributes
 bs_set_post_target()
 
-if(MEDIA_RUN_TEST_SUITE AND ENABLE_KERNELS AND ENABLE_NONFREE_KERNELS AND "${CMAKE_BUILD_TYPE}" STREQUAL "ReleaseInternal")
+if(MEDIA_BUILD_ULT)
     add_subdirectory(${CMAKE_CURRENT_LIST_DIR}/linux/ult)
     include(${MEDIA_EXT}/media_softlet/ult/ult_top_cmake.cmake OPTIONAL)
 endif()
@@ -799,10 +799,9 @@ MHW_SETPAR_DECL_SRC(VDENC_CMD1, Av1BasicFeature)
     auto setting = static_cast<Av1VdencFeatureSettings*>(m_constSettings);
     ENCODE_CHK_NULL_RETURN(setting);
 
-    for (const auto &lambda : setting->vdencCmd1Settings)
-    {
-        ENCODE_CHK_STATUS_RETURN(lambda(params, m_ref.IsLowDelay()));
-    }
+    bool     isLowDelay = m_ref.IsLowDelay();
+    uint64_t signature  = EncodeAv1VdencConstSettings::GetVdencCmd1Signature(m_av1PicParams, isLowDelay);
+    ENCODE_CHK_STATUS_RETURN(m_vdencCmd1Memo.Evaluate(signature, params, setting->vdencCmd1Settings, isLowDelay));
 
     return MOS_STATUS_SUCCESS;
 }
@@ -35,6 +35,7 @@
 #include "mhw_vdbox_avp_itf.h"
 #include "mhw_vdbox_huc_itf.h"
 #include "encode_mem_compression.h"
+#include "encode_const_settings.h"
 
 namespace encode
 {
@@ -217,6 +218,8 @@ protected:
     uint32_t m_appHdrSize                = 0;
     uint32_t m_appHdrSizeExcludeFrameHdr = 0;
 
+    mutable ConstSettingsMemo<mhw::vdbox::vdenc::_MHW_PAR_T(VDENC_CMD1)> m_vdencCmd1Memo;  //!< VDENC_CMD1 const settings evaluated per signature
+
 MEDIA_CLASS_DEFINE_END(encode__Av1BasicFeature)
 };
 
@@ -678,4 +678,11 @@ MOS_STATUS EncodeAv1VdencConstSettings::SetVdencCmd1Settings()
     return MOS_STATUS_SUCCESS;
 }
 
+uint64_t EncodeAv1VdencConstSettings::GetVdencCmd1Signature(const CODEC_AV1_ENCODE_PICTURE_PARAMS *av1PicParams, bool isLowDelay)
+{
+    return (uint64_t)isLowDelay |
+           ((uint64_t)av1PicParams->PicFlags.fields.frame_type << 8) |
+           ((uint64_t)av1PicParams->base_qindex << 16);
+}
+
 }  // namespace encode
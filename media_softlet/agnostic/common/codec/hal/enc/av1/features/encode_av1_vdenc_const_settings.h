@@ -207,6 +207,13 @@ public:
 
     virtual MOS_STATUS SetVdencCmd2Settings() override { return MOS_STATUS_SUCCESS; }
 
+    //!
+    //! \brief  Pack everything the VDENC_CMD1 lambdas read besides the incoming parameters
+    //! \return uint64_t
+    //!         Signature for ConstSettingsMemo, the lambdas give the same result for the same signature
+    //!
+    static uint64_t GetVdencCmd1Signature(const CODEC_AV1_ENCODE_PICTURE_PARAMS *av1PicParams, bool isLowDelay);
+
 protected:
 
     //!
@@ -106,6 +106,7 @@ MOS_STATUS HevcBasicFeature::Init(void *setting)
         MediaUserSetting::Group::Sequence);
 #endif  // _DEBUG || _RELEASE_INTERNAL
     m_hevcRDOQPerfDisabled = outValue.Get<bool>();
+    m_roundingEnableHandle = GetUserSettingHandle(m_userSettingPtr, "HEVC VDEnc Rounding Enable", MediaUserSetting::Group::Sequence);
 
 #ifdef _ENCODE_RESERVED
     ENCODE_CHK_STATUS_RETURN(InitRsvdState());
@@ -157,8 +158,7 @@ MOS_STATUS HevcBasicFeature::Update(void *params)
     ReadUserSetting(
         m_userSettingPtr,
         outValue,
-        "HEVC VDEnc Rounding Enable",
-        MediaUserSetting::Group::Sequence);
+        m_roundingEnableHandle);
     m_hevcVdencRoundingPrecisionEnabled = outValue.Get<bool>();
     ReportUserSettingForDebug(
         m_userSettingPtr,
@@ -867,10 +867,10 @@ MHW_SETPAR_DECL_SRC(VDENC_CMD1, HevcBasicFeature)
     auto settings = static_cast<HevcVdencFeatureSettings *>(m_constSettings);
     ENCODE_CHK_NULL_RETURN(settings);
 
-    for (const auto &lambda : settings->vdencCmd1Settings)
-    {
-        ENCODE_CHK_STATUS_RETURN(lambda(params, m_ref.IsLowDelay()));
-    }
+    bool     isLowDelay = m_ref.IsLowDelay();
+    uint64_t signature  = EncodeHevcVdencConstSettings::GetVdencCmd1Signature(
+        m_hevcSeqParams, m_hevcPicParams, m_hevcSliceParams, isLowDelay);
+    ENCODE_CHK_STATUS_RETURN(m_vdencCmd1Memo.Evaluate(signature, params, settings->vdencCmd1Settings, isLowDelay));
 
     return MOS_STATUS_SUCCESS;
 }
@@ -35,6 +35,7 @@
 #include "mhw_vdbox_vdenc_itf.h"
 #include "mhw_vdbox_hcp_itf.h"
 #include "encode_mem_compression.h"
+#include "encode_const_settings.h"
 
 #ifdef _ENCODE_RESERVED
 #include "encode_hevc_basic_feature_rsvd.h"
@@ -147,6 +148,9 @@ public:
     std::deque<uint32_t> m_recycleBufferIdxes;
 
 protected:
+    mutable ConstSettingsMemo<mhw::vdbox::vdenc::_MHW_PAR_T(VDENC_CMD1)> m_vdencCmd1Memo;  //!< VDENC_CMD1 const settings evaluated per signature
+    MediaUserSetting::Handle m_roundingEnableHandle = MediaUserSetting::InvalidHandle;  //!< "HEVC VDEnc Rounding Enable", read per frame
+
     MOS_STATUS SetPictureStructs();
     virtual MOS_STATUS UpdateTrackedBufferParameters() override;
     MOS_STATUS GetMaxMBPS(uint32_t levelIdc, uint32_t* maxMBPS, uint64_t* maxBytePerPic);
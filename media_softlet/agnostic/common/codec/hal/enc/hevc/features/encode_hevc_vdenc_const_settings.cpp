@@ -1190,6 +1190,25 @@ MOS_STATUS EncodeHevcVdencConstSettings::SetVdencCmd1Settings()
     return MOS_STATUS_SUCCESS;
 }
 
+uint64_t EncodeHevcVdencConstSettings::GetVdencCmd1Signature(
+    const CODEC_HEVC_ENCODE_SEQUENCE_PARAMS *hevcSeqParams,
+    const CODEC_HEVC_ENCODE_PICTURE_PARAMS  *hevcPicParams,
+    const CODEC_HEVC_ENCODE_SLICE_PARAMS    *hevcSliceParams,
+    bool                                     isLowDelay)
+{
+    // Covers the lambdas above and the ones platforms add in their SetVdencCmd1Settings()
+    uint8_t sliceQp = hevcPicParams->QpY + hevcSliceParams->slice_qp_delta;
+
+    return (uint64_t)isLowDelay |
+           ((uint64_t)hevcSeqParams->LowDelayMode << 1) |
+           ((uint64_t)(hevcPicParams->NumROI != 0) << 2) |
+           ((uint64_t)hevcPicParams->CodingType << 8) |
+           ((uint64_t)hevcPicParams->HierarchLevelPlus1 << 16) |
+           ((uint64_t)hevcSeqParams->TargetUsage << 24) |
+           ((uint64_t)hevcSeqParams->GopRefDist << 32) |
+           ((uint64_t)sliceQp << 40);
+}
+
 MOS_STATUS EncodeHevcVdencConstSettings::SetBrcSettings()
 {
     ENCODE_FUNC_CALL();
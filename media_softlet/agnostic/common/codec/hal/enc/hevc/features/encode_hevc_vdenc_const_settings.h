@@ -259,6 +259,17 @@ public:
 
     MOS_STATUS Update(void *params) override;
 
+    //!
+    //! \brief  Pack everything the VDENC_CMD1 lambdas read besides the incoming parameters
+    //! \return uint64_t
+    //!         Signature for ConstSettingsMemo, the lambdas give the same result for the same signature
+    //!
+    static uint64_t GetVdencCmd1Signature(
+        const CODEC_HEVC_ENCODE_SEQUENCE_PARAMS *hevcSeqParams,
+        const CODEC_HEVC_ENCODE_PICTURE_PARAMS  *hevcPicParams,
+        const CODEC_HEVC_ENCODE_SLICE_PARAMS    *hevcSliceParams,
+        bool                                     isLowDelay);
+
 protected:
     MOS_STATUS SetTUSettings() override;
 
@@ -49,20 +49,10 @@ HevcVdencRoi::HevcVdencRoi(
     m_basicFeature = dynamic_cast<EncodeBasicFeature *>(m_featureManager->GetFeature(FeatureIDs::basicFeature));
     ENCODE_CHK_NULL_NO_STATUS_RETURN(m_basicFeature);
 }
-MOS_STATUS HevcVdencRoi::ClearStreaminBuffer(uint32_t lucNumber)
+HevcVdencRoi::~HevcVdencRoi()
 {
-    // Clear streamin
-    ENCODE_CHK_NULL_RETURN(m_streamInTemp);
-
-    uint8_t *data = (uint8_t *)m_allocator->LockResourceForWrite(m_streamIn);
-    ENCODE_CHK_NULL_RETURN(data);
-
-    MOS_ZeroMemory(m_streamInTemp, lucNumber * 64);
-    MOS_SecureMemcpy(data, m_streamInSize, m_streamInTemp, m_streamInSize);
-
-    ENCODE_CHK_STATUS_RETURN(m_allocator->UnLock(m_streamIn));
-
-    return MOS_STATUS_SUCCESS;
+    MOS_SafeFreeMemory(m_streamInTemp);
+    m_streamInTemp = nullptr;
 }
 
 MOS_STATUS HevcVdencRoi::Init(void *setting)
@@ -158,13 +148,8 @@ MOS_STATUS HevcVdencRoi::Update(void *params)
 
     if (!m_isArbRoi || (hevcPicParams->CodingType == I_TYPE && !IFrameIsSet) || ((hevcPicParams->CodingType == P_TYPE || hevcPicParams->CodingType == B_TYPE) && !PBFrameIsSet))
     {
-        m_streamInTemp = (uint8_t *)MOS_AllocMemory(m_streamInSize);
-        ENCODE_CHK_NULL_RETURN(m_streamInTemp);
-
         uint32_t lcuNumber = GetLCUNumber();
 
-        ENCODE_CHK_STATUS_RETURN(ClearStreaminBuffer(lcuNumber));
-
         m_roiOverlap.Update(lcuNumber);
 
         ENCODE_CHK_STATUS_RETURN(ExecuteDirtyRoi(hevcSeqParams, hevcPicParams, hevcSlcParams));
@@ -185,8 +170,6 @@ MOS_STATUS HevcVdencRoi::Update(void *params)
 
         ENCODE_CHK_STATUS_RETURN(WriteStreaminData());
 
-        MOS_SafeFreeMemory(m_streamInTemp);
-
 #if (_DEBUG || _RELEASE_INTERNAL)
         ENCODE_CHK_NULL_RETURN(m_hwInterface);
         ENCODE_CHK_NULL_RETURN(m_hwInterface->GetOsInterface());
@@ -213,20 +196,47 @@ MOS_STATUS HevcVdencRoi::Update(void *params)
 MOS_STATUS HevcVdencRoi::WriteStreaminData()
 {
     ENCODE_CHK_NULL_RETURN(m_streamIn);
-    ENCODE_CHK_NULL_RETURN(m_streamInTemp);
+
+    // The factory keeps the strategies of earlier frames, only pass the active ones
+    RoiStrategy *roi      = m_roiEnabled ? m_strategyFactory.GetRoi() : nullptr;
+    RoiStrategy *dirtyRoi = m_dirtyRoiEnabled ? m_strategyFactory.GetDirtyRoi() : nullptr;
+
+    // The write history follows the allocation, not the MOS_RESOURCE holding it
+    ENCODE_CHK_NULL_RETURN(m_osInterface);
+    uint64_t streamInId = m_osInterface->pfnGetResourceGfxAddress(m_osInterface, m_streamIn);
+
+    bool incremental = streamInId != 0 &&
+                       !((roi != nullptr && roi->IsLcuPositionDependent()) ||
+                         (dirtyRoi != nullptr && dirtyRoi->IsLcuPositionDependent()));
+
+    if (!incremental && m_streamInTemp == nullptr)
+    {
+        m_streamInTemp = (uint8_t *)MOS_AllocMemory(m_streamInSize);
+        ENCODE_CHK_NULL_RETURN(m_streamInTemp);
+    }
 
     uint8_t *streaminBuffer = (uint8_t *)m_allocator->LockResourceForWrite(m_streamIn);
     ENCODE_CHK_NULL_RETURN(streaminBuffer);
 
-    m_roiOverlap.WriteStreaminData(
-        m_strategyFactory.GetRoi(), 
-        m_strategyFactory.GetDirtyRoi(),
-        m_streamInTemp);
+    MOS_STATUS status = MOS_STATUS_SUCCESS;
 
-    MOS_SecureMemcpy(streaminBuffer, m_streamInSize, m_streamInTemp, m_streamInSize);
+    if (incremental)
+    {
+        // Only rewrite the LCUs changed since the last frame using this recycled buffer
+        status = m_roiOverlap.WriteStreaminDataIncremental(roi, dirtyRoi, streamInId, streaminBuffer);
+    }
+    else
+    {
+        // LCU position dependent data, e.g. ARB and QP map, or no allocation
+        // identity, rebuild the whole buffer
+        MOS_ZeroMemory(m_streamInTemp, m_streamInSize);
+        status = m_roiOverlap.WriteStreaminData(roi, dirtyRoi, m_streamInTemp);
+        MOS_SecureMemcpy(streaminBuffer, m_streamInSize, m_streamInTemp, m_streamInSize);
+        m_roiOverlap.ResetStreaminHistory(streamInId);
+    }
 
     m_allocator->UnLock(m_streamIn);
-    return MOS_STATUS_SUCCESS;
+    return status;
 }
 
 MOS_STATUS HevcVdencRoi::ExecuteRoi(
@@ -60,7 +60,7 @@ public:
         CodechalHwInterface *hwInterface,
         void *constSettings);
 
-    virtual ~HevcVdencRoi() {}
+    virtual ~HevcVdencRoi();
 
     //!
     //! \brief  Init encode parameter
@@ -204,13 +204,6 @@ protected:
         return (streamInWidth * streamInHeight);
     }
 
-    //!
-    //! \brief    ClearStreaminBuffer
-    //! \return   MOS_STATUS
-    //!           MOS_STATUS_SUCCESS if success, else fail reason
-    //!
-    MOS_STATUS ClearStreaminBuffer(uint32_t lucNumber);
-
     //!
     //! \brief    Get strategy for setting command parameters
     //!
@@ -244,7 +237,7 @@ protected:
     bool m_isArbRoiSupported = true;     //!< Whether is Adaptive Region Boost ROI Supported
 
     PMOS_RESOURCE      m_streamIn = nullptr; //!< Stream in buffer
-    uint8_t *          m_streamInTemp = nullptr;
+    uint8_t *          m_streamInTemp = nullptr; //!< Staging buffer of the LCU position dependent strategies
     uint32_t           m_streamInSize = 0;
     RoiStrategyFactory m_strategyFactory;    //!< Factory of strategy
     RoiOverlap         m_roiOverlap;         //!< ROI and dirty ROI overlap
@@ -44,6 +44,8 @@ public:
         PicParams *hevcPicParams,
         SlcParams *hevcSlcParams) override;
 
+    bool IsLcuPositionDependent() const override { return true; }
+
 protected:
     void SetRoiCtrlMode(
         uint32_t        lcuIndex,
@@ -24,7 +24,7 @@
 //! \brief    Implemetation of the ROI overlap
 //!
 
-#include "encode_hevc_vdenc_roi_strategy.h"
+#include "encode_utils.h"
 #include "encode_hevc_vdenc_roi_overlap.h"
 
 namespace encode
@@ -103,8 +103,8 @@ void RoiOverlap::MarkLcu(uint32_t lcu, OverlapMarker marker)
 }
 
 MOS_STATUS RoiOverlap::WriteStreaminData(
-    RoiStrategy *roi,
-    RoiStrategy *dirtyRoi,
+    RoiStreaminWriter *roi,
+    RoiStreaminWriter *dirtyRoi,
     uint8_t *streaminBuffer)
 {
     ENCODE_CHK_NULL_RETURN(streaminBuffer);
@@ -133,4 +133,141 @@ MOS_STATUS RoiOverlap::WriteStreaminData(
     return MOS_STATUS_SUCCESS;
 }
 
+int32_t RoiOverlap::GetRecordSlot(uint16_t data)
+{
+    uint32_t roiRegionIndex = GetRoiRegionIndex(data);
+
+    if (roiRegionIndex == m_maskRoiRegionIndex)
+    {
+        roiRegionIndex = m_recordRegionNumber - 1;
+    }
+    else if (roiRegionIndex >= m_recordRegionNumber - 1)
+    {
+        return -1;
+    }
+
+    return GetMarker(data) * m_recordRegionNumber + roiRegionIndex;
+}
+
+MOS_STATUS RoiOverlap::BuildRecord(
+    RoiStreaminWriter *roi,
+    RoiStreaminWriter *dirtyRoi,
+    uint16_t data,
+    uint8_t *record)
+{
+    OverlapMarker      marker   = GetMarker(data);
+    RoiStreaminWriter *strategy = IsRoiMarker(marker) ? roi : dirtyRoi;
+    ENCODE_CHK_NULL_RETURN(strategy);
+
+    // Position independent strategies write the same record for any LCU,
+    // so build it as LCU 0 of a zeroed single record buffer.
+    MOS_ZeroMemory(record, m_streaminRecordSize);
+
+    return strategy->WriteStreaminData(
+        0, marker, GetRoiRegionIndex(data), record);
+}
+
+MOS_STATUS RoiOverlap::WriteStreaminDataIncremental(
+    RoiStreaminWriter *roi,
+    RoiStreaminWriter *dirtyRoi,
+    uint64_t allocationId,
+    uint8_t *streaminBuffer)
+{
+    ENCODE_CHK_NULL_RETURN(streaminBuffer);
+    ENCODE_CHK_NULL_RETURN(m_overlapMap);
+
+    if ((roi != nullptr && roi->IsLcuPositionDependent()) ||
+        (dirtyRoi != nullptr && dirtyRoi->IsLcuPositionDependent()))
+    {
+        return MOS_STATUS_INVALID_PARAMETER;
+    }
+
+    StreaminHistory &history = m_streaminHistory[allocationId];
+
+    // Unknown buffer or new resolution, every LCU must be written
+    if (history.overlapMap.size() != m_lcuNumber)
+    {
+        history.overlapMap.assign(m_lcuNumber, (uint16_t)m_unknownData);
+        history.records.assign(m_recordSlotNumber * m_streaminRecordSize, 0);
+        history.recordValid.assign(m_recordSlotNumber, false);
+    }
+
+    //! State of each record slot in this frame
+    enum
+    {
+        slotNotBuilt = 0,
+        slotChanged,
+        slotUnchanged
+    };
+
+    uint8_t slotState[m_recordSlotNumber] = {};
+    uint8_t record[m_streaminRecordSize];
+
+    for (uint32_t i = 0; i < m_lcuNumber; i++)
+    {
+        uint16_t data   = m_overlapMap[i];
+        uint8_t *lcuDst = streaminBuffer + i * m_streaminRecordSize;
+
+        // LCUs without ROI or dirty ROI marker stay zero
+        if (!IsRoiMarker(GetMarker(data)) && !IsDirtyRoiMarker(GetMarker(data)))
+        {
+            if (history.overlapMap[i] != 0)
+            {
+                MOS_ZeroMemory(lcuDst, m_streaminRecordSize);
+                history.overlapMap[i] = 0;
+            }
+            continue;
+        }
+
+        int32_t slot = GetRecordSlot(data);
+
+        if (slot < 0)
+        {
+            MOS_STATUS status = BuildRecord(roi, dirtyRoi, data, record);
+            if (status != MOS_STATUS_SUCCESS)
+            {
+                m_streaminHistory.erase(allocationId);
+                return status;
+            }
+            MOS_SecureMemcpy(lcuDst, m_streaminRecordSize, record, m_streaminRecordSize);
+            history.overlapMap[i] = m_unknownData;
+            continue;
+        }
+
+        uint8_t *slotRecord = history.records.data() + slot * m_streaminRecordSize;
+
+        if (slotState[slot] == slotNotBuilt)
+        {
+            MOS_STATUS status = BuildRecord(roi, dirtyRoi, data, record);
+            if (status != MOS_STATUS_SUCCESS)
+            {
+                m_streaminHistory.erase(allocationId);
+                return status;
+            }
+
+            if (history.recordValid[slot] &&
+                memcmp(slotRecord, record, m_streaminRecordSize) == 0)
+            {
+                slotState[slot] = slotUnchanged;
+            }
+            else
+            {
+                MOS_SecureMemcpy(slotRecord, m_streaminRecordSize, record, m_streaminRecordSize);
+                history.recordValid[slot] = true;
+                slotState[slot]           = slotChanged;
+            }
+        }
+
+        if (history.overlapMap[i] == data && slotState[slot] == slotUnchanged)
+        {
+            continue;
+        }
+
+        MOS_SecureMemcpy(lcuDst, m_streaminRecordSize, slotRecord, m_streaminRecordSize);
+        history.overlapMap[i] = data;
+    }
+
+    return MOS_STATUS_SUCCESS;
+}
+
 }  // namespace encode
\ No newline at end of file
@@ -28,12 +28,15 @@
 #ifndef __CODECHAL_HEVC_VDENC_ROI_OVERLAP_H__
 #define __CODECHAL_HEVC_VDENC_ROI_OVERLAP_H__
 
+#include <map>
+#include <vector>
+
 namespace encode
 {
 
 using UintVector = std::vector<uint32_t>;
 
-class RoiStrategy;
+class RoiStreaminWriter;
 
 //!
 //! \class    RoiOverlap
@@ -86,7 +89,7 @@ public:
     //! \return void
     //!
     void MarkLcus(
-        const UintVector lcus, 
+        const UintVector &lcus,
         OverlapMarker marker, 
         int32_t roiRegionIndex = m_maskRoiRegionIndex)
     {
@@ -120,11 +123,96 @@ public:
     //!         MOS_STATUS_SUCCESS if success, else fail reason
     //!
     MOS_STATUS WriteStreaminData(
-        RoiStrategy *roi,
-        RoiStrategy *dirtyRoi,
+        RoiStreaminWriter *roi,
+        RoiStreaminWriter *dirtyRoi,
+        uint8_t *streaminBuffer);
+
+    //!
+    //! \brief  Write streamin data incrementally according to the overlap map
+    //!
+    //! \detail Only valid when no strategy is LCU position dependent. The
+    //!         record of an LCU then only depends on its overlap map data, so
+    //!         each distinct data is built once per frame, and LCUs whose data
+    //!         and record did not change since the last write into the same
+    //!         buffer are skipped. The result equals WriteStreaminData into a
+    //!         zeroed buffer.
+    //!
+    //! \param  [in] roi
+    //!         ROI strategy
+    //! \param  [in] dirtyRoi
+    //!         Dirty ROI strategy
+    //! \param  [in] allocationId
+    //!         Identity of the streamin buffer allocation, e.g. its graphics
+    //!         address. Each recycled buffer keeps its own write history, a
+    //!         reallocated buffer gets a new identity and is written in full.
+    //! \param  [in, out] streaminBuffer
+    //!         locked streamin buffer, holding the last write with allocationId
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS WriteStreaminDataIncremental(
+        RoiStreaminWriter *roi,
+        RoiStreaminWriter *dirtyRoi,
+        uint64_t allocationId,
         uint8_t *streaminBuffer);
 
+    //!
+    //! \brief  Drop the write history of a streamin buffer
+    //!
+    //! \detail Must be called whenever the buffer is written without
+    //!         WriteStreaminDataIncremental.
+    //!
+    //! \param  [in] allocationId
+    //!         Identity of the streamin buffer allocation
+    //! \return void
+    //!
+    void ResetStreaminHistory(uint64_t allocationId)
+    {
+        m_streaminHistory.erase(allocationId);
+    }
+
 private:
+    //!
+    //! \struct StreaminHistory
+    //! \brief  Overlap map and records of the last incremental write into a buffer
+    //!
+    struct StreaminHistory
+    {
+        std::vector<uint16_t> overlapMap;   //<! Overlap map data written to each LCU
+        std::vector<uint8_t>  records;      //<! Record of each slot
+        std::vector<bool>     recordValid;  //<! Whether the record of each slot was built
+    };
+
+    //!
+    //! \brief  Get the record slot of overlap map data
+    //!
+    //! \param  [in] data
+    //!         overlap map data with a ROI or dirty ROI marker
+    //! \return int32_t
+    //!         record slot, -1 if the ROI region index has no slot
+    //!
+    int32_t GetRecordSlot(uint16_t data);
+
+    //!
+    //! \brief  Build the streamin record of overlap map data
+    //!
+    //! \param  [in] roi
+    //!         ROI strategy
+    //! \param  [in] dirtyRoi
+    //!         Dirty ROI strategy
+    //! \param  [in] data
+    //!         overlap map data with a ROI or dirty ROI marker
+    //! \param  [out] record
+    //!         streamin record of one LCU
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS BuildRecord(
+        RoiStreaminWriter *roi,
+        RoiStreaminWriter *dirtyRoi,
+        uint16_t data,
+        uint8_t *record);
+
     //!
     //! \brief  mark the specific LCU with provided marker and region index
     //!
@@ -199,8 +287,15 @@ private:
     static const uint16_t m_maskOverlapMarker  = 0x1F;  //<! Mask for overlap marker in overlap map
     static const uint8_t  m_bitNumberOfOverlapMarker  = 5;   //<! Bit number of overlap marker in overlap map
 
+    static const uint32_t m_streaminRecordSize = 64;           //<! Streamin data size of one LCU
+    static const uint32_t m_recordRegionNumber = 17;           //<! ROI region 0 to 15, plus the region index mask
+    static const uint32_t m_recordSlotNumber   = (mkDirtyRoiBkNone64Align + 1) * m_recordRegionNumber;
+    static const uint16_t m_unknownData        = 0xFFFF;       //<! History of an LCU with unknown content
+
     uint32_t   m_lcuNumber  = 0;       //<! Number of LCU
 
+    std::map<uint64_t, StreaminHistory> m_streaminHistory;  //<! Write history of each streamin buffer allocation
+
 protected:
     //! This map is a array of LCU description. The description is a unsigned 
     //! 16 bit integer data, In each description includes overlap marker and
@@ -231,5 +326,52 @@ protected:
 MEDIA_CLASS_DEFINE_END(encode__RoiOverlap)
 };
 
+//!
+//! \class    RoiStreaminWriter
+//!
+//! \brief    Writes the streamin data of the LCUs marked in RoiOverlap.
+//!
+//! \detail   RoiStrategy implements it, RoiOverlap needs nothing else from
+//!           the strategies.
+//!
+class RoiStreaminWriter
+{
+public:
+    virtual ~RoiStreaminWriter() {}
+
+    //!
+    //! \brief    Write the Streamin data according to marker.
+    //! \param    [in] lcuIndex
+    //!           Index of LCU
+    //! \param    [in] marker
+    //!           overlap marker
+    //! \param    [in] roiRegionIndex
+    //!           Index of ROI region
+    //! \param    [out] streamInBuffer
+    //!           Streamin buffer
+    //! \return   MOS_STATUS
+    //!           MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    virtual MOS_STATUS WriteStreaminData(uint32_t lcuIndex,
+        RoiOverlap::OverlapMarker marker,
+        uint32_t roiRegionIndex,
+        uint8_t *streamInBuffer) = 0;
+
+    //!
+    //! \brief    Whether the streamin data of an LCU depends on its position
+    //!
+    //! \detail   When false, WriteStreaminData writes the same record for the
+    //!           same marker and ROI region wherever the LCU is, and touches no
+    //!           other LCU. RoiOverlap relies on it to write streamin data
+    //!           incrementally.
+    //!
+    //! \return   bool
+    //!           true if the streamin data depends on the LCU position
+    //!
+    virtual bool IsLcuPositionDependent() const = 0;
+
+MEDIA_CLASS_DEFINE_END(encode__RoiStreaminWriter)
+};
+
 }  // namespace encode
 #endif  //<! __CODECHAL_HEVC_VDENC_ROI_OVERLAP_H__
\ No newline at end of file
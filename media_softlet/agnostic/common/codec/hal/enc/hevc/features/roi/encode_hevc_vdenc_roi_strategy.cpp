@@ -74,26 +74,7 @@ void RoiStrategy::StreaminZigZagToLinearMap(
     uint32_t *offset,
     uint32_t *xyOffset)
 {
-    ENCODE_FUNC_CALL();
-
-    *offset          = streamInWidth * y;
-    uint32_t yOffset = 0;
-    uint32_t xOffset = 2 * x;
-
-    //Calculate X Y Offset for the zig zag scan with in each 64x64 LCU
-    //dwOffset gives the 64 LCU row
-    if (y % 2)
-    {
-        *offset = streamInWidth * (y - 1);
-        yOffset = 2;
-    }
-
-    if (x % 2)
-    {
-        xOffset = (2 * x) - 1;
-    }
-
-    *xyOffset = xOffset + yOffset;
+    RoiZigZagLut::ZigZagToLinear(streamInWidth, x, y, offset, xyOffset);
 }
 
 void RoiStrategy::ZigZagToRaster(
@@ -347,17 +328,7 @@ void RoiStrategy::GetLCUsInRoiRegion(
         return;
     }
 
-    for (auto y = top; y < bottom; y++)
-    {
-        for (auto x = left; x < right; x++)
-        {
-            //Calculate X Y for the zig zag scan
-            uint32_t offset = 0, xyOffset = 0;
-            StreaminZigZagToLinearMap(streamInWidth, x, y, &offset, &xyOffset);
-
-            lcuVector.push_back(offset + xyOffset);
-        }
-    }
+    m_zigzagLut.GetLcus(streamInWidth, top, bottom, left, right, lcuVector);
 }
 
 /*******************************************************
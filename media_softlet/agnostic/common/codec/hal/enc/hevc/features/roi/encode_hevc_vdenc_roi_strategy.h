@@ -31,6 +31,7 @@
 #include "encode_hevc_basic_feature.h"
 #include "encode_hevc_brc.h"
 #include "encode_hevc_vdenc_roi_overlap.h"
+#include "encode_hevc_vdenc_roi_zigzag.h"
 #include "encode_hevc_vdenc_const_settings.h"
 #include "mhw_vdbox_huc_itf.h"
 
@@ -209,7 +210,7 @@ using UintVector     = std::vector<uint32_t>;
 //! \detail   This class provided unified interface of all ROI, and implemented
 //!           some common functions which will be used by the sub classes.
 //!
-class RoiStrategy : public mhw::vdbox::huc::Itf::ParSetting
+class RoiStrategy : public mhw::vdbox::huc::Itf::ParSetting, public RoiStreaminWriter
 {
 public:
     RoiStrategy(EncodeAllocator *allocator,
@@ -316,6 +317,14 @@ public:
 
     void SetFeatureSetting(HevcVdencFeatureSettings *settings) { m_FeatureSettings = settings; }
 
+    //!
+    //! \brief    Whether the streamin data of an LCU depends on its position
+    //!
+    //! \return   bool
+    //!           true if the streamin data depends on the LCU position
+    //!
+    bool IsLcuPositionDependent() const override { return false; }
+
 protected:
     //!
     //! \brief    Calculate X/Y offsets for zigzag scan within 64 LCU
@@ -513,6 +522,8 @@ protected:
     HevcVdencFeatureSettings *m_FeatureSettings = nullptr;
     PMOS_INTERFACE m_osInterface = nullptr;
 
+    RoiZigZagLut m_zigzagLut;             //!< LCU index of each 32x32 CU in raster order
+
 MEDIA_CLASS_DEFINE_END(encode__RoiStrategy)
 };
 
@@ -0,0 +1,134 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     encode_hevc_vdenc_roi_zigzag.cpp
+//! \brief    Implementation of the streamin zigzag scan LUT
+//!
+
+#include "encode_utils.h"
+#include "encode_hevc_vdenc_roi_zigzag.h"
+
+namespace encode
+{
+void RoiZigZagLut::ZigZagToLinear(
+    uint32_t  streamInWidth,
+    uint32_t  x,
+    uint32_t  y,
+    uint32_t *offset,
+    uint32_t *xyOffset)
+{
+    ENCODE_FUNC_CALL();
+
+    *offset          = streamInWidth * y;
+    uint32_t yOffset = 0;
+    uint32_t xOffset = 2 * x;
+
+    //Calculate X Y Offset for the zig zag scan with in each 64x64 LCU
+    //dwOffset gives the 64 LCU row
+    if (y % 2)
+    {
+        *offset = streamInWidth * (y - 1);
+        yOffset = 2;
+    }
+
+    if (x % 2)
+    {
+        xOffset = (2 * x) - 1;
+    }
+
+    *xyOffset = xOffset + yOffset;
+}
+
+void RoiZigZagLut::GetLcus(
+    uint32_t    streamInWidth,
+    uint32_t    top,
+    uint32_t    bottom,
+    uint32_t    left,
+    uint32_t    right,
+    UintVector &lcuVector)
+{
+    if (top >= bottom || left >= right)
+    {
+        return;
+    }
+
+    // Regions running over the right border have no LUT entry
+    if (right > streamInWidth)
+    {
+        for (auto y = top; y < bottom; y++)
+        {
+            for (auto x = left; x < right; x++)
+            {
+                //Calculate X Y for the zig zag scan
+                uint32_t offset = 0, xyOffset = 0;
+                ZigZagToLinear(streamInWidth, x, y, &offset, &xyOffset);
+
+                lcuVector.push_back(offset + xyOffset);
+            }
+        }
+        return;
+    }
+
+    Update(streamInWidth, bottom);
+
+    lcuVector.reserve(lcuVector.size() + (bottom - top) * (right - left));
+    for (auto y = top; y < bottom; y++)
+    {
+        const uint32_t *row = m_lut.data() + y * streamInWidth;
+        lcuVector.insert(lcuVector.end(), row + left, row + right);
+    }
+}
+
+void RoiZigZagLut::Update(
+    uint32_t streamInWidth,
+    uint32_t streamInHeight)
+{
+    if (streamInWidth == m_lutWidth && streamInHeight <= m_lutHeight)
+    {
+        return;
+    }
+
+    // Keep the rows already covered when only the height grows
+    if (streamInWidth == m_lutWidth)
+    {
+        streamInHeight = MOS_MAX(streamInHeight, m_lutHeight);
+    }
+
+    m_lut.resize(streamInWidth * streamInHeight);
+
+    for (uint32_t y = 0; y < streamInHeight; y++)
+    {
+        for (uint32_t x = 0; x < streamInWidth; x++)
+        {
+            //Calculate X Y for the zig zag scan
+            uint32_t offset = 0, xyOffset = 0;
+            ZigZagToLinear(streamInWidth, x, y, &offset, &xyOffset);
+
+            m_lut[y * streamInWidth + x] = offset + xyOffset;
+        }
+    }
+
+    m_lutWidth  = streamInWidth;
+    m_lutHeight = streamInHeight;
+}
+
+}  // namespace encode
@@ -0,0 +1,123 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     encode_hevc_vdenc_roi_zigzag.h
+//! \brief    Defines of the streamin zigzag scan LUT
+//!
+
+#ifndef __CODECHAL_HEVC_VDENC_ROI_ZIGZAG_H__
+#define __CODECHAL_HEVC_VDENC_ROI_ZIGZAG_H__
+
+#include <vector>
+#include "media_class_trace.h"
+
+namespace encode
+{
+
+using UintVector = std::vector<uint32_t>;
+
+//!
+//! \class    RoiZigZagLut
+//!
+//! \brief    Maps 32x32 CU positions to their index in the streamin buffer.
+//!
+//! \detail   The streamin buffer holds the four 32x32 CUs of each 64x64 LCU
+//!           in zigzag order. The index of each CU is kept in a raster order
+//!           LUT, rebuilt only when the streamin width changes or more rows
+//!           are needed.
+//!
+class RoiZigZagLut
+{
+public:
+    //!
+    //! \brief    Calculate X/Y offsets for zigzag scan within 64 LCU
+    //!
+    //! \param    [in] streamInWidth
+    //!           StreamInWidth, location of top left corner
+    //! \param    [in] x
+    //!           Position X
+    //! \param    [in] y
+    //!           Position Y
+    //! \param    [out] offset
+    //!           Offsets into the stream-in surface
+    //! \param    [out] xyOffset
+    //!           XY Offsets into the stream-in surface
+    //!
+    //! \return   void
+    //!
+    static void ZigZagToLinear(
+        uint32_t  streamInWidth,
+        uint32_t  x,
+        uint32_t  y,
+        uint32_t *offset,
+        uint32_t *xyOffset);
+
+    //!
+    //! \brief    Append the index of the CUs in a region, row by row
+    //!
+    //! \param    [in] streamInWidth
+    //!           StreamInWidth in 32x32 CUs
+    //! \param    [in] top
+    //!           top of the region
+    //! \param    [in] bottom
+    //!           bottom of the region
+    //! \param    [in] left
+    //!           left of the region
+    //! \param    [in] right
+    //!           right of the region
+    //! \param    [out] lcuVector
+    //!           vector of LCUs' index
+    //!
+    //! \return   void
+    //!
+    void GetLcus(
+        uint32_t    streamInWidth,
+        uint32_t    top,
+        uint32_t    bottom,
+        uint32_t    left,
+        uint32_t    right,
+        UintVector &lcuVector);
+
+private:
+    //!
+    //! \brief    Update the LUT of the streamin surface
+    //!
+    //! \param    [in] streamInWidth
+    //!           StreamInWidth in 32x32 CUs
+    //! \param    [in] streamInHeight
+    //!           Number of 32x32 CU rows the LUT must cover
+    //!
+    //! \return   void
+    //!
+    void Update(
+        uint32_t streamInWidth,
+        uint32_t streamInHeight);
+
+    UintVector m_lut;             //!< LCU index of each 32x32 CU in raster order
+    uint32_t   m_lutWidth  = 0;   //!< Width of the LUT in 32x32 CUs
+    uint32_t   m_lutHeight = 0;   //!< Height of the LUT in 32x32 CUs
+
+MEDIA_CLASS_DEFINE_END(encode__RoiZigZagLut)
+};
+
+}  // namespace encode
+#endif  //<! __CODECHAL_HEVC_VDENC_ROI_ZIGZAG_H__
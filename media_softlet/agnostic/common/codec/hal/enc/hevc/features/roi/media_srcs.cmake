@@ -33,6 +33,7 @@ set(TMP_SOURCES_
     ${CMAKE_CURRENT_LIST_DIR}/encode_hevc_vdenc_roi_forceqp.cpp
     ${CMAKE_CURRENT_LIST_DIR}/encode_hevc_vdenc_roi_qpmap.cpp
     ${CMAKE_CURRENT_LIST_DIR}/encode_hevc_vdenc_roi_forcedeltaqp.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/encode_hevc_vdenc_roi_zigzag.cpp
 )
 
 set(TMP_HEADERS_
@@ -47,6 +48,7 @@ set(TMP_HEADERS_
     ${CMAKE_CURRENT_LIST_DIR}/encode_hevc_vdenc_roi_forceqp.h
     ${CMAKE_CURRENT_LIST_DIR}/encode_hevc_vdenc_roi_qpmap.h
     ${CMAKE_CURRENT_LIST_DIR}/encode_hevc_vdenc_roi_forcedeltaqp.h
+    ${CMAKE_CURRENT_LIST_DIR}/encode_hevc_vdenc_roi_zigzag.h
 )
 endif()
 
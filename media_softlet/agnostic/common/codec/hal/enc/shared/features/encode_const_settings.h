@@ -31,6 +31,7 @@
 #include <array>
 #include <vector>
 #include <functional>
+#include <cstring>
 #include "media_feature_const_settings.h"
 #include "encode_utils.h"
 #include "mhw_vdbox_vdenc_cmdpar.h"
@@ -129,6 +130,88 @@ protected:
 MEDIA_CLASS_DEFINE_END(VdencConstSettings)
 };
 
+//!
+//! \brief  Memo of command parameters evaluated by the const setting lambdas
+//! \details The lambdas are pure functions of the incoming parameters, their flag argument and a
+//!          few sequence and picture fields, which the caller packs into a 64 bit signature.
+//!          Find() returns the parameters evaluated earlier for the same inputs, Insert() records a
+//!          new evaluation. Entries are direct mapped by signature, a collision evicts the older one.
+//!
+template <typename TPar, uint32_t entryNum = 64>
+class ConstSettingsMemo
+{
+public:
+    //!
+    //! \brief  Run the lambdas on par, or copy their result for the same signature and par
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else status of the failing lambda
+    //!
+    template <typename TLambdas, typename... TArgs>
+    MOS_STATUS Evaluate(uint64_t signature, TPar &par, const TLambdas &lambdas, TArgs... args)
+    {
+        auto cached = Find(signature, par);
+        if (cached != nullptr)
+        {
+            par = *cached;
+            return MOS_STATUS_SUCCESS;
+        }
+
+        TPar in;
+        memcpy(&in, &par, sizeof(TPar));
+        for (const auto &lambda : lambdas)
+        {
+            ENCODE_CHK_STATUS_RETURN(lambda(par, args...));
+        }
+        Insert(signature, in, par);
+
+        return MOS_STATUS_SUCCESS;
+    }
+
+    const TPar *Find(uint64_t signature, const TPar &in) const
+    {
+        const Entry &entry = m_entries[Index(signature)];
+        if (entry.valid && entry.signature == signature && memcmp(&entry.in, &in, sizeof(TPar)) == 0)
+        {
+            return &entry.out;
+        }
+        return nullptr;
+    }
+
+    void Insert(uint64_t signature, const TPar &in, const TPar &out)
+    {
+        Entry &entry    = m_entries[Index(signature)];
+        entry.valid     = true;
+        entry.signature = signature;
+        entry.out       = out;
+        // Find() compares all bytes, padding included, which an assignment need not copy
+        memcpy(&entry.in, &in, sizeof(TPar));
+    }
+
+    void Reset()
+    {
+        for (auto &entry : m_entries)
+        {
+            entry.valid = false;
+        }
+    }
+
+protected:
+    static uint32_t Index(uint64_t signature)
+    {
+        return (uint32_t)((signature * 0x9E3779B97F4A7C15ull) >> 32) % entryNum;
+    }
+
+    struct Entry
+    {
+        bool     valid     = false;
+        uint64_t signature = 0;
+        TPar     in        = {};
+        TPar     out       = {};
+    };
+
+    Entry m_entries[entryNum];
+};
+
 #define VDENC_CMD1_LAMBDA() [&](mhw::vdbox::vdenc::_MHW_PAR_T(VDENC_CMD1) & par, bool isLowDelay) -> MOS_STATUS
 #define VDENC_CMD2_LAMBDA() [&](mhw::vdbox::vdenc::_MHW_PAR_T(VDENC_CMD2) & par, bool isLowDelay) -> MOS_STATUS
 #define VDENC_CMD3_LAMBDA() [&](mhw::vdbox::vdenc::_MHW_PAR_T(VDENC_CMD3) & par) -> MOS_STATUS
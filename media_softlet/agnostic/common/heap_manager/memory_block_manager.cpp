@@ -26,6 +26,37 @@
 
 #include "memory_block_manager.h"
 
+//! \brief Index of the lowest set bit, \a value must not be 0
+static inline uint32_t HeapBitScanForward(uint32_t value)
+{
+#if defined(__GNUC__)
+    return (uint32_t)__builtin_ctz(value);
+#else
+    uint32_t index = 0;
+    while ((value & 1) == 0)
+    {
+        value >>= 1;
+        ++index;
+    }
+    return index;
+#endif
+}
+
+//! \brief Index of the highest set bit, \a value must not be 0
+static inline uint32_t HeapBitScanReverse(uint32_t value)
+{
+#if defined(__GNUC__)
+    return 31 - (uint32_t)__builtin_clz(value);
+#else
+    uint32_t index = 0;
+    while (value >>= 1)
+    {
+        ++index;
+    }
+    return index;
+#endif
+}
+
 MemoryBlockManager::~MemoryBlockManager()
 {
     HEAP_FUNCTION_ENTER;
@@ -69,37 +100,40 @@ MOS_STATUS MemoryBlockManager::AcquireSpace(
         m_sortedSizes.resize(params.m_blockSizes.size());
     }
     uint32_t alignment = MOS_MAX(m_blockAlignment, MOS_ALIGN_CEIL(params.m_alignment, m_blockAlignment));
-    uint32_t idx = 0;
-    auto sortedIterator = m_sortedSizes.begin();
-    for (auto requestIterator = params.m_blockSizes.begin();
-        requestIterator != params.m_blockSizes.end();
-        ++requestIterator)
+    for (uint32_t idx = 0; idx < params.m_blockSizes.size(); ++idx)
     {
-        if (sortedIterator == m_sortedSizes.end())
-        {
-            HEAP_ASSERTMESSAGE("sortedSizes is expected to be the same size as the number of blocks requested");
-            return MOS_STATUS_UNKNOWN;
-        }
-        (*sortedIterator).m_originalIdx = idx++;
-        (*sortedIterator).m_blockSize = MOS_ALIGN_CEIL(*requestIterator, alignment);
-        ++sortedIterator;
+        m_sortedSizes[idx].m_originalIdx = idx;
+        m_sortedSizes[idx].m_blockSize = MOS_ALIGN_CEIL(params.m_blockSizes[idx], alignment);
+        m_sortedSizes[idx].m_block = nullptr;
     }
     if (m_sortedSizes.size() > 1)
     {
-        m_sortedSizes.sort([](SortedSizePair &a, SortedSizePair &b) { return a.m_blockSize > b.m_blockSize; });
+        std::sort(
+            m_sortedSizes.begin(),
+            m_sortedSizes.end(),
+            [](const SortedSizePair &a, const SortedSizePair &b) { return a.m_blockSize > b.m_blockSize; });
     }
 
-    if (m_sortedBlockListNumEntries[MemoryBlockInternal::submitted] > m_numSubmissionsForRefresh)
+    // the refresh walks every submitted block, nothing may be reclaimed if the
+    // tracker has not moved since the last one
+    bool trackerMoved = m_useProducer || m_trackerData == nullptr ||
+        !m_refreshedTrackerIdValid || *m_trackerData != m_refreshedTrackerId;
+    if (m_sortedBlockListNumEntries[MemoryBlockInternal::submitted] > m_numSubmissionsForRefresh &&
+        trackerMoved)
     {
         bool blocksUpdated = false;
         HEAP_CHK_STATUS(RefreshBlockStates(blocksUpdated));
     }
 
     spaceNeeded = 0;
-    HEAP_CHK_STATUS(IsSpaceAvailable(params, spaceNeeded));
+    MOS_STATUS status = AllocateSpace(params, blocks, spaceNeeded);
+    if (status != MOS_STATUS_SUCCESS)
+    {
+        blocks.clear();
+        return status;
+    }
     if (spaceNeeded == 0)
     {
-        HEAP_CHK_STATUS(AllocateSpace(params, blocks));
         return MOS_STATUS_SUCCESS;
     }
 
@@ -130,6 +164,11 @@ MOS_STATUS MemoryBlockManager::SubmitBlocks(std::vector<MemoryBlock> &blocks)
         HEAP_CHK_STATUS(RemoveBlockFromSortedList(internalBlock, internalBlock->GetState()));
         HEAP_CHK_STATUS(internalBlock->Submit());
         HEAP_CHK_STATUS(AddBlockToSortedList(internalBlock, internalBlock->GetState()));
+        if (!m_useProducer && internalBlock->GetTrackerId() <= m_refreshedTrackerId)
+        {
+            // reusable as of the last refresh, the next one may not be skipped
+            m_refreshedTrackerIdValid = false;
+        }
     }
 
     return MOS_STATUS_SUCCESS;
@@ -173,6 +212,7 @@ MOS_STATUS MemoryBlockManager::RefreshBlockStates(bool &blocksUpdated)
     {
         currTrackerId = *m_trackerData;
     }
+    m_refreshedTrackerIdValid = false;
 
     auto block = m_sortedBlockList[MemoryBlockInternal::State::submitted];
     MemoryBlockInternal *nextSubmitted = nullptr;
@@ -197,27 +237,7 @@ MOS_STATUS MemoryBlockManager::RefreshBlockStates(bool &blocksUpdated)
             }
 
             HEAP_CHK_STATUS(RemoveBlockFromSortedList(block, block->GetState()));
-            HEAP_CHK_STATUS(block->Free());
-            HEAP_CHK_STATUS(AddBlockToSortedList(block, block->GetState()));
-
-            // Consolidate free blocks
-            auto prev = block->GetPrev(), next = block->GetNext();
-            if (prev && prev->GetState() == MemoryBlockInternal::State::free)
-            {
-                HEAP_CHK_STATUS(MergeBlocks(prev, block));
-                // re-assign block to pPrev for use in MergeBlocks with pNext
-                block = prev;
-            }
-            else if (prev == nullptr)
-            {
-                HEAP_ASSERTMESSAGE("The previous block should always be valid");
-                return MOS_STATUS_UNKNOWN;
-            }
-
-            if (next && next->GetState() == MemoryBlockInternal::State::free)
-            {
-                HEAP_CHK_STATUS(MergeBlocks(block, next));
-            }
+            HEAP_CHK_STATUS(FreeBlock(block));
 
             blocksUpdated = true;
         }
@@ -229,6 +249,12 @@ MOS_STATUS MemoryBlockManager::RefreshBlockStates(bool &blocksUpdated)
         HEAP_CHK_STATUS(CompleteHeapDeletion());
     }
 
+    if (!m_useProducer)
+    {
+        m_refreshedTrackerId = currTrackerId;
+        m_refreshedTrackerIdValid = true;
+    }
+
     return MOS_STATUS_SUCCESS;
 }
 
@@ -299,11 +325,11 @@ MOS_STATUS MemoryBlockManager::UnregisterHeap(uint32_t heapId)
             m_totalSizeOfHeaps -= (*iterator)->m_heap->GetSize();
 
             // free blocks may be removed right away
-            auto block = m_sortedBlockList[MemoryBlockInternal::State::free];
+            auto block = GetFirstFreeBlock();
             MemoryBlockInternal *next = nullptr;
             while (block != nullptr)
             {
-                next = block->m_stateNext;
+                next = GetNextFreeBlock(block);
                 auto heap = block->GetHeap();
                 if (heap != nullptr)
                 {
@@ -380,8 +406,9 @@ MOS_STATUS MemoryBlockManager::RegisterOsInterface(PMOS_INTERFACE osInterface)
     return MOS_STATUS_SUCCESS;
 }
 
-MOS_STATUS MemoryBlockManager::IsSpaceAvailable(
+MOS_STATUS MemoryBlockManager::AllocateSpace(
     AcquireParams &params,
+    std::vector<MemoryBlock> &blocks,
     uint32_t &spaceNeeded)
 {
     HEAP_FUNCTION_ENTER_VERBOSE;
@@ -391,7 +418,8 @@ MOS_STATUS MemoryBlockManager::IsSpaceAvailable(
         HEAP_ASSERTMESSAGE("No space is being requested");
         return MOS_STATUS_INVALID_PARAMETER;
     }
-    if (m_sortedBlockList[MemoryBlockInternal::State::free] == nullptr)
+
+    if (m_sortedBlockListNumEntries[MemoryBlockInternal::State::free] == 0)
     {
         bool blocksUpdated = false;
         HEAP_CHK_STATUS(RefreshBlockStates(blocksUpdated));
@@ -401,134 +429,92 @@ MOS_STATUS MemoryBlockManager::IsSpaceAvailable(
         }
     }
 
-    auto block = m_sortedBlockList[MemoryBlockInternal::State::free];
- 
-    for (auto requestIterator = m_sortedSizes.begin();
-        requestIterator != m_sortedSizes.end();
-        ++requestIterator)
+    if (blocks.size() != m_sortedSizes.size())
+    {
+        blocks.resize(m_sortedSizes.size());
+    }
+
+    // Requests are placed largest first so that smaller requests may use the
+    // remainders of the blocks split for the larger ones.
+    MOS_STATUS status = MOS_STATUS_SUCCESS;
+    for (auto &request : m_sortedSizes)
     {
+        if (request.m_originalIdx >= blocks.size())
+        {
+            HEAP_ASSERTMESSAGE("Index is out of bounds");
+            status = MOS_STATUS_INVALID_PARAMETER;
+            break;
+        }
+
+        auto block = FindFreeBlock(request.m_blockSize);
         if (block == nullptr)
         {
-            // There is no free space available, add up all requested sizes
-            spaceNeeded += (*requestIterator).m_blockSize;
+            // keep going to report the full amount of space missing
+            spaceNeeded += request.m_blockSize;
+            continue;
+        }
+
+        auto heap = block->GetHeap();
+        if (heap == nullptr)
+        {
+            HEAP_ASSERTMESSAGE("Free block does not have a heap");
+            status = MOS_STATUS_NULL_POINTER;
+            break;
+        }
+        if (!m_useProducer)
+        {
+            status = AllocateBlock(
+                request.m_blockSize,
+                params.m_trackerId,
+                params.m_staticBlock,
+                block);
         }
         else
         {
-            // Determine whether or not there is space available
-            if ((*requestIterator).m_blockSize > block->GetSize())
-            {
-                // The requested size is larger than the largest free block size
-                spaceNeeded += (*requestIterator).m_blockSize;
-                continue;
-            }
-            else
-            {
-                // determine if there is enough space in the heaps
-                auto freeBlockSize = block->GetSize();
-                while (requestIterator != m_sortedSizes.end())
-                {
-                    if ((*requestIterator).m_blockSize < freeBlockSize)
-                    {
-                        // if the aligned size fits within the current free block, consider it used
-                        freeBlockSize -= (*requestIterator).m_blockSize;
-                        ++requestIterator;
-                    }
-                    else
-                    {
-                        // if the aligned size does not fit within the curret free block, continue for loop
-                        break;
-                    }
-                }
-                if (requestIterator == m_sortedSizes.end())
-                {
-                    break;
-                }
-            }
+            status = AllocateBlock(
+                request.m_blockSize,
+                params.m_trackerIndex,
+                params.m_trackerId,
+                params.m_staticBlock,
+                block);
         }
-        if (block != nullptr)
+        if (status != MOS_STATUS_SUCCESS)
         {
-            block = block->m_stateNext;
+            break;
         }
-    }
-
-    return MOS_STATUS_SUCCESS;
-}
+        request.m_block = block;
 
-MOS_STATUS MemoryBlockManager::AllocateSpace(
-    AcquireParams &params,
-    std::vector<MemoryBlock> &blocks)
-{
-    HEAP_FUNCTION_ENTER_VERBOSE;
-
-    if (m_sortedSizes.empty())
-    {
-        HEAP_ASSERTMESSAGE("No space is being requested");
-        return MOS_STATUS_INVALID_PARAMETER;
-    }
-
-    if (m_sortedBlockList[MemoryBlockInternal::State::free] == nullptr)
-    {
-        HEAP_ASSERTMESSAGE("No free blocks available");
-        return MOS_STATUS_INVALID_PARAMETER;
-    }
-
-    if (blocks.size() != m_sortedSizes.size())
-    {
-        blocks.resize(m_sortedSizes.size());
+        status = blocks[request.m_originalIdx].CreateFromInternalBlock(
+            block,
+            heap,
+            heap->m_keepLocked ? heap->m_lockedHeap : nullptr);
+        if (status != MOS_STATUS_SUCCESS)
+        {
+            break;
+        }
     }
 
-    for (auto requestIterator = m_sortedSizes.begin();
-        requestIterator != m_sortedSizes.end();
-        ++requestIterator)
+    if (spaceNeeded != 0 || status != MOS_STATUS_SUCCESS)
     {
-        bool allocated = false;
-        auto block = m_sortedBlockList[MemoryBlockInternal::State::free];
-        while (block != nullptr)
+        // All or nothing: return the blocks allocated by this call so the heap is
+        // left as it was, merging restores the blocks that were split. The
+        // caller's entries must not keep referring to the freed blocks.
+        for (auto &request : m_sortedSizes)
         {
-            if (block->GetSize() >= (*requestIterator).m_blockSize)
+            auto block = request.m_block;
+            if (block == nullptr)
             {
-                auto heap = block->GetHeap();
-                HEAP_CHK_NULL(heap);
-                if (!m_useProducer)
-                {
-                    HEAP_CHK_STATUS(AllocateBlock(
-                        (*requestIterator).m_blockSize,
-                        params.m_trackerId,
-                        params.m_staticBlock,
-                        block));
-                }
-                else
-                {
-                    HEAP_CHK_STATUS(AllocateBlock(
-                        (*requestIterator).m_blockSize,
-                        params.m_trackerIndex,
-                        params.m_trackerId,
-                        params.m_staticBlock,
-                        block));
-                }
-                if ((*requestIterator).m_originalIdx >= m_sortedSizes.size())
-                {
-                    HEAP_ASSERTMESSAGE("Index is out of bounds");
-                    return MOS_STATUS_INVALID_PARAMETER;
-                }
-                HEAP_CHK_STATUS(blocks[(*requestIterator).m_originalIdx].CreateFromInternalBlock(
-                    block,
-                    heap,
-                    heap->m_keepLocked ? heap->m_lockedHeap : nullptr));
-                allocated = true;
-                break;
+                continue;
             }
-            block = block->m_stateNext;
-        }
-
-        if (!allocated)
-        {
-            HEAP_ASSERTMESSAGE("No free block was found for the data! This should not occur.");
-            return MOS_STATUS_UNKNOWN;
+            request.m_block = nullptr;
+            blocks[request.m_originalIdx] = MemoryBlock();
+            HEAP_CHK_STATUS(RemoveBlockFromSortedList(block, block->GetState()));
+            block->ClearStatic();
+            HEAP_CHK_STATUS(FreeBlock(block));
         }
     }
 
-    return MOS_STATUS_SUCCESS;
+    return status;
 }
 
 MOS_STATUS MemoryBlockManager::AllocateBlock(
@@ -648,42 +634,17 @@ MOS_STATUS MemoryBlockManager::AddBlockToSortedList(
     {
         case MemoryBlockInternal::State::free:
         {
-            bool inserted = false;
-            MemoryBlockInternal *prev = nullptr;
-            while (curr != nullptr)
-            {
-                if (curr->GetSize() <= block->GetSize())
-                {
-                    if (prev)
-                    {
-                        prev->m_stateNext = block;
-                    }
-                    else
-                    {
-                        m_sortedBlockList[state] = block;
-                    }
-                    curr->m_statePrev = block;
-                    block->m_statePrev = prev;
-                    block->m_stateNext = curr;
-                    inserted = true;
-                    break;
-                }
-                prev = curr;
-                curr = curr->m_stateNext;
-            }
-            if (!inserted)
+            uint32_t fl = 0, sl = 0;
+            GetFreeListIndex(block->GetSize(), fl, sl);
+            curr = m_freeLists[fl][sl];
+            block->m_stateNext = curr;
+            if (curr)
             {
-                if (prev == nullptr)
-                {
-                    block->m_stateNext = m_sortedBlockList[state];
-                    m_sortedBlockList[state] = block;
-                }
-                else
-                {
-                    block->m_statePrev = prev;
-                    prev->m_stateNext = block;
-                }
+                curr->m_statePrev = block;
             }
+            m_freeLists[fl][sl] = block;
+            m_freeListFlBitmap |= (1u << fl);
+            m_freeListSlBitmap[fl] |= (1u << sl);
             block->m_stateListType = state;
             m_sortedBlockListNumEntries[state]++;
             m_sortedBlockListSizes[state] += block->GetSize();
@@ -739,6 +700,21 @@ MOS_STATUS MemoryBlockManager::RemoveBlockFromSortedList(
             {
                 block->m_statePrev->m_stateNext = block->m_stateNext;
             }
+            else if (state == MemoryBlockInternal::State::free)
+            {
+                // special case for beginning of a free list, which may empty it
+                uint32_t fl = 0, sl = 0;
+                GetFreeListIndex(block->GetSize(), fl, sl);
+                m_freeLists[fl][sl] = block->m_stateNext;
+                if (m_freeLists[fl][sl] == nullptr)
+                {
+                    m_freeListSlBitmap[fl] &= ~(1u << sl);
+                    if (m_freeListSlBitmap[fl] == 0)
+                    {
+                        m_freeListFlBitmap &= ~(1u << fl);
+                    }
+                }
+            }
             else
             {
                 // special case for beginning of list
@@ -799,12 +775,13 @@ MOS_STATUS MemoryBlockManager::RemoveHeapFromSortedBlockList(uint32_t heapId)
             continue;
         }
 
-        auto curr = m_sortedBlockList[state];
+        bool freeState = (state == MemoryBlockInternal::State::free);
+        auto curr = freeState ? GetFirstFreeBlock() : m_sortedBlockList[state];
         Heap *heap = nullptr;
         MemoryBlockInternal *nextBlock = nullptr;
         while (curr != nullptr)
         {
-            nextBlock = curr->m_stateNext;
+            nextBlock = freeState ? GetNextFreeBlock(curr) : curr->m_stateNext;
             heap = curr->GetHeap();
             HEAP_CHK_NULL(heap);
             if (heap->GetId() == heapId)
@@ -818,6 +795,142 @@ MOS_STATUS MemoryBlockManager::RemoveHeapFromSortedBlockList(uint32_t heapId)
     return MOS_STATUS_SUCCESS;
 }
 
+MOS_STATUS MemoryBlockManager::FreeBlock(MemoryBlockInternal *block)
+{
+    HEAP_FUNCTION_ENTER_VERBOSE;
+
+    HEAP_CHK_NULL(block);
+
+    HEAP_CHK_STATUS(block->Free());
+    HEAP_CHK_STATUS(AddBlockToSortedList(block, block->GetState()));
+
+    // Consolidate free blocks
+    auto prev = block->GetPrev(), next = block->GetNext();
+    if (prev && prev->GetState() == MemoryBlockInternal::State::free)
+    {
+        HEAP_CHK_STATUS(MergeBlocks(prev, block));
+        // re-assign block to pPrev for use in MergeBlocks with pNext
+        block = prev;
+    }
+    else if (prev == nullptr)
+    {
+        HEAP_ASSERTMESSAGE("The previous block should always be valid");
+        return MOS_STATUS_UNKNOWN;
+    }
+
+    if (next && next->GetState() == MemoryBlockInternal::State::free)
+    {
+        HEAP_CHK_STATUS(MergeBlocks(block, next));
+    }
+
+    return MOS_STATUS_SUCCESS;
+}
+
+void MemoryBlockManager::GetFreeListIndex(uint32_t size, uint32_t &fl, uint32_t &sl)
+{
+    // sizes are in units of the block alignment, the smallest ranges are linear
+    uint32_t units = size / m_blockAlignment;
+    if (units < m_freeListSlCount)
+    {
+        fl = 0;
+        sl = units;
+        return;
+    }
+
+    uint32_t msb = HeapBitScanReverse(units);
+    fl = msb - m_freeListSlBits + 1;
+    sl = (units >> (msb - m_freeListSlBits)) - m_freeListSlCount;
+}
+
+MemoryBlockInternal *MemoryBlockManager::FindFreeBlock(uint32_t size)
+{
+    HEAP_FUNCTION_ENTER_VERBOSE;
+
+    // round the size up to the next list boundary so that every block in the
+    // list found is large enough
+    uint32_t units = MOS_ALIGN_CEIL(size, m_blockAlignment) / m_blockAlignment;
+    if (units >= m_freeListSlCount)
+    {
+        units += (1u << (HeapBitScanReverse(units) - m_freeListSlBits)) - 1;
+    }
+
+    uint32_t fl = 0, sl = 0;
+    GetFreeListIndex(units * m_blockAlignment, fl, sl);
+    if (fl < m_freeListFlCount)
+    {
+        uint32_t slBitmap = m_freeListSlBitmap[fl] & (~0u << sl);
+        if (slBitmap == 0)
+        {
+            uint32_t flBitmap = (fl + 1 < m_freeListFlCount) ? (m_freeListFlBitmap & (~0u << (fl + 1))) : 0;
+            if (flBitmap != 0)
+            {
+                fl = HeapBitScanForward(flBitmap);
+                slBitmap = m_freeListSlBitmap[fl];
+            }
+        }
+        if (slBitmap != 0)
+        {
+            return m_freeLists[fl][HeapBitScanForward(slBitmap)];
+        }
+    }
+
+    // no list is guaranteed to fit, the list holding this size may still have
+    // a large enough block; take the smallest that fits
+    GetFreeListIndex(size, fl, sl);
+    MemoryBlockInternal *bestBlock = nullptr;
+    for (auto block = m_freeLists[fl][sl]; block != nullptr; block = block->m_stateNext)
+    {
+        if (block->GetSize() >= size &&
+            (bestBlock == nullptr || block->GetSize() < bestBlock->GetSize()))
+        {
+            bestBlock = block;
+        }
+    }
+
+    return bestBlock;
+}
+
+MemoryBlockInternal *MemoryBlockManager::GetFirstFreeBlock()
+{
+    if (m_freeListFlBitmap == 0)
+    {
+        return nullptr;
+    }
+
+    uint32_t fl = HeapBitScanReverse(m_freeListFlBitmap);
+    uint32_t sl = HeapBitScanReverse(m_freeListSlBitmap[fl]);
+    return m_freeLists[fl][sl];
+}
+
+MemoryBlockInternal *MemoryBlockManager::GetNextFreeBlock(MemoryBlockInternal *block)
+{
+    if (block == nullptr)
+    {
+        return nullptr;
+    }
+    if (block->m_stateNext)
+    {
+        return block->m_stateNext;
+    }
+
+    uint32_t fl = 0, sl = 0;
+    GetFreeListIndex(block->GetSize(), fl, sl);
+
+    uint32_t slBitmap = m_freeListSlBitmap[fl] & ((1u << sl) - 1);
+    if (slBitmap == 0)
+    {
+        uint32_t flBitmap = m_freeListFlBitmap & ((1u << fl) - 1);
+        if (flBitmap == 0)
+        {
+            return nullptr;
+        }
+        fl = HeapBitScanReverse(flBitmap);
+        slBitmap = m_freeListSlBitmap[fl];
+    }
+
+    return m_freeLists[fl][HeapBitScanReverse(slBitmap)];
+}
+
 MOS_STATUS MemoryBlockManager::MergeBlocks(
     MemoryBlockInternal *blockCombined,
     MemoryBlockInternal *blockRelease)
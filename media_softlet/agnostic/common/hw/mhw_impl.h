@@ -28,6 +28,7 @@
 #ifndef __MHW_IMPL_H__
 #define __MHW_IMPL_H__
 
+#include <vector>
 #include "mhw_itf.h"
 #include "mhw_utilities.h"
 #include "media_class_trace.h"
@@ -93,10 +94,10 @@ protected:                             \
 
 #define _MHW_SETCMD_OVERRIDE_DECL(CMD) __MHW_SETCMD_DECL(CMD) override
 
-#define _MHW_SETCMD_CALLBASE(CMD)                            \
-    MHW_FUNCTION_ENTER;                                      \
-    const auto &params = this->__MHW_CMDINFO_M(CMD)->first;  \
-    auto &      cmd    = this->__MHW_CMDINFO_M(CMD)->second; \
+#define _MHW_SETCMD_CALLBASE(CMD)                                              \
+    MHW_FUNCTION_ENTER;                                                        \
+    const auto &params = this->__MHW_CMDINFO_M(CMD)->first;                    \
+    auto &      cmd    = this->CurrentCmd(this->__MHW_CMDINFO_M(CMD)->second); \
     MHW_CHK_STATUS_RETURN(base_t::__MHW_SETCMD_F(CMD)())
 
 // DWORD location of a command field
@@ -184,6 +185,13 @@ protected:
         {
             AddResourceToCmd = Mhw_AddResourceToCmd_PatchList;
         }
+
+        // SETCMD bitfield writes are read-modify-writes, they are only done in
+        // the command/batch buffer when it is mapped cached. Buffers in local
+        // memory are mapped write combined, there the command is built in its
+        // staging copy and written once.
+        MEDIA_FEATURE_TABLE *skuTable = m_osItf->pfnGetSkuTable ? m_osItf->pfnGetSkuTable(m_osItf) : nullptr;
+        m_buildInPlace                = skuTable && !MEDIA_IS_SKU(skuTable, FtrLocalMemory);
     }
 
     virtual ~Impl()
@@ -191,18 +199,180 @@ protected:
         MHW_FUNCTION_ENTER;
     }
 
+    //!
+    //! \brief    Command being set by the current SETCMD
+    //! \details  Returns the in place destination reserved by AddCmd in the
+    //!           command/batch buffer, or the staging command if AddCmd fell
+    //!           back to build-then-copy
+    //!
+    template <typename Cmd>
+    Cmd &CurrentCmd(Cmd &staging)
+    {
+        return m_currentCmd ? *static_cast<Cmd *>(m_currentCmd) : staging;
+    }
+
+    //!
+    //! \brief    Reserve space for a command in the command/batch buffer
+    //! \return   Pointer to the reserved space, nullptr if the command has to
+    //!           be built in the staging command and copied
+    //!
+    template <typename Cmd>
+    static Cmd *ReserveCmd(PMOS_COMMAND_BUFFER cmdBuf, PMHW_BATCH_BUFFER batchBuf)
+    {
+        uint8_t *dst = nullptr;
+
+        if (cmdBuf)
+        {
+            if (cmdBuf->pCmdPtr && cmdBuf->iRemaining >= (int32_t)sizeof(Cmd))
+            {
+                dst = reinterpret_cast<uint8_t *>(cmdBuf->pCmdPtr);
+            }
+        }
+        else if (batchBuf)
+        {
+            if (batchBuf->pData && batchBuf->iRemaining >= (int32_t)sizeof(Cmd))
+            {
+                dst = batchBuf->pData + batchBuf->iCurrent;
+            }
+        }
+
+        if (dst == nullptr || reinterpret_cast<uintptr_t>(dst) % alignof(Cmd))
+        {
+            return nullptr;
+        }
+
+        return reinterpret_cast<Cmd *>(dst);
+    }
+
+    //!
+    //! \brief    Advance the command/batch buffer over commands written in place
+    //!
+    static void CommitCmd(PMOS_COMMAND_BUFFER cmdBuf, PMHW_BATCH_BUFFER batchBuf, uint32_t size)
+    {
+        if (cmdBuf)
+        {
+            cmdBuf->iOffset += size;
+            cmdBuf->iRemaining -= size;
+            cmdBuf->pCmdPtr += size / sizeof(uint32_t);
+        }
+        else
+        {
+            batchBuf->iCurrent += size;
+            batchBuf->iRemaining -= size;
+        }
+    }
+
+    //!
+    //! \brief    Add a command built while another one is set in place
+    //! \details  A command added to the buffer of the command being set in
+    //!           place can not be written there yet. It is kept aside and the
+    //!           buffer is advanced over it, so that offsets taken from here on
+    //!           (patch list entries) are where it ends up; PlaceNestedCmds()
+    //!           writes it ahead of the in place command once that one is set,
+    //!           the order a staging copy of the in place command would give.
+    //!
+    MOS_STATUS AddNestedCmd(PMOS_COMMAND_BUFFER cmdBuf, PMHW_BATCH_BUFFER batchBuf, const void *cmd, uint32_t size)
+    {
+        bool sameBuf = cmdBuf ? cmdBuf == m_inPlaceCmdBuf : batchBuf && batchBuf == m_inPlaceBatchBuf;
+        if (!sameBuf)
+        {
+            return Mhw_AddCommandCmdOrBB(cmdBuf, batchBuf, cmd, size);
+        }
+
+        // the in place command still needs its room behind the nested ones
+        int32_t remaining = cmdBuf ? cmdBuf->iRemaining : batchBuf->iRemaining;
+        if (remaining < (int32_t)(size + m_inPlaceCmdSize))
+        {
+            MHW_ASSERTMESSAGE("Unable to add command (no space).");
+            return MOS_STATUS_UNKNOWN;
+        }
+
+        m_nestedCmds.insert(m_nestedCmds.end(), static_cast<const uint8_t *>(cmd), static_cast<const uint8_t *>(cmd) + size);
+        CommitCmd(cmdBuf, batchBuf, size);
+
+        return MOS_STATUS_SUCCESS;
+    }
+
+    //!
+    //! \brief    Write the commands kept aside by AddNestedCmd() ahead of the in
+    //!           place command
+    //! \param    [in] cmd
+    //!           In place command
+    //! \param    [in] size
+    //!           Size of the in place command to move behind them, 0 if it is
+    //!           dropped
+    //! \return   New location of the in place command
+    //!
+    uint8_t *PlaceNestedCmds(void *cmd, uint32_t size)
+    {
+        uint8_t *dst = static_cast<uint8_t *>(cmd);
+
+        if (!m_nestedCmds.empty())
+        {
+            uint32_t nestedSize = (uint32_t)m_nestedCmds.size();
+            if (size)
+            {
+                memmove(dst + nestedSize, dst, size);
+            }
+            MOS_SecureMemcpy(dst, nestedSize, m_nestedCmds.data(), nestedSize);
+            m_nestedCmds.clear();
+            dst += nestedSize;
+        }
+
+        m_inPlaceCmdBuf   = nullptr;
+        m_inPlaceBatchBuf = nullptr;
+        m_inPlaceCmdSize  = 0;
+
+        return dst;
+    }
+
     template <typename Cmd, typename CmdSetting>
     MOS_STATUS AddCmd(PMOS_COMMAND_BUFFER cmdBuf,
         PMHW_BATCH_BUFFER                 batchBuf,
         Cmd &                             cmd,
         const CmdSetting &                setting)
     {
-        this->m_currentCmdBuf   = cmdBuf;
-        this->m_currentBatchBuf = batchBuf;
+        static_assert(sizeof(Cmd) % sizeof(uint32_t) == 0, "MHW command size must be DWORD aligned");
+
+        // default-constructed command, built once per command type
+        static const Cmd defaultCmd{};
+
+        PMOS_COMMAND_BUFFER prevCmdBuf   = this->m_currentCmdBuf;
+        PMHW_BATCH_BUFFER   prevBatchBuf = this->m_currentBatchBuf;
+        this->m_currentCmdBuf            = cmdBuf;
+        this->m_currentBatchBuf          = batchBuf;
+
+        // set MHW cmd directly in the command/batch buffer when there is room,
+        // so that the command is written once instead of built and copied; a
+        // command added while another one is set in place uses its staging
+        // command, see AddNestedCmd()
+        bool nested = m_inPlaceCmdSize != 0;
+        Cmd *dst    = (m_buildInPlace && !nested) ? ReserveCmd<Cmd>(cmdBuf, batchBuf) : nullptr;
+        if (dst == nullptr)
+        {
+            dst = &cmd;
+        }
+        else
+        {
+            m_inPlaceCmdBuf   = cmdBuf;
+            m_inPlaceBatchBuf = cmdBuf ? nullptr : batchBuf;
+            m_inPlaceCmdSize  = sizeof(Cmd);
+        }
+        MOS_SecureMemcpy(dst, sizeof(Cmd), &defaultCmd, sizeof(Cmd));
+
+        void *prevCmd      = m_currentCmd;
+        m_currentCmd       = (dst != &cmd) ? dst : nullptr;
+        MOS_STATUS eStatus = setting();
+        m_currentCmd       = prevCmd;
+
+        this->m_currentCmdBuf   = prevCmdBuf;
+        this->m_currentBatchBuf = prevBatchBuf;
 
-        // set MHW cmd
-        cmd = {};
-        MHW_CHK_STATUS_RETURN(setting());
+        if (dst != &cmd)
+        {
+            dst = reinterpret_cast<Cmd *>(PlaceNestedCmds(dst, MOS_SUCCEEDED(eStatus) ? sizeof(Cmd) : 0));
+        }
+        MHW_CHK_STATUS_RETURN(eStatus);
 
         // call MHW cmd parser
     #if MHW_HWCMDPARSER_ENABLED
@@ -210,12 +380,22 @@ protected:
         if (instance)
         {
             instance->ParseCmd(this->m_currentCmdName,
-                reinterpret_cast<uint32_t *>(&cmd),
-                sizeof(cmd) / sizeof(uint32_t));
+                reinterpret_cast<uint32_t *>(dst),
+                sizeof(Cmd) / sizeof(uint32_t));
         }
     #endif
 
+        if (dst != &cmd)
+        {
+            CommitCmd(cmdBuf, batchBuf, sizeof(Cmd));
+            return MOS_STATUS_SUCCESS;
+        }
+
         // add cmd to cmd buffer
+        if (nested)
+        {
+            return AddNestedCmd(cmdBuf, batchBuf, &cmd, sizeof(cmd));
+        }
         return Mhw_AddCommandCmdOrBB(cmdBuf, batchBuf, &cmd, sizeof(cmd));
     }
 
@@ -223,9 +403,15 @@ protected:
     MOS_STATUS(*AddResourceToCmd)
     (PMOS_INTERFACE osItf, PMOS_COMMAND_BUFFER cmdBuf, PMHW_RESOURCE_PARAMS params) = nullptr;
 
-    PMOS_INTERFACE      m_osItf           = nullptr;
-    PMOS_COMMAND_BUFFER m_currentCmdBuf   = nullptr;
-    PMHW_BATCH_BUFFER   m_currentBatchBuf = nullptr;
+    PMOS_INTERFACE       m_osItf           = nullptr;
+    PMOS_COMMAND_BUFFER  m_currentCmdBuf   = nullptr;
+    PMHW_BATCH_BUFFER    m_currentBatchBuf = nullptr;
+    bool                 m_buildInPlace    = false;    //!< commands are set in place in the command/batch buffer
+    void *               m_currentCmd      = nullptr;  //!< in place destination of the command being set
+    PMOS_COMMAND_BUFFER  m_inPlaceCmdBuf   = nullptr;  //!< command buffer of the command set in place
+    PMHW_BATCH_BUFFER    m_inPlaceBatchBuf = nullptr;  //!< batch buffer of the command set in place
+    uint32_t             m_inPlaceCmdSize  = 0;        //!< size of the command set in place, 0 if none
+    std::vector<uint8_t> m_nestedCmds;                 //!< commands added while a command is set in place
 
 #if MHW_HWCMDPARSER_ENABLED
     std::string m_currentCmdName;
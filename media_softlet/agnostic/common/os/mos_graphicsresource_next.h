@@ -166,6 +166,9 @@ public:
         bool m_uncached     = false;
         bool m_writeRequest = false;
         bool m_noOverWrite  = false;
+        bool m_writeDiscard = false;        //!< Previous contents of the locked rows are not needed
+        uint32_t m_lockOffsetY = 0;         //!< First surface row the caller accesses
+        uint32_t m_lockHeight  = 0;         //!< Number of rows the caller accesses, 0 means the whole surface
 
         //!
         //! \brief   For wrapper usage, to be removed
@@ -179,6 +182,7 @@ public:
             m_uncached     = pLockFlags->Uncached;
             m_writeRequest = pLockFlags->WriteOnly;
             m_noOverWrite  = pLockFlags->NoOverWrite;
+            m_writeDiscard = pLockFlags->WriteDiscard;
         };
 
         LockParams()
@@ -136,6 +136,13 @@ MOS_STATUS MosUserSetting::InitMosCommonUserSetting(MediaUserSettingSharedPtr us
         "",
         true); //" Perf Utility Tool Customize Output Directory. "
 
+    DeclareUserSettingKey(
+        userSettingPtr,
+        __MEDIA_USER_FEATURE_VALUE_COPY_WORKER_NUMBER,
+        MediaUserSetting::Group::Device,
+        0,
+        false); //"Number of worker threads copying vaGetImage planes. (Default 0: disabled)"
+
 #if MOS_COMMAND_BUFFER_DUMP_SUPPORTED
     DeclareUserSettingKey(
         userSettingPtr,
@@ -1944,6 +1944,40 @@ public:
         int32_t         iPitch,
         int32_t         extFlags);
 
+    //!
+    //! \brief    Swizzle a band of rows
+    //! \details  Same as MosSwizzleData() for rows [iStartRow, iStartRow + iNumRows)
+    //!           only. Both buffers are whole surfaces; rows outside the band are
+    //!           not touched. Bands starting on a tile row boundary are copied
+    //!           tile by tile, others byte by byte.
+    //! \param    [in] pSrc
+    //!           Pointer to source data.
+    //! \param    [out] pDst
+    //!           Pointer to destiny data.
+    //! \param    [in] SrcTiling
+    //!           Source Tile Type
+    //! \param    [in] DstTiling
+    //!           Destiny Tile Type
+    //! \param    [in] iStartRow
+    //!           First row of the band
+    //! \param    [in] iNumRows
+    //!           Number of rows in the band
+    //! \param    [in] iPitch
+    //!           Pitch
+    //! \param    [in] extFlags
+    //!           Extended flags
+    //! \return   void
+    //!
+    static void MosSwizzleDataRows(
+        uint8_t         *pSrc,
+        uint8_t         *pDst,
+        MOS_TILE_TYPE   SrcTiling,
+        MOS_TILE_TYPE   DstTiling,
+        int32_t         iStartRow,
+        int32_t         iNumRows,
+        int32_t         iPitch,
+        int32_t         extFlags);
+
     //!
     //! \brief    MOS trace event initialize
     //! \details  register provide Global ID to the system.
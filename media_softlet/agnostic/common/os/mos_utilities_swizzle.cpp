@@ -0,0 +1,340 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     mos_utilities_swizzle.cpp
+//! \brief    Tiled <-> linear swizzling used by the software swizzled locks
+//! \details  Kept apart from mos_utilities_next.cpp so it only depends on the
+//!           MOS memory helpers and can be linked on its own.
+//!
+
+#include "mos_os.h"
+#include "mos_utilities.h"
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+#ifdef _MOS_UTILITY_EXT
+#include "mos_utilities_ext_next.h"
+#else
+#define Mos_SwizzleOffset MosUtilities::MosSwizzleOffset
+#endif
+
+int32_t MosUtilities::MosSwizzleOffset(
+    int32_t         OffsetX,
+    int32_t         OffsetY,
+    int32_t         Pitch,
+    MOS_TILE_TYPE   TileFormat,
+    int32_t         CsxSwizzle,
+    int32_t         ExtFlags)
+{
+    // When dealing with a tiled surface, logical linear accesses to the
+    // surface (y * pitch + x) must be translated into appropriate tile-
+    // formated accesses--This is done by swizzling (rearranging/translating)
+    // the given access address--though it is important to note that the
+    // swizzling is actually done on the accessing OFFSET into a TILED
+    // REGION--not on the absolute address itself.
+
+    // (!) Y-MAJOR TILING, REINTERPRETATION: For our purposes here, Y-Major
+    // tiling will be thought of in a different way, we will deal with
+    // the 16-byte-wide columns individually--i.e., we will treat a single
+    // Y-Major tile as 8 separate, thinner tiles--Doing so allows us to
+    // deal with both X- and Y-Major tile formats in the same "X-Major"
+    // way--just with different dimensions: either 512B x 8 rows, or
+    // 16B x 32 rows, respectively.
+
+    // A linear offset into a surface is of the form
+    //     y * pitch + x   =   y:x (Shorthand, meaning: y * (x's per y) + x)
+    //
+    // To treat a surface as being composed of tiles (though still being
+    // linear), just as a linear offset has a y:x composition--its y and x
+    // components can be thought of as having Row:Line and Column:X
+    // compositions, respectively, where Row specifies a row of tiles, Line
+    // specifies a row of pixels within a tile, Column specifies a column
+    // of tiles, and X in this context refers to a byte within a Line--i.e.,
+    //     offset = y:x
+    //     y = Row:Line
+    //     x = Col:X
+    //     offset = y:x = Row:Line:Col:X
+
+    // Given the Row:Line:Col:X composition of a linear offset, all that
+    // tile swizzling does is swap the Line and Col components--i.e.,
+    //     Linear Offset:   Row:Line:Col:X
+    //     Swizzled Offset: Row:Col:Line:X
+    // And with our reinterpretation of the Y-Major tiling format, we can now
+    // describe both the X- and Y-Major tiling formats in two simple terms:
+    // (1) The bit-depth of their Lines component--LBits, and (2) the
+    // swizzled bit-position of the Lines component (after it swaps with the
+    // Col component)--LPos.
+
+    int32_t Row, Line, Col, x; // Linear Offset Components
+    int32_t LBits, LPos; // Size and swizzled position of the Line component.
+    int32_t SwizzledOffset;
+    if (TileFormat == MOS_TILE_LINEAR)
+    {
+        return(OffsetY * Pitch + OffsetX);
+    }
+
+    if (TileFormat == MOS_TILE_Y)
+    {
+        LBits = 5; // Log2(TileY.Height = 32)
+        LPos = 4;  // Log2(TileY.PseudoWidth = 16)
+    }
+    else //if (TileFormat == MOS_TILE_X)
+    {
+        LBits = 3; // Log2(TileX.Height = 8)
+        LPos = 9;  // Log2(TileX.Width = 512)
+    }
+
+    Row = OffsetY >> LBits;               // OffsetY / LinesPerTile
+    Line = OffsetY & ((1 << LBits) - 1);   // OffsetY % LinesPerTile
+    Col = OffsetX >> LPos;                // OffsetX / BytesPerLine
+    x = OffsetX & ((1 << LPos) - 1);    // OffsetX % BytesPerLine
+
+    SwizzledOffset =
+        (((((Row * (Pitch >> LPos)) + Col) << LBits) + Line) << LPos) + x;
+    //                V                V                 V
+    //                / BytesPerLine   * LinesPerTile    * BytesPerLine
+
+    /// Channel Select XOR Swizzling ///////////////////////////////////////////
+    if (CsxSwizzle)
+    {
+        if (TileFormat == MOS_TILE_Y) // A6 = A6 ^ A9
+        {
+            SwizzledOffset ^= ((SwizzledOffset >> (9 - 6)) & 0x40);
+        }
+        else //if (TileFormat == VPHAL_TILE_X) // A6 = A6 ^ A9 ^ A10
+        {
+            SwizzledOffset ^= (((SwizzledOffset >> (9 - 6)) ^ (SwizzledOffset >> (10 - 6))) & 0x40);
+        }
+    }
+
+    return(SwizzledOffset);
+}
+
+//!
+//! \brief    Copy one 16 byte OWord column of a TileY tile from/to linear rows
+//!
+static inline void MosSwizzleOWordColumn(
+    uint8_t *pTile,
+    uint8_t *pLinear,
+    int32_t  iPitch,
+    int32_t  iLines,
+    bool     bToLinear)
+{
+#if defined(__SSE2__) || defined(_M_X64)
+    if (bToLinear)
+    {
+        for (int32_t line = 0; line < iLines; line++, pTile += 16, pLinear += iPitch)
+        {
+            _mm_storeu_si128((__m128i *)pLinear, _mm_loadu_si128((const __m128i *)pTile));
+        }
+    }
+    else
+    {
+        for (int32_t line = 0; line < iLines; line++, pTile += 16, pLinear += iPitch)
+        {
+            _mm_storeu_si128((__m128i *)pTile, _mm_loadu_si128((const __m128i *)pLinear));
+        }
+    }
+#else
+    for (int32_t line = 0; line < iLines; line++, pTile += 16, pLinear += iPitch)
+    {
+        if (bToLinear)
+        {
+            MOS_SecureMemcpy(pLinear, 16, pTile, 16);
+        }
+        else
+        {
+            MOS_SecureMemcpy(pTile, 16, pLinear, 16);
+        }
+    }
+#endif
+}
+
+//!
+//! \brief    Swizzle data by walking the tiled surface tile by tile
+//! \details  Same mapping as MosSwizzleOffset() without CSX swizzling: every
+//!           tile line (16B for TileY, 512B for TileX) is contiguous in both
+//!           layouts, so whole lines are copied and the tiled side is accessed
+//!           sequentially. Bytes of a row beyond the last full tile column go
+//!           through MosSwizzleOffset().
+//!
+static void MosSwizzleDataTileWalk(
+    uint8_t         *pTiled,
+    uint8_t         *pLinear,
+    MOS_TILE_TYPE   Tiling,
+    bool            bToLinear,
+    int32_t         iStartRow,
+    int32_t         iEndRow,
+    int32_t         iPitch,
+    int32_t         extFlags)
+{
+    // TileY is handled as 16B x 32 line columns, anything else as TileX
+    const bool    bTileY     = (Tiling == MOS_TILE_Y);
+    const int32_t LBits      = bTileY ? 5 : 3;
+    const int32_t LPos       = bTileY ? 4 : 9;
+    const int32_t LineBytes  = 1 << LPos;
+    const int32_t TileLines  = 1 << LBits;
+    const int32_t TileBytes  = LineBytes << LBits;
+    const int32_t Columns    = iPitch >> LPos;
+    const int32_t TailStart  = Columns << LPos;
+
+    for (int32_t y = iStartRow; y < iEndRow; y += TileLines)
+    {
+        const int32_t Lines    = MOS_MIN(TileLines, iEndRow - y);
+        uint8_t      *pTileRow = pTiled + (int64_t)(y >> LBits) * Columns * TileBytes;
+        uint8_t      *pRow     = pLinear + (int64_t)y * iPitch;
+
+        for (int32_t col = 0; col < Columns; col++)
+        {
+            uint8_t *pTile = pTileRow + (int64_t)col * TileBytes;
+            uint8_t *pLine = pRow + col * LineBytes;
+
+            if (bTileY)
+            {
+                MosSwizzleOWordColumn(pTile, pLine, iPitch, Lines, bToLinear);
+                continue;
+            }
+            for (int32_t line = 0; line < Lines; line++, pTile += LineBytes, pLine += iPitch)
+            {
+                if (bToLinear)
+                {
+                    MOS_SecureMemcpy(pLine, LineBytes, pTile, LineBytes);
+                }
+                else
+                {
+                    MOS_SecureMemcpy(pTile, LineBytes, pLine, LineBytes);
+                }
+            }
+        }
+
+        for (int32_t line = y; line < y + Lines && TailStart < iPitch; line++)
+        {
+            for (int32_t x = TailStart; x < iPitch; x++)
+            {
+                int32_t TileOffset = Mos_SwizzleOffset(x, line, iPitch, Tiling, false, extFlags);
+                if (bToLinear)
+                {
+                    pLinear[line * iPitch + x] = pTiled[TileOffset];
+                }
+                else
+                {
+                    pTiled[TileOffset] = pLinear[line * iPitch + x];
+                }
+            }
+        }
+    }
+}
+
+void MosUtilities::MosSwizzleData(
+    uint8_t         *pSrc,
+    uint8_t         *pDst,
+    MOS_TILE_TYPE   SrcTiling,
+    MOS_TILE_TYPE   DstTiling,
+    int32_t         iHeight,
+    int32_t         iPitch,
+    int32_t         extFlags)
+{
+    MosSwizzleDataRows(pSrc, pDst, SrcTiling, DstTiling, 0, iHeight, iPitch, extFlags);
+}
+
+void MosUtilities::MosSwizzleDataRows(
+    uint8_t         *pSrc,
+    uint8_t         *pDst,
+    MOS_TILE_TYPE   SrcTiling,
+    MOS_TILE_TYPE   DstTiling,
+    int32_t         iStartRow,
+    int32_t         iNumRows,
+    int32_t         iPitch,
+    int32_t         extFlags)
+{
+
+#define IS_TILED(_a)                ((_a) != MOS_TILE_LINEAR)
+#define IS_TILED_TO_LINEAR(_a, _b)  (IS_TILED(_a) && !IS_TILED(_b))
+#define IS_LINEAR_TO_TILED(_a, _b)  (!IS_TILED(_a) && IS_TILED(_b))
+
+    int32_t LinearOffset;
+    int32_t TileOffset;
+    int32_t x;
+    int32_t y;
+    int32_t iEndRow = iStartRow + iNumRows;
+
+#ifdef _MOS_UTILITY_EXT
+    // Extended swizzling may change the tile layout, keep the per byte path
+    bool bTileWalk = (extFlags == 0);
+#else
+    bool bTileWalk = true;
+#endif
+    // the tile walk starts at a tile row boundary
+    MOS_TILE_TYPE Tiling = IS_TILED(SrcTiling) ? SrcTiling : DstTiling;
+    bTileWalk = bTileWalk && (iStartRow % ((Tiling == MOS_TILE_Y) ? 32 : 8)) == 0;
+
+    if (bTileWalk && IS_TILED_TO_LINEAR(SrcTiling, DstTiling))
+    {
+        MosSwizzleDataTileWalk(pSrc, pDst, SrcTiling, true, iStartRow, iEndRow, iPitch, extFlags);
+        return;
+    }
+    if (bTileWalk && IS_LINEAR_TO_TILED(SrcTiling, DstTiling))
+    {
+        MosSwizzleDataTileWalk(pDst, pSrc, DstTiling, false, iStartRow, iEndRow, iPitch, extFlags);
+        return;
+    }
+
+    // Translate from one format to another
+    for (y = iStartRow, LinearOffset = iStartRow * iPitch, TileOffset = 0; y < iEndRow; y++)
+    {
+        for (x = 0; x < iPitch; x++, LinearOffset++)
+        {
+            // x or y --> linear
+            if (IS_TILED_TO_LINEAR(SrcTiling, DstTiling))
+            {
+                TileOffset = Mos_SwizzleOffset(
+                    x,
+                    y,
+                    iPitch,
+                    SrcTiling,
+                    false,
+                    extFlags);
+
+                *(pDst + LinearOffset) = *(pSrc + TileOffset);
+            }
+            // linear --> x or y
+            else if (IS_LINEAR_TO_TILED(SrcTiling, DstTiling))
+            {
+                TileOffset = Mos_SwizzleOffset(
+                    x,
+                    y,
+                    iPitch,
+                    DstTiling,
+                    false,
+                    extFlags);
+
+                *(pDst + TileOffset) = *(pSrc + LinearOffset);
+            }
+            else
+            {
+                MOS_OS_ASSERT(0);
+            }
+        }
+    }
+}
+
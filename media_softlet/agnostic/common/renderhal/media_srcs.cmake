@@ -20,6 +20,7 @@
 
 set(TMP_SOURCES_
     ${CMAKE_CURRENT_LIST_DIR}/renderhal.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/renderhal_kernel.cpp
     ${CMAKE_CURRENT_LIST_DIR}/renderhal_platform_interface_next.cpp
 )
 
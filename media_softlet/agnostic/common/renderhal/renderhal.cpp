@@ -142,20 +142,6 @@ const MHW_MEDIA_STATE_FLUSH_PARAM  g_cRenderHal_InitMediaStateFlushParams =
     0                                   // ui8InterfaceDescriptorOffset
 };
 
-const RENDERHAL_KERNEL_PARAM g_cRenderHal_InitKernelParams =
-{
-    0,                                  // GRF_Count;
-    0,                                  // BT_Count;
-    0,                                  // Sampler_Count
-    0,                                  // Thread_Count
-    0,                                  // GRF_Start_Register
-    0,                                  // CURBE_Length
-    0,                                  // block_width
-    0,                                  // block_height
-    0,                                  // blocks_x
-    0                                   // blocks_y
-};
-
 //!
 //! \brief      Table only used on HSW (look @ renderhal.c for HSW- table)
 //!             Constants used for setting up surface states ui8PlaneID, 
@@ -1079,6 +1065,8 @@ void RenderHal_GetPixelsPerSample(
 |  |         |                    .                      |
 |  |         | Kernel Allocation [K-1]                   |
 |  |         |-------------------------------------------|
+|  |         | Kernel Allocation Node [0] to [K-1]       |
+|  |         |-------------------------------------------|
 |  |         | Media State Control Structure [0]         |--+
 |  |         | Media State Control Structure [1]         |--|--+
 |  |         |                    .                      |  |  |
@@ -1186,6 +1174,7 @@ MOS_STATUS RenderHal_AllocateStateHeaps(
     // Calculate size of State Heap control structure
     dwSizeAlloc  = MOS_ALIGN_CEIL(stateHeapSize, 16);
     dwSizeAlloc += MOS_ALIGN_CEIL(pSettings->iKernelCount     * sizeof(RENDERHAL_KRN_ALLOCATION)     , 16);
+    dwSizeAlloc += MOS_ALIGN_CEIL(pSettings->iKernelCount     * sizeof(RENDERHAL_KRN_ALLOC_NODE)     , 16);
     dwSizeAlloc += MOS_ALIGN_CEIL(pSettings->iMediaStateHeaps * mediaStateSize, 16);
     dwSizeAlloc += MOS_ALIGN_CEIL(pSettings->iMediaStateHeaps * pSettings->iMediaIDs * sizeof(int32_t)   , 16);
     dwSizeAlloc += MOS_ALIGN_CEIL(pSettings->iSurfaceStates   * sizeof(RENDERHAL_SURFACE_STATE_ENTRY), 16);
@@ -1223,6 +1212,10 @@ MOS_STATUS RenderHal_AllocateStateHeaps(
     pStateHeap->pKernelAllocation = (PRENDERHAL_KRN_ALLOCATION) ptr;
     ptr += MOS_ALIGN_CEIL(pSettings->iKernelCount * sizeof(RENDERHAL_KRN_ALLOCATION), 16);
 
+    // Pointer to Kernel allocation index links
+    pStateHeap->pKernelAllocNode = (PRENDERHAL_KRN_ALLOC_NODE) ptr;
+    ptr += MOS_ALIGN_CEIL(pSettings->iKernelCount * sizeof(RENDERHAL_KRN_ALLOC_NODE), 16);
+
     // Pointer to Media State allocations
     pStateHeap->pMediaStates = (PRENDERHAL_MEDIA_STATE) ptr;
     ptr += MOS_ALIGN_CEIL(pSettings->iMediaStateHeaps * mediaStateSize, 16);
@@ -1903,426 +1896,6 @@ finish:
     return eStatus;
 }
 
-//!
-//! \brief    Load Kernel
-//! \details  Load a kernel from cache into GSH; searches for unused space in 
-//!           the kernel heap; deallocates kernels identified as no longer in use.
-//! \param    PRENDERHAL_INTERFACE pRenderHal
-//!           [in] Pointer to Hardware Interface Structure
-//! \param    PCRENDERHAL_KERNEL_PARAM pParameters
-//!           [in] Pointer to Kernel Parameters
-//! \param    PMHW_KERNEL_PARAMS pKernel
-//!           [in] Pointer to Kernel entry
-//! \param    Kdll_CacheEntry pKernelEntry
-//!           [in] The cache entry pointer maintaining the load status.
-//!                For cache entries from local variable,
-//!                set it to nullptr to avoid memory corruption
-//! \return   int32_t
-//!           Index to a kernel allocation index
-//!           -1 if invalid parameters, no available space and no
-//!            deallocation possible
-//!
-int32_t RenderHal_LoadKernel(
-    PRENDERHAL_INTERFACE       pRenderHal,
-    PCRENDERHAL_KERNEL_PARAM   pParameters,
-    PMHW_KERNEL_PARAM          pKernel,
-    Kdll_CacheEntry            *pKernelEntry)
-{
-    PRENDERHAL_STATE_HEAP       pStateHeap;
-    PRENDERHAL_KRN_ALLOCATION   pKernelAllocation;
-
-    int32_t iKernelAllocationID;    // Kernel allocation ID in GSH
-    int32_t iKernelCacheID;         // Kernel cache ID
-    int32_t iKernelUniqueID;        // Kernel unique ID
-    void    *pKernelPtr;
-    int32_t iKernelSize;
-    int32_t iSearchIndex;
-    int32_t iMaxKernels;            // Max number of kernels allowed in GSH
-    uint32_t dwOffset;
-    int32_t iSize;
-    MOS_STATUS eStatus;
-
-    iKernelAllocationID = RENDERHAL_KERNEL_LOAD_FAIL;
-    eStatus             = MOS_STATUS_SUCCESS;
-
-    MHW_RENDERHAL_CHK_NULL(pRenderHal);
-    MHW_RENDERHAL_CHK_NULL(pRenderHal->pStateHeap);
-    MHW_RENDERHAL_CHK_NULL(pRenderHal->pStateHeap->pKernelAllocation);
-    MHW_RENDERHAL_CHK_NULL(pParameters);
-    MHW_RENDERHAL_CHK_NULL(pKernel);
-
-    pStateHeap          = pRenderHal->pStateHeap;
-
-    // Validate parameters
-    if (pStateHeap->bGshLocked == false ||
-        pKernel->iSize == 0)
-    {
-        eStatus = MOS_STATUS_INVALID_PARAMETER;
-        MHW_RENDERHAL_NORMALMESSAGE("Failed to load kernel - invalid parameters.");
-        goto finish;
-    }
-
-    // Kernel parameters
-    pKernelPtr      = pKernel->pBinary;
-    iKernelSize     = pKernel->iSize;
-    iKernelUniqueID = pKernel->iKUID;
-    iKernelCacheID  = pKernel->iKCID;
-
-    // Check if kernel is already loaded; Search free allocation index
-    iSearchIndex = -1;
-    iMaxKernels  = pRenderHal->StateHeapSettings.iKernelCount;
-    pKernelAllocation = pStateHeap->pKernelAllocation;
-    for (iKernelAllocationID = 0;
-         iKernelAllocationID < iMaxKernels;
-         iKernelAllocationID++, pKernelAllocation++)
-    {
-        if (pKernelAllocation->iKUID == iKernelUniqueID &&
-            pKernelAllocation->iKCID == iKernelCacheID)
-        {
-            break;
-        }
-
-        if (iSearchIndex < 0 &&
-            pKernelAllocation->dwFlags == RENDERHAL_KERNEL_ALLOCATION_FREE)
-        {
-            iSearchIndex = iKernelAllocationID;
-        }
-    }
-
-    // The kernel size to be dumped in oca buffer.
-    pStateHeap->iKernelUsedForDump = iKernelSize;
-
-    // Kernel already loaded: refresh timer; return allocation index
-    if (iKernelAllocationID < iMaxKernels)
-    {
-        // To reload the kernel forcibly if needed
-        if (pKernel->bForceReload)
-        {
-            dwOffset = pKernelAllocation->dwOffset;
-            MOS_SecureMemcpy(pStateHeap->pIshBuffer + dwOffset, iKernelSize, pKernelPtr, iKernelSize);
-
-            pKernel->bForceReload = false;
-        }
-        goto finish;
-    }
-
-    // Simple allocation: allocation index available, space available
-    if ((iSearchIndex >= 0) &&
-        (pStateHeap->iKernelUsed + iKernelSize <= pStateHeap->iKernelSize))
-    {
-        // Allocate kernel at the end of the heap
-        iKernelAllocationID = iSearchIndex;
-        pKernelAllocation   = &(pStateHeap->pKernelAllocation[iSearchIndex]);
-
-        // Allocate block from the end of the heap
-        dwOffset = pStateHeap->dwKernelBase + pStateHeap->iKernelUsed;
-        iSize    = MOS_ALIGN_CEIL(iKernelSize, pRenderHal->StateHeapSettings.iKernelBlockSize);
-
-        // Update heap
-        pStateHeap->iKernelUsed += iSize;
-
-        // Load kernel
-        goto loadkernel;
-    }
-
-    // Search block from deallocated entry
-    if (iSearchIndex >= 0)
-    {
-        int32_t iMinSize = 0;
-
-        iSearchIndex = -1;
-        pKernelAllocation = pStateHeap->pKernelAllocation;
-        for (iKernelAllocationID = 0;
-             iKernelAllocationID < iMaxKernels;
-             iKernelAllocationID++, pKernelAllocation++)
-        {
-            // Skip allocated/empty entries
-            if (pKernelAllocation->dwFlags != RENDERHAL_KERNEL_ALLOCATION_FREE ||
-                pKernelAllocation->iSize   == 0)
-            {
-                continue;
-            }
-
-            // Allocate minimum available block
-            if (pKernelAllocation->iSize >= iKernelSize)
-            {
-                if (iSearchIndex < 0 ||
-                    pKernelAllocation->iSize < iMinSize)
-                {
-                    iSearchIndex = iKernelAllocationID;
-                    iMinSize     = pKernelAllocation->iSize;
-                }
-            }
-        }
-    }
-
-    // Did not find block, try to deallocate a kernel not recently used
-    if (iSearchIndex < 0)
-    {
-        uint32_t dwOldest = 0;
-        uint32_t dwLastUsed;
-
-        // Search and deallocate least used kernel
-        pKernelAllocation = pStateHeap->pKernelAllocation;
-        for (iKernelAllocationID = 0;
-             iKernelAllocationID < iMaxKernels;
-             iKernelAllocationID++, pKernelAllocation++)
-        {
-            // Skip unused entries and entries that would not fit
-            // Skip kernels flagged as locked (cannot be automatically deallocated)
-            if (pKernelAllocation->dwFlags == RENDERHAL_KERNEL_ALLOCATION_FREE ||
-                pKernelAllocation->dwFlags == RENDERHAL_KERNEL_ALLOCATION_LOCKED ||
-                pKernelAllocation->iSize < iKernelSize)
-            {
-                continue;
-            }
-
-            // Check if kernel may be replaced (not in use by GPU)
-            if ((int32_t)(pStateHeap->dwSyncTag - pKernelAllocation->dwSync) < 0)
-            {
-                continue;
-            }
-
-            // Find kernel not used for the greater amount of time (measured in number of operations)
-            // Must not unload recently allocated kernels
-            dwLastUsed = (uint32_t)(pStateHeap->dwAccessCounter - pKernelAllocation->dwCount);
-            if (dwLastUsed > dwOldest)
-            {
-                iSearchIndex = iKernelAllocationID;
-                dwOldest     = dwLastUsed;
-            }
-        }
-
-        // Did not found any entry for deallocation
-        if (iSearchIndex < 0)
-        {
-            MHW_RENDERHAL_NORMALMESSAGE("Failed to load kernel - no space available in GSH.");
-            iKernelAllocationID = RENDERHAL_KERNEL_LOAD_FAIL;
-            goto finish;
-        }
-
-        // Free kernel entry and states associated with the kernel (if any)
-        if (pRenderHal->pfnUnloadKernel(pRenderHal, iSearchIndex) != MOS_STATUS_SUCCESS)
-        {
-            MHW_RENDERHAL_NORMALMESSAGE("Failed to load kernel - no space available in GSH.");
-            iKernelAllocationID = RENDERHAL_KERNEL_LOAD_FAIL;
-            goto finish;
-        }
-    }
-
-    // Allocate the entry
-    iKernelAllocationID = iSearchIndex;
-    pKernelAllocation   = &(pStateHeap->pKernelAllocation[iSearchIndex]);
-
-    dwOffset = pKernelAllocation->dwOffset;
-    iSize    = pKernelAllocation->iSize;
-
-loadkernel:
-    // Allocate kernel
-    pKernelAllocation->iKID            = -1;
-    pKernelAllocation->iKUID           = iKernelUniqueID;
-    pKernelAllocation->iKCID           = iKernelCacheID;
-    pKernelAllocation->dwSync          = 0;
-    FrameTrackerTokenFlat_Clear(&pKernelAllocation->trackerToken);
-    pKernelAllocation->dwOffset        = dwOffset;
-    pKernelAllocation->iSize           = iSize;
-    pKernelAllocation->dwFlags         = RENDERHAL_KERNEL_ALLOCATION_USED;
-    pKernelAllocation->dwCount         = 0;  // will be updated by "TouchKernel"
-    pKernelAllocation->Params          = *pParameters;
-    pKernelAllocation->pKernelEntry    = pKernelEntry;
-    pKernelAllocation->iAllocIndex     = iKernelAllocationID;
-
-    // Copy kernel data
-    MOS_SecureMemcpy(pStateHeap->pIshBuffer + dwOffset, iKernelSize, pKernelPtr, iKernelSize);
-    if (iKernelSize < iSize)
-    {
-        MOS_ZeroMemory(pStateHeap->pIshBuffer + dwOffset + iKernelSize, iSize - iKernelSize);
-    }
-
-finish:
-    if (iKernelAllocationID != RENDERHAL_KERNEL_LOAD_FAIL)
-    {
-        // Update kernel usage
-        pRenderHal->pfnTouchKernel(pRenderHal, iKernelAllocationID);
-
-        // Increment reference counter
-        if (pKernelEntry)
-        {
-            pKernelEntry->dwLoaded = 1;
-        }
-        pRenderHal->iKernelAllocationID = iKernelAllocationID;
-    }
-
-    // Return kernel allocation index
-    return iKernelAllocationID;
-}
-
-//!
-//! \brief    Unload Kernel
-//! \details  Unload a kernel from GSH, free kernel heap space
-//!           Notify that the kernel has been unloaded (for tracking)
-//! \param    PRENDERHAL_INTERFACE pRenderHal
-//!           [in] Pointer to Hardware Interface Structure
-//! \param    int32_t iKernelAllocationID
-//!           [in] Kernel allocation index in GSH
-//! \return   MOS_STATUS
-//!           MOS_STATUS_SUCCESS    if success
-//!           others                if invalid parameters or if kernel cannot be unloaded
-//!
-MOS_STATUS RenderHal_UnloadKernel(
-    PRENDERHAL_INTERFACE pRenderHal,
-    int32_t              iKernelAllocationID)
-{
-    PRENDERHAL_STATE_HEAP       pStateHeap;
-    PRENDERHAL_KRN_ALLOCATION   pKernelAllocation;
-    MOS_STATUS                  eStatus;
-
-    //---------------------------------------
-    MHW_RENDERHAL_CHK_NULL(pRenderHal);
-    MHW_RENDERHAL_CHK_NULL(pRenderHal->pStateHeap);
-    MHW_RENDERHAL_CHK_NULL((void*)(iKernelAllocationID >= 0));
-    //---------------------------------------
-
-    eStatus    = MOS_STATUS_UNKNOWN;
-    pStateHeap = pRenderHal->pStateHeap;
-
-    //---------------------------------------
-    MHW_RENDERHAL_CHK_NULL(pStateHeap->pKernelAllocation);
-    MHW_RENDERHAL_ASSERT(iKernelAllocationID < pRenderHal->StateHeapSettings.iKernelCount);
-    //---------------------------------------
-
-    pKernelAllocation = &(pStateHeap->pKernelAllocation[iKernelAllocationID]);
-
-    if (pKernelAllocation->dwFlags == RENDERHAL_KERNEL_ALLOCATION_FREE)
-    {
-        goto finish;
-    }
-
-    // Update Sync tags
-    MHW_RENDERHAL_CHK_STATUS(pRenderHal->pfnRefreshSync(pRenderHal));
-
-    // Check if kernel may be unloaded
-    if ((int32_t)(pStateHeap->dwSyncTag - pKernelAllocation->dwSync) < 0)
-    {
-        goto finish;
-    }
-
-    // Unload kernel
-    if (pKernelAllocation->pKernelEntry)
-    {
-        pKernelAllocation->pKernelEntry->dwLoaded = 0;
-    }
-
-    // Release kernel entry (Offset/size may be used for reallocation)
-    pKernelAllocation->iKID             = -1;
-    pKernelAllocation->iKUID            = -1;
-    pKernelAllocation->iKCID            = -1;
-    pKernelAllocation->dwSync           = 0;
-    FrameTrackerTokenFlat_Clear(&pKernelAllocation->trackerToken);
-    pKernelAllocation->dwFlags          = RENDERHAL_KERNEL_ALLOCATION_FREE;
-    pKernelAllocation->dwCount          = 0;
-    pKernelAllocation->pKernelEntry     = nullptr;
-
-    eStatus = MOS_STATUS_SUCCESS;
-
-finish:
-    return eStatus;
-}
-
-//!
-//! \brief    Touch Kernel
-//! \details  Touch Kernel
-//! \param    PRENDERHAL_INTERFACE pRenderHal
-//!           [in] Pointer to Hardware Interface Structure
-//! \param    int32_t iKernelAllocationID
-//!           [in] Kernel Allocation ID
-//! \return   void
-//!
-void RenderHal_TouchKernel(
-    PRENDERHAL_INTERFACE pRenderHal,
-    int32_t             iKernelAllocationID)
-{
-    PRENDERHAL_STATE_HEAP       pStateHeap;
-    PRENDERHAL_KRN_ALLOCATION   pKernelAllocation;
-
-    pStateHeap = (pRenderHal) ? pRenderHal->pStateHeap : nullptr;
-    if (pStateHeap == nullptr ||
-        pStateHeap->pKernelAllocation == nullptr ||
-        iKernelAllocationID < 0 ||
-        iKernelAllocationID >= pRenderHal->StateHeapSettings.iKernelCount)
-    {
-        return;
-    }
-
-    // Update usage
-    pKernelAllocation = &(pStateHeap->pKernelAllocation[iKernelAllocationID]);
-    if (pKernelAllocation->dwFlags != RENDERHAL_KERNEL_ALLOCATION_FREE &&
-        pKernelAllocation->dwFlags != RENDERHAL_KERNEL_ALLOCATION_LOCKED)
-    {
-        pKernelAllocation->dwCount = pStateHeap->dwAccessCounter++;
-    }
-
-    // Set sync tag, for deallocation control
-    pKernelAllocation->dwSync = pStateHeap->dwNextTag;
-}
-
-//!
-//! \brief    Reset Kernels
-//! \details  Reset Kernels
-//! \param    PRENDERHAL_INTERFACE pRenderHal
-//!           [in] Pointer to Hardware Interface Structure
-//! \return   void
-//!
-void RenderHal_ResetKernels(
-    PRENDERHAL_INTERFACE pRenderHal)
-{
-    PRENDERHAL_STATE_HEAP       pStateHeap;
-    PRENDERHAL_KRN_ALLOCATION   pKernelAllocation;
-    int32_t                     i;
-    MOS_STATUS                  eStatus = MOS_STATUS_UNKNOWN;
-
-    //---------------------------------------
-    MHW_RENDERHAL_CHK_NULL(pRenderHal);
-    MHW_RENDERHAL_CHK_NULL(pRenderHal->pStateHeap);
-    MHW_RENDERHAL_CHK_NULL(pRenderHal->pStateHeap->pKernelAllocation);
-    //---------------------------------------
-
-    pStateHeap    = pRenderHal->pStateHeap;
-
-    // Unload kernels and notify HAL layer
-    pKernelAllocation = pStateHeap->pKernelAllocation;
-    for (i = 0; i< pRenderHal->StateHeapSettings.iKernelCount; i++, pKernelAllocation++)
-    {
-        // Unload kernel
-        if (pKernelAllocation->pKernelEntry)
-        {
-            pKernelAllocation->pKernelEntry->dwLoaded = 0;
-        }
-
-        pKernelAllocation->iKID             = -1;
-        pKernelAllocation->iKUID            = -1;
-        pKernelAllocation->iKCID            = -1;
-        pKernelAllocation->dwSync           = 0;
-        FrameTrackerTokenFlat_Clear(&pKernelAllocation->trackerToken);
-        pKernelAllocation->dwOffset         = 0;
-        pKernelAllocation->iSize            = 0;
-        pKernelAllocation->dwFlags          = RENDERHAL_KERNEL_ALLOCATION_FREE;
-        pKernelAllocation->dwCount          = 0;
-        pKernelAllocation->pKernelEntry     = nullptr;
-        pKernelAllocation->iAllocIndex      = i;
-        pKernelAllocation->Params           = g_cRenderHal_InitKernelParams;
-    }
-
-    // Free Kernel Heap
-    pStateHeap->dwAccessCounter = 0;
-    pStateHeap->iKernelSize = pRenderHal->StateHeapSettings.iKernelHeapSize;
-    pStateHeap->iKernelUsed = 0;
-    pStateHeap->iKernelUsedForDump = 0;
-
-finish:
-    return;
-}
-
 //!
 //! \brief    Get Kernel Offset
 //! \details  Get Kernel Offset
@@ -0,0 +1,425 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     renderhal_kernel.cpp
+//! \brief    Kernel heap management of the render state heap for VP and CM
+//! \details  Loads, unloads and evicts kernels in the instruction state heap.
+//!           Kept apart from renderhal.cpp so devult can link it alone.
+//!
+
+#include "renderhal.h"
+#include "renderhal_kernel_index.h"
+#include "hal_kerneldll_next.h"
+
+const RENDERHAL_KERNEL_PARAM g_cRenderHal_InitKernelParams =
+{
+    0,                                  // GRF_Count;
+    0,                                  // BT_Count;
+    0,                                  // Sampler_Count
+    0,                                  // Thread_Count
+    0,                                  // GRF_Start_Register
+    0,                                  // CURBE_Length
+    0,                                  // block_width
+    0,                                  // block_height
+    0,                                  // blocks_x
+    0                                   // blocks_y
+};
+
+//!
+//! \brief    Load Kernel
+//! \details  Load a kernel from cache into GSH; searches for unused space in 
+//!           the kernel heap; deallocates kernels identified as no longer in use.
+//! \param    PRENDERHAL_INTERFACE pRenderHal
+//!           [in] Pointer to Hardware Interface Structure
+//! \param    PCRENDERHAL_KERNEL_PARAM pParameters
+//!           [in] Pointer to Kernel Parameters
+//! \param    PMHW_KERNEL_PARAMS pKernel
+//!           [in] Pointer to Kernel entry
+//! \param    Kdll_CacheEntry pKernelEntry
+//!           [in] The cache entry pointer maintaining the load status.
+//!                For cache entries from local variable,
+//!                set it to nullptr to avoid memory corruption
+//! \return   int32_t
+//!           Index to a kernel allocation index
+//!           -1 if invalid parameters, no available space and no
+//!            deallocation possible
+//!
+int32_t RenderHal_LoadKernel(
+    PRENDERHAL_INTERFACE       pRenderHal,
+    PCRENDERHAL_KERNEL_PARAM   pParameters,
+    PMHW_KERNEL_PARAM          pKernel,
+    Kdll_CacheEntry            *pKernelEntry)
+{
+    PRENDERHAL_STATE_HEAP       pStateHeap;
+    PRENDERHAL_KRN_ALLOCATION   pKernelAllocation;
+
+    int32_t iKernelAllocationID;    // Kernel allocation ID in GSH
+    int32_t iKernelCacheID;         // Kernel cache ID
+    int32_t iKernelUniqueID;        // Kernel unique ID
+    void    *pKernelPtr;
+    int32_t iKernelSize;
+    int32_t iSearchIndex;
+    uint32_t dwOffset;
+    int32_t iSize;
+    MOS_STATUS eStatus;
+
+    iKernelAllocationID = RENDERHAL_KERNEL_LOAD_FAIL;
+    eStatus             = MOS_STATUS_SUCCESS;
+
+    MHW_RENDERHAL_CHK_NULL(pRenderHal);
+    MHW_RENDERHAL_CHK_NULL(pRenderHal->pStateHeap);
+    MHW_RENDERHAL_CHK_NULL(pRenderHal->pStateHeap->pKernelAllocation);
+    MHW_RENDERHAL_CHK_NULL(pRenderHal->pStateHeap->pKernelAllocNode);
+    MHW_RENDERHAL_CHK_NULL(pParameters);
+    MHW_RENDERHAL_CHK_NULL(pKernel);
+
+    pStateHeap          = pRenderHal->pStateHeap;
+
+    // Validate parameters
+    if (pStateHeap->bGshLocked == false ||
+        pKernel->iSize == 0)
+    {
+        eStatus = MOS_STATUS_INVALID_PARAMETER;
+        MHW_RENDERHAL_NORMALMESSAGE("Failed to load kernel - invalid parameters.");
+        goto finish;
+    }
+
+    // Kernel parameters
+    pKernelPtr      = pKernel->pBinary;
+    iKernelSize     = pKernel->iSize;
+    iKernelUniqueID = pKernel->iKUID;
+    iKernelCacheID  = pKernel->iKCID;
+
+    // Check if kernel is already loaded
+    iKernelAllocationID = RenderHal_FindKernelAllocation(pStateHeap, iKernelUniqueID, iKernelCacheID);
+
+    // The kernel size to be dumped in oca buffer.
+    pStateHeap->iKernelUsedForDump = iKernelSize;
+
+    // Kernel already loaded: refresh timer; return allocation index
+    if (iKernelAllocationID != RENDERHAL_KERNEL_INDEX_NONE)
+    {
+        pKernelAllocation = &(pStateHeap->pKernelAllocation[iKernelAllocationID]);
+
+        // To reload the kernel forcibly if needed
+        if (pKernel->bForceReload)
+        {
+            dwOffset = pKernelAllocation->dwOffset;
+            MOS_SecureMemcpy(pStateHeap->pIshBuffer + dwOffset, iKernelSize, pKernelPtr, iKernelSize);
+
+            pKernel->bForceReload = false;
+        }
+        goto finish;
+    }
+
+    // Simple allocation: allocation index available, space available
+    iSearchIndex = pStateHeap->KernelIndexList[RENDERHAL_KERNEL_LIST_EMPTY].iHead;
+    if ((iSearchIndex >= 0) &&
+        (pStateHeap->iKernelUsed + iKernelSize <= pStateHeap->iKernelSize))
+    {
+        goto allocateblock;
+    }
+
+    // Search block from deallocated entry
+    iSearchIndex = RenderHal_FindKernelBlock(pStateHeap, iKernelSize);
+
+    // No block fits, space available: reallocate a deallocated entry at the end of the heap
+    if (iSearchIndex < 0 &&
+        pStateHeap->KernelIndexList[RENDERHAL_KERNEL_LIST_FREE].iHead >= 0 &&
+        pStateHeap->iKernelUsed + iKernelSize <= pStateHeap->iKernelSize)
+    {
+        iSearchIndex = pStateHeap->KernelIndexList[RENDERHAL_KERNEL_LIST_FREE].iHead;
+        goto allocateblock;
+    }
+
+    // Did not find block, try to deallocate a kernel not recently used
+    if (iSearchIndex < 0)
+    {
+        // Search least recently used kernel not in use by GPU
+        iSearchIndex = RenderHal_FindKernelToUnload(pStateHeap, iKernelSize);
+
+        // Did not found any entry for deallocation
+        if (iSearchIndex < 0)
+        {
+            MHW_RENDERHAL_NORMALMESSAGE("Failed to load kernel - no space available in GSH.");
+            iKernelAllocationID = RENDERHAL_KERNEL_LOAD_FAIL;
+            goto finish;
+        }
+
+        // Free kernel entry and states associated with the kernel (if any)
+        if (pRenderHal->pfnUnloadKernel(pRenderHal, iSearchIndex) != MOS_STATUS_SUCCESS)
+        {
+            MHW_RENDERHAL_NORMALMESSAGE("Failed to load kernel - no space available in GSH.");
+            iKernelAllocationID = RENDERHAL_KERNEL_LOAD_FAIL;
+            goto finish;
+        }
+    }
+
+    // Allocate the entry
+    iKernelAllocationID = iSearchIndex;
+    pKernelAllocation   = &(pStateHeap->pKernelAllocation[iSearchIndex]);
+
+    dwOffset = pKernelAllocation->dwOffset;
+    iSize    = pKernelAllocation->iSize;
+    goto loadkernel;
+
+allocateblock:
+    // Allocate kernel at the end of the heap
+    iKernelAllocationID = iSearchIndex;
+    pKernelAllocation   = &(pStateHeap->pKernelAllocation[iSearchIndex]);
+
+    // Allocate block from the end of the heap
+    dwOffset = pStateHeap->dwKernelBase + pStateHeap->iKernelUsed;
+    iSize    = MOS_ALIGN_CEIL(iKernelSize, pRenderHal->StateHeapSettings.iKernelBlockSize);
+
+    // Update heap
+    pStateHeap->iKernelUsed += iSize;
+
+loadkernel:
+    // Allocate kernel
+    pKernelAllocation->iKID            = -1;
+    pKernelAllocation->iKUID           = iKernelUniqueID;
+    pKernelAllocation->iKCID           = iKernelCacheID;
+    pKernelAllocation->dwSync          = 0;
+    FrameTrackerTokenFlat_Clear(&pKernelAllocation->trackerToken);
+    pKernelAllocation->dwOffset        = dwOffset;
+    pKernelAllocation->iSize           = iSize;
+    pKernelAllocation->dwFlags         = RENDERHAL_KERNEL_ALLOCATION_USED;
+    pKernelAllocation->dwCount         = 0;  // will be updated by "TouchKernel"
+    pKernelAllocation->Params          = *pParameters;
+    pKernelAllocation->pKernelEntry    = pKernelEntry;
+    pKernelAllocation->iAllocIndex     = iKernelAllocationID;
+
+    // Index the entry; "TouchKernel" moves it to the most recently used end
+    RenderHal_HashKernelAllocation(pStateHeap, iKernelAllocationID, true);
+    RenderHal_LinkKernelAllocation(pStateHeap, iKernelAllocationID, RENDERHAL_KERNEL_LIST_LRU);
+
+    // Copy kernel data
+    MOS_SecureMemcpy(pStateHeap->pIshBuffer + dwOffset, iKernelSize, pKernelPtr, iKernelSize);
+    if (iKernelSize < iSize)
+    {
+        MOS_ZeroMemory(pStateHeap->pIshBuffer + dwOffset + iKernelSize, iSize - iKernelSize);
+    }
+
+finish:
+    if (iKernelAllocationID != RENDERHAL_KERNEL_LOAD_FAIL)
+    {
+        // Update kernel usage
+        pRenderHal->pfnTouchKernel(pRenderHal, iKernelAllocationID);
+
+        // Increment reference counter
+        if (pKernelEntry)
+        {
+            pKernelEntry->dwLoaded = 1;
+        }
+        pRenderHal->iKernelAllocationID = iKernelAllocationID;
+    }
+
+    // Return kernel allocation index
+    return iKernelAllocationID;
+}
+
+//!
+//! \brief    Unload Kernel
+//! \details  Unload a kernel from GSH, free kernel heap space
+//!           Notify that the kernel has been unloaded (for tracking)
+//! \param    PRENDERHAL_INTERFACE pRenderHal
+//!           [in] Pointer to Hardware Interface Structure
+//! \param    int32_t iKernelAllocationID
+//!           [in] Kernel allocation index in GSH
+//! \return   MOS_STATUS
+//!           MOS_STATUS_SUCCESS    if success
+//!           others                if invalid parameters or if kernel cannot be unloaded
+//!
+MOS_STATUS RenderHal_UnloadKernel(
+    PRENDERHAL_INTERFACE pRenderHal,
+    int32_t              iKernelAllocationID)
+{
+    PRENDERHAL_STATE_HEAP       pStateHeap;
+    PRENDERHAL_KRN_ALLOCATION   pKernelAllocation;
+    MOS_STATUS                  eStatus;
+
+    //---------------------------------------
+    MHW_RENDERHAL_CHK_NULL(pRenderHal);
+    MHW_RENDERHAL_CHK_NULL(pRenderHal->pStateHeap);
+    MHW_RENDERHAL_CHK_NULL((void*)(iKernelAllocationID >= 0));
+    //---------------------------------------
+
+    eStatus    = MOS_STATUS_UNKNOWN;
+    pStateHeap = pRenderHal->pStateHeap;
+
+    //---------------------------------------
+    MHW_RENDERHAL_CHK_NULL(pStateHeap->pKernelAllocation);
+    MHW_RENDERHAL_ASSERT(iKernelAllocationID < pRenderHal->StateHeapSettings.iKernelCount);
+    //---------------------------------------
+
+    pKernelAllocation = &(pStateHeap->pKernelAllocation[iKernelAllocationID]);
+
+    if (pKernelAllocation->dwFlags == RENDERHAL_KERNEL_ALLOCATION_FREE)
+    {
+        goto finish;
+    }
+
+    // Update Sync tags
+    MHW_RENDERHAL_CHK_STATUS(pRenderHal->pfnRefreshSync(pRenderHal));
+
+    // Check if kernel may be unloaded
+    if ((int32_t)(pStateHeap->dwSyncTag - pKernelAllocation->dwSync) < 0)
+    {
+        goto finish;
+    }
+
+    // Unload kernel
+    if (pKernelAllocation->pKernelEntry)
+    {
+        pKernelAllocation->pKernelEntry->dwLoaded = 0;
+    }
+
+    // Release kernel entry (Offset/size may be used for reallocation)
+    pKernelAllocation->iKID             = -1;
+    pKernelAllocation->iKUID            = -1;
+    pKernelAllocation->iKCID            = -1;
+    pKernelAllocation->dwSync           = 0;
+    FrameTrackerTokenFlat_Clear(&pKernelAllocation->trackerToken);
+    pKernelAllocation->dwFlags          = RENDERHAL_KERNEL_ALLOCATION_FREE;
+    pKernelAllocation->dwCount          = 0;
+    pKernelAllocation->pKernelEntry     = nullptr;
+
+    // Keep the block available for reallocation
+    if (pStateHeap->pKernelAllocNode)
+    {
+        RenderHal_HashKernelAllocation(pStateHeap, iKernelAllocationID, false);
+        RenderHal_LinkKernelAllocation(pStateHeap, iKernelAllocationID,
+            (pKernelAllocation->iSize > 0) ? RENDERHAL_KERNEL_LIST_FREE : RENDERHAL_KERNEL_LIST_EMPTY);
+    }
+
+    eStatus = MOS_STATUS_SUCCESS;
+
+finish:
+    return eStatus;
+}
+
+//!
+//! \brief    Touch Kernel
+//! \details  Touch Kernel
+//! \param    PRENDERHAL_INTERFACE pRenderHal
+//!           [in] Pointer to Hardware Interface Structure
+//! \param    int32_t iKernelAllocationID
+//!           [in] Kernel Allocation ID
+//! \return   void
+//!
+void RenderHal_TouchKernel(
+    PRENDERHAL_INTERFACE pRenderHal,
+    int32_t             iKernelAllocationID)
+{
+    PRENDERHAL_STATE_HEAP       pStateHeap;
+    PRENDERHAL_KRN_ALLOCATION   pKernelAllocation;
+
+    pStateHeap = (pRenderHal) ? pRenderHal->pStateHeap : nullptr;
+    if (pStateHeap == nullptr ||
+        pStateHeap->pKernelAllocation == nullptr ||
+        iKernelAllocationID < 0 ||
+        iKernelAllocationID >= pRenderHal->StateHeapSettings.iKernelCount)
+    {
+        return;
+    }
+
+    // Update usage
+    pKernelAllocation = &(pStateHeap->pKernelAllocation[iKernelAllocationID]);
+    if (pKernelAllocation->dwFlags != RENDERHAL_KERNEL_ALLOCATION_FREE &&
+        pKernelAllocation->dwFlags != RENDERHAL_KERNEL_ALLOCATION_LOCKED)
+    {
+        pKernelAllocation->dwCount = pStateHeap->dwAccessCounter++;
+
+        // Move to the most recently used end
+        if (pStateHeap->pKernelAllocNode)
+        {
+            RenderHal_LinkKernelAllocation(pStateHeap, iKernelAllocationID, RENDERHAL_KERNEL_LIST_LRU);
+        }
+    }
+
+    // Set sync tag, for deallocation control
+    pKernelAllocation->dwSync = pStateHeap->dwNextTag;
+}
+
+//!
+//! \brief    Reset Kernels
+//! \details  Reset Kernels
+//! \param    PRENDERHAL_INTERFACE pRenderHal
+//!           [in] Pointer to Hardware Interface Structure
+//! \return   void
+//!
+void RenderHal_ResetKernels(
+    PRENDERHAL_INTERFACE pRenderHal)
+{
+    PRENDERHAL_STATE_HEAP       pStateHeap;
+    PRENDERHAL_KRN_ALLOCATION   pKernelAllocation;
+    int32_t                     i;
+    MOS_STATUS                  eStatus = MOS_STATUS_UNKNOWN;
+
+    //---------------------------------------
+    MHW_RENDERHAL_CHK_NULL(pRenderHal);
+    MHW_RENDERHAL_CHK_NULL(pRenderHal->pStateHeap);
+    MHW_RENDERHAL_CHK_NULL(pRenderHal->pStateHeap->pKernelAllocation);
+    //---------------------------------------
+
+    pStateHeap    = pRenderHal->pStateHeap;
+
+    // Unload kernels and notify HAL layer
+    pKernelAllocation = pStateHeap->pKernelAllocation;
+    for (i = 0; i< pRenderHal->StateHeapSettings.iKernelCount; i++, pKernelAllocation++)
+    {
+        // Unload kernel
+        if (pKernelAllocation->pKernelEntry)
+        {
+            pKernelAllocation->pKernelEntry->dwLoaded = 0;
+        }
+
+        pKernelAllocation->iKID             = -1;
+        pKernelAllocation->iKUID            = -1;
+        pKernelAllocation->iKCID            = -1;
+        pKernelAllocation->dwSync           = 0;
+        FrameTrackerTokenFlat_Clear(&pKernelAllocation->trackerToken);
+        pKernelAllocation->dwOffset         = 0;
+        pKernelAllocation->iSize            = 0;
+        pKernelAllocation->dwFlags          = RENDERHAL_KERNEL_ALLOCATION_FREE;
+        pKernelAllocation->dwCount          = 0;
+        pKernelAllocation->pKernelEntry     = nullptr;
+        pKernelAllocation->iAllocIndex      = i;
+        pKernelAllocation->Params           = g_cRenderHal_InitKernelParams;
+    }
+
+    // Reset kernel allocation index
+    if (pStateHeap->pKernelAllocNode)
+    {
+        RenderHal_ResetKernelIndex(pStateHeap, pRenderHal->StateHeapSettings.iKernelCount);
+    }
+
+    // Free Kernel Heap
+    pStateHeap->dwAccessCounter = 0;
+    pStateHeap->iKernelSize = pRenderHal->StateHeapSettings.iKernelHeapSize;
+    pStateHeap->iKernelUsed = 0;
+    pStateHeap->iKernelUsedForDump = 0;
+
+finish:
+    return;
+}
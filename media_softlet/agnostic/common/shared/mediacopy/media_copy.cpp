@@ -27,6 +27,7 @@
 
 #include "media_copy.h"
 #include "media_copy_common.h"
+#include "media_copy_engine_scheduler.h"
 #include "vp_dumper.h"
 #include "media_interfaces_mhw.h"
 #include "mhw_cp_interface.h"
@@ -55,6 +56,8 @@ MediaCopyBaseState::~MediaCopyBaseState()
         m_inUseGPUMutex = nullptr;
     }
 
+    MOS_Delete(m_engineScheduler);
+
    #if (_DEBUG || _RELEASE_INTERNAL)
     if (m_surfaceDumper != nullptr)
     {
@@ -79,6 +82,12 @@ MOS_STATUS MediaCopyBaseState::Initialize(PMOS_INTERFACE osInterface)
         MCPY_CHK_NULL_RETURN(m_inUseGPUMutex);
     }
 
+    if (m_engineScheduler == nullptr)
+    {
+        m_engineScheduler = MOS_New(MediaCopyEngineScheduler);
+        MCPY_CHK_NULL_RETURN(m_engineScheduler);
+    }
+
    #if (_DEBUG || _RELEASE_INTERNAL)
     if (m_surfaceDumper == nullptr)
     {
@@ -175,6 +184,15 @@ MOS_STATUS MediaCopyBaseState::CopyEnigneSelect(MCPY_METHOD preferMethod)
         case MCPY_METHOD_POWERSAVING:
             m_mcpyEngine = m_mcpyEngineCaps.engineBlt?MCPY_ENGINE_BLT:(m_mcpyEngineCaps.engineVebox?MCPY_ENGINE_VEBOX:MCPY_ENGINE_RENDER);
             break;
+        case MCPY_METHOD_LOADBALANCE:
+            // route to the engine which is projected to finish this copy first, fall back to balance order.
+            RefreshEngineLoad();
+            if (m_engineScheduler == nullptr ||
+                m_engineScheduler->SelectEngine(m_mcpyEngineCaps, m_mcpySrc.Size, m_mcpySrc.TileMode, m_mcpyDst.TileMode, m_mcpyEngine) != MOS_STATUS_SUCCESS)
+            {
+                m_mcpyEngine = m_mcpyEngineCaps.engineVebox?MCPY_ENGINE_VEBOX:(m_mcpyEngineCaps.engineBlt?MCPY_ENGINE_BLT:MCPY_ENGINE_RENDER);
+            }
+            break;
         default:
             break;
     }
@@ -182,6 +200,65 @@ MOS_STATUS MediaCopyBaseState::CopyEnigneSelect(MCPY_METHOD preferMethod)
     return MOS_STATUS_SUCCESS;
 }
 
+//!
+//! \brief    refresh engine load.
+//! \details  feed the in-flight submissions of the copy gpu contexts back to the engine scheduler.
+//! \param    none
+//! \return   void
+//!
+void MediaCopyBaseState::RefreshEngineLoad()
+{
+    // gpu context used by each copy engine, indexed by MCPY_ENGINE.
+    const MOS_GPU_CONTEXT engineGpuContext[MCPY_ENGINE_NUM] = {MOS_GPU_CONTEXT_VEBOX, MOS_GPU_CONTEXT_BLT, MOS_GPU_CONTEXT_COMPUTE};
+
+    if (m_engineScheduler == nullptr || m_osInterface == nullptr ||
+        m_osInterface->pfnGetGpuStatusTag == nullptr || m_osInterface->pfnGetGpuStatusSyncTag == nullptr)
+    {
+        return;
+    }
+
+    for (uint32_t i = 0; i < MCPY_ENGINE_NUM; i++)
+    {
+        MCPY_ENGINE engine = (MCPY_ENGINE)i;
+
+        // the gpu context only exists once media copy submitted to the engine.
+        if (!m_engineSubmitted[i])
+        {
+            continue;
+        }
+
+        // status tag is the next tag to be submitted, sync tag the last one the gpu completed.
+        uint32_t statusTag = m_osInterface->pfnGetGpuStatusTag(m_osInterface, engineGpuContext[i]);
+        uint32_t syncTag   = m_osInterface->pfnGetGpuStatusSyncTag(m_osInterface, engineGpuContext[i]);
+        int32_t  inFlight  = (int32_t)(statusTag - 1 - syncTag);
+
+        m_engineScheduler->UpdateEngineLoad(engine, inFlight > 0 ? (uint32_t)inFlight : 0);
+    }
+}
+
+//!
+//! \brief    query engine counters.
+//! \details  per engine copy count, bytes, in-flight submissions and projected busy time.
+//! \param    engine
+//!           [in] copy engine
+//! \param    counters
+//!           [out] reference of engine counters
+//! \return   MOS_STATUS
+//!           Return MOS_STATUS_SUCCESS if success, otherwise return failed.
+//!
+MOS_STATUS MediaCopyBaseState::QueryEngineCounters(MCPY_ENGINE engine, MCPY_ENGINE_COUNTERS &counters)
+{
+    MCPY_CHK_NULL_RETURN(m_engineScheduler);
+
+    if (engine >= MCPY_ENGINE_NUM)
+    {
+        return MOS_STATUS_INVALID_PARAMETER;
+    }
+
+    counters = m_engineScheduler->GetEngineCounters(engine);
+    return MOS_STATUS_SUCCESS;
+}
+
 //!
 //! \brief    surface copy func.
 //! \details  copy surface.
@@ -203,6 +280,7 @@ MOS_STATUS MediaCopyBaseState::SurfaceCopy(PMOS_RESOURCE src, PMOS_RESOURCE dst,
     m_mcpySrc.CpMode          = src->pGmmResInfo->GetSetCpSurfTag(false, 0)?MCPY_CPMODE_CP:MCPY_CPMODE_CLEAR;
     m_mcpySrc.TileMode        = ResDetails.TileType;
     m_mcpySrc.OsRes           = src;
+    m_mcpySrc.Size            = src->pGmmResInfo->GetSizeMainSurface();
     MCPY_NORMALMESSAGE("input surface's format %d, width %d; hight %d, pitch %d, tiledmode %d, mmc mode %d",
         ResDetails.Format, ResDetails.dwWidth, ResDetails.dwHeight, ResDetails.dwPitch, m_mcpySrc.TileMode, m_mcpySrc.CompressionMode);
 
@@ -212,6 +290,7 @@ MOS_STATUS MediaCopyBaseState::SurfaceCopy(PMOS_RESOURCE src, PMOS_RESOURCE dst,
     m_mcpyDst.CpMode          = dst->pGmmResInfo->GetSetCpSurfTag(false, 0)?MCPY_CPMODE_CP:MCPY_CPMODE_CLEAR;
     m_mcpyDst.TileMode        = ResDetails.TileType;
     m_mcpyDst.OsRes           = dst;
+    m_mcpyDst.Size            = dst->pGmmResInfo->GetSizeMainSurface();
     MCPY_NORMALMESSAGE("Output surface's format %d, width %d; hight %d, pitch %d, tiledmode %d, mmc mode %d",
         ResDetails.Format, ResDetails.dwWidth, ResDetails.dwHeight, ResDetails.dwPitch, m_mcpyDst.TileMode, m_mcpyDst.CompressionMode);
 
@@ -222,6 +301,12 @@ MOS_STATUS MediaCopyBaseState::SurfaceCopy(PMOS_RESOURCE src, PMOS_RESOURCE dst,
     CopyEnigneSelect(preferMethod);
 
     MCPY_CHK_STATUS_RETURN(TaskDispatch());
+    m_engineSubmitted[m_mcpyEngine] = true;
+
+    if (m_engineScheduler)
+    {
+        m_engineScheduler->AddCopy(m_mcpyEngine, m_mcpySrc.Size, m_mcpySrc.TileMode, m_mcpyDst.TileMode);
+    }
 
     return eStatus;
 }
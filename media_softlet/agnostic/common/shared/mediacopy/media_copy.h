@@ -38,6 +38,7 @@
 #include "mos_interface.h"
 class MhwInterfaces;
 class VpSurfaceDumper;
+class MediaCopyEngineScheduler;
 typedef struct VPHAL_SURFACE* PVPHAL_SURFACE;
 
 typedef struct _MCPY_ENGINE_CAPS
@@ -67,6 +68,7 @@ enum MCPY_METHOD
     MCPY_METHOD_POWERSAVING,  // use BCS engine
     MCPY_METHOD_PERFORMANCE,  // use EU to get the best perf.
     MCPY_METHOD_BALANCE,      // use vebox engine.
+    MCPY_METHOD_LOADBALANCE,  // use the engine with the earliest projected completion.
 };
 
 typedef struct _MCPY_STATE_PARAMS
@@ -76,8 +78,17 @@ typedef struct _MCPY_STATE_PARAMS
     MOS_TILE_TYPE         TileMode;           // linear, TILEY, TILE4
     MCPY_CPMODE           CpMode;             // CP content.
     bool                  bAuxSuface;
+    uint64_t              Size;               // main surface size in bytes
 }MCPY_STATE_PARAMS;
 
+typedef struct _MCPY_ENGINE_COUNTERS
+{
+    uint64_t              copyNum;            // copies routed to the engine
+    uint64_t              byteNum;            // bytes routed to the engine
+    uint32_t              inFlightNum;        // in-flight submissions reported by the last load update
+    uint64_t              projectedBusyUs;    // projected time until the engine drains
+}MCPY_ENGINE_COUNTERS;
+
 class MediaCopyBaseState
 {
 public:
@@ -159,6 +170,18 @@ public:
         return &m_mcpyEngineCaps;
     }
 
+    //!
+    //! \brief    query engine counters.
+    //! \details  per engine copy count, bytes, in-flight submissions and projected busy time.
+    //! \param    engine
+    //!           [in] copy engine
+    //! \param    counters
+    //!           [out] reference of engine counters
+    //! \return   MOS_STATUS
+    //!           Return MOS_STATUS_SUCCESS if success, otherwise return failed.
+    //!
+    MOS_STATUS QueryEngineCounters(MCPY_ENGINE engine, MCPY_ENGINE_COUNTERS &counters);
+
 protected:
 
     //!
@@ -226,6 +249,14 @@ protected:
     //!
     MOS_STATUS CopyEnigneSelect(MCPY_METHOD preferMethod);
 
+    //!
+    //! \brief    refresh engine load.
+    //! \details  feed the in-flight submissions of the copy gpu contexts back to the engine scheduler.
+    //! \param    none
+    //! \return   void
+    //!
+    void RefreshEngineLoad();
+
     //!
     //! \brief    use blt engie to do surface copy.
     //! \details  implementation media blt copy.
@@ -274,13 +305,16 @@ public:
     PMOS_INTERFACE      m_osInterface    = nullptr;
     MCPY_ENGINE_CAPS    m_mcpyEngineCaps = {1,1,1,1};
     MCPY_ENGINE         m_mcpyEngine     = MCPY_ENGINE_RENDER;
-    MCPY_STATE_PARAMS   m_mcpySrc        = {nullptr, MOS_MMC_DISABLED,MOS_TILE_LINEAR, MCPY_CPMODE_CLEAR, false}; // source surface.
-    MCPY_STATE_PARAMS   m_mcpyDst        = {nullptr, MOS_MMC_DISABLED,MOS_TILE_LINEAR, MCPY_CPMODE_CLEAR, false}; // destination surface.
+    MCPY_STATE_PARAMS   m_mcpySrc        = {nullptr, MOS_MMC_DISABLED,MOS_TILE_LINEAR, MCPY_CPMODE_CLEAR, false, 0}; // source surface.
+    MCPY_STATE_PARAMS   m_mcpyDst        = {nullptr, MOS_MMC_DISABLED,MOS_TILE_LINEAR, MCPY_CPMODE_CLEAR, false, 0}; // destination surface.
     bool                m_allowCPBltCopy  = false;  // allow cp call media copy only for output clear cases.
     VpSurfaceDumper     *m_surfaceDumper  = nullptr;
 
+    MediaCopyEngineScheduler *m_engineScheduler = nullptr; // per engine load tracking for MCPY_METHOD_LOADBALANCE.
+
 protected:
     PMOS_MUTEX           m_inUseGPUMutex = nullptr; // Mutex for in-use GPU context
+    bool                 m_engineSubmitted[MCPY_ENGINE_RENDER + 1] = {}; // engine gpu context created by a copy submission
 MEDIA_CLASS_DEFINE_END(MediaCopyBaseState)
 };
 #endif
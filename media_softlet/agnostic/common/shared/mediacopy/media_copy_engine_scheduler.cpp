@@ -0,0 +1,178 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     media_copy_engine_scheduler.cpp
+//! \brief    Load aware copy engine selection
+//! \details  Tracks the projected busy time of the vebox, blt and render engines and
+//!           routes each copy to the engine with the earliest projected completion.
+//!
+
+#include "media_copy_engine_scheduler.h"
+#include "mos_utilities.h"
+
+// Default cost model, indexed by MCPY_ENGINE. Measured order of magnitude on Gen12 class
+// parts; SetEngineModel() can refine them per platform.
+static const MCPY_ENGINE_MODEL g_mcpyDefaultEngineModel[MCPY_ENGINE_NUM] =
+{
+    // setupUs, bytesPerUs, tileConvertPercent, submissionUs
+    {  30,  8000, 100,  500 },  // MCPY_ENGINE_VEBOX, tiling convert is native
+    {  20,  6000,  60,  200 },  // MCPY_ENGINE_BLT
+    {  50, 12000, 100, 1000 },  // MCPY_ENGINE_RENDER
+};
+
+//!
+//! \brief    default clock of the projection.
+//! \details  MosGetTime() follows CLOCK_REALTIME, which jumps with wall clock updates,
+//!           the performance counter is monotonic.
+//! \return   uint64_t
+//!           current time in us, 0 if the counter is not available
+//!
+static uint64_t McpyGetMonotonicTimeUs()
+{
+    uint64_t frequency = 0;
+    uint64_t counter   = 0;
+
+    if (!MosUtilities::MosQueryPerformanceFrequency(&frequency) ||
+        !MosUtilities::MosQueryPerformanceCounter(&counter) ||
+        frequency == 0)
+    {
+        return 0;
+    }
+
+    return counter / frequency * 1000000 + counter % frequency * 1000000 / frequency;
+}
+
+MediaCopyEngineScheduler::MediaCopyEngineScheduler(MCPY_GET_TIME_US getTimeUs) :
+    m_getTimeUs(getTimeUs ? getTimeUs : McpyGetMonotonicTimeUs)
+{
+    for (uint32_t i = 0; i < MCPY_ENGINE_NUM; i++)
+    {
+        m_engineModel[i]        = g_mcpyDefaultEngineModel[i];
+        MOS_ZeroMemory(&m_engineCounters[i], sizeof(MCPY_ENGINE_COUNTERS));
+        m_busyUntilUs[i]        = 0;
+        m_foreignBusyUntilUs[i] = 0;
+    }
+}
+
+uint64_t MediaCopyEngineScheduler::EstimateCopyCost(MCPY_ENGINE engine, uint64_t size, MOS_TILE_TYPE srcTile, MOS_TILE_TYPE dstTile)
+{
+    if (engine >= MCPY_ENGINE_NUM)
+    {
+        return 0;
+    }
+
+    const MCPY_ENGINE_MODEL &model = m_engineModel[engine];
+    uint64_t transferUs = size / MOS_MAX(model.bytesPerUs, 1);
+
+    if (srcTile != dstTile && model.tileConvertPercent)
+    {
+        transferUs = transferUs * 100 / model.tileConvertPercent;
+    }
+
+    return model.setupUs + transferUs;
+}
+
+uint64_t MediaCopyEngineScheduler::GetProjectedStart(MCPY_ENGINE engine, uint64_t now)
+{
+    return MOS_MAX(now, MOS_MAX(m_busyUntilUs[engine], m_foreignBusyUntilUs[engine]));
+}
+
+MOS_STATUS MediaCopyEngineScheduler::SelectEngine(const MCPY_ENGINE_CAPS &caps, uint64_t size, MOS_TILE_TYPE srcTile, MOS_TILE_TYPE dstTile, MCPY_ENGINE &engine)
+{
+    const bool allowed[MCPY_ENGINE_NUM] = {caps.engineVebox != 0, caps.engineBlt != 0, caps.engineRender != 0};
+    uint64_t   now                      = GetCurrentTimeUs();
+    uint64_t   bestCompletion           = 0;
+    bool       found                    = false;
+
+    for (uint32_t i = 0; i < MCPY_ENGINE_NUM; i++)
+    {
+        if (!allowed[i])
+        {
+            continue;
+        }
+
+        MCPY_ENGINE candidate  = (MCPY_ENGINE)i;
+        uint64_t    completion = GetProjectedStart(candidate, now) + EstimateCopyCost(candidate, size, srcTile, dstTile);
+
+        // on a tie keep the lower engine index, i.e. vebox before blt before render.
+        if (!found || completion < bestCompletion)
+        {
+            engine         = candidate;
+            bestCompletion = completion;
+            found          = true;
+        }
+    }
+
+    return found ? MOS_STATUS_SUCCESS : MOS_STATUS_INVALID_PARAMETER;
+}
+
+void MediaCopyEngineScheduler::AddCopy(MCPY_ENGINE engine, uint64_t size, MOS_TILE_TYPE srcTile, MOS_TILE_TYPE dstTile)
+{
+    if (engine >= MCPY_ENGINE_NUM)
+    {
+        return;
+    }
+
+    uint64_t now          = GetCurrentTimeUs();
+    m_busyUntilUs[engine] = GetProjectedStart(engine, now) + EstimateCopyCost(engine, size, srcTile, dstTile);
+
+    m_engineCounters[engine].copyNum++;
+    m_engineCounters[engine].byteNum += size;
+}
+
+void MediaCopyEngineScheduler::UpdateEngineLoad(MCPY_ENGINE engine, uint32_t inFlightNum)
+{
+    if (engine >= MCPY_ENGINE_NUM)
+    {
+        return;
+    }
+
+    m_foreignBusyUntilUs[engine]         = GetCurrentTimeUs() + (uint64_t)inFlightNum * m_engineModel[engine].submissionUs;
+    m_engineCounters[engine].inFlightNum = inFlightNum;
+}
+
+MCPY_ENGINE_COUNTERS MediaCopyEngineScheduler::GetEngineCounters(MCPY_ENGINE engine)
+{
+    MCPY_ENGINE_COUNTERS counters;
+    MOS_ZeroMemory(&counters, sizeof(counters));
+
+    if (engine >= MCPY_ENGINE_NUM)
+    {
+        return counters;
+    }
+
+    uint64_t now             = GetCurrentTimeUs();
+    counters                 = m_engineCounters[engine];
+    counters.projectedBusyUs = GetProjectedStart(engine, now) - now;
+
+    return counters;
+}
+
+void MediaCopyEngineScheduler::SetEngineModel(MCPY_ENGINE engine, const MCPY_ENGINE_MODEL &model)
+{
+    if (engine >= MCPY_ENGINE_NUM)
+    {
+        return;
+    }
+
+    m_engineModel[engine] = model;
+}
@@ -0,0 +1,173 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     media_copy_engine_scheduler.h
+//! \brief    Load aware copy engine selection
+//! \details  Tracks the projected busy time of the vebox, blt and render engines and
+//!           routes each copy to the engine with the earliest projected completion.
+//!
+
+#ifndef __MEDIA_COPY_ENGINE_SCHEDULER_H__
+#define __MEDIA_COPY_ENGINE_SCHEDULER_H__
+
+#include <stdint.h>
+#include "media_copy.h"
+
+#define MCPY_ENGINE_NUM (MCPY_ENGINE_RENDER + 1)
+
+//!
+//! \brief  Cost model of one copy engine
+//!
+typedef struct _MCPY_ENGINE_MODEL
+{
+    uint32_t setupUs;             // fixed cost of one copy: state setup and flush
+    uint32_t bytesPerUs;          // sustained copy throughput
+    uint32_t tileConvertPercent;  // throughput scaling when src and dst tiling differ, 100 means no penalty
+    uint32_t submissionUs;        // average cost of one foreign in-flight submission on the engine
+}MCPY_ENGINE_MODEL;
+
+//!
+//! \brief  Time base of the projection, in us on a monotonic clock
+//!
+typedef uint64_t (*MCPY_GET_TIME_US)();
+
+class MediaCopyEngineScheduler
+{
+public:
+    //!
+    //! \brief    MediaCopyEngineScheduler constructor
+    //! \param    getTimeUs
+    //!           [in] clock of the projection, nullptr uses the MOS performance counter.
+    //!
+    MediaCopyEngineScheduler(MCPY_GET_TIME_US getTimeUs = nullptr);
+    virtual ~MediaCopyEngineScheduler() {}
+
+    //!
+    //! \brief    estimate copy cost.
+    //! \details  estimate the engine time of one copy from its size and tiling.
+    //! \param    engine
+    //!           [in] copy engine
+    //! \param    size
+    //!           [in] bytes to copy
+    //! \param    srcTile
+    //!           [in] source tile type
+    //! \param    dstTile
+    //!           [in] destination tile type
+    //! \return   uint64_t
+    //!           estimated engine time in us
+    //!
+    uint64_t EstimateCopyCost(MCPY_ENGINE engine, uint64_t size, MOS_TILE_TYPE srcTile, MOS_TILE_TYPE dstTile);
+
+    //!
+    //! \brief    select copy engine.
+    //! \details  pick the engine allowed by caps with the earliest projected completion of this copy.
+    //! \param    caps
+    //!           [in] engines able to do this copy
+    //! \param    size
+    //!           [in] bytes to copy
+    //! \param    srcTile
+    //!           [in] source tile type
+    //! \param    dstTile
+    //!           [in] destination tile type
+    //! \param    engine
+    //!           [out] selected engine, untouched if caps allow no engine
+    //! \return   MOS_STATUS
+    //!           Return MOS_STATUS_SUCCESS if an engine is selected, otherwise MOS_STATUS_INVALID_PARAMETER.
+    //!
+    MOS_STATUS SelectEngine(const MCPY_ENGINE_CAPS &caps, uint64_t size, MOS_TILE_TYPE srcTile, MOS_TILE_TYPE dstTile, MCPY_ENGINE &engine);
+
+    //!
+    //! \brief    add copy.
+    //! \details  account one copy routed to engine, whatever policy selected it.
+    //! \param    engine
+    //!           [in] copy engine
+    //! \param    size
+    //!           [in] bytes to copy
+    //! \param    srcTile
+    //!           [in] source tile type
+    //! \param    dstTile
+    //!           [in] destination tile type
+    //! \return   void
+    //!
+    void AddCopy(MCPY_ENGINE engine, uint64_t size, MOS_TILE_TYPE srcTile, MOS_TILE_TYPE dstTile);
+
+    //!
+    //! \brief    update engine load.
+    //! \details  feed back the submissions still in flight on engine, e.g. from gpu context status tags.
+    //!           the engine is projected busy for inFlightNum submissions from now on.
+    //! \param    engine
+    //!           [in] copy engine
+    //! \param    inFlightNum
+    //!           [in] number of in-flight submissions
+    //! \return   void
+    //!
+    void UpdateEngineLoad(MCPY_ENGINE engine, uint32_t inFlightNum);
+
+    //!
+    //! \brief    get engine counters.
+    //! \param    engine
+    //!           [in] copy engine
+    //! \return   MCPY_ENGINE_COUNTERS
+    //!           counters of the engine
+    //!
+    MCPY_ENGINE_COUNTERS GetEngineCounters(MCPY_ENGINE engine);
+
+    //!
+    //! \brief    set engine model.
+    //! \details  override the default cost model of engine.
+    //! \param    engine
+    //!           [in] copy engine
+    //! \param    model
+    //!           [in] cost model
+    //! \return   void
+    //!
+    void SetEngineModel(MCPY_ENGINE engine, const MCPY_ENGINE_MODEL &model);
+
+protected:
+    //!
+    //! \brief    get current time.
+    //! \return   uint64_t
+    //!           current time in us
+    //!
+    uint64_t GetCurrentTimeUs() { return m_getTimeUs(); }
+
+    //!
+    //! \brief    get projected start.
+    //! \details  time at which engine can start a new copy.
+    //! \param    engine
+    //!           [in] copy engine
+    //! \param    now
+    //!           [in] current time in us
+    //! \return   uint64_t
+    //!           projected start in us
+    //!
+    uint64_t GetProjectedStart(MCPY_ENGINE engine, uint64_t now);
+
+    MCPY_GET_TIME_US      m_getTimeUs = nullptr;
+    MCPY_ENGINE_MODEL     m_engineModel[MCPY_ENGINE_NUM];
+    MCPY_ENGINE_COUNTERS  m_engineCounters[MCPY_ENGINE_NUM];
+    uint64_t              m_busyUntilUs[MCPY_ENGINE_NUM];        // end of the copies routed by media copy
+    uint64_t              m_foreignBusyUntilUs[MCPY_ENGINE_NUM]; // end of the in-flight work reported by load update
+
+MEDIA_CLASS_DEFINE_END(MediaCopyEngineScheduler)
+};
+#endif // __MEDIA_COPY_ENGINE_SCHEDULER_H__
@@ -140,11 +140,10 @@ MOS_STATUS MediaMemDeCompNext::MediaMemoryCopy(PMOS_RESOURCE inputResource, PMOS
 #if (_DEBUG || _RELEASE_INTERNAL)
     {
         // Read user feature key to force outputCompressed
-        ReadUserSettingForDebug(
+        ReadUserSetting(
             m_userSettingPtr,
             outputCompressed,
-            __VPHAL_VEBOX_FORCE_VP_MEMCOPY_OUTPUTCOMPRESSED,
-            MediaUserSetting::Group::Sequence);
+            m_outputCompressedHandle);
     }
 #endif
 
@@ -277,11 +276,10 @@ MOS_STATUS MediaMemDeCompNext::MediaMemoryCopy2D(PMOS_RESOURCE inputResource, PM
 #if (_DEBUG || _RELEASE_INTERNAL)
     {
         // Read user feature key to Force outputCompressed
-        ReadUserSettingForDebug(
+        ReadUserSetting(
             m_userSettingPtr,
             outputCompressed,
-            __VPHAL_VEBOX_FORCE_VP_MEMCOPY_OUTPUTCOMPRESSED,
-            MediaUserSetting::Group::Sequence);
+            m_outputCompressedHandle);
     }
 #endif
 
@@ -463,6 +461,9 @@ MOS_STATUS MediaMemDeCompNext::Initialize(PMOS_INTERFACE osInterface, MhwInterfa
     m_miInterface    = mhwInterfaces->m_miInterface;
 
     m_userSettingPtr = m_osInterface->pfnGetUserSettingInstance(m_osInterface);
+#if (_DEBUG || _RELEASE_INTERNAL)
+    m_outputCompressedHandle = GetUserSettingHandle(m_userSettingPtr, __VPHAL_VEBOX_FORCE_VP_MEMCOPY_OUTPUTCOMPRESSED, MediaUserSetting::Group::Sequence);
+#endif
 
     // Set-Up Vebox decompression enable or not
     IsVeboxDecompressionEnabled();
@@ -340,6 +340,7 @@ protected:
     MhwMiInterface                        * m_miInterface    = nullptr;
 
     MediaUserSettingSharedPtr m_userSettingPtr = nullptr;  //!< UserSettingInstance
+    MediaUserSetting::Handle  m_outputCompressedHandle = MediaUserSetting::InvalidHandle;  //!< read per copy
 MEDIA_CLASS_DEFINE_END(MediaMemDeCompNext)
 };
 
@@ -221,13 +221,16 @@ MOS_STATUS RenderCmdPacketNext::SetPowerMode(uint32_t KernelID)
 #if (_DEBUG || _RELEASE_INTERNAL)
     // User feature key reads
     userSettingPtr = m_osInterface->pfnGetUserSettingInstance(m_osInterface);
+    if (m_sseuOverrideHandle == MediaUserSetting::InvalidHandle)
+    {
+        m_sseuOverrideHandle = GetUserSettingHandle(userSettingPtr, __MEDIA_USER_FEATURE_VALUE_SSEU_SETTING_OVERRIDE, MediaUserSetting::Group::Device);
+    }
 
     uint32_t value = 0;
-    ReadUserSettingForDebug(
+    ReadUserSetting(
         userSettingPtr,
         value,
-        __MEDIA_USER_FEATURE_VALUE_SSEU_SETTING_OVERRIDE,
-        MediaUserSetting::Group::Device);
+        m_sseuOverrideHandle);
     if (value != 0xDEADC0DE)
     {
         wNumRequestedEUSlices  = value & 0xFF;            // Bits 0-7
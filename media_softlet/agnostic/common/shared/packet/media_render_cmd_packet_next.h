@@ -278,6 +278,7 @@ protected:
     MhwCpInterface* m_cpInterface = nullptr;
     PMOS_INTERFACE              m_osInterface = nullptr;
     MediaFeatureManager* m_featureManager = nullptr;
+    MediaUserSetting::Handle    m_sseuOverrideHandle = MediaUserSetting::InvalidHandle;  //!< read per submission
 
     // Perf
     VPHAL_PERFTAG               PerfTag; // need to check the perf setting in codec
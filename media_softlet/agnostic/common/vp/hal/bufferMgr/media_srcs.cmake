@@ -26,6 +26,7 @@ set(TMP_SOURCES_
 set(TMP_HEADERS_
     ${CMAKE_CURRENT_LIST_DIR}/vp_allocator.h
     ${CMAKE_CURRENT_LIST_DIR}/vp_resource_manager.h
+    ${CMAKE_CURRENT_LIST_DIR}/vp_surface_pool.h
 )
 
 set(SOFTLET_VP_SOURCES_
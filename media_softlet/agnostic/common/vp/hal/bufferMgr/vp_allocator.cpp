@@ -42,6 +42,16 @@ VpAllocator::VpAllocator(PMOS_INTERFACE osInterface, MediaMemComp *mmc) :
 
 VpAllocator::~VpAllocator()
 {
+    VP_PUBLIC_NORMALMESSAGE("Surface pool: %llu allocated, %llu reused, %llu evicted.",
+        (unsigned long long)m_surfacePool.GetAllocCount(),
+        (unsigned long long)m_surfacePool.GetReuseCount(),
+        (unsigned long long)m_surfacePool.GetEvictCount());
+
+    std::vector<VP_SURFACE *> surfaces;
+    surfaces.swap(m_poolRecycler);
+    m_surfacePool.Clear(surfaces);
+    DestroyPoolSurfaces(surfaces);
+
     if (m_allocator)
     {
         m_allocator->DestroyAllResources();
@@ -441,6 +451,8 @@ MOS_STATUS VpAllocator::DestroyVpSurface(VP_SURFACE* &surface, bool deferredDest
         return MOS_STATUS_SUCCESS;
     }
 
+    m_poolKeys.erase(surface);
+
     if (surface->isResourceOwner)
     {
         status = DestroySurface(surface->osSurface, flags);
@@ -454,6 +466,81 @@ MOS_STATUS VpAllocator::DestroyVpSurface(VP_SURFACE* &surface, bool deferredDest
     return status;
 }
 
+MOS_STATUS VpAllocator::ReleaseVpSurface(VP_SURFACE* &surface, bool deferredDestroyed, MOS_GFXRES_FREE_FLAGS flags)
+{
+    VP_FUNC_CALL();
+    if (nullptr == surface || nullptr == surface->osSurface)
+    {
+        return DestroyVpSurface(surface, deferredDestroyed, flags);
+    }
+
+    auto it = m_poolKeys.find(surface);
+    if (it == m_poolKeys.end() || !surface->isResourceOwner ||
+        Mos_ResourceIsNull(&surface->osSurface->OsResource) ||
+        !IsSurfaceMatchingPoolKey(surface, it->second))
+    {
+        return DestroyVpSurface(surface, deferredDestroyed, flags);
+    }
+
+    if (deferredDestroyed)
+    {
+        m_poolRecycler.push_back(surface);
+        surface = nullptr;
+        return MOS_STATUS_SUCCESS;
+    }
+
+    uint64_t size = surface->osSurface->dwSize;
+    if (0 == size)
+    {
+        size = (uint64_t)surface->osSurface->dwPitch * surface->osSurface->dwHeight;
+    }
+
+    std::vector<VP_SURFACE *> evicted;
+    m_surfacePool.Release(it->second, surface, size, evicted);
+    surface = nullptr;
+    DestroyPoolSurfaces(evicted);
+    return MOS_STATUS_SUCCESS;
+}
+
+void VpAllocator::SetSurfacePoolLimits(uint64_t maxSize, uint32_t maxCount)
+{
+    VP_FUNC_CALL();
+    std::vector<VP_SURFACE *> evicted;
+    m_surfacePool.SetLimits(maxSize, maxCount, evicted);
+    DestroyPoolSurfaces(evicted);
+    VP_PUBLIC_NORMALMESSAGE("Surface pool keeps up to %u surfaces, %llu bytes.", maxCount, (unsigned long long)maxSize);
+}
+
+bool VpAllocator::IsSurfaceMatchingPoolKey(VP_SURFACE *surface, const VP_SURFACE_POOL_KEY &key)
+{
+    MOS_SURFACE &osSurface = *surface->osSurface;
+    bool        isBuffer   = (Format_Buffer == osSurface.Format);
+
+    // Parameters may be overwritten by the user of the surface, e.g. to reinterpret format.
+    return  key.format          == (uint32_t)osSurface.Format               &&
+            key.tileType        == (uint32_t)osSurface.TileType             &&
+            key.compressible    == (uint32_t)(osSurface.bCompressible != 0) &&
+            key.compressionMode == (uint32_t)osSurface.CompressionMode      &&
+            key.width           == (isBuffer ? surface->bufferWidth : osSurface.dwWidth) &&
+            key.height          == (isBuffer ? surface->bufferHeight : osSurface.dwHeight);
+}
+
+void VpAllocator::DestroyPoolSurfaces(std::vector<VP_SURFACE *> &surfaces)
+{
+    VP_FUNC_CALL();
+    for (auto surf : surfaces)
+    {
+        MOS_GFXRES_FREE_FLAGS resFreeFlags = {};
+        //if free the compressed surface, need set the sync dealloc flag as 1 for sync dealloc for aux table update
+        if (surf && IsSyncFreeNeededForMMCSurface(surf->osSurface))
+        {
+            resFreeFlags.SynchronousDestroy = 1;
+        }
+        DestroyVpSurface(surf, false, resFreeFlags);
+    }
+    surfaces.clear();
+}
+
 void* VpAllocator::Lock(MOS_RESOURCE* resource, MOS_LOCK_PARAMS *lockFlag)
 {
     VP_FUNC_CALL();
@@ -791,10 +878,50 @@ MOS_STATUS VpAllocator::ReAllocateSurface(
         resFreeFlags.SynchronousDestroy = 1;
         VP_PUBLIC_NORMALMESSAGE("Set SynchronousDestroy flag for compressed resource %s", surfaceName);
     }
-    VP_PUBLIC_CHK_STATUS_RETURN(DestroyVpSurface(surface, deferredDestroyed, resFreeFlags));
+    VP_PUBLIC_CHK_STATUS_RETURN(ReleaseVpSurface(surface, deferredDestroyed, resFreeFlags));
 
     AllocParamsInitType(allocParams, surface, defaultResType, defaultTileType);
 
+    VP_SURFACE_POOL_KEY poolKey = {};
+    poolKey.format              = format;
+    poolKey.resType             = allocParams.Type;
+    poolKey.tileType            = allocParams.TileType;
+    poolKey.tileModeByForce     = tileModeByForce;
+    poolKey.width               = width;
+    poolKey.height              = height;
+    poolKey.compressible        = compressible;
+    poolKey.compressionMode     = compressionMode;
+    poolKey.resUsageType        = resUsageType;
+    poolKey.memType             = memType;
+    poolKey.notLockable         = isNotLockable;
+
+    // Surface to be zeroed or backed by system memory is not taken from or put into pool.
+    bool poolable = (nullptr == systemMemory);
+
+    surface = (poolable && !zeroOnAllocate) ? m_surfacePool.Acquire(poolKey) : nullptr;
+    if (surface)
+    {
+        // Reset the surface as AllocateVpSurface does.
+        MOS_SURFACE *osSurface    = surface->osSurface;
+        uint32_t     bufferWidth  = surface->bufferWidth;
+        uint32_t     bufferHeight = surface->bufferHeight;
+        MOS_ZeroMemory(surface, sizeof(VP_SURFACE));
+        surface->osSurface       = osSurface;
+        surface->isResourceOwner = true;
+        surface->ColorSpace      = CSpace_None;
+        surface->SampleType      = SAMPLE_PROGRESSIVE;
+        surface->rcSrc.right     = osSurface->dwWidth;
+        surface->rcSrc.bottom    = osSurface->dwHeight;
+        surface->rcDst           = surface->rcSrc;
+        surface->rcMaxSrc        = surface->rcSrc;
+        surface->bufferWidth     = bufferWidth;
+        surface->bufferHeight    = bufferHeight;
+
+        VP_PUBLIC_NORMALMESSAGE("Reuse pooled surface for %s", surfaceName);
+        allocated = true;
+        return MOS_STATUS_SUCCESS;
+    }
+
     allocParams.dwWidth         = width;
     allocParams.dwHeight        = height;
     allocParams.Format          = format;
@@ -820,6 +947,11 @@ MOS_STATUS VpAllocator::ReAllocateSurface(
     {
         VP_PUBLIC_ASSERTMESSAGE("Incorrect surface parameters.");
     }
+    else if (poolable)
+    {
+        m_poolKeys[surface] = poolKey;
+    }
+    m_surfacePool.OnAllocated();
 
     MT_LOG7(MT_VP_HAL_REALLOC_SURF, MT_NORMAL, MT_VP_HAL_INTER_SURF_TYPE, surfaceName ? *((int64_t*)surfaceName) : 0,
         MT_SURF_WIDTH, width, MT_SURF_HEIGHT, height, MT_SURF_MOS_FORMAT, format, MT_SURF_TILE_MODE, surface->osSurface->TileModeGMM,
@@ -1159,6 +1291,14 @@ bool VpAllocator::IsSyncFreeNeededForMMCSurface(PMOS_SURFACE pOsSurface)
 void VpAllocator::CleanRecycler()
 {
     VP_FUNC_CALL();
+    // Surfaces released in current frame can be reused from next frame.
+    std::vector<VP_SURFACE *> released;
+    released.swap(m_poolRecycler);
+    for (auto surf : released)
+    {
+        ReleaseVpSurface(surf);
+    }
+
     while (!m_recycler.empty())
     {
         MOS_GFXRES_FREE_FLAGS resFreeFlags = {};
@@ -33,6 +33,7 @@
 #include "vp_mem_compression.h"
 #include "vp_vebox_common.h"
 #include "vp_pipeline_common.h"
+#include "vp_surface_pool.h"
 
 namespace vp {
 
@@ -198,6 +199,32 @@ public:
     //!
     MOS_STATUS DestroyVpSurface(VP_SURFACE *&surface, bool deferredDestroyed = false, MOS_GFXRES_FREE_FLAGS flags = {0});
 
+    //!
+    //! \brief  Release Surface
+    //! \details Surface allocated by ReAllocateSurface is kept in surface pool for reuse
+    //!          by later ReAllocateSurface with same parameters. Other surfaces are destroyed.
+    //! \param  [in] surface
+    //!         Pointer to VP_SURFACE
+    //! \param  [in] deferredDestroyed
+    //!         Deferred release the resource until CleanRecycler being called.
+    //! \param  [in] flags
+    //!         flags for vp surface destroy
+    //! \return MOS_STATUS
+    //!         MOS_STATUS_SUCCESS if success, else fail reason
+    //!
+    MOS_STATUS ReleaseVpSurface(VP_SURFACE *&surface, bool deferredDestroyed = false, MOS_GFXRES_FREE_FLAGS flags = {0});
+
+    //!
+    //! \brief  Set the limits of the surface pool
+    //! \details Idle surfaces over the new limits are destroyed.
+    //! \param  [in] maxSize
+    //!         Bytes of idle surfaces kept
+    //! \param  [in] maxCount
+    //!         Idle surfaces kept, 0 to disable the surface pool
+    //! \return void
+    //!
+    void SetSurfacePoolLimits(uint64_t maxSize, uint32_t maxCount);
+
     //!
     //! \brief  Allocate Surface
     //! \param  [in] component
@@ -567,6 +594,11 @@ public:
     bool IsSyncFreeNeededForMMCSurface(PMOS_SURFACE pOsSurface);
     void CleanRecycler();
 
+    const VpSurfacePool<VP_SURFACE> &GetSurfacePool()
+    {
+        return m_surfacePool;
+    }
+
 protected:
     //!
     //! \brief    Set mmc flags to surface
@@ -586,10 +618,31 @@ protected:
     //!
     void UpdateSurfacePlaneOffset(MOS_SURFACE &surf);
 
+    //!
+    //! \brief    Check whether surface still has the parameters it was allocated with
+    //! \param    surface
+    //!           [in] surface to be checked.
+    //! \param    key
+    //!           [in] allocation parameters of the surface.
+    //! \return   bool
+    //!
+    bool IsSurfaceMatchingPoolKey(VP_SURFACE *surface, const VP_SURFACE_POOL_KEY &key);
+
+    //!
+    //! \brief    Destroy surfaces dropped from surface pool
+    //! \param    surfaces
+    //!           [in, out] surfaces to be destroyed.
+    //! \return   VOID
+    //!
+    void DestroyPoolSurfaces(std::vector<VP_SURFACE *> &surfaces);
+
     PMOS_INTERFACE  m_osInterface   = nullptr;
     Allocator       *m_allocator    = nullptr;
     MediaMemComp    *m_mmc          = nullptr;
     std::vector<VP_SURFACE *> m_recycler;   // Container for delayed destroyed surface.
+    std::vector<VP_SURFACE *> m_poolRecycler;   // Container for delayed released surface.
+    VpSurfacePool<VP_SURFACE> m_surfacePool;    // Idle surfaces for reuse by ReAllocateSurface.
+    std::map<VP_SURFACE *, VP_SURFACE_POOL_KEY> m_poolKeys;  // Allocation parameters of surfaces which can be pooled.
 
 MEDIA_CLASS_DEFINE_END(vp__VpAllocator)
 };
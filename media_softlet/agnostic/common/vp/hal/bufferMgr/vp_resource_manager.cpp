@@ -1564,7 +1564,7 @@ void VpResourceManager::DestoryVeboxOutputSurface()
 
     for (uint32_t i = 0; i < VP_MAX_NUM_VEBOX_SURFACES; i++)
     {
-        m_allocator.DestroyVpSurface(m_veboxOutput[i], IsDeferredResourceDestroyNeeded());
+        m_allocator.ReleaseVpSurface(m_veboxOutput[i], IsDeferredResourceDestroyNeeded());
     }
 }
 
@@ -1574,7 +1574,7 @@ void VpResourceManager::DestoryVeboxDenoiseOutputSurface()
 
     for (uint32_t i = 0; i < VP_NUM_DN_SURFACES; i++)
     {
-        m_allocator.DestroyVpSurface(m_veboxDenoiseOutput[i], IsDeferredResourceDestroyNeeded());
+        m_allocator.ReleaseVpSurface(m_veboxDenoiseOutput[i], IsDeferredResourceDestroyNeeded());
     }
 }
 
@@ -1585,7 +1585,7 @@ void VpResourceManager::DestoryVeboxSTMMSurface()
     // Free DI history buffers (STMM = Spatial-temporal motion measure)
     for (uint32_t i = 0; i < VP_NUM_STMM_SURFACES; i++)
     {
-        m_allocator.DestroyVpSurface(m_veboxSTMMSurface[i], IsDeferredResourceDestroyNeeded());
+        m_allocator.ReleaseVpSurface(m_veboxSTMMSurface[i], IsDeferredResourceDestroyNeeded());
     }
 }
 
@@ -0,0 +1,243 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     vp_surface_pool.h
+//! \brief    Pool of idle internal surfaces, keyed by their allocation parameters
+//! \details  Surfaces dropped by VpAllocator::ReAllocateSurface, e.g. when the stream
+//!           switches resolution, are kept here instead of being freed, and handed out
+//!           again to the next request with the same parameters. The pool is bounded in
+//!           surface count and size, the least recently released surfaces are evicted.
+//!           Each VpAllocator has its own pool rather than one per device: pooled surfaces
+//!           are allocated through the allocator's OS interface and are freed with it, and
+//!           the pool is only used from the allocator's pipeline thread, so it needs no lock.
+//!           A device with several VP pipelines can keep the limits once per pipeline, which
+//!           is why the defaults are low. VpPipeline takes the limits from the "VP Surface
+//!           Pool Max Count" and "VP Surface Pool Max Size" (MB) user settings.
+//!
+#ifndef __VP_SURFACE_POOL_H__
+#define __VP_SURFACE_POOL_H__
+
+#include <stdint.h>
+#include <string.h>
+#include <list>
+#include <map>
+#include <vector>
+
+namespace vp
+{
+#define VP_SURFACE_POOL_MAX_SIZE_MB 32      // Default of the MB of idle surfaces kept
+#define VP_SURFACE_POOL_MAX_SIZE    ((uint64_t)VP_SURFACE_POOL_MAX_SIZE_MB << 20)
+#define VP_SURFACE_POOL_MAX_COUNT   16      // Default of the idle surfaces kept
+
+//!
+//! \brief  Allocation parameters of a pooled surface, all of them need to match for reuse
+//!
+struct VP_SURFACE_POOL_KEY
+{
+    uint32_t format;
+    uint32_t resType;
+    uint32_t tileType;
+    uint32_t tileModeByForce;
+    uint32_t width;
+    uint32_t height;
+    uint32_t compressible;
+    uint32_t compressionMode;
+    uint32_t resUsageType;
+    uint32_t memType;
+    uint32_t notLockable;
+
+    bool operator<(const VP_SURFACE_POOL_KEY &key) const
+    {
+        return memcmp(this, &key, sizeof(VP_SURFACE_POOL_KEY)) < 0;
+    }
+};
+
+template <typename Surface>
+class VpSurfacePool
+{
+public:
+    VpSurfacePool(uint64_t maxSize = VP_SURFACE_POOL_MAX_SIZE, uint32_t maxCount = VP_SURFACE_POOL_MAX_COUNT) :
+        m_maxSize(maxSize), m_maxCount(maxCount)
+    {
+    }
+
+    //!
+    //! \brief    Take an idle surface with the key out of the pool
+    //! \return   Surface *
+    //!           nullptr if no idle surface matches
+    //!
+    Surface *Acquire(const VP_SURFACE_POOL_KEY &key)
+    {
+        auto it = m_index.find(key);
+        if (it == m_index.end())
+        {
+            return nullptr;
+        }
+
+        auto     entry   = it->second;
+        Surface *surface = entry->surface;
+        m_size -= entry->size;
+        m_index.erase(it);
+        m_lru.erase(entry);
+        m_reuseCount++;
+        return surface;
+    }
+
+    //!
+    //! \brief    Put an idle surface in the pool
+    //! \details  Surfaces over the count or size limit are evicted from the least recently
+    //!           released one, and appended to evicted for the caller to free.
+    //! \param    [in] key
+    //!           Allocation parameters of the surface
+    //! \param    [in] surface
+    //!           Idle surface
+    //! \param    [in] size
+    //!           Size of the surface in bytes
+    //! \param    [out] evicted
+    //!           Surfaces to be freed
+    //!
+    void Release(const VP_SURFACE_POOL_KEY &key, Surface *surface, uint64_t size, std::vector<Surface *> &evicted)
+    {
+        m_lru.push_back({key, surface, size});
+        m_index.insert(std::make_pair(key, std::prev(m_lru.end())));
+        m_size += size;
+
+        Evict(evicted);
+    }
+
+    //!
+    //! \brief    Change the count and size limits of the pool
+    //! \details  Surfaces over the new limits are evicted as by Release.
+    //! \param    [in] maxSize
+    //!           Bytes of idle surfaces kept
+    //! \param    [in] maxCount
+    //!           Idle surfaces kept, 0 to disable the pool
+    //! \param    [out] evicted
+    //!           Surfaces to be freed
+    //!
+    void SetLimits(uint64_t maxSize, uint32_t maxCount, std::vector<Surface *> &evicted)
+    {
+        m_maxSize  = maxSize;
+        m_maxCount = maxCount;
+        Evict(evicted);
+    }
+
+    uint64_t GetMaxSize() const
+    {
+        return m_maxSize;
+    }
+
+    uint32_t GetMaxCount() const
+    {
+        return m_maxCount;
+    }
+
+    //!
+    //! \brief    Take all idle surfaces out of the pool, for the caller to free
+    //!
+    void Clear(std::vector<Surface *> &surfaces)
+    {
+        for (auto &entry : m_lru)
+        {
+            surfaces.push_back(entry.surface);
+        }
+        m_lru.clear();
+        m_index.clear();
+        m_size = 0;
+    }
+
+    //!
+    //! \brief    Count a surface allocated because no idle one matched
+    //!
+    void OnAllocated()
+    {
+        m_allocCount++;
+    }
+
+    uint64_t GetAllocCount() const
+    {
+        return m_allocCount;
+    }
+
+    uint64_t GetReuseCount() const
+    {
+        return m_reuseCount;
+    }
+
+    uint64_t GetEvictCount() const
+    {
+        return m_evictCount;
+    }
+
+    uint64_t GetSize() const
+    {
+        return m_size;
+    }
+
+    uint32_t GetCount() const
+    {
+        return (uint32_t)m_lru.size();
+    }
+
+private:
+    //!
+    //! \brief    Evict the least recently released surfaces until the pool is within its limits
+    //!
+    void Evict(std::vector<Surface *> &evicted)
+    {
+        while (!m_lru.empty() && (m_size > m_maxSize || m_lru.size() > m_maxCount))
+        {
+            auto oldest = m_lru.begin();
+            auto range  = m_index.equal_range(oldest->key);
+            for (auto it = range.first; it != range.second; ++it)
+            {
+                if (it->second == oldest)
+                {
+                    m_index.erase(it);
+                    break;
+                }
+            }
+            evicted.push_back(oldest->surface);
+            m_size -= oldest->size;
+            m_lru.erase(oldest);
+            m_evictCount++;
+        }
+    }
+
+    struct Entry
+    {
+        VP_SURFACE_POOL_KEY key;
+        Surface             *surface;
+        uint64_t            size;
+    };
+
+    std::list<Entry>                                                        m_lru;      // Least recently released first
+    std::multimap<VP_SURFACE_POOL_KEY, typename std::list<Entry>::iterator> m_index;
+    uint64_t                                                                m_maxSize    = 0;
+    uint32_t                                                                m_maxCount   = 0;
+    uint64_t                                                                m_size       = 0;
+    uint64_t                                                                m_allocCount = 0;
+    uint64_t                                                                m_reuseCount = 0;
+    uint64_t                                                                m_evictCount = 0;
+};
+}
+#endif // !__VP_SURFACE_POOL_H__
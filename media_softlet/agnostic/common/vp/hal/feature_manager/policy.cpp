@@ -45,6 +45,8 @@ Policy::Policy(VpInterface &vpInterface) : m_vpInterface(vpInterface)
 
 Policy::~Policy()
 {
+    VP_PUBLIC_NORMALMESSAGE("Engine caps cache hit %lld, miss %lld",
+        (long long)m_capsCache.GetHitCount(), (long long)m_capsCache.GetMissCount());
     UnregisterFeatures();
 }
 
@@ -348,14 +350,31 @@ MOS_STATUS Policy::GetExecuteCaps(SwFilterPipe& subSwFilterPipe, HW_FILTER_PARAM
     uint32_t inputSurfCount     = subSwFilterPipe.GetSurfaceCount(true);
     uint32_t outputSurfCount    = subSwFilterPipe.GetSurfaceCount(false);
 
-    for (index = 0; index < inputSurfCount; ++index)
+    bool capsCacheable = BuildCapsCacheKey(subSwFilterPipe);
+
+    if (capsCacheable && m_capsCache.Apply(m_capsCacheFeatures))
     {
-        VP_PUBLIC_CHK_STATUS_RETURN(BuildExecutionEngines(subSwFilterPipe, true, index));
+        for (auto &feature : m_capsCacheFeatures)
+        {
+            PrintFeatureExecutionCaps("Engine caps from cache", *feature.engineCaps);
+        }
     }
-
-    for (index = 0; index < outputSurfCount; ++index)
+    else
     {
-        VP_PUBLIC_CHK_STATUS_RETURN(BuildExecutionEngines(subSwFilterPipe, false, index));
+        for (index = 0; index < inputSurfCount; ++index)
+        {
+            VP_PUBLIC_CHK_STATUS_RETURN(BuildExecutionEngines(subSwFilterPipe, true, index));
+        }
+
+        for (index = 0; index < outputSurfCount; ++index)
+        {
+            VP_PUBLIC_CHK_STATUS_RETURN(BuildExecutionEngines(subSwFilterPipe, false, index));
+        }
+
+        if (capsCacheable)
+        {
+            m_capsCache.Save(m_capsCacheFeatures);
+        }
     }
 
     VP_PUBLIC_CHK_STATUS_RETURN(BuildFilters(subSwFilterPipe, params));
@@ -503,6 +522,104 @@ MOS_STATUS Policy::BuildExecutionEngines(SwFilterPipe &swFilterPipe, bool isInpu
     return MOS_STATUS_SUCCESS;
 }
 
+bool Policy::BuildCapsCacheKey(SwFilterPipe &swFilterPipe)
+{
+    VP_FUNC_CALL();
+
+    m_capsCache.ResetKey();
+    m_capsCacheFeatures.clear();
+
+    if (nullptr == m_vpInterface.GetHwInterface() ||
+        nullptr == m_vpInterface.GetHwInterface()->m_userFeatureControl)
+    {
+        return false;
+    }
+
+    auto userFeatureControl = m_vpInterface.GetHwInterface()->m_userFeatureControl;
+    m_capsCache.AddToKey(userFeatureControl->IsSfcDisabled() ? 1 : 0);
+    m_capsCache.AddToKey(userFeatureControl->IsVeboxOutputDisabled() ? 1 : 0);
+
+    for (auto isInputPipe : {true, false})
+    {
+        uint32_t surfCount = swFilterPipe.GetSurfaceCount(isInputPipe);
+        m_capsCache.AddToKey(surfCount);
+
+        for (uint32_t index = 0; index < surfCount; ++index)
+        {
+            SwFilterSubPipe *pipe = swFilterPipe.GetSwFilterSubPipe(isInputPipe, index);
+            if (nullptr == pipe)
+            {
+                m_capsCache.AddToKey(FeatureTypeInvalid);
+                continue;
+            }
+
+            for (auto filterID : m_featurePool)
+            {
+                SwFilter *feature = pipe->GetSwFilter(filterID);
+                if (nullptr == feature)
+                {
+                    continue;
+                }
+                if (!AddFeatureToCapsCacheKey(filterID, *feature))
+                {
+                    return false;
+                }
+            }
+            // End of sub pipe.
+            m_capsCache.AddToKey(FeatureTypeInvalid);
+        }
+    }
+
+    return true;
+}
+
+bool Policy::AddFeatureToCapsCacheKey(FeatureType featureType, SwFilter &feature)
+{
+    VP_FUNC_CALL();
+
+    // Features processed by previous pass keep their engine caps.
+    if (feature.GetFilterEngineCaps().value != 0)
+    {
+        return false;
+    }
+
+    VpPolicyCapsCache::Feature cacheFeature = {};
+    cacheFeature.engineCaps = &feature.GetFilterEngineCaps();
+
+    switch (featureType)
+    {
+    case FeatureTypeCsc:
+        m_capsCache.AddCscToKey(((SwFilterCsc &)feature).GetSwFilterParams());
+        break;
+    case FeatureTypeScaling:
+    {
+        FeatureParamScaling &params = ((SwFilterScaling &)feature).GetSwFilterParams();
+        m_capsCache.AddScalingToKey(params);
+        cacheFeature.scalingPreference = &params.scalingPreference;
+        break;
+    }
+    case FeatureTypeRotMir:
+        m_capsCache.AddRotMirToKey(((SwFilterRotMir &)feature).GetSwFilterParams());
+        break;
+    case FeatureTypeAlpha:
+        m_capsCache.AddAlphaToKey(((SwFilterAlpha &)feature).GetSwFilterParams());
+        break;
+    case FeatureTypeColorFill:
+    case FeatureTypeLumakey:
+    case FeatureTypeBlending:
+        // Engine caps do not depend on parameters.
+        m_capsCache.AddToKey(featureType);
+        break;
+    default:
+        // Caps query of DN/DI/HDR updates feature parameters, and the caps of
+        // other features depend on them.
+        return false;
+    }
+
+    m_capsCacheFeatures.push_back(cacheFeature);
+    return true;
+}
+
 MOS_STATUS Policy::Update3DLutoutputColorAndFormat(FeatureParamCsc *cscParams, FeatureParamHdr *hdrParams, MOS_FORMAT Format, VPHAL_CSPACE CSpace)
 {
     // For vebox + render, e.g. BT2020 P010->SRGB, if not correct the format here, since forceCscToRender being enabled, outputFormat in csc filter of
@@ -38,6 +38,7 @@
 #include "hw_filter.h"
 #include "sw_filter_pipe.h"
 #include "vp_resource_manager.h"
+#include "vp_policy_caps_cache.h"
 #include <map>
 
 namespace vp
@@ -68,6 +69,16 @@ public:
     //!
     bool IsVeboxSfcFormatSupported(MOS_FORMAT formatInput, MOS_FORMAT formatOutput);
 
+    uint64_t GetCapsCacheHitCount()
+    {
+        return m_capsCache.GetHitCount();
+    }
+
+    uint64_t GetCapsCacheMissCount()
+    {
+        return m_capsCache.GetMissCount();
+    }
+
 protected:
     virtual MOS_STATUS RegisterFeatures();
     virtual void UnregisterFeatures();
@@ -76,6 +87,18 @@ protected:
     virtual MOS_STATUS BuildVeboxSecureFilters(SwFilterPipe& featurePipe, VP_EXECUTE_CAPS& caps, HW_FILTER_PARAMS& params);
 
     MOS_STATUS BuildExecutionEngines(SwFilterPipe &swFilterPipe, bool isInputPipe, uint32_t index);
+    //!
+    //! \brief    Build the caps cache key of a feature pipe
+    //! \details  The key holds the parameters the engine caps of the features depend on.
+    //!           Only pipes whose features are not processed yet and whose caps query does
+    //!           not update the feature parameters can be cached.
+    //! \param    swFilterPipe
+    //!           [in] Feature pipe
+    //! \return   bool
+    //!           true if the engine caps of the pipe can be cached
+    //!
+    bool BuildCapsCacheKey(SwFilterPipe &swFilterPipe);
+    bool AddFeatureToCapsCacheKey(FeatureType featureType, SwFilter &feature);
     MOS_STATUS GetHwFilterParam(SwFilterPipe& subSwFilterPipe, HW_FILTER_PARAMS& params);
     MOS_STATUS ReleaseHwFilterParam(HW_FILTER_PARAMS &params);
     MOS_STATUS InitExecuteCaps(VP_EXECUTE_CAPS &caps, VP_EngineEntry &engineCapsInputPipe, VP_EngineEntry &engineCapsOutputPipe);
@@ -183,6 +206,10 @@ protected:
     VP_HW_CAPS          m_hwCaps = {};
     bool                m_initialized = false;
 
+    // Engine caps reused across frames with the same feature parameters
+    VpPolicyCapsCache                           m_capsCache;
+    std::vector<VpPolicyCapsCache::Feature>     m_capsCacheFeatures;    // features of current key, in key order
+
     // HDR 3DLut Parameters
     uint32_t            m_savedMaxDLL   = 1000;
     uint32_t            m_savedMaxCLL   = 4000;
@@ -218,6 +218,8 @@ VPFeatureManager::VPFeatureManager(
     {
         m_userSettingPtr = m_hwInterface->m_osInterface->pfnGetUserSettingInstance(m_hwInterface->m_osInterface);
     }
+    m_bypassCompositionHandle = GetUserSettingHandle(m_userSettingPtr, __VPHAL_BYPASS_COMPOSITION, MediaUserSetting::Group::Sequence);
+    m_disableSfcHandle        = GetUserSettingHandle(m_userSettingPtr, __VPHAL_VEBOX_DISABLE_SFC, MediaUserSetting::Group::Sequence);
 }
 
 MOS_STATUS VPFeatureManager::CheckFeatures(void * params, bool &bApgFuncSupported)
@@ -429,8 +431,7 @@ bool VPFeatureManager::IsVeboxOutFeasible(
     ReadUserSetting(
         m_userSettingPtr,
         dwCompBypassMode,
-        __VPHAL_BYPASS_COMPOSITION,
-        MediaUserSetting::Group::Sequence,
+        m_bypassCompositionHandle,
         customValue,
         true);
 
@@ -589,8 +590,7 @@ bool VPFeatureManager::IsSfcOutputFeasible(PVP_PIPELINE_PARAMS params)
         ReadUserSetting(
             m_userSettingPtr,
             disableSFC,
-            __VPHAL_VEBOX_DISABLE_SFC,
-            MediaUserSetting::Group::Sequence);
+            m_disableSfcHandle);
 
         if (disableSFC)
         {
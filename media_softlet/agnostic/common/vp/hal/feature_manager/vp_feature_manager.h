@@ -166,6 +166,8 @@ protected:
 protected:
     PVP_MHWINTERFACE        m_hwInterface       = nullptr;
     PMOS_INTERFACE          m_pOsInterface      = nullptr;
+    MediaUserSetting::Handle m_bypassCompositionHandle = MediaUserSetting::InvalidHandle;  //!< read per frame
+    MediaUserSetting::Handle m_disableSfcHandle        = MediaUserSetting::InvalidHandle;  //!< read per frame
 
 MEDIA_CLASS_DEFINE_END(vp__VPFeatureManager)
 };
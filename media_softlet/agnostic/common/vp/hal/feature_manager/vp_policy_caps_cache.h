@@ -0,0 +1,285 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     vp_policy_caps_cache.h
+//! \brief    Cache of the feature engine caps resolved by policy
+//! \details  The policy builds a canonical key from the feature parameters its engine caps
+//!           depend on. Frames with the same key reuse the engine caps resolved for the first
+//!           one instead of querying every feature again.
+//!
+#ifndef __VP_POLICY_CAPS_CACHE_H__
+#define __VP_POLICY_CAPS_CACHE_H__
+
+#include <stdint.h>
+#include <list>
+#include <unordered_map>
+#include <vector>
+#include "sw_filter.h"
+
+namespace vp
+{
+#define VP_POLICY_CAPS_CACHE_MAX_SIZE   16
+
+class VpPolicyCapsCache
+{
+public:
+    //!
+    //! \brief    Engine caps of one feature of the key, written on a hit, read when saved
+    //!
+    struct Feature
+    {
+        VP_EngineEntry              *engineCaps        = nullptr;
+        VPHAL_SCALING_PREFERENCE    *scalingPreference = nullptr;   // scaling only, may be forced by the caps query
+    };
+
+    //!
+    //! \brief    Start a new key
+    //!
+    void ResetKey()
+    {
+        m_key.clear();
+        m_keyHash = m_fnvOffset;
+    }
+
+    //!
+    //! \brief    Append one value to the key
+    //!
+    void AddToKey(uint32_t value)
+    {
+        m_key.push_back(value);
+        m_keyHash = (m_keyHash ^ value) * m_fnvPrime;
+    }
+
+    //!
+    //! \brief    Append the parameters the engine caps of a feature depend on
+    //!
+    void AddCscToKey(const FeatureParamCsc &params)
+    {
+        AddToKey(FeatureTypeCsc);
+        AddToKey(params.formatInput);
+        AddToKey(params.formatOutput);
+        AddToKey(params.input.colorSpace);
+        AddToKey(params.input.chromaSiting);
+        AddToKey(params.output.colorSpace);
+        AddToKey(params.output.chromaSiting);
+        AddToKey(params.pIEFParams ? 1 : 0);
+        AddAlphaParamsToKey(params.pAlphaParams);
+    }
+
+    void AddScalingToKey(const FeatureParamScaling &params)
+    {
+        AddToKey(FeatureTypeScaling);
+        AddToKey(params.formatInput);
+        AddToKey(params.formatOutput);
+        for (auto surf : {&params.input, &params.output})
+        {
+            AddToKey(surf->dwWidth);
+            AddToKey(surf->dwHeight);
+            AddRectToKey(surf->rcSrc);
+            AddRectToKey(surf->rcDst);
+            AddToKey(surf->sampleType);
+        }
+        AddToKey(params.isPrimary ? 1 : 0);
+        AddToKey(params.scalingMode);
+        AddToKey(params.scalingPreference);
+        AddToKey(params.interlacedScalingType);
+        AddToKey(params.pColorFillParams ? 1 : 0);
+        AddToKey(params.pColorFillParams ? params.pColorFillParams->bDisableColorfillinSFC : 0);
+        AddToKey(params.pColorFillParams ? params.pColorFillParams->bOnePixelBiasinSFC : 0);
+        AddAlphaParamsToKey(params.pCompAlpha);
+    }
+
+    void AddRotMirToKey(const FeatureParamRotMir &params)
+    {
+        AddToKey(FeatureTypeRotMir);
+        AddToKey(params.formatInput);
+        AddToKey(params.formatOutput);
+        AddToKey(params.rotation);
+        AddToKey(params.surfInfo.tileOutput);
+    }
+
+    void AddAlphaToKey(const FeatureParamAlpha &params)
+    {
+        AddToKey(FeatureTypeAlpha);
+        AddToKey(params.formatInput);
+        AddToKey(params.formatOutput);
+        AddAlphaParamsToKey(params.compAlpha);
+    }
+
+    //!
+    //! \brief    Look up the engine caps cached for current key
+    //! \return   const std::vector<uint32_t> *
+    //!           Cached caps, nullptr on miss
+    //!
+    const std::vector<uint32_t> *Find()
+    {
+        auto it = m_index.find(m_keyHash);
+        if (it != m_index.end() && it->second->key == m_key)
+        {
+            m_hitCount++;
+            // most recently used first
+            m_entries.splice(m_entries.begin(), m_entries, it->second);
+            return &it->second->caps;
+        }
+        m_missCount++;
+        return nullptr;
+    }
+
+    //!
+    //! \brief    Cache the engine caps resolved for current key
+    //! \details  An entry with the same hash is replaced. Once the cache is full, the least
+    //!           recently used entry is dropped.
+    //!
+    void Add(const std::vector<uint32_t> &caps)
+    {
+        auto it = m_index.find(m_keyHash);
+        if (it != m_index.end())
+        {
+            m_entries.splice(m_entries.begin(), m_entries, it->second);
+        }
+        else
+        {
+            if (m_entries.size() >= VP_POLICY_CAPS_CACHE_MAX_SIZE)
+            {
+                m_index.erase(m_entries.back().keyHash);
+                m_entries.pop_back();
+            }
+            m_entries.emplace_front();
+            m_entries.front().keyHash = m_keyHash;
+            m_index[m_keyHash]        = m_entries.begin();
+        }
+        m_entries.front().key  = m_key;
+        m_entries.front().caps = caps;
+    }
+
+    //!
+    //! \brief    Apply the engine caps cached for current key to its features
+    //! \param    features
+    //!           [in] Features of current key, in key order
+    //! \return   bool
+    //!           false on miss, the features are not changed
+    //!
+    bool Apply(const std::vector<Feature> &features)
+    {
+        const std::vector<uint32_t> *caps = Find();
+        if (nullptr == caps || caps->size() != GetCapsSize(features))
+        {
+            return false;
+        }
+
+        uint32_t i = 0;
+        for (auto &feature : features)
+        {
+            feature.engineCaps->value = (*caps)[i++];
+            if (feature.scalingPreference)
+            {
+                *feature.scalingPreference = (VPHAL_SCALING_PREFERENCE)(*caps)[i++];
+            }
+        }
+        return true;
+    }
+
+    //!
+    //! \brief    Cache the engine caps resolved for the features of current key
+    //! \param    features
+    //!           [in] Features of current key, in key order
+    //!
+    void Save(const std::vector<Feature> &features)
+    {
+        m_caps.clear();
+        for (auto &feature : features)
+        {
+            m_caps.push_back(feature.engineCaps->value);
+            if (feature.scalingPreference)
+            {
+                m_caps.push_back(*feature.scalingPreference);
+            }
+        }
+        Add(m_caps);
+    }
+
+    void Clear()
+    {
+        m_entries.clear();
+        m_index.clear();
+    }
+
+    uint32_t GetSize()
+    {
+        return (uint32_t)m_entries.size();
+    }
+
+    uint64_t GetHitCount()
+    {
+        return m_hitCount;
+    }
+
+    uint64_t GetMissCount()
+    {
+        return m_missCount;
+    }
+
+private:
+    struct Entry
+    {
+        uint64_t                keyHash = 0;
+        std::vector<uint32_t>   key;
+        std::vector<uint32_t>   caps;
+    };
+
+    void AddRectToKey(const RECT &rect)
+    {
+        AddToKey((uint32_t)rect.left);
+        AddToKey((uint32_t)rect.top);
+        AddToKey((uint32_t)rect.right);
+        AddToKey((uint32_t)rect.bottom);
+    }
+
+    void AddAlphaParamsToKey(const VPHAL_ALPHA_PARAMS *alpha)
+    {
+        AddToKey(alpha ? 1 : 0);
+        AddToKey(alpha ? alpha->AlphaMode : 0);
+    }
+
+    static uint32_t GetCapsSize(const std::vector<Feature> &features)
+    {
+        uint32_t size = 0;
+        for (auto &feature : features)
+        {
+            size += feature.scalingPreference ? 2 : 1;
+        }
+        return size;
+    }
+
+    static const uint64_t m_fnvOffset = 0xcbf29ce484222325ull;   // FNV-1a
+    static const uint64_t m_fnvPrime  = 0x100000001b3ull;
+
+    std::list<Entry>                                            m_entries;      // most recently used first
+    std::unordered_map<uint64_t, std::list<Entry>::iterator>    m_index;        // by key hash, key compared on hit
+    std::vector<uint32_t>                                       m_key;
+    std::vector<uint32_t>                                       m_caps;
+    uint64_t                                                    m_keyHash   = m_fnvOffset;
+    uint64_t                                                    m_hitCount  = 0;
+    uint64_t                                                    m_missCount = 0;
+};
+}
+#endif // !__VP_POLICY_CAPS_CACHE_H__
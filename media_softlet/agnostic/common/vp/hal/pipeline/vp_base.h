@@ -166,6 +166,21 @@ public:
     virtual MOS_STATUS GetStatusReportEntryLength(
         uint32_t                         *puiLength) = 0;
 
+    //!
+    //! \brief    Get the index of the first Status Report entry of a frame, counted from head
+    //! \details Not every VP HAL keeps a status table, callers then report the whole table.
+    //! \return   MOS_STATUS
+    //!           MOS_STATUS_UNIMPLEMENTED if the HAL cannot find the frame
+    //!
+    virtual MOS_STATUS GetStatusReportEntryIndex(
+        uint32_t                         statusFeedBackID,
+        uint32_t                         *puiIndex)
+    {
+        MOS_UNUSED(statusFeedBackID);
+        MOS_UNUSED(puiIndex);
+        return MOS_STATUS_UNIMPLEMENTED;
+    }
+
     HANDLE m_gpuAppTaskEvent = nullptr;
 
     VpExtIntfBase *extIntf = nullptr;
@@ -232,6 +232,9 @@ MOS_STATUS VpPipeline::Init(void *mhwInterface)
     VP_PUBLIC_CHK_STATUS_RETURN(CreateFeatureManager());
     VP_PUBLIC_CHK_NULL_RETURN(m_featureManager);
     VP_PUBLIC_CHK_STATUS_RETURN(InitUserFeatureSetting());
+#if (_DEBUG || _RELEASE_INTERNAL)
+    m_forceDecompressedOutputHandle = GetUserSettingHandle(m_userSettingPtr, __VPHAL_RNDR_FORCE_VP_DECOMPRESSED_OUTPUT, MediaUserSetting::Group::Sequence);
+#endif
     VP_PUBLIC_CHK_STATUS_RETURN(CreateVPDebugInterface());
 
     m_vpMhwInterface.m_debugInterface = (void*)m_debugInterface;
@@ -265,6 +268,8 @@ MOS_STATUS VpPipeline::Init(void *mhwInterface)
         m_vpMhwInterface.m_userFeatureControl = m_userFeatureControl;
     }
 
+    m_allocator->SetSurfacePoolLimits(m_userFeatureControl->GetSurfacePoolMaxSize(), m_userFeatureControl->GetSurfacePoolMaxCount());
+
     if (m_vpMhwInterface.m_vpPlatformInterface->IsGpuContextCreatedInPipelineInit())
     {
         if (m_numVebox > 0)
@@ -407,11 +412,10 @@ MOS_STATUS VpPipeline::UpdateExecuteStatus()
         bool uiForceDecompressedOutput = false;
         bool forceDecompressedOutput   = false;
 
-        MOS_STATUS eStatus1 = ReadUserSettingForDebug(
+        MOS_STATUS eStatus1 = ReadUserSetting(
             m_userSettingPtr,
             forceDecompressedOutput,
-            __VPHAL_RNDR_FORCE_VP_DECOMPRESSED_OUTPUT,
-            MediaUserSetting::Group::Sequence);
+            m_forceDecompressedOutputHandle);
 
         if (eStatus1 == MOS_STATUS_SUCCESS)
         {
@@ -353,6 +353,7 @@ protected:
 
     uint8_t                m_numVebox               = 0;
     uint32_t               m_forceMultiplePipe      = 0;
+    MediaUserSetting::Handle m_forceDecompressedOutputHandle = MediaUserSetting::InvalidHandle;  //!< read per frame
     VpAllocator           *m_allocator              = nullptr;  //!< vp Pipeline allocator
     VPMediaMemComp        *m_mmc                    = nullptr;  //!< vp Pipeline mmc
 
@@ -30,6 +30,7 @@
 #include "vp_platform_interface.h"
 #include "vphal_debug.h"
 #include "media_interfaces_mhw_next.h"
+#include "vp_status_table.h"
 
 VpPipelineAdapterBase::VpPipelineAdapterBase(
     vp::VpPlatformInterface &vpPlatformInterface,
@@ -227,6 +228,11 @@ MOS_STATUS VpPipelineAdapterBase::GetStatusReport(
     uint32_t            uiNewHead;
     PVPHAL_STATUS_ENTRY pStatusEntry;
     bool                bMarkNotReadyForRemains = false;
+    bool                bCheckGpuHung           = true;
+    bool                bNullRender             = false;
+    MOS_GPU_CONTEXT     lastGpuContext          = MOS_GPU_CONTEXT_INVALID_HANDLE;
+    uint16_t            lastStreamIndex         = 0;
+    uint32_t            dwLastGpuTag            = 0;
 
     VP_PUBLIC_CHK_NULL(pQueryReport);
     VP_PUBLIC_CHK_NULL(m_osInterface);
@@ -241,6 +247,11 @@ MOS_STATUS VpPipelineAdapterBase::GetStatusReport(
     // entry length from head to tail
     uiTableLen = (pStatusTable->uiCurrent - pStatusTable->uiHead) & (VPHAL_STATUS_TABLE_MAX_SIZE - 1);
 
+#if (_DEBUG || _RELEASE_INTERNAL)
+    MOS_NULL_RENDERING_FLAGS NullRender = m_osInterface->pfnGetNullHWRenderFlags(m_osInterface);
+    bNullRender = (NullRender.Value != 0);
+#endif
+
     // step 1 - update pStatusEntry from driver if command associated with the dwTag is done by gpu
     for (i = 0; i < wStatusNum && i < uiTableLen; i++)
     {
@@ -266,17 +277,16 @@ MOS_STATUS VpPipelineAdapterBase::GetStatusReport(
             continue;
         }
 
-        dwGpuTag            = m_osInterface->pfnGetGpuStatusSyncTag(m_osInterface, pStatusEntry->GpuContextOrdinal);
-        bDoneByGpu          = (dwGpuTag >= pStatusEntry->dwTag);
-        bFailedOnSubmitCmd  = (pStatusEntry->dwStatus == VPREP_ERROR);
-
-#if (_DEBUG || _RELEASE_INTERNAL)
-        MOS_NULL_RENDERING_FLAGS NullRender = m_osInterface->pfnGetNullHWRenderFlags(m_osInterface);
-        if (NullRender.Value != 0)
+        // entries in a row are mostly on one GPU context, read its tag once
+        if (pStatusEntry->GpuContextOrdinal != lastGpuContext || m_osInterface->streamIndex != lastStreamIndex)
         {
-            bDoneByGpu = true;
+            lastGpuContext  = pStatusEntry->GpuContextOrdinal;
+            lastStreamIndex = m_osInterface->streamIndex;
+            dwLastGpuTag    = m_osInterface->pfnGetGpuStatusSyncTag(m_osInterface, lastGpuContext);
         }
-#endif
+        dwGpuTag            = dwLastGpuTag;
+        bDoneByGpu          = (dwGpuTag >= pStatusEntry->dwTag) || bNullRender;
+        bFailedOnSubmitCmd  = (pStatusEntry->dwStatus == VPREP_ERROR);
 
         if (bFailedOnSubmitCmd)
         {
@@ -298,9 +308,14 @@ MOS_STATUS VpPipelineAdapterBase::GetStatusReport(
             bMarkNotReadyForRemains = true;
         }
 
-        if (m_osInterface->pfnIsGPUHung(m_osInterface))
+        // reading the reset stats is an ioctl and a hang is reported only once, so check for the first entry only
+        if (bCheckGpuHung)
         {
-            pStatusEntry->dwStatus = VPREP_NOTREADY;
+            bCheckGpuHung = false;
+            if (m_osInterface->pfnIsGPUHung(m_osInterface))
+            {
+                pStatusEntry->dwStatus = VPREP_NOTREADY;
+            }
         }
 
         pQueryReport[i].dwStatus         = pStatusEntry->dwStatus;
@@ -311,7 +326,7 @@ MOS_STATUS VpPipelineAdapterBase::GetStatusReport(
             m_osInterface->streamIndex = oldStreamIndex;
         }
     }
-    pStatusTable->uiHead = uiNewHead;
+    VpHal_StatusTableSetHead(pStatusTable, uiNewHead);
 
     // step 2 - mark VPREP_NOTAVAILABLE for unused entry
     for (/* continue from previous i */; i < wStatusNum; i++)
@@ -347,3 +362,20 @@ finish:
 #endif
     return eStatus;
 }
+
+MOS_STATUS VpPipelineAdapterBase::GetStatusReportEntryIndex(
+    uint32_t                       statusFeedBackID,
+    uint32_t*                      puiIndex)
+{
+    MOS_STATUS                     eStatus = MOS_STATUS_SUCCESS;
+#if(!EMUL)        // this function is dummy for emul
+    VPHAL_PUBLIC_CHK_NULL(puiIndex);
+
+    *puiIndex = VpHal_StatusTableFindEntry(&m_statusTable, statusFeedBackID);
+finish:
+#else
+    MOS_UNUSED(statusFeedBackID);
+    MOS_UNUSED(puiIndex);
+#endif
+    return eStatus;
+}
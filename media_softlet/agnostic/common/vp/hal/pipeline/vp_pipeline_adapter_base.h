@@ -120,6 +120,19 @@ public:
     virtual MOS_STATUS GetStatusReportEntryLength(
         uint32_t                         *puiLength);
 
+    //!
+    //! \brief    Get the index of the first Status Report entry of a frame, counted from head
+    //! \param    [in] statusFeedBackID
+    //!           StatusFeedBackID of the frame
+    //! \param    [out] puiIndex
+    //!           Pointer to the index, the entry length if no entry has the id
+    //! \return   MOS_STATUS
+    //!           Return MOS_STATUS_SUCCESS if successful, otherwise failed
+    //!
+    virtual MOS_STATUS GetStatusReportEntryIndex(
+        uint32_t                         statusFeedBackID,
+        uint32_t                         *puiIndex);
+
     virtual VphalFeatureReport *GetRenderFeatureReport() = 0;
 
     //!
@@ -137,6 +137,18 @@ MOS_STATUS VpPlatformInterface::InitVPFCKernels(
             patchKernelSize,
             ModifyFunctionPointers);
 
+        // Preload combined kernels built by previous processes (optional)
+        if (vpKernel.GetKdllState())
+        {
+            MediaUserSetting::Value outValue;
+            ReadUserSetting(
+                m_userSettingPtr,
+                outValue,
+                __VPHAL_KDLL_CACHE_DIRECTORY,
+                MediaUserSetting::Group::Sequence);
+            KernelDll_LoadDiskCache(vpKernel.GetKdllState(), outValue.ConstString().c_str());
+        }
+
         m_kernelPool.insert(std::make_pair(vpKernel.GetKernelName(), vpKernel));
     }
 
@@ -30,6 +30,7 @@
 #include "vp_status_report.h"
 #include "mos_utilities.h"
 #include "vp_common.h"
+#include "vp_status_table.h"
 #include "vp_utils.h"
 
 namespace vp
@@ -53,7 +54,6 @@ MOS_STATUS VPStatusReport::UpdateStatusTableAfterSubmit(
     MOS_STATUS                  eLastStatus)
 {
     PVPHAL_STATUS_ENTRY             pStatusEntry;
-    bool                            bEmptyTable;
     MOS_STATUS                      eStatus;
     uint32_t                        dwLastTag;
     PVPHAL_STATUS_TABLE             pStatusTable;
@@ -78,24 +78,12 @@ MOS_STATUS VPStatusReport::UpdateStatusTableAfterSubmit(
     VP_PUBLIC_ASSERT(pStatusTable->uiHead < VPHAL_STATUS_TABLE_MAX_SIZE);
     VP_PUBLIC_ASSERT(pStatusTable->uiCurrent < VPHAL_STATUS_TABLE_MAX_SIZE);
 
-    bEmptyTable = (pStatusTable->uiCurrent == pStatusTable->uiHead);
-    if (!bEmptyTable)
-    {
-        uint32_t uiLast                 = (pStatusTable->uiCurrent - 1) & (VPHAL_STATUS_TABLE_MAX_SIZE - 1);
-        bool bSameFrameIdWithLastRender = (pStatusTable->aTableEntries[uiLast].StatusFeedBackID == dwStatusFeedBackID);
-        if (bSameFrameIdWithLastRender)
-        {
-            pStatusTable->uiCurrent = uiLast;
-        }
-    }
-
-    pStatusEntry                    = &pStatusTable->aTableEntries[pStatusTable->uiCurrent];
-    pStatusEntry->StatusFeedBackID  = dwStatusFeedBackID;
+    // an entry with the same frame id as the last render is reused
+    pStatusEntry                    = VpHal_StatusTableAddEntry(pStatusTable, dwStatusFeedBackID);
     pStatusEntry->GpuContextOrdinal = eMosGpuContext;
     dwLastTag                       = m_osInterface->pfnGetGpuStatusTag(m_osInterface, eMosGpuContext) - 1;
     pStatusEntry->dwTag             = dwLastTag;
     pStatusEntry->dwStatus          = (eLastStatus == MOS_STATUS_SUCCESS)? VPREP_NOTREADY : VPREP_ERROR;
-    pStatusTable->uiCurrent         = (pStatusTable->uiCurrent + 1) & (VPHAL_STATUS_TABLE_MAX_SIZE - 1);
 
 finish:
     return eStatus;
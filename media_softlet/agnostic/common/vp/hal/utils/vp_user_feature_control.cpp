@@ -113,6 +113,31 @@ VpUserFeatureControl::VpUserFeatureControl(MOS_INTERFACE &osInterface, VpPlatfor
     }
     VP_PUBLIC_NORMALMESSAGE("disableAutoDn %d", m_ctrlValDefault.disableAutoDn);
 
+    // Limits of the idle intermediate surfaces kept for reuse
+    uint32_t surfacePoolMaxCount = VP_SURFACE_POOL_MAX_COUNT;
+    status = ReadUserSetting(
+        m_userSettingPtr,
+        surfacePoolMaxCount,
+        __VPHAL_SURFACE_POOL_MAX_COUNT,
+        MediaUserSetting::Group::Sequence);
+    if (MOS_SUCCEEDED(status))
+    {
+        m_ctrlValDefault.surfacePoolMaxCount = surfacePoolMaxCount;
+    }
+
+    uint32_t surfacePoolMaxSizeMb = VP_SURFACE_POOL_MAX_SIZE_MB;
+    status = ReadUserSetting(
+        m_userSettingPtr,
+        surfacePoolMaxSizeMb,
+        __VPHAL_SURFACE_POOL_MAX_SIZE,
+        MediaUserSetting::Group::Sequence);
+    if (MOS_SUCCEEDED(status))
+    {
+        m_ctrlValDefault.surfacePoolMaxSizeMb = surfacePoolMaxSizeMb;
+    }
+    VP_PUBLIC_NORMALMESSAGE("surfacePoolMaxCount %d, surfacePoolMaxSizeMb %d",
+        m_ctrlValDefault.surfacePoolMaxCount, m_ctrlValDefault.surfacePoolMaxSizeMb);
+
     // bComputeContextEnabled is true only if Gen12+. 
     // Gen12+, compute context(MOS_GPU_NODE_COMPUTE, MOS_GPU_CONTEXT_COMPUTE) can be used for render engine.
     // Before Gen12, we only use MOS_GPU_NODE_3D and MOS_GPU_CONTEXT_RENDER.
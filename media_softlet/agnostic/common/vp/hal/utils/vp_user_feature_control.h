@@ -30,6 +30,7 @@
 #include "mos_os.h"
 #include "vp_pipeline_common.h"
 #include "vp_platform_interface.h"
+#include "vp_surface_pool.h"
 
 namespace vp
 {
@@ -48,6 +49,8 @@ public:
         bool computeContextEnabled          = true;
         bool eufusionBypassWaEnabled        = false;
         bool disableAutoDn                  = false;
+        uint32_t surfacePoolMaxCount        = VP_SURFACE_POOL_MAX_COUNT;
+        uint32_t surfacePoolMaxSizeMb       = VP_SURFACE_POOL_MAX_SIZE_MB;
     };
 
     virtual MOS_STATUS Update(PVP_PIPELINE_PARAMS params);
@@ -77,6 +80,16 @@ public:
         return m_ctrlVal.disableAutoDn;
     }
 
+    uint32_t GetSurfacePoolMaxCount()
+    {
+        return m_ctrlVal.surfacePoolMaxCount;
+    }
+
+    uint64_t GetSurfacePoolMaxSize()
+    {
+        return (uint64_t)m_ctrlVal.surfacePoolMaxSizeMb << 20;
+    }
+
     const void *m_owner = nullptr; // The object who create current instance.
 
 protected:
@@ -29,6 +29,7 @@
 #include "media_common_defs.h"
 #include "media_user_setting_configure.h"
 #include "mos_interface.h"
+#include "vp_surface_pool.h"
 
 MOS_SURFACE VpUtils::VpHalConvertVphalSurfaceToMosSurface(PVPHAL_SURFACE surface)
 {
@@ -649,6 +650,27 @@ MOS_STATUS VpUtils::DeclareUserSettings(MediaUserSettingSharedPtr userSettingPtr
         0,
         true);
 
+    DeclareUserSettingKey(  // Directory of the persistent combined kernel cache, empty to disable
+        userSettingPtr,
+        __VPHAL_KDLL_CACHE_DIRECTORY,
+        MediaUserSetting::Group::Sequence,
+        "",
+        false);
+
+    DeclareUserSettingKey(  // Idle intermediate surfaces kept for reuse per VP pipeline, 0 to disable
+        userSettingPtr,
+        __VPHAL_SURFACE_POOL_MAX_COUNT,
+        MediaUserSetting::Group::Sequence,
+        (uint32_t)VP_SURFACE_POOL_MAX_COUNT,
+        false);
+
+    DeclareUserSettingKey(  // MB of idle intermediate surfaces kept for reuse per VP pipeline
+        userSettingPtr,
+        __VPHAL_SURFACE_POOL_MAX_SIZE,
+        MediaUserSetting::Group::Sequence,
+        (uint32_t)VP_SURFACE_POOL_MAX_SIZE_MB,
+        false);
+
 #if (_DEBUG || _RELEASE_INTERNAL)
     DeclareUserSettingKeyForDebug( //Init CP output surface with protected 0.
         userSettingPtr,
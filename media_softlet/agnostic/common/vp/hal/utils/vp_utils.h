@@ -281,6 +281,9 @@ protected:
 #define __VPHAL_RNDR_SSD_CONTROL                                        "SSD Control"
 #define __MEDIA_USER_FEATURE_VALUE_CSC_COEFF_PATCH_MODE_DISABLE         "CSC Patch Mode Disable"
 #define __MEDIA_USER_FEATURE_VALUE_DISABLE_AUTODN                       "Disable AutoDn"
+#define __VPHAL_KDLL_CACHE_DIRECTORY                                    "VP Kernel Cache Directory"
+#define __VPHAL_SURFACE_POOL_MAX_COUNT                                  "VP Surface Pool Max Count"
+#define __VPHAL_SURFACE_POOL_MAX_SIZE                                   "VP Surface Pool Max Size"
 
 #if (_DEBUG || _RELEASE_INTERNAL)
 #define __VPHAL_ENABLE_COMPUTE_CONTEXT                                  "VP Enable Compute Context"
@@ -575,6 +575,9 @@ typedef struct tagKdll_State
     // Colorfill
     VPHAL_CSPACE colorfill_cspace;  // Selected colorfill Color Space by Kdll
 
+    // Persistent combined kernel cache
+    struct tagKdll_DiskCache *pDiskCache;  // nullptr if disabled
+
     // Start kernel search
     void (*pfnStartKernelSearch)(PKdll_State pState,
         PKdll_SearchState                    pSearchState,
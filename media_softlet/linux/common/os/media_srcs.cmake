@@ -31,6 +31,7 @@ set(TMP_SOURCES_
     ${CMAKE_CURRENT_LIST_DIR}/mos_decompression.cpp
     ${CMAKE_CURRENT_LIST_DIR}/mos_mediacopy.cpp
     ${CMAKE_CURRENT_LIST_DIR}/mos_user_setting_specific.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/mos_system_shadow.cpp
 )
 
 set(TMP_HEADERS_
@@ -40,6 +41,8 @@ set(TMP_HEADERS_
     ${CMAKE_CURRENT_LIST_DIR}/mos_commandbuffer_specific_next.h
     ${CMAKE_CURRENT_LIST_DIR}/mos_gpucontext_specific_next.h
     ${CMAKE_CURRENT_LIST_DIR}/mos_decompression.h
+    ${CMAKE_CURRENT_LIST_DIR}/mos_bo_index_map.h
+    ${CMAKE_CURRENT_LIST_DIR}/mos_system_shadow.h
     ${CMAKE_CURRENT_LIST_DIR}/media_skuwa_specific.h
 )
 
@@ -0,0 +1,122 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//!
+//! \file        mos_bo_index_map.h
+//! \brief       Map from bo to allocation index of one submission
+//! \details     Self-contained, so devult tests it directly.
+//!
+#ifndef __MOS_BO_INDEX_MAP_H__
+#define __MOS_BO_INDEX_MAP_H__
+
+#include <stdint.h>
+#include <string.h>
+
+//!
+//! \brief    Open addressed map from bo to allocation index, probed linearly
+//! \details  Holds up to maxIndexes bos, in a table twice as large, so a probe
+//!           always ends at an empty entry. Entries are tagged with an epoch,
+//!           Reset() only bumps the epoch and the table is cleared when the
+//!           16-bit epoch wraps.
+//!
+template <uint32_t maxIndexes>
+class MosBoIndexMap
+{
+public:
+    MosBoIndexMap()
+    {
+        memset(m_entries, 0, sizeof(m_entries));
+    }
+
+    //!
+    //! \brief    Add bo with index
+    //! \details  bo must not be in the map, and the map must hold less than maxIndexes bos
+    //! \param    [in] bo
+    //!           Key, nullptr is a valid key
+    //! \param    [in] index
+    //!           Index of bo, less than maxIndexes
+    //!
+    void Add(const void *bo, uint32_t index)
+    {
+        Entry *entry = FindEntry(bo);
+        entry->bo    = bo;
+        entry->tag   = (m_epoch << 16) | (index + 1);
+    }
+
+    //!
+    //! \brief    Find the index of bo
+    //! \return   int32_t
+    //!           Index of bo, -1 if bo is not in the map
+    //!
+    int32_t Find(const void *bo)
+    {
+        Entry *entry = FindEntry(bo);
+        return ((entry->tag >> 16) == m_epoch) ? (int32_t)(entry->tag & 0xffff) - 1 : -1;
+    }
+
+    //!
+    //! \brief    Drop all entries
+    //!
+    void Reset()
+    {
+        m_epoch = (m_epoch + 1) & 0xffff;
+        if (m_epoch == 0)
+        {
+            memset(m_entries, 0, sizeof(m_entries));
+            m_epoch = 1;
+        }
+    }
+
+private:
+    struct Entry
+    {
+        const void *bo;
+        uint32_t    tag;  //!< epoch << 16 | (index + 1), entries of an older epoch are empty
+    };
+
+    static constexpr uint32_t m_size = 2 * maxIndexes;
+    static_assert((m_size & (m_size - 1)) == 0, "bo index map size must be power of 2");
+    static_assert(maxIndexes < 0xffff, "index must fit in 16 bits of map entry");
+
+    Entry *FindEntry(const void *bo)
+    {
+        uint64_t key = (uint64_t)(uintptr_t)bo;
+        key ^= key >> 33;
+        key *= 0xff51afd7ed558ccdULL;
+        key ^= key >> 33;
+
+        uint32_t mask = m_size - 1;
+        for (uint32_t slot = (uint32_t)key & mask; ; slot = (slot + 1) & mask)
+        {
+            Entry *entry = &m_entries[slot];
+            if ((entry->tag >> 16) != m_epoch || entry->bo == bo)
+            {
+                return entry;
+            }
+        }
+    }
+
+    Entry    m_entries[m_size];
+    uint32_t m_epoch = 1;
+};
+
+#endif  // __MOS_BO_INDEX_MAP_H__
@@ -149,6 +149,9 @@ MOS_STATUS GpuContextSpecificNext::Init(OsContextNext *osContext,
     m_writeModeList = (bool *)MOS_AllocAndZeroMemory(sizeof(bool) * ALLOCATIONLIST_SIZE);
     MOS_OS_CHK_NULL_RETURN(m_writeModeList);
 
+    m_allocationIndexMap = MOS_New(MosBoIndexMap<ALLOCATIONLIST_SIZE>);
+    MOS_OS_CHK_NULL_RETURN(m_allocationIndexMap);
+
     m_GPUStatusTag = 1;
 
     m_createOptionEnhanced = (MOS_GPUCTX_CREATOPTIONS_ENHANCED*)MOS_AllocAndZeroMemory(sizeof(MOS_GPUCTX_CREATOPTIONS_ENHANCED));
@@ -448,6 +451,7 @@ void GpuContextSpecificNext::Clear()
     MOS_SafeFreeMemory(m_patchLocationList);
     MOS_SafeFreeMemory(m_attachedResources);
     MOS_SafeFreeMemory(m_writeModeList);
+    MOS_Delete(m_allocationIndexMap);
     MOS_SafeFreeMemory(m_createOptionEnhanced);
 
     for (int i=0; i<MAX_ENGINE_INSTANCE_NUM; i++)
@@ -471,24 +475,18 @@ MOS_STATUS GpuContextSpecificNext::RegisterResource(
     MOS_OS_CHK_NULL_RETURN(osResource);
 
     MOS_OS_CHK_NULL_RETURN(m_attachedResources);
+    MOS_OS_CHK_NULL_RETURN(m_allocationIndexMap);
 
-    PMOS_RESOURCE registeredResources = m_attachedResources;
-    uint32_t      allocationIndex     = 0;
-
-    for ( allocationIndex = 0; allocationIndex < m_resCount; allocationIndex++, registeredResources++)
-    {
-        if (osResource->bo == registeredResources->bo)
-        {
-            break;
-        }
-    }
+    int32_t  registeredIndex = m_allocationIndexMap->Find(osResource->bo);
+    uint32_t allocationIndex = (registeredIndex >= 0) ? (uint32_t)registeredIndex : m_resCount;
 
     // Allocation list to be updated
     if (allocationIndex < m_maxNumAllocations)
     {
         // New buffer
-        if (allocationIndex == m_resCount)
+        if (registeredIndex < 0)
         {
+            m_allocationIndexMap->Add(osResource->bo, allocationIndex);
             m_resCount++;
         }
 
@@ -1038,17 +1036,14 @@ MOS_STATUS GpuContextSpecificNext::SubmitCommandBuffer(
                 it++;
             }
 
-            for(auto allocIdx = 0; allocIdx < m_numAllocations && (!isSecondaryCmdBuf); allocIdx++)
+            int32_t allocIdx = isSecondaryCmdBuf ? -1 : m_allocationIndexMap->Find(tempCmdBo);
+            if (allocIdx >= 0 && (uint32_t)allocIdx < m_numAllocations)
             {
                 auto tempRes = (PMOS_RESOURCE)m_allocationList[allocIdx].hAllocation;
-                if (tempCmdBo == tempRes->bo)
-                {
-                    GraphicsResourceNext::LockParams param;
-                    param.m_writeRequest = true;
-                    tempRes->pGfxResourceNext->Lock(m_osContext, param);
-                    mappedResList.push_back(tempRes);
-                    break;
-                }
+                GraphicsResourceNext::LockParams param;
+                param.m_writeRequest = true;
+                tempRes->pGfxResourceNext->Lock(m_osContext, param);
+                mappedResList.push_back(tempRes);
             }
         }
 
@@ -1428,6 +1423,10 @@ if (streamState->dumpCommandBuffer)
     m_currentNumPatchLocations = 0;
     MosUtilities::MosZeroMemory(m_patchLocationList, sizeof(PATCHLOCATIONLIST) * m_maxNumAllocations);
     m_resCount = 0;
+    if (m_allocationIndexMap)
+    {
+        m_allocationIndexMap->Reset();
+    }
 
     MosUtilities::MosZeroMemory(m_writeModeList, sizeof(bool) * m_maxNumAllocations);
 finish:
@@ -1647,6 +1646,10 @@ void GpuContextSpecificNext::ResetGpuContextStatus()
 
     MosUtilities::MosZeroMemory(m_attachedResources, sizeof(MOS_RESOURCE) * ALLOCATIONLIST_SIZE);
     m_resCount = 0;
+    if (m_allocationIndexMap)
+    {
+        m_allocationIndexMap->Reset();
+    }
 
     MosUtilities::MosZeroMemory(m_writeModeList, sizeof(bool) * ALLOCATIONLIST_SIZE);
 
@@ -30,6 +30,7 @@
 #include "mos_gpucontext_next.h"
 #include "mos_graphicsresource_specific_next.h"
 #include "mos_oca_interface_specific.h"
+#include "mos_bo_index_map.h"
 
 #define ENGINE_INSTANCE_SELECT_ENABLE_MASK                   0xFF
 #define ENGINE_INSTANCE_SELECT_COMPUTE_INSTANCE_SHIFT        16
@@ -298,6 +299,8 @@ private:
     PMOS_RESOURCE m_attachedResources = nullptr;  //!< Pointer to resources list
     bool         *m_writeModeList     = nullptr;  //!< Write mode
 
+    MosBoIndexMap<ALLOCATIONLIST_SIZE> *m_allocationIndexMap = nullptr;  //!< bo to index in m_attachedResources
+
     //! \brief    GPU Status tag
     uint32_t m_GPUStatusTag = 0;
 
@@ -487,21 +487,19 @@ void* GraphicsResourceSpecificNext::Lock(OsContextNext* osContextPtr, LockParams
                     {
                         mos_bo_map(boPtr, ( OSKM_LOCKFLAG_WRITEONLY & params.m_writeRequest ));
                         m_mmapOperation = MOS_MMAP_OPERATION_MMAP;
-                        if (m_systemShadow == nullptr)
-                        {
-                            m_systemShadow = (uint8_t *)MOS_AllocMemory(boPtr->size);
-                            MOS_OS_CHECK_CONDITION((m_systemShadow == nullptr), "Failed to allocate shadow surface", nullptr);
-                        }
-                        if (m_systemShadow)
+                        MOS_OS_CHECK_CONDITION((m_tileType != MOS_TILE_Y), "Unsupported tile type", nullptr);
+                        MOS_OS_CHECK_CONDITION((boPtr->size <= 0 || m_pitch <= 0), "Invalid BO size or pitch", nullptr);
+                        if (m_systemShadow.GetData() == nullptr)
                         {
                             int32_t flags = pOsContextSpecific->GetTileYFlag() ? 0 : 1;
                             uint64_t surfSize = m_gmmResInfo->GetSizeMainSurface();
-                            MOS_OS_CHECK_CONDITION((m_tileType != MOS_TILE_Y), "Unsupported tile type", nullptr);
-                            MOS_OS_CHECK_CONDITION((boPtr->size <= 0 || m_pitch <= 0), "Invalid BO size or pitch", nullptr);
-                            MosUtilities::MosSwizzleData((uint8_t*)boPtr->virt, m_systemShadow,
-                                            MOS_TILE_Y, MOS_TILE_LINEAR,
-                                            (int32_t)(surfSize / m_pitch), m_pitch, flags);
+                            MOS_OS_CHECK_CONDITION((m_systemShadow.Allocate(boPtr->size, m_pitch, (uint32_t)(surfSize / m_pitch), flags) != MOS_STATUS_SUCCESS),
+                                "Failed to allocate shadow surface", nullptr);
                         }
+                        // only the locked rows are de-swizzled, a read only lock leaves them as they are on Unlock()
+                        MOS_OS_CHECK_CONDITION((m_systemShadow.Update((uint8_t *)boPtr->virt, params.m_lockOffsetY, params.m_lockHeight,
+                                                   !(params.m_readRequest && !params.m_writeRequest), params.m_writeDiscard) != MOS_STATUS_SUCCESS),
+                            "Failed to update shadow surface", nullptr);
                     }
                     else
                     {
@@ -521,7 +519,14 @@ void* GraphicsResourceSpecificNext::Lock(OsContextNext* osContextPtr, LockParams
                 }
             }
             m_mapped = true;
-            m_pData  = m_systemShadow ? m_systemShadow : (uint8_t *)boPtr->virt;
+            m_pData  = m_systemShadow.GetData() ? m_systemShadow.GetData() : (uint8_t *)boPtr->virt;
+        }
+        else if (m_systemShadow.GetData())
+        {
+            // nested lock, de-swizzle the rows of its band not locked before
+            MOS_OS_CHECK_CONDITION((m_systemShadow.Update((uint8_t *)boPtr->virt, params.m_lockOffsetY, params.m_lockHeight,
+                                       !(params.m_readRequest && !params.m_writeRequest), params.m_writeDiscard) != MOS_STATUS_SUCCESS),
+                "Failed to update shadow surface", nullptr);
         }
 
         dataPtr = m_pData;
@@ -561,15 +566,10 @@ MOS_STATUS GraphicsResourceSpecificNext::Unlock(OsContextNext* osContextPtr)
            else
            {
 
-               if (m_systemShadow)
+               if (m_systemShadow.GetData())
                {
-                   int32_t flags = pOsContextSpecific->GetTileYFlag() ? 0 : 1;
-                   uint64_t surfSize = m_gmmResInfo->GetSizeMainSurface();
-                   MosUtilities::MosSwizzleData(m_systemShadow, (uint8_t*)boPtr->virt,
-                                   MOS_TILE_LINEAR, MOS_TILE_Y,
-                                   (int32_t)(surfSize / m_pitch), m_pitch, flags);
-                   MOS_FreeMemory(m_systemShadow);
-                   m_systemShadow = nullptr;
+                   m_systemShadow.Flush((uint8_t *)boPtr->virt);
+                   m_systemShadow.Free();
                }
 
                switch(m_mmapOperation)
@@ -948,7 +948,11 @@ void* GraphicsResourceSpecificNext::LockExternalResource(
                             int32_t swizzleflags = perStreamParameters->bTileYFlag ? 0 : 1;
                             MOS_OS_CHECK_CONDITION((resource->TileType != MOS_TILE_Y), "Unsupported tile type", nullptr);
                             MOS_OS_CHECK_CONDITION((bo->size <= 0 || resource->iPitch <= 0), "Invalid BO size or pitch", nullptr);
-                            MosUtilities::MosSwizzleData((uint8_t *)bo->virt, resource->pSystemShadow, MOS_TILE_Y, MOS_TILE_LINEAR, bo->size / resource->iPitch, resource->iPitch, swizzleflags);
+                            // the whole surface is overwritten, nothing to de-swizzle
+                            if (!flags->WriteDiscard)
+                            {
+                                MosUtilities::MosSwizzleData((uint8_t *)bo->virt, resource->pSystemShadow, MOS_TILE_Y, MOS_TILE_LINEAR, bo->size / resource->iPitch, resource->iPitch, swizzleflags);
+                            }
                         }
                     }
                     else
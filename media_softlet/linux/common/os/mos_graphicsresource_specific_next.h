@@ -28,6 +28,7 @@
 #define __GRAPHICS_RESOURCE_SPECIFIC_NEXT_H__
 
 #include "mos_graphicsresource_next.h"
+#include "mos_system_shadow.h"
 
 class GraphicsResourceSpecificNext : public GraphicsResourceNext
 {
@@ -242,7 +243,7 @@ private:
     //!
     HybridSem m_hybridSem = {};
 
-    uint8_t*  m_systemShadow = nullptr;     //!< System shadow surface for s/w untiling
+    MosSystemShadow m_systemShadow;         //!< System shadow surface for s/w untiling
 MEDIA_CLASS_DEFINE_END(GraphicsResourceSpecificNext)
 };
 #endif // #ifndef __GRAPHICS_RESOURCE_SPECIFIC_NEXT_H__
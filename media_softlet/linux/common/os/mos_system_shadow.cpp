@@ -0,0 +1,143 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file        mos_system_shadow.cpp
+//! \brief       Linear system memory copy of a TileY surface for s/w swizzled locks
+//!
+
+#include "mos_system_shadow.h"
+#include "mos_os.h"
+#include "mos_utilities.h"
+
+MOS_STATUS MosSystemShadow::Allocate(uint64_t size, uint32_t pitch, uint32_t height, int32_t swizzleFlags)
+{
+    MOS_OS_CHECK_CONDITION((pitch == 0 || height == 0 || size < (uint64_t)pitch * height),
+        "Invalid shadow size, pitch or height", MOS_STATUS_INVALID_PARAMETER);
+
+    Free();
+    m_data = (uint8_t *)MOS_AllocMemory(size);
+    MOS_OS_CHK_NULL_RETURN(m_data);
+
+    m_pitch        = pitch;
+    m_height       = height;
+    m_swizzleFlags = swizzleFlags;
+    m_tileRowState.assign((height + m_tileRowHeight - 1) / m_tileRowHeight, 0);
+
+    return MOS_STATUS_SUCCESS;
+}
+
+MOS_STATUS MosSystemShadow::Update(uint8_t *tiled, uint32_t offsetY, uint32_t height, bool write, bool writeDiscard)
+{
+    MOS_OS_CHK_NULL_RETURN(tiled);
+    MOS_OS_CHK_NULL_RETURN(m_data);
+    MOS_OS_CHECK_CONDITION((offsetY >= m_height), "Lock band starts below the surface", MOS_STATUS_INVALID_PARAMETER);
+
+    uint32_t endY = (height == 0 || height > m_height - offsetY) ? m_height : offsetY + height;
+    uint32_t first = offsetY / m_tileRowHeight;
+    uint32_t last  = (endY + m_tileRowHeight - 1) / m_tileRowHeight;
+
+    // discarded rows are written by the caller
+    write = write || writeDiscard;
+
+    uint32_t runStart = last;
+    for (uint32_t row = first; row <= last; row++)
+    {
+        bool load = false;
+        if (row < last && !(m_tileRowState[row] & tileRowValid))
+        {
+            uint32_t rowStartY = row * m_tileRowHeight;
+            uint32_t rowEndY   = MOS_MIN(rowStartY + m_tileRowHeight, m_height);
+            load = !(writeDiscard && rowStartY >= offsetY && rowEndY <= endY);
+        }
+
+        if (load && runStart == last)
+        {
+            runStart = row;
+        }
+        else if (!load && runStart != last)
+        {
+            SwizzleTileRows(tiled, runStart, row, true);
+            runStart = last;
+        }
+
+        if (row < last)
+        {
+            m_tileRowState[row] |= tileRowValid | (write ? tileRowDirty : 0);
+        }
+    }
+
+    return MOS_STATUS_SUCCESS;
+}
+
+void MosSystemShadow::Flush(uint8_t *tiled)
+{
+    if (tiled == nullptr || m_data == nullptr)
+    {
+        return;
+    }
+
+    uint32_t rows     = (uint32_t)m_tileRowState.size();
+    uint32_t runStart = rows;
+    for (uint32_t row = 0; row <= rows; row++)
+    {
+        bool dirty = row < rows && (m_tileRowState[row] & tileRowDirty);
+        if (dirty && runStart == rows)
+        {
+            runStart = row;
+        }
+        else if (!dirty && runStart != rows)
+        {
+            SwizzleTileRows(tiled, runStart, row, false);
+            runStart = rows;
+        }
+
+        if (dirty)
+        {
+            m_tileRowState[row] &= ~tileRowDirty;
+        }
+    }
+}
+
+void MosSystemShadow::Free()
+{
+    MOS_FreeMemAndSetNull(m_data);
+    m_pitch  = 0;
+    m_height = 0;
+    m_tileRowState.clear();
+}
+
+void MosSystemShadow::SwizzleTileRows(uint8_t *tiled, uint32_t first, uint32_t last, bool toLinear)
+{
+    uint32_t startY = first * m_tileRowHeight;
+    uint32_t endY   = MOS_MIN(last * m_tileRowHeight, m_height);
+
+    if (toLinear)
+    {
+        MosUtilities::MosSwizzleDataRows(tiled, m_data, MOS_TILE_Y, MOS_TILE_LINEAR,
+            (int32_t)startY, (int32_t)(endY - startY), (int32_t)m_pitch, m_swizzleFlags);
+    }
+    else
+    {
+        MosUtilities::MosSwizzleDataRows(m_data, tiled, MOS_TILE_LINEAR, MOS_TILE_Y,
+            (int32_t)startY, (int32_t)(endY - startY), (int32_t)m_pitch, m_swizzleFlags);
+    }
+}
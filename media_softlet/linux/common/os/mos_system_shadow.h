@@ -0,0 +1,122 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+//!
+//! \file        mos_system_shadow.h
+//! \brief       Linear system memory copy of a TileY surface for s/w swizzled locks
+//! \details     Tracked per tile row, so a lock only de-swizzles the rows it
+//!              accesses and Unlock() only swizzles back the rows written.
+//!
+#ifndef __MOS_SYSTEM_SHADOW_H__
+#define __MOS_SYSTEM_SHADOW_H__
+
+#include <vector>
+#include "mos_defs.h"
+
+//!
+//! \brief    System shadow of one TileY surface
+//! \details  Every tile row (32 surface rows) is either not yet de-swizzled,
+//!           valid, or valid and dirty. Rows outside the bands passed to
+//!           Update() are never read from or written back to the surface.
+//!
+class MosSystemShadow
+{
+public:
+    static const uint32_t m_tileRowHeight = 32;  //!< Surface rows per TileY tile row
+
+    MosSystemShadow() {}
+
+    ~MosSystemShadow()
+    {
+        Free();
+    }
+
+    //!
+    //! \brief    Allocate the shadow, no row is valid yet
+    //! \param    [in] size
+    //!           Shadow size in bytes, at least pitch * height
+    //! \param    [in] pitch
+    //!           Surface pitch, multiple of the tile width
+    //! \param    [in] height
+    //!           Surface rows to swizzle
+    //! \param    [in] swizzleFlags
+    //!           extFlags passed to MosUtilities::MosSwizzleDataRows()
+    //! \return   MOS_STATUS
+    //!
+    MOS_STATUS Allocate(uint64_t size, uint32_t pitch, uint32_t height, int32_t swizzleFlags);
+
+    //!
+    //! \brief    Make rows [offsetY, offsetY + height) of the shadow valid
+    //! \details  De-swizzles the tile rows of the band that are not valid yet,
+    //!           except the ones a write discard band fully covers. The tile
+    //!           rows of a write band are swizzled back by Flush().
+    //! \param    [in] tiled
+    //!           Mapped surface
+    //! \param    [in] offsetY
+    //!           First row of the band
+    //! \param    [in] height
+    //!           Rows of the band, 0 means up to the last surface row
+    //! \param    [in] write
+    //!           The band is written
+    //! \param    [in] writeDiscard
+    //!           Every byte of the band is written before it is read
+    //! \return   MOS_STATUS
+    //!
+    MOS_STATUS Update(uint8_t *tiled, uint32_t offsetY, uint32_t height, bool write, bool writeDiscard);
+
+    //!
+    //! \brief    Swizzle the dirty tile rows back to the surface
+    //! \param    [in] tiled
+    //!           Mapped surface
+    //!
+    void Flush(uint8_t *tiled);
+
+    //!
+    //! \brief    Free the shadow, dirty rows are dropped
+    //!
+    void Free();
+
+    uint8_t *GetData()
+    {
+        return m_data;
+    }
+
+private:
+    enum TileRowState
+    {
+        tileRowValid = 1,
+        tileRowDirty = 2,
+    };
+
+    //!
+    //! \brief    Swizzle tile rows [first, last) from or to the surface
+    //!
+    void SwizzleTileRows(uint8_t *tiled, uint32_t first, uint32_t last, bool toLinear);
+
+    uint8_t             *m_data         = nullptr;
+    uint32_t             m_pitch        = 0;
+    uint32_t             m_height       = 0;
+    int32_t              m_swizzleFlags = 0;
+    std::vector<uint8_t> m_tileRowState;
+};
+
+#endif  // __MOS_SYSTEM_SHADOW_H__
@@ -0,0 +1,423 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     mos_trace_ring_specific.cpp
+//! \brief    Ring buffer trace event backend for Linux
+//! \details  Trace events are appended to lock-free per-thread rings and drained by
+//!           a background thread into a memory-mapped binary file.
+//!
+
+#include "mos_trace_ring_specific.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <chrono>
+#include <new>
+
+#define MOS_TRACE_RING_ALIGN(size) (((size) + MOS_TRACE_RING_RECORD_ALIGN - 1) & ~(uint64_t)(MOS_TRACE_RING_RECORD_ALIGN - 1))
+
+std::atomic<bool>                     MosTraceRing::m_open(false);
+std::mutex                            MosTraceRing::m_ringMutex;
+std::vector<MosTraceRing::Ring *>     MosTraceRing::m_rings;
+uint32_t                              MosTraceRing::m_ringSize = MOS_TRACE_RING_DEFAULT_RING_SIZE;
+std::mutex                            MosTraceRing::m_drainMutex;
+std::condition_variable               MosTraceRing::m_drainCond;
+bool                                  MosTraceRing::m_drainStop = false;
+std::thread                           MosTraceRing::m_drainThread;
+int                                   MosTraceRing::m_fd        = -1;
+uint8_t                               *MosTraceRing::m_map      = nullptr;
+uint64_t                              MosTraceRing::m_mapSize   = 0;
+uint64_t                              MosTraceRing::m_dataSize  = 0;
+std::atomic<uint64_t>                 MosTraceRing::m_droppedCount(0);
+uint32_t                              MosTraceRing::m_fileCount = 0;
+char                                  MosTraceRing::m_filePath[PATH_MAX] = {};
+
+MosTraceRing::RingOwner::~RingOwner()
+{
+    // The ring outlives the thread; it is drained, then reused or freed on close
+    if (ring)
+    {
+        ring->owned.store(false, std::memory_order_release);
+    }
+}
+
+uint64_t MosTraceRing::GetTimeNs()
+{
+    struct timespec ts = {};
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+bool MosTraceRing::Open(const char *path, uint32_t ringSize, uint64_t fileSize)
+{
+    if (path == nullptr || fileSize <= sizeof(MOS_TRACE_RING_FILE_HEADER))
+    {
+        return false;
+    }
+
+    Close();
+
+    int len = snprintf(m_filePath, sizeof(m_filePath), "%s.%u.%u", path, (uint32_t)getpid(), m_fileCount++);
+    if (len < 0 || len >= (int)sizeof(m_filePath))
+    {
+        m_filePath[0] = '\0';
+        return false;
+    }
+    m_fd = open(m_filePath, O_RDWR | O_CREAT | O_EXCL | O_NOFOLLOW | O_CLOEXEC, 0644);
+    if (m_fd < 0)
+    {
+        return false;
+    }
+
+    // Sparse file, only the written part takes space
+    if (ftruncate(m_fd, fileSize) != 0)
+    {
+        close(m_fd);
+        m_fd = -1;
+        return false;
+    }
+    m_map = (uint8_t *)mmap(nullptr, fileSize, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+    if (m_map == MAP_FAILED)
+    {
+        m_map = nullptr;
+        close(m_fd);
+        m_fd = -1;
+        return false;
+    }
+    m_mapSize  = fileSize;
+    m_dataSize = 0;
+    m_droppedCount.store(0, std::memory_order_relaxed);
+
+    MOS_TRACE_RING_FILE_HEADER *header = (MOS_TRACE_RING_FILE_HEADER *)m_map;
+    header->magic        = MOS_TRACE_RING_FILE_MAGIC;
+    header->version      = MOS_TRACE_RING_FILE_VERSION;
+    header->headerSize   = sizeof(MOS_TRACE_RING_FILE_HEADER);
+    header->pid          = (uint32_t)getpid();
+    header->dataSize     = 0;
+    header->droppedCount = 0;
+    header->startTime    = GetTimeNs();
+
+    // Power of 2 ring, at least one max size record
+    m_ringSize = 4096;
+    while (m_ringSize < ringSize && m_ringSize < MOS_TRACE_RING_MAX_RING_SIZE)
+    {
+        m_ringSize <<= 1;
+    }
+
+    {
+        // Discard what rings kept from a previous file
+        std::lock_guard<std::mutex> lock(m_ringMutex);
+        for (auto ring : m_rings)
+        {
+            ring->tail.store(ring->head.load(std::memory_order_acquire), std::memory_order_release);
+            ring->droppedReported = ring->dropped.load(std::memory_order_relaxed);
+        }
+    }
+
+    m_drainStop = false;
+    try
+    {
+        m_drainThread = std::thread(DrainThread);
+    }
+    catch (...)
+    {
+        munmap(m_map, m_mapSize);
+        m_map = nullptr;
+        close(m_fd);
+        m_fd = -1;
+        return false;
+    }
+
+    m_open.store(true, std::memory_order_release);
+    return true;
+}
+
+void MosTraceRing::Close()
+{
+    if (!m_open.exchange(false, std::memory_order_acq_rel))
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_drainMutex);
+        m_drainStop = true;
+    }
+    m_drainCond.notify_one();
+    if (m_drainThread.joinable())
+    {
+        m_drainThread.join();
+    }
+
+    Drain();
+
+    {
+        // Free the rings of exited threads, live threads keep theirs
+        std::lock_guard<std::mutex> lock(m_ringMutex);
+        auto it = m_rings.begin();
+        while (it != m_rings.end())
+        {
+            Ring *ring = *it;
+            if (ring->owned.load(std::memory_order_acquire))
+            {
+                ++it;
+                continue;
+            }
+            free(ring->buffer);
+            delete ring;
+            it = m_rings.erase(it);
+        }
+    }
+
+    uint64_t fileSize = sizeof(MOS_TRACE_RING_FILE_HEADER) + m_dataSize;
+    munmap(m_map, m_mapSize);
+    m_map     = nullptr;
+    m_mapSize = 0;
+    if (ftruncate(m_fd, fileSize) != 0)
+    {
+        // keep the sparse tail, the header still tells the data size
+    }
+    close(m_fd);
+    m_fd = -1;
+}
+
+uint64_t MosTraceRing::GetDroppedCount()
+{
+    return m_droppedCount.load(std::memory_order_relaxed);
+}
+
+MosTraceRing::Ring *MosTraceRing::GetThreadRing()
+{
+    static thread_local RingOwner owner;
+
+    if (owner.ring)
+    {
+        return owner.ring;
+    }
+
+    std::lock_guard<std::mutex> lock(m_ringMutex);
+
+    // Reuse the ring of an exited thread
+    Ring *ring = nullptr;
+    for (auto candidate : m_rings)
+    {
+        if (!candidate->owned.load(std::memory_order_acquire))
+        {
+            ring = candidate;
+            break;
+        }
+    }
+
+    if (ring == nullptr)
+    {
+        ring = new (std::nothrow) Ring();
+        if (ring == nullptr)
+        {
+            return nullptr;
+        }
+        ring->buffer = (uint8_t *)calloc(1, m_ringSize);
+        if (ring->buffer == nullptr)
+        {
+            delete ring;
+            return nullptr;
+        }
+        ring->size = m_ringSize;
+        ring->head.store(0, std::memory_order_relaxed);
+        ring->tail.store(0, std::memory_order_relaxed);
+        ring->dropped.store(0, std::memory_order_relaxed);
+        ring->droppedReported = 0;
+        m_rings.push_back(ring);
+    }
+
+    ring->tid = (uint32_t)syscall(SYS_gettid);
+    ring->owned.store(true, std::memory_order_release);
+    owner.ring = ring;
+    return ring;
+}
+
+void MosTraceRing::CopyToRing(Ring *ring, uint64_t pos, const void *src, uint32_t size)
+{
+    uint32_t offset = (uint32_t)(pos & (ring->size - 1));
+    uint32_t first  = ring->size - offset;
+
+    if (size <= first)
+    {
+        memcpy(ring->buffer + offset, src, size);
+    }
+    else
+    {
+        memcpy(ring->buffer + offset, src, first);
+        memcpy(ring->buffer, (const uint8_t *)src + first, size - first);
+    }
+}
+
+void MosTraceRing::CopyFromRing(const Ring *ring, uint64_t pos, void *dst, uint32_t size)
+{
+    uint32_t offset = (uint32_t)(pos & (ring->size - 1));
+    uint32_t first  = ring->size - offset;
+
+    if (size <= first)
+    {
+        memcpy(dst, ring->buffer + offset, size);
+    }
+    else
+    {
+        memcpy(dst, ring->buffer + offset, first);
+        memcpy((uint8_t *)dst + first, ring->buffer, size - first);
+    }
+}
+
+void MosTraceRing::Write(const void *event, uint32_t size)
+{
+    if (event == nullptr || size > UINT16_MAX)
+    {
+        return;
+    }
+
+    Ring *ring = GetThreadRing();
+    if (ring == nullptr)
+    {
+        return;
+    }
+
+    uint32_t recordSize = (uint32_t)MOS_TRACE_RING_ALIGN(sizeof(MOS_TRACE_RING_RECORD) + size);
+    uint64_t head       = ring->head.load(std::memory_order_relaxed);
+    uint64_t used       = head - ring->tail.load(std::memory_order_acquire);
+    if (used + recordSize > ring->size)
+    {
+        ring->dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    MOS_TRACE_RING_RECORD record;
+    record.size      = (uint16_t)size;
+    record.type      = MOS_TRACE_RING_RECORD_EVENT;
+    record.tid       = ring->tid;
+    record.timestamp = GetTimeNs();
+
+    CopyToRing(ring, head, &record, sizeof(record));
+    CopyToRing(ring, head + sizeof(record), event, size);
+
+    // Publish the record to the drain thread
+    ring->head.store(head + recordSize, std::memory_order_release);
+
+    // Wake the drain thread early on bursts rather than waiting for the interval
+    if (used <= ring->size / 2 && used + recordSize > ring->size / 2)
+    {
+        m_drainCond.notify_one();
+    }
+}
+
+uint8_t *MosTraceRing::ReserveFile(uint32_t size)
+{
+    uint64_t offset = sizeof(MOS_TRACE_RING_FILE_HEADER) + m_dataSize;
+    if (offset + size > m_mapSize)
+    {
+        return nullptr;
+    }
+    m_dataSize += size;
+    return m_map + offset;
+}
+
+void MosTraceRing::DrainRing(Ring *ring)
+{
+    uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+    uint64_t head = ring->head.load(std::memory_order_acquire);
+
+    // Records are stored in the ring exactly as in the file
+    while (tail < head)
+    {
+        MOS_TRACE_RING_RECORD record;
+        CopyFromRing(ring, tail, &record, sizeof(record));
+
+        uint32_t recordSize = (uint32_t)MOS_TRACE_RING_ALIGN(sizeof(record) + record.size);
+        uint8_t  *dst       = ReserveFile(recordSize);
+        if (dst)
+        {
+            CopyFromRing(ring, tail, dst, recordSize);
+        }
+        else
+        {
+            m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+        }
+        tail += recordSize;
+    }
+    ring->tail.store(tail, std::memory_order_release);
+
+    // Report events the thread dropped on ring overflow since last drain
+    uint64_t dropped = ring->dropped.load(std::memory_order_relaxed);
+    if (dropped != ring->droppedReported)
+    {
+        uint32_t count = (uint32_t)(dropped - ring->droppedReported);
+        ring->droppedReported = dropped;
+        m_droppedCount.fetch_add(count, std::memory_order_relaxed);
+
+        uint8_t *dst = ReserveFile((uint32_t)MOS_TRACE_RING_ALIGN(sizeof(MOS_TRACE_RING_RECORD) + sizeof(count)));
+        if (dst)
+        {
+            MOS_TRACE_RING_RECORD record;
+            record.size      = sizeof(count);
+            record.type      = MOS_TRACE_RING_RECORD_DROP;
+            record.tid       = ring->tid;
+            record.timestamp = GetTimeNs();
+            memcpy(dst, &record, sizeof(record));
+            memcpy(dst + sizeof(record), &count, sizeof(count));
+        }
+    }
+}
+
+void MosTraceRing::Drain()
+{
+    if (m_map == nullptr)
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_ringMutex);
+        for (auto ring : m_rings)
+        {
+            DrainRing(ring);
+        }
+    }
+
+    MOS_TRACE_RING_FILE_HEADER *header = (MOS_TRACE_RING_FILE_HEADER *)m_map;
+    header->dataSize     = m_dataSize;
+    header->droppedCount = m_droppedCount.load(std::memory_order_relaxed);
+}
+
+void MosTraceRing::DrainThread()
+{
+    std::unique_lock<std::mutex> lock(m_drainMutex);
+    while (!m_drainStop)
+    {
+        m_drainCond.wait_for(lock, std::chrono::milliseconds(MOS_TRACE_RING_DRAIN_INTERVAL_MS));
+        lock.unlock();
+        Drain();
+        lock.lock();
+    }
+}
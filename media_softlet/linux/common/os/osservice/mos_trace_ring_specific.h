@@ -0,0 +1,189 @@
+/*
+* Copyright (c) 2026, Intel Corporation
+*
+* Permission is hereby granted, free of charge, to any person obtaining a
+* copy of this software and associated documentation files (the "Software"),
+* to deal in the Software without restriction, including without limitation
+* the rights to use, copy, modify, merge, publish, distribute, sublicense,
+* and/or sell copies of the Software, and to permit persons to whom the
+* Software is furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included
+* in all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+* OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+* THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+* OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+* ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+* OTHER DEALINGS IN THE SOFTWARE.
+*/
+//!
+//! \file     mos_trace_ring_specific.h
+//! \brief    Ring buffer trace event backend for Linux
+//! \details  Trace events are appended to lock-free per-thread rings and drained by
+//!           a background thread into a memory-mapped binary file, as an alternative
+//!           to ftrace trace_marker_raw when debugfs is not available.
+//!
+
+#ifndef __MOS_TRACE_RING_SPECIFIC_H__
+#define __MOS_TRACE_RING_SPECIFIC_H__
+
+#include <limits.h>
+#include <stdint.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "media_class_trace.h"
+
+//!
+//! \brief Trace file layout: file header, then records, each 8 byte aligned.
+//!        An event record carries one trace event exactly as written to trace_marker_raw.
+//!
+#define MOS_TRACE_RING_FILE_MAGIC          0x4252544D  // MTRB
+#define MOS_TRACE_RING_FILE_VERSION        1
+#define MOS_TRACE_RING_RECORD_ALIGN        8
+#define MOS_TRACE_RING_RECORD_EVENT        0           // data is a trace event
+#define MOS_TRACE_RING_RECORD_DROP         1           // data is uint32_t count of events dropped by the thread
+
+#define MOS_TRACE_RING_DEFAULT_RING_SIZE   (1 << 20)   // bytes per thread
+#define MOS_TRACE_RING_DEFAULT_FILE_SIZE   (256 << 20) // bytes, events beyond are dropped
+#define MOS_TRACE_RING_MAX_RING_SIZE       (1u << 30)  // bytes per thread
+#define MOS_TRACE_RING_MAX_FILE_SIZE       (64ull << 30)
+#define MOS_TRACE_RING_DRAIN_INTERVAL_MS   10
+
+typedef struct _MOS_TRACE_RING_FILE_HEADER
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t headerSize;
+    uint32_t pid;
+    uint64_t dataSize;          // bytes of records following the header
+    uint64_t droppedCount;      // events dropped on ring or file overflow
+    uint64_t startTime;         // CLOCK_MONOTONIC time in ns when the file was opened
+} MOS_TRACE_RING_FILE_HEADER;
+
+typedef struct _MOS_TRACE_RING_RECORD
+{
+    uint16_t size;              // bytes of data following the record header
+    uint16_t type;              // MOS_TRACE_RING_RECORD_*
+    uint32_t tid;               // thread id
+    uint64_t timestamp;         // CLOCK_MONOTONIC time in ns
+} MOS_TRACE_RING_RECORD;
+
+class MosTraceRing
+{
+public:
+    //!
+    //! \brief    Open trace file
+    //! \details  Create the trace file <path>.<pid>.<n> and start the drain thread.
+    //!           n counts the files opened by the process, so no process or
+    //!           re-initialization overwrites the trace of another, and an
+    //!           existing file is never opened.
+    //! \param    [in] path
+    //!           Trace file path prefix
+    //! \param    [in] ringSize
+    //!           Ring size per thread in bytes, rounded up to a power of 2
+    //! \param    [in] fileSize
+    //!           Maximum trace file size in bytes
+    //! \return   bool
+    //!           true if tracing to file is enabled
+    //!
+    static bool Open(const char *path, uint32_t ringSize, uint64_t fileSize);
+
+    //!
+    //! \brief    Close trace file
+    //! \details  Stop the drain thread, drain remaining events and truncate the file to its data
+    //! \return   void
+    //!
+    static void Close();
+
+    //!
+    //! \brief    Is trace file open
+    //! \return   bool
+    //!
+    static bool IsOpen()
+    {
+        return m_open.load(std::memory_order_acquire);
+    }
+
+    //!
+    //! \brief    Write trace event
+    //! \details  Append one event to the calling thread ring, lock free.
+    //!           The event is dropped and counted if the ring is full.
+    //! \param    [in] event
+    //!           Trace event, header and data
+    //! \param    [in] size
+    //!           Trace event size in bytes
+    //! \return   void
+    //!
+    static void Write(const void *event, uint32_t size);
+
+    //!
+    //! \brief    Get dropped event count
+    //! \return   uint64_t
+    //!           Events dropped since the file was opened
+    //!
+    static uint64_t GetDroppedCount();
+
+    //!
+    //! \brief    Get trace file path
+    //! \return   const char *
+    //!           Path of the file last opened, empty if none
+    //!
+    static const char *GetFilePath()
+    {
+        return m_filePath;
+    }
+
+protected:
+    struct Ring
+    {
+        alignas(64) std::atomic<uint64_t> head;     // written by the owner thread
+        alignas(64) std::atomic<uint64_t> tail;     // written by the drain thread
+        alignas(64) std::atomic<uint64_t> dropped;  // events the owner thread could not write
+        uint64_t                          droppedReported;
+        std::atomic<bool>                 owned;    // a live thread writes to the ring
+        uint32_t                          tid;
+        uint32_t                          size;
+        uint8_t                           *buffer;
+    };
+
+    struct RingOwner
+    {
+        Ring *ring = nullptr;
+        ~RingOwner();
+    };
+
+    static Ring *GetThreadRing();
+    static void  CopyToRing(Ring *ring, uint64_t pos, const void *src, uint32_t size);
+    static void  CopyFromRing(const Ring *ring, uint64_t pos, void *dst, uint32_t size);
+    static uint8_t *ReserveFile(uint32_t size);
+    static void  DrainRing(Ring *ring);
+    static void  Drain();
+    static void  DrainThread();
+    static uint64_t GetTimeNs();
+
+    static std::atomic<bool>    m_open;
+    static std::mutex           m_ringMutex;        // ring registration, and draining
+    static std::vector<Ring *>  m_rings;
+    static uint32_t             m_ringSize;
+    static std::mutex           m_drainMutex;
+    static std::condition_variable m_drainCond;
+    static bool                 m_drainStop;
+    static std::thread          m_drainThread;
+    static int                  m_fd;
+    static uint8_t              *m_map;             // whole trace file, header first
+    static uint64_t             m_mapSize;
+    static uint64_t             m_dataSize;         // bytes of records written after the header
+    static std::atomic<uint64_t> m_droppedCount;
+    static uint32_t             m_fileCount;        // files opened by the process
+    static char                 m_filePath[PATH_MAX];
+
+MEDIA_CLASS_DEFINE_END(MosTraceRing)
+};
+
+#endif // __MOS_TRACE_RING_SPECIFIC_H__
@@ -44,6 +44,7 @@
 #include "media_user_settings_mgr_specific.h"
 #endif
 #include "mos_user_setting.h"
+#include "mos_trace_ring_specific.h"
 
 #include <sys/ipc.h>  // System V IPC
 #include <sys/types.h>
@@ -94,6 +95,27 @@ MosMutex          MosUtilitiesSpecificNext::m_userSettingMutex;
 #define TRACE_EVENT_HEADER_SIZE        (sizeof(uint32_t)*3)
 #define TRACE_EVENT_MAX_DATA_SIZE      (TRACE_EVENT_MAX_SIZE - TRACE_EVENT_HEADER_SIZE - sizeof(uint16_t)) // Trace info data size section is in uint16_t
 
+//!
+//! \brief trace event sink: trace_marker_raw, or per-thread rings drained to GFX_MEDIA_TRACE_FILE
+//!
+static inline bool MosTraceEnabled()
+{
+    return MosUtilitiesSpecificNext::m_mosTraceFd >= 0 || MosTraceRing::IsOpen();
+}
+
+static inline void MosTraceWrite(const void *pTraceBuf, uint32_t nLen)
+{
+    if (MosTraceRing::IsOpen())
+    {
+        MosTraceRing::Write(pTraceBuf, nLen);
+    }
+    else
+    {
+        size_t writeSize = write(MosUtilitiesSpecificNext::m_mosTraceFd, pTraceBuf, nLen);
+        MOS_UNUSED(writeSize);
+    }
+}
+
 //!
 //! \brief for int64_t/uint64_t format print warning
 //!
@@ -1354,6 +1376,13 @@ MOS_STATUS MosUtilities::MosOsUtilitiesInit(MediaUserSettingSharedPtr userSettin
     }
 #endif
 
+    // User settings read through handles are cached. Read env variables and reg values
+    // again for each device, so changes made between devices take effect for the new one.
+    if (userSettingPtr != nullptr)
+    {
+        userSettingPtr->Reload();
+    }
+
     if (m_mosUtilInitCount == 0)
     {
         //Init MOS User Feature Key from mos desc table
@@ -2423,6 +2452,31 @@ void MosUtilities::MosTraceEventInit()
         close(MosUtilitiesSpecificNext::m_mosTraceFd);
         MosUtilitiesSpecificNext::m_mosTraceFd = -1;
     }
+    MosTraceRing::Close();
+
+    // trace to file through per-thread rings, no debugfs needed
+    char *file = getenv("GFX_MEDIA_TRACE_FILE");
+    if (file != nullptr)
+    {
+        uint32_t ringSize = MOS_TRACE_RING_DEFAULT_RING_SIZE;
+        uint64_t fileSize = MOS_TRACE_RING_DEFAULT_FILE_SIZE;
+        val = getenv("GFX_MEDIA_TRACE_RING_SIZE");  // KB per thread
+        if (val != nullptr && strtoul(val, &tmp, 0) > 0)
+        {
+            ringSize = (uint32_t)MOS_MIN(strtoul(val, &tmp, 0), MOS_TRACE_RING_MAX_RING_SIZE >> 10) << 10;
+        }
+        val = getenv("GFX_MEDIA_TRACE_FILE_SIZE");  // MB
+        if (val != nullptr && strtoull(val, &tmp, 0) > 0)
+        {
+            fileSize = MOS_MIN(strtoull(val, &tmp, 0), MOS_TRACE_RING_MAX_FILE_SIZE >> 20) << 20;
+        }
+        if (MosTraceRing::Open(file, ringSize, fileSize))
+        {
+            MOS_OS_NORMALMESSAGE("Trace to file %s.", MosTraceRing::GetFilePath());
+            return;
+        }
+        MOS_OS_NORMALMESSAGE("Failed to open trace file %s, fall back to %s.", file, MosUtilitiesSpecificNext::m_mosTracePath);
+    }
     MosUtilitiesSpecificNext::m_mosTraceFd = open(MosUtilitiesSpecificNext::m_mosTracePath, O_WRONLY);
     return;
 }
@@ -2434,6 +2488,7 @@ void MosUtilities::MosTraceEventClose()
         close(MosUtilitiesSpecificNext::m_mosTraceFd);
         MosUtilitiesSpecificNext::m_mosTraceFd = -1;
     }
+    MosTraceRing::Close();
     m_mosTraceFilter = 0;
     return;
 }
@@ -2451,7 +2506,7 @@ void MosUtilities::MosTraceEvent(
     const void       *pArg2,
     uint32_t         dwSize2)
 {
-    if (MosUtilitiesSpecificNext::m_mosTraceFd >= 0 &&
+    if (MosTraceEnabled() &&
         TRACE_EVENT_MAX_SIZE > dwSize1 + dwSize2 + TRACE_EVENT_HEADER_SIZE)
     {
         uint8_t traceBuf[256];
@@ -2495,7 +2550,7 @@ void MosUtilities::MosTraceEvent(
                 memcpy(pTraceBuf+nLen, pArg2, dwSize2);
                 nLen += dwSize2;
             }
-            size_t writeSize = write(MosUtilitiesSpecificNext::m_mosTraceFd, pTraceBuf, nLen);
+            MosTraceWrite(pTraceBuf, nLen);
             if (traceBuf != pTraceBuf)
             {
                 MOS_FreeMemory(pTraceBuf);
@@ -2517,7 +2572,7 @@ void MosUtilities::MosTraceEvent(
                 header[2] = 0;
                 header[3] = (uint32_t)num;
                 nLen += num*sizeof(void *);
-                size_t ret = write(MosUtilitiesSpecificNext::m_mosTraceFd, traceBuf, nLen);
+                MosTraceWrite(traceBuf, nLen);
             }
         }
     }
@@ -2539,10 +2594,9 @@ void MosUtilities::MosTraceDataDump(
     const void *pBuf,
     uint32_t    dwSize)
 {
-    if (MosUtilitiesSpecificNext::m_mosTraceFd >= 0 && pBuf && pcName)
+    if (MosTraceEnabled() && pBuf && pcName)
     {
         uint8_t *pTraceBuf = (uint8_t *)MOS_AllocAndZeroMemory(TRACE_EVENT_MAX_SIZE);
-        size_t writeSize = 0;
 
         if (pTraceBuf)
         {
@@ -2557,7 +2611,7 @@ void MosUtilities::MosTraceDataDump(
             header[4] = flags;
             memcpy(&header[5], pcName, nLen);
             nLen += TRACE_EVENT_HEADER_SIZE + 8 + 1;
-            writeSize = write(MosUtilitiesSpecificNext::m_mosTraceFd, pTraceBuf, nLen);
+            MosTraceWrite(pTraceBuf, nLen);
             // send dump data
             header[2] = EVENT_TYPE_INFO;
             const uint8_t *pData = static_cast<const uint8_t *>(pBuf);
@@ -2575,14 +2629,14 @@ void MosUtilities::MosTraceDataDump(
                 memcpy(pDst, &len, sizeof(len));
                 memcpy(pDst+sizeof(len), pData, size);
                 nLen = TRACE_EVENT_HEADER_SIZE + size + sizeof(len);
-                writeSize = write(MosUtilitiesSpecificNext::m_mosTraceFd, pTraceBuf, nLen);
+                MosTraceWrite(pTraceBuf, nLen);
                 dwSize -= size;
                 pData += size;
             }
             // send dump end
             header[1] = EVENT_DATA_DUMP << 16;
             header[2] = EVENT_TYPE_END;
-            writeSize = write(MosUtilitiesSpecificNext::m_mosTraceFd, pTraceBuf, TRACE_EVENT_HEADER_SIZE);
+            MosTraceWrite(pTraceBuf, TRACE_EVENT_HEADER_SIZE);
 
             MOS_FreeMemory(pTraceBuf);
         }